@@ -1417,6 +1417,44 @@
 			#define EA_AVX 0
 		#endif
 	#endif
+	#ifndef EA_AVX2
+		#if defined __AVX2__ || defined CS_UNDEFINED_STRING
+			#define EA_AVX2 1
+		#else
+			#define EA_AVX2 0
+		#endif
+	#endif
+	// EA_POPCNT, EA_LZCNT, EA_BMI1 and EA_BMI2 tell whether the bit manipulation
+	// instructions (popcnt, lzcnt, tzcnt, pdep/pext) may be used. VC++ doesn't
+	// define feature macros for them, but every AVX2-capable CPU has all four.
+	#ifndef EA_POPCNT
+		#if defined __POPCNT__ || (defined _MSC_VER && defined __AVX__)
+			#define EA_POPCNT 1
+		#else
+			#define EA_POPCNT 0
+		#endif
+	#endif
+	#ifndef EA_LZCNT
+		#if defined __LZCNT__ || (defined _MSC_VER && defined __AVX2__)
+			#define EA_LZCNT 1
+		#else
+			#define EA_LZCNT 0
+		#endif
+	#endif
+	#ifndef EA_BMI1
+		#if defined __BMI__ || (defined _MSC_VER && defined __AVX2__)
+			#define EA_BMI1 1
+		#else
+			#define EA_BMI1 0
+		#endif
+	#endif
+	#ifndef EA_BMI2
+		#if defined __BMI2__ || (defined _MSC_VER && defined __AVX2__)
+			#define EA_BMI2 1
+		#else
+			#define EA_BMI2 0
+		#endif
+	#endif
 	// EA_FP16C may be used to determine the existence of float <-> half conversion operations on an x86 CPU.
 	// (For example to determine if _mm_cvtph_ps or _mm_cvtps_ph could be used.)
 	#ifndef EA_FP16C
@@ -0,0 +1,469 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements argsort, which sorts the positions of the elements of
+// a range rather than the elements themselves, and apply_permutation, which
+// rearranges one or more ranges in place by such a list of positions.
+//
+// Sorting large records directly moves whole records on every swap. Sorting
+// their positions instead moves only indices, and the records are then moved
+// to their places once. The same positions can reorder any number of parallel
+// arrays, which is how a table stored by column is sorted by one of its
+// columns:
+//
+//    eastl::vector<uint32_t> order(keys.size());
+//    eastl::argsort(keys.begin(), keys.end(), order.begin());
+//    eastl::apply_permutation_columns(order.begin(), order.end(), keys.begin(), names.begin(), prices.begin());
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_ARGSORT_H
+#define EASTL_ARGSORT_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/functional.h>
+#include <eastl/iterator.h>
+#include <eastl/memory.h>
+#include <eastl/sort.h>
+#include <eastl/type_traits.h>
+#include <eastl/utility.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_ARGSORT_DEFAULT_NAME
+	///
+	/// Defines a default allocation name in the absence of a user-provided allocator.
+	///
+	#ifndef EASTL_ARGSORT_DEFAULT_NAME
+		#define EASTL_ARGSORT_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " argsort" // Unless the user overrides something, this is "EASTL argsort".
+	#endif
+
+
+
+	namespace Internal
+	{
+		static const size_t kArgsortRadixLimit = 256; // Ranges smaller than this are sorted by comparison even if they could be radix sorted.
+
+		template <size_t nSize>
+		struct argsort_unsigned;
+
+		template <>
+		struct argsort_unsigned<1> { typedef uint8_t type; };
+
+		template <>
+		struct argsort_unsigned<2> { typedef uint16_t type; };
+
+		template <>
+		struct argsort_unsigned<4> { typedef uint32_t type; };
+
+		template <>
+		struct argsort_unsigned<8> { typedef uint64_t type; };
+
+
+		/// argsort_use_radix
+		///
+		/// Whether argsort radix sorts the keys rather than comparing them. This is done
+		/// for integers, float and double under the built-in orderings, whose keys can be
+		/// turned into unsigned integers that sort the same way.
+		///
+		template <typename T>
+		struct argsort_radix_type : public eastl::integral_constant<bool, (eastl::is_integral<T>::value && (sizeof(T) <= 8)) ||
+		                                                                  eastl::is_same<T, float>::value || eastl::is_same<T, double>::value> { };
+
+		template <typename T, typename Compare>
+		struct argsort_use_radix : public eastl::false_type { };
+
+		template <typename T>
+		struct argsort_use_radix<T, eastl::less<T> > : public argsort_radix_type<T> { };
+
+		template <typename T>
+		struct argsort_use_radix<T, eastl::greater<T> > : public argsort_radix_type<T> { };
+
+
+		// Returns a key as an unsigned integer with the same order. The sign bit of a
+		// signed integer is flipped. A float is ordered by its sign and magnitude, so a
+		// positive one gets its sign bit set and a negative one has all its bits flipped.
+		// Negative zero is made positive, as it compares equal to zero. NaNs with the sign
+		// bit clear end up after infinity, and those with it set before -infinity.
+		template <typename T>
+		EASTL_FORCE_INLINE typename argsort_unsigned<sizeof(T)>::type ArgsortRadixKey(T value, eastl::false_type)
+		{
+			typedef typename argsort_unsigned<sizeof(T)>::type unsigned_type;
+
+			const unsigned_type kSignBit = (unsigned_type)((unsigned_type)1 << ((sizeof(T) * 8) - 1));
+
+			return (unsigned_type)((unsigned_type)value ^ (eastl::is_signed<T>::value ? kSignBit : 0));
+		}
+
+		template <typename T>
+		EASTL_FORCE_INLINE typename argsort_unsigned<sizeof(T)>::type ArgsortRadixKey(T value, eastl::true_type)
+		{
+			typedef typename argsort_unsigned<sizeof(T)>::type unsigned_type;
+
+			const unsigned_type kSignBit = (unsigned_type)((unsigned_type)1 << ((sizeof(T) * 8) - 1));
+
+			if(value == T(0))
+				value = T(0);
+
+			unsigned_type n;
+			memcpy(&n, &value, sizeof(n));
+
+			return (n & kSignBit) ? (unsigned_type)~n : (unsigned_type)(n | kSignBit);
+		}
+
+
+		template <typename Key, typename Index>
+		struct argsort_entry
+		{
+			Key   mnKey;
+			Index mnIndex;
+		};
+
+
+		// LSD radix sorts the keys a byte at a time, which is stable. The counts for every
+		// byte are taken in one pass over the keys, and a byte that has the same value in
+		// every key is skipped, as its pass wouldn't move anything.
+		template <typename RandomAccessIterator, typename IndexIterator, typename Index, typename Allocator, bool bDescending>
+		void argsort_radix(RandomAccessIterator first, size_t n, IndexIterator indices, Allocator& allocator)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+			typedef typename eastl::iterator_traits<IndexIterator>::value_type        index_type;
+			typedef typename argsort_unsigned<sizeof(value_type)>::type             key_type;
+			typedef argsort_entry<key_type, Index>                                  entry_type;
+			typedef typename eastl::is_floating_point<value_type>::type             float_type;
+
+			const size_t kPasses = sizeof(key_type);
+			const size_t nBytes  = (2 * n * sizeof(entry_type)) + (kPasses * 256 * sizeof(size_t));
+
+			void* const pMemory  = allocate_memory(allocator, nBytes, EASTL_ALIGN_OF(entry_type) > EASTL_ALIGN_OF(size_t) ? EASTL_ALIGN_OF(entry_type) : EASTL_ALIGN_OF(size_t), 0);
+			entry_type* pEntries = (entry_type*)pMemory;
+			entry_type* pTemp    = pEntries + n;
+			size_t*     pCounts  = (size_t*)(pTemp + n);
+
+			memset(pCounts, 0, kPasses * 256 * sizeof(size_t));
+
+			for(size_t i = 0; i < n; ++i)
+			{
+				key_type nKey = ArgsortRadixKey<value_type>(*(first + i), float_type());
+
+				if(bDescending)
+					nKey = (key_type)~nKey;
+
+				pEntries[i].mnKey   = nKey;
+				pEntries[i].mnIndex = (Index)i;
+
+				for(size_t p = 0; p < kPasses; ++p)
+					++pCounts[(p * 256) + ((nKey >> (p * 8)) & 0xff)];
+			}
+
+			for(size_t p = 0; p < kPasses; ++p)
+			{
+				size_t* const pPassCounts = pCounts + (p * 256);
+
+				if(pPassCounts[(pEntries[0].mnKey >> (p * 8)) & 0xff] == n)
+					continue;
+
+				for(size_t k = 0, nSum = 0; k < 256; ++k)
+				{
+					const size_t nCount = pPassCounts[k];
+					pPassCounts[k] = nSum;
+					nSum += nCount;
+				}
+
+				for(size_t i = 0; i < n; ++i)
+					pTemp[pPassCounts[(pEntries[i].mnKey >> (p * 8)) & 0xff]++] = pEntries[i];
+
+				eastl::swap(pEntries, pTemp);
+			}
+
+			for(size_t i = 0; i < n; ++i)
+				*(indices + i) = (index_type)pEntries[i].mnIndex;
+
+			EASTLFree(allocator, pMemory, nBytes);
+		}
+
+
+		// Compares positions by the elements at them.
+		template <typename RandomAccessIterator, typename Compare>
+		struct argsort_compare
+		{
+			RandomAccessIterator mFirst;
+			Compare              mCompare;
+
+			argsort_compare(RandomAccessIterator first, Compare compare)
+				: mFirst(first), mCompare(compare) { }
+
+			template <typename Index>
+			bool operator()(Index a, Index b)
+				{ return mCompare(*(mFirst + a), *(mFirst + b)); }
+		};
+
+
+		template <typename RandomAccessIterator, typename IndexIterator, typename Allocator, typename Compare>
+		void argsort_impl(RandomAccessIterator first, RandomAccessIterator last, IndexIterator indices, Allocator& allocator, Compare compare, eastl::false_type)
+		{
+			typedef typename eastl::iterator_traits<IndexIterator>::value_type index_type;
+
+			const size_t n = (size_t)(last - first);
+
+			for(size_t i = 0; i < n; ++i)
+				*(indices + i) = (index_type)i;
+
+			eastl::mergeSort(indices, indices + n, allocator, argsort_compare<RandomAccessIterator, Compare>(first, compare));
+		}
+
+		template <typename RandomAccessIterator, typename IndexIterator, typename Allocator, typename Compare>
+		void argsort_impl(RandomAccessIterator first, RandomAccessIterator last, IndexIterator indices, Allocator& allocator, Compare compare, eastl::true_type)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			const size_t n           = (size_t)(last - first);
+			const bool   bDescending = eastl::is_same<Compare, eastl::greater<value_type> >::value;
+
+			if(n < kArgsortRadixLimit)
+				argsort_impl(first, last, indices, allocator, compare, eastl::false_type());
+			else if(n <= (size_t)0xffffffffu) // 32 bit indices keep the entries of 32 bit keys to 8 bytes.
+			{
+				if(bDescending)
+					argsort_radix<RandomAccessIterator, IndexIterator, uint32_t, Allocator, true>(first, n, indices, allocator);
+				else
+					argsort_radix<RandomAccessIterator, IndexIterator, uint32_t, Allocator, false>(first, n, indices, allocator);
+			}
+			else
+			{
+				if(bDescending)
+					argsort_radix<RandomAccessIterator, IndexIterator, size_t, Allocator, true>(first, n, indices, allocator);
+				else
+					argsort_radix<RandomAccessIterator, IndexIterator, size_t, Allocator, false>(first, n, indices, allocator);
+			}
+		}
+	}
+
+
+
+	/// argsort
+	///
+	/// Writes the positions 0 to (last - first - 1) of the elements of [first, last) to
+	/// the range starting at indices, in the order that sorts the elements by compare.
+	/// That is, after the call *(first + indices[0]) is the least element. The elements
+	/// themselves aren't modified. This is a stable sort: equal elements are given in
+	/// order of position.
+	///
+	/// The index range must be random access and its value_type must be able to hold
+	/// (last - first - 1); uint32_t is usually enough.
+	///
+	/// Integer, float and double elements under eastl::less or eastl::greater (the
+	/// default) are LSD radix sorted, in at most one pass per byte of the type, skipping
+	/// any byte that is the same in all elements. This allocates two arrays of key and
+	/// index pairs. NaNs are put after all other values if their sign bit is clear and
+	/// before them otherwise. Anything else is merge sorted by compare, which allocates
+	/// a second array of indices.
+	///
+	/// Example usage:
+	///     eastl::vector<uint32_t> order(prices.size());
+	///     eastl::argsort(prices.begin(), prices.end(), order.begin(), eastl::greater<float>());
+	///
+	template <typename RandomAccessIterator, typename IndexIterator, typename Allocator, typename Compare>
+	inline void argsort(RandomAccessIterator first, RandomAccessIterator last, IndexIterator indices, Allocator& allocator, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+		Internal::argsort_impl(first, last, indices, allocator, compare, typename Internal::argsort_use_radix<value_type, Compare>::type());
+	}
+
+	template <typename RandomAccessIterator, typename IndexIterator, typename Compare>
+	inline void argsort(RandomAccessIterator first, RandomAccessIterator last, IndexIterator indices, Compare compare)
+	{
+		EASTLAllocatorType allocator(EASTL_ARGSORT_DEFAULT_NAME);
+		eastl::argsort(first, last, indices, allocator, compare);
+	}
+
+	template <typename RandomAccessIterator, typename IndexIterator>
+	inline void argsort(RandomAccessIterator first, RandomAccessIterator last, IndexIterator indices)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		EASTLAllocatorType allocator(EASTL_ARGSORT_DEFAULT_NAME);
+		eastl::argsort(first, last, indices, allocator, Less());
+	}
+
+
+
+	namespace Internal
+	{
+		// One range being permuted, with room for the element that is lifted out
+		// at the start of each cycle.
+		template <typename RandomAccessIterator>
+		struct apply_permutation_column
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			RandomAccessIterator mFirst;
+			typename eastl::aligned_storage<sizeof(value_type), EASTL_ALIGN_OF(value_type)>::type mTemp;
+
+			explicit apply_permutation_column(RandomAccessIterator first)
+				: mFirst(first) { }
+
+			void save(size_t i)
+				{ ::new((void*)&mTemp) value_type(eastl::move(*(mFirst + i))); }
+
+			void move(size_t to, size_t from)
+				{ *(mFirst + to) = eastl::move(*(mFirst + from)); }
+
+			void restore(size_t i)
+			{
+				value_type* const pTemp = (value_type*)(void*)&mTemp;
+
+				*(mFirst + i) = eastl::move(*pTemp);
+				pTemp->~value_type();
+			}
+		};
+
+
+		#if EASTL_VARIADIC_TEMPLATES_ENABLED
+			template <typename... RandomAccessIterators>
+			struct apply_permutation_columns;
+
+			template <>
+			struct apply_permutation_columns<>
+			{
+				void save(size_t) { }
+				void move(size_t, size_t) { }
+				void restore(size_t) { }
+			};
+
+			template <typename RandomAccessIterator, typename... RandomAccessIterators>
+			struct apply_permutation_columns<RandomAccessIterator, RandomAccessIterators...> : public apply_permutation_columns<RandomAccessIterators...>
+			{
+				typedef apply_permutation_columns<RandomAccessIterators...> base_type;
+
+				apply_permutation_column<RandomAccessIterator> mColumn;
+
+				explicit apply_permutation_columns(RandomAccessIterator first, RandomAccessIterators... rest)
+					: base_type(rest...), mColumn(first) { }
+
+				void save(size_t i)
+					{ mColumn.save(i); base_type::save(i); }
+
+				void move(size_t to, size_t from)
+					{ mColumn.move(to, from); base_type::move(to, from); }
+
+				void restore(size_t i)
+					{ mColumn.restore(i); base_type::restore(i); }
+			};
+		#endif
+
+
+		// Follows each cycle of the permutation once: the element at the start of the cycle
+		// is lifted out, each position in turn is filled from the one it takes its element
+		// from, and the last is filled with the lifted element. A bit per position records
+		// which have been filled, so that each cycle is followed only once and the
+		// permutation itself needn't be modified.
+		template <typename IndexIterator, typename Columns, typename Allocator>
+		void apply_permutation_impl(IndexIterator perm, size_t n, Columns& columns, Allocator& allocator)
+		{
+			if(n < 2)
+				return;
+
+			const size_t    nWords = (n + 63) / 64;
+			const size_t    nBytes = nWords * sizeof(uint64_t);
+			uint64_t* const pDone  = (uint64_t*)allocate_memory(allocator, nBytes, EASTL_ALIGN_OF(uint64_t), 0);
+
+			memset(pDone, 0, nBytes);
+
+			for(size_t i = 0; i < n; ++i)
+			{
+				if(pDone[i / 64] & ((uint64_t)1 << (i % 64)))
+					continue;
+
+				size_t k = (size_t)*(perm + i);
+
+				EASTL_ASSERT(k < n);
+
+				if(k == i)
+					continue;
+
+				size_t j = i;
+				columns.save(i);
+
+				do
+				{
+					EASTL_ASSERT((k < n) && !(pDone[k / 64] & ((uint64_t)1 << (k % 64)))); // If this fails, perm isn't a permutation of [0, n).
+
+					columns.move(j, k);
+					pDone[k / 64] |= ((uint64_t)1 << (k % 64));
+					j = k;
+					k = (size_t)*(perm + j);
+				} while(k != i);
+
+				columns.restore(j);
+			}
+
+			EASTLFree(allocator, pDone, nBytes);
+		}
+	}
+
+
+
+	/// apply_permutation
+	///
+	/// Rearranges [first, last) in place so that the element at position i is the one
+	/// that was at position perm[i], where perm is a permutation of 0 to (last - first - 1)
+	/// such as argsort writes. So after argsort(first, last, perm), apply_permutation(first,
+	/// last, perm) sorts the range. perm isn't modified.
+	///
+	/// Each element is moved once, plus one extra move per cycle of the permutation.
+	/// This allocates a bit per element to keep track of which have been placed.
+	///
+	template <typename RandomAccessIterator, typename IndexIterator, typename Allocator>
+	inline void apply_permutation(RandomAccessIterator first, RandomAccessIterator last, IndexIterator perm, Allocator& allocator)
+	{
+		Internal::apply_permutation_column<RandomAccessIterator> column(first);
+		Internal::apply_permutation_impl(perm, (size_t)(last - first), column, allocator);
+	}
+
+	template <typename RandomAccessIterator, typename IndexIterator>
+	inline void apply_permutation(RandomAccessIterator first, RandomAccessIterator last, IndexIterator perm)
+	{
+		EASTLAllocatorType allocator(EASTL_ARGSORT_DEFAULT_NAME);
+		eastl::apply_permutation(first, last, perm, allocator);
+	}
+
+
+	/// apply_permutation_columns
+	///
+	/// Applies the permutation [permFirst, permLast) to each of the ranges starting at
+	/// columns, as apply_permutation does to one. The permutation is followed once for
+	/// all the ranges, rather than once per range.
+	///
+	/// Example usage:
+	///     eastl::argsort(ids.begin(), ids.end(), order.begin());
+	///     eastl::apply_permutation_columns(order.begin(), order.end(), ids.begin(), names.begin(), scores.begin());
+	///
+	#if EASTL_VARIADIC_TEMPLATES_ENABLED
+		template <typename IndexIterator, typename... RandomAccessIterators>
+		inline void apply_permutation_columns(IndexIterator permFirst, IndexIterator permLast, RandomAccessIterators... columns)
+		{
+			EASTLAllocatorType allocator(EASTL_ARGSORT_DEFAULT_NAME);
+			Internal::apply_permutation_columns<RandomAccessIterators...> columnSet(columns...);
+			Internal::apply_permutation_impl(permFirst, (size_t)(permLast - permFirst), columnSet, allocator);
+		}
+	#endif
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,2158 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements art_map, an ordered map built on an adaptive radix
+// tree (Leis, Kemper and Neumann, "The Adaptive Radix Tree: ARTful Indexing
+// for Main-Memory Databases", 2013), as an alternative to map for string
+// and integer keys.
+//
+// A map<string, T> lookup does about log2(n) full string comparisons, each
+// of which may touch a different cache line. An art_map lookup looks at each
+// byte of the key once, one tree level per byte, and compares the whole key
+// just once, at the leaf. Inner nodes come in four sizes (4, 16, 48 and 256
+// children) so that sparse levels stay small, and runs of bytes which no key
+// branches on are stored once as a compressed path prefix.
+//
+// The leaves are also linked in key order, so iteration is as cheap as with
+// list, and lowerBound and prefix scans descend once and then walk the list.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_ART_MAP_H
+#define EASTL_ART_MAP_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/algorithm.h>
+#include <eastl/bit.h>
+#include <eastl/allocator.h>
+#include <eastl/iterator.h>
+#include <eastl/initializer_list.h>
+#include <eastl/string.h>
+#include <eastl/type_traits.h>
+#include <eastl/utility.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <new>
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <new>
+	#include <string.h>
+#endif
+
+#if EASTL_SSE2
+	#include <emmintrin.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_ART_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_ART_MAP_DEFAULT_NAME
+		#define EASTL_ART_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " art_map" // Unless the user overrides something, this is "EASTL art_map".
+	#endif
+
+
+	/// EASTL_ART_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_ART_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_ART_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_ART_MAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// art_key_bytes
+	///
+	/// The binary-comparable form of a key: comparing two keys' bytes with
+	/// memcmp, the shorter first if one is a prefix of the other, must give the
+	/// order wanted for the keys. mpData may point into the key or into mBuffer.
+	///
+	struct art_key_bytes
+	{
+		const uint8_t* mpData;
+		size_t         mnSize;
+		uint8_t        mBuffer[16];
+	};
+
+
+	/// art_key_traits
+	///
+	/// Converts a key to bytes. Specialized for integers, which are written big
+	/// endian with the sign bit flipped, so that the order is numeric, and for
+	/// basicString of 8 bit characters, whose order is that of the unsigned
+	/// bytes (the same as strcmp). Specialize it for other key types.
+	///
+	template <typename Key, typename Enable = void>
+	struct art_key_traits
+	{
+	};
+
+	template <typename Key>
+	struct art_key_traits<Key, typename eastl::enable_if<eastl::is_integral<Key>::value>::type>
+	{
+		static void get_bytes(const Key& key, art_key_bytes& bytes)
+		{
+			uint64_t u = (uint64_t)key;
+
+			if(eastl::is_signed<Key>::value)
+				u ^= (UINT64_C(1) << ((sizeof(Key) * 8) - 1));
+
+			for(size_t i = 0; i < sizeof(Key); ++i)
+				bytes.mBuffer[i] = (uint8_t)(u >> ((sizeof(Key) - 1 - i) * 8));
+
+			bytes.mpData = bytes.mBuffer;
+			bytes.mnSize = sizeof(Key);
+		}
+	};
+
+	template <typename T, typename Allocator>
+	struct art_key_traits<basicString<T, Allocator>, void>
+	{
+		static_assert(sizeof(T) == 1, "art_key_traits: only strings of 8 bit characters have a default byte form.");
+
+		static void get_bytes(const basicString<T, Allocator>& key, art_key_bytes& bytes)
+		{
+			bytes.mpData = (const uint8_t*)key.data();
+			bytes.mnSize = (size_t)key.size();
+		}
+	};
+
+
+
+	/// art_leaf_base
+	///
+	/// Leaves are kept in a circular doubly linked list in key order, through
+	/// the container's anchor, as with list.
+	///
+	struct art_leaf_base
+	{
+		art_leaf_base* mpNext;
+		art_leaf_base* mpPrev;
+	};
+
+	template <typename Value>
+	struct art_leaf : public art_leaf_base
+	{
+		Value mValue;
+	};
+
+
+	/// art_node
+	///
+	/// The header of an inner node. A reference to a child is a uintptr_t which
+	/// is either an art_node* or an art_leaf_base* with the low bit set.
+	///
+	/// mnPrefixLength bytes are skipped at this node, as all keys below it share
+	/// them. Only the first kArtMaxStoredPrefix of them are stored; lookups skip
+	/// the rest optimistically, as the full key is compared at the leaf anyway,
+	/// and updates which need them read them from any leaf below.
+	///
+	/// mpTerminal is the leaf whose key ends exactly after the prefix, if any,
+	/// which is how one key can be a prefix of another.
+	///
+	enum art_node_type
+	{
+		kArtNode4,
+		kArtNode16,
+		kArtNode48,
+		kArtNode256
+	};
+
+	static const uint32_t kArtMaxStoredPrefix = 9;
+
+	struct art_node
+	{
+		art_leaf_base* mpTerminal;
+		uint32_t       mnPrefixLength;
+		uint16_t       mnChildCount;
+		uint8_t        mnType;
+		uint8_t        mPrefix[kArtMaxStoredPrefix];
+	};
+
+	struct art_node4 : public art_node
+	{
+		uint8_t   mKeys[4];        // Sorted.
+		uintptr_t mChildren[4];
+	};
+
+	struct art_node16 : public art_node
+	{
+		uint8_t   mKeys[16];       // Sorted.
+		uintptr_t mChildren[16];
+	};
+
+	struct art_node48 : public art_node
+	{
+		uint8_t   mChildIndex[256]; // 0 if there is no child for the byte, else the child's slot + 1.
+		uintptr_t mChildren[48];    // Unordered; free slots are 0.
+	};
+
+	struct art_node256 : public art_node
+	{
+		uintptr_t mChildren[256];
+	};
+
+
+	namespace Internal
+	{
+		inline bool art_is_leaf(uintptr_t ref)
+			{ return (ref & 1) != 0; }
+
+		inline art_leaf_base* art_to_leaf(uintptr_t ref)
+			{ return (art_leaf_base*)(ref & ~(uintptr_t)1); }
+
+		inline uintptr_t art_from_leaf(const art_leaf_base* pLeaf)
+			{ return (uintptr_t)pLeaf | 1; }
+
+		inline art_node* art_to_node(uintptr_t ref)
+			{ return (art_node*)ref; }
+
+		/// art_find_child
+		///
+		/// Returns a pointer to the reference to the child for byte b, or NULL.
+		///
+		inline uintptr_t* art_find_child(art_node* pNode, uint8_t b)
+		{
+			switch(pNode->mnType)
+			{
+				case kArtNode4:
+				{
+					art_node4* const p = static_cast<art_node4*>(pNode);
+					for(uint32_t i = 0; i < p->mnChildCount; ++i)
+					{
+						if(p->mKeys[i] == b)
+							return &p->mChildren[i];
+					}
+					return NULL;
+				}
+
+				case kArtNode16:
+				{
+					art_node16* const p = static_cast<art_node16*>(pNode);
+
+					#if EASTL_SSE2
+						const __m128i  cmp  = _mm_cmpeq_epi8(_mm_set1_epi8((char)b), _mm_loadu_si128((const __m128i*)p->mKeys));
+						const uint32_t mask = (uint32_t)_mm_movemask_epi8(cmp) & ((1u << p->mnChildCount) - 1);
+						return mask ? &p->mChildren[eastl::countr_zero(mask)] : NULL;
+					#else
+						for(uint32_t i = 0; i < p->mnChildCount; ++i)
+						{
+							if(p->mKeys[i] == b)
+								return &p->mChildren[i];
+						}
+						return NULL;
+					#endif
+				}
+
+				case kArtNode48:
+				{
+					art_node48* const p = static_cast<art_node48*>(pNode);
+					return p->mChildIndex[b] ? &p->mChildren[p->mChildIndex[b] - 1] : NULL;
+				}
+
+				default:
+				{
+					art_node256* const p = static_cast<art_node256*>(pNode);
+					return p->mChildren[b] ? &p->mChildren[b] : NULL;
+				}
+			}
+		}
+
+
+		/// art_find_child_greater
+		///
+		/// Returns the child with the smallest byte greater than b, or 0.
+		///
+		inline uintptr_t art_find_child_greater(const art_node* pNode, uint8_t b)
+		{
+			switch(pNode->mnType)
+			{
+				case kArtNode4:
+				{
+					const art_node4* const p = static_cast<const art_node4*>(pNode);
+					for(uint32_t i = 0; i < p->mnChildCount; ++i)
+					{
+						if(p->mKeys[i] > b)
+							return p->mChildren[i];
+					}
+					return 0;
+				}
+
+				case kArtNode16:
+				{
+					const art_node16* const p = static_cast<const art_node16*>(pNode);
+
+					#if EASTL_SSE2
+						// There is no unsigned byte compare, so flip the sign bits and compare signed.
+						const __m128i  bias = _mm_set1_epi8((char)0x80);
+						const __m128i  cmp  = _mm_cmpgt_epi8(_mm_xor_si128(_mm_loadu_si128((const __m128i*)p->mKeys), bias),
+															 _mm_xor_si128(_mm_set1_epi8((char)b), bias));
+						const uint32_t mask = (uint32_t)_mm_movemask_epi8(cmp) & ((1u << p->mnChildCount) - 1);
+						return mask ? p->mChildren[eastl::countr_zero(mask)] : 0;
+					#else
+						for(uint32_t i = 0; i < p->mnChildCount; ++i)
+						{
+							if(p->mKeys[i] > b)
+								return p->mChildren[i];
+						}
+						return 0;
+					#endif
+				}
+
+				case kArtNode48:
+				{
+					const art_node48* const p = static_cast<const art_node48*>(pNode);
+					for(uint32_t i = (uint32_t)b + 1; i < 256; ++i)
+					{
+						if(p->mChildIndex[i])
+							return p->mChildren[p->mChildIndex[i] - 1];
+					}
+					return 0;
+				}
+
+				default:
+				{
+					const art_node256* const p = static_cast<const art_node256*>(pNode);
+					for(uint32_t i = (uint32_t)b + 1; i < 256; ++i)
+					{
+						if(p->mChildren[i])
+							return p->mChildren[i];
+					}
+					return 0;
+				}
+			}
+		}
+
+
+		/// art_first_child / art_last_child
+		///
+		/// Return the child with the smallest or largest byte, or 0 if there are no children.
+		///
+		inline uintptr_t art_first_child(const art_node* pNode)
+		{
+			if(pNode->mnChildCount == 0)
+				return 0;
+
+			switch(pNode->mnType)
+			{
+				case kArtNode4:  return static_cast<const art_node4*>(pNode)->mChildren[0];
+				case kArtNode16: return static_cast<const art_node16*>(pNode)->mChildren[0];
+
+				case kArtNode48:
+				{
+					const art_node48* const p = static_cast<const art_node48*>(pNode);
+					for(int i = 0; ; ++i)
+					{
+						if(p->mChildIndex[i])
+							return p->mChildren[p->mChildIndex[i] - 1];
+					}
+				}
+
+				default:
+				{
+					const art_node256* const p = static_cast<const art_node256*>(pNode);
+					for(int i = 0; ; ++i)
+					{
+						if(p->mChildren[i])
+							return p->mChildren[i];
+					}
+				}
+			}
+		}
+
+		inline uintptr_t art_last_child(const art_node* pNode)
+		{
+			if(pNode->mnChildCount == 0)
+				return 0;
+
+			switch(pNode->mnType)
+			{
+				case kArtNode4:  return static_cast<const art_node4*>(pNode)->mChildren[pNode->mnChildCount - 1];
+				case kArtNode16: return static_cast<const art_node16*>(pNode)->mChildren[pNode->mnChildCount - 1];
+
+				case kArtNode48:
+				{
+					const art_node48* const p = static_cast<const art_node48*>(pNode);
+					for(int i = 255; ; --i)
+					{
+						if(p->mChildIndex[i])
+							return p->mChildren[p->mChildIndex[i] - 1];
+					}
+				}
+
+				default:
+				{
+					const art_node256* const p = static_cast<const art_node256*>(pNode);
+					for(int i = 255; ; --i)
+					{
+						if(p->mChildren[i])
+							return p->mChildren[i];
+					}
+				}
+			}
+		}
+
+
+		/// art_leftmost / art_rightmost
+		///
+		/// Return the first or last leaf in key order below ref. A terminal leaf
+		/// comes before the children, as its key is a prefix of theirs.
+		///
+		inline art_leaf_base* art_leftmost(uintptr_t ref)
+		{
+			while(!art_is_leaf(ref))
+			{
+				const art_node* const pNode = art_to_node(ref);
+				if(pNode->mpTerminal)
+					return pNode->mpTerminal;
+				ref = art_first_child(pNode);
+			}
+			return art_to_leaf(ref);
+		}
+
+		inline art_leaf_base* art_rightmost(uintptr_t ref)
+		{
+			while(!art_is_leaf(ref))
+			{
+				const art_node* const pNode = art_to_node(ref);
+				if(pNode->mnChildCount == 0)
+					return pNode->mpTerminal;
+				ref = art_last_child(pNode);
+			}
+			return art_to_leaf(ref);
+		}
+
+	} // namespace Internal
+
+
+
+	/// art_map_iterator
+	///
+	template <typename Value, bool bConst>
+	struct art_map_iterator
+	{
+	public:
+		typedef art_map_iterator<Value, bConst>                                  this_type;
+		typedef art_map_iterator<Value, false>                                   iterator_type;
+		typedef art_leaf<Value>                                                  leaf_type;
+		typedef Value                                                            value_type;
+		typedef typename type_select<bConst, const Value*, Value*>::type         pointer;
+		typedef typename type_select<bConst, const Value&, Value&>::type         reference;
+		typedef ptrdiff_t                                                        difference_type;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag                         iterator_category;
+
+		art_leaf_base* mpLeaf;
+
+	public:
+		art_map_iterator(art_leaf_base* pLeaf = NULL)
+			: mpLeaf(pLeaf) { }
+
+		art_map_iterator(const iterator_type& x)
+			: mpLeaf(x.mpLeaf) { }
+
+		reference operator*() const
+			{ return static_cast<leaf_type*>(mpLeaf)->mValue; }
+
+		pointer operator->() const
+			{ return &static_cast<leaf_type*>(mpLeaf)->mValue; }
+
+		this_type& operator++()
+			{ mpLeaf = mpLeaf->mpNext; return *this; }
+
+		this_type operator++(int)
+			{ this_type temp(*this); mpLeaf = mpLeaf->mpNext; return temp; }
+
+		this_type& operator--()
+			{ mpLeaf = mpLeaf->mpPrev; return *this; }
+
+		this_type operator--(int)
+			{ this_type temp(*this); mpLeaf = mpLeaf->mpPrev; return temp; }
+
+	}; // art_map_iterator
+
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator==(const art_map_iterator<Value, bConstA>& a, const art_map_iterator<Value, bConstB>& b)
+		{ return a.mpLeaf == b.mpLeaf; }
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator!=(const art_map_iterator<Value, bConstA>& a, const art_map_iterator<Value, bConstB>& b)
+		{ return a.mpLeaf != b.mpLeaf; }
+
+
+
+	/// art_map
+	///
+	/// An ordered unique-key map with the interface of map, for keys which
+	/// art_key_traits can convert to bytes. Keys are ordered by their bytes,
+	/// which for strings is strcmp order and for integers is numeric order.
+	///
+	/// Iterators and references are invalidated only by erasing their element.
+	/// Each element is its own allocation, as with map, but with 16 bytes of
+	/// overhead rather than 32; the inner nodes add roughly 10 to 30 bytes per
+	/// key depending on how the keys branch.
+	///
+	/// In addition to the map interface there is prefixRange, which returns
+	/// the range of keys which start with a given sequence of bytes.
+	///
+	/// Example usage:
+	///     art_map<eastl::string, PageInfo> pages;
+	///     pages["example.com/a"] = infoA;
+	///
+	///     eastl::pair<art_map<eastl::string, PageInfo>::iterator, art_map<eastl::string, PageInfo>::iterator>
+	///         range = pages.prefixRange("example.com/");
+	///     for(; range.first != range.second; ++range.first)
+	///         Visit(range.first->second);
+	///
+	template <typename Key, typename T, typename KeyTraits = art_key_traits<Key>, typename Allocator = EASTLAllocatorType>
+	class art_map
+	{
+	public:
+		typedef art_map<Key, T, KeyTraits, Allocator>                  this_type;
+		typedef Key                                                    key_type;
+		typedef T                                                      mapped_type;
+		typedef eastl::pair<const Key, T>                              value_type;
+		typedef value_type&                                            reference;
+		typedef const value_type&                                      const_reference;
+		typedef eastl_size_t                                           size_type;
+		typedef ptrdiff_t                                              difference_type;
+		typedef Allocator                                              allocator_type;
+		typedef art_map_iterator<value_type, false>                    iterator;
+		typedef art_map_iterator<value_type, true>                     const_iterator;
+		typedef eastl::reverse_iterator<iterator>                      reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>                const_reverse_iterator;
+		typedef eastl::pair<iterator, bool>                            insert_return_type;
+		typedef art_leaf<value_type>                                   leaf_type;
+
+	public:
+		art_map(const allocator_type& allocator = EASTL_ART_MAP_DEFAULT_ALLOCATOR);
+		art_map(const this_type& x);
+
+		template <typename InputIterator>
+		art_map(InputIterator first, InputIterator last, const allocator_type& allocator = EASTL_ART_MAP_DEFAULT_ALLOCATOR);
+
+		art_map(std::initializer_list<value_type> ilist, const allocator_type& allocator = EASTL_ART_MAP_DEFAULT_ALLOCATOR);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			art_map(this_type&& x);
+			this_type& operator=(this_type&& x);
+		#endif
+
+	   ~art_map();
+
+		this_type& operator=(const this_type& x);
+		this_type& operator=(std::initializer_list<value_type> ilist);
+		void       swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+		void                  setAllocator(const allocator_type& allocator);
+
+		iterator               begin() EASTL_NOEXCEPT         { return iterator(mAnchor.mpNext); }
+		const_iterator         begin() const EASTL_NOEXCEPT   { return const_iterator(mAnchor.mpNext); }
+		const_iterator         cbegin() const EASTL_NOEXCEPT  { return const_iterator(mAnchor.mpNext); }
+
+		iterator               end() EASTL_NOEXCEPT           { return iterator(&mAnchor); }
+		const_iterator         end() const EASTL_NOEXCEPT     { return const_iterator(const_cast<art_leaf_base*>(&mAnchor)); }
+		const_iterator         cend() const EASTL_NOEXCEPT    { return const_iterator(const_cast<art_leaf_base*>(&mAnchor)); }
+
+		reverse_iterator       rbegin() EASTL_NOEXCEPT        { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const EASTL_NOEXCEPT  { return const_reverse_iterator(end()); }
+		const_reverse_iterator crbegin() const EASTL_NOEXCEPT { return const_reverse_iterator(end()); }
+		reverse_iterator       rend() EASTL_NOEXCEPT          { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const EASTL_NOEXCEPT    { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crend() const EASTL_NOEXCEPT   { return const_reverse_iterator(begin()); }
+
+		bool      empty() const EASTL_NOEXCEPT { return (mnSize == 0); }
+		size_type size() const EASTL_NOEXCEPT  { return mnSize; }
+
+		// The position hints are accepted for compatibility with map but are
+		// unused; a lookup costs the same with or without one.
+		#if EASTL_MOVE_SEMANTICS_ENABLED && EASTL_VARIADIC_TEMPLATES_ENABLED
+			template <class... Args>
+			insert_return_type emplace(Args&&... args);
+
+			template <class... Args>
+			iterator emplace_hint(const_iterator position, Args&&... args);
+		#else
+			#if EASTL_MOVE_SEMANTICS_ENABLED
+				insert_return_type emplace(value_type&& value);
+				iterator emplace_hint(const_iterator position, value_type&& value);
+			#endif
+
+			insert_return_type emplace(const value_type& value);
+			iterator emplace_hint(const_iterator position, const value_type& value);
+		#endif
+
+		insert_return_type insert(const value_type& value);
+		insert_return_type insert(const key_type& key);
+		iterator           insert(const_iterator position, const value_type& value);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			insert_return_type insert(value_type&& value);
+			iterator           insert(const_iterator position, value_type&& value);
+		#endif
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last);
+		void insert(std::initializer_list<value_type> ilist);
+
+		mapped_type& operator[](const key_type& key)
+			{ return insert(key).first->second; }
+
+		size_type erase(const key_type& key);
+		iterator  erase(const_iterator position);
+		iterator  erase(const_iterator first, const_iterator last);
+
+		reverse_iterator erase(const_reverse_iterator position);
+		reverse_iterator erase(const_reverse_iterator first, const_reverse_iterator last);
+
+		void clear();
+
+		iterator       find(const key_type& key);
+		const_iterator find(const key_type& key) const;
+		size_type      count(const key_type& key) const;
+
+		iterator       lowerBound(const key_type& key);
+		const_iterator lowerBound(const key_type& key) const;
+		iterator       upperBound(const key_type& key);
+		const_iterator upperBound(const key_type& key) const;
+
+		eastl::pair<iterator, iterator>             equalRange(const key_type& key);
+		eastl::pair<const_iterator, const_iterator> equalRange(const key_type& key) const;
+
+		/// prefixRange
+		/// Returns the range of elements whose keys' bytes start with the given
+		/// bytes. For string keys this is the keys starting with prefix.
+		eastl::pair<iterator, iterator>             prefixRange(const key_type& prefix);
+		eastl::pair<const_iterator, const_iterator> prefixRange(const key_type& prefix) const;
+		eastl::pair<iterator, iterator>             prefixRange(const uint8_t* pPrefix, size_t nPrefixSize);
+		eastl::pair<const_iterator, const_iterator> prefixRange(const uint8_t* pPrefix, size_t nPrefixSize) const;
+
+		bool validate() const;
+		int  validateIterator(const_iterator i) const;
+
+	protected:
+		uintptr_t      mRoot;     // 0 if empty.
+		art_leaf_base  mAnchor;   // Links the first and last leaves; end() points to it.
+		size_type      mnSize;
+		allocator_type mAllocator;
+
+		static void DoGetKeyBytes(const art_leaf_base* pLeaf, art_key_bytes& bytes)
+			{ KeyTraits::get_bytes(static_cast<const leaf_type*>(pLeaf)->mValue.first, bytes); }
+
+		static bool DoLeafMatches(const art_leaf_base* pLeaf, const uint8_t* pKey, size_t nKeySize);
+		static int  DoLeafCompare(const art_leaf_base* pLeaf, const uint8_t* pKey, size_t nKeySize);
+
+		art_leaf_base* DoFind(const uint8_t* pKey, size_t nKeySize) const;
+		art_leaf_base* DoLowerBound(const uint8_t* pKey, size_t nKeySize) const;
+		uintptr_t      DoFindPrefix(const uint8_t* pKey, size_t nKeySize) const;
+		void           DoInsertLeaf(art_leaf_base* pLeaf, art_leaf_base* pNext);
+		art_leaf_base* DoRemoveLeaf(const uint8_t* pKey, size_t nKeySize);
+
+		leaf_type* DoAllocateLeaf();
+		void       DoFreeLeaf(leaf_type* pLeaf);
+		void       DoLinkAndCount(art_leaf_base* pLeaf, art_leaf_base* pNext);
+
+		art_node*  DoAllocateNode(uint8_t nType);
+		void       DoFreeNode(art_node* pNode);
+		void       DoFreeNodes(uintptr_t ref);
+		void       DoAddChild(uintptr_t* pRef, uint8_t b, uintptr_t child);
+		void       DoRemoveChild(uintptr_t* pRef, uint8_t b);
+		void       DoCollapse(uintptr_t* pRef);
+
+		const uint8_t* DoGetPrefix(const art_node* pNode, size_t nDepth, art_key_bytes& bytes) const;
+
+		static size_t DoNodeSize(uint8_t nType);
+		static void   DoCopyHeader(art_node* pDest, const art_node* pSource);
+
+		bool DoValidateNode(uintptr_t ref, size_t nDepth, size_t& nLeafCount) const;
+
+	}; // class art_map
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// art_map
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename KT, typename A>
+	inline art_map<K, T, KT, A>::art_map(const allocator_type& allocator)
+		: mRoot(0), mnSize(0), mAllocator(allocator)
+	{
+		mAnchor.mpNext = mAnchor.mpPrev = &mAnchor;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline art_map<K, T, KT, A>::art_map(const this_type& x)
+		: mRoot(0), mnSize(0), mAllocator(x.mAllocator)
+	{
+		mAnchor.mpNext = mAnchor.mpPrev = &mAnchor;
+		insert(x.begin(), x.end());
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	template <typename InputIterator>
+	inline art_map<K, T, KT, A>::art_map(InputIterator first, InputIterator last, const allocator_type& allocator)
+		: mRoot(0), mnSize(0), mAllocator(allocator)
+	{
+		mAnchor.mpNext = mAnchor.mpPrev = &mAnchor;
+		insert(first, last);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline art_map<K, T, KT, A>::art_map(std::initializer_list<value_type> ilist, const allocator_type& allocator)
+		: mRoot(0), mnSize(0), mAllocator(allocator)
+	{
+		mAnchor.mpNext = mAnchor.mpPrev = &mAnchor;
+		insert(ilist.begin(), ilist.end());
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename T, typename KT, typename A>
+		inline art_map<K, T, KT, A>::art_map(this_type&& x)
+			: mRoot(0), mnSize(0), mAllocator(x.mAllocator)
+		{
+			mAnchor.mpNext = mAnchor.mpPrev = &mAnchor;
+			swap(x);
+		}
+
+
+		template <typename K, typename T, typename KT, typename A>
+		inline typename art_map<K, T, KT, A>::this_type&
+		art_map<K, T, KT, A>::operator=(this_type&& x)
+		{
+			if(this != &x)
+			{
+				clear();
+				swap(x);
+			}
+			return *this;
+		}
+	#endif
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline art_map<K, T, KT, A>::~art_map()
+	{
+		clear();
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	typename art_map<K, T, KT, A>::this_type&
+	art_map<K, T, KT, A>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			clear();
+			insert(x.begin(), x.end());
+		}
+		return *this;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	typename art_map<K, T, KT, A>::this_type&
+	art_map<K, T, KT, A>::operator=(std::initializer_list<value_type> ilist)
+	{
+		clear();
+		insert(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	void art_map<K, T, KT, A>::swap(this_type& x)
+	{
+		// The end leaves point to the anchors, which don't move, so relink them.
+		eastl::swap(mRoot,     x.mRoot);
+		eastl::swap(mAnchor,   x.mAnchor);
+		eastl::swap(mnSize,    x.mnSize);
+		eastl::swap(mAllocator, x.mAllocator);
+
+		if(mnSize)
+			mAnchor.mpNext->mpPrev = mAnchor.mpPrev->mpNext = &mAnchor;
+		else
+			mAnchor.mpNext = mAnchor.mpPrev = &mAnchor;
+
+		if(x.mnSize)
+			x.mAnchor.mpNext->mpPrev = x.mAnchor.mpPrev->mpNext = &x.mAnchor;
+		else
+			x.mAnchor.mpNext = x.mAnchor.mpPrev = &x.mAnchor;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline void art_map<K, T, KT, A>::setAllocator(const allocator_type& allocator)
+	{
+		EASTL_ASSERT(empty());
+		mAllocator = allocator;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline bool art_map<K, T, KT, A>::DoLeafMatches(const art_leaf_base* pLeaf, const uint8_t* pKey, size_t nKeySize)
+	{
+		art_key_bytes bytes;
+		DoGetKeyBytes(pLeaf, bytes);
+		return (bytes.mnSize == nKeySize) && (memcmp(bytes.mpData, pKey, nKeySize) == 0);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline int art_map<K, T, KT, A>::DoLeafCompare(const art_leaf_base* pLeaf, const uint8_t* pKey, size_t nKeySize)
+	{
+		art_key_bytes bytes;
+		DoGetKeyBytes(pLeaf, bytes);
+
+		const int n = memcmp(bytes.mpData, pKey, (bytes.mnSize < nKeySize) ? bytes.mnSize : nKeySize);
+		if(n)
+			return n;
+		return (bytes.mnSize < nKeySize) ? -1 : (bytes.mnSize > nKeySize) ? 1 : 0;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline const uint8_t* art_map<K, T, KT, A>::DoGetPrefix(const art_node* pNode, size_t nDepth, art_key_bytes& bytes) const
+	{
+		// Every key below the node has the node's prefix at nDepth, so if the node
+		// doesn't store the whole prefix, read it from any leaf below.
+		if(pNode->mnPrefixLength <= kArtMaxStoredPrefix)
+			return pNode->mPrefix;
+
+		DoGetKeyBytes(Internal::art_leftmost((uintptr_t)pNode), bytes);
+		return bytes.mpData + nDepth;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	art_leaf_base* art_map<K, T, KT, A>::DoFind(const uint8_t* pKey, size_t nKeySize) const
+	{
+		uintptr_t ref   = mRoot;
+		size_t    depth = 0;
+
+		while(ref)
+		{
+			if(Internal::art_is_leaf(ref))
+			{
+				art_leaf_base* const pLeaf = Internal::art_to_leaf(ref);
+				return DoLeafMatches(pLeaf, pKey, nKeySize) ? pLeaf : NULL;
+			}
+
+			art_node* const pNode = Internal::art_to_node(ref);
+
+			if(pNode->mnPrefixLength)
+			{
+				// Check only the stored part of the prefix; the leaf comparison catches the rest.
+				if((depth + pNode->mnPrefixLength) > nKeySize)
+					return NULL;
+
+				const size_t nCheck = (pNode->mnPrefixLength < kArtMaxStoredPrefix) ? pNode->mnPrefixLength : kArtMaxStoredPrefix;
+				if(memcmp(pNode->mPrefix, pKey + depth, nCheck) != 0)
+					return NULL;
+
+				depth += pNode->mnPrefixLength;
+			}
+
+			if(depth == nKeySize)
+				return (pNode->mpTerminal && DoLeafMatches(pNode->mpTerminal, pKey, nKeySize)) ? pNode->mpTerminal : NULL;
+
+			const uintptr_t* const pChild = Internal::art_find_child(pNode, pKey[depth]);
+			if(!pChild)
+				return NULL;
+
+			ref = *pChild;
+			++depth;
+		}
+
+		return NULL;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	art_leaf_base* art_map<K, T, KT, A>::DoLowerBound(const uint8_t* pKey, size_t nKeySize) const
+	{
+		// Each step either finds the answer within the current subtree, or finds that
+		// the whole subtree is less than the key, in which case the answer is the leaf
+		// after the subtree's last. Thus there is never any backtracking.
+		art_leaf_base* const pEnd  = const_cast<art_leaf_base*>(&mAnchor);
+		uintptr_t            ref   = mRoot;
+		size_t               depth = 0;
+
+		if(!ref)
+			return pEnd;
+
+		for(;;)
+		{
+			if(Internal::art_is_leaf(ref))
+			{
+				art_leaf_base* const pLeaf = Internal::art_to_leaf(ref);
+				return (DoLeafCompare(pLeaf, pKey, nKeySize) >= 0) ? pLeaf : pLeaf->mpNext;
+			}
+
+			const art_node* const pNode = Internal::art_to_node(ref);
+
+			if(pNode->mnPrefixLength)
+			{
+				art_key_bytes        bytes;
+				const uint8_t* const pPrefix = DoGetPrefix(pNode, depth, bytes);
+
+				for(size_t i = 0; i < pNode->mnPrefixLength; ++i)
+				{
+					if((depth + i) == nKeySize) // The key is a proper prefix of every key in the subtree.
+						return Internal::art_leftmost(ref);
+
+					if(pPrefix[i] != pKey[depth + i])
+						return (pPrefix[i] > pKey[depth + i]) ? Internal::art_leftmost(ref) : Internal::art_rightmost(ref)->mpNext;
+				}
+
+				depth += pNode->mnPrefixLength;
+			}
+
+			if(depth == nKeySize)
+				return Internal::art_leftmost(ref);
+
+			const uintptr_t* const pChild = Internal::art_find_child(const_cast<art_node*>(pNode), pKey[depth]);
+
+			if(!pChild)
+			{
+				const uintptr_t greater = Internal::art_find_child_greater(pNode, pKey[depth]);
+				return greater ? Internal::art_leftmost(greater) : Internal::art_rightmost(ref)->mpNext;
+			}
+
+			ref = *pChild;
+			++depth;
+		}
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	uintptr_t art_map<K, T, KT, A>::DoFindPrefix(const uint8_t* pKey, size_t nKeySize) const
+	{
+		// Returns the smallest subtree containing all the keys which start with pKey, or 0.
+		uintptr_t ref   = mRoot;
+		size_t    depth = 0;
+
+		while(ref)
+		{
+			if(depth == nKeySize)
+				return ref;
+
+			if(Internal::art_is_leaf(ref))
+			{
+				art_key_bytes bytes;
+				DoGetKeyBytes(Internal::art_to_leaf(ref), bytes);
+				return ((bytes.mnSize >= nKeySize) && (memcmp(bytes.mpData, pKey, nKeySize) == 0)) ? ref : 0;
+			}
+
+			const art_node* const pNode = Internal::art_to_node(ref);
+
+			if(pNode->mnPrefixLength)
+			{
+				art_key_bytes        bytes;
+				const uint8_t* const pPrefix = DoGetPrefix(pNode, depth, bytes);
+
+				for(size_t i = 0; i < pNode->mnPrefixLength; ++i)
+				{
+					if((depth + i) == nKeySize)
+						return ref;
+					if(pPrefix[i] != pKey[depth + i])
+						return 0;
+				}
+
+				depth += pNode->mnPrefixLength;
+
+				if(depth == nKeySize)
+					return ref;
+			}
+
+			const uintptr_t* const pChild = Internal::art_find_child(const_cast<art_node*>(pNode), pKey[depth]);
+			ref = pChild ? *pChild : 0;
+			++depth;
+		}
+
+		return 0;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline size_t art_map<K, T, KT, A>::DoNodeSize(uint8_t nType)
+	{
+		switch(nType)
+		{
+			case kArtNode4:  return sizeof(art_node4);
+			case kArtNode16: return sizeof(art_node16);
+			case kArtNode48: return sizeof(art_node48);
+			default:         return sizeof(art_node256);
+		}
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline art_node* art_map<K, T, KT, A>::DoAllocateNode(uint8_t nType)
+	{
+		const size_t    nSize = DoNodeSize(nType);
+		art_node* const pNode = (art_node*)allocate_memory(mAllocator, nSize, EASTL_ALIGN_OF(uintptr_t), 0);
+		EASTL_ASSERT(pNode != NULL);
+
+		memset(pNode, 0, nSize);
+		pNode->mnType = nType;
+		return pNode;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline void art_map<K, T, KT, A>::DoFreeNode(art_node* pNode)
+	{
+		EASTLFree(mAllocator, pNode, DoNodeSize(pNode->mnType));
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline void art_map<K, T, KT, A>::DoCopyHeader(art_node* pDest, const art_node* pSource)
+	{
+		pDest->mpTerminal     = pSource->mpTerminal;
+		pDest->mnPrefixLength = pSource->mnPrefixLength;
+		pDest->mnChildCount   = pSource->mnChildCount;
+		memcpy(pDest->mPrefix, pSource->mPrefix, kArtMaxStoredPrefix);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	void art_map<K, T, KT, A>::DoAddChild(uintptr_t* pRef, uint8_t b, uintptr_t child)
+	{
+		art_node* pNode = Internal::art_to_node(*pRef);
+
+		switch(pNode->mnType)
+		{
+			case kArtNode4:
+			{
+				art_node4* const p = static_cast<art_node4*>(pNode);
+
+				if(p->mnChildCount < 4)
+				{
+					uint32_t i = 0;
+					while((i < p->mnChildCount) && (p->mKeys[i] < b))
+						++i;
+					memmove(p->mKeys + i + 1,     p->mKeys + i,     (p->mnChildCount - i) * sizeof(uint8_t));
+					memmove(p->mChildren + i + 1, p->mChildren + i, (p->mnChildCount - i) * sizeof(uintptr_t));
+					p->mKeys[i]     = b;
+					p->mChildren[i] = child;
+					++p->mnChildCount;
+					return;
+				}
+
+				art_node16* const pNew = static_cast<art_node16*>(DoAllocateNode(kArtNode16));
+				DoCopyHeader(pNew, p);
+				memcpy(pNew->mKeys,     p->mKeys,     sizeof(p->mKeys));
+				memcpy(pNew->mChildren, p->mChildren, sizeof(p->mChildren));
+				*pRef = (uintptr_t)pNew;
+				DoFreeNode(p);
+				break;
+			}
+
+			case kArtNode16:
+			{
+				art_node16* const p = static_cast<art_node16*>(pNode);
+
+				if(p->mnChildCount < 16)
+				{
+					uint32_t i = 0;
+					while((i < p->mnChildCount) && (p->mKeys[i] < b))
+						++i;
+					memmove(p->mKeys + i + 1,     p->mKeys + i,     (p->mnChildCount - i) * sizeof(uint8_t));
+					memmove(p->mChildren + i + 1, p->mChildren + i, (p->mnChildCount - i) * sizeof(uintptr_t));
+					p->mKeys[i]     = b;
+					p->mChildren[i] = child;
+					++p->mnChildCount;
+					return;
+				}
+
+				art_node48* const pNew = static_cast<art_node48*>(DoAllocateNode(kArtNode48));
+				DoCopyHeader(pNew, p);
+				for(uint32_t i = 0; i < 16; ++i)
+				{
+					pNew->mChildIndex[p->mKeys[i]] = (uint8_t)(i + 1);
+					pNew->mChildren[i]             = p->mChildren[i];
+				}
+				*pRef = (uintptr_t)pNew;
+				DoFreeNode(p);
+				break;
+			}
+
+			case kArtNode48:
+			{
+				art_node48* const p = static_cast<art_node48*>(pNode);
+
+				if(p->mnChildCount < 48)
+				{
+					uint32_t i = 0;
+					while(p->mChildren[i])
+						++i;
+					p->mChildren[i]    = child;
+					p->mChildIndex[b]  = (uint8_t)(i + 1);
+					++p->mnChildCount;
+					return;
+				}
+
+				art_node256* const pNew = static_cast<art_node256*>(DoAllocateNode(kArtNode256));
+				DoCopyHeader(pNew, p);
+				for(uint32_t i = 0; i < 256; ++i)
+				{
+					if(p->mChildIndex[i])
+						pNew->mChildren[i] = p->mChildren[p->mChildIndex[i] - 1];
+				}
+				*pRef = (uintptr_t)pNew;
+				DoFreeNode(p);
+				break;
+			}
+
+			default:
+			{
+				art_node256* const p = static_cast<art_node256*>(pNode);
+				p->mChildren[b] = child;
+				++p->mnChildCount;
+				return;
+			}
+		}
+
+		DoAddChild(pRef, b, child); // The node grew; add to the new node.
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	void art_map<K, T, KT, A>::DoRemoveChild(uintptr_t* pRef, uint8_t b)
+	{
+		art_node* const pNode = Internal::art_to_node(*pRef);
+
+		switch(pNode->mnType)
+		{
+			case kArtNode4:
+			case kArtNode16:
+			{
+				// art_node4 and art_node16 differ only in array sizes, so handle both through their own types.
+				uint8_t*   pKeys;
+				uintptr_t* pChildren;
+
+				if(pNode->mnType == kArtNode4)
+				{
+					pKeys     = static_cast<art_node4*>(pNode)->mKeys;
+					pChildren = static_cast<art_node4*>(pNode)->mChildren;
+				}
+				else
+				{
+					pKeys     = static_cast<art_node16*>(pNode)->mKeys;
+					pChildren = static_cast<art_node16*>(pNode)->mChildren;
+				}
+
+				uint32_t i = 0;
+				while(pKeys[i] != b)
+					++i;
+				memmove(pKeys + i,     pKeys + i + 1,     (pNode->mnChildCount - i - 1) * sizeof(uint8_t));
+				memmove(pChildren + i, pChildren + i + 1, (pNode->mnChildCount - i - 1) * sizeof(uintptr_t));
+				--pNode->mnChildCount;
+
+				if((pNode->mnType == kArtNode16) && (pNode->mnChildCount <= 3))
+				{
+					art_node4* const pNew = static_cast<art_node4*>(DoAllocateNode(kArtNode4));
+					DoCopyHeader(pNew, pNode);
+					memcpy(pNew->mKeys,     pKeys,     pNode->mnChildCount * sizeof(uint8_t));
+					memcpy(pNew->mChildren, pChildren, pNode->mnChildCount * sizeof(uintptr_t));
+					*pRef = (uintptr_t)pNew;
+					DoFreeNode(pNode);
+				}
+				break;
+			}
+
+			case kArtNode48:
+			{
+				art_node48* const p = static_cast<art_node48*>(pNode);
+				p->mChildren[p->mChildIndex[b] - 1] = 0;
+				p->mChildIndex[b] = 0;
+				--p->mnChildCount;
+
+				if(p->mnChildCount <= 12)
+				{
+					art_node16* const pNew = static_cast<art_node16*>(DoAllocateNode(kArtNode16));
+					DoCopyHeader(pNew, p);
+					uint32_t n = 0;
+					for(uint32_t i = 0; i < 256; ++i)
+					{
+						if(p->mChildIndex[i])
+						{
+							pNew->mKeys[n]     = (uint8_t)i;
+							pNew->mChildren[n] = p->mChildren[p->mChildIndex[i] - 1];
+							++n;
+						}
+					}
+					*pRef = (uintptr_t)pNew;
+					DoFreeNode(p);
+				}
+				break;
+			}
+
+			default:
+			{
+				art_node256* const p = static_cast<art_node256*>(pNode);
+				p->mChildren[b] = 0;
+				--p->mnChildCount;
+
+				if(p->mnChildCount <= 36)
+				{
+					art_node48* const pNew = static_cast<art_node48*>(DoAllocateNode(kArtNode48));
+					DoCopyHeader(pNew, p);
+					uint32_t n = 0;
+					for(uint32_t i = 0; i < 256; ++i)
+					{
+						if(p->mChildren[i])
+						{
+							pNew->mChildren[n]   = p->mChildren[i];
+							pNew->mChildIndex[i] = (uint8_t)(n + 1);
+							++n;
+						}
+					}
+					*pRef = (uintptr_t)pNew;
+					DoFreeNode(p);
+				}
+				break;
+			}
+		}
+
+		DoCollapse(pRef);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	void art_map<K, T, KT, A>::DoCollapse(uintptr_t* pRef)
+	{
+		// A node with no children is replaced by its terminal leaf, and a node with
+		// one child and no terminal is merged into the child, so that every inner
+		// node branches.
+		art_node* const pNode = Internal::art_to_node(*pRef);
+
+		if(pNode->mnType != kArtNode4)
+			return;
+
+		if(pNode->mnChildCount == 0)
+		{
+			EASTL_ASSERT(pNode->mpTerminal != NULL);
+			*pRef = Internal::art_from_leaf(pNode->mpTerminal);
+			DoFreeNode(pNode);
+		}
+		else if((pNode->mnChildCount == 1) && !pNode->mpTerminal)
+		{
+			art_node4* const p     = static_cast<art_node4*>(pNode);
+			const uintptr_t  child = p->mChildren[0];
+
+			if(!Internal::art_is_leaf(child))
+			{
+				// The child's prefix becomes this prefix, then the byte, then the child's prefix.
+				art_node* const pChild = Internal::art_to_node(child);
+				uint8_t         prefix[kArtMaxStoredPrefix];
+				uint32_t        n = (p->mnPrefixLength < kArtMaxStoredPrefix) ? p->mnPrefixLength : kArtMaxStoredPrefix;
+
+				memcpy(prefix, p->mPrefix, n);
+				if(n < kArtMaxStoredPrefix)
+					prefix[n++] = p->mKeys[0];
+				for(uint32_t i = 0; (n < kArtMaxStoredPrefix) && (i < pChild->mnPrefixLength); ++i)
+					prefix[n++] = pChild->mPrefix[i];
+
+				memcpy(pChild->mPrefix, prefix, n);
+				pChild->mnPrefixLength += p->mnPrefixLength + 1;
+			}
+
+			*pRef = child;
+			DoFreeNode(pNode);
+		}
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	void art_map<K, T, KT, A>::DoInsertLeaf(art_leaf_base* pLeaf, art_leaf_base* pNext)
+	{
+		// Adds pLeaf, whose key is known not to be present, to the tree, then links
+		// it into the list before pNext, which is the lowerBound of its key.
+		art_key_bytes bytes;
+		DoGetKeyBytes(pLeaf, bytes);
+
+		const uint8_t* const pKey     = bytes.mpData;
+		const size_t         nKeySize = bytes.mnSize;
+		uintptr_t*           pRef     = &mRoot;
+		size_t               depth    = 0;
+
+		while(*pRef)
+		{
+			if(Internal::art_is_leaf(*pRef))
+			{
+				// Replace the leaf with a node which branches at the first byte where the keys differ.
+				art_leaf_base* const pOld = Internal::art_to_leaf(*pRef);
+				art_key_bytes        oldBytes;
+				DoGetKeyBytes(pOld, oldBytes);
+
+				size_t i = depth;
+				while((i < nKeySize) && (i < oldBytes.mnSize) && (pKey[i] == oldBytes.mpData[i]))
+					++i;
+
+				art_node* const pNode = DoAllocateNode(kArtNode4);
+				pNode->mnPrefixLength = (uint32_t)(i - depth);
+				memcpy(pNode->mPrefix, pKey + depth, ((i - depth) < kArtMaxStoredPrefix) ? (i - depth) : kArtMaxStoredPrefix);
+				*pRef = (uintptr_t)pNode;
+
+				if(i == oldBytes.mnSize)
+					pNode->mpTerminal = pOld;
+				else
+					DoAddChild(pRef, oldBytes.mpData[i], Internal::art_from_leaf(pOld));
+
+				if(i == nKeySize)
+					pNode->mpTerminal = pLeaf;
+				else
+					DoAddChild(pRef, pKey[i], Internal::art_from_leaf(pLeaf));
+				break;
+			}
+
+			art_node* const pNode = Internal::art_to_node(*pRef);
+
+			if(pNode->mnPrefixLength)
+			{
+				art_key_bytes        prefixBytes;
+				const uint8_t* const pPrefix = DoGetPrefix(pNode, depth, prefixBytes);
+
+				size_t m = 0;
+				while((m < pNode->mnPrefixLength) && ((depth + m) < nKeySize) && (pPrefix[m] == pKey[depth + m]))
+					++m;
+
+				if(m < pNode->mnPrefixLength)
+				{
+					// Split the prefix: a new node takes the matching part, and the old node keeps what follows the byte where they differ.
+					art_node* const pSplit = DoAllocateNode(kArtNode4);
+					const uint8_t   b      = pPrefix[m];
+
+					pSplit->mnPrefixLength = (uint32_t)m;
+					memcpy(pSplit->mPrefix, pPrefix, (m < kArtMaxStoredPrefix) ? m : kArtMaxStoredPrefix);
+
+					const size_t nRemaining = pNode->mnPrefixLength - m - 1;
+					memmove(pNode->mPrefix, pPrefix + m + 1, (nRemaining < kArtMaxStoredPrefix) ? nRemaining : kArtMaxStoredPrefix);
+					pNode->mnPrefixLength = (uint32_t)nRemaining;
+
+					*pRef = (uintptr_t)pSplit;
+					DoAddChild(pRef, b, (uintptr_t)pNode);
+
+					if((depth + m) == nKeySize)
+						pSplit->mpTerminal = pLeaf;
+					else
+						DoAddChild(pRef, pKey[depth + m], Internal::art_from_leaf(pLeaf));
+					break;
+				}
+
+				depth += pNode->mnPrefixLength;
+			}
+
+			if(depth == nKeySize)
+			{
+				EASTL_ASSERT(pNode->mpTerminal == NULL);
+				pNode->mpTerminal = pLeaf;
+				break;
+			}
+
+			uintptr_t* const pChild = Internal::art_find_child(pNode, pKey[depth]);
+
+			if(!pChild)
+			{
+				DoAddChild(pRef, pKey[depth], Internal::art_from_leaf(pLeaf));
+				break;
+			}
+
+			pRef = pChild;
+			++depth;
+		}
+
+		if(!mRoot)
+			mRoot = Internal::art_from_leaf(pLeaf);
+
+		DoLinkAndCount(pLeaf, pNext);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline void art_map<K, T, KT, A>::DoLinkAndCount(art_leaf_base* pLeaf, art_leaf_base* pNext)
+	{
+		pLeaf->mpNext         = pNext;
+		pLeaf->mpPrev         = pNext->mpPrev;
+		pNext->mpPrev->mpNext = pLeaf;
+		pNext->mpPrev         = pLeaf;
+		++mnSize;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	art_leaf_base* art_map<K, T, KT, A>::DoRemoveLeaf(const uint8_t* pKey, size_t nKeySize)
+	{
+		// Removes the leaf for the key from the tree, but not from the list, and returns it, or NULL.
+		uintptr_t* pRef  = &mRoot;
+		size_t     depth = 0;
+
+		while(*pRef)
+		{
+			if(Internal::art_is_leaf(*pRef)) // Only the root can be a leaf here.
+			{
+				art_leaf_base* const pLeaf = Internal::art_to_leaf(*pRef);
+				if(!DoLeafMatches(pLeaf, pKey, nKeySize))
+					return NULL;
+				*pRef = 0;
+				return pLeaf;
+			}
+
+			art_node* const pNode = Internal::art_to_node(*pRef);
+
+			if(pNode->mnPrefixLength)
+			{
+				if((depth + pNode->mnPrefixLength) > nKeySize)
+					return NULL;
+
+				const size_t nCheck = (pNode->mnPrefixLength < kArtMaxStoredPrefix) ? pNode->mnPrefixLength : kArtMaxStoredPrefix;
+				if(memcmp(pNode->mPrefix, pKey + depth, nCheck) != 0)
+					return NULL;
+
+				depth += pNode->mnPrefixLength;
+			}
+
+			if(depth == nKeySize)
+			{
+				art_leaf_base* const pLeaf = pNode->mpTerminal;
+				if(!pLeaf || !DoLeafMatches(pLeaf, pKey, nKeySize))
+					return NULL;
+				pNode->mpTerminal = NULL;
+				DoCollapse(pRef);
+				return pLeaf;
+			}
+
+			uintptr_t* const pChild = Internal::art_find_child(pNode, pKey[depth]);
+			if(!pChild)
+				return NULL;
+
+			if(Internal::art_is_leaf(*pChild))
+			{
+				art_leaf_base* const pLeaf = Internal::art_to_leaf(*pChild);
+				if(!DoLeafMatches(pLeaf, pKey, nKeySize))
+					return NULL;
+				DoRemoveChild(pRef, pKey[depth]);
+				return pLeaf;
+			}
+
+			pRef = pChild;
+			++depth;
+		}
+
+		return NULL;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::leaf_type*
+	art_map<K, T, KT, A>::DoAllocateLeaf()
+	{
+		leaf_type* const pLeaf = (leaf_type*)allocate_memory(mAllocator, sizeof(leaf_type), EASTL_ALIGN_OF(leaf_type), 0);
+		EASTL_ASSERT(pLeaf != NULL);
+		return pLeaf;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline void art_map<K, T, KT, A>::DoFreeLeaf(leaf_type* pLeaf)
+	{
+		pLeaf->~leaf_type();
+		EASTLFree(mAllocator, pLeaf, sizeof(leaf_type));
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	typename art_map<K, T, KT, A>::insert_return_type
+	art_map<K, T, KT, A>::insert(const value_type& value)
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(value.first, bytes);
+
+		art_leaf_base* const pNext = DoLowerBound(bytes.mpData, bytes.mnSize);
+		if((pNext != &mAnchor) && DoLeafMatches(pNext, bytes.mpData, bytes.mnSize))
+			return insert_return_type(iterator(pNext), false);
+
+		leaf_type* const pLeaf = DoAllocateLeaf();
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+				::new((void*)&pLeaf->mValue) value_type(value);
+			}
+			catch(...)
+			{
+				EASTLFree(mAllocator, pLeaf, sizeof(leaf_type));
+				throw;
+			}
+		#else
+			::new((void*)&pLeaf->mValue) value_type(value);
+		#endif
+
+		DoInsertLeaf(pLeaf, pNext);
+		return insert_return_type(iterator(pLeaf), true);
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename T, typename KT, typename A>
+		typename art_map<K, T, KT, A>::insert_return_type
+		art_map<K, T, KT, A>::insert(value_type&& value)
+		{
+			art_key_bytes bytes;
+			KT::get_bytes(value.first, bytes);
+
+			art_leaf_base* const pNext = DoLowerBound(bytes.mpData, bytes.mnSize);
+			if((pNext != &mAnchor) && DoLeafMatches(pNext, bytes.mpData, bytes.mnSize))
+				return insert_return_type(iterator(pNext), false);
+
+			leaf_type* const pLeaf = DoAllocateLeaf();
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+					::new((void*)&pLeaf->mValue) value_type(eastl::move(value));
+				}
+				catch(...)
+				{
+					EASTLFree(mAllocator, pLeaf, sizeof(leaf_type));
+					throw;
+				}
+			#else
+				::new((void*)&pLeaf->mValue) value_type(eastl::move(value));
+			#endif
+
+			DoInsertLeaf(pLeaf, pNext); // This gets the key bytes from the leaf, as value's key may have been moved from.
+			return insert_return_type(iterator(pLeaf), true);
+		}
+	#endif
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::iterator
+	art_map<K, T, KT, A>::insert(const_iterator /*position*/, const value_type& value)
+	{
+		return insert(value).first;
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename T, typename KT, typename A>
+		inline typename art_map<K, T, KT, A>::iterator
+		art_map<K, T, KT, A>::insert(const_iterator /*position*/, value_type&& value)
+		{
+			return insert(eastl::move(value)).first;
+		}
+	#endif
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED && EASTL_VARIADIC_TEMPLATES_ENABLED
+		template <typename K, typename T, typename KT, typename A>
+		template <class... Args>
+		typename art_map<K, T, KT, A>::insert_return_type
+		art_map<K, T, KT, A>::emplace(Args&&... args)
+		{
+			// The key isn't known until the value is constructed, so construct it
+			// in a new leaf and free the leaf again if the key is already present.
+			leaf_type* const pLeaf = DoAllocateLeaf();
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+					::new((void*)&pLeaf->mValue) value_type(eastl::forward<Args>(args)...);
+				}
+				catch(...)
+				{
+					EASTLFree(mAllocator, pLeaf, sizeof(leaf_type));
+					throw;
+				}
+			#else
+				::new((void*)&pLeaf->mValue) value_type(eastl::forward<Args>(args)...);
+			#endif
+
+			art_key_bytes bytes;
+			DoGetKeyBytes(pLeaf, bytes);
+
+			art_leaf_base* const pNext = DoLowerBound(bytes.mpData, bytes.mnSize);
+			if((pNext != &mAnchor) && DoLeafMatches(pNext, bytes.mpData, bytes.mnSize))
+			{
+				DoFreeLeaf(pLeaf);
+				return insert_return_type(iterator(pNext), false);
+			}
+
+			DoInsertLeaf(pLeaf, pNext);
+			return insert_return_type(iterator(pLeaf), true);
+		}
+
+		template <typename K, typename T, typename KT, typename A>
+		template <class... Args>
+		inline typename art_map<K, T, KT, A>::iterator
+		art_map<K, T, KT, A>::emplace_hint(const_iterator /*position*/, Args&&... args)
+		{
+			return emplace(eastl::forward<Args>(args)...).first;
+		}
+	#else
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			template <typename K, typename T, typename KT, typename A>
+			inline typename art_map<K, T, KT, A>::insert_return_type
+			art_map<K, T, KT, A>::emplace(value_type&& value)
+			{
+				return insert(eastl::move(value));
+			}
+
+			template <typename K, typename T, typename KT, typename A>
+			inline typename art_map<K, T, KT, A>::iterator
+			art_map<K, T, KT, A>::emplace_hint(const_iterator /*position*/, value_type&& value)
+			{
+				return insert(eastl::move(value)).first;
+			}
+		#endif
+
+		template <typename K, typename T, typename KT, typename A>
+		inline typename art_map<K, T, KT, A>::insert_return_type
+		art_map<K, T, KT, A>::emplace(const value_type& value)
+		{
+			return insert(value);
+		}
+
+		template <typename K, typename T, typename KT, typename A>
+		inline typename art_map<K, T, KT, A>::iterator
+		art_map<K, T, KT, A>::emplace_hint(const_iterator /*position*/, const value_type& value)
+		{
+			return insert(value).first;
+		}
+	#endif
+
+
+	template <typename K, typename T, typename KT, typename A>
+	typename art_map<K, T, KT, A>::insert_return_type
+	art_map<K, T, KT, A>::insert(const key_type& key)
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(key, bytes);
+
+		art_leaf_base* const pNext = DoLowerBound(bytes.mpData, bytes.mnSize);
+		if((pNext != &mAnchor) && DoLeafMatches(pNext, bytes.mpData, bytes.mnSize))
+			return insert_return_type(iterator(pNext), false);
+
+		leaf_type* const pLeaf = DoAllocateLeaf();
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+				::new((void*)&pLeaf->mValue) value_type(key);
+			}
+			catch(...)
+			{
+				EASTLFree(mAllocator, pLeaf, sizeof(leaf_type));
+				throw;
+			}
+		#else
+			::new((void*)&pLeaf->mValue) value_type(key);
+		#endif
+
+		DoInsertLeaf(pLeaf, pNext);
+		return insert_return_type(iterator(pLeaf), true);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	template <typename InputIterator>
+	inline void art_map<K, T, KT, A>::insert(InputIterator first, InputIterator last)
+	{
+		for(; first != last; ++first)
+			insert(*first);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline void art_map<K, T, KT, A>::insert(std::initializer_list<value_type> ilist)
+	{
+		insert(ilist.begin(), ilist.end());
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	typename art_map<K, T, KT, A>::size_type
+	art_map<K, T, KT, A>::erase(const key_type& key)
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(key, bytes);
+
+		art_leaf_base* const pLeaf = DoRemoveLeaf(bytes.mpData, bytes.mnSize);
+
+		if(pLeaf)
+		{
+			pLeaf->mpPrev->mpNext = pLeaf->mpNext;
+			pLeaf->mpNext->mpPrev = pLeaf->mpPrev;
+			--mnSize;
+			DoFreeLeaf(static_cast<leaf_type*>(pLeaf));
+			return 1;
+		}
+
+		return 0;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	typename art_map<K, T, KT, A>::iterator
+	art_map<K, T, KT, A>::erase(const_iterator position)
+	{
+		art_leaf_base* const pLeaf = position.mpLeaf;
+		art_leaf_base* const pNext = pLeaf->mpNext;
+
+		art_key_bytes bytes;
+		DoGetKeyBytes(pLeaf, bytes);
+
+		#if EASTL_ASSERT_ENABLED
+			art_leaf_base* const pRemoved = DoRemoveLeaf(bytes.mpData, bytes.mnSize);
+			EASTL_ASSERT(pRemoved == pLeaf);
+		#else
+			DoRemoveLeaf(bytes.mpData, bytes.mnSize);
+		#endif
+
+		pLeaf->mpPrev->mpNext = pNext;
+		pNext->mpPrev         = pLeaf->mpPrev;
+		--mnSize;
+		DoFreeLeaf(static_cast<leaf_type*>(pLeaf));
+
+		return iterator(pNext);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	typename art_map<K, T, KT, A>::iterator
+	art_map<K, T, KT, A>::erase(const_iterator first, const_iterator last)
+	{
+		if((first == cbegin()) && (last == cend()))
+		{
+			clear();
+			return end();
+		}
+
+		while(first != last)
+			first = erase(first);
+
+		return iterator(last.mpLeaf);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::reverse_iterator
+	art_map<K, T, KT, A>::erase(const_reverse_iterator position)
+	{
+		return reverse_iterator(erase((++position).base()));
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::reverse_iterator
+	art_map<K, T, KT, A>::erase(const_reverse_iterator first, const_reverse_iterator last)
+	{
+		// The reverse range [first, last) is the forward range [last.base(), first.base()).
+		return reverse_iterator(erase(last.base(), first.base()));
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	void art_map<K, T, KT, A>::DoFreeNodes(uintptr_t ref)
+	{
+		if(Internal::art_is_leaf(ref))
+			return;
+
+		art_node* const pNode = Internal::art_to_node(ref);
+
+		switch(pNode->mnType)
+		{
+			case kArtNode4:
+				for(uint32_t i = 0; i < pNode->mnChildCount; ++i)
+					DoFreeNodes(static_cast<art_node4*>(pNode)->mChildren[i]);
+				break;
+
+			case kArtNode16:
+				for(uint32_t i = 0; i < pNode->mnChildCount; ++i)
+					DoFreeNodes(static_cast<art_node16*>(pNode)->mChildren[i]);
+				break;
+
+			case kArtNode48:
+				for(uint32_t i = 0; i < 48; ++i)
+				{
+					if(static_cast<art_node48*>(pNode)->mChildren[i])
+						DoFreeNodes(static_cast<art_node48*>(pNode)->mChildren[i]);
+				}
+				break;
+
+			default:
+				for(uint32_t i = 0; i < 256; ++i)
+				{
+					if(static_cast<art_node256*>(pNode)->mChildren[i])
+						DoFreeNodes(static_cast<art_node256*>(pNode)->mChildren[i]);
+				}
+				break;
+		}
+
+		DoFreeNode(pNode);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	void art_map<K, T, KT, A>::clear()
+	{
+		// Free the inner nodes through the tree, and the leaves through the list.
+		if(mRoot)
+			DoFreeNodes(mRoot);
+
+		for(art_leaf_base* p = mAnchor.mpNext; p != &mAnchor; )
+		{
+			art_leaf_base* const pNext = p->mpNext;
+			DoFreeLeaf(static_cast<leaf_type*>(p));
+			p = pNext;
+		}
+
+		mRoot          = 0;
+		mAnchor.mpNext = mAnchor.mpPrev = &mAnchor;
+		mnSize         = 0;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::iterator
+	art_map<K, T, KT, A>::find(const key_type& key)
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(key, bytes);
+
+		art_leaf_base* const pLeaf = DoFind(bytes.mpData, bytes.mnSize);
+		return iterator(pLeaf ? pLeaf : &mAnchor);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::const_iterator
+	art_map<K, T, KT, A>::find(const key_type& key) const
+	{
+		return const_cast<this_type*>(this)->find(key);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::size_type
+	art_map<K, T, KT, A>::count(const key_type& key) const
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(key, bytes);
+
+		return DoFind(bytes.mpData, bytes.mnSize) ? 1 : 0;
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::iterator
+	art_map<K, T, KT, A>::lowerBound(const key_type& key)
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(key, bytes);
+
+		return iterator(DoLowerBound(bytes.mpData, bytes.mnSize));
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::const_iterator
+	art_map<K, T, KT, A>::lowerBound(const key_type& key) const
+	{
+		return const_cast<this_type*>(this)->lowerBound(key);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::iterator
+	art_map<K, T, KT, A>::upperBound(const key_type& key)
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(key, bytes);
+
+		art_leaf_base* const pLeaf = DoLowerBound(bytes.mpData, bytes.mnSize);
+
+		if((pLeaf != &mAnchor) && DoLeafMatches(pLeaf, bytes.mpData, bytes.mnSize))
+			return iterator(pLeaf->mpNext);
+		return iterator(pLeaf);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline typename art_map<K, T, KT, A>::const_iterator
+	art_map<K, T, KT, A>::upperBound(const key_type& key) const
+	{
+		return const_cast<this_type*>(this)->upperBound(key);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline eastl::pair<typename art_map<K, T, KT, A>::iterator, typename art_map<K, T, KT, A>::iterator>
+	art_map<K, T, KT, A>::equalRange(const key_type& key)
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(key, bytes);
+
+		art_leaf_base* const pLeaf = DoLowerBound(bytes.mpData, bytes.mnSize);
+
+		if((pLeaf != &mAnchor) && DoLeafMatches(pLeaf, bytes.mpData, bytes.mnSize))
+			return eastl::pair<iterator, iterator>(iterator(pLeaf), iterator(pLeaf->mpNext));
+		return eastl::pair<iterator, iterator>(iterator(pLeaf), iterator(pLeaf));
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline eastl::pair<typename art_map<K, T, KT, A>::const_iterator, typename art_map<K, T, KT, A>::const_iterator>
+	art_map<K, T, KT, A>::equalRange(const key_type& key) const
+	{
+		const eastl::pair<iterator, iterator> range = const_cast<this_type*>(this)->equalRange(key);
+		return eastl::pair<const_iterator, const_iterator>(range.first, range.second);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline eastl::pair<typename art_map<K, T, KT, A>::iterator, typename art_map<K, T, KT, A>::iterator>
+	art_map<K, T, KT, A>::prefixRange(const uint8_t* pPrefix, size_t nPrefixSize)
+	{
+		const uintptr_t ref = DoFindPrefix(pPrefix, nPrefixSize);
+
+		if(ref)
+			return eastl::pair<iterator, iterator>(iterator(Internal::art_leftmost(ref)), iterator(Internal::art_rightmost(ref)->mpNext));
+		return eastl::pair<iterator, iterator>(end(), end());
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline eastl::pair<typename art_map<K, T, KT, A>::const_iterator, typename art_map<K, T, KT, A>::const_iterator>
+	art_map<K, T, KT, A>::prefixRange(const uint8_t* pPrefix, size_t nPrefixSize) const
+	{
+		const eastl::pair<iterator, iterator> range = const_cast<this_type*>(this)->prefixRange(pPrefix, nPrefixSize);
+		return eastl::pair<const_iterator, const_iterator>(range.first, range.second);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline eastl::pair<typename art_map<K, T, KT, A>::iterator, typename art_map<K, T, KT, A>::iterator>
+	art_map<K, T, KT, A>::prefixRange(const key_type& prefix)
+	{
+		art_key_bytes bytes;
+		KT::get_bytes(prefix, bytes);
+
+		return prefixRange(bytes.mpData, bytes.mnSize);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	inline eastl::pair<typename art_map<K, T, KT, A>::const_iterator, typename art_map<K, T, KT, A>::const_iterator>
+	art_map<K, T, KT, A>::prefixRange(const key_type& prefix) const
+	{
+		const eastl::pair<iterator, iterator> range = const_cast<this_type*>(this)->prefixRange(prefix);
+		return eastl::pair<const_iterator, const_iterator>(range.first, range.second);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	bool art_map<K, T, KT, A>::DoValidateNode(uintptr_t ref, size_t nDepth, size_t& nLeafCount) const
+	{
+		if(Internal::art_is_leaf(ref))
+		{
+			++nLeafCount;
+			return true;
+		}
+
+		const art_node* const pNode = Internal::art_to_node(ref);
+
+		// Every leaf below must have the stored prefix at nDepth.
+		art_key_bytes bytes;
+		DoGetKeyBytes(Internal::art_leftmost(ref), bytes);
+		const size_t nCheck = (pNode->mnPrefixLength < kArtMaxStoredPrefix) ? pNode->mnPrefixLength : kArtMaxStoredPrefix;
+		if((bytes.mnSize < (nDepth + pNode->mnPrefixLength)) || (memcmp(bytes.mpData + nDepth, pNode->mPrefix, nCheck) != 0))
+			return false;
+
+		const size_t nChildDepth = nDepth + pNode->mnPrefixLength + 1;
+
+		if(pNode->mpTerminal)
+		{
+			DoGetKeyBytes(pNode->mpTerminal, bytes);
+			if(bytes.mnSize != (nChildDepth - 1))
+				return false;
+			++nLeafCount;
+		}
+
+		// Every inner node must branch, or it should have been collapsed.
+		if((pNode->mnChildCount + (pNode->mpTerminal ? 1 : 0)) < 2)
+			return false;
+
+		uint32_t nCount = 0;
+
+		switch(pNode->mnType)
+		{
+			case kArtNode4:
+			case kArtNode16:
+			{
+				const uint8_t*   pKeys     = (pNode->mnType == kArtNode4) ? static_cast<const art_node4*>(pNode)->mKeys     : static_cast<const art_node16*>(pNode)->mKeys;
+				const uintptr_t* pChildren = (pNode->mnType == kArtNode4) ? static_cast<const art_node4*>(pNode)->mChildren : static_cast<const art_node16*>(pNode)->mChildren;
+
+				if(pNode->mnChildCount > ((pNode->mnType == kArtNode4) ? 4 : 16))
+					return false;
+
+				for(uint32_t i = 0; i < pNode->mnChildCount; ++i)
+				{
+					if(((i > 0) && (pKeys[i - 1] >= pKeys[i])) || !pChildren[i])
+						return false;
+					DoGetKeyBytes(Internal::art_leftmost(pChildren[i]), bytes);
+					if((bytes.mnSize < nChildDepth) || (bytes.mpData[nChildDepth - 1] != pKeys[i]))
+						return false;
+					if(!DoValidateNode(pChildren[i], nChildDepth, nLeafCount))
+						return false;
+					++nCount;
+				}
+				break;
+			}
+
+			case kArtNode48:
+			{
+				const art_node48* const p = static_cast<const art_node48*>(pNode);
+				for(uint32_t i = 0; i < 256; ++i)
+				{
+					if(p->mChildIndex[i])
+					{
+						const uintptr_t child = p->mChildren[p->mChildIndex[i] - 1];
+						DoGetKeyBytes(Internal::art_leftmost(child), bytes);
+						if(!child || (bytes.mnSize < nChildDepth) || (bytes.mpData[nChildDepth - 1] != i))
+							return false;
+						if(!DoValidateNode(child, nChildDepth, nLeafCount))
+							return false;
+						++nCount;
+					}
+				}
+				break;
+			}
+
+			default:
+			{
+				const art_node256* const p = static_cast<const art_node256*>(pNode);
+				for(uint32_t i = 0; i < 256; ++i)
+				{
+					if(p->mChildren[i])
+					{
+						DoGetKeyBytes(Internal::art_leftmost(p->mChildren[i]), bytes);
+						if((bytes.mnSize < nChildDepth) || (bytes.mpData[nChildDepth - 1] != i))
+							return false;
+						if(!DoValidateNode(p->mChildren[i], nChildDepth, nLeafCount))
+							return false;
+						++nCount;
+					}
+				}
+				break;
+			}
+		}
+
+		return (nCount == pNode->mnChildCount);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	bool art_map<K, T, KT, A>::validate() const
+	{
+		// Check the tree, then check that the list is in strictly increasing key order and that every leaf can be found.
+		size_t nLeafCount = 0;
+
+		if(mRoot && !DoValidateNode(mRoot, 0, nLeafCount))
+			return false;
+
+		if(nLeafCount != mnSize)
+			return false;
+
+		size_t nListCount = 0;
+
+		for(const art_leaf_base* p = mAnchor.mpNext; p != &mAnchor; p = p->mpNext)
+		{
+			if(p->mpNext->mpPrev != p)
+				return false;
+
+			art_key_bytes bytes;
+			DoGetKeyBytes(p, bytes);
+
+			if(DoFind(bytes.mpData, bytes.mnSize) != p)
+				return false;
+
+			if((p->mpNext != &mAnchor) && (DoLeafCompare(p->mpNext, bytes.mpData, bytes.mnSize) <= 0))
+				return false;
+
+			if(++nListCount > mnSize)
+				return false;
+		}
+
+		return (nListCount == mnSize);
+	}
+
+
+	template <typename K, typename T, typename KT, typename A>
+	int art_map<K, T, KT, A>::validateIterator(const_iterator i) const
+	{
+		for(const_iterator temp = begin(), tempEnd = end(); temp != tempEnd; ++temp)
+		{
+			if(temp == i)
+				return (isf_valid | isf_current | isf_can_dereference);
+		}
+
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename KT, typename A>
+	inline bool operator==(const art_map<K, T, KT, A>& a, const art_map<K, T, KT, A>& b)
+	{
+		return (a.size() == b.size()) && eastl::equal(a.begin(), a.end(), b.begin());
+	}
+
+	template <typename K, typename T, typename KT, typename A>
+	inline bool operator!=(const art_map<K, T, KT, A>& a, const art_map<K, T, KT, A>& b)
+	{
+		return !(a == b);
+	}
+
+	template <typename K, typename T, typename KT, typename A>
+	inline void swap(art_map<K, T, KT, A>& a, art_map<K, T, KT, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
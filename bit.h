@@ -0,0 +1,555 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements the bit manipulation functions of C++20 <bit> and
+// C++23 byteswap, plus bit_reverse, pdep and pext. They work on any unsigned
+// integral type, including eastl_uint128_t where it is supported.
+//
+// Each function maps to the compiler builtin or intrinsic where one exists,
+// and to the popcnt, lzcnt, tzcnt and pdep/pext instructions when the build
+// targets a CPU that has them (see EA_POPCNT, EA_LZCNT, EA_BMI1 and EA_BMI2).
+// Otherwise a portable fallback is used. The choice is made at compile time;
+// there is no runtime dispatch.
+//
+// Unlike the GCC builtins, countl_zero and countr_zero are defined for zero,
+// where they return the width of the type.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_BIT_H
+#define EASTL_BIT_H
+
+
+#include <eastl/internal/config.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#if defined(_MSC_VER)
+	#pragma warning(push, 0)
+	#include <intrin.h>
+	#pragma warning(pop)
+#elif (EA_LZCNT || EA_BMI1 || EA_BMI2) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+	#include <immintrin.h>
+#endif
+
+
+
+namespace eastl
+{
+	namespace Internal
+	{
+		/// bit_uint
+		///
+		/// Maps a size in bytes to the unsigned integer type of that size.
+		///
+		template <size_t nSize> struct bit_uint;
+		template <> struct bit_uint<1> { typedef uint8_t  type; };
+		template <> struct bit_uint<2> { typedef uint16_t type; };
+		template <> struct bit_uint<4> { typedef uint32_t type; };
+		template <> struct bit_uint<8> { typedef uint64_t type; };
+		#if EASTL_INT128_SUPPORTED
+			template <> struct bit_uint<16> { typedef eastl_uint128_t type; };
+		#endif
+
+
+		/// bit_word
+		///
+		/// The type the operations on T are done in. Types narrower than 32 bits
+		/// are widened, as there are no 8 or 16 bit versions of most instructions.
+		///
+		template <typename T>
+		struct bit_word
+		{
+			EASTL_CT_ASSERT_MSG(T(-1) > T(0), "The bit functions are only defined for unsigned types.");
+
+			typedef typename bit_uint<(sizeof(T) < 4) ? 4 : sizeof(T)>::type type;
+
+			static const int kDigits = (int)(sizeof(T) * 8);
+			static const int kPad    = (int)(sizeof(type) - sizeof(T)) * 8; // The number of high bits the widening adds.
+		};
+
+
+
+		// popcount
+
+		inline int bit_popcount(uint32_t x)
+		{
+			#if defined(__GNUC__) || defined(__clang__)
+				return __builtin_popcount(x);
+			#elif defined(_MSC_VER) && EA_POPCNT
+				return (int)__popcnt(x);
+			#else
+				x = x - ((x >> 1) & 0x55555555);
+				x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+				x = (x + (x >> 4)) & 0x0F0F0F0F;
+				return (int)((x * 0x01010101) >> 24);
+			#endif
+		}
+
+		inline int bit_popcount(uint64_t x)
+		{
+			#if defined(__GNUC__) || defined(__clang__)
+				return __builtin_popcountll(x);
+			#elif defined(_MSC_VER) && EA_POPCNT && defined(EA_PROCESSOR_X86_64)
+				return (int)__popcnt64(x);
+			#else
+				x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+				x = (x & UINT64_C(0x3333333333333333)) + ((x >> 2) & UINT64_C(0x3333333333333333));
+				x = (x + (x >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+				return (int)((x * UINT64_C(0x0101010101010101)) >> 56);
+			#endif
+		}
+
+
+
+		// countl_zero
+		// Returns the width of the type for x == 0.
+
+		inline int bit_countl_zero(uint32_t x)
+		{
+			#if EA_LZCNT && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				return (int)_lzcnt_u32(x);
+			#elif defined(__GNUC__) || defined(__clang__)
+				return x ? __builtin_clz(x) : 32;
+			#elif defined(_MSC_VER)
+				unsigned long nIndex;
+				return _BitScanReverse(&nIndex, x) ? (31 - (int)nIndex) : 32;
+			#else
+				if(!x)
+					return 32;
+				int n = 0;
+				if(!(x & 0xFFFF0000)) { n += 16; x <<= 16; }
+				if(!(x & 0xFF000000)) { n +=  8; x <<=  8; }
+				if(!(x & 0xF0000000)) { n +=  4; x <<=  4; }
+				if(!(x & 0xC0000000)) { n +=  2; x <<=  2; }
+				if(!(x & 0x80000000)) { n +=  1; }
+				return n;
+			#endif
+		}
+
+		inline int bit_countl_zero(uint64_t x)
+		{
+			#if EA_LZCNT && defined(EA_PROCESSOR_X86_64)
+				return (int)_lzcnt_u64(x);
+			#elif defined(__GNUC__) || defined(__clang__)
+				return x ? __builtin_clzll(x) : 64;
+			#elif defined(_MSC_VER) && defined(EA_PROCESSOR_X86_64)
+				unsigned long nIndex;
+				return _BitScanReverse64(&nIndex, x) ? (63 - (int)nIndex) : 64;
+			#else
+				const uint32_t hi = (uint32_t)(x >> 32);
+				return hi ? bit_countl_zero(hi) : (32 + bit_countl_zero((uint32_t)x));
+			#endif
+		}
+
+
+
+		// countr_zero
+		// Returns the width of the type for x == 0.
+
+		inline int bit_countr_zero(uint32_t x)
+		{
+			#if EA_BMI1 && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				return (int)_tzcnt_u32(x);
+			#elif defined(__GNUC__) || defined(__clang__)
+				return x ? __builtin_ctz(x) : 32;
+			#elif defined(_MSC_VER)
+				unsigned long nIndex;
+				return _BitScanForward(&nIndex, x) ? (int)nIndex : 32;
+			#else
+				if(!x)
+					return 32;
+				int n = 0;
+				if(!(x & 0x0000FFFF)) { n += 16; x >>= 16; }
+				if(!(x & 0x000000FF)) { n +=  8; x >>=  8; }
+				if(!(x & 0x0000000F)) { n +=  4; x >>=  4; }
+				if(!(x & 0x00000003)) { n +=  2; x >>=  2; }
+				if(!(x & 0x00000001)) { n +=  1; }
+				return n;
+			#endif
+		}
+
+		inline int bit_countr_zero(uint64_t x)
+		{
+			#if EA_BMI1 && defined(EA_PROCESSOR_X86_64)
+				return (int)_tzcnt_u64(x);
+			#elif defined(__GNUC__) || defined(__clang__)
+				return x ? __builtin_ctzll(x) : 64;
+			#elif defined(_MSC_VER) && defined(EA_PROCESSOR_X86_64)
+				unsigned long nIndex;
+				return _BitScanForward64(&nIndex, x) ? (int)nIndex : 64;
+			#else
+				const uint32_t lo = (uint32_t)x;
+				return lo ? bit_countr_zero(lo) : (32 + bit_countr_zero((uint32_t)(x >> 32)));
+			#endif
+		}
+
+
+
+		// byteswap
+
+		inline uint8_t bit_byteswap(uint8_t x)
+			{ return x; }
+
+		inline uint16_t bit_byteswap(uint16_t x)
+		{
+			#if defined(__GNUC__) || defined(__clang__)
+				return __builtin_bswap16(x);
+			#elif defined(_MSC_VER)
+				return _byteswap_ushort(x);
+			#else
+				return (uint16_t)((x << 8) | (x >> 8));
+			#endif
+		}
+
+		inline uint32_t bit_byteswap(uint32_t x)
+		{
+			#if defined(__GNUC__) || defined(__clang__)
+				return __builtin_bswap32(x);
+			#elif defined(_MSC_VER)
+				return _byteswap_ulong(x);
+			#else
+				x = ((x & 0x00FF00FF) << 8) | ((x >> 8) & 0x00FF00FF);
+				return (x << 16) | (x >> 16);
+			#endif
+		}
+
+		inline uint64_t bit_byteswap(uint64_t x)
+		{
+			#if defined(__GNUC__) || defined(__clang__)
+				return __builtin_bswap64(x);
+			#elif defined(_MSC_VER)
+				return _byteswap_uint64(x);
+			#else
+				return ((uint64_t)bit_byteswap((uint32_t)x) << 32) | bit_byteswap((uint32_t)(x >> 32));
+			#endif
+		}
+
+
+
+		// bit_reverse
+
+		inline uint32_t bit_reverse(uint32_t x)
+		{
+			#if defined(__clang__) && defined(__has_builtin)
+				#if __has_builtin(__builtin_bitreverse32)
+					return __builtin_bitreverse32(x);
+				#endif
+			#endif
+			x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+			x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+			x = ((x >> 4) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 4);
+			return bit_byteswap(x);
+		}
+
+		inline uint64_t bit_reverse(uint64_t x)
+		{
+			#if defined(__clang__) && defined(__has_builtin)
+				#if __has_builtin(__builtin_bitreverse64)
+					return __builtin_bitreverse64(x);
+				#endif
+			#endif
+			x = ((x >> 1) & UINT64_C(0x5555555555555555)) | ((x & UINT64_C(0x5555555555555555)) << 1);
+			x = ((x >> 2) & UINT64_C(0x3333333333333333)) | ((x & UINT64_C(0x3333333333333333)) << 2);
+			x = ((x >> 4) & UINT64_C(0x0F0F0F0F0F0F0F0F)) | ((x & UINT64_C(0x0F0F0F0F0F0F0F0F)) << 4);
+			return bit_byteswap(x);
+		}
+
+
+
+		// pdep / pext
+		// The fallbacks walk the set bits of the mask, one per iteration.
+
+		template <typename T>
+		inline T bit_pdep_generic(T src, T mask)
+		{
+			T result = 0;
+
+			for(T bit = 1; mask; bit += bit)
+			{
+				if(src & bit)
+					result |= (mask & (T)(0 - mask));
+				mask &= (mask - 1);
+			}
+
+			return result;
+		}
+
+		template <typename T>
+		inline T bit_pext_generic(T src, T mask)
+		{
+			T result = 0;
+
+			for(T bit = 1; mask; bit += bit)
+			{
+				if(src & mask & (T)(0 - mask))
+					result |= bit;
+				mask &= (mask - 1);
+			}
+
+			return result;
+		}
+
+		inline uint32_t bit_pdep(uint32_t src, uint32_t mask)
+		{
+			#if EA_BMI2 && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				return _pdep_u32(src, mask);
+			#else
+				return bit_pdep_generic(src, mask);
+			#endif
+		}
+
+		inline uint64_t bit_pdep(uint64_t src, uint64_t mask)
+		{
+			#if EA_BMI2 && defined(EA_PROCESSOR_X86_64)
+				return _pdep_u64(src, mask);
+			#else
+				return bit_pdep_generic(src, mask);
+			#endif
+		}
+
+		inline uint32_t bit_pext(uint32_t src, uint32_t mask)
+		{
+			#if EA_BMI2 && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				return _pext_u32(src, mask);
+			#else
+				return bit_pext_generic(src, mask);
+			#endif
+		}
+
+		inline uint64_t bit_pext(uint64_t src, uint64_t mask)
+		{
+			#if EA_BMI2 && defined(EA_PROCESSOR_X86_64)
+				return _pext_u64(src, mask);
+			#else
+				return bit_pext_generic(src, mask);
+			#endif
+		}
+
+
+
+		#if EASTL_INT128_SUPPORTED
+			inline int bit_popcount(eastl_uint128_t x)
+				{ return bit_popcount((uint64_t)x) + bit_popcount((uint64_t)(x >> 64)); }
+
+			inline int bit_countl_zero(eastl_uint128_t x)
+			{
+				const uint64_t hi = (uint64_t)(x >> 64);
+				return hi ? bit_countl_zero(hi) : (64 + bit_countl_zero((uint64_t)x));
+			}
+
+			inline int bit_countr_zero(eastl_uint128_t x)
+			{
+				const uint64_t lo = (uint64_t)x;
+				return lo ? bit_countr_zero(lo) : (64 + bit_countr_zero((uint64_t)(x >> 64)));
+			}
+
+			inline eastl_uint128_t bit_byteswap(eastl_uint128_t x)
+				{ return ((eastl_uint128_t)bit_byteswap((uint64_t)x) << 64) | bit_byteswap((uint64_t)(x >> 64)); }
+
+			inline eastl_uint128_t bit_reverse(eastl_uint128_t x)
+				{ return ((eastl_uint128_t)bit_reverse((uint64_t)x) << 64) | bit_reverse((uint64_t)(x >> 64)); }
+
+			inline eastl_uint128_t bit_pdep(eastl_uint128_t src, eastl_uint128_t mask)
+				{ return bit_pdep_generic(src, mask); }
+
+			inline eastl_uint128_t bit_pext(eastl_uint128_t src, eastl_uint128_t mask)
+				{ return bit_pext_generic(src, mask); }
+		#endif
+
+	} // namespace Internal
+
+
+
+	/// popcount
+	///
+	/// Returns the number of bits set in x.
+	///
+	template <typename T>
+	inline int popcount(T x)
+	{
+		typedef typename Internal::bit_word<T>::type word_type;
+		return Internal::bit_popcount((word_type)x);
+	}
+
+
+	/// countl_zero
+	///
+	/// Returns the number of consecutive zero bits starting at the most
+	/// significant bit. Returns the width of T if x is zero.
+	///
+	template <typename T>
+	inline int countl_zero(T x)
+	{
+		typedef Internal::bit_word<T> word;
+		return Internal::bit_countl_zero((typename word::type)x) - word::kPad;
+	}
+
+
+	/// countr_zero
+	///
+	/// Returns the number of consecutive zero bits starting at the least
+	/// significant bit. Returns the width of T if x is zero.
+	///
+	template <typename T>
+	inline int countr_zero(T x)
+	{
+		typedef Internal::bit_word<T> word;
+		const int n = Internal::bit_countr_zero((typename word::type)x);
+		return (n < word::kDigits) ? n : word::kDigits; // Only matters when T was widened and x is zero.
+	}
+
+
+	/// countl_one
+	///
+	/// Returns the number of consecutive one bits starting at the most significant bit.
+	///
+	template <typename T>
+	inline int countl_one(T x)
+		{ return eastl::countl_zero((T)~x); }
+
+
+	/// countr_one
+	///
+	/// Returns the number of consecutive one bits starting at the least significant bit.
+	///
+	template <typename T>
+	inline int countr_one(T x)
+		{ return eastl::countr_zero((T)~x); }
+
+
+	/// bit_width
+	///
+	/// Returns the number of bits needed to represent x, which is 1 + floor(log2(x))
+	/// for nonzero x, and 0 for x == 0.
+	///
+	template <typename T>
+	inline int bit_width(T x)
+		{ return Internal::bit_word<T>::kDigits - eastl::countl_zero(x); }
+
+
+	/// has_single_bit
+	///
+	/// Returns true if x is a power of two.
+	///
+	template <typename T>
+	inline bool has_single_bit(T x)
+		{ return (x != 0) && ((x & (T)(x - 1)) == 0); }
+
+
+	/// bit_floor
+	///
+	/// Returns the largest power of two that is not greater than x, or 0 if x is 0.
+	///
+	template <typename T>
+	inline T bit_floor(T x)
+		{ return x ? (T)((T)1 << (eastl::bit_width(x) - 1)) : (T)0; }
+
+
+	/// bit_ceil
+	///
+	/// Returns the smallest power of two that is not less than x. The result
+	/// must be representable in T.
+	///
+	template <typename T>
+	inline T bit_ceil(T x)
+	{
+		if(x <= 1)
+			return (T)1;
+
+		const int n = eastl::bit_width((T)(x - 1));
+		EASTL_ASSERT(n < Internal::bit_word<T>::kDigits);
+		return (T)((T)1 << n);
+	}
+
+
+	/// rotl
+	///
+	/// Rotates x left by s bits. A negative s rotates right.
+	///
+	template <typename T>
+	inline T rotl(T x, int s)
+	{
+		const int kDigits = Internal::bit_word<T>::kDigits;
+		const unsigned r = (unsigned)s & (unsigned)(kDigits - 1); // The width is a power of two, so this is s mod width for negative s as well.
+		return (T)((x << r) | (x >> ((kDigits - r) & (kDigits - 1))));
+	}
+
+
+	/// rotr
+	///
+	/// Rotates x right by s bits. A negative s rotates left.
+	///
+	template <typename T>
+	inline T rotr(T x, int s)
+	{
+		const int kDigits = Internal::bit_word<T>::kDigits;
+		const unsigned r = (unsigned)s & (unsigned)(kDigits - 1);
+		return (T)((x >> r) | (x << ((kDigits - r) & (kDigits - 1))));
+	}
+
+
+	/// byteswap
+	///
+	/// Reverses the order of the bytes of x.
+	///
+	template <typename T>
+	inline T byteswap(T x)
+	{
+		EASTL_CT_ASSERT_MSG(T(-1) > T(0), "The bit functions are only defined for unsigned types.");
+		typedef typename Internal::bit_uint<sizeof(T)>::type uint_type;
+		return (T)Internal::bit_byteswap((uint_type)x);
+	}
+
+
+	/// bit_reverse
+	///
+	/// Reverses the order of the bits of x, so that bit 0 becomes the most significant bit.
+	///
+	template <typename T>
+	inline T bit_reverse(T x)
+	{
+		typedef Internal::bit_word<T> word;
+		return (T)(Internal::bit_reverse((typename word::type)x) >> word::kPad);
+	}
+
+
+	/// pdep
+	///
+	/// Parallel bit deposit: scatters the low bits of src to the positions of
+	/// the set bits of mask, from the lowest up. Other bits of the result are zero.
+	///
+	/// Example:
+	///     pdep(0b101u, 0b11010u) == 0b10010u
+	///
+	template <typename T>
+	inline T pdep(T src, T mask)
+	{
+		typedef typename Internal::bit_word<T>::type word_type;
+		return (T)Internal::bit_pdep((word_type)src, (word_type)mask);
+	}
+
+
+	/// pext
+	///
+	/// Parallel bit extract: gathers the bits of src at the positions of the
+	/// set bits of mask into the low bits of the result. This is the inverse of pdep.
+	///
+	/// Example:
+	///     pext(0b10010u, 0b11010u) == 0b101u
+	///
+	template <typename T>
+	inline T pext(T src, T mask)
+	{
+		typedef typename Internal::bit_word<T>::type word_type;
+		return (T)Internal::bit_pext((word_type)src, (word_type)mask);
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -26,6 +26,7 @@
 
 #include <eastl/internal/config.h>
 #include <eastl/algorithm.h>
+#include <eastl/bit.h>
 
 #ifdef _MSC_VER
 	#pragma warning(push, 0)
@@ -488,192 +489,46 @@ namespace eastl
 	#define EASTL_BITSET_COUNT_STRING "\0\1\1\2\1\2\2\3\1\2\2\3\2\3\3\4"
 
 
+	// GetFirstBit / GetLastBit
+	//
+	// Return the index of the lowest / highest set bit of x, or the width of x if x is zero.
+	//
 	inline uint32_t GetFirstBit(uint8_t x)
-	{
-		if(x)
-		{
-			uint32_t n = 1;
-
-			if((x & 0x0000000F) == 0) { n +=  4; x >>=  4; }
-			if((x & 0x00000003) == 0) { n +=  2; x >>=  2; }
-
-			return (uint32_t)(n - (x & 1));
-		}
-
-		return 8;
-	}
-
-	inline uint32_t GetFirstBit(uint16_t x) // To do: Update this to use VC++ _BitScanForward, _BitScanForward64; GCC __builtin_ctz, __builtin_ctzl. VC++ __lzcnt16, __lzcnt, __lzcnt64 requires recent CPUs (2013+) and probably can't be used. http://en.wikipedia.org/wiki/Haswell_%28microarchitecture%29#New_features
-	{
-		if(x)
-		{
-			uint32_t n = 1;
-
-			if((x & 0x000000FF) == 0) { n +=  8; x >>=  8; }
-			if((x & 0x0000000F) == 0) { n +=  4; x >>=  4; }
-			if((x & 0x00000003) == 0) { n +=  2; x >>=  2; }
-
-			return (uint32_t)(n - (x & 1));
-		}
+		{ return (uint32_t)eastl::countr_zero(x); }
 
-		return 16;
-	}
+	inline uint32_t GetFirstBit(uint16_t x)
+		{ return (uint32_t)eastl::countr_zero(x); }
 
 	inline uint32_t GetFirstBit(uint32_t x)
-	{
-		if(x)
-		{
-			uint32_t n = 1;
-
-			if((x & 0x0000FFFF) == 0) { n += 16; x >>= 16; }
-			if((x & 0x000000FF) == 0) { n +=  8; x >>=  8; }
-			if((x & 0x0000000F) == 0) { n +=  4; x >>=  4; }
-			if((x & 0x00000003) == 0) { n +=  2; x >>=  2; }
-
-			return (n - (x & 1));
-		}
-
-		return 32;
-	}
+		{ return (uint32_t)eastl::countr_zero(x); }
 
 	inline uint32_t GetFirstBit(uint64_t x)
-	{
-		if(x)
-		{
-			uint32_t n = 1;
-
-			if((x & 0xFFFFFFFF) == 0) { n += 32; x >>= 32; }
-			if((x & 0x0000FFFF) == 0) { n += 16; x >>= 16; }
-			if((x & 0x000000FF) == 0) { n +=  8; x >>=  8; }
-			if((x & 0x0000000F) == 0) { n +=  4; x >>=  4; }
-			if((x & 0x00000003) == 0) { n +=  2; x >>=  2; }
-
-			return (n - ((uint32_t)x & 1));
-		}
-
-		return 64;
-	}
-
+		{ return (uint32_t)eastl::countr_zero(x); }
 
 	#if EASTL_INT128_SUPPORTED
 		inline uint32_t GetFirstBit(eastl_uint128_t x)
-		{
-			if(x)
-			{
-				uint32_t n = 1;
-
-				if((x & UINT64_C(0xFFFFFFFFFFFFFFFF)) == 0) { n += 64; x >>= 64; }
-				if((x & 0xFFFFFFFF) == 0)                   { n += 32; x >>= 32; }
-				if((x & 0x0000FFFF) == 0)                   { n += 16; x >>= 16; }
-				if((x & 0x000000FF) == 0)                   { n +=  8; x >>=  8; }
-				if((x & 0x0000000F) == 0)                   { n +=  4; x >>=  4; }
-				if((x & 0x00000003) == 0)                   { n +=  2; x >>=  2; }
-
-				return (n - ((uint32_t)x & 1));
-			}
-
-			return 128;
-		}
+			{ return (uint32_t)eastl::countr_zero(x); }
 	#endif
 
 	inline uint32_t GetLastBit(uint8_t x)
-	{
-		if(x)
-		{
-			uint32_t n = 0;
-
-			if(x & 0xFFF0) { n +=  4; x >>=  4; }
-			if(x & 0xFFFC) { n +=  2; x >>=  2; }
-			if(x & 0xFFFE) { n +=  1;           }
-
-			return n;
-		}
-
-		return 8;
-	}
+		{ return x ? (uint32_t)(7 - eastl::countl_zero(x)) : 8; }
 
 	inline uint32_t GetLastBit(uint16_t x)
-	{
-		if(x)
-		{
-			uint32_t n = 0;
-
-			if(x & 0xFF00) { n +=  8; x >>=  8; }
-			if(x & 0xFFF0) { n +=  4; x >>=  4; }
-			if(x & 0xFFFC) { n +=  2; x >>=  2; }
-			if(x & 0xFFFE) { n +=  1;           }
-
-			return n;
-		}
-
-		return 16;
-	}
+		{ return x ? (uint32_t)(15 - eastl::countl_zero(x)) : 16; }
 
 	inline uint32_t GetLastBit(uint32_t x)
-	{
-		if(x)
-		{
-			uint32_t n = 0;
-
-			if(x & 0xFFFF0000) { n += 16; x >>= 16; }
-			if(x & 0xFFFFFF00) { n +=  8; x >>=  8; }
-			if(x & 0xFFFFFFF0) { n +=  4; x >>=  4; }
-			if(x & 0xFFFFFFFC) { n +=  2; x >>=  2; }
-			if(x & 0xFFFFFFFE) { n +=  1;           }
-
-			return n;
-		}
-
-		return 32;
-	}
+		{ return x ? (uint32_t)(31 - eastl::countl_zero(x)) : 32; }
 
 	inline uint32_t GetLastBit(uint64_t x)
-	{
-		if(x)
-		{
-			uint32_t n = 0;
-
-			if(x & UINT64_C(0xFFFFFFFF00000000)) { n += 32; x >>= 32; }
-			if(x & 0xFFFF0000)                   { n += 16; x >>= 16; }
-			if(x & 0xFFFFFF00)                   { n +=  8; x >>=  8; }
-			if(x & 0xFFFFFFF0)                   { n +=  4; x >>=  4; }
-			if(x & 0xFFFFFFFC)                   { n +=  2; x >>=  2; }
-			if(x & 0xFFFFFFFE)                   { n +=  1;           }
-
-			return n;
-		}
-
-		return 64;
-	}
+		{ return x ? (uint32_t)(63 - eastl::countl_zero(x)) : 64; }
 
 	#if EASTL_INT128_SUPPORTED
 		inline uint32_t GetLastBit(eastl_uint128_t x)
-		{
-			if(x)
-			{
-				uint32_t n = 0;
-				
-				eastl_uint128_t mask(UINT64_C(0xFFFFFFFF00000000)); // There doesn't seem to exist compiler support for INT128_C() by any compiler. EAStdC's int128_t supports it though.
-				mask <<= 64;
-
-				if(x & mask)                         { n += 64; x >>= 64; }
-				if(x & UINT64_C(0xFFFFFFFF00000000)) { n += 32; x >>= 32; }
-				if(x & UINT64_C(0x00000000FFFF0000)) { n += 16; x >>= 16; }
-				if(x & UINT64_C(0x00000000FFFFFF00)) { n +=  8; x >>=  8; }
-				if(x & UINT64_C(0x00000000FFFFFFF0)) { n +=  4; x >>=  4; }
-				if(x & UINT64_C(0x00000000FFFFFFFC)) { n +=  2; x >>=  2; }
-				if(x & UINT64_C(0x00000000FFFFFFFE)) { n +=  1;           }
-
-				return n;
-			}
-
-			return 128;
-		}
+			{ return x ? (uint32_t)(127 - eastl::countl_zero(x)) : 128; }
 	#endif
 
 
 
-
 	///////////////////////////////////////////////////////////////////////////
 	// BitsetBase
 	//
@@ -865,26 +720,8 @@ namespace eastl
 		size_type n = 0;
 
 		for(size_t i = 0; i < NW; i++)
-		{
-			#if defined(__GNUC__) && (((__GNUC__ * 100) + __GNUC_MINOR__) >= 304) && !defined(EA_PLATFORM_ANDROID) // GCC 3.4 or later
-				#if(EA_PLATFORM_WORD_SIZE == 4)
-					n += (size_type)__builtin_popcountl(mWord[i]);
-				#else
-					n += (size_type)__builtin_popcountll(mWord[i]);
-				#endif
-			#elif defined(__GNUC__) && (__GNUC__ < 3)
-				n +=  BitsetCountBits(mWord[i]); // GCC 2.x compiler inexplicably blows up on the code below.
-			#else
-				// todo: use __popcnt16, __popcnt, __popcnt64 for msvc builds
-				// https://msdn.microsoft.com/en-us/library/bb385231(v=vs.140).aspx
-				for(word_type w = mWord[i]; w; w >>= 4)
-					n += EASTL_BITSET_COUNT_STRING[w & 0xF];
+			n += (size_type)eastl::popcount(mWord[i]);
 
-				// Version which seems to run slower in benchmarks:
-				// n +=  BitsetCountBits(mWord[i]);
-			#endif
-
-		}
 		return n;
 	}
 
@@ -1219,20 +1056,7 @@ EA_RESTORE_GCC_WARNING()
 	inline typename BitsetBase<1, WordType>::size_type
 	BitsetBase<1, WordType>::count() const
 	{
-		#if defined(__GNUC__) && (((__GNUC__ * 100) + __GNUC_MINOR__) >= 304) && !defined(EA_PLATFORM_ANDROID) // GCC 3.4 or later
-			#if(EA_PLATFORM_WORD_SIZE == 4)
-				return (size_type)__builtin_popcountl(mWord[0]);
-			#else
-				return (size_type)__builtin_popcountll(mWord[0]);
-			#endif
-		#elif defined(__GNUC__) && (__GNUC__ < 3)
-			return BitsetCountBits(mWord[0]); // GCC 2.x compiler inexplicably blows up on the code below.
-		#else
-			size_type n = 0;
-			for(word_type w = mWord[0]; w; w >>= 4)
-				n += EASTL_BITSET_COUNT_STRING[w & 0xF];
-			return n;
-		#endif
+		return (size_type)eastl::popcount(mWord[0]);
 	}
 
 
@@ -1512,16 +1336,7 @@ EA_RESTORE_GCC_WARNING()
 	inline typename BitsetBase<2, WordType>::size_type
 	BitsetBase<2, WordType>::count() const
 	{
-		#if defined(__GNUC__) && (((__GNUC__ * 100) + __GNUC_MINOR__) >= 304) && !defined(EA_PLATFORM_ANDROID) // GCC 3.4 or later
-			#if(EA_PLATFORM_WORD_SIZE == 4)
-				return (size_type)__builtin_popcountl(mWord[0])  + (size_type)__builtin_popcountl(mWord[1]);
-			#else
-				return (size_type)__builtin_popcountll(mWord[0]) + (size_type)__builtin_popcountll(mWord[1]);
-			#endif
-
-		#else
-			return BitsetCountBits(mWord[0]) + BitsetCountBits(mWord[1]);
-		#endif
+		return (size_type)(eastl::popcount(mWord[0]) + eastl::popcount(mWord[1]));
 	}
 
 
@@ -20,6 +20,7 @@
 #include <eastl/internal/config.h>
 #include <eastl/vector.h>
 #include <eastl/algorithm.h>
+#include <eastl/bit.h>
 #include <eastl/bitset.h>
 
 #ifdef _MSC_VER
@@ -297,18 +298,15 @@ namespace eastl
 		reference       operator[](size_type n);            // behavior is undefined if n is invalid.
 		const_reference operator[](size_type n) const;
 
-		/*
-		Work in progress:
-		template <bool value = true> iterator findFirst();                                 // Finds the lowest "on" bit.
-		template <bool value = true> iterator findNext(const_iterator it);                 // Finds the next lowest "on" bit after it.
-		template <bool value = true> iterator findLast();                                  // Finds the index of the last "on" bit, returns size if none are set.
-		template <bool value = true> iterator findPrev(const_iterator it);                 // Finds the index of the last "on" bit before last_find, returns size if none are set.
+		template <bool value = true> iterator findFirst();                                 // Finds the lowest bit equal to value, or end() if there is none.
+		template <bool value = true> iterator findNext(const_iterator it);                 // Finds the lowest bit equal to value after it, or end() if there is none.
+		template <bool value = true> iterator findLast();                                  // Finds the highest bit equal to value, or end() if there is none.
+		template <bool value = true> iterator findPrev(const_iterator it);                 // Finds the highest bit equal to value before it, or end() if there is none.
 
-		template <bool value = true> const_iterator findFirst() const;                     // Finds the lowest "on" bit.
-		template <bool value = true> const_iterator findNext(const_iterator it) const;     // Finds the next lowest "on" bit after it.
-		template <bool value = true> const_iterator findLast() const;                      // Finds the index of the last "on" bit, returns size if none are set.
-		template <bool value = true> const_iterator findPrev(const_iterator it) const;     // Finds the index of the last "on" bit before last_find, returns size if none are set.
-		*/
+		template <bool value = true> const_iterator findFirst() const;
+		template <bool value = true> const_iterator findNext(const_iterator it) const;
+		template <bool value = true> const_iterator findLast() const;
+		template <bool value = true> const_iterator findPrev(const_iterator it) const;
 
 		element_type*       data() EASTL_NOEXCEPT;
 		const element_type* data() const EASTL_NOEXCEPT;
@@ -337,6 +335,10 @@ namespace eastl
 		#if EASTL_RESET_ENABLED
 			void reset(); // This function name is deprecated; use reset_lose_memory instead.
 		#endif
+
+	protected:
+		size_type DoFindNext(size_type n, bool value) const;    // Returns the index of the first bit at or after n equal to value, or size().
+		size_type DoFindPrev(size_type n, bool value) const;    // Returns the index of the last bit before n equal to value, or size().
 	};
 
 
@@ -1089,24 +1091,138 @@ namespace eastl
 	}
 
 
-/*
+	template <typename Allocator, typename Element, typename Container>
+	typename bitvector<Allocator, Element, Container>::size_type
+	bitvector<Allocator, Element, Container>::DoFindNext(size_type n, bool value) const
+	{
+		// We scan a word at a time, flipping the words when looking for zeros, and
+		// use countr_zero to find the bit within the first nonzero word.
+		const size_type nSize = size();
+
+		if(n >= nSize)
+			return nSize;
+
+		const Element   kAll  = (Element)~Element(0);
+		const Element   flip  = value ? Element(0) : kAll;
+		const size_type nWordCount = mContainer.size();
+		size_type       w     = n / kBitCount;
+		Element         word  = (Element)((mContainer[w] ^ flip) & (Element)(kAll << (n % kBitCount)));
+
+		for(;;)
+		{
+			if(word)
+			{
+				const size_type i = (w * kBitCount) + (size_type)eastl::countr_zero(word);
+				return (i < nSize) ? i : nSize; // The unused bits at the end of the last word are not cleared.
+			}
+
+			if(++w == nWordCount)
+				return nSize;
+
+			word = (Element)(mContainer[w] ^ flip);
+		}
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	typename bitvector<Allocator, Element, Container>::size_type
+	bitvector<Allocator, Element, Container>::DoFindPrev(size_type n, bool value) const
+	{
+		const size_type nSize = size();
+
+		if(n > nSize)
+			n = nSize;
+		if(n == 0)
+			return nSize;
+
+		const Element   kAll = (Element)~Element(0);
+		const Element   flip = value ? Element(0) : kAll;
+		size_type       w    = (n - 1) / kBitCount;
+		Element         word = (Element)((mContainer[w] ^ flip) & (Element)(kAll >> ((kBitCount - 1) - ((n - 1) % kBitCount))));
+
+		for(;;)
+		{
+			if(word)
+				return (w * kBitCount) + (size_type)((kBitCount - 1) - eastl::countl_zero(word));
+
+			if(w-- == 0)
+				return nSize;
+
+			word = (Element)(mContainer[w] ^ flip);
+		}
+	}
+
+
 	template <typename Allocator, typename Element, typename Container>
 	template <bool value>
-	typename bitvector<Allocator, Element, Container>::iterator 
+	inline typename bitvector<Allocator, Element, Container>::iterator
 	bitvector<Allocator, Element, Container>::findFirst()
 	{
-		return begin();
+		return begin() + (difference_type)DoFindNext(0, value);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	template <bool value>
+	inline typename bitvector<Allocator, Element, Container>::iterator
+	bitvector<Allocator, Element, Container>::findNext(const_iterator it)
+	{
+		return begin() + (difference_type)DoFindNext((size_type)(it - cbegin()) + 1, value);
 	}
 
-	template <bool value> iterator findNext(const_iterator it);
-	template <bool value> iterator findLast();
-	template <bool value> iterator findPrev(const_iterator it);
-						
-	template <bool value> const_iterator findFirst() const;
-	template <bool value> const_iterator findNext(const_iterator it) const;
-	template <bool value> const_iterator findLast() const;
-	template <bool value> const_iterator findPrev(const_iterator it) const;
-*/
+
+	template <typename Allocator, typename Element, typename Container>
+	template <bool value>
+	inline typename bitvector<Allocator, Element, Container>::iterator
+	bitvector<Allocator, Element, Container>::findLast()
+	{
+		return begin() + (difference_type)DoFindPrev(size(), value);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	template <bool value>
+	inline typename bitvector<Allocator, Element, Container>::iterator
+	bitvector<Allocator, Element, Container>::findPrev(const_iterator it)
+	{
+		return begin() + (difference_type)DoFindPrev((size_type)(it - cbegin()), value);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	template <bool value>
+	inline typename bitvector<Allocator, Element, Container>::const_iterator
+	bitvector<Allocator, Element, Container>::findFirst() const
+	{
+		return begin() + (difference_type)DoFindNext(0, value);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	template <bool value>
+	inline typename bitvector<Allocator, Element, Container>::const_iterator
+	bitvector<Allocator, Element, Container>::findNext(const_iterator it) const
+	{
+		return begin() + (difference_type)DoFindNext((size_type)(it - begin()) + 1, value);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	template <bool value>
+	inline typename bitvector<Allocator, Element, Container>::const_iterator
+	bitvector<Allocator, Element, Container>::findLast() const
+	{
+		return begin() + (difference_type)DoFindPrev(size(), value);
+	}
+
+
+	template <typename Allocator, typename Element, typename Container>
+	template <bool value>
+	inline typename bitvector<Allocator, Element, Container>::const_iterator
+	bitvector<Allocator, Element, Container>::findPrev(const_iterator it) const
+	{
+		return begin() + (difference_type)DoFindPrev((size_type)(it - begin()), value);
+	}
 
 
 
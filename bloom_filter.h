@@ -0,0 +1,551 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements bloom_filter, an approximate set which answers
+// "definitely not present" or "probably present" in about 10 bits per key
+// for a 1% false positive rate, where a hashSet of the keys would use 40 or
+// more bytes per key.
+//
+// This is a split block Bloom filter. Each key maps to one 32 byte block and
+// sets one bit in each of the block's eight 32 bit words. Thus a lookup
+// touches one cache line rather than k of them, and the eight bit positions
+// are computed and tested together with SIMD. The cost of blocking is a
+// slightly higher false positive rate for the same number of bits, which
+// the sizing below accounts for.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_BLOOM_FILTER_H
+#define EASTL_BLOOM_FILTER_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/filter_support.h>
+#include <eastl/allocator.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <math.h>
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <math.h>
+	#include <string.h>
+#endif
+
+#if EASTL_SSE2
+	#include <emmintrin.h>
+#endif
+#if EASTL_SSE4_1
+	#include <smmintrin.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_BLOOM_FILTER_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_BLOOM_FILTER_DEFAULT_NAME
+		#define EASTL_BLOOM_FILTER_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " bloom_filter" // Unless the user overrides something, this is "EASTL bloom_filter".
+	#endif
+
+
+	/// EASTL_BLOOM_FILTER_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_BLOOM_FILTER_DEFAULT_ALLOCATOR
+		#define EASTL_BLOOM_FILTER_DEFAULT_ALLOCATOR allocator_type(EASTL_BLOOM_FILTER_DEFAULT_NAME)
+	#endif
+
+
+
+	/// bloom_filter
+	///
+	/// Keys are hashed with Hash, and the result is finalized to 64 well mixed
+	/// bits, so eastl::hash is fine even where it is the identity. Alternatively
+	/// insert_hash and contains_hash take a 64 bit hash directly, such as half
+	/// of murmurHash_x64_128, which must already be well mixed.
+	///
+	/// Filters with the same block count can be merged, which is the union of
+	/// their sets. Thus a large filter can be built in parallel, one filter per
+	/// thread, and merged at the end.
+	///
+	/// Example usage:
+	///     bloom_filter<uint64_t> filter(1000000, 0.01f); // Sized for a million keys at 1% false positives: about 1.2 MB.
+	///
+	///     for(...)
+	///         filter.insert(assetId);
+	///
+	///     if(filter.contains(assetId)) // If false, the asset is definitely not present.
+	///         pAsset = SlowLookup(assetId);
+	///
+	template <typename T, typename Hash = eastl::hash<T>, typename Allocator = EASTLAllocatorType>
+	class bloom_filter
+	{
+	public:
+		typedef bloom_filter<T, Hash, Allocator>  this_type;
+		typedef T                                 value_type;
+		typedef eastl_size_t                      size_type;
+		typedef Hash                              hasher;
+		typedef Allocator                         allocator_type;
+
+		static const uint32_t kBlockWordCount = 8;
+		static const uint32_t kBlockSize      = kBlockWordCount * sizeof(uint32_t);
+		static const uint32_t kSerializeMagic = 0x46424145; // "EABF" in little endian.
+
+	public:
+		bloom_filter(const allocator_type& allocator = EASTL_BLOOM_FILTER_DEFAULT_ALLOCATOR);
+		bloom_filter(size_type nExpectedCount, float fFalsePositiveRate, const allocator_type& allocator = EASTL_BLOOM_FILTER_DEFAULT_ALLOCATOR);
+		bloom_filter(const this_type& x);
+	   ~bloom_filter();
+
+		this_type& operator=(const this_type& x);
+		void       swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+		/// reset
+		/// Reallocates and clears the filter, sized so that after nExpectedCount
+		/// inserts the false positive rate is at most fFalsePositiveRate.
+		void reset(size_type nExpectedCount, float fFalsePositiveRate);
+
+		/// reset_blocks
+		/// Reallocates and clears the filter with exactly nBlockCount blocks.
+		void reset_blocks(size_type nBlockCount);
+
+		void clear();
+
+		void insert(const value_type& value)
+			{ insert_hash(Internal::filter_mix64((uint64_t)mHash(value))); }
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for(; first != last; ++first)
+				insert(*first);
+		}
+
+		/// contains
+		/// Returns false if value was definitely not inserted. Returns true if
+		/// it was, or with probability false_positive_rate() if it wasn't.
+		bool contains(const value_type& value) const
+			{ return contains_hash(Internal::filter_mix64((uint64_t)mHash(value))); }
+
+		void insert_hash(uint64_t h);
+		bool contains_hash(uint64_t h) const;
+
+		/// merge
+		/// Adds all of x's keys to this filter. Returns false, and does nothing,
+		/// if x has a different block count.
+		bool merge(const this_type& x);
+
+		size_type insert_count() const EASTL_NOEXCEPT   { return mnInsertCount; } // Counts every insert, including repeats of a key.
+		size_type block_count() const EASTL_NOEXCEPT    { return mnBlockCount; }
+		size_type size_in_bytes() const EASTL_NOEXCEPT  { return (size_type)mnBlockCount * kBlockSize; }
+		bool      empty() const EASTL_NOEXCEPT          { return (mnInsertCount == 0); }
+
+		/// false_positive_rate
+		/// Returns the expected false positive rate of a filter with nBlockCount
+		/// blocks holding nCount distinct keys.
+		static double false_positive_rate(size_type nCount, size_type nBlockCount);
+
+		double false_positive_rate() const
+			{ return false_positive_rate(mnInsertCount, mnBlockCount); }
+
+		/// serialize
+		/// Writes the filter to pBuffer, which must hold serialized_size() bytes.
+		/// Returns the number of bytes written, or 0 if the buffer is too small.
+		size_type serialized_size() const EASTL_NOEXCEPT
+			{ return sizeof(Internal::filter_header) + size_in_bytes(); }
+
+		size_type serialize(void* pBuffer, size_type nBufferSize) const;
+
+		/// deserialize
+		/// Replaces the filter with one written by serialize. Returns false, and
+		/// leaves the filter unchanged, if the buffer isn't a valid bloom_filter.
+		bool deserialize(const void* pBuffer, size_type nBufferSize);
+
+		bool validate() const;
+
+	protected:
+		uint32_t*      mpBlocks;        // mnBlockCount * kBlockWordCount words, aligned to kBlockSize.
+		uint32_t       mnBlockCount;
+		size_type      mnInsertCount;
+		hasher         mHash;
+		allocator_type mAllocator;
+
+		void DoAllocate(uint32_t nBlockCount);
+		void DoFree();
+
+		static void DoMakeMask(uint32_t key, uint32_t* pMask);
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// bloom_filter
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename H, typename A>
+	inline bloom_filter<T, H, A>::bloom_filter(const allocator_type& allocator)
+		: mpBlocks(NULL), mnBlockCount(0), mnInsertCount(0), mHash(), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline bloom_filter<T, H, A>::bloom_filter(size_type nExpectedCount, float fFalsePositiveRate, const allocator_type& allocator)
+		: mpBlocks(NULL), mnBlockCount(0), mnInsertCount(0), mHash(), mAllocator(allocator)
+	{
+		reset(nExpectedCount, fFalsePositiveRate);
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline bloom_filter<T, H, A>::bloom_filter(const this_type& x)
+		: mpBlocks(NULL), mnBlockCount(0), mnInsertCount(x.mnInsertCount), mHash(x.mHash), mAllocator(x.mAllocator)
+	{
+		DoAllocate(x.mnBlockCount);
+		if(mnBlockCount)
+			memcpy(mpBlocks, x.mpBlocks, size_in_bytes());
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline bloom_filter<T, H, A>::~bloom_filter()
+	{
+		DoFree();
+	}
+
+
+	template <typename T, typename H, typename A>
+	typename bloom_filter<T, H, A>::this_type&
+	bloom_filter<T, H, A>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			if(mnBlockCount != x.mnBlockCount)
+			{
+				DoFree();
+				DoAllocate(x.mnBlockCount);
+			}
+			if(mnBlockCount)
+				memcpy(mpBlocks, x.mpBlocks, size_in_bytes());
+			mnInsertCount = x.mnInsertCount;
+			mHash         = x.mHash;
+		}
+		return *this;
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline void bloom_filter<T, H, A>::swap(this_type& x)
+	{
+		eastl::swap(mpBlocks,      x.mpBlocks);
+		eastl::swap(mnBlockCount,  x.mnBlockCount);
+		eastl::swap(mnInsertCount, x.mnInsertCount);
+		eastl::swap(mHash,         x.mHash);
+		eastl::swap(mAllocator,    x.mAllocator);
+	}
+
+
+	template <typename T, typename H, typename A>
+	void bloom_filter<T, H, A>::DoAllocate(uint32_t nBlockCount)
+	{
+		mnBlockCount = nBlockCount;
+		mpBlocks     = NULL;
+
+		if(nBlockCount)
+		{
+			mpBlocks = (uint32_t*)allocate_memory(mAllocator, (size_t)nBlockCount * kBlockSize, kBlockSize, 0);
+			EASTL_ASSERT(mpBlocks != NULL);
+		}
+	}
+
+
+	template <typename T, typename H, typename A>
+	void bloom_filter<T, H, A>::DoFree()
+	{
+		if(mpBlocks)
+			EASTLFree(mAllocator, mpBlocks, (size_t)mnBlockCount * kBlockSize);
+		mpBlocks     = NULL;
+		mnBlockCount = 0;
+	}
+
+
+	template <typename T, typename H, typename A>
+	void bloom_filter<T, H, A>::reset_blocks(size_type nBlockCount)
+	{
+		EASTL_ASSERT(nBlockCount <= 0xffffffff);
+
+		if(nBlockCount != mnBlockCount)
+		{
+			DoFree();
+			DoAllocate((uint32_t)nBlockCount);
+		}
+		clear();
+	}
+
+
+	template <typename T, typename H, typename A>
+	void bloom_filter<T, H, A>::reset(size_type nExpectedCount, float fFalsePositiveRate)
+	{
+		const double p = (fFalsePositiveRate < 1e-7f) ? 1e-7 : (fFalsePositiveRate > 0.5f) ? 0.5 : (double)fFalsePositiveRate;
+		const double n = (nExpectedCount ? (double)nExpectedCount : 1.0);
+
+		// Start from the size a classic Bloom filter would need, which is a lower
+		// bound, and grow in steps of 1/32 until the blocked filter's rate is met.
+		double fBlockCount = ceil((n * -log(p) / (0.6931471805599453 * 0.6931471805599453)) / (kBlockSize * 8));
+
+		while(false_positive_rate((size_type)n, (size_type)fBlockCount) > p)
+			fBlockCount = ceil(fBlockCount * (33.0 / 32.0));
+
+		reset_blocks((size_type)fBlockCount);
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline void bloom_filter<T, H, A>::clear()
+	{
+		if(mnBlockCount)
+			memset(mpBlocks, 0, size_in_bytes());
+		mnInsertCount = 0;
+	}
+
+
+	template <typename T, typename H, typename A>
+	double bloom_filter<T, H, A>::false_positive_rate(size_type nCount, size_type nBlockCount)
+	{
+		if(nBlockCount == 0)
+			return 1.0;
+
+		// The number of keys in a given block is Poisson distributed with mean
+		// lambda. A block holding j keys has each bit of each word set with
+		// probability 1 - (31/32)^j, and a false positive needs all 8 words' bits.
+		const double lambda = (double)nCount / (double)nBlockCount;
+		const double jMax   = lambda + (10.0 * sqrt(lambda)) + 10.0;
+
+		double fRate  = 0.0;
+		double pJ     = exp(-lambda); // Probability that a block has j keys.
+		double fEmpty = 1.0;          // (31/32)^j
+
+		for(double j = 0.0; j <= jMax; j += 1.0)
+		{
+			const double fBit = 1.0 - fEmpty;
+			const double fBit2 = fBit * fBit, fBit4 = fBit2 * fBit2;
+
+			fRate  += pJ * (fBit4 * fBit4);
+			pJ     *= lambda / (j + 1.0);
+			fEmpty *= (31.0 / 32.0);
+		}
+
+		return fRate;
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline void bloom_filter<T, H, A>::DoMakeMask(uint32_t key, uint32_t* pMask)
+	{
+		// Odd constants which send each key to a different bit in each word.
+		static const uint32_t kSalt[kBlockWordCount] = { 0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
+														 0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31 };
+
+		for(uint32_t i = 0; i < kBlockWordCount; ++i)
+			pMask[i] = (uint32_t)1 << ((key * kSalt[i]) >> 27);
+	}
+
+
+	#if EASTL_SSE2
+		namespace Internal
+		{
+			// Returns the 8 words of the mask for key, as DoMakeMask does.
+			EASTL_FORCE_INLINE void bloom_filter_make_mask(uint32_t key, __m128i& mask0, __m128i& mask1)
+			{
+				const __m128i k      = _mm_set1_epi32((int)key);
+				const __m128i salt0  = _mm_setr_epi32((int)0x47b6137b, (int)0x44974d91, (int)0x8824ad5b, (int)0xa2b7289d);
+				const __m128i salt1  = _mm_setr_epi32((int)0x705495c7, (int)0x2df1424b, (int)0x9efc4947, (int)0x5c6bfb31);
+
+				#if EASTL_SSE4_1
+					__m128i h0 = _mm_mullo_epi32(k, salt0);
+					__m128i h1 = _mm_mullo_epi32(k, salt1);
+				#else
+					// SSE2 has only a 32 x 32 -> 64 multiply of the even lanes, so do the even and odd lanes separately.
+					const __m128i kOdd = _mm_srli_epi64(k, 32);
+					__m128i h0 = _mm_unpacklo_epi32(_mm_shuffle_epi32(_mm_mul_epu32(k, salt0), _MM_SHUFFLE(0, 0, 2, 0)),
+													_mm_shuffle_epi32(_mm_mul_epu32(kOdd, _mm_srli_epi64(salt0, 32)), _MM_SHUFFLE(0, 0, 2, 0)));
+					__m128i h1 = _mm_unpacklo_epi32(_mm_shuffle_epi32(_mm_mul_epu32(k, salt1), _MM_SHUFFLE(0, 0, 2, 0)),
+													_mm_shuffle_epi32(_mm_mul_epu32(kOdd, _mm_srli_epi64(salt1, 32)), _MM_SHUFFLE(0, 0, 2, 0)));
+				#endif
+
+				// There is no per-lane variable shift before AVX2, so make 1 << n by building
+				// the float 2^n and converting it. For n == 31 the conversion overflows to
+				// 0x80000000, which happens to be the right answer.
+				const __m128i bias = _mm_set1_epi32(127);
+				h0 = _mm_slli_epi32(_mm_add_epi32(_mm_srli_epi32(h0, 27), bias), 23);
+				h1 = _mm_slli_epi32(_mm_add_epi32(_mm_srli_epi32(h1, 27), bias), 23);
+
+				mask0 = _mm_cvttps_epi32(_mm_castsi128_ps(h0));
+				mask1 = _mm_cvttps_epi32(_mm_castsi128_ps(h1));
+			}
+		}
+	#endif
+
+
+	template <typename T, typename H, typename A>
+	inline void bloom_filter<T, H, A>::insert_hash(uint64_t h)
+	{
+		EASTL_ASSERT(mnBlockCount != 0);
+
+		// The upper 32 bits pick the block and the lower 32 bits pick the bits within it.
+		uint32_t* const pBlock = mpBlocks + (Internal::filter_range((uint32_t)(h >> 32), mnBlockCount) * kBlockWordCount);
+
+		#if EASTL_SSE2
+			__m128i mask0, mask1;
+			Internal::bloom_filter_make_mask((uint32_t)h, mask0, mask1);
+
+			__m128i* const pBlock128 = (__m128i*)pBlock;
+			_mm_store_si128(pBlock128,     _mm_or_si128(_mm_load_si128(pBlock128),     mask0));
+			_mm_store_si128(pBlock128 + 1, _mm_or_si128(_mm_load_si128(pBlock128 + 1), mask1));
+		#else
+			uint32_t mask[kBlockWordCount];
+			DoMakeMask((uint32_t)h, mask);
+
+			for(uint32_t i = 0; i < kBlockWordCount; ++i)
+				pBlock[i] |= mask[i];
+		#endif
+
+		++mnInsertCount;
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline bool bloom_filter<T, H, A>::contains_hash(uint64_t h) const
+	{
+		if(mnBlockCount == 0)
+			return false;
+
+		const uint32_t* const pBlock = mpBlocks + (Internal::filter_range((uint32_t)(h >> 32), mnBlockCount) * kBlockWordCount);
+
+		#if EASTL_SSE2
+			__m128i mask0, mask1;
+			Internal::bloom_filter_make_mask((uint32_t)h, mask0, mask1);
+
+			const __m128i* const pBlock128 = (const __m128i*)pBlock;
+			const __m128i missing = _mm_or_si128(_mm_andnot_si128(_mm_load_si128(pBlock128),     mask0),
+												 _mm_andnot_si128(_mm_load_si128(pBlock128 + 1), mask1));
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) == 0xffff;
+		#else
+			uint32_t mask[kBlockWordCount];
+			DoMakeMask((uint32_t)h, mask);
+
+			uint32_t missing = 0;
+			for(uint32_t i = 0; i < kBlockWordCount; ++i)
+				missing |= (mask[i] & ~pBlock[i]);
+			return (missing == 0);
+		#endif
+	}
+
+
+	template <typename T, typename H, typename A>
+	bool bloom_filter<T, H, A>::merge(const this_type& x)
+	{
+		if(x.mnBlockCount != mnBlockCount)
+			return false;
+
+		const size_type nWordCount = (size_type)mnBlockCount * kBlockWordCount;
+
+		for(size_type i = 0; i < nWordCount; ++i)
+			mpBlocks[i] |= x.mpBlocks[i];
+
+		mnInsertCount += x.mnInsertCount;
+		return true;
+	}
+
+
+	template <typename T, typename H, typename A>
+	typename bloom_filter<T, H, A>::size_type
+	bloom_filter<T, H, A>::serialize(void* pBuffer, size_type nBufferSize) const
+	{
+		if(nBufferSize < serialized_size())
+			return 0;
+
+		Internal::filter_header header;
+		header.mnMagic      = kSerializeMagic;
+		header.mnVersion    = 1;
+		header.mnParameter  = (uint16_t)kBlockWordCount;
+		header.mnBlockCount = mnBlockCount;
+		header.mnReserved   = 0;
+		header.mnItemCount  = (uint64_t)mnInsertCount;
+
+		memcpy(pBuffer, &header, sizeof(header));
+		if(mnBlockCount)
+			memcpy((char*)pBuffer + sizeof(header), mpBlocks, size_in_bytes());
+
+		return serialized_size();
+	}
+
+
+	template <typename T, typename H, typename A>
+	bool bloom_filter<T, H, A>::deserialize(const void* pBuffer, size_type nBufferSize)
+	{
+		Internal::filter_header header;
+
+		if(!Internal::filter_read_header(pBuffer, nBufferSize, kSerializeMagic, header) || (header.mnParameter != kBlockWordCount) ||
+		   ((nBufferSize - sizeof(header)) < ((size_type)header.mnBlockCount * kBlockSize)))
+		{
+			return false;
+		}
+
+		if(header.mnBlockCount != mnBlockCount)
+		{
+			DoFree();
+			DoAllocate(header.mnBlockCount);
+		}
+
+		if(mnBlockCount)
+			memcpy(mpBlocks, (const char*)pBuffer + sizeof(header), size_in_bytes());
+		mnInsertCount = (size_type)header.mnItemCount;
+
+		return true;
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline bool bloom_filter<T, H, A>::validate() const
+	{
+		if((mpBlocks == NULL) != (mnBlockCount == 0))
+			return false;
+
+		return ((uintptr_t)mpBlocks % kBlockSize) == 0;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename H, typename A>
+	inline void swap(bloom_filter<T, H, A>& a, bloom_filter<T, H, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
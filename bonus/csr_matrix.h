@@ -0,0 +1,1263 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements compressed sparse row (CSR) and compressed sparse
+// column (CSC) matrices, along with a builder which creates them from
+// (row, col, value) triplets.
+//
+// Unlike sparse_matrix, which stores a map of maps and thus pays for two
+// tree lookups and a heap node per cell, a compressed matrix stores all
+// of its non-zero cells in three flat arrays:
+//     offsets: outer_size() + 1 entries. Row (or col) i occupies the index
+//              range [offsets[i], offsets[i + 1]) of the other two arrays.
+//     indices: The column (or row) of each non-zero cell, sorted within each row (or col).
+//     values:  The value of each non-zero cell.
+//
+// Compressed matrices are immutable in structure once built; you can modify
+// the values of existing cells but you cannot add new cells without rebuilding
+// the matrix. Use csr_matrix_builder to accumulate cells in any order.
+//
+// Example usage:
+//     csr_matrix_builder<float> builder;
+//     builder.reserve(3);
+//     builder.add(0, 0, 1.f);
+//     builder.add(2, 1, 3.f);
+//     builder.add(1, 2, 2.f);
+//
+//     csr_matrix<float> m;
+//     builder.build(m, 3, 3);
+//     m.multiply(x, y); // y = m * x
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_CSR_MATRIX_H
+#define EASTL_CSR_MATRIX_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/vector.h>
+#include <eastl/algorithm.h>
+#include <eastl/sort.h>
+#include <eastl/utility.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_CSR_MATRIX_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CSR_MATRIX_DEFAULT_NAME
+		#define EASTL_CSR_MATRIX_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " csr_matrix" // Unless the user overrides something, this is "EASTL csr_matrix".
+	#endif
+
+
+	/// EASTL_CSR_MATRIX_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_CSR_MATRIX_DEFAULT_ALLOCATOR
+		#define EASTL_CSR_MATRIX_DEFAULT_ALLOCATOR allocator_type(EASTL_CSR_MATRIX_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_CSR_MATRIX_BLOCK_SIZE
+	///
+	/// The number of vector elements per column block used by multiply_blocked.
+	/// The default of 16K elements keeps the active slice of a float or double
+	/// input vector within a typical 64K-256K L2 cache.
+	///
+	#ifndef EASTL_CSR_MATRIX_BLOCK_SIZE
+		#define EASTL_CSR_MATRIX_BLOCK_SIZE 16384
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// compressed_dot
+		///
+		/// Computes the dot product of a compressed row with a dense vector.
+		/// We use four independent accumulators so that the loads and the
+		/// multiply-adds of successive cells don't form a single dependency chain.
+		/// This lets the compiler pipeline (or vectorize, where gathers exist) the loop.
+		/// Note that for floating point types the summation order differs from a
+		/// naive loop and thus results can differ in the last bits.
+		///
+		template <typename T, typename Index>
+		inline T compressed_dot(const T* EASTL_RESTRICT pValues, const Index* EASTL_RESTRICT pIndices, size_t n, const T* EASTL_RESTRICT x)
+		{
+			T sum0 = T(), sum1 = T(), sum2 = T(), sum3 = T();
+			size_t i = 0;
+
+			for(; (i + 4) <= n; i += 4)
+			{
+				sum0 += pValues[i + 0] * x[pIndices[i + 0]];
+				sum1 += pValues[i + 1] * x[pIndices[i + 1]];
+				sum2 += pValues[i + 2] * x[pIndices[i + 2]];
+				sum3 += pValues[i + 3] * x[pIndices[i + 3]];
+			}
+
+			for(; i < n; ++i)
+				sum0 += pValues[i] * x[pIndices[i]];
+
+			return (sum0 + sum1) + (sum2 + sum3);
+		}
+
+
+		/// compressed_axpy
+		///
+		/// Computes y[indices[i]] += values[i] * a for a compressed row or column.
+		///
+		template <typename T, typename Index>
+		inline void compressed_axpy(const T* EASTL_RESTRICT pValues, const Index* EASTL_RESTRICT pIndices, size_t n, const T& a, T* EASTL_RESTRICT y)
+		{
+			for(size_t i = 0; i < n; ++i)
+				y[pIndices[i]] += pValues[i] * a;
+		}
+
+	} // namespace Internal
+
+
+
+	/// compressed_matrix_base
+	///
+	/// Implements the storage common to csr_matrix and csc_matrix. The 'outer'
+	/// dimension is rows for csr_matrix and columns for csc_matrix; the 'inner'
+	/// dimension is the other one.
+	///
+	/// Index is the integral type used for the offsets and indices arrays.
+	/// The default of int32_t supports up to 2^31 - 1 non-zeros; use int64_t
+	/// (or uint32_t) for larger matrices.
+	///
+	template <typename T, typename Index, typename Allocator>
+	class compressed_matrix_base
+	{
+	public:
+		typedef compressed_matrix_base<T, Index, Allocator>  this_type;
+		typedef T                                            value_type;
+		typedef Index                                        index_type;
+		typedef eastl_size_t                                 size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef ptrdiff_t                                    difference_type;
+		typedef Allocator                                    allocator_type;
+		typedef eastl::vector<index_type, allocator_type>    index_vector_type;
+		typedef eastl::vector<value_type, allocator_type>    value_vector_type;
+
+	public:
+		compressed_matrix_base();
+		explicit compressed_matrix_base(const allocator_type& allocator);
+
+		void swap(this_type& x);
+		void clear();
+
+		bool      empty() const;        // Returns true if there are no non-zero cells.
+		size_type nnz() const;          // Returns the number of stored (non-zero) cells.
+
+		size_type outer_size() const;
+		size_type inner_size() const;
+		size_type outer_nnz(size_type i) const;
+
+		const index_type* offsets() const;      // outer_size() + 1 entries.
+		const index_type* indices() const;      // nnz() entries.
+		const value_type* values() const;       // nnz() entries.
+		value_type*       values();             // Values can be modified in place; structure cannot.
+
+		value_type* find(size_type outer, size_type inner);              // Returns NULL if the cell is not stored. O(log(outer_nnz(outer))).
+		const value_type* find(size_type outer, size_type inner) const;
+
+		// Sets the contents to the given already-compressed arrays. 'pOffsets' must have
+		// outerSize + 1 entries and indices must be sorted and unique within each outer entry.
+		void assign(size_type outerSize, size_type innerSize, const index_type* pOffsets, const index_type* pIndices, const value_type* pValues);
+
+		// Partitions the outer dimension into nPartCount contiguous ranges with
+		// approximately equal numbers of non-zeros. pBoundaries must have room
+		// for nPartCount + 1 entries; part i is [pBoundaries[i], pBoundaries[i + 1]).
+		// This is what you want to use to distribute multiply_rows or multiply_cols
+		// across threads, as rows of real-world matrices vary greatly in length.
+		void partition(size_type nPartCount, size_type* pBoundaries) const;
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT;
+		allocator_type&       getAllocator() EASTL_NOEXCEPT;
+		void                  setAllocator(const allocator_type& allocator);
+
+		bool validate() const;
+
+	protected:
+		void DoTranspose(this_type& result) const;
+		void DoMultiplyOuter(const value_type* x, value_type* y, size_type outerBegin, size_type outerEnd) const;
+		void DoMultiplyInner(const value_type* x, value_type* y, size_type outerBegin, size_type outerEnd) const;
+
+	protected:
+		index_vector_type mOffsets;     // outer_size() + 1 entries, or empty if the matrix was never built.
+		index_vector_type mIndices;     // nnz() entries.
+		value_vector_type mValues;      // nnz() entries.
+		size_type         mnInnerSize;
+
+	}; // compressed_matrix_base
+
+
+
+	template <typename T, typename Index, typename Allocator> class csc_matrix;
+
+
+	/// csr_matrix
+	///
+	/// Implements a compressed sparse row matrix. This is the layout of choice
+	/// for computing y = A * x, as each output element is the dot product of
+	/// one contiguous row with x, and rows can be processed independently
+	/// (e.g. by separate threads) without any write contention.
+	///
+	/// A row's cells are sorted by column, so row iteration visits cells in
+	/// column order.
+	///
+	template <typename T, typename Index = int32_t, typename Allocator = EASTLAllocatorType>
+	class csr_matrix : public compressed_matrix_base<T, Index, Allocator>
+	{
+	public:
+		typedef compressed_matrix_base<T, Index, Allocator>  base_type;
+		typedef csr_matrix<T, Index, Allocator>              this_type;
+		typedef csc_matrix<T, Index, Allocator>              transpose_layout_type;
+		typedef typename base_type::value_type               value_type;
+		typedef typename base_type::index_type               index_type;
+		typedef typename base_type::size_type                size_type;
+		typedef typename base_type::allocator_type           allocator_type;
+
+		using base_type::mOffsets;
+		using base_type::mIndices;
+		using base_type::mValues;
+		using base_type::mnInnerSize;
+
+	public:
+		csr_matrix();
+		explicit csr_matrix(const allocator_type& allocator);
+		explicit csr_matrix(const transpose_layout_type& x);
+
+		size_type rows() const;
+		size_type cols() const;
+		size_type row_nnz(size_type row) const;
+
+		value_type*       find(size_type row, size_type col);
+		const value_type* find(size_type row, size_type col) const;
+
+		// Sparse matrix-vector products. x must have cols() elements and y must have rows() elements.
+		void multiply(const value_type* x, value_type* y) const;                                            // y = A * x
+		void multiply_add(const value_type* x, value_type* y) const;                                        // y += A * x
+		void multiply_rows(const value_type* x, value_type* y, size_type rowBegin, size_type rowEnd) const; // y[rowBegin, rowEnd) = (A * x)[rowBegin, rowEnd). Thread-safe for disjoint row ranges.
+		void multiply_blocked(const value_type* x, value_type* y, size_type blockSize = EASTL_CSR_MATRIX_BLOCK_SIZE) const; // y = A * x, processing x in cache-sized column blocks.
+		void multiply_transpose(const value_type* x, value_type* y) const;                                  // y = transpose(A) * x. x has rows() elements, y has cols() elements.
+
+		// Sparse matrix-dense matrix product. B is a row-major cols() x nColCountB
+		// dense matrix and C is a row-major rows() x nColCountB dense matrix.
+		void multiply_dense(const value_type* B, size_type nColCountB, value_type* C) const;                // C = A * B
+
+		void transpose(this_type& result) const;     // result = transpose(A), in CSR layout.
+		void to_csc(transpose_layout_type& result) const;
+
+		bool validate() const;
+
+	}; // csr_matrix
+
+
+
+	/// csc_matrix
+	///
+	/// Implements a compressed sparse column matrix. This is the layout of choice
+	/// for computing y = transpose(A) * x and for column slicing. Note that the
+	/// CSC arrays of A are identical to the CSR arrays of transpose(A), so
+	/// conversions between the two are a single transposition.
+	///
+	template <typename T, typename Index = int32_t, typename Allocator = EASTLAllocatorType>
+	class csc_matrix : public compressed_matrix_base<T, Index, Allocator>
+	{
+	public:
+		typedef compressed_matrix_base<T, Index, Allocator>  base_type;
+		typedef csc_matrix<T, Index, Allocator>              this_type;
+		typedef csr_matrix<T, Index, Allocator>              transpose_layout_type;
+		typedef typename base_type::value_type               value_type;
+		typedef typename base_type::index_type               index_type;
+		typedef typename base_type::size_type                size_type;
+		typedef typename base_type::allocator_type           allocator_type;
+
+		using base_type::mOffsets;
+		using base_type::mIndices;
+		using base_type::mValues;
+		using base_type::mnInnerSize;
+
+	public:
+		csc_matrix();
+		explicit csc_matrix(const allocator_type& allocator);
+		explicit csc_matrix(const transpose_layout_type& x);
+
+		size_type rows() const;
+		size_type cols() const;
+		size_type col_nnz(size_type col) const;
+
+		value_type*       find(size_type row, size_type col);
+		const value_type* find(size_type row, size_type col) const;
+
+		void multiply(const value_type* x, value_type* y) const;                                            // y = A * x
+		void multiply_add(const value_type* x, value_type* y) const;                                        // y += A * x
+		void multiply_cols(const value_type* x, value_type* y, size_type colBegin, size_type colEnd) const; // y += A[:, colBegin, colEnd) * x[colBegin, colEnd). Disjoint ranges write overlapping y; use one y per thread.
+		void multiply_transpose(const value_type* x, value_type* y) const;                                  // y = transpose(A) * x
+
+		void transpose(this_type& result) const;     // result = transpose(A), in CSC layout.
+		void to_csr(transpose_layout_type& result) const;
+
+		bool validate() const;
+
+	}; // csc_matrix
+
+
+
+	/// csr_matrix_builder
+	///
+	/// Accumulates cells in coordinate (COO) format in any order and then
+	/// compresses them into a csr_matrix or csc_matrix in O(nnz + rows + cols)
+	/// time via a counting sort. Duplicate cells are summed, as is conventional.
+	///
+	template <typename T, typename Index = int32_t, typename Allocator = EASTLAllocatorType>
+	class csr_matrix_builder
+	{
+	public:
+		typedef csr_matrix_builder<T, Index, Allocator>  this_type;
+		typedef T                                        value_type;
+		typedef Index                                    index_type;
+		typedef eastl_size_t                             size_type;
+		typedef Allocator                                allocator_type;
+
+		struct entry
+		{
+			index_type mRow;
+			index_type mCol;
+			value_type mValue;
+		};
+
+		typedef eastl::vector<entry, allocator_type>     entry_vector_type;
+
+	public:
+		csr_matrix_builder();
+		explicit csr_matrix_builder(const allocator_type& allocator);
+
+		void reserve(size_type n);
+		void clear();
+		size_type size() const;
+
+		void add(index_type row, index_type col, const value_type& value);
+
+		// Builds the result. nRowCount and nColCount must be larger than any row/col added.
+		void build(csr_matrix<T, Index, Allocator>& result, size_type nRowCount, size_type nColCount) const;
+		void build(csc_matrix<T, Index, Allocator>& result, size_type nRowCount, size_type nColCount) const;
+
+	protected:
+		void DoBuild(compressed_matrix_base<T, Index, Allocator>& result, size_type nOuterCount, size_type nInnerCount, bool bRowMajor) const;
+
+	protected:
+		entry_vector_type mEntries;
+
+	}; // csr_matrix_builder
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// compressed_matrix_base
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Index, typename Allocator>
+	inline compressed_matrix_base<T, Index, Allocator>::compressed_matrix_base()
+		: mOffsets(EASTL_CSR_MATRIX_DEFAULT_ALLOCATOR),
+		  mIndices(EASTL_CSR_MATRIX_DEFAULT_ALLOCATOR),
+		  mValues(EASTL_CSR_MATRIX_DEFAULT_ALLOCATOR),
+		  mnInnerSize(0)
+	{
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline compressed_matrix_base<T, Index, Allocator>::compressed_matrix_base(const allocator_type& allocator)
+		: mOffsets(allocator), mIndices(allocator), mValues(allocator), mnInnerSize(0)
+	{
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void compressed_matrix_base<T, Index, Allocator>::swap(this_type& x)
+	{
+		mOffsets.swap(x.mOffsets);
+		mIndices.swap(x.mIndices);
+		mValues.swap(x.mValues);
+		eastl::swap(mnInnerSize, x.mnInnerSize);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void compressed_matrix_base<T, Index, Allocator>::clear()
+	{
+		mOffsets.clear();
+		mIndices.clear();
+		mValues.clear();
+		mnInnerSize = 0;
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline bool compressed_matrix_base<T, Index, Allocator>::empty() const
+	{
+		return mValues.empty();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename compressed_matrix_base<T, Index, Allocator>::size_type
+	compressed_matrix_base<T, Index, Allocator>::nnz() const
+	{
+		return mValues.size();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename compressed_matrix_base<T, Index, Allocator>::size_type
+	compressed_matrix_base<T, Index, Allocator>::outer_size() const
+	{
+		return mOffsets.empty() ? 0 : (mOffsets.size() - 1);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename compressed_matrix_base<T, Index, Allocator>::size_type
+	compressed_matrix_base<T, Index, Allocator>::inner_size() const
+	{
+		return mnInnerSize;
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename compressed_matrix_base<T, Index, Allocator>::size_type
+	compressed_matrix_base<T, Index, Allocator>::outer_nnz(size_type i) const
+	{
+		EASTL_ASSERT(i < outer_size());
+		return (size_type)(mOffsets[i + 1] - mOffsets[i]);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline const typename compressed_matrix_base<T, Index, Allocator>::index_type*
+	compressed_matrix_base<T, Index, Allocator>::offsets() const
+	{
+		return mOffsets.data();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline const typename compressed_matrix_base<T, Index, Allocator>::index_type*
+	compressed_matrix_base<T, Index, Allocator>::indices() const
+	{
+		return mIndices.data();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline const typename compressed_matrix_base<T, Index, Allocator>::value_type*
+	compressed_matrix_base<T, Index, Allocator>::values() const
+	{
+		return mValues.data();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename compressed_matrix_base<T, Index, Allocator>::value_type*
+	compressed_matrix_base<T, Index, Allocator>::values()
+	{
+		return mValues.data();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename compressed_matrix_base<T, Index, Allocator>::value_type*
+	compressed_matrix_base<T, Index, Allocator>::find(size_type outer, size_type inner)
+	{
+		return const_cast<value_type*>(static_cast<const this_type*>(this)->find(outer, inner));
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	const typename compressed_matrix_base<T, Index, Allocator>::value_type*
+	compressed_matrix_base<T, Index, Allocator>::find(size_type outer, size_type inner) const
+	{
+		EASTL_ASSERT((outer < outer_size()) && (inner < mnInnerSize));
+
+		const index_type* const pBegin = mIndices.data() + mOffsets[outer];
+		const index_type* const pEnd   = mIndices.data() + mOffsets[outer + 1];
+		const index_type* const pFound = eastl::lowerBound(pBegin, pEnd, (index_type)inner);
+
+		if((pFound != pEnd) && (*pFound == (index_type)inner))
+			return mValues.data() + (pFound - mIndices.data());
+		return NULL;
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	void compressed_matrix_base<T, Index, Allocator>::assign(size_type outerSize, size_type innerSize, const index_type* pOffsets,
+															 const index_type* pIndices, const value_type* pValues)
+	{
+		const size_type n = (size_type)pOffsets[outerSize];
+
+		mOffsets.assign(pOffsets, pOffsets + outerSize + 1);
+		mIndices.assign(pIndices, pIndices + n);
+		mValues.assign(pValues, pValues + n);
+		mnInnerSize = innerSize;
+
+		EASTL_ASSERT(validate());
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	void compressed_matrix_base<T, Index, Allocator>::partition(size_type nPartCount, size_type* pBoundaries) const
+	{
+		EASTL_ASSERT(nPartCount > 0);
+
+		const size_type nOuterSize = outer_size();
+		const size_type nTotal     = nnz();
+
+		pBoundaries[0] = 0;
+
+		for(size_type i = 1; i < nPartCount; ++i)
+		{
+			// Find the first outer entry whose start offset reaches the target share of non-zeros.
+			const index_type  target = (index_type)((nTotal * (uint64_t)i) / nPartCount);
+			const index_type* pFound = eastl::lowerBound(mOffsets.data() + pBoundaries[i - 1], mOffsets.data() + nOuterSize, target);
+
+			pBoundaries[i] = (size_type)(pFound - mOffsets.data());
+		}
+
+		pBoundaries[nPartCount] = nOuterSize;
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline const typename compressed_matrix_base<T, Index, Allocator>::allocator_type&
+	compressed_matrix_base<T, Index, Allocator>::getAllocator() const EASTL_NOEXCEPT
+	{
+		return mValues.getAllocator();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename compressed_matrix_base<T, Index, Allocator>::allocator_type&
+	compressed_matrix_base<T, Index, Allocator>::getAllocator() EASTL_NOEXCEPT
+	{
+		return mValues.getAllocator();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void compressed_matrix_base<T, Index, Allocator>::setAllocator(const allocator_type& allocator)
+	{
+		mOffsets.setAllocator(allocator);
+		mIndices.setAllocator(allocator);
+		mValues.setAllocator(allocator);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	bool compressed_matrix_base<T, Index, Allocator>::validate() const
+	{
+		if(mOffsets.empty())
+			return mIndices.empty() && mValues.empty();
+
+		if((mOffsets[0] != 0) || ((size_type)mOffsets.back() != mIndices.size()) || (mIndices.size() != mValues.size()))
+			return false;
+
+		for(size_type i = 0, iEnd = outer_size(); i < iEnd; ++i)
+		{
+			if(mOffsets[i] > mOffsets[i + 1])
+				return false;
+
+			for(index_type j = mOffsets[i]; j < mOffsets[i + 1]; ++j)
+			{
+				if((mIndices[j] < 0) || ((size_type)mIndices[j] >= mnInnerSize))
+					return false;
+				if((j > mOffsets[i]) && !(mIndices[j - 1] < mIndices[j])) // Indices must be sorted and unique within an outer entry.
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+
+	// Transposition is a counting sort of the cells by their inner index.
+	// Since we visit outer entries in order, the resulting inner lists come
+	// out sorted without any further work.
+	template <typename T, typename Index, typename Allocator>
+	void compressed_matrix_base<T, Index, Allocator>::DoTranspose(this_type& result) const
+	{
+		EASTL_ASSERT(&result != this);
+
+		const size_type nOuterSize = outer_size();
+		const size_type n          = nnz();
+
+		result.mOffsets.assign(mnInnerSize + 1, index_type(0));
+		result.mIndices.resize(n);
+		result.mValues.resize(n);
+		result.mnInnerSize = nOuterSize;
+
+		for(size_type k = 0; k < n; ++k)
+			++result.mOffsets[mIndices[k] + 1];
+
+		for(size_type i = 0; i < mnInnerSize; ++i)
+			result.mOffsets[i + 1] += result.mOffsets[i];
+
+		index_vector_type cursor(result.mOffsets.begin(), result.mOffsets.end() - 1, mOffsets.getAllocator());
+
+		for(size_type i = 0; i < nOuterSize; ++i)
+		{
+			for(index_type k = mOffsets[i]; k < mOffsets[i + 1]; ++k)
+			{
+				const index_type dest = cursor[mIndices[k]]++;
+
+				result.mIndices[dest] = (index_type)i;
+				result.mValues[dest]  = mValues[k];
+			}
+		}
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	void compressed_matrix_base<T, Index, Allocator>::DoMultiplyOuter(const value_type* x, value_type* y, size_type outerBegin, size_type outerEnd) const
+	{
+		EASTL_ASSERT((outerBegin <= outerEnd) && (outerEnd <= outer_size()));
+
+		const index_type* const pOffsets = mOffsets.data();
+		const index_type* const pIndices = mIndices.data();
+		const value_type* const pValues  = mValues.data();
+
+		for(size_type i = outerBegin; i < outerEnd; ++i)
+		{
+			const index_type begin = pOffsets[i];
+			y[i] = Internal::compressed_dot(pValues + begin, pIndices + begin, (size_t)(pOffsets[i + 1] - begin), x);
+		}
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	void compressed_matrix_base<T, Index, Allocator>::DoMultiplyInner(const value_type* x, value_type* y, size_type outerBegin, size_type outerEnd) const
+	{
+		EASTL_ASSERT((outerBegin <= outerEnd) && (outerEnd <= outer_size()));
+
+		const index_type* const pOffsets = mOffsets.data();
+		const index_type* const pIndices = mIndices.data();
+		const value_type* const pValues  = mValues.data();
+
+		for(size_type i = outerBegin; i < outerEnd; ++i)
+		{
+			const index_type begin = pOffsets[i];
+			Internal::compressed_axpy(pValues + begin, pIndices + begin, (size_t)(pOffsets[i + 1] - begin), x[i], y);
+		}
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// csr_matrix
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Index, typename Allocator>
+	inline csr_matrix<T, Index, Allocator>::csr_matrix()
+		: base_type()
+	{
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline csr_matrix<T, Index, Allocator>::csr_matrix(const allocator_type& allocator)
+		: base_type(allocator)
+	{
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline csr_matrix<T, Index, Allocator>::csr_matrix(const transpose_layout_type& x)
+		: base_type(x.getAllocator())
+	{
+		x.to_csr(*this);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csr_matrix<T, Index, Allocator>::size_type
+	csr_matrix<T, Index, Allocator>::rows() const
+	{
+		return base_type::outer_size();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csr_matrix<T, Index, Allocator>::size_type
+	csr_matrix<T, Index, Allocator>::cols() const
+	{
+		return mnInnerSize;
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csr_matrix<T, Index, Allocator>::size_type
+	csr_matrix<T, Index, Allocator>::row_nnz(size_type row) const
+	{
+		return base_type::outer_nnz(row);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csr_matrix<T, Index, Allocator>::value_type*
+	csr_matrix<T, Index, Allocator>::find(size_type row, size_type col)
+	{
+		return base_type::find(row, col);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline const typename csr_matrix<T, Index, Allocator>::value_type*
+	csr_matrix<T, Index, Allocator>::find(size_type row, size_type col) const
+	{
+		return base_type::find(row, col);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix<T, Index, Allocator>::multiply(const value_type* x, value_type* y) const
+	{
+		base_type::DoMultiplyOuter(x, y, 0, rows());
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	void csr_matrix<T, Index, Allocator>::multiply_add(const value_type* x, value_type* y) const
+	{
+		const index_type* const pOffsets = mOffsets.data();
+
+		for(size_type i = 0, iEnd = rows(); i < iEnd; ++i)
+		{
+			const index_type begin = pOffsets[i];
+			y[i] += Internal::compressed_dot(mValues.data() + begin, mIndices.data() + begin, (size_t)(pOffsets[i + 1] - begin), x);
+		}
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix<T, Index, Allocator>::multiply_rows(const value_type* x, value_type* y, size_type rowBegin, size_type rowEnd) const
+	{
+		base_type::DoMultiplyOuter(x, y, rowBegin, rowEnd);
+	}
+
+
+	namespace Internal
+	{
+		// Appends row i to the queue of rows to visit in block b.
+		template <typename Index>
+		inline void csr_block_enqueue(Index* pHead, Index* pTail, Index* pNext, Index i, size_t b)
+		{
+			pNext[i] = Index(-1);
+
+			if(pTail[b] == Index(-1))
+				pHead[b] = i;
+			else
+				pNext[pTail[b]] = i;
+
+			pTail[b] = i;
+		}
+	}
+
+
+	// multiply_blocked
+	//
+	// For matrices with a very wide column range (e.g. web graphs), the x lookups
+	// of a plain row-by-row product are effectively random accesses into a huge
+	// array. Here we instead sweep x in column blocks small enough to stay in cache,
+	// and for each block we process the portion of every row that falls within it.
+	// Each row is queued on the block holding its next unprocessed cell, so a block
+	// visits only the rows that have cells in it, and the whole product takes
+	// O(nnz + rows + blocks) time. The per-row cursors and queue links and the
+	// per-block queue ends are allocated once per call. For matrices with
+	// cols() <= blockSize this degenerates to a plain multiply.
+	//
+	template <typename T, typename Index, typename Allocator>
+	void csr_matrix<T, Index, Allocator>::multiply_blocked(const value_type* x, value_type* y, size_type blockSize) const
+	{
+		typedef typename base_type::index_vector_type index_vector_type;
+
+		const size_type nRowCount = rows();
+		const size_type nColCount = cols();
+
+		if(nColCount <= blockSize)
+		{
+			multiply(x, y);
+			return;
+		}
+
+		const size_type   nBlockCount = (nColCount + blockSize - 1) / blockSize;
+		const index_type  kNone       = index_type(-1);
+
+		index_vector_type cursor(mOffsets.begin(), mOffsets.end() - 1, mOffsets.getAllocator());
+		index_vector_type next(nRowCount, kNone, mOffsets.getAllocator());
+		index_vector_type head(nBlockCount, kNone, mOffsets.getAllocator());
+		index_vector_type tail(nBlockCount, kNone, mOffsets.getAllocator());
+
+		const index_type* const pOffsets = mOffsets.data();
+		const index_type* const pIndices = mIndices.data();
+		const value_type* const pValues  = mValues.data();
+
+		for(size_type i = 0; i < nRowCount; ++i)
+		{
+			y[i] = value_type();
+
+			if(pOffsets[i] != pOffsets[i + 1])
+				Internal::csr_block_enqueue(head.data(), tail.data(), next.data(), (index_type)i, (size_t)pIndices[pOffsets[i]] / blockSize);
+		}
+
+		for(size_type b = 0; b < nBlockCount; ++b)
+		{
+			const index_type blockEnd = (index_type)eastl::minAlt((b + 1) * blockSize, nColCount);
+
+			for(index_type i = head[b], iNext; i != kNone; i = iNext)
+			{
+				iNext = next[i]; // Read before the row is queued on a later block.
+
+				const index_type begin  = cursor[i];
+				index_type       end    = begin;
+				const index_type rowEnd = pOffsets[i + 1];
+
+				while((end < rowEnd) && (pIndices[end] < blockEnd))
+					++end;
+
+				y[i] += Internal::compressed_dot(pValues + begin, pIndices + begin, (size_t)(end - begin), x);
+
+				if(end != rowEnd)
+				{
+					cursor[i] = end;
+					Internal::csr_block_enqueue(head.data(), tail.data(), next.data(), i, (size_t)pIndices[end] / blockSize);
+				}
+			}
+		}
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	void csr_matrix<T, Index, Allocator>::multiply_transpose(const value_type* x, value_type* y) const
+	{
+		for(size_type i = 0, iEnd = cols(); i < iEnd; ++i)
+			y[i] = value_type();
+
+		base_type::DoMultiplyInner(x, y, 0, rows());
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	void csr_matrix<T, Index, Allocator>::multiply_dense(const value_type* B, size_type nColCountB, value_type* C) const
+	{
+		const index_type* const pOffsets = mOffsets.data();
+
+		for(size_type i = 0, iEnd = rows(); i < iEnd; ++i)
+		{
+			value_type* const pRowC = C + (i * nColCountB);
+
+			for(size_type j = 0; j < nColCountB; ++j)
+				pRowC[j] = value_type();
+
+			// Each cell A(i, k) scales row k of B into row i of C. The inner loop
+			// is a contiguous axpy, which compilers readily vectorize.
+			for(index_type k = pOffsets[i]; k < pOffsets[i + 1]; ++k)
+			{
+				const value_type        a     = mValues[k];
+				const value_type* const pRowB = B + ((size_type)mIndices[k] * nColCountB);
+
+				for(size_type j = 0; j < nColCountB; ++j)
+					pRowC[j] += a * pRowB[j];
+			}
+		}
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix<T, Index, Allocator>::transpose(this_type& result) const
+	{
+		base_type::DoTranspose(result);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix<T, Index, Allocator>::to_csc(transpose_layout_type& result) const
+	{
+		// The CSC arrays of A are the CSR arrays of transpose(A).
+		base_type::DoTranspose(result);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline bool csr_matrix<T, Index, Allocator>::validate() const
+	{
+		return base_type::validate();
+	}
+
+
+	/// multiply
+	///
+	/// Computes the sparse matrix-matrix product result = a * b using Gustavson's
+	/// row-by-row algorithm with a dense accumulator of b.cols() entries.
+	/// The cost is proportional to the number of multiply-adds rather than
+	/// to the matrix dimensions. Explicit zeros produced by cancellation are kept.
+	///
+	template <typename T, typename Index, typename Allocator>
+	void multiply(const csr_matrix<T, Index, Allocator>& a, const csr_matrix<T, Index, Allocator>& b, csr_matrix<T, Index, Allocator>& result)
+	{
+		typedef typename csr_matrix<T, Index, Allocator>::size_type size_type;
+
+		EASTL_ASSERT((a.cols() == b.rows()) && (&result != &a) && (&result != &b));
+
+		const size_type nRowCount = a.rows();
+		const size_type nColCount = b.cols();
+		const Index     kUnused   = (Index)-1;
+
+		eastl::vector<T, Allocator>     accumulator(nColCount, T(), a.getAllocator());
+		eastl::vector<Index, Allocator> marker(nColCount, kUnused, a.getAllocator());
+		eastl::vector<Index, Allocator> offsets(a.getAllocator());
+		eastl::vector<Index, Allocator> indices(a.getAllocator());
+		eastl::vector<T, Allocator>     values(a.getAllocator());
+
+		offsets.reserve(nRowCount + 1);
+		offsets.pushBack(Index(0));
+
+		for(size_type i = 0; i < nRowCount; ++i)
+		{
+			const Index rowBegin = (Index)indices.size();
+
+			for(Index ka = a.offsets()[i]; ka < a.offsets()[i + 1]; ++ka)
+			{
+				const T     va = a.values()[ka];
+				const Index k  = a.indices()[ka];
+
+				for(Index kb = b.offsets()[k]; kb < b.offsets()[k + 1]; ++kb)
+				{
+					const Index j = b.indices()[kb];
+
+					if(marker[j] != (Index)i)
+					{
+						marker[j] = (Index)i;
+						accumulator[j] = va * b.values()[kb];
+						indices.pushBack(j);
+					}
+					else
+						accumulator[j] += va * b.values()[kb];
+				}
+			}
+
+			eastl::sort(indices.begin() + rowBegin, indices.end());
+
+			for(eastl_size_t k = (eastl_size_t)rowBegin, kEnd = indices.size(); k < kEnd; ++k)
+				values.pushBack(accumulator[indices[k]]);
+
+			offsets.pushBack((Index)indices.size());
+		}
+
+		result.assign(nRowCount, nColCount, offsets.data(), indices.data(), values.data());
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// csc_matrix
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Index, typename Allocator>
+	inline csc_matrix<T, Index, Allocator>::csc_matrix()
+		: base_type()
+	{
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline csc_matrix<T, Index, Allocator>::csc_matrix(const allocator_type& allocator)
+		: base_type(allocator)
+	{
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline csc_matrix<T, Index, Allocator>::csc_matrix(const transpose_layout_type& x)
+		: base_type(x.getAllocator())
+	{
+		x.to_csc(*this);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csc_matrix<T, Index, Allocator>::size_type
+	csc_matrix<T, Index, Allocator>::rows() const
+	{
+		return mnInnerSize;
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csc_matrix<T, Index, Allocator>::size_type
+	csc_matrix<T, Index, Allocator>::cols() const
+	{
+		return base_type::outer_size();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csc_matrix<T, Index, Allocator>::size_type
+	csc_matrix<T, Index, Allocator>::col_nnz(size_type col) const
+	{
+		return base_type::outer_nnz(col);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csc_matrix<T, Index, Allocator>::value_type*
+	csc_matrix<T, Index, Allocator>::find(size_type row, size_type col)
+	{
+		return base_type::find(col, row);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline const typename csc_matrix<T, Index, Allocator>::value_type*
+	csc_matrix<T, Index, Allocator>::find(size_type row, size_type col) const
+	{
+		return base_type::find(col, row);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	void csc_matrix<T, Index, Allocator>::multiply(const value_type* x, value_type* y) const
+	{
+		for(size_type i = 0, iEnd = rows(); i < iEnd; ++i)
+			y[i] = value_type();
+
+		base_type::DoMultiplyInner(x, y, 0, cols());
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csc_matrix<T, Index, Allocator>::multiply_add(const value_type* x, value_type* y) const
+	{
+		base_type::DoMultiplyInner(x, y, 0, cols());
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csc_matrix<T, Index, Allocator>::multiply_cols(const value_type* x, value_type* y, size_type colBegin, size_type colEnd) const
+	{
+		base_type::DoMultiplyInner(x, y, colBegin, colEnd);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csc_matrix<T, Index, Allocator>::multiply_transpose(const value_type* x, value_type* y) const
+	{
+		base_type::DoMultiplyOuter(x, y, 0, cols());
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csc_matrix<T, Index, Allocator>::transpose(this_type& result) const
+	{
+		base_type::DoTranspose(result);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csc_matrix<T, Index, Allocator>::to_csr(transpose_layout_type& result) const
+	{
+		base_type::DoTranspose(result);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline bool csc_matrix<T, Index, Allocator>::validate() const
+	{
+		return base_type::validate();
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// csr_matrix_builder
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename Index, typename Allocator>
+	inline csr_matrix_builder<T, Index, Allocator>::csr_matrix_builder()
+		: mEntries(EASTL_CSR_MATRIX_DEFAULT_ALLOCATOR)
+	{
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline csr_matrix_builder<T, Index, Allocator>::csr_matrix_builder(const allocator_type& allocator)
+		: mEntries(allocator)
+	{
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix_builder<T, Index, Allocator>::reserve(size_type n)
+	{
+		mEntries.reserve(n);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix_builder<T, Index, Allocator>::clear()
+	{
+		mEntries.clear();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline typename csr_matrix_builder<T, Index, Allocator>::size_type
+	csr_matrix_builder<T, Index, Allocator>::size() const
+	{
+		return mEntries.size();
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix_builder<T, Index, Allocator>::add(index_type row, index_type col, const value_type& value)
+	{
+		EASTL_ASSERT((row >= 0) && (col >= 0));
+
+		entry& e = mEntries.pushBack();
+		e.mRow   = row;
+		e.mCol   = col;
+		e.mValue = value;
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix_builder<T, Index, Allocator>::build(csr_matrix<T, Index, Allocator>& result, size_type nRowCount, size_type nColCount) const
+	{
+		DoBuild(result, nRowCount, nColCount, true);
+	}
+
+
+	template <typename T, typename Index, typename Allocator>
+	inline void csr_matrix_builder<T, Index, Allocator>::build(csc_matrix<T, Index, Allocator>& result, size_type nRowCount, size_type nColCount) const
+	{
+		DoBuild(result, nColCount, nRowCount, false);
+	}
+
+
+	// DoBuild
+	//
+	// We do two counting sort passes: first by inner index into a temporary
+	// matrix, then the transposition of that by outer index into the result.
+	// The second pass visits cells in inner order, so each resulting outer
+	// entry comes out sorted, and duplicates end up adjacent where we merge them.
+	//
+	template <typename T, typename Index, typename Allocator>
+	void csr_matrix_builder<T, Index, Allocator>::DoBuild(compressed_matrix_base<T, Index, Allocator>& result, size_type nOuterCount, size_type nInnerCount, bool bRowMajor) const
+	{
+		typedef compressed_matrix_base<T, Index, Allocator> matrix_type;
+		typedef typename matrix_type::index_vector_type     index_vector_type;
+		typedef typename matrix_type::value_vector_type     value_vector_type;
+
+		const size_type n = mEntries.size();
+
+		// Pass 1: bucket the cells by inner index.
+		index_vector_type innerOffsets(nInnerCount + 1, Index(0), mEntries.getAllocator());
+		index_vector_type outerOfCell(n, Index(0), mEntries.getAllocator());
+		value_vector_type valueOfCell(n, mEntries.getAllocator());
+
+		for(size_type k = 0; k < n; ++k)
+		{
+			const Index inner = bRowMajor ? mEntries[k].mCol : mEntries[k].mRow;
+			EASTL_ASSERT((size_type)inner < nInnerCount);
+			++innerOffsets[inner + 1];
+		}
+
+		for(size_type i = 0; i < nInnerCount; ++i)
+			innerOffsets[i + 1] += innerOffsets[i];
+
+		{
+			index_vector_type cursor(innerOffsets.begin(), innerOffsets.end() - 1, mEntries.getAllocator());
+
+			for(size_type k = 0; k < n; ++k)
+			{
+				const entry& e     = mEntries[k];
+				const Index  inner = bRowMajor ? e.mCol : e.mRow;
+				const Index  dest  = cursor[inner]++;
+
+				outerOfCell[dest] = bRowMajor ? e.mRow : e.mCol;
+				valueOfCell[dest] = e.mValue;
+			}
+		}
+
+		// Pass 2: bucket the cells by outer index, merging duplicates.
+		index_vector_type offsets(nOuterCount + 1, Index(0), mEntries.getAllocator());
+		index_vector_type indices(n, Index(0), mEntries.getAllocator());
+		value_vector_type values(n, mEntries.getAllocator());
+
+		for(size_type k = 0; k < n; ++k)
+		{
+			EASTL_ASSERT((size_type)outerOfCell[k] < nOuterCount);
+			++offsets[outerOfCell[k] + 1];
+		}
+
+		for(size_type i = 0; i < nOuterCount; ++i)
+			offsets[i + 1] += offsets[i];
+
+		index_vector_type cursor(offsets.begin(), offsets.end() - 1, mEntries.getAllocator());
+
+		for(size_type inner = 0; inner < nInnerCount; ++inner)
+		{
+			for(Index k = innerOffsets[inner]; k < innerOffsets[inner + 1]; ++k)
+			{
+				const Index outer = outerOfCell[k];
+
+				if((cursor[outer] != offsets[outer]) && (indices[cursor[outer] - 1] == (Index)inner)) // If this is a duplicate of the previous cell...
+					values[cursor[outer] - 1] += valueOfCell[k];
+				else
+				{
+					const Index dest = cursor[outer]++;
+					indices[dest] = (Index)inner;
+					values[dest]  = valueOfCell[k];
+				}
+			}
+		}
+
+		// Compact away the holes left by merged duplicates, if any.
+		Index write = 0;
+
+		for(size_type i = 0; i < nOuterCount; ++i)
+		{
+			const Index begin = offsets[i];
+			offsets[i] = write;
+
+			for(Index k = begin; k < cursor[i]; ++k, ++write)
+			{
+				indices[write] = indices[k];
+				values[write]  = values[k];
+			}
+		}
+		offsets[nOuterCount] = write;
+
+		result.assign(nOuterCount, nInnerCount, offsets.data(), indices.data(), values.data());
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
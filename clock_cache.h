@@ -0,0 +1,476 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements clock_cache, a fixed capacity key/value cache with the
+// same interface as lru_cache but which approximates LRU with the CLOCK
+// algorithm. A hit only sets a small counter in the entry, where lru_cache
+// must relink the entry into its recency list. This makes hits cheaper and
+// touches less memory, and the counter makes the cache resistant to being
+// flushed by a scan of keys which are each used once.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_CLOCK_CACHE_H
+#define EASTL_CLOCK_CACHE_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/cache_table.h>
+#include <eastl/iterator.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_CLOCK_CACHE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CLOCK_CACHE_DEFAULT_NAME
+		#define EASTL_CLOCK_CACHE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " clock_cache" // Unless the user overrides something, this is "EASTL clock_cache".
+	#endif
+
+
+	/// EASTL_CLOCK_CACHE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_CLOCK_CACHE_DEFAULT_ALLOCATOR
+		#define EASTL_CLOCK_CACHE_DEFAULT_ALLOCATOR allocator_type(EASTL_CLOCK_CACHE_DEFAULT_NAME)
+	#endif
+
+
+
+	/// clock_cache_entry
+	///
+	template <typename Value>
+	struct clock_cache_entry : public cache_entry_base<Value>
+	{
+		uint8_t mnWeight;  // Incremented by a hit, up to kMaxWeight; decremented as the clock hand passes.
+		uint8_t mbInUse;   // True if the value is constructed.
+	};
+
+
+
+	/// clock_cache_iterator
+	///
+	/// Iterates over the entries in storage order, which is not related to recency.
+	///
+	template <typename Value, bool bConst>
+	struct clock_cache_iterator
+	{
+	public:
+		typedef clock_cache_iterator<Value, bConst>                              this_type;
+		typedef clock_cache_iterator<Value, false>                               iterator_type;
+		typedef clock_cache_entry<Value>                                         entry_type;
+		typedef Value                                                            value_type;
+		typedef typename type_select<bConst, const Value*, Value*>::type         pointer;
+		typedef typename type_select<bConst, const Value&, Value&>::type         reference;
+		typedef ptrdiff_t                                                        difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag                               iterator_category;
+
+		entry_type* mpEntry;
+		entry_type* mpEnd;
+
+	public:
+		clock_cache_iterator(entry_type* pEntry = NULL, entry_type* pEnd = NULL)
+			: mpEntry(pEntry), mpEnd(pEnd) { }
+
+		clock_cache_iterator(const iterator_type& x)
+			: mpEntry(x.mpEntry), mpEnd(x.mpEnd) { }
+
+		reference operator*() const
+			{ return mpEntry->value(); }
+
+		pointer operator->() const
+			{ return &mpEntry->value(); }
+
+		this_type& operator++()
+		{
+			++mpEntry;
+			increment_to_used();
+			return *this;
+		}
+
+		this_type operator++(int)
+		{
+			this_type temp(*this);
+			++*this;
+			return temp;
+		}
+
+		void increment_to_used()
+		{
+			while((mpEntry != mpEnd) && !mpEntry->mbInUse)
+				++mpEntry;
+		}
+
+	}; // clock_cache_iterator
+
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator==(const clock_cache_iterator<Value, bConstA>& a, const clock_cache_iterator<Value, bConstB>& b)
+		{ return a.mpEntry == b.mpEntry; }
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator!=(const clock_cache_iterator<Value, bConstA>& a, const clock_cache_iterator<Value, bConstB>& b)
+		{ return a.mpEntry != b.mpEntry; }
+
+
+
+	/// clock_cache
+	///
+	/// A fixed capacity map which, when full, evicts an entry chosen by the
+	/// CLOCK algorithm: a hand sweeps around the entries, evicting the first one
+	/// whose weight is zero and decrementing the weight of each one it passes.
+	/// A new entry starts with a weight of zero and each hit adds one, up to
+	/// kMaxWeight. Thus an entry which was never gotten after being put is
+	/// evicted on the hand's next pass, while an entry which is gotten often
+	/// survives several passes.
+	///
+	/// The interface is that of lru_cache, except that iteration is in storage
+	/// order and there is no back(). The same pointer stability applies: a
+	/// value pointer remains valid until the entry is erased or evicted.
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
+			  typename Allocator = EASTLAllocatorType>
+	class clock_cache
+		: public cache_table<Key, T, Hash, Predicate, Allocator, clock_cache_entry<eastl::pair<const Key, T> > >
+	{
+	public:
+		typedef cache_table<Key, T, Hash, Predicate, Allocator,
+							clock_cache_entry<eastl::pair<const Key, T> > >   base_type;
+		typedef clock_cache<Key, T, Hash, Predicate, Allocator>                this_type;
+		typedef typename base_type::size_type                                  size_type;
+		typedef typename base_type::key_type                                   key_type;
+		typedef typename base_type::mapped_type                                mapped_type;
+		typedef typename base_type::value_type                                 value_type;     // Note that this is pair<const key_type, mapped_type>.
+		typedef typename base_type::allocator_type                             allocator_type;
+		typedef typename base_type::entry_type                                 entry_type;
+		typedef clock_cache_iterator<value_type, false>                        iterator;
+		typedef clock_cache_iterator<value_type, true>                         const_iterator;
+		typedef eastl::pair<mapped_type*, bool>                                insert_return_type;
+
+		using base_type::kNil;
+
+		static const uint8_t kMaxWeight = 3;
+
+	public:
+		explicit clock_cache(size_type capacity = 0, const allocator_type& allocator = EASTL_CLOCK_CACHE_DEFAULT_ALLOCATOR)
+			: base_type(capacity, Hash(), Predicate(), allocator), mnHand(0) { }
+
+		clock_cache(size_type capacity, const Hash& hashFunction, const Predicate& predicate = Predicate(),
+					const allocator_type& allocator = EASTL_CLOCK_CACHE_DEFAULT_ALLOCATOR)
+			: base_type(capacity, hashFunction, predicate, allocator), mnHand(0) { }
+
+	   ~clock_cache()
+			{ base_type::DoClear(); }
+
+		/// get
+		/// Returns the value for key and increments its weight, or returns NULL.
+		/// Counts a hit or a miss.
+		mapped_type* get(const key_type& key)
+		{
+			const uint32_t i = base_type::DoFind(key, base_type::DoHash(key));
+
+			if(i != kNil)
+			{
+				++mStats.mnHits;
+				if(mpEntries[i].mnWeight < kMaxWeight)
+					++mpEntries[i].mnWeight;
+				return &mpEntries[i].value().second;
+			}
+
+			++mStats.mnMisses;
+			return NULL;
+		}
+
+		/// put
+		/// Sets the value for key, evicting an entry if the cache is full. An
+		/// existing entry has its weight incremented as if by get. Returns the
+		/// stored value (NULL if the capacity is zero) and whether the key was
+		/// newly inserted.
+		insert_return_type put(const key_type& key, const mapped_type& value)
+			{ return DoPut(key, value); }
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			insert_return_type put(const key_type& key, mapped_type&& value)
+				{ return DoPut(key, eastl::move(value)); }
+
+			insert_return_type put(key_type&& key, mapped_type&& value)
+				{ return DoPut(eastl::move(key), eastl::move(value)); }
+		#endif
+
+		/// erase
+		/// Removes key without calling the eviction callback. Returns true if it was present.
+		bool erase(const key_type& key);
+
+		void clear();
+
+		/// setCapacity
+		/// Reallocates the cache with the given capacity. If the new capacity is
+		/// smaller than size(), entries are evicted as by put.
+		void setCapacity(size_type capacity);
+
+		void swap(this_type& x);
+
+		iterator       begin() EASTL_NOEXCEPT        { iterator i(mpEntries, mpEntries + base_type::mnHighWater); i.increment_to_used(); return i; }
+		const_iterator begin() const EASTL_NOEXCEPT  { const_iterator i(mpEntries, mpEntries + base_type::mnHighWater); i.increment_to_used(); return i; }
+		const_iterator cbegin() const EASTL_NOEXCEPT { return begin(); }
+
+		iterator       end() EASTL_NOEXCEPT          { return iterator(mpEntries + base_type::mnHighWater, mpEntries + base_type::mnHighWater); }
+		const_iterator end() const EASTL_NOEXCEPT    { return const_iterator(mpEntries + base_type::mnHighWater, mpEntries + base_type::mnHighWater); }
+		const_iterator cend() const EASTL_NOEXCEPT   { return end(); }
+
+		bool validate() const;
+		int  validateIterator(const_iterator i) const;
+
+	protected:
+		using base_type::mpEntries;
+		using base_type::mnSize;
+		using base_type::mnCapacity;
+		using base_type::mStats;
+
+		uint32_t mnHand; // The next entry the clock hand will examine.
+
+		uint32_t DoEvict();
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			template <typename KeyArg, typename ValueArg>
+			insert_return_type DoPut(KeyArg&& key, ValueArg&& value);
+		#else
+			template <typename KeyArg, typename ValueArg>
+			insert_return_type DoPut(const KeyArg& key, const ValueArg& value);
+		#endif
+
+	}; // class clock_cache
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// clock_cache
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	uint32_t clock_cache<K, T, H, P, A>::DoEvict()
+	{
+		// This is called only when the cache is full, so every entry is in use.
+		// The sweep ends within kMaxWeight + 1 revolutions, as each pass decrements.
+		for(;;)
+		{
+			entry_type& entry = mpEntries[mnHand];
+			const uint32_t i  = mnHand;
+
+			if(++mnHand == mnCapacity)
+				mnHand = 0;
+
+			if(entry.mnWeight == 0)
+			{
+				entry.mbInUse = 0;
+				base_type::DoEvictEntry(i);
+				return i;
+			}
+
+			--entry.mnWeight;
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	template <typename KeyArg, typename ValueArg>
+	typename clock_cache<K, T, H, P, A>::insert_return_type
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		clock_cache<K, T, H, P, A>::DoPut(KeyArg&& key, ValueArg&& value)
+	#else
+		clock_cache<K, T, H, P, A>::DoPut(const KeyArg& key, const ValueArg& value)
+	#endif
+	{
+		const uint32_t h = base_type::DoHash(key);
+		uint32_t       i = base_type::DoFind(key, h);
+
+		if(i != kNil)
+		{
+			mpEntries[i].value().second = EASTL_FORWARD(ValueArg, value);
+			if(mpEntries[i].mnWeight < kMaxWeight)
+				++mpEntries[i].mnWeight;
+			return insert_return_type(&mpEntries[i].value().second, false);
+		}
+
+		if(mnCapacity == 0)
+			return insert_return_type((mapped_type*)NULL, false);
+
+		i = base_type::DoAllocateEntry();
+
+		if(i == kNil)
+		{
+			DoEvict();
+			i = base_type::DoAllocateEntry();
+		}
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+				::new((void*)&mpEntries[i].mStorage) value_type(EASTL_FORWARD(KeyArg, key), EASTL_FORWARD(ValueArg, value));
+			}
+			catch(...)
+			{
+				mpEntries[i].mbInUse = 0;
+				base_type::DoAbandonEntry(i);
+				throw;
+			}
+		#else
+			::new((void*)&mpEntries[i].mStorage) value_type(EASTL_FORWARD(KeyArg, key), EASTL_FORWARD(ValueArg, value));
+		#endif
+
+		mpEntries[i].mnWeight = 0;
+		mpEntries[i].mbInUse  = 1;
+		base_type::DoLinkEntry(i, h);
+		++mStats.mnInserts;
+
+		return insert_return_type(&mpEntries[i].value().second, true);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	bool clock_cache<K, T, H, P, A>::erase(const key_type& key)
+	{
+		const uint32_t i = base_type::DoFind(key, base_type::DoHash(key));
+
+		if(i != kNil)
+		{
+			mpEntries[i].mbInUse = 0;
+			base_type::DoUnlinkEntry(i);
+			base_type::DoFreeEntry(i);
+			return true;
+		}
+
+		return false;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void clock_cache<K, T, H, P, A>::clear()
+	{
+		// Entries at or above the high water mark are never looked at, so their mbInUse flags needn't be reset.
+		base_type::DoClear();
+		mnHand = 0;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	void clock_cache<K, T, H, P, A>::setCapacity(size_type capacity)
+	{
+		if(capacity != mnCapacity)
+		{
+			// A cache of capacity 0 drops anything put into it without evicting it,
+			// so the entries are evicted here instead.
+			if(capacity == 0)
+			{
+				#if EASTL_ASSERT_ENABLED
+					const size_type nOldSize      = base_type::size();
+					const uint64_t  nOldEvictions = mStats.mnEvictions;
+				#endif
+
+				for(iterator it = begin(), itEnd = end(); it != itEnd; )
+				{
+					entry_type* const pEntry = it.mpEntry;
+					++it;
+					pEntry->mbInUse = 0;
+					base_type::DoEvictEntry((uint32_t)(pEntry - mpEntries));
+				}
+
+				EASTL_ASSERT((base_type::size() == 0) && ((mStats.mnEvictions - nOldEvictions) == nOldSize)); // Every entry went through the eviction callback.
+			}
+
+			this_type temp(capacity, base_type::mHash, base_type::mPredicate, base_type::mAllocator);
+			temp.setEvictionCallback(base_type::mpEvictionCallback, base_type::mpEvictionContext);
+
+			for(iterator it = begin(), itEnd = end(); it != itEnd; ++it)
+			{
+				temp.DoPut(it->first, eastl::move(it->second));
+
+				// Carry the weight over, so that the hot entries are the ones kept if shrinking.
+				const uint32_t i = temp.DoFind(it->first, temp.DoHash(it->first));
+				if(i != kNil)
+					temp.mpEntries[i].mnWeight = it.mpEntry->mnWeight;
+			}
+
+			temp.mStats.mnHits      = mStats.mnHits;
+			temp.mStats.mnMisses    = mStats.mnMisses;
+			temp.mStats.mnInserts   = mStats.mnInserts;
+			temp.mStats.mnEvictions += mStats.mnEvictions;
+
+			swap(temp);
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void clock_cache<K, T, H, P, A>::swap(this_type& x)
+	{
+		base_type::DoSwap(x);
+		eastl::swap(mnHand, x.mnHand);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	bool clock_cache<K, T, H, P, A>::validate() const
+	{
+		if((mnSize > mnCapacity) || (base_type::mnHighWater > mnCapacity) || (mnCapacity && (mnHand >= mnCapacity)))
+			return false;
+
+		uint32_t nCount = 0;
+
+		for(uint32_t i = 0; i < base_type::mnHighWater; ++i)
+		{
+			if(mpEntries[i].mbInUse)
+			{
+				if(mpEntries[i].mnWeight > kMaxWeight)
+					return false;
+
+				if(base_type::DoFind(mpEntries[i].value().first, mpEntries[i].mnHash) != i)
+					return false;
+
+				++nCount;
+			}
+		}
+
+		return (nCount == mnSize);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	int clock_cache<K, T, H, P, A>::validateIterator(const_iterator i) const
+	{
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		if((i.mpEntry >= mpEntries) && (i.mpEntry < (mpEntries + base_type::mnHighWater)) && i.mpEntry->mbInUse)
+			return (isf_valid | isf_current | isf_can_dereference);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void swap(clock_cache<K, T, H, P, A>& a, clock_cache<K, T, H, P, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,416 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements count_min_sketch, a fixed size table which estimates
+// how many times each key has been added to a stream, in place of a hashMap
+// of exact counters which grows with the number of distinct keys. Estimates
+// are never low; they are high by at most epsilon * total() with probability
+// 1 - delta, where width = e / epsilon and depth = ln(1 / delta).
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_COUNT_MIN_SKETCH_H
+#define EASTL_COUNT_MIN_SKETCH_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/filter_support.h>
+#include <eastl/allocator.h>
+#include <eastl/functional.h>
+#include <eastl/numeric_limits.h>
+#include <eastl/type_traits.h>
+#include <eastl/utility.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <math.h>
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <math.h>
+	#include <string.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_COUNT_MIN_SKETCH_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_COUNT_MIN_SKETCH_DEFAULT_NAME
+		#define EASTL_COUNT_MIN_SKETCH_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " count_min_sketch" // Unless the user overrides something, this is "EASTL count_min_sketch".
+	#endif
+
+
+	/// EASTL_COUNT_MIN_SKETCH_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_COUNT_MIN_SKETCH_DEFAULT_ALLOCATOR
+		#define EASTL_COUNT_MIN_SKETCH_DEFAULT_ALLOCATOR allocator_type(EASTL_COUNT_MIN_SKETCH_DEFAULT_NAME)
+	#endif
+
+
+
+	/// count_min_sketch
+	///
+	/// A depth x width table of Counter, where width is a power of two. Adding a
+	/// key increments one counter in each row, and the estimate is the smallest
+	/// of the key's counters. Counters saturate rather than wrap.
+	///
+	/// add_conservative increments only those of the key's counters which are
+	/// at the minimum, which is much more accurate for skewed streams. It must
+	/// not be mixed with negative updates, which this class doesn't support anyway.
+	///
+	/// Sketches of the same shape can be merged, so each thread can count into
+	/// its own sketch and the results can be summed at the end.
+	///
+	/// To find heavy hitters, pair the sketch with a small set of candidates,
+	/// such as a fixed size heap of the keys whose estimate after add was highest.
+	///
+	/// Example usage:
+	///     count_min_sketch<eastl::string> sketch(2048, 4); // 32 KB; error at most 0.13% of total() with probability 98%.
+	///
+	///     sketch.add(requestPath);
+	///     if(sketch.estimate(requestPath) > (sketch.total() / 100))
+	///         heavyHitters.insert(requestPath);
+	///
+	template <typename T, typename Counter = uint32_t, typename Hash = eastl::hash<T>, typename Allocator = EASTLAllocatorType>
+	class count_min_sketch
+	{
+		static_assert(is_unsigned<Counter>::value, "count_min_sketch: Counter must be an unsigned integer type.");
+
+	public:
+		typedef count_min_sketch<T, Counter, Hash, Allocator>  this_type;
+		typedef T                                              value_type;
+		typedef Counter                                        counter_type;
+		typedef eastl_size_t                                   size_type;
+		typedef Hash                                           hasher;
+		typedef Allocator                                      allocator_type;
+
+		static const uint32_t kMaxDepth = 32;
+
+	public:
+		count_min_sketch(const allocator_type& allocator = EASTL_COUNT_MIN_SKETCH_DEFAULT_ALLOCATOR);
+		count_min_sketch(size_type nWidth, size_type nDepth, const allocator_type& allocator = EASTL_COUNT_MIN_SKETCH_DEFAULT_ALLOCATOR);
+		count_min_sketch(const this_type& x);
+	   ~count_min_sketch();
+
+		this_type& operator=(const this_type& x);
+		void       swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+		/// reset
+		/// Reallocates and clears the sketch. nWidth is rounded up to a power of two.
+		void reset(size_type nWidth, size_type nDepth);
+
+		/// reset_for_error
+		/// Reallocates and clears the sketch, sized so that estimates are high by
+		/// at most fEpsilon * total() with probability at least 1 - fDelta.
+		void reset_for_error(float fEpsilon, float fDelta);
+
+		void clear();
+
+		void add(const value_type& value, counter_type n = 1)
+			{ add_hash(Internal::filter_mix64((uint64_t)mHash(value)), n); }
+
+		void add_conservative(const value_type& value, counter_type n = 1)
+			{ add_conservative_hash(Internal::filter_mix64((uint64_t)mHash(value)), n); }
+
+		counter_type estimate(const value_type& value) const
+			{ return estimate_hash(Internal::filter_mix64((uint64_t)mHash(value))); }
+
+		void         add_hash(uint64_t h, counter_type n = 1);
+		void         add_conservative_hash(uint64_t h, counter_type n = 1);
+		counter_type estimate_hash(uint64_t h) const;
+
+		/// merge
+		/// Adds x's counts to this sketch. Returns false, and does nothing, if x has a different shape.
+		bool merge(const this_type& x);
+
+		uint64_t  total() const EASTL_NOEXCEPT         { return mnTotal; } // The sum of all n added.
+		size_type width() const EASTL_NOEXCEPT         { return mnWidth; }
+		size_type depth() const EASTL_NOEXCEPT         { return mnDepth; }
+		size_type size_in_bytes() const EASTL_NOEXCEPT { return (size_type)mnWidth * mnDepth * sizeof(Counter); }
+
+		bool validate() const;
+
+	protected:
+		Counter*       mpCounters;   // mnDepth rows of mnWidth counters.
+		uint32_t       mnWidth;
+		uint32_t       mnDepth;
+		uint64_t       mnTotal;
+		hasher         mHash;
+		allocator_type mAllocator;
+
+		void DoAllocate(uint32_t nWidth, uint32_t nDepth);
+		void DoFree();
+
+		// Each row's column comes from two 32 bit halves of the hash, h1 + row * h2,
+		// which is as good as independent hashes per row (Kirsch and Mitzenmacher).
+		uint32_t DoColumn(uint64_t h, uint32_t nRow) const
+			{ return ((uint32_t)h + (nRow * ((uint32_t)(h >> 32) | 1))) & (mnWidth - 1); }
+
+		static Counter DoSaturatingAdd(Counter a, Counter b)
+			{ return (a > (eastl::numeric_limits<Counter>::max() - b)) ? eastl::numeric_limits<Counter>::max() : (Counter)(a + b); }
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// count_min_sketch
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename C, typename H, typename A>
+	inline count_min_sketch<T, C, H, A>::count_min_sketch(const allocator_type& allocator)
+		: mpCounters(NULL), mnWidth(0), mnDepth(0), mnTotal(0), mHash(), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	inline count_min_sketch<T, C, H, A>::count_min_sketch(size_type nWidth, size_type nDepth, const allocator_type& allocator)
+		: mpCounters(NULL), mnWidth(0), mnDepth(0), mnTotal(0), mHash(), mAllocator(allocator)
+	{
+		reset(nWidth, nDepth);
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	inline count_min_sketch<T, C, H, A>::count_min_sketch(const this_type& x)
+		: mpCounters(NULL), mnWidth(0), mnDepth(0), mnTotal(x.mnTotal), mHash(x.mHash), mAllocator(x.mAllocator)
+	{
+		DoAllocate(x.mnWidth, x.mnDepth);
+		if(mpCounters)
+			memcpy(mpCounters, x.mpCounters, size_in_bytes());
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	inline count_min_sketch<T, C, H, A>::~count_min_sketch()
+	{
+		DoFree();
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	typename count_min_sketch<T, C, H, A>::this_type&
+	count_min_sketch<T, C, H, A>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			if((mnWidth != x.mnWidth) || (mnDepth != x.mnDepth))
+			{
+				DoFree();
+				DoAllocate(x.mnWidth, x.mnDepth);
+			}
+			if(mpCounters)
+				memcpy(mpCounters, x.mpCounters, size_in_bytes());
+			mnTotal = x.mnTotal;
+			mHash   = x.mHash;
+		}
+		return *this;
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	inline void count_min_sketch<T, C, H, A>::swap(this_type& x)
+	{
+		eastl::swap(mpCounters, x.mpCounters);
+		eastl::swap(mnWidth,    x.mnWidth);
+		eastl::swap(mnDepth,    x.mnDepth);
+		eastl::swap(mnTotal,    x.mnTotal);
+		eastl::swap(mHash,      x.mHash);
+		eastl::swap(mAllocator, x.mAllocator);
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	void count_min_sketch<T, C, H, A>::DoAllocate(uint32_t nWidth, uint32_t nDepth)
+	{
+		mnWidth    = nWidth;
+		mnDepth    = nDepth;
+		mpCounters = NULL;
+
+		if(nWidth && nDepth)
+		{
+			mpCounters = (C*)allocate_memory(mAllocator, size_in_bytes(), EASTL_ALIGN_OF(C), 0);
+			EASTL_ASSERT(mpCounters != NULL);
+		}
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	void count_min_sketch<T, C, H, A>::DoFree()
+	{
+		if(mpCounters)
+			EASTLFree(mAllocator, mpCounters, size_in_bytes());
+		mpCounters = NULL;
+		mnWidth    = 0;
+		mnDepth    = 0;
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	void count_min_sketch<T, C, H, A>::reset(size_type nWidth, size_type nDepth)
+	{
+		EASTL_ASSERT((nWidth <= 0x80000000u) && (nDepth <= kMaxDepth));
+
+		uint32_t nWidthPow2 = 1;
+		while(nWidthPow2 < nWidth)
+			nWidthPow2 *= 2;
+
+		if((nWidthPow2 != mnWidth) || (nDepth != mnDepth))
+		{
+			DoFree();
+			DoAllocate(nWidthPow2, (uint32_t)nDepth);
+		}
+		clear();
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	void count_min_sketch<T, C, H, A>::reset_for_error(float fEpsilon, float fDelta)
+	{
+		EASTL_ASSERT((fEpsilon > 0.f) && (fDelta > 0.f) && (fDelta < 1.f));
+
+		const double fWidth = ceil(2.718281828459045 / (double)fEpsilon);
+		const double fDepth = ceil(log(1.0 / (double)fDelta));
+
+		reset((size_type)fWidth, (fDepth < 1.0) ? 1 : (fDepth > kMaxDepth) ? kMaxDepth : (size_type)fDepth);
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	inline void count_min_sketch<T, C, H, A>::clear()
+	{
+		if(mpCounters)
+			memset(mpCounters, 0, size_in_bytes());
+		mnTotal = 0;
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	inline void count_min_sketch<T, C, H, A>::add_hash(uint64_t h, counter_type n)
+	{
+		EASTL_ASSERT(mpCounters != NULL);
+
+		for(uint32_t r = 0; r < mnDepth; ++r)
+		{
+			C& c = mpCounters[(r * mnWidth) + DoColumn(h, r)];
+			c = DoSaturatingAdd(c, n);
+		}
+
+		mnTotal += n;
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	void count_min_sketch<T, C, H, A>::add_conservative_hash(uint64_t h, counter_type n)
+	{
+		EASTL_ASSERT(mpCounters != NULL);
+
+		C* pCounters[kMaxDepth];
+		C  nMin = eastl::numeric_limits<C>::max();
+
+		for(uint32_t r = 0; r < mnDepth; ++r)
+		{
+			pCounters[r] = &mpCounters[(r * mnWidth) + DoColumn(h, r)];
+			if(*pCounters[r] < nMin)
+				nMin = *pCounters[r];
+		}
+
+		// Raise every counter to at least the new estimate, but no further.
+		const C nNew = DoSaturatingAdd(nMin, n);
+
+		for(uint32_t r = 0; r < mnDepth; ++r)
+		{
+			if(*pCounters[r] < nNew)
+				*pCounters[r] = nNew;
+		}
+
+		mnTotal += n;
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	inline typename count_min_sketch<T, C, H, A>::counter_type
+	count_min_sketch<T, C, H, A>::estimate_hash(uint64_t h) const
+	{
+		C nMin = mpCounters ? eastl::numeric_limits<C>::max() : 0;
+
+		for(uint32_t r = 0; r < mnDepth; ++r)
+		{
+			const C c = mpCounters[(r * mnWidth) + DoColumn(h, r)];
+			if(c < nMin)
+				nMin = c;
+		}
+
+		return nMin;
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	bool count_min_sketch<T, C, H, A>::merge(const this_type& x)
+	{
+		if((x.mnWidth != mnWidth) || (x.mnDepth != mnDepth))
+			return false;
+
+		const size_type nCount = (size_type)mnWidth * mnDepth;
+
+		for(size_type i = 0; i < nCount; ++i)
+			mpCounters[i] = DoSaturatingAdd(mpCounters[i], x.mpCounters[i]);
+
+		mnTotal += x.mnTotal;
+		return true;
+	}
+
+
+	template <typename T, typename C, typename H, typename A>
+	bool count_min_sketch<T, C, H, A>::validate() const
+	{
+		if((mpCounters == NULL) != ((mnWidth == 0) || (mnDepth == 0)))
+			return false;
+
+		if((mnWidth & (mnWidth - 1)) || (mnDepth > kMaxDepth))
+			return false;
+
+		// No counter can exceed the total, unless it saturated.
+		const size_type nCount = (size_type)mnWidth * mnDepth;
+
+		for(size_type i = 0; i < nCount; ++i)
+		{
+			if(((uint64_t)mpCounters[i] > mnTotal) && (mpCounters[i] != eastl::numeric_limits<C>::max()))
+				return false;
+		}
+
+		return true;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename C, typename H, typename A>
+	inline void swap(count_min_sketch<T, C, H, A>& a, count_min_sketch<T, C, H, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,615 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements cuckoo_filter, an approximate set which, unlike
+// bloom_filter, supports erase. It stores a small fingerprint of each key in
+// a cuckoo hash table of 4 slot buckets. A key's fingerprint lives in one of
+// two buckets, and the second bucket can be computed from the first and the
+// fingerprint alone, so entries can be relocated without knowing their keys.
+//
+// With 16 bit fingerprints the false positive rate is about 0.01% at about
+// 17 bits per key; with 8 bit fingerprints it is about 3% at about 9 bits
+// per key. For rates near 1% bloom_filter is smaller.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_CUCKOO_FILTER_H
+#define EASTL_CUCKOO_FILTER_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/filter_support.h>
+#include <eastl/allocator.h>
+#include <eastl/functional.h>
+#include <eastl/type_traits.h>
+#include <eastl/utility.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <string.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_CUCKOO_FILTER_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_CUCKOO_FILTER_DEFAULT_NAME
+		#define EASTL_CUCKOO_FILTER_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " cuckoo_filter" // Unless the user overrides something, this is "EASTL cuckoo_filter".
+	#endif
+
+
+	/// EASTL_CUCKOO_FILTER_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_CUCKOO_FILTER_DEFAULT_ALLOCATOR
+		#define EASTL_CUCKOO_FILTER_DEFAULT_ALLOCATOR allocator_type(EASTL_CUCKOO_FILTER_DEFAULT_NAME)
+	#endif
+
+
+
+	/// cuckoo_filter
+	///
+	/// Fingerprint is uint8_t, uint16_t or uint32_t, and sets the false positive
+	/// rate: about 8 / 2^bits at full load. Keys are hashed as by bloom_filter,
+	/// and insert_hash, contains_hash and erase_hash take a 64 bit hash directly.
+	///
+	/// insert can fail when the table is nearly full, which is at about 95% of
+	/// capacity() with 4 slot buckets. The filter keeps one displaced fingerprint
+	/// aside when that happens, so a failed insert doesn't lose an earlier key;
+	/// further inserts fail until an erase makes room.
+	///
+	/// erase must only be called for keys which were inserted; erasing a key
+	/// which wasn't, but which collides with one which was, removes the other.
+	/// A key inserted n times must be erased n times.
+	///
+	/// Example usage:
+	///     cuckoo_filter<uint64_t> filter(100000);
+	///     filter.insert(sessionId);
+	///     ...
+	///     filter.erase(sessionId);
+	///
+	template <typename T, typename Fingerprint = uint16_t, typename Hash = eastl::hash<T>, typename Allocator = EASTLAllocatorType>
+	class cuckoo_filter
+	{
+		static_assert(is_unsigned<Fingerprint>::value && (sizeof(Fingerprint) <= 4), "cuckoo_filter: Fingerprint must be uint8_t, uint16_t or uint32_t.");
+
+	public:
+		typedef cuckoo_filter<T, Fingerprint, Hash, Allocator>  this_type;
+		typedef T                                               value_type;
+		typedef Fingerprint                                     fingerprint_type;
+		typedef eastl_size_t                                    size_type;
+		typedef Hash                                            hasher;
+		typedef Allocator                                       allocator_type;
+
+		static const uint32_t kBucketSlotCount = 4;
+		static const uint32_t kMaxKickCount    = 500;
+		static const uint32_t kSerializeMagic  = 0x46434145; // "EACF" in little endian.
+
+	public:
+		cuckoo_filter(const allocator_type& allocator = EASTL_CUCKOO_FILTER_DEFAULT_ALLOCATOR);
+		explicit cuckoo_filter(size_type nExpectedCount, const allocator_type& allocator = EASTL_CUCKOO_FILTER_DEFAULT_ALLOCATOR);
+		cuckoo_filter(const this_type& x);
+	   ~cuckoo_filter();
+
+		this_type& operator=(const this_type& x);
+		void       swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+		/// reset
+		/// Reallocates and clears the filter, with room for at least nExpectedCount keys.
+		void reset(size_type nExpectedCount);
+
+		void clear();
+
+		/// insert
+		/// Returns false if the filter is too full to add value.
+		bool insert(const value_type& value)
+			{ return insert_hash(Internal::filter_mix64((uint64_t)mHash(value))); }
+
+		bool contains(const value_type& value) const
+			{ return contains_hash(Internal::filter_mix64((uint64_t)mHash(value))); }
+
+		/// erase
+		/// Removes one copy of value, which must have been inserted. Returns false if no fingerprint matched.
+		bool erase(const value_type& value)
+			{ return erase_hash(Internal::filter_mix64((uint64_t)mHash(value))); }
+
+		bool insert_hash(uint64_t h);
+		bool contains_hash(uint64_t h) const;
+		bool erase_hash(uint64_t h);
+
+		/// merge
+		/// Adds all of x's keys to this filter, which must have the same bucket
+		/// count. Returns false if the bucket counts differ, or if the filter
+		/// filled up, in which case only some of x's keys were added.
+		bool merge(const this_type& x);
+
+		size_type size() const EASTL_NOEXCEPT          { return mnSize; }
+		bool      empty() const EASTL_NOEXCEPT         { return (mnSize == 0); }
+		size_type capacity() const EASTL_NOEXCEPT      { return (size_type)mnBucketCount * kBucketSlotCount; }
+		size_type bucket_count() const EASTL_NOEXCEPT  { return mnBucketCount; }
+		size_type size_in_bytes() const EASTL_NOEXCEPT { return (size_type)mnBucketCount * kBucketSlotCount * sizeof(Fingerprint); }
+		float     load_factor() const EASTL_NOEXCEPT   { return mnBucketCount ? ((float)mnSize / (float)capacity()) : 0.f; }
+
+		/// false_positive_rate
+		/// Returns the expected false positive rate at the current load.
+		double false_positive_rate() const;
+
+		size_type serialized_size() const EASTL_NOEXCEPT
+			{ return sizeof(Internal::filter_header) + size_in_bytes() + (2 * sizeof(uint32_t)); }
+
+		size_type serialize(void* pBuffer, size_type nBufferSize) const;
+		bool      deserialize(const void* pBuffer, size_type nBufferSize);
+
+		bool validate() const;
+
+	protected:
+		Fingerprint*   mpSlots;         // mnBucketCount * kBucketSlotCount fingerprints. Zero is an empty slot.
+		uint32_t       mnBucketCount;   // Always a power of two, as bucket indices are combined with xor.
+		size_type      mnSize;
+		uint32_t       mnVictimBucket;  // The bucket of the fingerprint which a failed insert couldn't place, or kNoVictim.
+		Fingerprint    mVictim;
+		uint32_t       mnRandom;        // State for choosing which slot to kick out.
+		hasher         mHash;
+		allocator_type mAllocator;
+
+		static const uint32_t kNoVictim = 0xffffffff;
+
+		void DoAllocate(uint32_t nBucketCount);
+		void DoFree();
+
+		uint32_t DoAltBucket(uint32_t nBucket, Fingerprint fp) const
+			{ return (nBucket ^ ((uint32_t)fp * 0x5bd1e995)) & (mnBucketCount - 1); }
+
+		void DoSplit(uint64_t h, uint32_t& nBucket, Fingerprint& fp) const
+		{
+			nBucket = (uint32_t)h & (mnBucketCount - 1);
+			fp      = (Fingerprint)(h >> 32);
+			if(fp == 0) // Zero marks an empty slot.
+				fp = 1;
+		}
+
+		bool DoBucketContains(uint32_t nBucket, Fingerprint fp) const
+		{
+			const Fingerprint* const p = mpSlots + (nBucket * kBucketSlotCount);
+			return (p[0] == fp) | (p[1] == fp) | (p[2] == fp) | (p[3] == fp); // Not || so that this compiles to branch free compares.
+		}
+
+		bool DoBucketInsert(uint32_t nBucket, Fingerprint fp);
+		bool DoBucketErase(uint32_t nBucket, Fingerprint fp);
+		bool DoInsert(uint32_t nBucket, Fingerprint fp);
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// cuckoo_filter
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename F, typename H, typename A>
+	inline cuckoo_filter<T, F, H, A>::cuckoo_filter(const allocator_type& allocator)
+		: mpSlots(NULL), mnBucketCount(0), mnSize(0), mnVictimBucket(kNoVictim), mVictim(0), mnRandom(0x2545F491), mHash(), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	inline cuckoo_filter<T, F, H, A>::cuckoo_filter(size_type nExpectedCount, const allocator_type& allocator)
+		: mpSlots(NULL), mnBucketCount(0), mnSize(0), mnVictimBucket(kNoVictim), mVictim(0), mnRandom(0x2545F491), mHash(), mAllocator(allocator)
+	{
+		reset(nExpectedCount);
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	inline cuckoo_filter<T, F, H, A>::cuckoo_filter(const this_type& x)
+		: mpSlots(NULL), mnBucketCount(0), mnSize(x.mnSize), mnVictimBucket(x.mnVictimBucket), mVictim(x.mVictim),
+		  mnRandom(x.mnRandom), mHash(x.mHash), mAllocator(x.mAllocator)
+	{
+		DoAllocate(x.mnBucketCount);
+		if(mnBucketCount)
+			memcpy(mpSlots, x.mpSlots, size_in_bytes());
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	inline cuckoo_filter<T, F, H, A>::~cuckoo_filter()
+	{
+		DoFree();
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	typename cuckoo_filter<T, F, H, A>::this_type&
+	cuckoo_filter<T, F, H, A>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			if(mnBucketCount != x.mnBucketCount)
+			{
+				DoFree();
+				DoAllocate(x.mnBucketCount);
+			}
+			if(mnBucketCount)
+				memcpy(mpSlots, x.mpSlots, size_in_bytes());
+			mnSize         = x.mnSize;
+			mnVictimBucket = x.mnVictimBucket;
+			mVictim        = x.mVictim;
+			mnRandom       = x.mnRandom;
+			mHash          = x.mHash;
+		}
+		return *this;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	inline void cuckoo_filter<T, F, H, A>::swap(this_type& x)
+	{
+		eastl::swap(mpSlots,        x.mpSlots);
+		eastl::swap(mnBucketCount,  x.mnBucketCount);
+		eastl::swap(mnSize,         x.mnSize);
+		eastl::swap(mnVictimBucket, x.mnVictimBucket);
+		eastl::swap(mVictim,        x.mVictim);
+		eastl::swap(mnRandom,       x.mnRandom);
+		eastl::swap(mHash,          x.mHash);
+		eastl::swap(mAllocator,     x.mAllocator);
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	void cuckoo_filter<T, F, H, A>::DoAllocate(uint32_t nBucketCount)
+	{
+		EASTL_ASSERT((nBucketCount & (nBucketCount - 1)) == 0);
+
+		mnBucketCount = nBucketCount;
+		mpSlots       = NULL;
+
+		if(nBucketCount)
+		{
+			mpSlots = (F*)allocate_memory(mAllocator, size_in_bytes(), kBucketSlotCount * sizeof(F), 0);
+			EASTL_ASSERT(mpSlots != NULL);
+		}
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	void cuckoo_filter<T, F, H, A>::DoFree()
+	{
+		if(mpSlots)
+			EASTLFree(mAllocator, mpSlots, size_in_bytes());
+		mpSlots       = NULL;
+		mnBucketCount = 0;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	void cuckoo_filter<T, F, H, A>::reset(size_type nExpectedCount)
+	{
+		// Aim for at most 95% load, above which inserts start to fail.
+		const size_type nNeeded = (size_type)(((double)nExpectedCount / 0.95) / kBucketSlotCount) + 1;
+
+		uint32_t nBucketCount = 1;
+		while(nBucketCount < nNeeded)
+			nBucketCount *= 2;
+
+		if(nBucketCount != mnBucketCount)
+		{
+			DoFree();
+			DoAllocate(nBucketCount);
+		}
+		clear();
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	inline void cuckoo_filter<T, F, H, A>::clear()
+	{
+		if(mnBucketCount)
+			memset(mpSlots, 0, size_in_bytes());
+		mnSize         = 0;
+		mnVictimBucket = kNoVictim;
+		mVictim        = 0;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	inline bool cuckoo_filter<T, F, H, A>::DoBucketInsert(uint32_t nBucket, F fp)
+	{
+		F* const p = mpSlots + (nBucket * kBucketSlotCount);
+
+		for(uint32_t i = 0; i < kBucketSlotCount; ++i)
+		{
+			if(p[i] == 0)
+			{
+				p[i] = fp;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	inline bool cuckoo_filter<T, F, H, A>::DoBucketErase(uint32_t nBucket, F fp)
+	{
+		F* const p = mpSlots + (nBucket * kBucketSlotCount);
+
+		for(uint32_t i = 0; i < kBucketSlotCount; ++i)
+		{
+			if(p[i] == fp)
+			{
+				p[i] = 0;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	bool cuckoo_filter<T, F, H, A>::DoInsert(uint32_t nBucket, F fp)
+	{
+		if(mnVictimBucket != kNoVictim) // If the previous insert failed, we're full.
+			return false;
+
+		if(DoBucketInsert(nBucket, fp))
+			return true;
+
+		nBucket = DoAltBucket(nBucket, fp);
+		if(DoBucketInsert(nBucket, fp))
+			return true;
+
+		// Both buckets are full, so evict a random fingerprint to its other bucket, and so on.
+		for(uint32_t n = 0; n < kMaxKickCount; ++n)
+		{
+			mnRandom ^= mnRandom << 13; // xorshift32
+			mnRandom ^= mnRandom >> 17;
+			mnRandom ^= mnRandom << 5;
+
+			eastl::swap(fp, mpSlots[(nBucket * kBucketSlotCount) + (mnRandom % kBucketSlotCount)]);
+
+			nBucket = DoAltBucket(nBucket, fp);
+			if(DoBucketInsert(nBucket, fp))
+				return true;
+		}
+
+		// Keep the fingerprint left in hand, which is not necessarily the one we
+		// were inserting. It still counts as inserted, but no more inserts will succeed.
+		mnVictimBucket = nBucket;
+		mVictim        = fp;
+		return true;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	bool cuckoo_filter<T, F, H, A>::insert_hash(uint64_t h)
+	{
+		EASTL_ASSERT(mnBucketCount != 0);
+
+		uint32_t nBucket;
+		F        fp;
+		DoSplit(h, nBucket, fp);
+
+		if(DoInsert(nBucket, fp))
+		{
+			++mnSize;
+			return true;
+		}
+
+		return false;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	inline bool cuckoo_filter<T, F, H, A>::contains_hash(uint64_t h) const
+	{
+		if(mnBucketCount == 0)
+			return false;
+
+		uint32_t nBucket;
+		F        fp;
+		DoSplit(h, nBucket, fp);
+
+		const uint32_t nAltBucket = DoAltBucket(nBucket, fp);
+
+		return DoBucketContains(nBucket, fp) || DoBucketContains(nAltBucket, fp) ||
+			   ((mVictim == fp) && ((mnVictimBucket == nBucket) || (mnVictimBucket == nAltBucket)));
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	bool cuckoo_filter<T, F, H, A>::erase_hash(uint64_t h)
+	{
+		if(mnBucketCount == 0)
+			return false;
+
+		uint32_t nBucket;
+		F        fp;
+		DoSplit(h, nBucket, fp);
+
+		const uint32_t nAltBucket = DoAltBucket(nBucket, fp);
+		bool bErased;
+
+		if((mnVictimBucket != kNoVictim) && (mVictim == fp) && ((mnVictimBucket == nBucket) || (mnVictimBucket == nAltBucket)))
+		{
+			mnVictimBucket = kNoVictim;
+			mVictim        = 0;
+			--mnSize;
+			return true;
+		}
+
+		bErased = DoBucketErase(nBucket, fp) || DoBucketErase(nAltBucket, fp);
+
+		if(bErased)
+		{
+			--mnSize;
+
+			if(mnVictimBucket != kNoVictim) // Now that there is room, try to place the victim again.
+			{
+				const uint32_t nVictimBucket = mnVictimBucket;
+				mnVictimBucket = kNoVictim;
+				DoInsert(nVictimBucket, mVictim);
+			}
+		}
+
+		return bErased;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	bool cuckoo_filter<T, F, H, A>::merge(const this_type& x)
+	{
+		if(x.mnBucketCount != mnBucketCount)
+			return false;
+
+		for(uint32_t b = 0; b < mnBucketCount; ++b)
+		{
+			for(uint32_t i = 0; i < kBucketSlotCount; ++i)
+			{
+				const F fp = x.mpSlots[(b * kBucketSlotCount) + i];
+
+				if(fp)
+				{
+					if(!DoInsert(b, fp))
+						return false;
+					++mnSize;
+				}
+			}
+		}
+
+		if(x.mnVictimBucket != kNoVictim)
+		{
+			if(!DoInsert(x.mnVictimBucket, x.mVictim))
+				return false;
+			++mnSize;
+		}
+
+		return true;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	double cuckoo_filter<T, F, H, A>::false_positive_rate() const
+	{
+		// A lookup compares against up to 2 * kBucketSlotCount occupied slots, each
+		// of which matches with probability 1 / (2^bits - 1).
+		const double fMatch = 1.0 / (double)((uint64_t(1) << (sizeof(F) * 8)) - 1);
+		return fMatch * (2 * kBucketSlotCount) * load_factor();
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	typename cuckoo_filter<T, F, H, A>::size_type
+	cuckoo_filter<T, F, H, A>::serialize(void* pBuffer, size_type nBufferSize) const
+	{
+		if(nBufferSize < serialized_size())
+			return 0;
+
+		Internal::filter_header header;
+		header.mnMagic      = kSerializeMagic;
+		header.mnVersion    = 1;
+		header.mnParameter  = (uint16_t)(sizeof(F) * 8);
+		header.mnBlockCount = mnBucketCount;
+		header.mnReserved   = 0;
+		header.mnItemCount  = (uint64_t)mnSize;
+
+		const uint32_t victim[2] = { mnVictimBucket, (uint32_t)mVictim };
+
+		char* p = (char*)pBuffer;
+		memcpy(p, &header, sizeof(header));
+		p += sizeof(header);
+		if(mnBucketCount)
+			memcpy(p, mpSlots, size_in_bytes());
+		memcpy(p + size_in_bytes(), victim, sizeof(victim));
+
+		return serialized_size();
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	bool cuckoo_filter<T, F, H, A>::deserialize(const void* pBuffer, size_type nBufferSize)
+	{
+		Internal::filter_header header;
+
+		if(!Internal::filter_read_header(pBuffer, nBufferSize, kSerializeMagic, header) || (header.mnParameter != (sizeof(F) * 8)) ||
+		   (header.mnBlockCount & (header.mnBlockCount - 1)) ||
+		   ((nBufferSize - sizeof(header)) < (((size_type)header.mnBlockCount * kBucketSlotCount * sizeof(F)) + (2 * sizeof(uint32_t)))))
+		{
+			return false;
+		}
+
+		if(header.mnBlockCount != mnBucketCount)
+		{
+			DoFree();
+			DoAllocate(header.mnBlockCount);
+		}
+
+		uint32_t victim[2];
+		const char* p = (const char*)pBuffer + sizeof(header);
+		if(mnBucketCount)
+			memcpy(mpSlots, p, size_in_bytes());
+		memcpy(victim, p + size_in_bytes(), sizeof(victim));
+
+		mnSize         = (size_type)header.mnItemCount;
+		mnVictimBucket = victim[0];
+		mVictim        = (F)victim[1];
+
+		return true;
+	}
+
+
+	template <typename T, typename F, typename H, typename A>
+	bool cuckoo_filter<T, F, H, A>::validate() const
+	{
+		if((mpSlots == NULL) != (mnBucketCount == 0))
+			return false;
+
+		if((mnVictimBucket != kNoVictim) && ((mnVictimBucket >= mnBucketCount) || (mVictim == 0)))
+			return false;
+
+		size_type nCount = (mnVictimBucket != kNoVictim) ? 1 : 0;
+
+		for(size_type i = 0, iEnd = capacity(); i < iEnd; ++i)
+		{
+			if(mpSlots[i])
+				++nCount;
+		}
+
+		return (nCount == mnSize);
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename F, typename H, typename A>
+	inline void swap(cuckoo_filter<T, F, H, A>& a, cuckoo_filter<T, F, H, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
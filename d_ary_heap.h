@@ -0,0 +1,1461 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements heaps whose nodes have D children rather than two.
+// A binary heap pop does about log2(n) dependent loads, and once the heap
+// no longer fits in cache each of them is a miss. A 4-ary heap halves the
+// depth and an 8-ary heap thirds it, in exchange for comparing D children
+// per level instead of two. The children of a node are adjacent, so if
+// they share a cache line the extra comparisons are nearly free.
+//
+// The publicly usable functions we define are the d-ary versions of those
+// in heap.h, with the arity as the first template argument:
+//    pushDaryHeap<D>, popDaryHeap<D>, makeDaryHeap<D>, sortDaryHeap<D>,
+//    removeDaryHeap<D>, changeDaryHeap<D>, isDaryHeap_until<D>, isDaryHeap<D>
+// The children of the element at position i are at D*i+1 through D*i+D.
+// pushDaryHeap<2> and the others build valid binary heaps, which heap.h's
+// functions accept, but where keys are equal they may order them differently
+// than pushHeap et al. would, as ties between children are broken differently.
+//
+// The containers we define are:
+//    d_ary_heap   -- A priority_queue-like container using the functions above.
+//    indexed_heap -- A d-ary heap whose entries are addressed by handles, so
+//                    that an entry's priority can be changed (decrease_key)
+//                    or the entry erased in O(log n).
+//
+// Both containers allocate their storage aligned to the size of a group of
+// D children and leave D - 1 unused slots before the root, which puts the
+// first child of every node on a group boundary. If D * sizeof(value_type)
+// is the cache line size (e.g. D = 8 with 8 byte entries) then every level
+// of a push or pop touches exactly one cache line.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_D_ARY_HEAP_H
+#define EASTL_D_ARY_HEAP_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/functional.h>
+#include <eastl/heap.h>
+#include <eastl/initializer_list.h>
+#include <eastl/iterator.h>
+#include <eastl/memory.h>
+#include <eastl/type_traits.h>
+#include <eastl/vector.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#if defined(_MSC_VER) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+	#pragma warning(push, 0)
+	#include <xmmintrin.h>
+	#pragma warning(pop)
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_D_ARY_HEAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_D_ARY_HEAP_DEFAULT_NAME
+		#define EASTL_D_ARY_HEAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " d_ary_heap" // Unless the user overrides something, this is "EASTL d_ary_heap".
+	#endif
+
+	#ifndef EASTL_INDEXED_HEAP_DEFAULT_NAME
+		#define EASTL_INDEXED_HEAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " indexed_heap" // Unless the user overrides something, this is "EASTL indexed_heap".
+	#endif
+
+
+	/// EASTL_D_ARY_HEAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_D_ARY_HEAP_DEFAULT_ALLOCATOR
+		#define EASTL_D_ARY_HEAP_DEFAULT_ALLOCATOR allocator_type(EASTL_D_ARY_HEAP_DEFAULT_NAME)
+	#endif
+
+	#ifndef EASTL_INDEXED_HEAP_DEFAULT_ALLOCATOR
+		#define EASTL_INDEXED_HEAP_DEFAULT_ALLOCATOR allocator_type(EASTL_INDEXED_HEAP_DEFAULT_NAME)
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// DaryBestChild
+		///
+		/// Returns the position of the highest priority of the nChildCount
+		/// children starting at childPosition. Used for the last, partial,
+		/// group of children; full groups use dary_best_of.
+		///
+		template <typename RandomAccessIterator, typename Distance, typename Compare>
+		inline Distance DaryBestChild(RandomAccessIterator first, Distance childPosition, Distance nChildCount, Compare& compare)
+		{
+			Distance bestPosition = childPosition;
+
+			for(Distance i = 1; i < nChildCount; ++i)
+			{
+				if(compare(*(first + bestPosition), *(first + (childPosition + i))))
+					bestPosition = childPosition + i;
+			}
+
+			return bestPosition;
+		}
+
+
+		/// dary_best_of
+		///
+		/// Returns the position of the highest priority of the N items starting
+		/// at position, as a tournament of pairs. Unlike a linear scan, each
+		/// round's comparisons are independent, and each selection is a
+		/// conditional move rather than a branch, which for random keys would
+		/// be mispredicted about half the time.
+		///
+		template <size_t N>
+		struct dary_best_of
+		{
+			template <typename RandomAccessIterator, typename Distance, typename Compare>
+			static Distance get(RandomAccessIterator first, Distance position, Compare& compare)
+			{
+				const Distance a = dary_best_of<N / 2>::get(first, position, compare);
+				const Distance b = dary_best_of<N - (N / 2)>::get(first, position + (Distance)(N / 2), compare);
+
+				return a + ((b - a) & -(Distance)compare(*(first + a), *(first + b))); // Same as compare(...) ? b : a, which compilers tend to turn into a branch.
+			}
+		};
+
+		template <>
+		struct dary_best_of<1>
+		{
+			template <typename RandomAccessIterator, typename Distance, typename Compare>
+			static Distance get(RandomAccessIterator, Distance position, Compare&)
+				{ return position; }
+		};
+
+
+		/// DaryPrefetch
+		///
+		EASTL_FORCE_INLINE void DaryPrefetch(const char* p)
+		{
+			#if defined(__GNUC__) || defined(__clang__)
+				__builtin_prefetch(p);
+			#elif defined(_MSC_VER) && (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
+				_mm_prefetch(p, _MM_HINT_T0);
+			#else
+				(void)p;
+			#endif
+		}
+
+		template <size_t nLineCount>
+		struct dary_prefetch_lines
+		{
+			static EASTL_FORCE_INLINE void prefetch(const char* p)
+				{ DaryPrefetch(p); dary_prefetch_lines<nLineCount - 1>::prefetch(p + 64); }
+		};
+
+		template <>
+		struct dary_prefetch_lines<0>
+		{
+			static EASTL_FORCE_INLINE void prefetch(const char*) { }
+		};
+
+
+		/// DaryPrefetchGrandchildren
+		///
+		/// Prefetches the children of the D children starting at childPosition,
+		/// one of whose groups the next level of a sift down will read. Choosing
+		/// among children with conditional moves rather than branches means the
+		/// CPU doesn't speculatively load the next level, so without this each
+		/// level of a heap larger than the cache would be a full memory latency.
+		/// The D*D grandchildren are contiguous; at most 512 bytes are prefetched.
+		/// These are force inlined because GCC considers a function which only
+		/// prefetches to be const, and so removes calls to it as having no effect.
+		///
+		template <size_t D, typename RandomAccessIterator, typename Distance>
+		EASTL_FORCE_INLINE void DaryPrefetchGrandchildren(RandomAccessIterator first, Distance childPosition, Distance heapSize)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			const size_t   kBytes = ((D * D * sizeof(value_type)) < 512) ? (D * D * sizeof(value_type)) : 512;
+			const Distance grandchildPosition = ((Distance)D * childPosition) + 1;
+
+			if(grandchildPosition < heapSize)
+			{
+				const char* const p = (const char*)&*(first + grandchildPosition);
+
+				dary_prefetch_lines<(kBytes + 63) / 64>::prefetch(p);
+				DaryPrefetch(p + (kBytes - 1)); // The range may not start on a line boundary.
+			}
+		}
+
+
+		/// DaryPromoteHeap
+		///
+		/// Moves the vacant position up toward topPosition until value can
+		/// be placed in it. This is the d-ary version of promoteHeap.
+		///
+		template <size_t D, typename RandomAccessIterator, typename Distance, typename T, typename Compare>
+		inline void DaryPromoteHeap(RandomAccessIterator first, Distance topPosition, Distance position, T& value, Compare& compare)
+		{
+			while(position > topPosition)
+			{
+				const Distance parentPosition = (position - 1) / (Distance)D;
+
+				if(!compare(*(first + parentPosition), value))
+					break;
+
+				*(first + position) = EASTL_MOVE(*(first + parentPosition));
+				position = parentPosition;
+			}
+
+			*(first + position) = EASTL_MOVE(value);
+		}
+
+
+		/// DaryAdjustHeap
+		///
+		/// Fills the vacant position with value, moving it down the heap as
+		/// needed. This is the d-ary version of adjustHeap: it moves the vacancy
+		/// all the way to the bottom along the highest priority children and
+		/// then promotes value from there. As value usually comes from the
+		/// bottom of the heap, this saves a comparison per level.
+		///
+		template <size_t D, typename RandomAccessIterator, typename Distance, typename T, typename Compare>
+		void DaryAdjustHeap(RandomAccessIterator first, Distance topPosition, Distance heapSize, Distance position, T& value, Compare& compare)
+		{
+			Distance childPosition = ((Distance)D * position) + 1;
+
+			for(; (childPosition + (Distance)D) <= heapSize; childPosition = ((Distance)D * childPosition) + 1)
+			{
+				Internal::DaryPrefetchGrandchildren<D>(first, childPosition, heapSize);
+				childPosition = Internal::dary_best_of<D>::get(first, childPosition, compare);
+				*(first + position) = EASTL_MOVE(*(first + childPosition));
+				position = childPosition;
+			}
+
+			if(childPosition < heapSize) // If the bottom node has fewer than D children...
+			{
+				childPosition = Internal::DaryBestChild(first, childPosition, heapSize - childPosition, compare);
+				*(first + position) = EASTL_MOVE(*(first + childPosition));
+				position = childPosition;
+			}
+
+			Internal::DaryPromoteHeap<D>(first, topPosition, position, value, compare);
+		}
+
+	} // namespace Internal
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// pushDaryHeap
+	///////////////////////////////////////////////////////////////////////
+
+	/// pushDaryHeap
+	///
+	/// Adds the item at last - 1 to the d-ary heap [first, last - 1).
+	///
+	/// Example usage:
+	///    heap.pushBack(3);
+	///    pushDaryHeap<4>(heap.begin(), heap.end()); // Places '3' appropriately.
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline void pushDaryHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		EASTL_CT_ASSERT(D >= 2);
+
+		const difference_type position = (last - first) - 1;
+		value_type temp(EASTL_MOVE(*(first + position)));
+
+		Internal::DaryPromoteHeap<D>(first, (difference_type)0, position, temp, compare);
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline void pushDaryHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::pushDaryHeap<D, RandomAccessIterator, Less>(first, last, Less());
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// popDaryHeap
+	///////////////////////////////////////////////////////////////////////
+
+	/// popDaryHeap
+	///
+	/// Moves the top item of the d-ary heap [first, last) to last - 1 and
+	/// makes [first, last - 1) a heap of the rest.
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline void popDaryHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		EASTL_CT_ASSERT(D >= 2);
+
+		const difference_type heapSize = (last - first) - 1;
+
+		if(heapSize > 0)
+		{
+			value_type temp(EASTL_MOVE(*(first + heapSize)));
+			*(first + heapSize) = EASTL_MOVE(*first);
+			Internal::DaryAdjustHeap<D>(first, (difference_type)0, heapSize, (difference_type)0, temp, compare);
+		}
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline void popDaryHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::popDaryHeap<D, RandomAccessIterator, Less>(first, last, Less());
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// makeDaryHeap
+	///////////////////////////////////////////////////////////////////////
+
+	/// makeDaryHeap
+	///
+	/// Converts the range [first, last) into a d-ary heap in O(n).
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	void makeDaryHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		EASTL_CT_ASSERT(D >= 2);
+
+		const difference_type heapSize = last - first;
+
+		if(heapSize >= 2) // If there is anything to do... (we need this check because otherwise the math fails below).
+		{
+			difference_type parentPosition = ((heapSize - 2) / (difference_type)D) + 1;
+
+			do{
+				--parentPosition;
+				value_type temp(EASTL_MOVE(*(first + parentPosition)));
+				Internal::DaryAdjustHeap<D>(first, parentPosition, heapSize, parentPosition, temp, compare);
+			} while(parentPosition != 0);
+		}
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline void makeDaryHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::makeDaryHeap<D, RandomAccessIterator, Less>(first, last, Less());
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// sortDaryHeap
+	///////////////////////////////////////////////////////////////////////
+
+	/// sortDaryHeap
+	///
+	/// Sorts the d-ary heap [first, last) in place, lowest priority first.
+	///
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline void sortDaryHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		for(; (last - first) > 1; --last)
+			eastl::popDaryHeap<D, RandomAccessIterator, Compare>(first, last, compare);
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline void sortDaryHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::sortDaryHeap<D, RandomAccessIterator, Less>(first, last, Less());
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// removeDaryHeap
+	///////////////////////////////////////////////////////////////////////
+
+	/// removeDaryHeap
+	///
+	/// Moves the item at position to the back of the heap (heapSize - 1) and
+	/// makes the first heapSize - 1 items a heap. As with removeHeap, the
+	/// user must then erase the back item from the container.
+	///
+	template <size_t D, typename RandomAccessIterator, typename Distance, typename Compare>
+	inline void removeDaryHeap(RandomAccessIterator first, Distance heapSize, Distance position, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		const difference_type lastPosition = (difference_type)heapSize - 1;
+
+		if((difference_type)position != lastPosition)
+		{
+			value_type temp(EASTL_MOVE(*(first + lastPosition)));
+			*(first + lastPosition) = EASTL_MOVE(*(first + position));
+			Internal::DaryAdjustHeap<D>(first, (difference_type)0, lastPosition, (difference_type)position, temp, compare);
+		}
+	}
+
+	template <size_t D, typename RandomAccessIterator, typename Distance>
+	inline void removeDaryHeap(RandomAccessIterator first, Distance heapSize, Distance position)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::removeDaryHeap<D, RandomAccessIterator, Distance, Less>(first, heapSize, position, Less());
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// changeDaryHeap
+	///////////////////////////////////////////////////////////////////////
+
+	/// changeDaryHeap
+	///
+	/// Given an item in the heap whose priority has changed, either up or
+	/// down, moves it to its correct position.
+	///
+	template <size_t D, typename RandomAccessIterator, typename Distance, typename Compare>
+	inline void changeDaryHeap(RandomAccessIterator first, Distance heapSize, Distance position, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		value_type temp(EASTL_MOVE(*(first + position)));
+
+		if((position > 0) && compare(*(first + ((position - 1) / (Distance)D)), temp))
+			Internal::DaryPromoteHeap<D>(first, (difference_type)0, (difference_type)position, temp, compare);
+		else
+			Internal::DaryAdjustHeap<D>(first, (difference_type)position, (difference_type)heapSize, (difference_type)position, temp, compare);
+	}
+
+	template <size_t D, typename RandomAccessIterator, typename Distance>
+	inline void changeDaryHeap(RandomAccessIterator first, Distance heapSize, Distance position)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::changeDaryHeap<D, RandomAccessIterator, Distance, Less>(first, heapSize, position, Less());
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// isDaryHeap_until / isDaryHeap
+	///////////////////////////////////////////////////////////////////////
+
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline RandomAccessIterator isDaryHeap_until(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+		const difference_type heapSize = last - first;
+
+		for(difference_type childPosition = 1; childPosition < heapSize; ++childPosition)
+		{
+			if(compare(*(first + ((childPosition - 1) / (difference_type)D)), *(first + childPosition)))
+				return first + childPosition;
+		}
+
+		return last;
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline RandomAccessIterator isDaryHeap_until(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		return eastl::isDaryHeap_until<D, RandomAccessIterator, Less>(first, last, Less());
+	}
+
+
+	template <size_t D, typename RandomAccessIterator, typename Compare>
+	inline bool isDaryHeap(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		return (eastl::isDaryHeap_until<D>(first, last, compare) == last);
+	}
+
+	template <size_t D, typename RandomAccessIterator>
+	inline bool isDaryHeap(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		return (eastl::isDaryHeap_until<D>(first, last) == last);
+	}
+
+
+
+
+	/// dary_heap_base
+	///
+	/// The storage shared by d_ary_heap and indexed_heap: a growable array of
+	/// Node whose root is preceded by D - 1 unconstructed slots, allocated so
+	/// that each group of D children is aligned to its size (up to a cache line).
+	///
+	template <typename Node, size_t D, typename Allocator>
+	class dary_heap_base
+	{
+	public:
+		typedef eastl_size_t size_type;
+		typedef Allocator    allocator_type;
+
+		static const size_t kArity        = D;
+		static const size_t kPadding      = D - 1;
+		static const size_t kGroupSize    = D * sizeof(Node);
+		static const size_t kGroupAlign   = kGroupSize & (0 - kGroupSize); // The largest power of two that divides kGroupSize.
+		static const size_t kCacheAlign   = (kGroupAlign < EA_CACHE_LINE_SIZE) ? kGroupAlign : EA_CACHE_LINE_SIZE;
+		static const size_t kAlignment    = (kCacheAlign > EASTL_ALIGN_OF(Node)) ? kCacheAlign : EASTL_ALIGN_OF(Node);
+
+	public:
+		dary_heap_base(const allocator_type& allocator)
+			: mpBegin(NULL), mnSize(0), mnCapacity(0), mAllocator(allocator) { EASTL_CT_ASSERT(D >= 2); }
+
+	   ~dary_heap_base()
+			{ DoFree(); }
+
+		bool      empty() const EASTL_NOEXCEPT    { return (mnSize == 0); }
+		size_type size() const EASTL_NOEXCEPT     { return mnSize; }
+		size_type capacity() const EASTL_NOEXCEPT { return mnCapacity; }
+
+		void reserve(size_type n)
+		{
+			if(n > mnCapacity)
+				DoReallocate(n);
+		}
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+	protected:
+		Node*          mpBegin;     // The root. Preceded by kPadding unused slots within the allocation.
+		size_type      mnSize;
+		size_type      mnCapacity;
+		allocator_type mAllocator;
+
+		void DoGrow(size_type nMinCapacity)
+		{
+			size_type nNewCapacity = (mnCapacity < 8) ? 8 : (mnCapacity * 2);
+			if(nNewCapacity < nMinCapacity)
+				nNewCapacity = nMinCapacity;
+			DoReallocate(nNewCapacity);
+		}
+
+		void DoReallocate(size_type nNewCapacity)
+		{
+			Node* const pBuffer = (Node*)allocate_memory(mAllocator, (nNewCapacity + kPadding) * sizeof(Node), kAlignment, 0);
+			EASTL_ASSERT(pBuffer != NULL);
+			Node* const pNewBegin = pBuffer + kPadding;
+
+			for(size_type i = 0; i < mnSize; ++i)
+			{
+				::new((void*)(pNewBegin + i)) Node(EASTL_MOVE(mpBegin[i]));
+				mpBegin[i].~Node();
+			}
+
+			if(mpBegin)
+				EASTLFree(mAllocator, mpBegin - kPadding, (mnCapacity + kPadding) * sizeof(Node));
+
+			mpBegin    = pNewBegin;
+			mnCapacity = nNewCapacity;
+		}
+
+		void DoDestroyAll()
+		{
+			for(size_type i = 0; i < mnSize; ++i)
+				mpBegin[i].~Node();
+			mnSize = 0;
+		}
+
+		void DoFree()
+		{
+			DoDestroyAll();
+			if(mpBegin)
+				EASTLFree(mAllocator, mpBegin - kPadding, (mnCapacity + kPadding) * sizeof(Node));
+			mpBegin    = NULL;
+			mnCapacity = 0;
+		}
+
+		void DoSwap(dary_heap_base& x)
+		{
+			eastl::swap(mpBegin,    x.mpBegin);
+			eastl::swap(mnSize,     x.mnSize);
+			eastl::swap(mnCapacity, x.mnCapacity);
+			eastl::swap(mAllocator, x.mAllocator);
+		}
+
+	private:
+		dary_heap_base(const dary_heap_base&);
+		dary_heap_base& operator=(const dary_heap_base&);
+	};
+
+
+
+
+	/// d_ary_heap
+	///
+	/// A priority queue like priority_queue, whose top() is the item of
+	/// highest priority, implemented as a d-ary heap. D is usually 4 or 8;
+	/// larger values reduce the depth of the heap but add comparisons.
+	///
+	/// Unlike priority_queue, d_ary_heap isn't an adapter over a sequence
+	/// container, as it needs to control the alignment of its storage.
+	///
+	/// push_range adds many items at once, rebuilding the heap instead of
+	/// pushing the items one by one when that is cheaper. pop_n removes
+	/// the n items of highest priority at once, writing them in priority
+	/// order to an output iterator. Neither allocates unless the heap grows.
+	///
+	/// Example usage:
+	///     d_ary_heap<uint64_t, 8, eastl::greater<uint64_t> > deadlines; // The earliest deadline is on top.
+	///
+	///     deadlines.push_range(newDeadlines.begin(), newDeadlines.end());
+	///     while(!deadlines.empty() && (deadlines.top() <= now))
+	///         deadlines.pop();
+	///
+	template <typename T, size_t D = 4, typename Compare = eastl::less<T>, typename Allocator = EASTLAllocatorType>
+	class d_ary_heap : public dary_heap_base<T, D, Allocator>
+	{
+	public:
+		typedef d_ary_heap<T, D, Compare, Allocator> this_type;
+		typedef dary_heap_base<T, D, Allocator>      base_type;
+		typedef T                                    value_type;
+		typedef const T&                             const_reference;
+		typedef const T*                             const_iterator;
+		typedef Compare                              compare_type;
+		typedef typename base_type::size_type        size_type;
+		typedef typename base_type::allocator_type   allocator_type;
+		typedef ptrdiff_t                            difference_type;
+
+		using base_type::mpBegin;
+		using base_type::mnSize;
+		using base_type::mnCapacity;
+
+	public:
+		d_ary_heap(const allocator_type& allocator = EASTL_D_ARY_HEAP_DEFAULT_ALLOCATOR);
+		explicit d_ary_heap(const compare_type& compare, const allocator_type& allocator = EASTL_D_ARY_HEAP_DEFAULT_ALLOCATOR);
+		d_ary_heap(std::initializer_list<value_type> ilist, const compare_type& compare = compare_type(), const allocator_type& allocator = EASTL_D_ARY_HEAP_DEFAULT_ALLOCATOR);
+		d_ary_heap(const this_type& x);
+
+		template <typename InputIterator>
+		d_ary_heap(InputIterator first, InputIterator last, const compare_type& compare = compare_type(), const allocator_type& allocator = EASTL_D_ARY_HEAP_DEFAULT_ALLOCATOR);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			d_ary_heap(this_type&& x);
+		#endif
+
+		this_type& operator=(const this_type& x);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			this_type& operator=(this_type&& x);
+		#endif
+
+		void swap(this_type& x);
+
+		const_reference top() const
+			{ EASTL_ASSERT(mnSize != 0); return *mpBegin; }
+
+		void push(const value_type& value);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			void push(value_type&& value);
+		#endif
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED && EASTL_VARIADIC_TEMPLATES_ENABLED
+			template <class... Args>
+			void emplace(Args&&... args);
+		#endif
+
+		/// push_range
+		/// Adds all of [first, last), either by pushing each item or by
+		/// appending them all and rebuilding the heap, whichever is cheaper.
+		template <typename InputIterator>
+		void push_range(InputIterator first, InputIterator last);
+
+		void pop();
+		void pop(value_type& value); // Allows popping a move-only type (e.g. unique_ptr).
+
+		/// pop_n
+		/// Pops the min(n, size()) items of highest priority, writing them to
+		/// result in priority order. Returns the end of the written range.
+		template <typename OutputIterator>
+		OutputIterator pop_n(size_type n, OutputIterator result);
+
+		void change(size_type n);   /// Moves the item at the given array index to a new location based on its current priority.
+		void remove(size_type n);   /// Removes the item at the given array index.
+
+		void clear()
+			{ base_type::DoDestroyAll(); }
+
+		/// begin / end
+		/// The heap array, root first. Its order is unspecified beyond being a heap.
+		const_iterator begin() const EASTL_NOEXCEPT { return mpBegin; }
+		const_iterator end() const EASTL_NOEXCEPT   { return mpBegin + mnSize; }
+
+		const compare_type& comp() const EASTL_NOEXCEPT { return mCompare; }
+
+		bool validate() const;
+
+	protected:
+		compare_type mCompare;
+
+		void DoAppend(const value_type& value)
+		{
+			if(mnSize == mnCapacity)
+				base_type::DoGrow(mnSize + 1);
+			::new((void*)(mpBegin + mnSize)) value_type(value);
+			++mnSize;
+		}
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			void DoAppend(value_type&& value)
+			{
+				if(mnSize == mnCapacity)
+					base_type::DoGrow(mnSize + 1);
+				::new((void*)(mpBegin + mnSize)) value_type(eastl::move(value));
+				++mnSize;
+			}
+		#endif
+
+		template <typename InputIterator>
+		void DoAppendRange(InputIterator first, InputIterator last, EASTL_ITC_NS::input_iterator_tag)
+		{
+			for(; first != last; ++first)
+				DoAppend(*first);
+		}
+
+		template <typename ForwardIterator>
+		void DoAppendRange(ForwardIterator first, ForwardIterator last, EASTL_ITC_NS::forward_iterator_tag)
+		{
+			const size_type n = (size_type)eastl::distance(first, last);
+			if((mnSize + n) > mnCapacity)
+				base_type::DoGrow(mnSize + n);
+			for(; first != last; ++first, ++mnSize)
+				::new((void*)(mpBegin + mnSize)) value_type(*first);
+		}
+
+		void DoPopBack()
+		{
+			--mnSize;
+			mpBegin[mnSize].~value_type();
+		}
+	}; // class d_ary_heap
+
+
+
+
+	/// indexed_heap
+	///
+	/// A d-ary heap whose entries are addressed by handles, for algorithms
+	/// such as Dijkstra's and A* which change the priority of entries already
+	/// in the queue, or timer queues which cancel entries.
+	///
+	/// push returns a handle_type which refers to the pushed entry until it
+	/// is popped or erased, after which the handle may be reused by a later
+	/// push. Handles are small integers, so the caller can store them in an
+	/// array indexed by its own node ids.
+	///
+	/// decrease_key gives an entry a higher or equal priority. It is named for
+	/// the usual case of a min-heap (Compare = greater), where a higher priority
+	/// is a smaller key. change gives an entry an arbitrary new priority.
+	/// Both are O(log n) and neither allocates.
+	///
+	/// Each heap slot stores the value with its handle, and a separate array
+	/// maps each handle to its heap slot, so comparisons never indirect.
+	///
+	/// Example usage:
+	///     indexed_heap<float, 4, eastl::greater<float> > frontier;
+	///     eastl::vector<indexed_heap<float>::handle_type> nodeHandles(nodeCount, frontier.kInvalidHandle);
+	///
+	///     nodeHandles[start] = frontier.push(0.f);
+	///     ...
+	///     if(newDistance < distance[v])
+	///         frontier.decrease_key(nodeHandles[v], newDistance);
+	///
+	template <typename T, size_t D = 4, typename Compare = eastl::less<T>, typename Allocator = EASTLAllocatorType>
+	class indexed_heap
+	{
+	public:
+		typedef indexed_heap<T, D, Compare, Allocator> this_type;
+		typedef T                                      value_type;
+		typedef const T&                               const_reference;
+		typedef Compare                                compare_type;
+		typedef eastl_size_t                           size_type;
+		typedef Allocator                              allocator_type;
+		typedef uint32_t                               handle_type;
+
+		static const handle_type kInvalidHandle = 0xffffffff;
+
+	protected:
+		struct node_type
+		{
+			value_type  mValue;
+			handle_type mnHandle;
+
+			node_type(const value_type& value, handle_type nHandle) : mValue(value), mnHandle(nHandle) { }
+
+			#if EASTL_MOVE_SEMANTICS_ENABLED
+				node_type(value_type&& value, handle_type nHandle) : mValue(eastl::move(value)), mnHandle(nHandle) { }
+			#endif
+		};
+
+		struct node_compare
+		{
+			compare_type mCompare;
+
+			node_compare(const compare_type& compare) : mCompare(compare) { }
+
+			bool operator()(const node_type& a, const node_type& b)
+				{ return mCompare(a.mValue, b.mValue); }
+		};
+
+		class heap_storage : public dary_heap_base<node_type, D, Allocator>
+		{
+		public:
+			typedef dary_heap_base<node_type, D, Allocator> base_type;
+
+			heap_storage(const allocator_type& allocator) : base_type(allocator) { }
+
+			using base_type::mpBegin;
+			using base_type::mnSize;
+			using base_type::mnCapacity;
+			using base_type::DoGrow;
+			using base_type::DoDestroyAll;
+			using base_type::DoSwap;
+		};
+
+		typedef eastl::vector<handle_type, Allocator> position_array;
+
+		static const handle_type kFreeFlag = 0x80000000; // Set in mPositions entries of free handles, whose other bits link the free list.
+
+	public:
+		indexed_heap(const allocator_type& allocator = EASTL_INDEXED_HEAP_DEFAULT_ALLOCATOR);
+		explicit indexed_heap(const compare_type& compare, const allocator_type& allocator = EASTL_INDEXED_HEAP_DEFAULT_ALLOCATOR);
+	   ~indexed_heap() { }
+
+		void swap(this_type& x);
+
+		bool      empty() const EASTL_NOEXCEPT    { return (mHeap.mnSize == 0); }
+		size_type size() const EASTL_NOEXCEPT     { return mHeap.mnSize; }
+		size_type capacity() const EASTL_NOEXCEPT { return mHeap.mnCapacity; }
+
+		void reserve(size_type n);
+		void clear();
+
+		const_reference top() const
+			{ EASTL_ASSERT(mHeap.mnSize != 0); return mHeap.mpBegin->mValue; }
+
+		handle_type top_handle() const
+			{ EASTL_ASSERT(mHeap.mnSize != 0); return mHeap.mpBegin->mnHandle; }
+
+		handle_type push(const value_type& value);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			handle_type push(value_type&& value);
+		#endif
+
+		void pop();
+		void pop(value_type& value);
+
+		/// pop_n
+		/// Pops the min(n, size()) items of highest priority, writing them to
+		/// result in priority order. Returns the end of the written range.
+		template <typename OutputIterator>
+		OutputIterator pop_n(size_type n, OutputIterator result);
+
+		/// contains
+		/// Returns true if h refers to an entry currently in the heap.
+		bool contains(handle_type h) const
+			{ return (h < (handle_type)mPositions.size()) && !(mPositions[h] & kFreeFlag); }
+
+		/// get
+		/// Returns the value of the entry referred to by h.
+		const_reference get(handle_type h) const
+			{ EASTL_ASSERT(contains(h)); return mHeap.mpBegin[mPositions[h]].mValue; }
+
+		/// decrease_key
+		/// Sets the value of h's entry to value, which must have priority
+		/// no lower than the current value (i.e. !compare(value, get(h))).
+		void decrease_key(handle_type h, const value_type& value);
+
+		/// change
+		/// Sets the value of h's entry to value, of any priority.
+		void change(handle_type h, const value_type& value);
+
+		/// erase
+		/// Removes h's entry from the heap. h is then free for reuse.
+		void erase(handle_type h);
+
+		const compare_type& comp() const EASTL_NOEXCEPT { return mCompare.mCompare; }
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mHeap.getAllocator(); }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mHeap.getAllocator(); }
+
+		bool validate() const;
+
+	protected:
+		heap_storage   mHeap;
+		position_array mPositions;      // Maps each handle to its position in mHeap, or to kFreeFlag | the next free handle.
+		handle_type    mnFreeHandle;    // The first of the free list of handles, or kInvalidHandle.
+		node_compare   mCompare;
+
+		handle_type DoAllocateHandle();
+		void        DoFreeHandle(handle_type h);
+		void        DoPromote(size_type position, node_type& node);
+		void        DoAdjust(size_type position, node_type& node);
+		void        DoRemoveTop();
+
+	private:
+		indexed_heap(const this_type&);
+		this_type& operator=(const this_type&);
+	}; // class indexed_heap
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// d_ary_heap
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, size_t D, typename C, typename A>
+	inline d_ary_heap<T, D, C, A>::d_ary_heap(const allocator_type& allocator)
+		: base_type(allocator), mCompare()
+	{
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline d_ary_heap<T, D, C, A>::d_ary_heap(const compare_type& compare, const allocator_type& allocator)
+		: base_type(allocator), mCompare(compare)
+	{
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline d_ary_heap<T, D, C, A>::d_ary_heap(std::initializer_list<value_type> ilist, const compare_type& compare, const allocator_type& allocator)
+		: base_type(allocator), mCompare(compare)
+	{
+		DoAppendRange(ilist.begin(), ilist.end(), EASTL_ITC_NS::forward_iterator_tag());
+		eastl::makeDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	template <typename InputIterator>
+	inline d_ary_heap<T, D, C, A>::d_ary_heap(InputIterator first, InputIterator last, const compare_type& compare, const allocator_type& allocator)
+		: base_type(allocator), mCompare(compare)
+	{
+		DoAppendRange(first, last, typename eastl::iterator_traits<InputIterator>::iterator_category());
+		eastl::makeDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline d_ary_heap<T, D, C, A>::d_ary_heap(const this_type& x)
+		: base_type(x.mAllocator), mCompare(x.mCompare)
+	{
+		DoAppendRange(x.begin(), x.end(), EASTL_ITC_NS::forward_iterator_tag()); // x is already a heap.
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename T, size_t D, typename C, typename A>
+		inline d_ary_heap<T, D, C, A>::d_ary_heap(this_type&& x)
+			: base_type(x.mAllocator), mCompare(x.mCompare)
+		{
+			swap(x);
+		}
+	#endif
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline typename d_ary_heap<T, D, C, A>::this_type&
+	d_ary_heap<T, D, C, A>::operator=(const this_type& x)
+	{
+		if(&x != this)
+		{
+			base_type::DoDestroyAll();
+			mCompare = x.mCompare;
+			DoAppendRange(x.begin(), x.end(), EASTL_ITC_NS::forward_iterator_tag());
+		}
+		return *this;
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename T, size_t D, typename C, typename A>
+		inline typename d_ary_heap<T, D, C, A>::this_type&
+		d_ary_heap<T, D, C, A>::operator=(this_type&& x)
+		{
+			if(&x != this)
+				swap(x);
+			return *this;
+		}
+	#endif
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void d_ary_heap<T, D, C, A>::swap(this_type& x)
+	{
+		base_type::DoSwap(x);
+		eastl::swap(mCompare, x.mCompare);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void d_ary_heap<T, D, C, A>::push(const value_type& value)
+	{
+		DoAppend(value);
+		eastl::pushDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename T, size_t D, typename C, typename A>
+		inline void d_ary_heap<T, D, C, A>::push(value_type&& value)
+		{
+			DoAppend(eastl::move(value));
+			eastl::pushDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+		}
+	#endif
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED && EASTL_VARIADIC_TEMPLATES_ENABLED
+		template <typename T, size_t D, typename C, typename A>
+		template <class... Args>
+		inline void d_ary_heap<T, D, C, A>::emplace(Args&&... args)
+		{
+			if(mnSize == mnCapacity)
+				base_type::DoGrow(mnSize + 1);
+			::new((void*)(mpBegin + mnSize)) value_type(eastl::forward<Args>(args)...);
+			++mnSize;
+			eastl::pushDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+		}
+	#endif
+
+
+	template <typename T, size_t D, typename C, typename A>
+	template <typename InputIterator>
+	void d_ary_heap<T, D, C, A>::push_range(InputIterator first, InputIterator last)
+	{
+		const size_type nOldSize = mnSize;
+
+		DoAppendRange(first, last, typename eastl::iterator_traits<InputIterator>::iterator_category());
+
+		if(Internal::HeapRebuildIsCheaper(nOldSize, mnSize - nOldSize))
+			eastl::makeDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+		else
+		{
+			for(size_type i = nOldSize; i < mnSize; ++i)
+				eastl::pushDaryHeap<D>(mpBegin, mpBegin + (i + 1), mCompare);
+		}
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void d_ary_heap<T, D, C, A>::pop()
+	{
+		EASTL_ASSERT(mnSize != 0);
+		eastl::popDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+		DoPopBack();
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void d_ary_heap<T, D, C, A>::pop(value_type& value)
+	{
+		EASTL_ASSERT(mnSize != 0);
+		eastl::popDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+		value = EASTL_MOVE(mpBegin[mnSize - 1]);
+		DoPopBack();
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	template <typename OutputIterator>
+	OutputIterator d_ary_heap<T, D, C, A>::pop_n(size_type n, OutputIterator result)
+	{
+		if(n > mnSize)
+			n = mnSize;
+
+		// Each pop moves the top to the back of the shrinking heap, so the popped
+		// items collect at the back of the array in reverse priority order.
+		const size_type nNewSize = mnSize - n;
+
+		for(size_type i = mnSize; i > nNewSize; --i)
+			eastl::popDaryHeap<D>(mpBegin, mpBegin + i, mCompare);
+
+		while(mnSize > nNewSize)
+		{
+			*result = EASTL_MOVE(mpBegin[mnSize - 1]);
+			++result;
+			DoPopBack();
+		}
+
+		return result;
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void d_ary_heap<T, D, C, A>::change(size_type n)
+	{
+		EASTL_ASSERT(n < mnSize);
+		eastl::changeDaryHeap<D>(mpBegin, (difference_type)mnSize, (difference_type)n, mCompare);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void d_ary_heap<T, D, C, A>::remove(size_type n)
+	{
+		EASTL_ASSERT(n < mnSize);
+		eastl::removeDaryHeap<D>(mpBegin, (difference_type)mnSize, (difference_type)n, mCompare);
+		DoPopBack();
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline bool d_ary_heap<T, D, C, A>::validate() const
+	{
+		if(mnSize > mnCapacity)
+			return false;
+		if(mpBegin && ((((uintptr_t)(mpBegin - base_type::kPadding)) & (base_type::kAlignment - 1)) != 0))
+			return false;
+		return eastl::isDaryHeap<D>(mpBegin, mpBegin + mnSize, mCompare);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void swap(d_ary_heap<T, D, C, A>& a, d_ary_heap<T, D, C, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// indexed_heap
+	///////////////////////////////////////////////////////////////////////
+
+	// The definition is needed when kInvalidHandle is bound to a reference, as when passed to vector's constructor.
+	template <typename T, size_t D, typename C, typename A>
+	const typename indexed_heap<T, D, C, A>::handle_type indexed_heap<T, D, C, A>::kInvalidHandle;
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline indexed_heap<T, D, C, A>::indexed_heap(const allocator_type& allocator)
+		: mHeap(allocator), mPositions(allocator), mnFreeHandle(kInvalidHandle), mCompare(compare_type())
+	{
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline indexed_heap<T, D, C, A>::indexed_heap(const compare_type& compare, const allocator_type& allocator)
+		: mHeap(allocator), mPositions(allocator), mnFreeHandle(kInvalidHandle), mCompare(compare)
+	{
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void indexed_heap<T, D, C, A>::swap(this_type& x)
+	{
+		mHeap.DoSwap(x.mHeap);
+		mPositions.swap(x.mPositions);
+		eastl::swap(mnFreeHandle, x.mnFreeHandle);
+		eastl::swap(mCompare, x.mCompare);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void indexed_heap<T, D, C, A>::reserve(size_type n)
+	{
+		mHeap.reserve(n);
+		mPositions.reserve(n);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void indexed_heap<T, D, C, A>::clear()
+	{
+		mHeap.DoDestroyAll();
+		mPositions.clear();
+		mnFreeHandle = kInvalidHandle;
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline typename indexed_heap<T, D, C, A>::handle_type
+	indexed_heap<T, D, C, A>::DoAllocateHandle()
+	{
+		if(mnFreeHandle != kInvalidHandle)
+		{
+			const handle_type h = mnFreeHandle;
+			const handle_type nNext = mPositions[h] & ~kFreeFlag;
+			mnFreeHandle = (nNext == (kInvalidHandle & ~kFreeFlag)) ? kInvalidHandle : nNext;
+			return h;
+		}
+
+		EASTL_ASSERT(mPositions.size() < (size_type)(kFreeFlag - 1));
+		mPositions.pushBack(0);
+		return (handle_type)(mPositions.size() - 1);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void indexed_heap<T, D, C, A>::DoFreeHandle(handle_type h)
+	{
+		mPositions[h] = kFreeFlag | (mnFreeHandle & ~kFreeFlag);
+		mnFreeHandle  = h;
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	void indexed_heap<T, D, C, A>::DoPromote(size_type position, node_type& node)
+	{
+		node_type* const pHeap = mHeap.mpBegin;
+
+		while(position > 0)
+		{
+			const size_type parentPosition = (position - 1) / D;
+
+			if(!mCompare(pHeap[parentPosition], node))
+				break;
+
+			pHeap[position] = EASTL_MOVE(pHeap[parentPosition]);
+			mPositions[pHeap[position].mnHandle] = (handle_type)position;
+			position = parentPosition;
+		}
+
+		pHeap[position] = EASTL_MOVE(node);
+		mPositions[pHeap[position].mnHandle] = (handle_type)position;
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	void indexed_heap<T, D, C, A>::DoAdjust(size_type position, node_type& node)
+	{
+		// Moves the vacancy at position down to the bottom and then promotes node
+		// from there, as Internal::DaryAdjustHeap does.
+		node_type* const pHeap     = mHeap.mpBegin;
+		const size_type  heapSize  = mHeap.mnSize;
+		size_type        childPosition = (D * position) + 1;
+
+		for(; (childPosition + D) <= heapSize; childPosition = (D * childPosition) + 1)
+		{
+			Internal::DaryPrefetchGrandchildren<D>(pHeap, childPosition, heapSize);
+			childPosition = Internal::dary_best_of<D>::get(pHeap, childPosition, mCompare);
+			pHeap[position] = EASTL_MOVE(pHeap[childPosition]);
+			mPositions[pHeap[position].mnHandle] = (handle_type)position;
+			position = childPosition;
+		}
+
+		if(childPosition < heapSize)
+		{
+			childPosition = Internal::DaryBestChild(pHeap, childPosition, heapSize - childPosition, mCompare);
+			pHeap[position] = EASTL_MOVE(pHeap[childPosition]);
+			mPositions[pHeap[position].mnHandle] = (handle_type)position;
+			position = childPosition;
+		}
+
+		DoPromote(position, node);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline typename indexed_heap<T, D, C, A>::handle_type
+	indexed_heap<T, D, C, A>::push(const value_type& value)
+	{
+		const handle_type h = DoAllocateHandle();
+
+		if(mHeap.mnSize == mHeap.mnCapacity)
+			mHeap.DoGrow(mHeap.mnSize + 1);
+		node_type* const pNode = ::new((void*)(mHeap.mpBegin + mHeap.mnSize)) node_type(value, h); // The slot must be constructed before DoPromote assigns to it.
+		node_type node(EASTL_MOVE(*pNode));
+		DoPromote(mHeap.mnSize++, node);
+		return h;
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename T, size_t D, typename C, typename A>
+		inline typename indexed_heap<T, D, C, A>::handle_type
+		indexed_heap<T, D, C, A>::push(value_type&& value)
+		{
+			const handle_type h = DoAllocateHandle();
+
+			if(mHeap.mnSize == mHeap.mnCapacity)
+				mHeap.DoGrow(mHeap.mnSize + 1);
+			node_type* const pNode = ::new((void*)(mHeap.mpBegin + mHeap.mnSize)) node_type(eastl::move(value), h);
+			node_type node(eastl::move(*pNode));
+			DoPromote(mHeap.mnSize++, node);
+			return h;
+		}
+	#endif
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void indexed_heap<T, D, C, A>::DoRemoveTop()
+	{
+		node_type* const pHeap = mHeap.mpBegin;
+
+		DoFreeHandle(pHeap[0].mnHandle);
+
+		const size_type nLast = --mHeap.mnSize;
+
+		if(nLast != 0)
+		{
+			node_type node(EASTL_MOVE(pHeap[nLast]));
+			pHeap[nLast].~node_type();
+			DoAdjust(0, node);
+		}
+		else
+			pHeap[0].~node_type();
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void indexed_heap<T, D, C, A>::pop()
+	{
+		EASTL_ASSERT(mHeap.mnSize != 0);
+		DoRemoveTop();
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void indexed_heap<T, D, C, A>::pop(value_type& value)
+	{
+		EASTL_ASSERT(mHeap.mnSize != 0);
+		value = EASTL_MOVE(mHeap.mpBegin->mValue);
+		DoRemoveTop();
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	template <typename OutputIterator>
+	OutputIterator indexed_heap<T, D, C, A>::pop_n(size_type n, OutputIterator result)
+	{
+		for(; n && mHeap.mnSize; --n)
+		{
+			*result = EASTL_MOVE(mHeap.mpBegin->mValue);
+			++result;
+			DoRemoveTop();
+		}
+
+		return result;
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void indexed_heap<T, D, C, A>::decrease_key(handle_type h, const value_type& value)
+	{
+		EASTL_ASSERT(contains(h));
+		EASTL_ASSERT(!mCompare.mCompare(value, get(h)));
+
+		const size_type position = mPositions[h];
+		node_type node(value, h);
+		DoPromote(position, node);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	void indexed_heap<T, D, C, A>::change(handle_type h, const value_type& value)
+	{
+		EASTL_ASSERT(contains(h));
+
+		const size_type position = mPositions[h];
+		node_type node(value, h);
+
+		if((position > 0) && mCompare(mHeap.mpBegin[(position - 1) / D], node))
+			DoPromote(position, node);
+		else
+			DoAdjust(position, node);
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	void indexed_heap<T, D, C, A>::erase(handle_type h)
+	{
+		EASTL_ASSERT(contains(h));
+
+		node_type* const pHeap    = mHeap.mpBegin;
+		const size_type  position = mPositions[h];
+		const size_type  nLast    = --mHeap.mnSize;
+
+		DoFreeHandle(h);
+
+		if(position != nLast)
+		{
+			// Fill the vacancy with the last entry, which may belong above or below it.
+			node_type node(EASTL_MOVE(pHeap[nLast]));
+			pHeap[nLast].~node_type();
+
+			if((position > 0) && mCompare(pHeap[(position - 1) / D], node))
+				DoPromote(position, node);
+			else
+				DoAdjust(position, node);
+		}
+		else
+			pHeap[nLast].~node_type();
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	bool indexed_heap<T, D, C, A>::validate() const
+	{
+		const node_type* const pHeap = mHeap.mpBegin;
+
+		if(!eastl::isDaryHeap<D>(pHeap, pHeap + mHeap.mnSize, mCompare))
+			return false;
+
+		size_type nFreeCount = 0;
+
+		for(size_type i = 0; i < mHeap.mnSize; ++i)
+		{
+			const handle_type h = pHeap[i].mnHandle;
+			if((h >= (handle_type)mPositions.size()) || (mPositions[h] != (handle_type)i))
+				return false;
+		}
+
+		for(handle_type h = mnFreeHandle; h != kInvalidHandle; ++nFreeCount)
+		{
+			if((h >= (handle_type)mPositions.size()) || !(mPositions[h] & kFreeFlag) || (nFreeCount > mPositions.size()))
+				return false;
+			h = mPositions[h] & ~kFreeFlag;
+			if(h == (kInvalidHandle & ~kFreeFlag))
+				h = kInvalidHandle;
+		}
+
+		return (mHeap.mnSize + nFreeCount) == mPositions.size();
+	}
+
+
+	template <typename T, size_t D, typename C, typename A>
+	inline void swap(indexed_heap<T, D, C, A>& a, indexed_heap<T, D, C, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,555 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements enum_set, a set of the values of an enumeration with N
+// members, stored as a bit per member in the same words that bitset uses.
+// Unlike extra/flags.h, which is limited to the 32 bits of a uint32_t, an
+// enum_set can hold any number of members, and the enum's values are the bit
+// indexes [0, N) rather than masks.
+//
+// An enum_set can be constructed at compile time from a list of members, and
+// iterating over it visits only the set members, with a countr_zero per member.
+//
+// enumSetAnd, enumSetOr and enumSetContainsAll operate on arrays of enum sets,
+// with SSE2 or AVX2 where available. They are meant for matching large numbers
+// of small sets (such as 128 bit component masks) against a query.
+//
+// Example usage:
+//     enum class Component { Position, Velocity, Mesh, Count };
+//     typedef eastl::enum_set<Component, (size_t)Component::Count> ComponentMask;
+//
+//     EA_CONSTEXPR ComponentMask kMovable(Component::Position, Component::Velocity);
+//
+//     for(Component c : mask)
+//         ...
+//
+//     size_t nMatched = eastl::enumSetContainsAll(masks.data(), masks.size(), kMovable, matchedIndexes);
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_ENUM_SET_H
+#define EASTL_ENUM_SET_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/integer_sequence.h>
+#include <eastl/bit.h>
+#include <eastl/bitset.h>
+#include <eastl/iterator.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <string.h>
+#endif
+
+#if EA_AVX2
+	#include <immintrin.h>
+#elif EASTL_SSE2
+	#include <emmintrin.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// enum_set_iterator
+	///
+	/// Iterates over the members of an enum_set in increasing order. Each
+	/// increment clears the lowest bit of the current word and finds the next
+	/// one with countr_zero, so empty words are all that is ever skipped.
+	///
+	template <typename Enum, typename WordType, size_t nWordCount>
+	class enum_set_iterator
+	{
+	public:
+		typedef enum_set_iterator<Enum, WordType, nWordCount> this_type;
+		typedef Enum                                           value_type;
+		typedef const Enum*                                    pointer;
+		typedef Enum                                           reference;
+		typedef ptrdiff_t                                      difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag             iterator_category;
+
+		enum { kBitsPerWord = 8 * sizeof(WordType) };
+
+	public:
+		enum_set_iterator()
+			: mpWord(NULL), mnWordIndex(nWordCount), mWord(0) { }
+
+		enum_set_iterator(const WordType* pWord, size_t nWordIndex)
+			: mpWord(pWord), mnWordIndex(nWordIndex), mWord((nWordIndex < nWordCount) ? pWord[nWordIndex] : 0)
+			{ DoSkipEmpty(); }
+
+		reference operator*() const
+			{ return (Enum)((mnWordIndex * kBitsPerWord) + (size_t)eastl::countr_zero(mWord)); }
+
+		this_type& operator++()
+		{
+			mWord &= (WordType)(mWord - 1);
+			DoSkipEmpty();
+			return *this;
+		}
+
+		this_type operator++(int)
+		{
+			this_type temp(*this);
+			++*this;
+			return temp;
+		}
+
+		bool operator==(const this_type& x) const
+			{ return (mnWordIndex == x.mnWordIndex) && (mWord == x.mWord); }
+
+		bool operator!=(const this_type& x) const
+			{ return !(*this == x); }
+
+	protected:
+		void DoSkipEmpty()
+		{
+			while(!mWord && (mnWordIndex < nWordCount))
+			{
+				if(++mnWordIndex < nWordCount)
+					mWord = mpWord[mnWordIndex];
+			}
+		}
+
+		const WordType* mpWord;
+		size_t          mnWordIndex;
+		WordType        mWord;          // The bits of mpWord[mnWordIndex] that haven't been visited yet.
+	};
+
+
+
+	/// enum_set
+	///
+	/// A set of the members of Enum, whose values must be in the range [0, N).
+	/// The layout is kWordCount words of WordType and nothing else, so arrays of
+	/// enum sets can be processed as flat arrays of words. Bits at or above N
+	/// are always zero.
+	///
+	template <typename Enum, size_t N, typename WordType = EASTL_BITSET_WORD_TYPE_DEFAULT>
+	class enum_set
+	{
+	public:
+		typedef enum_set<Enum, N, WordType>  this_type;
+		typedef Enum                         value_type;
+		typedef WordType                     word_type;
+		typedef eastl_size_t                 size_type;
+		typedef bitset<N, WordType>          bitset_type;
+
+		enum
+		{
+			kSize         = N,
+			kBitsPerWord  = (8 * sizeof(word_type)),
+			kWordCount    = ((N == 0) ? 1 : ((N - 1) / kBitsPerWord + 1)),
+			kLastWordBits = (N % kBitsPerWord)                                  // The number of bits used in the last word, or 0 if all of them are.
+		};
+
+		typedef enum_set_iterator<Enum, WordType, kWordCount> const_iterator;
+		typedef const_iterator                                iterator;
+
+	public:
+		EA_CONSTEXPR enum_set()
+			: mWord() { }
+
+		#if EASTL_VARIADIC_TEMPLATES_ENABLED
+			template <typename... Enums>
+			EA_CONSTEXPR enum_set(Enum e, Enums... rest)
+				: enum_set(make_index_sequence<kWordCount>(), e, rest...) { }
+		#else
+			enum_set(Enum e)
+				: mWord() { set(e); }
+		#endif
+
+		explicit enum_set(const bitset_type& x)
+			{ memcpy(mWord, x.data(), sizeof(mWord)); }
+
+		bitset_type to_bitset() const
+		{
+			bitset_type x;
+			memcpy(x.data(), mWord, sizeof(mWord));
+			return x;
+		}
+
+		this_type& set()
+		{
+			for(size_t i = 0; i < kWordCount; i++)
+				mWord[i] = (word_type)~word_type(0);
+			DoClearUnusedBits();
+			return *this;
+		}
+
+		this_type& set(Enum e, bool value = true)
+		{
+			if(value)
+				mWord[DoGetWordIndex(e)] |= DoGetMask(e);
+			else
+				mWord[DoGetWordIndex(e)] &= (word_type)~DoGetMask(e);
+			return *this;
+		}
+
+		this_type& reset()
+		{
+			for(size_t i = 0; i < kWordCount; i++)
+				mWord[i] = 0;
+			return *this;
+		}
+
+		this_type& reset(Enum e)
+			{ return set(e, false); }
+
+		this_type& flip()
+		{
+			for(size_t i = 0; i < kWordCount; i++)
+				mWord[i] = (word_type)~mWord[i];
+			DoClearUnusedBits();
+			return *this;
+		}
+
+		this_type& flip(Enum e)
+		{
+			mWord[DoGetWordIndex(e)] ^= DoGetMask(e);
+			return *this;
+		}
+
+		EA_CONSTEXPR bool test(Enum e) const
+			{ return ((size_t)e < N) ? ((mWord[(size_t)e / kBitsPerWord] & ((word_type)1 << ((size_t)e % kBitsPerWord))) != 0) : (DoOutOfRange() != 0); }
+
+		EA_CONSTEXPR bool operator[](Enum e) const
+			{ return test(e); }
+
+		size_type count() const
+		{
+			size_type n = 0;
+			for(size_t i = 0; i < kWordCount; i++)
+				n += (size_type)eastl::popcount(mWord[i]);
+			return n;
+		}
+
+		bool any() const
+		{
+			word_type x = 0;
+			for(size_t i = 0; i < kWordCount; i++)
+				x |= mWord[i];
+			return x != 0;
+		}
+
+		bool none() const
+			{ return !any(); }
+
+		bool all() const
+			{ return count() == (size_type)N; }
+
+		bool contains_all(const this_type& x) const // Returns true if every member of x is in this set.
+		{
+			word_type missing = 0;
+			for(size_t i = 0; i < kWordCount; i++)
+				missing |= (word_type)(x.mWord[i] & ~mWord[i]);
+			return missing == 0;
+		}
+
+		bool contains_any(const this_type& x) const // Returns true if any member of x is in this set.
+		{
+			word_type common = 0;
+			for(size_t i = 0; i < kWordCount; i++)
+				common |= (word_type)(x.mWord[i] & mWord[i]);
+			return common != 0;
+		}
+
+		const_iterator begin() const
+			{ return const_iterator(mWord, 0); }
+
+		const_iterator end() const
+			{ return const_iterator(mWord, kWordCount); }
+
+		this_type& operator&=(const this_type& x)
+		{
+			for(size_t i = 0; i < kWordCount; i++)
+				mWord[i] &= x.mWord[i];
+			return *this;
+		}
+
+		this_type& operator|=(const this_type& x)
+		{
+			for(size_t i = 0; i < kWordCount; i++)
+				mWord[i] |= x.mWord[i];
+			return *this;
+		}
+
+		this_type& operator^=(const this_type& x)
+		{
+			for(size_t i = 0; i < kWordCount; i++)
+				mWord[i] ^= x.mWord[i];
+			return *this;
+		}
+
+		this_type operator~() const
+			{ return this_type(*this).flip(); }
+
+		bool operator==(const this_type& x) const
+			{ return memcmp(mWord, x.mWord, sizeof(mWord)) == 0; }
+
+		bool operator!=(const this_type& x) const
+			{ return !(*this == x); }
+
+		const word_type* data() const { return mWord; }
+		word_type*       data()       { return mWord; } // The bits at or above N must be left zero.
+
+	protected:
+		#if EASTL_VARIADIC_TEMPLATES_ENABLED
+			template <size_t... Is, typename... Enums>
+			EA_CONSTEXPR enum_set(index_sequence<Is...>, Enums... e)
+				: mWord{ DoMakeWord(Is, e...)... } { }
+
+			static EA_CONSTEXPR word_type DoMakeWord(size_t)
+				{ return 0; }
+
+			template <typename... Enums>
+			static EA_CONSTEXPR word_type DoMakeWord(size_t nWordIndex, Enum e, Enums... rest)
+			{
+				return (word_type)(((size_t)e >= N) ? DoOutOfRange() :
+								   (((((size_t)e / kBitsPerWord) == nWordIndex) ? ((word_type)1 << ((size_t)e % kBitsPerWord)) : (word_type)0) |
+									DoMakeWord(nWordIndex, rest...)));
+			}
+		#endif
+
+		// Called by the constexpr functions for an Enum value of N or more. As it isn't
+		// constexpr, that's a compile error in a constant expression, and otherwise it
+		// asserts. With asserts disabled the value is ignored.
+		static word_type DoOutOfRange()
+		{
+			EASTL_FAIL_MSG("enum_set: Enum value out of range.");
+			return 0;
+		}
+
+		static size_t DoGetWordIndex(Enum e)
+		{
+			EASTL_ASSERT((size_t)e < N);
+			return (size_t)e / kBitsPerWord;
+		}
+
+		static word_type DoGetMask(Enum e)
+			{ return (word_type)((word_type)1 << ((size_t)e % kBitsPerWord)); }
+
+		void DoClearUnusedBits()
+		{
+			if(kLastWordBits != 0)
+				mWord[kWordCount - 1] &= (word_type)(((word_type)1 << (kLastWordBits % kBitsPerWord)) - 1);
+			else if(N == 0)
+				mWord[0] = 0;
+		}
+
+		word_type mWord[kWordCount];
+	};
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Enum, size_t N, typename WordType>
+	inline enum_set<Enum, N, WordType> operator&(const enum_set<Enum, N, WordType>& a, const enum_set<Enum, N, WordType>& b)
+		{ return enum_set<Enum, N, WordType>(a) &= b; }
+
+	template <typename Enum, size_t N, typename WordType>
+	inline enum_set<Enum, N, WordType> operator|(const enum_set<Enum, N, WordType>& a, const enum_set<Enum, N, WordType>& b)
+		{ return enum_set<Enum, N, WordType>(a) |= b; }
+
+	template <typename Enum, size_t N, typename WordType>
+	inline enum_set<Enum, N, WordType> operator^(const enum_set<Enum, N, WordType>& a, const enum_set<Enum, N, WordType>& b)
+		{ return enum_set<Enum, N, WordType>(a) ^= b; }
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// bulk operations
+	///////////////////////////////////////////////////////////////////////
+
+	namespace Internal
+	{
+		struct enum_set_and
+		{
+			static uint8_t apply(uint8_t a, uint8_t b) { return (uint8_t)(a & b); }
+			#if EA_AVX2
+				static __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+			#elif EASTL_SSE2
+				static __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+			#endif
+		};
+
+		struct enum_set_or
+		{
+			static uint8_t apply(uint8_t a, uint8_t b) { return (uint8_t)(a | b); }
+			#if EA_AVX2
+				static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+			#elif EASTL_SSE2
+				static __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+			#endif
+		};
+
+		/// enum_set_transform
+		///
+		/// Applies Op to the bytes of two arrays of enum sets. Enum sets are plain
+		/// arrays of words, so the arrays can be treated as flat runs of bytes.
+		///
+		template <typename Op>
+		inline void enum_set_transform(const uint8_t* pA, const uint8_t* pB, uint8_t* pResult, size_t nBytes)
+		{
+			size_t i = 0;
+
+			#if EA_AVX2
+				for(; (i + 32) <= nBytes; i += 32)
+					_mm256_storeu_si256((__m256i*)(pResult + i), Op::apply(_mm256_loadu_si256((const __m256i*)(pA + i)), _mm256_loadu_si256((const __m256i*)(pB + i))));
+			#elif EASTL_SSE2
+				for(; (i + 16) <= nBytes; i += 16)
+					_mm_storeu_si128((__m128i*)(pResult + i), Op::apply(_mm_loadu_si128((const __m128i*)(pA + i)), _mm_loadu_si128((const __m128i*)(pB + i))));
+			#endif
+
+			for(; i < nBytes; ++i)
+				pResult[i] = Op::apply(pA[i], pB[i]);
+		}
+	}
+
+
+	/// enumSetAnd
+	///
+	/// Sets pResult[i] = pA[i] & pB[i] for i in [0, nCount). pResult may be pA or pB.
+	///
+	template <typename Enum, size_t N, typename WordType>
+	inline void enumSetAnd(const enum_set<Enum, N, WordType>* pA, const enum_set<Enum, N, WordType>* pB, enum_set<Enum, N, WordType>* pResult, size_t nCount)
+	{
+		Internal::enum_set_transform<Internal::enum_set_and>((const uint8_t*)pA, (const uint8_t*)pB, (uint8_t*)pResult, nCount * sizeof(enum_set<Enum, N, WordType>));
+	}
+
+
+	/// enumSetOr
+	///
+	/// Sets pResult[i] = pA[i] | pB[i] for i in [0, nCount). pResult may be pA or pB.
+	///
+	template <typename Enum, size_t N, typename WordType>
+	inline void enumSetOr(const enum_set<Enum, N, WordType>* pA, const enum_set<Enum, N, WordType>* pB, enum_set<Enum, N, WordType>* pResult, size_t nCount)
+	{
+		Internal::enum_set_transform<Internal::enum_set_or>((const uint8_t*)pA, (const uint8_t*)pB, (uint8_t*)pResult, nCount * sizeof(enum_set<Enum, N, WordType>));
+	}
+
+
+	/// enumSetContainsAll
+	///
+	/// Writes the index of each set in [pSets, pSets + nCount) that contains all
+	/// of the members of required to pIndexes, in increasing order, and returns
+	/// the number written. pIndexes must have room for nCount indexes.
+	///
+	/// The vector version computes the missing members (~set & required) a vector
+	/// at a time and collects one bit per 32 (SSE2) or 64 (AVX2) bit lane that is
+	/// zero, 64 lanes at a time. Anding each set's lanes together leaves one bit
+	/// per matching set, and the indexes are written with a countr_zero per match.
+	/// This requires the size of a set to be a power of two number of lanes, which
+	/// it is for the common sizes; other sizes are matched a set at a time.
+	///
+	template <typename Enum, size_t N, typename WordType>
+	size_t enumSetContainsAll(const enum_set<Enum, N, WordType>* pSets, size_t nCount, const enum_set<Enum, N, WordType>& required, size_t* pIndexes)
+	{
+		typedef enum_set<Enum, N, WordType> set_type;
+
+		size_t nFound = 0;
+		size_t i      = 0;
+
+		EASTL_CT_ASSERT(sizeof(set_type) == (sizeof(WordType) * set_type::kWordCount));
+
+		#if EA_AVX2 || EASTL_SSE2
+			#if EA_AVX2
+				const size_t kVectorSize = 128; // Four AVX vectors, whose 32 lane compares are packed into the bytes of one for a single movemask.
+				const size_t kLaneSize   = 4;
+				#define EASTL_ENUM_SET_ZERO_LANES_256(p, pRequired) _mm256_cmpeq_epi32(_mm256_andnot_si256(_mm256_loadu_si256((const __m256i*)(p)), _mm256_loadu_si256((const __m256i*)(pRequired))), _mm256_setzero_si256())
+				#define EASTL_ENUM_SET_ZERO_LANES(p, pRequired) (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_permutevar8x32_epi32(_mm256_packs_epi16( \
+									_mm256_packs_epi32(EASTL_ENUM_SET_ZERO_LANES_256((p),      (pRequired)),      EASTL_ENUM_SET_ZERO_LANES_256((p) + 32, (pRequired) + 32)), \
+									_mm256_packs_epi32(EASTL_ENUM_SET_ZERO_LANES_256((p) + 64, (pRequired) + 64), EASTL_ENUM_SET_ZERO_LANES_256((p) + 96, (pRequired) + 96))), \
+									_mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7))) // The packs work within 128 bit halves; this puts the lanes back in order.
+			#else
+				const size_t kVectorSize = 64; // Four SSE vectors, whose 16 lane compares are packed into the bytes of one for a single movemask.
+				const size_t kLaneSize   = 4;
+				#define EASTL_ENUM_SET_ZERO_LANES_128(p, pRequired) _mm_cmpeq_epi32(_mm_andnot_si128(_mm_loadu_si128((const __m128i*)(p)), _mm_loadu_si128((const __m128i*)(pRequired))), _mm_setzero_si128())
+				#define EASTL_ENUM_SET_ZERO_LANES(p, pRequired) (uint64_t)_mm_movemask_epi8(_mm_packs_epi16( \
+									_mm_packs_epi32(EASTL_ENUM_SET_ZERO_LANES_128((p),      (pRequired)),      EASTL_ENUM_SET_ZERO_LANES_128((p) + 16, (pRequired) + 16)), \
+									_mm_packs_epi32(EASTL_ENUM_SET_ZERO_LANES_128((p) + 32, (pRequired) + 32), EASTL_ENUM_SET_ZERO_LANES_128((p) + 48, (pRequired) + 48))))
+			#endif
+
+			const size_t kSetSize  = sizeof(set_type);
+			const size_t kSetLanes = kSetSize / kLaneSize;    // The number of lanes each set spans.
+
+			if(((kSetSize % kLaneSize) == 0) && (kSetLanes <= 64) && eastl::has_single_bit(kSetLanes))
+			{
+				const size_t   kLanesPerVector = kVectorSize / kLaneSize;
+				const size_t   kSetsPerBlock   = 64 / kSetLanes;
+				const size_t   kPatternSize    = (kSetSize > kVectorSize) ? kSetSize : kVectorSize;
+				const uint64_t kFirstLanes     = (kSetLanes == 64) ? 1 : (~UINT64_C(0) / ((UINT64_C(1) << (kSetLanes % 64)) - 1)); // The bit of the first lane of every set.
+				const uint8_t* pBytes          = (const uint8_t*)pSets;
+				const uint8_t* pPattern        = (const uint8_t*)required.data();
+				uint8_t        requiredRepeated[kVectorSize];
+
+				if(kSetSize < kVectorSize) // Sets smaller than a vector are compared against required repeated to fill a vector.
+				{
+					for(size_t k = 0; k < kVectorSize; k += kSetSize)
+						memcpy(requiredRepeated + k, required.data(), (kSetSize < kVectorSize) ? kSetSize : kVectorSize);
+					pPattern = requiredRepeated;
+				}
+
+				// The matches of a chunk of blocks are found before any are written. Writing
+				// them takes a branch per match, and if those branches depended directly on
+				// loads that miss the cache, each mispredict would throw away the loads that
+				// had been started for the following blocks.
+				const size_t kBlocksPerChunk = 16;
+				uint64_t     chunkMatches[kBlocksPerChunk];
+
+				for(; (i + (kSetsPerBlock * kBlocksPerChunk)) <= nCount; i += (kSetsPerBlock * kBlocksPerChunk))
+				{
+					for(size_t b = 0; b < kBlocksPerChunk; ++b)
+					{
+						const uint8_t* pBlock = pBytes + ((i + (b * kSetsPerBlock)) * kSetSize);
+						uint64_t       lanes  = 0;
+
+						for(size_t v = 0; v < (64 / kLanesPerVector); ++v)
+							lanes |= EASTL_ENUM_SET_ZERO_LANES(pBlock + (v * kVectorSize), pPattern + ((v * kVectorSize) % kPatternSize)) << (v * kLanesPerVector);
+
+						for(size_t shift = 1; shift < kSetLanes; shift <<= 1)
+							lanes &= (lanes >> shift);
+
+						chunkMatches[b] = lanes & kFirstLanes;
+					}
+
+					for(size_t b = 0; b < kBlocksPerChunk; ++b)
+					{
+						for(uint64_t matches = chunkMatches[b]; matches; matches &= (matches - 1))
+							pIndexes[nFound++] = i + (b * kSetsPerBlock) + ((size_t)eastl::countr_zero(matches) / kSetLanes);
+					}
+				}
+			}
+
+			#undef EASTL_ENUM_SET_ZERO_LANES
+			#undef EASTL_ENUM_SET_ZERO_LANES_128
+			#undef EASTL_ENUM_SET_ZERO_LANES_256
+		#endif
+
+		for(; i < nCount; ++i)
+		{
+			pIndexes[nFound] = i;
+			nFound += pSets[i].contains_all(required);
+		}
+
+		return nFound;
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
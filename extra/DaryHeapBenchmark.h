@@ -0,0 +1,365 @@
+// Checks and times eastl::d_ary_heap and eastl::indexed_heap, and times
+// eastl::radix_heap and eastl::pairing_heap against them.
+//
+// The check runs random pushes, pops, push_ranges, pop_ns and removals on each
+// heap alongside a plain vector of the same contents, and compares the tops
+// and validate() as it goes. indexed_heap is also given random decrease_key,
+// change and erase calls on its handles. d_ary_heap::validate also checks the
+// alignment of the storage, so the aligned operator new[] which EASTL's
+// allocator calls must honour its alignment argument.
+//
+// The benchmarks are:
+//   - The hold model: with n keys in the heap, pop the top and push a later
+//     key, as a timer queue or event simulation does. This is timed for
+//     priority_queue, for d-ary heaps of several arities, for radix_heap,
+//     whose monotone keys this trace respects, and for pairing_heap.
+//   - push_range's choice: adding a batch of random keys to a heap by pushing
+//     each one, and by appending them all and remaking the heap, for batches
+//     from an eighth of the heap's size to twice it. Internal::HeapRebuildIsCheaper
+//     is meant to pick whichever of the two is faster.
+//
+// To build it, compile a .cpp file which does:
+//     #define DARY_HEAP_BENCHMARK_MAIN
+//     #include <eastl/extra/DaryHeapBenchmark.h>
+
+#ifndef EASTL_EXTRA_DARYHEAPBENCHMARK_H
+#define EASTL_EXTRA_DARYHEAPBENCHMARK_H
+
+#include <eastl/d_ary_heap.h>
+#include <eastl/radix_heap.h>
+#include <eastl/pairing_heap.h>
+#include <eastl/priority_queue.h>
+#include <eastl/heap.h>
+#include <eastl/algorithm.h>
+#include <eastl/vector.h>
+#include <stdio.h>
+
+#ifdef WIN32
+	#include <windows.h>
+#else
+	#include <sys/time.h>
+#endif
+
+namespace eastl
+{
+	namespace dary_heap_benchmark
+	{
+		#ifdef WIN32
+			inline uint64_t GetMicroTime() { static uint64_t hz=0; static uint64_t hzo=0; if (!hz) { QueryPerformanceFrequency((LARGE_INTEGER*)&hz); QueryPerformanceCounter((LARGE_INTEGER*)&hzo); } uint64_t t; QueryPerformanceCounter((LARGE_INTEGER*)&t); return ((t-hzo)*1000000)/hz; }
+		#else
+			inline uint64_t GetMicroTime() { timeval t;gettimeofday(&t,NULL); return t.tv_sec * 1000000ull + t.tv_usec; }
+		#endif
+
+		// xorshift64
+		inline uint64_t Random()
+		{
+			static uint64_t nState = UINT64_C(88172645463325252);
+			nState ^= nState << 13;
+			nState ^= nState >> 7;
+			nState ^= nState << 17;
+			return nState;
+		}
+
+
+		/////////////////////////////// the check
+
+		// Removes and returns the largest value in v.
+		inline uint32_t PopLargest(vector<uint32_t>& v)
+		{
+			vector<uint32_t>::iterator it = eastl::maxElement(v.begin(), v.end());
+			const uint32_t value = *it;
+			*it = v.back();
+			v.popBack();
+			return value;
+		}
+
+		inline void EraseValue(vector<uint32_t>& v, uint32_t value)
+		{
+			vector<uint32_t>::iterator it = eastl::find(v.begin(), v.end(), value);
+			*it = v.back();
+			v.popBack();
+		}
+
+		template <size_t D>
+		int RunDaryHeapCheck(int nOpCount)
+		{
+			int nErrorCount = 0;
+			d_ary_heap<uint32_t, D> heap;
+			vector<uint32_t>        reference;
+
+			for(int k = 0; k < nOpCount; ++k)
+			{
+				const uint32_t op = (uint32_t)(Random() % 10);
+
+				if(op < 4)
+				{
+					const uint32_t value = (uint32_t)(Random() % 500);
+					heap.push(value);
+					reference.pushBack(value);
+				}
+				else if(op < 5)
+				{
+					vector<uint32_t> batch((eastl_size_t)(Random() % ((Random() % 4) ? 10 : 400)));
+					for(eastl_size_t i = 0; i < batch.size(); ++i)
+						batch[i] = (uint32_t)(Random() % 500);
+					heap.push_range(batch.begin(), batch.end());
+					reference.insert(reference.end(), batch.begin(), batch.end());
+				}
+				else if((op < 7) && !heap.empty())
+				{
+					if(heap.top() != PopLargest(reference))
+						++nErrorCount;
+					heap.pop();
+				}
+				else if(op < 8)
+				{
+					uint32_t popped[8];
+					const size_t nRequested = (size_t)(Random() % 8);
+					const size_t nExpected  = eastl::min(nRequested, (size_t)reference.size());
+
+					if((size_t)(heap.pop_n(nRequested, popped) - popped) != nExpected)
+						++nErrorCount;
+					for(size_t i = 0; i < nExpected; ++i)
+					{
+						if(popped[i] != PopLargest(reference))
+							++nErrorCount;
+					}
+				}
+				else if((op < 9) && !heap.empty())
+				{
+					const size_t n = (size_t)(Random() % heap.size());
+					const uint32_t value = heap.begin()[n];
+					heap.remove(n);
+					EraseValue(reference, value);
+				}
+
+				if((heap.size() != reference.size()) || !heap.validate())
+					++nErrorCount;
+			}
+
+			return nErrorCount;
+		}
+
+		template <size_t D>
+		int RunIndexedHeapCheck(int nOpCount)
+		{
+			typedef indexed_heap<uint32_t, D, eastl::greater<uint32_t> > heap_type;
+			typedef typename heap_type::handle_type                      handle_type;
+
+			int              nErrorCount = 0;
+			heap_type        heap;
+			vector<uint32_t> values; // Indexed by handle.
+			vector<bool>     live;
+
+			for(int k = 0; k < nOpCount; ++k)
+			{
+				const uint32_t op = (uint32_t)(Random() % 10);
+
+				if(op < 4)
+				{
+					const uint32_t    value = (uint32_t)(Random() % 1000) + 1000;
+					const handle_type h     = heap.push(value);
+
+					if(h >= values.size())
+					{
+						values.resize(h + 1);
+						live.resize(h + 1);
+					}
+					if(live[h])
+						++nErrorCount;
+					values[h] = value;
+					live[h]   = true;
+				}
+				else if(heap.empty())
+					continue;
+				else if(op < 5)
+				{
+					const handle_type h = heap.top_handle();
+					uint32_t nSmallest = 0xffffffff;
+					for(eastl_size_t i = 0; i < values.size(); ++i)
+					{
+						if(live[i] && (values[i] < nSmallest))
+							nSmallest = values[i];
+					}
+					if((heap.top() != nSmallest) || (values[h] != nSmallest))
+						++nErrorCount;
+					heap.pop();
+					live[h] = false;
+				}
+				else
+				{
+					handle_type h;
+					do
+						h = (handle_type)(Random() % values.size());
+					while(!live[h]);
+
+					if(op < 7)
+					{
+						values[h] -= (uint32_t)(Random() % 50);
+						heap.decrease_key(h, values[h]);
+					}
+					else if(op < 9)
+					{
+						values[h] = (uint32_t)(Random() % 1000) + 1000;
+						heap.change(h, values[h]);
+					}
+					else
+					{
+						heap.erase(h);
+						live[h] = false;
+					}
+				}
+
+				size_t nLiveCount = 0;
+				for(eastl_size_t i = 0; i < live.size(); ++i)
+				{
+					if(live[i])
+					{
+						++nLiveCount;
+						if(!heap.contains((handle_type)i) || (heap.get((handle_type)i) != values[i]))
+							++nErrorCount;
+					}
+				}
+
+				if((nLiveCount != heap.size()) || !heap.validate())
+					++nErrorCount;
+			}
+
+			return nErrorCount;
+		}
+
+
+		/////////////////////////////// the benchmarks proper
+
+		// Returns the nanoseconds per pop and push.
+		template <typename Heap>
+		double RunHoldBenchmark(Heap& heap, size_t nHeapSize, size_t nOpCount)
+		{
+			const uint64_t nRange = (uint64_t)nHeapSize * 1024;
+
+			for(size_t i = 0; i < nHeapSize; ++i)
+				heap.push(Random() % nRange);
+
+			uint64_t nSum = 0; // Use the popped values so that the compiler can't drop them.
+			const uint64_t t0 = GetMicroTime();
+
+			for(size_t i = 0; i < nOpCount; ++i)
+			{
+				const uint64_t value = heap.top();
+				nSum += value;
+				heap.pop();
+				heap.push(value + (Random() % (2 * nRange)));
+			}
+
+			const double fTime = (double)(GetMicroTime() - t0) * 1000.0 / (double)nOpCount;
+			return (nSum == 1) ? 0.0 : fTime;
+		}
+
+		// Gives radix_heap, whose entries are (key, value) pairs, the interface RunHoldBenchmark uses.
+		struct radix_hold_heap
+		{
+			radix_heap<uint64_t, uint32_t> mHeap;
+
+			void     push(uint64_t key) { mHeap.push(key, 0); }
+			uint64_t top()              { return mHeap.top().first; }
+			void     pop()              { mHeap.pop(); }
+		};
+
+		inline void RunHoldBenchmarks(size_t nHeapSize, size_t nOpCount)
+		{
+			typedef eastl::greater<uint64_t> compare_type;
+
+			printf("hold n=%-9u", (unsigned)nHeapSize);
+			{ priority_queue<uint64_t, vector<uint64_t>, compare_type> h; printf("  priority_queue %6.1f", RunHoldBenchmark(h, nHeapSize, nOpCount)); }
+			{ d_ary_heap<uint64_t, 2, compare_type>   h; printf("  d2 %6.1f",   RunHoldBenchmark(h, nHeapSize, nOpCount)); }
+			{ d_ary_heap<uint64_t, 4, compare_type>   h; printf("  d4 %6.1f",   RunHoldBenchmark(h, nHeapSize, nOpCount)); }
+			{ d_ary_heap<uint64_t, 8, compare_type>   h; printf("  d8 %6.1f",   RunHoldBenchmark(h, nHeapSize, nOpCount)); }
+			{ indexed_heap<uint64_t, 4, compare_type> h; printf("  indexed4 %6.1f", RunHoldBenchmark(h, nHeapSize, nOpCount)); }
+			{ radix_hold_heap                         h; printf("  radix %6.1f", RunHoldBenchmark(h, nHeapSize, nOpCount)); }
+			{ pairing_heap<uint64_t, compare_type>    h; printf("  pairing %6.1f", RunHoldBenchmark(h, nHeapSize, nOpCount)); }
+			printf("  ns/op\n");
+		}
+
+		inline void RunPushRangeBenchmark(size_t nHeapSize)
+		{
+			vector<uint64_t> heap((eastl_size_t)nHeapSize);
+			vector<uint64_t> batch((eastl_size_t)(nHeapSize * 2));
+			vector<uint64_t> v;
+
+			for(eastl_size_t i = 0; i < heap.size(); ++i)
+				heap[i] = Random();
+			for(eastl_size_t i = 0; i < batch.size(); ++i)
+				batch[i] = Random();
+			eastl::makeHeap(heap.begin(), heap.end());
+
+			for(size_t nAddCount = nHeapSize / 8; nAddCount <= nHeapSize * 2; nAddCount *= 2)
+			{
+				uint64_t t0;
+
+				v = heap;
+				t0 = GetMicroTime();
+				for(size_t i = 0; i < nAddCount; ++i)
+				{
+					v.pushBack(batch[(eastl_size_t)i]);
+					eastl::pushHeap(v.begin(), v.end());
+				}
+				const int nPushTime = int(GetMicroTime() - t0);
+
+				v = heap;
+				t0 = GetMicroTime();
+				v.insert(v.end(), batch.begin(), batch.begin() + (ptrdiff_t)nAddCount);
+				eastl::makeHeap(v.begin(), v.end());
+				const int nMakeTime = int(GetMicroTime() - t0);
+
+				v = heap;
+				t0 = GetMicroTime();
+				for(size_t i = 0; i < nAddCount; ++i)
+				{
+					v.pushBack(batch[(eastl_size_t)i]);
+					eastl::pushDaryHeap<4>(v.begin(), v.end());
+				}
+				const int nPush4Time = int(GetMicroTime() - t0);
+
+				v = heap;
+				t0 = GetMicroTime();
+				v.insert(v.end(), batch.begin(), batch.begin() + (ptrdiff_t)nAddCount);
+				eastl::makeDaryHeap<4>(v.begin(), v.end());
+				const int nMake4Time = int(GetMicroTime() - t0);
+
+				printf("push_range %8u onto %8u   binary: push %7dusec make %7dusec   4-ary: push %7dusec make %7dusec   rebuild chosen: %s\n",
+					   (unsigned)nAddCount, (unsigned)nHeapSize, nPushTime, nMakeTime, nPush4Time, nMake4Time,
+					   Internal::HeapRebuildIsCheaper(nHeapSize, nAddCount) ? "yes" : "no");
+			}
+		}
+
+	} // namespace dary_heap_benchmark
+
+} // namespace eastl
+
+
+#if defined(DARY_HEAP_BENCHMARK_MAIN)
+
+	#ifndef TEST_OP_COUNT
+		#define TEST_OP_COUNT 2000000
+	#endif
+
+	int main(int, char**)
+	{
+		using namespace eastl::dary_heap_benchmark;
+
+		const int nErrorCount = RunDaryHeapCheck<2>(5000) + RunDaryHeapCheck<4>(5000) + RunDaryHeapCheck<5>(5000) + RunDaryHeapCheck<8>(5000) +
+								RunIndexedHeapCheck<2>(3000) + RunIndexedHeapCheck<4>(3000) + RunIndexedHeapCheck<8>(3000);
+		printf("d-ary heap check: %d errors\n", nErrorCount);
+
+		const size_t sizes[] = { 1000, 100000, 1000000, 10000000 };
+		for(size_t i = 0; i < EASTLArrayCount(sizes); ++i)
+			RunHoldBenchmarks(sizes[i], TEST_OP_COUNT);
+
+		RunPushRangeBenchmark(1000000);
+
+		return nErrorCount ? 1 : 0;
+	}
+
+#endif
+
+#endif // Header include guard
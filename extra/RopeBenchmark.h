@@ -0,0 +1,265 @@
+// Checks and times eastl::rope against basicString.
+//
+// The check makes random inserts, erases, replaces and substrs on a rope and a
+// string side by side, keeping copies of the rope as snapshots, and compares
+// the contents, iteration and validate() as it goes. The benchmark makes
+// small edits at random positions in a large text, where the string has to
+// move everything after the edit and the rope only rebuilds a path.
+//
+// To build it, compile a .cpp file which does:
+//     #define ROPE_BENCHMARK_MAIN
+//     #include <eastl/extra/RopeBenchmark.h>
+
+#ifndef EASTL_EXTRA_ROPEBENCHMARK_H
+#define EASTL_EXTRA_ROPEBENCHMARK_H
+
+#include <eastl/rope.h>
+#include <eastl/string.h>
+#include <eastl/vector.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef WIN32
+	#include <windows.h>
+#else
+	#include <sys/time.h>
+#endif
+
+namespace eastl
+{
+	namespace rope_benchmark
+	{
+		#ifdef WIN32
+			inline uint64_t GetMicroTime() { static uint64_t hz=0; static uint64_t hzo=0; if (!hz) { QueryPerformanceFrequency((LARGE_INTEGER*)&hz); QueryPerformanceCounter((LARGE_INTEGER*)&hzo); } uint64_t t; QueryPerformanceCounter((LARGE_INTEGER*)&t); return ((t-hzo)*1000000)/hz; }
+		#else
+			inline uint64_t GetMicroTime() { timeval t;gettimeofday(&t,NULL); return t.tv_sec * 1000000ull + t.tv_usec; }
+		#endif
+
+		inline uint32_t Random()
+		{
+			static uint32_t nSeed = 1;
+			nSeed = (nSeed * 1103515245) + 12345;
+			return nSeed >> 8;
+		}
+
+		inline string RandomString(size_t n)
+		{
+			string s;
+			for(size_t i = 0; i < n; ++i)
+				s.pushBack((char)('a' + (Random() % 26)));
+			return s;
+		}
+
+		struct chunk_checker
+		{
+			const string* mpString;
+			size_t*       mpPosition;
+			bool*         mpMatches;
+
+			void operator()(const char* p, size_t n) const
+			{
+				if(memcmp(p, mpString->data() + *mpPosition, n) != 0)
+					*mpMatches = false;
+				*mpPosition += n;
+			}
+		};
+
+		// Returns the number of ways in which r differs from s.
+		inline int CompareRope(const rope& r, const string& s)
+		{
+			int nErrorCount = 0;
+
+			if(!r.validate())     ++nErrorCount;
+			if(r.size() != s.size()) return nErrorCount + 1;
+			if(r.str() != s)      ++nErrorCount;
+
+			size_t i = 0;
+			for(rope::const_iterator it = r.begin(); it != r.end(); ++it, ++i)
+			{
+				if(*it != s[i])
+					{ ++nErrorCount; break; }
+			}
+
+			if(!s.empty())
+			{
+				rope::const_iterator it = r.end();
+				for(size_t j = s.size(); j-- > 0; )
+				{
+					if(*--it != s[j])
+						{ ++nErrorCount; break; }
+				}
+			}
+
+			for(int k = 0; (k < 20) && !s.empty(); ++k)
+			{
+				const size_t p = Random() % s.size();
+				if(r[p] != s[p])
+					++nErrorCount;
+			}
+
+			size_t nPosition = 0;
+			bool   bMatches  = true;
+			chunk_checker checker = { &s, &nPosition, &bMatches };
+			r.forEachChunk(checker);
+			if(!bMatches || (nPosition != s.size()))
+				++nErrorCount;
+
+			return nErrorCount;
+		}
+
+
+		/////////////////////////////// the check
+
+		inline int RunRopeCheck(int nRoundCount, int nEditCount)
+		{
+			int nErrorCount = 0;
+
+			for(int round = 0; round < nRoundCount; ++round)
+			{
+				string s(RandomString(Random() % 5000));
+				rope   r(s.data(), s.size());
+
+				vector<rope>   snapshots;
+				vector<string> snapshotStrings;
+
+				for(int k = 0; k < nEditCount; ++k)
+				{
+					const size_t p = Random() % (s.size() + 1);
+
+					switch(Random() % 7)
+					{
+						case 0:
+						case 1:
+						{
+							const string t(RandomString(Random() % ((k & 1) ? 3 : 2000)));
+							r.insert(p, t.data(), t.size());
+							s.insert(p, t);
+							break;
+						}
+
+						case 2:
+						{
+							const size_t n = Random() % 300;
+							r.erase(p, n);
+							s.erase(p, n);
+							break;
+						}
+
+						case 3:
+						{
+							const size_t n   = Random() % 300;
+							const rope   sub = r.substr(p, n);
+							const string subString(s.substr(p, n));
+							nErrorCount += CompareRope(sub, subString);
+							r.insert(0, sub);
+							s.insert(0, subString);
+							break;
+						}
+
+						case 4:
+						{
+							const string t(RandomString(Random() % 50));
+							const size_t n = Random() % 50;
+							r.replace(p, n, t.data(), t.size());
+							s.replace(p, n, t);
+							break;
+						}
+
+						case 5:
+						{
+							const char c = (char)('A' + (Random() % 26));
+							r.pushBack(c);
+							s.pushBack(c);
+							break;
+						}
+
+						default:
+							snapshots.pushBack(r);
+							snapshotStrings.pushBack(s);
+							break;
+					}
+
+					if((k % 50) == 0)
+						nErrorCount += CompareRope(r, s);
+				}
+
+				nErrorCount += CompareRope(r, s);
+
+				for(eastl_size_t i = 0; i < snapshots.size(); ++i)
+					nErrorCount += CompareRope(snapshots[i], snapshotStrings[i]);
+
+				rope   r2(r);
+				string s2(s);
+				r2.append(r2);
+				s2.append(s2);
+				r2.insert(r2.size() / 2, r2);
+				s2.insert(s2.size() / 2, s2);
+				nErrorCount += CompareRope(r2, s2);
+				nErrorCount += CompareRope(r, s);
+			}
+
+			return nErrorCount;
+		}
+
+
+		/////////////////////////////// the benchmark proper
+
+		inline void RunEditBenchmark(size_t nTextSize, int nEditCount)
+		{
+			const string text(RandomString(nTextSize));
+			const char   insertion[] = "hello world";
+			uint64_t     t0;
+
+			rope r(text.data(), text.size());
+
+			t0 = GetMicroTime();
+			for(int k = 0; k < nEditCount; ++k)
+			{
+				r.insert(Random() % r.size(), insertion, sizeof(insertion) - 1);
+				r.erase(Random() % r.size(), 5);
+			}
+			printf("rope   %8d edits %10dusec\n", nEditCount, int(GetMicroTime() - t0));
+
+			string s(text);
+
+			t0 = GetMicroTime();
+			for(int k = 0; k < nEditCount; ++k)
+			{
+				s.insert(Random() % s.size(), insertion);
+				s.erase(Random() % s.size(), 5);
+			}
+			printf("string %8d edits %10dusec\n", nEditCount, int(GetMicroTime() - t0));
+
+			EASTL_ASSERT(r.validate() && (r.size() == s.size()));
+		}
+
+	} // namespace rope_benchmark
+
+} // namespace eastl
+
+
+#if defined(ROPE_BENCHMARK_MAIN)
+
+	#ifndef TEST_TEXT_SIZE
+		#define TEST_TEXT_SIZE (8 * 1024 * 1024)
+	#endif
+
+	#ifndef TEST_EDIT_COUNT
+		#define TEST_EDIT_COUNT 20000
+	#endif
+
+	int main(int, char**)
+	{
+		using namespace eastl::rope_benchmark;
+
+		const int nErrorCount = RunRopeCheck(30, 400);
+		printf("rope check: %d errors\n", nErrorCount);
+
+		RunEditBenchmark(TEST_TEXT_SIZE, TEST_EDIT_COUNT);
+
+		return nErrorCount ? 1 : 0;
+	}
+
+#endif
+
+#endif // Header include guard
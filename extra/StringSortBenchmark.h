@@ -0,0 +1,269 @@
+// Checks and times eastl::string_sort and eastl::string_stable_sort.
+//
+// The check sorts random sets of strings with string_sort and compares the
+// result with sort, and sorts C strings with string_stable_sort and compares
+// the result, pointers and all, with stableSort. The sets include URLs, which
+// share long prefixes, bytes above 0x7f, and nested prefixes ("a", "aa",
+// "aaa", ...), which split off one string at each depth and so take the
+// deepest path through the radix and multikey passes.
+//
+// The benchmark times sort, stableSort, string_sort and string_stable_sort on
+// URLs and on random strings of 4 to 15 characters, and sort with strcmp
+// against string_sort on C string URLs.
+//
+// To build it, compile a .cpp file which does:
+//     #define STRING_SORT_BENCHMARK_MAIN
+//     #include <eastl/extra/StringSortBenchmark.h>
+
+#ifndef EASTL_EXTRA_STRINGSORTBENCHMARK_H
+#define EASTL_EXTRA_STRINGSORTBENCHMARK_H
+
+#include <eastl/string_sort.h>
+#include <eastl/sort.h>
+#include <eastl/string.h>
+#include <eastl/vector.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef WIN32
+	#include <windows.h>
+#else
+	#include <sys/time.h>
+#endif
+
+namespace eastl
+{
+	namespace string_sort_benchmark
+	{
+		#ifdef WIN32
+			inline uint64_t GetMicroTime() { static uint64_t hz=0; static uint64_t hzo=0; if (!hz) { QueryPerformanceFrequency((LARGE_INTEGER*)&hz); QueryPerformanceCounter((LARGE_INTEGER*)&hzo); } uint64_t t; QueryPerformanceCounter((LARGE_INTEGER*)&t); return ((t-hzo)*1000000)/hz; }
+		#else
+			inline uint64_t GetMicroTime() { timeval t;gettimeofday(&t,NULL); return t.tv_sec * 1000000ull + t.tv_usec; }
+		#endif
+
+		inline uint32_t Random()
+		{
+			static uint32_t nSeed = 1;
+			nSeed = (nSeed * 1103515245) + 12345;
+			return nSeed >> 8;
+		}
+
+		enum StringKind
+		{
+			kKindURL,
+			kKindShort,   // 4 to 15 random lower case letters.
+			kKindBytes,   // Up to 12 bytes from a small alphabet, including bytes above 0x7f.
+			kKindNested,  // i copies of 'a', for i from 1 to n, shuffled.
+			kKindCount
+		};
+
+		inline void MakeStrings(vector<string>& strings, size_t n, StringKind kind)
+		{
+			static const char* const pHosts[] = { "https://example.com/", "https://example.com/a/b/c/", "http://www.example.org/index/", "https://cdn.example.net/static/" };
+
+			strings.clear();
+			strings.reserve((eastl_size_t)n);
+
+			for(size_t i = 0; i < n; ++i)
+			{
+				string s;
+
+				switch(kind)
+				{
+					case kKindURL:
+					{
+						s = pHosts[Random() % 4];
+						const uint32_t nPartCount = 1 + (Random() % 3);
+						for(uint32_t p = 0; p < nPartCount; ++p)
+						{
+							const uint32_t nLength = 2 + (Random() % 8);
+							for(uint32_t c = 0; c < nLength; ++c)
+								s.pushBack((char)('a' + (Random() % 26)));
+							s.pushBack('/');
+						}
+						break;
+					}
+
+					case kKindShort:
+					{
+						const uint32_t nLength = 4 + (Random() % 12);
+						for(uint32_t c = 0; c < nLength; ++c)
+							s.pushBack((char)('a' + (Random() % 26)));
+						break;
+					}
+
+					case kKindBytes:
+					{
+						static const unsigned char kAlphabet[] = { 1, 'a', 'b', 0x7f, 0x80, 0xff };
+						const uint32_t nLength = Random() % 13;
+						for(uint32_t c = 0; c < nLength; ++c)
+							s.pushBack((char)kAlphabet[Random() % sizeof(kAlphabet)]);
+						break;
+					}
+
+					default:
+						s.assign((eastl_size_t)(i + 1), 'a');
+						break;
+				}
+
+				strings.pushBack(s);
+			}
+
+			for(size_t i = n; i > 1; --i) // Shuffle, as the nested strings are made in order.
+				eastl::swap(strings[(eastl_size_t)(i - 1)], strings[(eastl_size_t)(Random() % i)]);
+		}
+
+		struct c_string_less
+		{
+			bool operator()(const char* a, const char* b) const
+				{ return (strcmp(a, b) < 0); }
+		};
+
+
+		/////////////////////////////// the check
+
+		// Returns the number of sorts which gave a different order from sort and stableSort.
+		inline int RunStringSortCheck(size_t n, StringKind kind)
+		{
+			int            nErrorCount = 0;
+			vector<string> strings;
+			MakeStrings(strings, n, kind);
+
+			vector<string> expected(strings);
+			vector<string> actual(strings);
+			eastl::sort(expected.begin(), expected.end());
+
+			eastl::string_sort(actual.begin(), actual.end());
+			if(actual != expected)
+				++nErrorCount;
+
+			actual = strings;
+			eastl::string_stable_sort(actual.begin(), actual.end());
+			if(actual != expected)
+				++nErrorCount;
+
+			{
+				// Equal C strings are distinguishable by address, which shows whether the sort is stable.
+				vector<const char*> cStrings;
+				for(eastl_size_t i = 0; i < strings.size(); ++i)
+					cStrings.pushBack(strings[(eastl_size_t)(Random() % strings.size())].c_str());
+
+				vector<const char*> cExpected(cStrings);
+				vector<const char*> cActual(cStrings);
+				eastl::stableSort(cExpected.begin(), cExpected.end(), c_string_less());
+
+				eastl::string_stable_sort(cActual.begin(), cActual.end());
+				if(cActual != cExpected)
+					++nErrorCount;
+
+				cActual = cStrings;
+				eastl::string_sort(cActual.begin(), cActual.end());
+				for(eastl_size_t i = 0; i < cActual.size(); ++i)
+				{
+					if(strcmp(cActual[i], cExpected[i]) != 0)
+						{ ++nErrorCount; break; }
+				}
+			}
+
+			return nErrorCount;
+		}
+
+		inline int RunStringSortChecks()
+		{
+			// The sizes straddle the 16 string insertion sort limit and the 4096 string radix limit.
+			static const size_t kSizes[] = { 0, 1, 2, 15, 17, 100, 1000, 4095, 4096, 20000 };
+
+			int nErrorCount = 0;
+
+			for(int kind = 0; kind < kKindCount; ++kind)
+			{
+				for(size_t i = 0; i < EASTLArrayCount(kSizes); ++i)
+				{
+					const size_t n = ((kind == kKindNested) && (kSizes[i] > 8000)) ? 8000 : kSizes[i]; // Nested strings total n*n/2 bytes.
+					nErrorCount += RunStringSortCheck(n, (StringKind)kind);
+				}
+			}
+
+			return nErrorCount;
+		}
+
+
+		/////////////////////////////// the benchmark proper
+
+		// Returns the best of three times, in milliseconds, of sorting copies of strings with sortFunction.
+		template <typename T, typename SortFunction>
+		double TimeSort(const vector<T>& strings, SortFunction sortFunction)
+		{
+			uint64_t nBest = 0;
+
+			for(int iteration = 0; iteration < 3; ++iteration)
+			{
+				vector<T> v(strings);
+				const uint64_t t0 = GetMicroTime();
+				sortFunction(v);
+				const uint64_t t = GetMicroTime() - t0;
+				if((iteration == 0) || (t < nBest))
+					nBest = t;
+			}
+
+			return (double)nBest / 1000.0;
+		}
+
+		struct sort_function          { void operator()(vector<string>& v) const { eastl::sort(v.begin(), v.end()); } };
+		struct stable_sort_function   { void operator()(vector<string>& v) const { eastl::stableSort(v.begin(), v.end()); } };
+		struct string_sort_function   { void operator()(vector<string>& v) const { eastl::string_sort(v.begin(), v.end()); } };
+		struct string_stable_function { void operator()(vector<string>& v) const { eastl::string_stable_sort(v.begin(), v.end()); } };
+		struct c_sort_function        { void operator()(vector<const char*>& v) const { eastl::sort(v.begin(), v.end(), c_string_less()); } };
+		struct c_string_sort_function { void operator()(vector<const char*>& v) const { eastl::string_sort(v.begin(), v.end()); } };
+
+		inline void RunStringSortBenchmark(size_t n)
+		{
+			vector<string> strings;
+
+			printf("%u eastl::string, best of 3, ms:\n", (unsigned)n);
+			printf("                     sort   stableSort  string_sort  string_stable_sort\n");
+
+			MakeStrings(strings, n, kKindURL);
+			printf("URLs              %7.0f  %11.0f  %11.0f  %18.0f\n", TimeSort(strings, sort_function()), TimeSort(strings, stable_sort_function()),
+				   TimeSort(strings, string_sort_function()), TimeSort(strings, string_stable_function()));
+
+			vector<const char*> cStrings;
+			for(eastl_size_t i = 0; i < strings.size(); ++i)
+				cStrings.pushBack(strings[i].c_str());
+
+			const double fCSortTime       = TimeSort(cStrings, c_sort_function());
+			const double fCStringSortTime = TimeSort(cStrings, c_string_sort_function());
+
+			MakeStrings(strings, n, kKindShort);
+			printf("random 4-15 chars %7.0f  %11.0f  %11.0f  %18.0f\n", TimeSort(strings, sort_function()), TimeSort(strings, stable_sort_function()),
+				   TimeSort(strings, string_sort_function()), TimeSort(strings, string_stable_function()));
+
+			printf("const char* URLs: sort with strcmp %.0f, string_sort %.0f\n", fCSortTime, fCStringSortTime);
+		}
+
+	} // namespace string_sort_benchmark
+
+} // namespace eastl
+
+
+#if defined(STRING_SORT_BENCHMARK_MAIN)
+
+	#ifndef TEST_SIZE
+		#define TEST_SIZE 2000000
+	#endif
+
+	int main(int, char**)
+	{
+		using namespace eastl::string_sort_benchmark;
+
+		const int nErrorCount = RunStringSortChecks();
+		printf("string_sort check: %d errors\n", nErrorCount);
+
+		RunStringSortBenchmark(TEST_SIZE);
+
+		return nErrorCount ? 1 : 0;
+	}
+
+#endif
+
+#endif // Header include guard
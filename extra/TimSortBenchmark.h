@@ -0,0 +1,239 @@
+// Checks and times eastl::tim_sort_buffer on inputs with and without existing order.
+//
+// The inputs are random ints, presorted ints, descending runs of 1000 to 11000
+// elements, four distinct values, a sorted range with 1% random values appended,
+// and a sorted range with 1% of its values replaced at random positions. The last
+// two are where galloping pays: most of each merge is a block move.
+//
+// The check sorts each kind of input, at several sizes, as keys paired with their
+// original positions, and compares the result with stableSort's, which shows both
+// that the result is sorted and that tim_sort_buffer is stable.
+//
+// The benchmark prints the best of five times of tim_sort_buffer and of stableSort
+// on TEST_SIZE ints of each kind.
+//
+// To build it, compile a .cpp file which does:
+//     #define TIM_SORT_BENCHMARK_MAIN
+//     #include <eastl/extra/TimSortBenchmark.h>
+
+#ifndef EASTL_EXTRA_TIMSORTBENCHMARK_H
+#define EASTL_EXTRA_TIMSORTBENCHMARK_H
+
+#include <eastl/sort.h>
+#include <eastl/vector.h>
+#include <eastl/functional.h>
+#include <stdio.h>
+
+#ifdef WIN32
+	#include <windows.h>
+#else
+	#include <sys/time.h>
+#endif
+
+namespace eastl
+{
+	namespace tim_sort_benchmark
+	{
+		#ifdef WIN32
+			inline uint64_t GetMicroTime() { static uint64_t hz=0; static uint64_t hzo=0; if (!hz) { QueryPerformanceFrequency((LARGE_INTEGER*)&hz); QueryPerformanceCounter((LARGE_INTEGER*)&hzo); } uint64_t t; QueryPerformanceCounter((LARGE_INTEGER*)&t); return ((t-hzo)*1000000)/hz; }
+		#else
+			inline uint64_t GetMicroTime() { timeval t;gettimeofday(&t,NULL); return t.tv_sec * 1000000ull + t.tv_usec; }
+		#endif
+
+		inline uint32_t Random()
+		{
+			static uint32_t nSeed = 1;
+			nSeed = (nSeed * 1103515245) + 12345;
+			return nSeed >> 8;
+		}
+
+		enum InputKind
+		{
+			kInputRandom,
+			kInputPresorted,
+			kInputReverseRuns,
+			kInputFewUnique,
+			kInputAppended,
+			kInputScattered,
+			kInputCount
+		};
+
+		inline const char* GetInputName(InputKind kind)
+		{
+			static const char* const pNames[kInputCount] = { "random", "presorted", "reverse runs", "4 unique values", "sorted + 1% appended", "sorted + 1% scattered" };
+			return pNames[kind];
+		}
+
+		inline void MakeInput(vector<int>& v, size_t n, InputKind kind)
+		{
+			v.resize((eastl_size_t)n);
+
+			for(size_t i = 0; i < n; ++i)
+				v[(eastl_size_t)i] = (int)Random();
+
+			switch(kind)
+			{
+				case kInputPresorted:
+					eastl::sort(v.begin(), v.end());
+					break;
+
+				case kInputReverseRuns:
+					for(size_t p = 0; p < n; )
+					{
+						size_t nRun = 1000 + (Random() % 10000);
+						if(nRun > (n - p))
+							nRun = n - p;
+						eastl::sort(v.begin() + (ptrdiff_t)p, v.begin() + (ptrdiff_t)(p + nRun), eastl::greater<int>());
+						p += nRun;
+					}
+					break;
+
+				case kInputFewUnique:
+					for(size_t i = 0; i < n; ++i)
+						v[(eastl_size_t)i] &= 3;
+					break;
+
+				case kInputAppended:
+					eastl::sort(v.begin(), v.begin() + (ptrdiff_t)(n - (n / 100)));
+					break;
+
+				case kInputScattered:
+					eastl::sort(v.begin(), v.end());
+					for(size_t i = 0; i < (n / 100); ++i)
+						v[(eastl_size_t)(Random() % n)] = (int)Random();
+					break;
+
+				default:
+					break;
+			}
+		}
+
+
+		/////////////////////////////// the check
+
+		struct keyed_index
+		{
+			int      mnKey;
+			uint32_t mnIndex;
+
+			bool operator==(const keyed_index& x) const
+				{ return (mnKey == x.mnKey) && (mnIndex == x.mnIndex); }
+		};
+
+		struct key_less
+		{
+			bool operator()(const keyed_index& a, const keyed_index& b) const
+				{ return (a.mnKey < b.mnKey); }
+		};
+
+		// Returns the number of inputs which tim_sort_buffer didn't sort as stableSort did.
+		inline int RunTimSortCheck()
+		{
+			static const size_t kSizes[] = { 0, 1, 63, 64, 65, 1000, 20000, 200000 };
+
+			int                 nErrorCount = 0;
+			vector<int>         keys;
+			vector<keyed_index> expected, actual, buffer;
+
+			for(int kind = 0; kind < kInputCount; ++kind)
+			{
+				for(size_t s = 0; s < EASTLArrayCount(kSizes); ++s)
+				{
+					const size_t n = kSizes[s];
+					MakeInput(keys, n, (InputKind)kind);
+
+					if(kind == kInputRandom) // Give the random input repeated keys too, so stability is tested.
+					{
+						for(size_t i = 0; i < n; ++i)
+							keys[(eastl_size_t)i] %= 1000;
+					}
+
+					expected.resize((eastl_size_t)n);
+					for(size_t i = 0; i < n; ++i)
+					{
+						expected[(eastl_size_t)i].mnKey   = keys[(eastl_size_t)i];
+						expected[(eastl_size_t)i].mnIndex = (uint32_t)i;
+					}
+
+					actual = expected;
+					buffer.resize((eastl_size_t)((n / 2) + 1));
+
+					eastl::stableSort(expected.begin(), expected.end(), key_less());
+					eastl::tim_sort_buffer(actual.begin(), actual.end(), buffer.data(), key_less());
+
+					if(actual != expected)
+					{
+						printf("tim_sort_buffer differs from stableSort: %s, n = %u\n", GetInputName((InputKind)kind), (unsigned)n);
+						++nErrorCount;
+					}
+				}
+			}
+
+			return nErrorCount;
+		}
+
+
+		/////////////////////////////// the benchmark proper
+
+		inline void RunTimSortBenchmark(size_t n)
+		{
+			vector<int> input, v, buffer((eastl_size_t)((n / 2) + 1));
+
+			printf("%u ints, best of 5, ms:\n", (unsigned)n);
+			printf("                        tim_sort_buffer  stableSort\n");
+
+			for(int kind = 0; kind < kInputCount; ++kind)
+			{
+				MakeInput(input, n, (InputKind)kind);
+
+				uint64_t nTimBest = 0, nStableBest = 0;
+
+				for(int iteration = 0; iteration < 5; ++iteration)
+				{
+					v = input;
+					uint64_t t0 = GetMicroTime();
+					eastl::tim_sort_buffer(v.begin(), v.end(), buffer.data());
+					uint64_t t = GetMicroTime() - t0;
+					if((iteration == 0) || (t < nTimBest))
+						nTimBest = t;
+
+					EASTL_ASSERT(eastl::isSorted(v.begin(), v.end()));
+
+					v = input;
+					t0 = GetMicroTime();
+					eastl::stableSort(v.begin(), v.end());
+					t = GetMicroTime() - t0;
+					if((iteration == 0) || (t < nStableBest))
+						nStableBest = t;
+				}
+
+				printf("%-22s  %15.2f  %10.2f\n", GetInputName((InputKind)kind), (double)nTimBest / 1000.0, (double)nStableBest / 1000.0);
+			}
+		}
+
+	} // namespace tim_sort_benchmark
+
+} // namespace eastl
+
+
+#if defined(TIM_SORT_BENCHMARK_MAIN)
+
+	#ifndef TEST_SIZE
+		#define TEST_SIZE 1000000
+	#endif
+
+	int main(int, char**)
+	{
+		using namespace eastl::tim_sort_benchmark;
+
+		const int nErrorCount = RunTimSortCheck();
+		printf("tim_sort_buffer check: %d errors\n", nErrorCount);
+
+		RunTimSortBenchmark(TEST_SIZE);
+
+		return nErrorCount ? 1 : 0;
+	}
+
+#endif
+
+#endif // Header include guard
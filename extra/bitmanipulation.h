@@ -2,6 +2,8 @@
 #ifndef EASTL_EXTRA_BITMANIPULATION_H_
 #define EASTL_EXTRA_BITMANIPULATION_H_
 
+#include <eastl/bit.h>
+
 namespace eastl {
    /*
    #define STR_ME( X ) ( # X )
@@ -87,15 +89,7 @@ namespace eastl {
    }
 
    inline int reverseBits(unsigned int x) {
-      unsigned int y = 0x55555555;
-      x = (((x >> 1) & y) | ((x & y) << 1));
-      y = 0x33333333;
-      x = (((x >> 2) & y) | ((x & y) << 2));
-      y = 0x0f0f0f0f;
-      x = (((x >> 4) & y) | ((x & y) << 4));
-      y = 0x00ff00ff;
-      x = (((x >> 8) & y) | ((x & y) << 8));
-      return((x >> 16) | (x << 16));
+      return (int)bit_reverse(x);
    }
 
    inline bool isPowerOf2(const int number) {
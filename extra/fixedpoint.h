@@ -91,14 +91,14 @@ public:
       mValue -= val.mValue;
       return *this;
    }
+   //rounds to nearest, halves up (same as FixedVec4/FixedVec8)
    FixedPoint operator*(FixedPoint val) {
-      NormalType result = (NormalType)(((MulType)mValue*val.mValue) << fractBits);
       FixedPoint ret;
-      ret.mValue = result;
+      ret.mValue = internalMul(mValue, val.mValue);
       return ret;
    }
    FixedPoint &operator*=(FixedPoint val) {
-      mValue = (NormalType)(((MulType)mValue*val.mValue) << fractBits);
+      mValue = internalMul(mValue, val.mValue);
       return *this;
    }
    FixedPoint operator*(NormalType val) {
@@ -122,7 +122,21 @@ protected:
    NormalType internalDiv(NormalType val1, NormalType val2) {
       return (NormalType)(((MulType)val1 << fractBits)/(MulType)val2);
    }
+   static NormalType internalMul(NormalType val1, NormalType val2) {
+      //the rounding term is half an ulp, written so that it's 0 rather than undefined when fractBits is 0
+      return (NormalType)(((MulType)val1*val2 + (((MulType)1 << fractBits) >> 1)) >> fractBits);
+   }
 public:
+   //the fixed-point representation, e.g. for handing values to FixedVec4/FixedVec8
+   NormalType raw() const {
+      return mValue;
+   }
+   static FixedPoint fromRaw(NormalType raw) {
+      FixedPoint ret;
+      ret.mValue = raw;
+      return ret;
+   }
+
    eastl::string convertToStr() {
       char tmp[32];
       char *ptr = &tmp[0];
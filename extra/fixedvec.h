@@ -0,0 +1,664 @@
+/*  _______         __
+   |_     _|.-----.|  |_.-----.----.
+    _|   |_ |     ||   _|  -__|   _|
+   |_______||__|__||____|_____|__|
+       coded by Questor / Inter      */
+
+/* Packed fixed-point vectors: FixedVec4 holds four and FixedVec8 eight 32 bit
+ * fixed-point values with fractBits fractional bits, laid out exactly like an
+ * array of FixedPoint<int32_t, int64_t, fractBits>.
+ *
+ * Every operation gives the same bits on every machine and code path (scalar,
+ * SSE2, SSE4.1, AVX2), so they can be used for lockstep simulations:
+ *  - add/sub/shifts wrap around like two's complement int32_t
+ *  - mul rounds to nearest (halves up) like FixedPoint::operator*
+ *  - addSat/subSat/mulSat clamp to the representable range
+ *  - rcp/sqrt are computed via IEEE single precision division and square
+ *    root, which are correctly rounded, and are exact to ~24 bits. The
+ *    approximate rcpps/rsqrtps instructions are deliberately not used as they
+ *    differ between CPU vendors. The scalar path relies on float math being
+ *    done in single precision (FLT_EVAL_METHOD == 0, i.e. SSE and not x87).
+ *
+ * FixedVec8 uses AVX2 when it is enabled and two FixedVec4 otherwise.
+ *
+ * Example usage:
+ *   eastl::vector<FixedPoint32> pos, vel;
+ *   ...
+ *   fixedTransform(pos.begin(), pos.end(), vel.begin(), pos.begin(), Integrate(dt));
+ *   //with struct Integrate { FixedPoint32x8 dt; FixedPoint32x8 operator()(FixedPoint32x8 p, FixedPoint32x8 v) const { return p + v*dt; } };
+ */
+
+#ifndef __EASTL_EXTRAS_FIXEDVEC_H__
+#define __EASTL_EXTRAS_FIXEDVEC_H__
+
+#include <math.h>
+#include <string.h>
+#include "eastl/types.h"
+#include "fixedpoint.h"
+
+#if EASTL_SSE2
+   #include <emmintrin.h>
+#endif
+#if EASTL_SSE4_1
+   #include <smmintrin.h>
+#endif
+#if EA_AVX2
+   #include <immintrin.h>
+#endif
+
+namespace eastl {
+
+namespace Internal {
+   //scalar reference versions of the lane operations, used by the non-SIMD paths
+   template<int fractBits> inline int32_t fixedMul(int32_t a, int32_t b) {
+      return (int32_t)(((int64_t)a*b + (((int64_t)1 << fractBits) >> 1)) >> fractBits);
+   }
+   inline int32_t fixedClamp(int64_t v) {
+      return v > INT32_MAX ? INT32_MAX : (v < INT32_MIN ? INT32_MIN : (int32_t)v);
+   }
+   template<int fractBits> inline int32_t fixedMulSat(int32_t a, int32_t b) {
+      return fixedClamp(((int64_t)a*b + (((int64_t)1 << fractBits) >> 1)) >> fractBits);
+   }
+   inline int32_t fixedFloatToRaw(float v) {
+      //same clamping as the SIMD versions; 2147483520 is the largest float below 2^31
+      v = v < -2147483648.0f ? -2147483648.0f : (v > 2147483520.0f ? 2147483520.0f : v);
+      return (int32_t)v;
+   }
+   template<int fractBits> inline int32_t fixedRcp(int32_t a) {
+      return fixedFloatToRaw((float)((uint64_t)1 << (2*fractBits)) / (float)a);
+   }
+   template<int fractBits> inline int32_t fixedSqrt(int32_t a) {
+      return a <= 0 ? 0 : (int32_t)sqrtf((float)a * (float)(1 << fractBits));
+   }
+   template<int fractBits> inline int32_t fixedFromFloat(float v) {
+      //same as FixedPoint::set(float)
+      v *= (float)(1 << fractBits);
+      v += (v >= 0) ? 0.5f : -0.5f;
+      return fixedFloatToRaw(v);
+   }
+
+   #if EASTL_SSE2
+      //signed 32x32->64 bit products of lanes 0 and 2
+      inline __m128i fixedMulEven(__m128i a, __m128i b) {
+         #if EASTL_SSE4_1
+            return _mm_mul_epi32(a, b);
+         #else
+            //unsigned product minus the corrections for negative factors
+            const __m128i corr = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b), _mm_and_si128(_mm_srai_epi32(b, 31), a));
+            return _mm_sub_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(corr, 32));
+         #endif
+      }
+      inline __m128i fixedMullo(__m128i a, __m128i b) {
+         #if EASTL_SSE4_1
+            return _mm_mullo_epi32(a, b);
+         #else
+            const __m128i even = _mm_mul_epu32(a, b);
+            const __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+         #endif
+      }
+      inline __m128i fixedSelect(__m128i mask, __m128i a, __m128i b) {
+         return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+      }
+      inline __m128i fixedFloatToRaw(__m128 v) {
+         v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-2147483648.0f)), _mm_set1_ps(2147483520.0f));
+         return _mm_cvttps_epi32(v);
+      }
+   #endif
+}
+
+template<int fractBits> class FixedVec8;
+
+template<int fractBits> class FixedVec4 {
+   //the SIMD multiplies round with a shift by fractBits-1
+   static_assert(fractBits > 0 && fractBits < 32, "FixedVec4: fractBits must be in [1, 31].");
+public:
+   typedef FixedPoint<int32_t, int64_t, fractBits> FixedType;
+   enum { kSize = 4 };
+
+   FixedVec4() {}
+
+   explicit FixedVec4(FixedType val) {
+      #if EASTL_SSE2
+         mValue = _mm_set1_epi32(val.raw());
+      #else
+         mValue[0] = mValue[1] = mValue[2] = mValue[3] = val.raw();
+      #endif
+   }
+
+   FixedVec4(FixedType v0, FixedType v1, FixedType v2, FixedType v3) {
+      #if EASTL_SSE2
+         mValue = _mm_setr_epi32(v0.raw(), v1.raw(), v2.raw(), v3.raw());
+      #else
+         mValue[0] = v0.raw(); mValue[1] = v1.raw(); mValue[2] = v2.raw(); mValue[3] = v3.raw();
+      #endif
+   }
+
+   //loads and stores; the pointers need not be aligned
+   static FixedVec4 loadRaw(const int32_t *p) {
+      FixedVec4 ret;
+      #if EASTL_SSE2
+         ret.mValue = _mm_loadu_si128((const __m128i*)p);
+      #else
+         memcpy(ret.mValue, p, sizeof(ret.mValue));
+      #endif
+      return ret;
+   }
+   void storeRaw(int32_t *p) const {
+      #if EASTL_SSE2
+         _mm_storeu_si128((__m128i*)p, mValue);
+      #else
+         memcpy(p, mValue, sizeof(mValue));
+      #endif
+   }
+   static FixedVec4 load(const FixedType *p) {
+      return loadRaw((const int32_t*)p);
+   }
+   void store(FixedType *p) const {
+      storeRaw((int32_t*)p);
+   }
+   //n < 4 values, the others are zero
+   static FixedVec4 loadPartial(const FixedType *p, uint32_t n) {
+      int32_t tmp[4] = { 0, 0, 0, 0 };
+      memcpy(tmp, p, n * sizeof(int32_t));
+      return loadRaw(tmp);
+   }
+   void storePartial(FixedType *p, uint32_t n) const {
+      int32_t tmp[4];
+      storeRaw(tmp);
+      memcpy((void*)p, tmp, n * sizeof(int32_t));
+   }
+
+   //conversion from/to float, rounding like FixedPoint::set(float)
+   static FixedVec4 loadFloat(const float *p) {
+      FixedVec4 ret;
+      #if EASTL_SSE2
+         __m128 v = _mm_mul_ps(_mm_loadu_ps(p), _mm_set1_ps((float)(1 << fractBits)));
+         const __m128 half = _mm_or_ps(_mm_set1_ps(0.5f), _mm_and_ps(v, _mm_set1_ps(-0.0f)));
+         ret.mValue = Internal::fixedFloatToRaw(_mm_add_ps(v, half));
+      #else
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = Internal::fixedFromFloat<fractBits>(p[i]);
+      #endif
+      return ret;
+   }
+   void storeFloat(float *p) const {
+      #if EASTL_SSE2
+         _mm_storeu_ps(p, _mm_mul_ps(_mm_cvtepi32_ps(mValue), _mm_set1_ps(1.0f / (float)(1 << fractBits))));
+      #else
+         for(int i = 0; i < 4; i++)
+            p[i] = (float)mValue[i] * (1.0f / (float)(1 << fractBits));
+      #endif
+   }
+
+   FixedType operator[](int i) const {
+      int32_t tmp[4];
+      storeRaw(tmp);
+      return FixedType::fromRaw(tmp[i]);
+   }
+
+   FixedVec4 operator+(FixedVec4 val) const {
+      #if EASTL_SSE2
+         return make(_mm_add_epi32(mValue, val.mValue));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = (int32_t)((uint32_t)mValue[i] + (uint32_t)val.mValue[i]);
+         return ret;
+      #endif
+   }
+   FixedVec4 operator-(FixedVec4 val) const {
+      #if EASTL_SSE2
+         return make(_mm_sub_epi32(mValue, val.mValue));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = (int32_t)((uint32_t)mValue[i] - (uint32_t)val.mValue[i]);
+         return ret;
+      #endif
+   }
+   FixedVec4 operator-() const {
+      return FixedVec4(FixedType::fromRaw(0)) - *this;
+   }
+
+   FixedVec4 operator*(FixedVec4 val) const {
+      #if EASTL_SSE2
+         const __m128i round = _mm_set1_epi64x((int64_t)1 << (fractBits-1));
+         const __m128i even  = _mm_srli_epi64(_mm_add_epi64(Internal::fixedMulEven(mValue, val.mValue), round), fractBits);
+         const __m128i odd   = _mm_srli_epi64(_mm_add_epi64(Internal::fixedMulEven(_mm_srli_epi64(mValue, 32), _mm_srli_epi64(val.mValue, 32)), round), fractBits);
+         return make(_mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0))));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = Internal::fixedMul<fractBits>(mValue[i], val.mValue[i]);
+         return ret;
+      #endif
+   }
+   //multiplication by an integer, wraps around
+   FixedVec4 operator*(int32_t val) const {
+      #if EASTL_SSE2
+         return make(Internal::fixedMullo(mValue, _mm_set1_epi32(val)));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = (int32_t)((uint32_t)mValue[i] * (uint32_t)val);
+         return ret;
+      #endif
+   }
+
+   //arithmetic shifts of the raw values
+   FixedVec4 operator<<(int n) const {
+      #if EASTL_SSE2
+         return make(_mm_sll_epi32(mValue, _mm_cvtsi32_si128(n)));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = (int32_t)((uint32_t)mValue[i] << n);
+         return ret;
+      #endif
+   }
+   FixedVec4 operator>>(int n) const {
+      #if EASTL_SSE2
+         return make(_mm_sra_epi32(mValue, _mm_cvtsi32_si128(n)));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = mValue[i] >> n;
+         return ret;
+      #endif
+   }
+   //shift right by n >= 1, rounding to nearest (halves up)
+   FixedVec4 shrRound(int n) const {
+      return (*this + fromRawValue(1 << (n-1))) >> n;
+   }
+
+   FixedVec4 &operator+=(FixedVec4 val) { return *this = *this + val; }
+   FixedVec4 &operator-=(FixedVec4 val) { return *this = *this - val; }
+   FixedVec4 &operator*=(FixedVec4 val) { return *this = *this * val; }
+   FixedVec4 &operator*=(int32_t val)   { return *this = *this * val; }
+   FixedVec4 &operator<<=(int n)        { return *this = *this << n; }
+   FixedVec4 &operator>>=(int n)        { return *this = *this >> n; }
+
+   bool operator==(FixedVec4 val) const {
+      #if EASTL_SSE2
+         return _mm_movemask_epi8(_mm_cmpeq_epi32(mValue, val.mValue)) == 0xffff;
+      #else
+         return memcmp(mValue, val.mValue, sizeof(mValue)) == 0;
+      #endif
+   }
+   bool operator!=(FixedVec4 val) const {
+      return !(*this == val);
+   }
+
+   //saturating versions
+   FixedVec4 addSat(FixedVec4 val) const {
+      #if EASTL_SSE2
+         //overflow iff both operands have a sign different from the wrapped sum
+         const __m128i sum = _mm_add_epi32(mValue, val.mValue);
+         const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(mValue, sum), _mm_xor_si128(val.mValue, sum)), 31);
+         const __m128i sat = _mm_xor_si128(_mm_srai_epi32(mValue, 31), _mm_set1_epi32(INT32_MAX));
+         return make(Internal::fixedSelect(overflow, sat, sum));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = Internal::fixedClamp((int64_t)mValue[i] + val.mValue[i]);
+         return ret;
+      #endif
+   }
+   FixedVec4 subSat(FixedVec4 val) const {
+      #if EASTL_SSE2
+         const __m128i diff = _mm_sub_epi32(mValue, val.mValue);
+         const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(mValue, val.mValue), _mm_xor_si128(mValue, diff)), 31);
+         const __m128i sat = _mm_xor_si128(_mm_srai_epi32(mValue, 31), _mm_set1_epi32(INT32_MAX));
+         return make(Internal::fixedSelect(overflow, sat, diff));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = Internal::fixedClamp((int64_t)mValue[i] - val.mValue[i]);
+         return ret;
+      #endif
+   }
+   FixedVec4 mulSat(FixedVec4 val) const {
+      #if EASTL_SSE2
+         const __m128i round = _mm_set1_epi64x((int64_t)1 << (fractBits-1));
+         const __m128i even  = _mm_add_epi64(Internal::fixedMulEven(mValue, val.mValue), round);
+         const __m128i odd   = _mm_add_epi64(Internal::fixedMulEven(_mm_srli_epi64(mValue, 32), _mm_srli_epi64(val.mValue, 32)), round);
+         const __m128i lo = _mm_unpacklo_epi32(_mm_shuffle_epi32(_mm_srli_epi64(even, fractBits), _MM_SHUFFLE(0,0,2,0)),
+                                               _mm_shuffle_epi32(_mm_srli_epi64(odd, fractBits), _MM_SHUFFLE(0,0,2,0)));
+         //the upper halves of the products; the result fits iff their bits from fractBits-1 up are all equal
+         const __m128i hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,3,1)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,3,1)));
+         const __m128i sign = _mm_srai_epi32(hi, 31);
+         const __m128i fits = _mm_cmpeq_epi32(_mm_srai_epi32(hi, fractBits-1), sign);
+         return make(Internal::fixedSelect(fits, lo, _mm_xor_si128(sign, _mm_set1_epi32(INT32_MAX))));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = Internal::fixedMulSat<fractBits>(mValue[i], val.mValue[i]);
+         return ret;
+      #endif
+   }
+
+   FixedVec4 min(FixedVec4 val) const {
+      #if EASTL_SSE4_1
+         return make(_mm_min_epi32(mValue, val.mValue));
+      #elif EASTL_SSE2
+         return make(Internal::fixedSelect(_mm_cmpgt_epi32(mValue, val.mValue), val.mValue, mValue));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = mValue[i] > val.mValue[i] ? val.mValue[i] : mValue[i];
+         return ret;
+      #endif
+   }
+   FixedVec4 max(FixedVec4 val) const {
+      #if EASTL_SSE4_1
+         return make(_mm_max_epi32(mValue, val.mValue));
+      #elif EASTL_SSE2
+         return make(Internal::fixedSelect(_mm_cmpgt_epi32(mValue, val.mValue), mValue, val.mValue));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = mValue[i] > val.mValue[i] ? mValue[i] : val.mValue[i];
+         return ret;
+      #endif
+   }
+   //abs of the most negative value wraps around to itself, as for int32_t
+   FixedVec4 abs() const {
+      #if EASTL_SSE2
+         const __m128i sign = _mm_srai_epi32(mValue, 31);
+         return make(_mm_sub_epi32(_mm_xor_si128(mValue, sign), sign));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = mValue[i] < 0 ? (int32_t)(0u - (uint32_t)mValue[i]) : mValue[i];
+         return ret;
+      #endif
+   }
+
+   //1/x, clamped to the representable range (1/0 gives the maximum)
+   FixedVec4 rcp() const {
+      #if EASTL_SSE2
+         const __m128 one = _mm_set1_ps((float)((uint64_t)1 << (2*fractBits)));
+         return make(Internal::fixedFloatToRaw(_mm_div_ps(one, _mm_cvtepi32_ps(mValue))));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = Internal::fixedRcp<fractBits>(mValue[i]);
+         return ret;
+      #endif
+   }
+   //square root, 0 for negative values
+   FixedVec4 sqrt() const {
+      #if EASTL_SSE2
+         const __m128 v = _mm_max_ps(_mm_cvtepi32_ps(mValue), _mm_setzero_ps());
+         return make(_mm_cvttps_epi32(_mm_sqrt_ps(_mm_mul_ps(v, _mm_set1_ps((float)(1 << fractBits))))));
+      #else
+         FixedVec4 ret;
+         for(int i = 0; i < 4; i++)
+            ret.mValue[i] = Internal::fixedSqrt<fractBits>(mValue[i]);
+         return ret;
+      #endif
+   }
+
+protected:
+   friend class FixedVec8<fractBits>;
+
+   static FixedVec4 fromRawValue(int32_t raw) {
+      return FixedVec4(FixedType::fromRaw(raw));
+   }
+
+   #if EASTL_SSE2
+      static FixedVec4 make(__m128i v) {
+         FixedVec4 ret;
+         ret.mValue = v;
+         return ret;
+      }
+
+      __m128i mValue;
+   #else
+      int32_t mValue[4];
+   #endif
+
+   EASTL_CT_ASSERT(fractBits >= 1 && fractBits <= 30);
+   EASTL_CT_ASSERT(sizeof(FixedType) == sizeof(int32_t));
+};
+
+
+template<int fractBits> class FixedVec8 {
+   static_assert(fractBits > 0 && fractBits < 32, "FixedVec8: fractBits must be in [1, 31].");
+public:
+   typedef FixedPoint<int32_t, int64_t, fractBits> FixedType;
+   typedef FixedVec4<fractBits> half_type;
+   enum { kSize = 8 };
+
+   FixedVec8() {}
+
+   explicit FixedVec8(FixedType val) {
+      #if EA_AVX2
+         mValue = _mm256_set1_epi32(val.raw());
+      #else
+         mLo = mHi = half_type(val);
+      #endif
+   }
+
+   FixedVec8(half_type lo, half_type hi) {
+      #if EA_AVX2
+         mValue = _mm256_inserti128_si256(_mm256_castsi128_si256(lo.mValue), hi.mValue, 1);
+      #else
+         mLo = lo;
+         mHi = hi;
+      #endif
+   }
+
+   half_type lo() const {
+      #if EA_AVX2
+         return half_type::make(_mm256_castsi256_si128(mValue));
+      #else
+         return mLo;
+      #endif
+   }
+   half_type hi() const {
+      #if EA_AVX2
+         return half_type::make(_mm256_extracti128_si256(mValue, 1));
+      #else
+         return mHi;
+      #endif
+   }
+
+   static FixedVec8 loadRaw(const int32_t *p) {
+      #if EA_AVX2
+         return make(_mm256_loadu_si256((const __m256i*)p));
+      #else
+         return FixedVec8(half_type::loadRaw(p), half_type::loadRaw(p + 4));
+      #endif
+   }
+   void storeRaw(int32_t *p) const {
+      #if EA_AVX2
+         _mm256_storeu_si256((__m256i*)p, mValue);
+      #else
+         mLo.storeRaw(p);
+         mHi.storeRaw(p + 4);
+      #endif
+   }
+   static FixedVec8 load(const FixedType *p) {
+      return loadRaw((const int32_t*)p);
+   }
+   void store(FixedType *p) const {
+      storeRaw((int32_t*)p);
+   }
+   static FixedVec8 loadPartial(const FixedType *p, uint32_t n) {
+      int32_t tmp[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+      memcpy(tmp, p, n * sizeof(int32_t));
+      return loadRaw(tmp);
+   }
+   void storePartial(FixedType *p, uint32_t n) const {
+      int32_t tmp[8];
+      storeRaw(tmp);
+      memcpy((void*)p, tmp, n * sizeof(int32_t));
+   }
+   static FixedVec8 loadFloat(const float *p) {
+      #if EA_AVX2
+         __m256 v = _mm256_mul_ps(_mm256_loadu_ps(p), _mm256_set1_ps((float)(1 << fractBits)));
+         const __m256 half = _mm256_or_ps(_mm256_set1_ps(0.5f), _mm256_and_ps(v, _mm256_set1_ps(-0.0f)));
+         return make(floatToRaw(_mm256_add_ps(v, half)));
+      #else
+         return FixedVec8(half_type::loadFloat(p), half_type::loadFloat(p + 4));
+      #endif
+   }
+   void storeFloat(float *p) const {
+      #if EA_AVX2
+         _mm256_storeu_ps(p, _mm256_mul_ps(_mm256_cvtepi32_ps(mValue), _mm256_set1_ps(1.0f / (float)(1 << fractBits))));
+      #else
+         mLo.storeFloat(p);
+         mHi.storeFloat(p + 4);
+      #endif
+   }
+
+   FixedType operator[](int i) const {
+      int32_t tmp[8];
+      storeRaw(tmp);
+      return FixedType::fromRaw(tmp[i]);
+   }
+
+   #if EA_AVX2
+      FixedVec8 operator+(FixedVec8 val) const { return make(_mm256_add_epi32(mValue, val.mValue)); }
+      FixedVec8 operator-(FixedVec8 val) const { return make(_mm256_sub_epi32(mValue, val.mValue)); }
+      FixedVec8 operator*(int32_t val) const   { return make(_mm256_mullo_epi32(mValue, _mm256_set1_epi32(val))); }
+      FixedVec8 operator<<(int n) const        { return make(_mm256_sll_epi32(mValue, _mm_cvtsi32_si128(n))); }
+      FixedVec8 operator>>(int n) const        { return make(_mm256_sra_epi32(mValue, _mm_cvtsi32_si128(n))); }
+      FixedVec8 min(FixedVec8 val) const       { return make(_mm256_min_epi32(mValue, val.mValue)); }
+      FixedVec8 max(FixedVec8 val) const       { return make(_mm256_max_epi32(mValue, val.mValue)); }
+      FixedVec8 abs() const                    { return make(_mm256_abs_epi32(mValue)); }
+
+      bool operator==(FixedVec8 val) const {
+         return _mm256_movemask_epi8(_mm256_cmpeq_epi32(mValue, val.mValue)) == -1;
+      }
+
+      FixedVec8 operator*(FixedVec8 val) const {
+         const __m256i round = _mm256_set1_epi64x((int64_t)1 << (fractBits-1));
+         const __m256i even  = _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epi32(mValue, val.mValue), round), fractBits);
+         const __m256i odd   = _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(mValue, 32), _mm256_srli_epi64(val.mValue, 32)), round), fractBits);
+         return make(_mm256_unpacklo_epi32(_mm256_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm256_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0))));
+      }
+
+      FixedVec8 addSat(FixedVec8 val) const {
+         const __m256i sum = _mm256_add_epi32(mValue, val.mValue);
+         const __m256i overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(mValue, sum), _mm256_xor_si256(val.mValue, sum)), 31);
+         const __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(mValue, 31), _mm256_set1_epi32(INT32_MAX));
+         return make(_mm256_blendv_epi8(sum, sat, overflow));
+      }
+      FixedVec8 subSat(FixedVec8 val) const {
+         const __m256i diff = _mm256_sub_epi32(mValue, val.mValue);
+         const __m256i overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(mValue, val.mValue), _mm256_xor_si256(mValue, diff)), 31);
+         const __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(mValue, 31), _mm256_set1_epi32(INT32_MAX));
+         return make(_mm256_blendv_epi8(diff, sat, overflow));
+      }
+      FixedVec8 mulSat(FixedVec8 val) const {
+         const __m256i round = _mm256_set1_epi64x((int64_t)1 << (fractBits-1));
+         const __m256i even  = _mm256_add_epi64(_mm256_mul_epi32(mValue, val.mValue), round);
+         const __m256i odd   = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(mValue, 32), _mm256_srli_epi64(val.mValue, 32)), round);
+         const __m256i lo = _mm256_unpacklo_epi32(_mm256_shuffle_epi32(_mm256_srli_epi64(even, fractBits), _MM_SHUFFLE(0,0,2,0)),
+                                                  _mm256_shuffle_epi32(_mm256_srli_epi64(odd, fractBits), _MM_SHUFFLE(0,0,2,0)));
+         const __m256i hi = _mm256_unpacklo_epi32(_mm256_shuffle_epi32(even, _MM_SHUFFLE(0,0,3,1)), _mm256_shuffle_epi32(odd, _MM_SHUFFLE(0,0,3,1)));
+         const __m256i sign = _mm256_srai_epi32(hi, 31);
+         const __m256i fits = _mm256_cmpeq_epi32(_mm256_srai_epi32(hi, fractBits-1), sign);
+         return make(_mm256_blendv_epi8(_mm256_xor_si256(sign, _mm256_set1_epi32(INT32_MAX)), lo, fits));
+      }
+
+      FixedVec8 rcp() const {
+         const __m256 one = _mm256_set1_ps((float)((uint64_t)1 << (2*fractBits)));
+         return make(floatToRaw(_mm256_div_ps(one, _mm256_cvtepi32_ps(mValue))));
+      }
+      FixedVec8 sqrt() const {
+         const __m256 v = _mm256_max_ps(_mm256_cvtepi32_ps(mValue), _mm256_setzero_ps());
+         return make(_mm256_cvttps_epi32(_mm256_sqrt_ps(_mm256_mul_ps(v, _mm256_set1_ps((float)(1 << fractBits))))));
+      }
+   #else
+      FixedVec8 operator+(FixedVec8 val) const { return FixedVec8(mLo + val.mLo, mHi + val.mHi); }
+      FixedVec8 operator-(FixedVec8 val) const { return FixedVec8(mLo - val.mLo, mHi - val.mHi); }
+      FixedVec8 operator*(FixedVec8 val) const { return FixedVec8(mLo * val.mLo, mHi * val.mHi); }
+      FixedVec8 operator*(int32_t val) const   { return FixedVec8(mLo * val, mHi * val); }
+      FixedVec8 operator<<(int n) const        { return FixedVec8(mLo << n, mHi << n); }
+      FixedVec8 operator>>(int n) const        { return FixedVec8(mLo >> n, mHi >> n); }
+      FixedVec8 addSat(FixedVec8 val) const    { return FixedVec8(mLo.addSat(val.mLo), mHi.addSat(val.mHi)); }
+      FixedVec8 subSat(FixedVec8 val) const    { return FixedVec8(mLo.subSat(val.mLo), mHi.subSat(val.mHi)); }
+      FixedVec8 mulSat(FixedVec8 val) const    { return FixedVec8(mLo.mulSat(val.mLo), mHi.mulSat(val.mHi)); }
+      FixedVec8 min(FixedVec8 val) const       { return FixedVec8(mLo.min(val.mLo), mHi.min(val.mHi)); }
+      FixedVec8 max(FixedVec8 val) const       { return FixedVec8(mLo.max(val.mLo), mHi.max(val.mHi)); }
+      FixedVec8 abs() const                    { return FixedVec8(mLo.abs(), mHi.abs()); }
+      FixedVec8 rcp() const                    { return FixedVec8(mLo.rcp(), mHi.rcp()); }
+      FixedVec8 sqrt() const                   { return FixedVec8(mLo.sqrt(), mHi.sqrt()); }
+
+      bool operator==(FixedVec8 val) const {
+         return mLo == val.mLo && mHi == val.mHi;
+      }
+   #endif
+
+   FixedVec8 operator-() const {
+      return FixedVec8(FixedType::fromRaw(0)) - *this;
+   }
+   FixedVec8 shrRound(int n) const {
+      return (*this + FixedVec8(FixedType::fromRaw(1 << (n-1)))) >> n;
+   }
+   bool operator!=(FixedVec8 val) const {
+      return !(*this == val);
+   }
+
+   FixedVec8 &operator+=(FixedVec8 val) { return *this = *this + val; }
+   FixedVec8 &operator-=(FixedVec8 val) { return *this = *this - val; }
+   FixedVec8 &operator*=(FixedVec8 val) { return *this = *this * val; }
+   FixedVec8 &operator*=(int32_t val)   { return *this = *this * val; }
+   FixedVec8 &operator<<=(int n)        { return *this = *this << n; }
+   FixedVec8 &operator>>=(int n)        { return *this = *this >> n; }
+
+protected:
+   #if EA_AVX2
+      static FixedVec8 make(__m256i v) {
+         FixedVec8 ret;
+         ret.mValue = v;
+         return ret;
+      }
+      static __m256i floatToRaw(__m256 v) {
+         v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-2147483648.0f)), _mm256_set1_ps(2147483520.0f));
+         return _mm256_cvttps_epi32(v);
+      }
+
+      __m256i mValue;
+   #else
+      half_type mLo, mHi;
+   #endif
+};
+
+
+//applies op (taking and returning FixedVec8) to [first, last) eight values at
+//a time and writes the results to result, which may equal first. Works on the
+//contiguous storage of vector, fixedVector or plain arrays.
+template<int fractBits, typename UnaryOp>
+void fixedTransform(const FixedPoint<int32_t, int64_t, fractBits> *first, const FixedPoint<int32_t, int64_t, fractBits> *last,
+                    FixedPoint<int32_t, int64_t, fractBits> *result, UnaryOp op) {
+   typedef FixedVec8<fractBits> vec_type;
+   for(; last - first >= 8; first += 8, result += 8)
+      op(vec_type::load(first)).store(result);
+   if(first != last)
+      op(vec_type::loadPartial(first, (uint32_t)(last - first))).storePartial(result, (uint32_t)(last - first));
+}
+
+//binary version, op(a, b) with a from [first1, last1) and b from first2
+template<int fractBits, typename BinaryOp>
+void fixedTransform(const FixedPoint<int32_t, int64_t, fractBits> *first1, const FixedPoint<int32_t, int64_t, fractBits> *last1,
+                    const FixedPoint<int32_t, int64_t, fractBits> *first2, FixedPoint<int32_t, int64_t, fractBits> *result, BinaryOp op) {
+   typedef FixedVec8<fractBits> vec_type;
+   for(; last1 - first1 >= 8; first1 += 8, first2 += 8, result += 8)
+      op(vec_type::load(first1), vec_type::load(first2)).store(result);
+   if(first1 != last1) {
+      const uint32_t n = (uint32_t)(last1 - first1);
+      op(vec_type::loadPartial(first1, n), vec_type::loadPartial(first2, n)).storePartial(result, n);
+   }
+}
+
+typedef FixedVec4<16> FixedPoint32x4;
+typedef FixedVec8<16> FixedPoint32x8;
+
+}  //namespace eastl
+
+#endif   // __EASTL_EXTRAS_FIXEDVEC_H__
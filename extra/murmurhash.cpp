@@ -1,5 +1,13 @@
 
 #include "murmurhash.h"
+#include <string.h>
+
+#if EASTL_SSE2
+   #include <emmintrin.h>
+#endif
+#if EASTL_SSE4_1
+   #include <smmintrin.h>
+#endif
 
 // this is the MurmurHash 3 (based on r136)
 // http://code.google.com/p/smhasher/
@@ -26,6 +34,16 @@
    #define ROTL32(x,y)     rotl32(x,y)
    #define ROTL64(x,y)     rotl64(x,y)
    #define BIG_CONSTANT(x) (x##LLU)
+
+   #if defined(__has_attribute)
+      #if __has_attribute(fallthrough)
+         #define FALLTHROUGH __attribute__((fallthrough))
+      #endif
+   #endif
+#endif
+
+#ifndef FALLTHROUGH
+   #define FALLTHROUGH
 #endif
 
 //-----------------------------------------------------------------------------
@@ -283,3 +301,252 @@ void eastl::murmurHash_x64_128( const uint8_t *data, uint32_t len, void *out) {
    ((uint64_t*)out)[0] = h1;
    ((uint64_t*)out)[1] = h2;
  }
+
+//-----------------------------------------------------------------------------
+// Batch hashing. Each State below is one MurmurHash3 hash in progress; the
+// batch functions advance several states in lockstep over the blocks their
+// keys have in common so that the independent multiply chains overlap, and
+// then finish every key on its own. The results are the same as hashing each
+// key with the single-key functions above.
+
+namespace {
+
+struct Murmur32State {
+   enum { kBlockSize = 4, kOutCount = 1 };
+   typedef uint32_t out_type;
+   uint32_t h1;
+
+   void init() { h1 = 0; }
+
+   void block(const uint8_t *p) {
+      uint32_t k1;
+      memcpy(&k1, p, 4);
+      k1 *= 0xcc9e2d51; k1 = ROTL32(k1,15); k1 *= 0x1b873593;
+      h1 ^= k1; h1 = ROTL32(h1,13); h1 = h1*5+0xe6546b64;
+   }
+
+   void finish(const uint8_t *tail, uint32_t len, uint32_t *out) {
+      uint32_t k1 = 0;
+      switch(len & 3) {
+      case 3: k1 ^= tail[2] << 16; FALLTHROUGH;
+      case 2: k1 ^= tail[1] << 8;  FALLTHROUGH;
+      case 1: k1 ^= tail[0];
+              k1 *= 0xcc9e2d51; k1 = ROTL32(k1,15); k1 *= 0x1b873593; h1 ^= k1;
+      };
+      out[0] = fmix(h1 ^ len);
+   }
+};
+
+struct Murmur128x86State {
+   enum { kBlockSize = 16, kOutCount = 4 };
+   typedef uint32_t out_type;
+   uint32_t h1, h2, h3, h4;
+
+   void init() { h1 = h2 = h3 = h4 = 0; }
+
+   void block(const uint8_t *p) {
+      uint32_t k[4];
+      memcpy(k, p, 16);
+      k[0] *= 0x239b961b; k[0] = ROTL32(k[0],15); k[0] *= 0xab0e9789; h1 ^= k[0];
+      h1 = ROTL32(h1,19); h1 += h2; h1 = h1*5+0x561ccd1b;
+      k[1] *= 0xab0e9789; k[1] = ROTL32(k[1],16); k[1] *= 0x38b34ae5; h2 ^= k[1];
+      h2 = ROTL32(h2,17); h2 += h3; h2 = h2*5+0x0bcaa747;
+      k[2] *= 0x38b34ae5; k[2] = ROTL32(k[2],17); k[2] *= 0xa1e38b93; h3 ^= k[2];
+      h3 = ROTL32(h3,15); h3 += h4; h3 = h3*5+0x96cd1c35;
+      k[3] *= 0xa1e38b93; k[3] = ROTL32(k[3],18); k[3] *= 0x239b961b; h4 ^= k[3];
+      h4 = ROTL32(h4,13); h4 += h1; h4 = h4*5+0x32ac3b17;
+   }
+
+   void finish(const uint8_t *tail, uint32_t len, uint32_t *out) {
+      uint32_t k[4] = { 0, 0, 0, 0 };
+      uint8_t bytes[16] = { 0 };
+      memcpy(bytes, tail, len & 15);
+      for(uint32_t i = 0; i < (len & 15); i++)
+         k[i >> 2] ^= uint32_t(bytes[i]) << ((i & 3) * 8);
+      if(len & 15) {
+         if((len & 15) > 12) { k[3] *= 0xa1e38b93; k[3] = ROTL32(k[3],18); k[3] *= 0x239b961b; h4 ^= k[3]; }
+         if((len & 15) > 8)  { k[2] *= 0x38b34ae5; k[2] = ROTL32(k[2],17); k[2] *= 0xa1e38b93; h3 ^= k[2]; }
+         if((len & 15) > 4)  { k[1] *= 0xab0e9789; k[1] = ROTL32(k[1],16); k[1] *= 0x38b34ae5; h2 ^= k[1]; }
+         k[0] *= 0x239b961b; k[0] = ROTL32(k[0],15); k[0] *= 0xab0e9789; h1 ^= k[0];
+      }
+      h1 ^= len; h2 ^= len; h3 ^= len; h4 ^= len;
+      h1 += h2; h1 += h3; h1 += h4;
+      h2 += h1; h3 += h1; h4 += h1;
+      h1 = fmix(h1); h2 = fmix(h2); h3 = fmix(h3); h4 = fmix(h4);
+      h1 += h2; h1 += h3; h1 += h4;
+      h2 += h1; h3 += h1; h4 += h1;
+      out[0] = h1; out[1] = h2; out[2] = h3; out[3] = h4;
+   }
+};
+
+struct Murmur128x64State {
+   enum { kBlockSize = 16, kOutCount = 2 };
+   typedef uint64_t out_type;
+   uint64_t h1, h2;
+
+   void init() { h1 = h2 = 0; }
+
+   void block(const uint8_t *p) {
+      uint64_t k[2];
+      memcpy(k, p, 16);
+      k[0] *= BIG_CONSTANT(0x87c37b91114253d5); k[0] = ROTL64(k[0],31); k[0] *= BIG_CONSTANT(0x4cf5ad432745937f); h1 ^= k[0];
+      h1 = ROTL64(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
+      k[1] *= BIG_CONSTANT(0x4cf5ad432745937f); k[1] = ROTL64(k[1],33); k[1] *= BIG_CONSTANT(0x87c37b91114253d5); h2 ^= k[1];
+      h2 = ROTL64(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+   }
+
+   void finish(const uint8_t *tail, uint32_t len, uint64_t *out) {
+      uint64_t k[2] = { 0, 0 };
+      uint8_t bytes[16] = { 0 };
+      memcpy(bytes, tail, len & 15);
+      for(uint32_t i = 0; i < (len & 15); i++)
+         k[i >> 3] ^= uint64_t(bytes[i]) << ((i & 7) * 8);
+      if(len & 15) {
+         if((len & 15) > 8) { k[1] *= BIG_CONSTANT(0x4cf5ad432745937f); k[1] = ROTL64(k[1],33); k[1] *= BIG_CONSTANT(0x87c37b91114253d5); h2 ^= k[1]; }
+         k[0] *= BIG_CONSTANT(0x87c37b91114253d5); k[0] = ROTL64(k[0],31); k[0] *= BIG_CONSTANT(0x4cf5ad432745937f); h1 ^= k[0];
+      }
+      h1 ^= len; h2 ^= len;
+      h1 += h2; h2 += h1;
+      h1 = fmix64(h1); h2 = fmix64(h2);
+      h1 += h2; h2 += h1;
+      out[0] = h1; out[1] = h2;
+   }
+};
+
+// Hashes kLanes keys, interleaving their states over the blocks they have in common.
+template <typename State, int kLanes>
+inline void hashLanes(const uint8_t * const *keys, const uint32_t *lens, typename State::out_type *out) {
+   State s[kLanes];
+   uint32_t common = lens[0] / State::kBlockSize;
+   for(int l = 0; l < kLanes; l++) {
+      s[l].init();
+      if(lens[l] / State::kBlockSize < common)
+         common = lens[l] / State::kBlockSize;
+   }
+
+   for(uint32_t b = 0; b < common; b++) {
+      for(int l = 0; l < kLanes; l++)
+         s[l].block(keys[l] + b * State::kBlockSize);
+   }
+
+   for(int l = 0; l < kLanes; l++) {
+      const uint32_t nblocks = lens[l] / State::kBlockSize;
+      for(uint32_t b = common; b < nblocks; b++)
+         s[l].block(keys[l] + b * State::kBlockSize);
+      s[l].finish(keys[l] + nblocks * State::kBlockSize, lens[l], out + l * State::kOutCount);
+   }
+}
+
+template <typename State, int kLanes>
+void hashMany(const uint8_t * const *keys, const uint32_t *lens, uint32_t count, typename State::out_type *out) {
+   uint32_t i = 0;
+   for(; i + kLanes <= count; i += kLanes)
+      hashLanes<State, kLanes>(keys + i, lens + i, out + i * State::kOutCount);
+   for(; i < count; i++)
+      hashLanes<State, 1>(keys + i, lens + i, out + i * State::kOutCount);
+}
+
+#if EASTL_SSE2
+   // MurmurHash3_x86_32 of four keys at once, one per 32 bit lane.
+   inline __m128i mullo32x4(__m128i a, __m128i b) {
+      #if EASTL_SSE4_1
+         return _mm_mullo_epi32(a, b);
+      #else
+         const __m128i even = _mm_mul_epu32(a, b);
+         const __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+         return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+      #endif
+   }
+
+   #define ROTL32x4(x,r) _mm_or_si128(_mm_slli_epi32(x, r), _mm_srli_epi32(x, 32 - (r)))
+
+   inline __m128i murmurBlockx4(__m128i h, __m128i k) {
+      k = mullo32x4(k, _mm_set1_epi32((int)0xcc9e2d51));
+      k = ROTL32x4(k, 15);
+      k = mullo32x4(k, _mm_set1_epi32((int)0x1b873593));
+      h = _mm_xor_si128(h, k);
+      h = ROTL32x4(h, 13);
+      return _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(h, 2), h), _mm_set1_epi32((int)0xe6546b64));
+   }
+
+   inline __m128i fmixx4(__m128i h) {
+      h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+      h = mullo32x4(h, _mm_set1_epi32((int)0x85ebca6b));
+      h = _mm_xor_si128(h, _mm_srli_epi32(h, 13));
+      h = mullo32x4(h, _mm_set1_epi32((int)0xc2b2ae35));
+      return _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+   }
+
+   #undef ROTL32x4
+#endif
+
+// Keys of kWidth bytes stored back to back. With SSE2 the blocks of four keys
+// are transposed so that each vector holds the same block of four keys.
+template <uint32_t kWidth>
+void hashManyFixed(const uint8_t *keys, uint32_t count, uint32_t *out) {
+   uint32_t i = 0;
+
+   #if EASTL_SSE2
+      for(; i + 4 <= count; i += 4) {
+         const __m128i *p = (const __m128i*)(keys + i * kWidth);
+         __m128i h = _mm_setzero_si128();
+
+         if(kWidth == 4)
+            h = murmurBlockx4(h, _mm_loadu_si128(p));
+         else if(kWidth == 8) {
+            const __m128i t0 = _mm_shuffle_epi32(_mm_loadu_si128(p + 0), _MM_SHUFFLE(3,1,2,0));
+            const __m128i t1 = _mm_shuffle_epi32(_mm_loadu_si128(p + 1), _MM_SHUFFLE(3,1,2,0));
+            h = murmurBlockx4(h, _mm_unpacklo_epi64(t0, t1));
+            h = murmurBlockx4(h, _mm_unpackhi_epi64(t0, t1));
+         }
+         else {
+            const __m128i r0 = _mm_loadu_si128(p + 0), r1 = _mm_loadu_si128(p + 1);
+            const __m128i r2 = _mm_loadu_si128(p + 2), r3 = _mm_loadu_si128(p + 3);
+            const __m128i t0 = _mm_unpacklo_epi32(r0, r1), t1 = _mm_unpacklo_epi32(r2, r3);
+            const __m128i t2 = _mm_unpackhi_epi32(r0, r1), t3 = _mm_unpackhi_epi32(r2, r3);
+            h = murmurBlockx4(h, _mm_unpacklo_epi64(t0, t1));
+            h = murmurBlockx4(h, _mm_unpackhi_epi64(t0, t1));
+            h = murmurBlockx4(h, _mm_unpacklo_epi64(t2, t3));
+            h = murmurBlockx4(h, _mm_unpackhi_epi64(t2, t3));
+         }
+
+         h = fmixx4(_mm_xor_si128(h, _mm_set1_epi32((int)kWidth)));
+         _mm_storeu_si128((__m128i*)(out + i), h);
+      }
+   #else
+      for(; i + 4 <= count; i += 4) {
+         const uint8_t *p[4] = { keys + (i + 0) * kWidth, keys + (i + 1) * kWidth, keys + (i + 2) * kWidth, keys + (i + 3) * kWidth };
+         const uint32_t lens[4] = { kWidth, kWidth, kWidth, kWidth };
+         hashLanes<Murmur32State, 4>(p, lens, out + i);
+      }
+   #endif
+
+   for(; i < count; i++)
+      out[i] = eastl::murmurHash(keys + i * kWidth, kWidth);
+}
+
+} //namespace
+
+void eastl::murmurHashMany(const uint8_t * const *keys, const uint32_t *lens, uint32_t count, uint32_t *out) {
+   hashMany<Murmur32State, 4>(keys, lens, count, out);
+}
+
+void eastl::murmurHashMany4(const void *keys, uint32_t count, uint32_t *out) {
+   hashManyFixed<4>((const uint8_t*)keys, count, out);
+}
+
+void eastl::murmurHashMany8(const void *keys, uint32_t count, uint32_t *out) {
+   hashManyFixed<8>((const uint8_t*)keys, count, out);
+}
+
+void eastl::murmurHashMany16(const void *keys, uint32_t count, uint32_t *out) {
+   hashManyFixed<16>((const uint8_t*)keys, count, out);
+}
+
+void eastl::murmurHashMany_x86_128(const uint8_t * const *keys, const uint32_t *lens, uint32_t count, uint32_t *out) {
+   hashMany<Murmur128x86State, 2>(keys, lens, count, out);
+}
+
+void eastl::murmurHashMany_x64_128(const uint8_t * const *keys, const uint32_t *lens, uint32_t count, uint64_t *out) {
+   hashMany<Murmur128x64State, 2>(keys, lens, count, out);
+}
@@ -11,6 +11,7 @@
 #include <eastl/internal/allocator_traits_fwd_decls.h>
 #include <eastl/type_traits.h>
 #include <eastl/internal/functional_base.h>
+#include <eastl/internal/move_help.h>
 
 
 #if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
@@ -972,6 +973,72 @@ namespace eastl
 	};
 
 
+	/// hashed_key
+	///
+	/// Holds a key together with its hash, which is computed once at construction.
+	/// As the key of a hashMap or hashSet it makes rehashing free and lets most
+	/// mismatches be rejected on the hash alone. Its hash() can also be passed to
+	/// the precomputed-hash functions of the hash containers (find(key, hash),
+	/// erase(key, hash), insert_hinted_hash) so that one key can be looked up in
+	/// several tables while being hashed once. For that the tables must use Hash
+	/// as their hash function.
+	///
+	/// Example usage:
+	///    eastl::hashed_key<eastl::string> k(someLongString);
+	///    eastl::hashMap<eastl::string, int>::iterator it = hashMap.find(k.key(), k.hash());
+	///
+	///    eastl::hashSet<eastl::hashed_key<eastl::string> > hashSet;
+	///    hashSet.insert(k);
+	///
+	template <typename Key, typename Hash = eastl::hash<Key> >
+	class hashed_key
+	{
+	public:
+		typedef Key  key_type;
+		typedef Hash hasher;
+
+		explicit hashed_key(const key_type& key, const hasher& h = hasher())
+			: mKey(key), mnHash((size_t)h(mKey)) { }
+
+		hashed_key(const key_type& key, size_t nHash) // nHash must equal Hash()(key).
+			: mKey(key), mnHash(nHash) { }
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			explicit hashed_key(key_type&& key, const hasher& h = hasher())
+				: mKey(eastl::move(key)), mnHash((size_t)h(mKey)) { }
+		#endif
+
+		const key_type& key() const
+			{ return mKey; }
+
+		size_t hash() const
+			{ return mnHash; }
+
+	protected:
+		key_type mKey;
+		size_t   mnHash;
+	};
+
+	template <typename Key, typename Hash>
+	inline bool operator==(const hashed_key<Key, Hash>& a, const hashed_key<Key, Hash>& b)
+		{ return (a.hash() == b.hash()) && (a.key() == b.key()); }
+
+	template <typename Key, typename Hash>
+	inline bool operator!=(const hashed_key<Key, Hash>& a, const hashed_key<Key, Hash>& b)
+		{ return !(a == b); }
+
+	template <typename Key, typename Hash>
+	inline bool operator<(const hashed_key<Key, Hash>& a, const hashed_key<Key, Hash>& b)
+		{ return a.key() < b.key(); }
+
+	template <typename Key, typename Hash>
+	struct hash< hashed_key<Key, Hash> >
+	{
+		size_t operator()(const hashed_key<Key, Hash>& k) const
+			{ return k.hash(); }
+	};
+
+
 } // namespace eastl
 
 #if EASTL_FUNCTION_ENABLED
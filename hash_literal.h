@@ -0,0 +1,422 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements string hash functions which can be evaluated at
+// compile time, for hashing string literals into constants:
+//
+//     switch(hash_string(pName, nNameLength))
+//     {
+//         case hash_literal("Move"):   ...
+//         case hash_literal("Attack"): ...
+//     }
+//
+// Each hash comes in two forms which give identical results for the same
+// bytes, on any platform: a constexpr form for literals, written as C++11
+// constexpr recursion, and an ordinary loop for runtime strings. The family
+// is MurmurHash3 (x86, 32 bit), FNV-1a (32 and 64 bit), and wyhash (final
+// version 4, with its default secret), which is the fastest at runtime and
+// is the one hash_literal, hash_string and literal_hash use.
+//
+// The constexpr forms recurse once per 16 to 48 bytes, so that within the
+// usual default compiler limit of 512 levels they can hash literals of 4 KB
+// or more at compile time. Runtime strings should use the loop forms.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_HASH_LITERAL_H
+#define EASTL_HASH_LITERAL_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/string.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <string.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	namespace Internal
+	{
+		///////////////////////////////////////////////////////////////////////
+		// Byte access. Bytes are read as unsigned and assembled little endian,
+		// so that the constexpr and runtime forms agree on every platform.
+		///////////////////////////////////////////////////////////////////////
+
+		EA_CONSTEXPR inline uint32_t literal_byte(const char* p, size_t i)
+			{ return (uint32_t)(uint8_t)p[i]; }
+
+		EA_CONSTEXPR inline uint32_t literal_read32(const char* p)
+			{ return literal_byte(p, 0) | (literal_byte(p, 1) << 8) | (literal_byte(p, 2) << 16) | (literal_byte(p, 3) << 24); }
+
+		EA_CONSTEXPR inline uint64_t literal_read64(const char* p)
+			{ return (uint64_t)literal_read32(p) | ((uint64_t)literal_read32(p + 4) << 32); }
+
+		EA_CONSTEXPR inline uint32_t literal_rotl32(uint32_t x, int r)
+			{ return (x << r) | (x >> (32 - r)); }
+
+		inline uint32_t runtime_read32(const char* p)
+		{
+			#if defined(EA_SYSTEM_LITTLE_ENDIAN)
+				uint32_t x;
+				memcpy(&x, p, sizeof(x));
+				return x;
+			#else
+				return literal_read32(p);
+			#endif
+		}
+
+		inline uint64_t runtime_read64(const char* p)
+		{
+			#if defined(EA_SYSTEM_LITTLE_ENDIAN)
+				uint64_t x;
+				memcpy(&x, p, sizeof(x));
+				return x;
+			#else
+				return literal_read64(p);
+			#endif
+		}
+
+
+		///////////////////////////////////////////////////////////////////////
+		// MurmurHash3_x86_32
+		///////////////////////////////////////////////////////////////////////
+
+		EA_CONSTEXPR inline uint32_t murmur3_scramble(uint32_t k)
+			{ return literal_rotl32(k * 0xcc9e2d51u, 15) * 0x1b873593u; }
+
+		EA_CONSTEXPR inline uint32_t murmur3_block(uint32_t h, uint32_t k)
+			{ return (literal_rotl32(h ^ murmur3_scramble(k), 13) * 5) + 0xe6546b64u; }
+
+		EA_CONSTEXPR inline uint32_t murmur3_fmix_step(uint32_t h, int shift, uint32_t mul)
+			{ return (h ^ (h >> shift)) * mul; }
+
+		EA_CONSTEXPR inline uint32_t murmur3_xorshift16(uint32_t h)
+			{ return h ^ (h >> 16); }
+
+		EA_CONSTEXPR inline uint32_t murmur3_fmix(uint32_t h)
+			{ return murmur3_xorshift16(murmur3_fmix_step(murmur3_fmix_step(h, 16, 0x85ebca6bu), 13, 0xc2b2ae35u)); }
+
+		EA_CONSTEXPR inline uint32_t murmur3_tail(const char* p, size_t n)
+		{
+			return (n == 3) ? (literal_byte(p, 0) | (literal_byte(p, 1) << 8) | (literal_byte(p, 2) << 16)) :
+				   (n == 2) ? (literal_byte(p, 0) | (literal_byte(p, 1) << 8)) :
+				   (n == 1) ?  literal_byte(p, 0) : 0;
+		}
+
+		EA_CONSTEXPR inline uint32_t murmur3_body(const char* p, size_t nBlocks, uint32_t h)
+		{
+			return (nBlocks >= 4) ? murmur3_body(p + 16, nBlocks - 4, murmur3_block(murmur3_block(murmur3_block(murmur3_block(h,
+																		literal_read32(p)), literal_read32(p + 4)), literal_read32(p + 8)), literal_read32(p + 12))) :
+				   (nBlocks > 0)  ? murmur3_body(p + 4, nBlocks - 1, murmur3_block(h, literal_read32(p))) : h;
+		}
+
+		EA_CONSTEXPR inline uint32_t murmur3_finish(const char* p, size_t n, uint32_t h)
+			{ return murmur3_fmix(h ^ ((n & 3) ? murmur3_scramble(murmur3_tail(p + (n & ~(size_t)3), n & 3)) : 0) ^ (uint32_t)n); }
+
+
+		///////////////////////////////////////////////////////////////////////
+		// FNV-1a
+		///////////////////////////////////////////////////////////////////////
+
+		EA_CONSTEXPR inline uint32_t fnv1a_32_step(uint32_t h, const char* p, size_t i)
+			{ return (h ^ literal_byte(p, i)) * 16777619u; }
+
+		EA_CONSTEXPR inline uint32_t fnv1a_32_step8(uint32_t h, const char* p)
+		{
+			return fnv1a_32_step(fnv1a_32_step(fnv1a_32_step(fnv1a_32_step(fnv1a_32_step(fnv1a_32_step(fnv1a_32_step(
+					   fnv1a_32_step(h, p, 0), p, 1), p, 2), p, 3), p, 4), p, 5), p, 6), p, 7);
+		}
+
+		EA_CONSTEXPR inline uint32_t fnv1a_32_literal(const char* p, size_t n, uint32_t h)
+		{
+			return (n >= 16) ? fnv1a_32_literal(p + 16, n - 16, fnv1a_32_step8(fnv1a_32_step8(h, p), p + 8)) :
+				   (n > 0)   ? fnv1a_32_literal(p + 1, n - 1, fnv1a_32_step(h, p, 0)) : h;
+		}
+
+		EA_CONSTEXPR inline uint64_t fnv1a_64_step(uint64_t h, const char* p, size_t i)
+			{ return (h ^ literal_byte(p, i)) * UINT64_C(1099511628211); }
+
+		EA_CONSTEXPR inline uint64_t fnv1a_64_step8(uint64_t h, const char* p)
+		{
+			return fnv1a_64_step(fnv1a_64_step(fnv1a_64_step(fnv1a_64_step(fnv1a_64_step(fnv1a_64_step(fnv1a_64_step(
+					   fnv1a_64_step(h, p, 0), p, 1), p, 2), p, 3), p, 4), p, 5), p, 6), p, 7);
+		}
+
+		EA_CONSTEXPR inline uint64_t fnv1a_64_literal(const char* p, size_t n, uint64_t h)
+		{
+			return (n >= 16) ? fnv1a_64_literal(p + 16, n - 16, fnv1a_64_step8(fnv1a_64_step8(h, p), p + 8)) :
+				   (n > 0)   ? fnv1a_64_literal(p + 1, n - 1, fnv1a_64_step(h, p, 0)) : h;
+		}
+
+
+		///////////////////////////////////////////////////////////////////////
+		// wyhash
+		///////////////////////////////////////////////////////////////////////
+
+		static const uint64_t kWyP0 = UINT64_C(0x2d358dccaa6c78a5);
+		static const uint64_t kWyP1 = UINT64_C(0x8bb84b93962eacc9);
+		static const uint64_t kWyP2 = UINT64_C(0x4b33a62ed433d4a3);
+		static const uint64_t kWyP3 = UINT64_C(0x4d5a2da51de1aa47);
+
+		// The 128 bit product of a and b, from 32 bit halves so that it can be constexpr.
+		EA_CONSTEXPR inline uint64_t wy_mid(uint64_t a, uint64_t b)
+			{ return (((a & 0xffffffffu) * (b & 0xffffffffu)) >> 32) + (((a & 0xffffffffu) * (b >> 32)) & 0xffffffffu) + (((a >> 32) * (b & 0xffffffffu)) & 0xffffffffu); }
+
+		EA_CONSTEXPR inline uint64_t wy_mul_lo(uint64_t a, uint64_t b)
+			{ return a * b; }
+
+		EA_CONSTEXPR inline uint64_t wy_mul_hi(uint64_t a, uint64_t b)
+			{ return ((a >> 32) * (b >> 32)) + (((a & 0xffffffffu) * (b >> 32)) >> 32) + (((a >> 32) * (b & 0xffffffffu)) >> 32) + (wy_mid(a, b) >> 32); }
+
+		EA_CONSTEXPR inline uint64_t wy_mix_literal(uint64_t a, uint64_t b)
+			{ return wy_mul_lo(a, b) ^ wy_mul_hi(a, b); }
+
+		inline uint64_t wy_mix(uint64_t a, uint64_t b)
+		{
+			#if defined(__SIZEOF_INT128__)
+				const __uint128_t r = (__uint128_t)a * b;
+				return (uint64_t)r ^ (uint64_t)(r >> 64);
+			#else
+				return wy_mix_literal(a, b);
+			#endif
+		}
+
+		EA_CONSTEXPR inline uint64_t wy_read3(const char* p, size_t n)
+			{ return ((uint64_t)literal_byte(p, 0) << 16) | ((uint64_t)literal_byte(p, n >> 1) << 8) | literal_byte(p, n - 1); }
+
+		// Inputs of up to 16 bytes are folded into a and b directly.
+		EA_CONSTEXPR inline uint64_t wy_short_a(const char* p, size_t n)
+		{
+			return (n >= 4) ? (((uint64_t)literal_read32(p) << 32) | literal_read32(p + ((n >> 3) << 2))) :
+				   (n > 0)  ? wy_read3(p, n) : 0;
+		}
+
+		EA_CONSTEXPR inline uint64_t wy_short_b(const char* p, size_t n)
+			{ return (n >= 4) ? (((uint64_t)literal_read32(p + n - 4) << 32) | literal_read32(p + n - 4 - ((n >> 3) << 2))) : 0; }
+
+		// Longer inputs are consumed 48 bytes at a time in three lanes, then 16 bytes at a time.
+		EA_CONSTEXPR inline uint64_t wy_lanes48(const char* p, size_t i, uint64_t seed, uint64_t see1, uint64_t see2)
+		{
+			return (i > 48) ? wy_lanes48(p + 48, i - 48, wy_mix_literal(literal_read64(p) ^ kWyP1, literal_read64(p + 8) ^ seed),
+																	  wy_mix_literal(literal_read64(p + 16) ^ kWyP2, literal_read64(p + 24) ^ see1),
+																	  wy_mix_literal(literal_read64(p + 32) ^ kWyP3, literal_read64(p + 40) ^ see2))
+							: (seed ^ see1 ^ see2);
+		}
+
+		EA_CONSTEXPR inline uint64_t wy_lanes16(const char* p, size_t i, uint64_t seed)
+			{ return (i > 16) ? wy_lanes16(p + 16, i - 16, wy_mix_literal(literal_read64(p) ^ kWyP1, literal_read64(p + 8) ^ seed)) : seed; }
+
+		EA_CONSTEXPR inline size_t wy_after48(size_t n)
+			{ return (n > 48) ? (n - (((n - 1) / 48) * 48)) : n; }
+
+		EA_CONSTEXPR inline size_t wy_after16(size_t i)
+			{ return (i > 16) ? (i - (((i - 1) / 16) * 16)) : i; }
+
+		EA_CONSTEXPR inline uint64_t wy_long_seed(const char* p, size_t n, uint64_t seed)
+			{ return wy_lanes16(p + (n - wy_after48(n)), wy_after48(n), (n > 48) ? wy_lanes48(p, n, seed, seed, seed) : seed); }
+
+		EA_CONSTEXPR inline uint64_t wy_finish(uint64_t a, uint64_t b, uint64_t seed, size_t n)
+			{ return wy_mix_literal(wy_mul_lo(a ^ kWyP1, b ^ seed) ^ kWyP0 ^ (uint64_t)n, wy_mul_hi(a ^ kWyP1, b ^ seed) ^ kWyP1); }
+
+		EA_CONSTEXPR inline uint64_t wy_literal_seeded(const char* p, size_t n, uint64_t seed)
+		{
+			return (n <= 16) ? wy_finish(wy_short_a(p, n), wy_short_b(p, n), seed, n)
+							 : wy_finish(literal_read64(p + n - 16), literal_read64(p + n - 8), wy_long_seed(p, n, seed), n);
+		}
+
+		EA_CONSTEXPR inline uint64_t wy_literal(const char* p, size_t n, uint64_t seed)
+			{ return wy_literal_seeded(p, n, seed ^ wy_mix_literal(seed ^ kWyP0, kWyP1)); }
+
+		inline uint64_t wy_finish_runtime(uint64_t a, uint64_t b, uint64_t seed, size_t n)
+		{
+			#if defined(__SIZEOF_INT128__)
+				const __uint128_t r = (__uint128_t)(a ^ kWyP1) * (b ^ seed);
+				return wy_mix((uint64_t)r ^ kWyP0 ^ (uint64_t)n, (uint64_t)(r >> 64) ^ kWyP1);
+			#else
+				return wy_finish(a, b, seed, n);
+			#endif
+		}
+
+	} // namespace Internal
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// Runtime hashes
+	///////////////////////////////////////////////////////////////////////
+
+	/// hash_murmur3_32
+	///
+	/// MurmurHash3_x86_32. With seed 0 this is the same as murmurHash in extra/murmurhash.h.
+	///
+	inline uint32_t hash_murmur3_32(const char* p, size_t n, uint32_t seed = 0)
+	{
+		uint32_t     h       = seed;
+		const size_t nBlocks = n / 4;
+
+		for(size_t i = 0; i < nBlocks; ++i)
+			h = Internal::murmur3_block(h, Internal::runtime_read32(p + (i * 4)));
+
+		return Internal::murmur3_finish(p, n, h);
+	}
+
+
+	/// hash_fnv1a_32
+	///
+	inline uint32_t hash_fnv1a_32(const char* p, size_t n)
+	{
+		uint32_t h = 2166136261u;
+
+		for(size_t i = 0; i < n; ++i)
+			h = (h ^ (uint8_t)p[i]) * 16777619u;
+
+		return h;
+	}
+
+
+	/// hash_fnv1a_64
+	///
+	inline uint64_t hash_fnv1a_64(const char* p, size_t n)
+	{
+		uint64_t h = UINT64_C(14695981039346656037);
+
+		for(size_t i = 0; i < n; ++i)
+			h = (h ^ (uint8_t)p[i]) * UINT64_C(1099511628211);
+
+		return h;
+	}
+
+
+	/// hash_wyhash_64
+	///
+	inline uint64_t hash_wyhash_64(const char* p, size_t n, uint64_t seed = 0)
+	{
+		using namespace Internal;
+
+		seed ^= wy_mix(seed ^ kWyP0, kWyP1);
+
+		uint64_t a, b;
+
+		if(n <= 16)
+		{
+			a = wy_short_a(p, n);
+			b = wy_short_b(p, n);
+		}
+		else
+		{
+			size_t i = n;
+
+			if(i > 48)
+			{
+				uint64_t see1 = seed, see2 = seed;
+
+				do {
+					seed = wy_mix(runtime_read64(p)      ^ kWyP1, runtime_read64(p + 8)  ^ seed);
+					see1 = wy_mix(runtime_read64(p + 16) ^ kWyP2, runtime_read64(p + 24) ^ see1);
+					see2 = wy_mix(runtime_read64(p + 32) ^ kWyP3, runtime_read64(p + 40) ^ see2);
+					p += 48;
+					i -= 48;
+				} while(i > 48);
+
+				seed ^= see1 ^ see2;
+			}
+
+			for(; i > 16; i -= 16, p += 16)
+				seed = wy_mix(runtime_read64(p) ^ kWyP1, runtime_read64(p + 8) ^ seed);
+
+			a = runtime_read64(p + i - 16);
+			b = runtime_read64(p + i - 8);
+		}
+
+		return wy_finish_runtime(a, b, seed, n);
+	}
+
+
+	/// hash_string
+	///
+	/// The runtime counterpart of hash_literal.
+	///
+	inline size_t hash_string(const char* p, size_t n)
+		{ return (size_t)hash_wyhash_64(p, n); }
+
+	inline size_t hash_string(const char* p)
+		{ return (size_t)hash_wyhash_64(p, strlen(p)); }
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// Compile-time hashes
+	//
+	// These take string literals; the terminating 0 is not hashed. Passing a
+	// char array which isn't a literal hashes all of it but its last element.
+	///////////////////////////////////////////////////////////////////////
+
+	template <size_t N>
+	EA_CONSTEXPR inline uint32_t hash_literal_murmur3_32(const char (&s)[N], uint32_t seed = 0)
+		{ return Internal::murmur3_finish(s, N - 1, Internal::murmur3_body(s, (N - 1) / 4, seed)); }
+
+	template <size_t N>
+	EA_CONSTEXPR inline uint32_t hash_literal_fnv1a_32(const char (&s)[N])
+		{ return Internal::fnv1a_32_literal(s, N - 1, 2166136261u); }
+
+	template <size_t N>
+	EA_CONSTEXPR inline uint64_t hash_literal_fnv1a_64(const char (&s)[N])
+		{ return Internal::fnv1a_64_literal(s, N - 1, UINT64_C(14695981039346656037)); }
+
+	template <size_t N>
+	EA_CONSTEXPR inline uint64_t hash_literal_wyhash_64(const char (&s)[N], uint64_t seed = 0)
+		{ return Internal::wy_literal(s, N - 1, seed); }
+
+
+	/// hash_literal
+	///
+	/// Hashes a string literal at compile time. hash_string and literal_hash
+	/// give the same value for the same characters at runtime.
+	///
+	/// Example usage:
+	///     EA_CONSTEXPR size_t kPlayerId = hash_literal("Player");
+	///
+	template <size_t N>
+	EA_CONSTEXPR inline size_t hash_literal(const char (&s)[N])
+		{ return (size_t)Internal::wy_literal(s, N - 1, 0); }
+
+
+
+	/// literal_hash
+	///
+	/// A hash function object for hashMap and hashSet with string keys which
+	/// computes hash_string, so that hashes made with hash_literal can be used
+	/// to look up keys in the container.
+	///
+	/// Example usage:
+	///     hashMap<string, Handler, literal_hash> handlers;
+	///
+	struct literal_hash
+	{
+		size_t operator()(const char* p) const
+			{ return hash_string(p); }
+
+		template <typename Allocator>
+		size_t operator()(const basicString<char, Allocator>& s) const
+			{ return hash_string(s.data(), (size_t)s.size()); }
+	};
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
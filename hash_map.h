@@ -116,8 +116,10 @@ namespace eastl
 		typedef typename base_type::node_type                                     node_type;
 		typedef typename base_type::insert_return_type                            insert_return_type;
 		typedef typename base_type::iterator                                      iterator;
+		typedef typename base_type::hash_code_t                                   hash_code_t;
 
 		using base_type::insert;
+		using base_type::insert_hinted_hash;
 
 	public:
 		/// hashMap
@@ -236,6 +238,17 @@ namespace eastl
 		#endif
 
 
+		/// insert_hinted_hash
+		///
+		/// Same as insert(key), but uses c as the hash code of key instead of computing it.
+		/// This is the precomputed-hash equivalent of operator[]:
+		///     (*hashMap.insert_hinted_hash(c, key).first).second = value;
+		insert_return_type insert_hinted_hash(hash_code_t c, const key_type& key)
+		{
+			return base_type::DoInsertKey(true_type(), key, c);
+		}
+
+
 		mapped_type& operator[](const key_type& key)
 		{
 			return (*base_type::DoInsertKey(true_type(), key).first).second;
@@ -289,8 +302,10 @@ namespace eastl
 		typedef typename base_type::node_type                                         node_type;
 		typedef typename base_type::insert_return_type                                insert_return_type;
 		typedef typename base_type::iterator                                          iterator;
+		typedef typename base_type::hash_code_t                                       hash_code_t;
 
 		using base_type::insert;
+		using base_type::insert_hinted_hash;
 
 	public:
 		/// hashMultimap
@@ -409,6 +424,15 @@ namespace eastl
 		#endif
 
 
+		/// insert_hinted_hash
+		///
+		/// Same as insert(key), but uses c as the hash code of key instead of computing it.
+		insert_return_type insert_hinted_hash(hash_code_t c, const key_type& key)
+		{
+			return base_type::DoInsertKey(false_type(), key, c);
+		}
+
+
 	}; // hashMultimap
 
 
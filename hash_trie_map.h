@@ -0,0 +1,206 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file is based on the hash_map.h file. It implements hash_trie_map,
+// a unique-key hashed map built on a hash array mapped trie instead of a
+// bucketed hash table. See internal/hash_trie.h for the tradeoffs; in short
+// it uses much less memory per entry than hashMap and never rehashes, but
+// insert and erase invalidate all iterators and references.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_HASH_TRIE_MAP_H
+#define EASTL_HASH_TRIE_MAP_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/hash_trie.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+#include <eastl/initializer_list.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_HASH_TRIE_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_HASH_TRIE_MAP_DEFAULT_NAME
+		#define EASTL_HASH_TRIE_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " hash_trie_map" // Unless the user overrides something, this is "EASTL hash_trie_map".
+	#endif
+
+
+	/// EASTL_HASH_TRIE_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_HASH_TRIE_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_HASH_TRIE_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_HASH_TRIE_MAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// hash_trie_map
+	///
+	/// Implements a hash_trie_map, which is a hashed unique-key map.
+	/// Lookups follow about log32(n) node pointers, and the memory cost is
+	/// about 8 bytes per trie node plus the values themselves. There is no
+	/// load factor and no rehashing.
+	///
+	/// Iterator and reference invalidation
+	/// Since nodes are allocated at exactly the size they need, insert and
+	/// erase reallocate the nodes they touch. Thus every insert and erase
+	/// invalidates all iterators, pointers and references to elements.
+	/// This is unlike hashMap, which only invalidates erased elements.
+	///
+	/// Example usage:
+	///     hash_trie_map<uint64_t, Widget*> widgetMap;
+	///     widgetMap[id] = pWidget;
+	///     Widget** ppWidget = widgetMap.find_value(id); // Cheaper than find(), as no iterator is built.
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
+			  typename Allocator = EASTLAllocatorType>
+	class hash_trie_map
+		: public hash_trie<Key, eastl::pair<const Key, T>, Allocator, eastl::useFirst<eastl::pair<const Key, T> >, Predicate, Hash>
+	{
+	public:
+		typedef hash_trie<Key, eastl::pair<const Key, T>, Allocator,
+						  eastl::useFirst<eastl::pair<const Key, T> >, Predicate, Hash>  base_type;
+		typedef hash_trie_map<Key, T, Hash, Predicate, Allocator>                        this_type;
+		typedef typename base_type::size_type                                            size_type;
+		typedef typename base_type::key_type                                             key_type;
+		typedef T                                                                        mapped_type;
+		typedef typename base_type::value_type                                           value_type;     // Note that this is pair<const key_type, mapped_type>.
+		typedef typename base_type::allocator_type                                       allocator_type;
+		typedef typename base_type::insert_return_type                                   insert_return_type;
+		typedef typename base_type::iterator                                             iterator;
+		typedef typename base_type::const_iterator                                       const_iterator;
+
+		using base_type::insert;
+
+	public:
+		explicit hash_trie_map(const allocator_type& allocator = EASTL_HASH_TRIE_MAP_DEFAULT_ALLOCATOR)
+			: base_type(Hash(), Predicate(), eastl::useFirst<value_type>(), allocator)
+		{
+			// Empty
+		}
+
+
+		explicit hash_trie_map(const Hash& hashFunction, const Predicate& predicate = Predicate(),
+							   const allocator_type& allocator = EASTL_HASH_TRIE_MAP_DEFAULT_ALLOCATOR)
+			: base_type(hashFunction, predicate, eastl::useFirst<value_type>(), allocator)
+		{
+			// Empty
+		}
+
+
+		hash_trie_map(const this_type& x)
+			: base_type(x)
+		{
+		}
+
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			hash_trie_map(this_type&& x)
+				: base_type(eastl::move(x))
+			{
+			}
+		#endif
+
+
+		hash_trie_map(std::initializer_list<value_type> ilist, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_TRIE_MAP_DEFAULT_ALLOCATOR)
+			: base_type(hashFunction, predicate, eastl::useFirst<value_type>(), allocator)
+		{
+			base_type::insert(ilist.begin(), ilist.end());
+		}
+
+
+		template <typename InputIterator>
+		hash_trie_map(InputIterator first, InputIterator last, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_TRIE_MAP_DEFAULT_ALLOCATOR)
+			: base_type(hashFunction, predicate, eastl::useFirst<value_type>(), allocator)
+		{
+			base_type::insert(first, last);
+		}
+
+
+		this_type& operator=(const this_type& x)
+		{
+			return static_cast<this_type&>(base_type::operator=(x));
+		}
+
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			this_type& operator=(this_type&& x)
+			{
+				return static_cast<this_type&>(base_type::operator=(eastl::move(x)));
+			}
+		#endif
+
+
+		/// insert
+		///
+		/// This is an extension to the C++ standard. We insert a default-constructed
+		/// element with the given key. The reason for this is that we can avoid the
+		/// potentially expensive operation of creating and/or copying a mapped_type
+		/// object on the stack.
+		insert_return_type insert(const key_type& key)
+		{
+			return base_type::DoInsert(key, Internal::hash_trie_key_construct<value_type, key_type>(key));
+		}
+
+
+		mapped_type& operator[](const key_type& key)
+		{
+			return (*base_type::DoInsert(key, Internal::hash_trie_key_construct<value_type, key_type>(key)).first).second;
+		}
+
+	}; // hash_trie_map
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator==(const hash_trie_map<Key, T, Hash, Predicate, Allocator>& a,
+						   const hash_trie_map<Key, T, Hash, Predicate, Allocator>& b)
+	{
+		typedef typename hash_trie_map<Key, T, Hash, Predicate, Allocator>::const_iterator const_iterator;
+
+		if(a.size() != b.size())
+			return false;
+
+		for(const_iterator ai = a.begin(), aiEnd = a.end(); ai != aiEnd; ++ai)
+		{
+			const typename hash_trie_map<Key, T, Hash, Predicate, Allocator>::value_type* const pValue = b.find_value(ai->first);
+
+			if(!pValue || !(pValue->second == ai->second))
+				return false;
+		}
+
+		return true;
+	}
+
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator!=(const hash_trie_map<Key, T, Hash, Predicate, Allocator>& a,
+						   const hash_trie_map<Key, T, Hash, Predicate, Allocator>& b)
+	{
+		return !(a == b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,170 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file is based on the hash_set.h file. It implements hash_trie_set,
+// a hashed unique-item set built on a hash array mapped trie instead of a
+// bucketed hash table. See internal/hash_trie.h for the tradeoffs.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_HASH_TRIE_SET_H
+#define EASTL_HASH_TRIE_SET_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/hash_trie.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+#include <eastl/initializer_list.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_HASH_TRIE_SET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_HASH_TRIE_SET_DEFAULT_NAME
+		#define EASTL_HASH_TRIE_SET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " hash_trie_set" // Unless the user overrides something, this is "EASTL hash_trie_set".
+	#endif
+
+
+	/// EASTL_HASH_TRIE_SET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_HASH_TRIE_SET_DEFAULT_ALLOCATOR
+		#define EASTL_HASH_TRIE_SET_DEFAULT_ALLOCATOR allocator_type(EASTL_HASH_TRIE_SET_DEFAULT_NAME)
+	#endif
+
+
+
+	/// hash_trie_set
+	///
+	/// Implements a hash_trie_set, which is a hashed unique-item set.
+	/// For a set of 8 byte keys the cost is about 9 bytes per entry,
+	/// versus about 24 bytes (node plus bucket) for hashSet.
+	///
+	/// As with hash_trie_map, insert and erase invalidate all iterators.
+	/// Set elements are immutable; iterator and const_iterator both give const access.
+	///
+	template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>,
+			  typename Allocator = EASTLAllocatorType>
+	class hash_trie_set
+		: public hash_trie<Value, Value, Allocator, eastl::useSelf<Value>, Predicate, Hash>
+	{
+	public:
+		typedef hash_trie<Value, Value, Allocator, eastl::useSelf<Value>, Predicate, Hash>  base_type;
+		typedef hash_trie_set<Value, Hash, Predicate, Allocator>                            this_type;
+		typedef typename base_type::size_type                                               size_type;
+		typedef typename base_type::value_type                                              value_type;
+		typedef typename base_type::allocator_type                                          allocator_type;
+		typedef typename base_type::insert_return_type                                      insert_return_type;
+		typedef typename base_type::const_iterator                                          iterator;
+		typedef typename base_type::const_iterator                                          const_iterator;
+
+	public:
+		explicit hash_trie_set(const allocator_type& allocator = EASTL_HASH_TRIE_SET_DEFAULT_ALLOCATOR)
+			: base_type(Hash(), Predicate(), eastl::useSelf<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		explicit hash_trie_set(const Hash& hashFunction, const Predicate& predicate = Predicate(),
+							   const allocator_type& allocator = EASTL_HASH_TRIE_SET_DEFAULT_ALLOCATOR)
+			: base_type(hashFunction, predicate, eastl::useSelf<Value>(), allocator)
+		{
+			// Empty
+		}
+
+
+		hash_trie_set(const this_type& x)
+			: base_type(x)
+		{
+		}
+
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			hash_trie_set(this_type&& x)
+				: base_type(eastl::move(x))
+			{
+			}
+		#endif
+
+
+		hash_trie_set(std::initializer_list<value_type> ilist, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_TRIE_SET_DEFAULT_ALLOCATOR)
+			: base_type(hashFunction, predicate, eastl::useSelf<Value>(), allocator)
+		{
+			base_type::insert(ilist.begin(), ilist.end());
+		}
+
+
+		template <typename InputIterator>
+		hash_trie_set(InputIterator first, InputIterator last, const Hash& hashFunction = Hash(),
+					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_TRIE_SET_DEFAULT_ALLOCATOR)
+			: base_type(hashFunction, predicate, eastl::useSelf<Value>(), allocator)
+		{
+			base_type::insert(first, last);
+		}
+
+
+		this_type& operator=(const this_type& x)
+		{
+			return static_cast<this_type&>(base_type::operator=(x));
+		}
+
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			this_type& operator=(this_type&& x)
+			{
+				return static_cast<this_type&>(base_type::operator=(eastl::move(x)));
+			}
+		#endif
+
+	}; // hash_trie_set
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Value, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator==(const hash_trie_set<Value, Hash, Predicate, Allocator>& a,
+						   const hash_trie_set<Value, Hash, Predicate, Allocator>& b)
+	{
+		typedef typename hash_trie_set<Value, Hash, Predicate, Allocator>::const_iterator const_iterator;
+
+		if(a.size() != b.size())
+			return false;
+
+		for(const_iterator ai = a.begin(), aiEnd = a.end(); ai != aiEnd; ++ai)
+		{
+			if(!b.find_value(*ai))
+				return false;
+		}
+
+		return true;
+	}
+
+	template <typename Value, typename Hash, typename Predicate, typename Allocator>
+	inline bool operator!=(const hash_trie_set<Value, Hash, Predicate, Allocator>& a,
+						   const hash_trie_set<Value, Hash, Predicate, Allocator>& b)
+	{
+		return !(a == b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -177,6 +177,28 @@ namespace eastl
 
 
 
+	namespace Internal
+	{
+		/// HeapRebuildIsCheaper
+		///
+		/// Returns true if adding nAddCount items to a heap of nHeapSize items is
+		/// cheaper done by appending them all and calling makeHeap than by pushing
+		/// them one at a time. A push of random data moves up a constant number
+		/// of levels on average, but a push of increasing priorities moves all
+		/// the way up, while makeHeap costs about the same for any data but
+		/// visits the entire heap. With random data the break even point is
+		/// around nAddCount == nHeapSize for 4-ary heaps and a bit above for
+		/// binary heaps. Used by the push_range functions of priority_queue and d_ary_heap.
+		///
+		inline bool HeapRebuildIsCheaper(size_t nHeapSize, size_t nAddCount)
+		{
+			return (nAddCount >= nHeapSize);
+		}
+	}
+
+
+
+
 	///////////////////////////////////////////////////////////////////////
 	// pushHeap
 	///////////////////////////////////////////////////////////////////////
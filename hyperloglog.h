@@ -0,0 +1,508 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements hyperloglog, which estimates the number of distinct
+// keys in a stream using 2^precision bytes, regardless of how many keys
+// there are. The relative standard error is 1.04 / sqrt(2^precision): 1.6%
+// at the default precision of 12, which is 4 KB.
+//
+// As in HyperLogLog++, small sets are kept in a sparse form, a sorted array
+// of (index, rank) pairs at a much higher precision, which is both smaller
+// and more accurate until it grows to the size of the dense registers.
+// The dense estimate uses Ertl's improved estimator ("New cardinality
+// estimation algorithms for HyperLogLog sketches", 2017), which is unbiased
+// over the whole range without HyperLogLog++'s empirical bias tables.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_HYPERLOGLOG_H
+#define EASTL_HYPERLOGLOG_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/filter_support.h>
+#include <eastl/bit.h>
+#include <eastl/allocator.h>
+#include <eastl/algorithm.h>
+#include <eastl/functional.h>
+#include <eastl/vector.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <math.h>
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <math.h>
+	#include <string.h>
+#endif
+
+#if EASTL_SSE2
+	#include <emmintrin.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_HYPERLOGLOG_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_HYPERLOGLOG_DEFAULT_NAME
+		#define EASTL_HYPERLOGLOG_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " hyperloglog" // Unless the user overrides something, this is "EASTL hyperloglog".
+	#endif
+
+
+	/// EASTL_HYPERLOGLOG_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_HYPERLOGLOG_DEFAULT_ALLOCATOR
+		#define EASTL_HYPERLOGLOG_DEFAULT_ALLOCATOR allocator_type(EASTL_HYPERLOGLOG_DEFAULT_NAME)
+	#endif
+
+
+	/// hyperloglog
+	///
+	/// Keys are hashed with Hash and the result is finalized to 64 well mixed
+	/// bits; insert_hash takes a 64 bit hash directly. Inserting a key which was
+	/// already inserted has no effect, so the estimate is of distinct keys.
+	///
+	/// Sketches with the same precision can be merged, the result being the
+	/// sketch of the union of their streams. Thus each thread can keep its own
+	/// sketch and merge at the end. Merging two dense sketches is a byte-wise
+	/// max, done 16 bytes at a time with SSE2.
+	///
+	/// Example usage:
+	///     hyperloglog<uint64_t> uniqueUsers;
+	///
+	///     uniqueUsers.insert(userId);
+	///     printf("about %.0f unique users\n", uniqueUsers.estimate());
+	///
+	template <typename T, typename Hash = eastl::hash<T>, typename Allocator = EASTLAllocatorType>
+	class hyperloglog
+	{
+	public:
+		typedef hyperloglog<T, Hash, Allocator>  this_type;
+		typedef T                                value_type;
+		typedef eastl_size_t                     size_type;
+		typedef Hash                             hasher;
+		typedef Allocator                        allocator_type;
+
+		static const uint32_t kMinPrecision     = 4;
+		static const uint32_t kMaxPrecision     = 18;
+		static const uint32_t kDefaultPrecision = 12;
+		static const uint32_t kSparsePrecision  = 25;
+
+	public:
+		explicit hyperloglog(uint32_t nPrecision = kDefaultPrecision, const allocator_type& allocator = EASTL_HYPERLOGLOG_DEFAULT_ALLOCATOR);
+		hyperloglog(const this_type& x);
+	   ~hyperloglog();
+
+		this_type& operator=(const this_type& x);
+		void       swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mSparse.getAllocator(); }
+
+		/// reset
+		/// Clears the sketch and changes its precision, which is clamped to [kMinPrecision, kMaxPrecision].
+		void reset(uint32_t nPrecision);
+
+		/// clear
+		/// Empties the sketch and returns it to the sparse form.
+		void clear();
+
+		void insert(const value_type& value)
+			{ insert_hash(Internal::filter_mix64((uint64_t)mHash(value))); }
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for(; first != last; ++first)
+				insert(*first);
+		}
+
+		void insert_hash(uint64_t h);
+
+		/// estimate
+		/// Returns the estimated number of distinct keys inserted.
+		double estimate() const;
+
+		/// merge
+		/// Makes this the sketch of the union of this and x. Returns false, and
+		/// does nothing, if x has a different precision.
+		bool merge(const this_type& x);
+
+		uint32_t  precision() const EASTL_NOEXCEPT      { return mnPrecision; }
+		size_type register_count() const EASTL_NOEXCEPT { return (size_type)1 << mnPrecision; }
+		bool      is_sparse() const EASTL_NOEXCEPT      { return (mpRegisters == NULL); }
+		bool      empty() const EASTL_NOEXCEPT;
+		size_type size_in_bytes() const EASTL_NOEXCEPT  { return is_sparse() ? (mSparse.capacity() * sizeof(uint32_t)) : register_count(); }
+		double    relative_error() const                { return 1.04 / sqrt((double)register_count()); }
+
+		bool validate() const;
+
+	protected:
+		typedef eastl::vector<uint32_t, Allocator> sparse_type;
+
+		// A sparse entry is (index << 6) | rank, at kSparsePrecision. Sorting the
+		// entries sorts them by index, and the rank fits in 6 bits as it is at most 40.
+		sparse_type mSparse;
+		uint8_t*    mpRegisters;  // The 2^mnPrecision dense registers, or NULL while sparse.
+		uint32_t    mnPrecision;
+		hasher      mHash;
+
+		void DoInsertSparse(uint32_t nEntry);
+		void DoInsertDense(uint32_t nEntry);   // Inserts a sparse entry into the dense registers.
+		void DoConvertToDense();
+		void DoFreeRegisters();
+	};
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// hyperloglog
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename H, typename A>
+	inline hyperloglog<T, H, A>::hyperloglog(uint32_t nPrecision, const allocator_type& allocator)
+		: mSparse(allocator), mpRegisters(NULL), mnPrecision(kDefaultPrecision), mHash()
+	{
+		reset(nPrecision);
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline hyperloglog<T, H, A>::hyperloglog(const this_type& x)
+		: mSparse(x.mSparse), mpRegisters(NULL), mnPrecision(x.mnPrecision), mHash(x.mHash)
+	{
+		if(x.mpRegisters)
+		{
+			mpRegisters = (uint8_t*)allocate_memory(mSparse.getAllocator(), register_count(), 16, 0);
+			memcpy(mpRegisters, x.mpRegisters, register_count());
+		}
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline hyperloglog<T, H, A>::~hyperloglog()
+	{
+		DoFreeRegisters();
+	}
+
+
+	template <typename T, typename H, typename A>
+	typename hyperloglog<T, H, A>::this_type&
+	hyperloglog<T, H, A>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			this_type temp(x);
+			swap(temp);
+		}
+		return *this;
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline void hyperloglog<T, H, A>::swap(this_type& x)
+	{
+		mSparse.swap(x.mSparse);
+		eastl::swap(mpRegisters, x.mpRegisters);
+		eastl::swap(mnPrecision, x.mnPrecision);
+		eastl::swap(mHash,       x.mHash);
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline void hyperloglog<T, H, A>::DoFreeRegisters()
+	{
+		if(mpRegisters)
+			EASTLFree(mSparse.getAllocator(), mpRegisters, register_count());
+		mpRegisters = NULL;
+	}
+
+
+	template <typename T, typename H, typename A>
+	void hyperloglog<T, H, A>::reset(uint32_t nPrecision)
+	{
+		clear();
+		mnPrecision = (nPrecision < kMinPrecision) ? kMinPrecision : (nPrecision > kMaxPrecision) ? kMaxPrecision : nPrecision;
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline void hyperloglog<T, H, A>::clear()
+	{
+		DoFreeRegisters();
+		mSparse.clear();
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline bool hyperloglog<T, H, A>::empty() const EASTL_NOEXCEPT
+	{
+		if(mpRegisters)
+		{
+			for(size_type i = 0, iEnd = register_count(); i < iEnd; ++i)
+			{
+				if(mpRegisters[i])
+					return false;
+			}
+			return true;
+		}
+		return mSparse.empty();
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline void hyperloglog<T, H, A>::insert_hash(uint64_t h)
+	{
+		if(mpRegisters)
+		{
+			// The top mnPrecision bits pick the register, and the register keeps the
+			// highest rank (leading zeros + 1) of the remaining bits. The or'd in bit
+			// caps the rank at 65 - precision, as the sparse form's conversion does.
+			uint8_t&       r     = mpRegisters[h >> (64 - mnPrecision)];
+			const uint8_t  nRank = (uint8_t)(eastl::countl_zero((h << mnPrecision) | (UINT64_C(1) << (mnPrecision - 1))) + 1);
+
+			if(nRank > r)
+				r = nRank;
+		}
+		else
+		{
+			const uint32_t nIndex = (uint32_t)(h >> (64 - kSparsePrecision));
+			const uint32_t nRank  = (uint32_t)eastl::countl_zero((h << kSparsePrecision) | (UINT64_C(1) << (kSparsePrecision - 1))) + 1;
+
+			DoInsertSparse((nIndex << 6) | nRank);
+		}
+	}
+
+
+	template <typename T, typename H, typename A>
+	void hyperloglog<T, H, A>::DoInsertSparse(uint32_t nEntry)
+	{
+		typename sparse_type::iterator it = eastl::lowerBound(mSparse.begin(), mSparse.end(), nEntry & ~63u);
+
+		if((it != mSparse.end()) && ((*it >> 6) == (nEntry >> 6)))
+		{
+			if((*it & 63) < (nEntry & 63))
+				*it = nEntry;
+		}
+		else
+		{
+			mSparse.insert(it, nEntry);
+
+			// Once the sparse form is as big as the registers, it's no longer worth it.
+			if((mSparse.size() * sizeof(uint32_t)) >= register_count())
+				DoConvertToDense();
+		}
+	}
+
+
+	template <typename T, typename H, typename A>
+	inline void hyperloglog<T, H, A>::DoInsertDense(uint32_t nEntry)
+	{
+		// The sparse index is the dense index followed by the next (kSparsePrecision - mnPrecision)
+		// bits of the hash. If any of those bits is set, they determine the dense rank.
+		const uint32_t nExtraBits   = kSparsePrecision - mnPrecision;
+		const uint32_t nSparseIndex = nEntry >> 6;
+		const uint32_t nExtra       = nSparseIndex & ((1u << nExtraBits) - 1);
+		uint8_t        nRank;
+
+		if(nExtra)
+			nRank = (uint8_t)(nExtraBits - (uint32_t)eastl::bit_width(nExtra) + 1);
+		else
+			nRank = (uint8_t)(nExtraBits + (nEntry & 63));
+
+		uint8_t& r = mpRegisters[nSparseIndex >> nExtraBits];
+		if(nRank > r)
+			r = nRank;
+	}
+
+
+	template <typename T, typename H, typename A>
+	void hyperloglog<T, H, A>::DoConvertToDense()
+	{
+		mpRegisters = (uint8_t*)allocate_memory(mSparse.getAllocator(), register_count(), 16, 0);
+		EASTL_ASSERT(mpRegisters != NULL);
+		memset(mpRegisters, 0, register_count());
+
+		for(typename sparse_type::const_iterator it = mSparse.begin(); it != mSparse.end(); ++it)
+			DoInsertDense(*it);
+
+		mSparse.setCapacity(0); // Free the sparse array's memory.
+	}
+
+
+	template <typename T, typename H, typename A>
+	bool hyperloglog<T, H, A>::merge(const this_type& x)
+	{
+		if(x.mnPrecision != mnPrecision)
+			return false;
+
+		if(x.is_sparse())
+		{
+			if(this == &x)
+				return true;
+
+			for(typename sparse_type::const_iterator it = x.mSparse.begin(); it != x.mSparse.end(); ++it)
+			{
+				if(mpRegisters)
+					DoInsertDense(*it);
+				else
+					DoInsertSparse(*it);
+			}
+		}
+		else
+		{
+			if(!mpRegisters)
+				DoConvertToDense();
+
+			const size_type nCount = register_count();
+
+			#if EASTL_SSE2
+				// The registers are 16 byte aligned and there are at least 2^kMinPrecision == 16 of them.
+				for(size_type i = 0; i < nCount; i += 16)
+				{
+					__m128i* const pDest = (__m128i*)(mpRegisters + i);
+					_mm_store_si128(pDest, _mm_max_epu8(_mm_load_si128(pDest), _mm_load_si128((const __m128i*)(x.mpRegisters + i))));
+				}
+			#else
+				for(size_type i = 0; i < nCount; ++i)
+				{
+					if(x.mpRegisters[i] > mpRegisters[i])
+						mpRegisters[i] = x.mpRegisters[i];
+				}
+			#endif
+		}
+
+		return true;
+	}
+
+
+	template <typename T, typename H, typename A>
+	double hyperloglog<T, H, A>::estimate() const
+	{
+		if(!mpRegisters)
+		{
+			// Linear counting over the 2^kSparsePrecision sparse registers, which is
+			// very accurate while so few of them are used.
+			const double m = (double)(UINT64_C(1) << kSparsePrecision);
+			return m * log(m / (m - (double)mSparse.size()));
+		}
+
+		// Ertl's improved estimator. C[k] is the number of registers with rank k.
+		const uint32_t q = 64 - mnPrecision;
+		const double   m = (double)register_count();
+		uint32_t       C[66];
+
+		memset(C, 0, sizeof(C));
+		for(size_type i = 0, iEnd = register_count(); i < iEnd; ++i)
+			++C[mpRegisters[i]];
+
+		// tau(1 - C[q + 1] / m)
+		double z = 0.0;
+		{
+			double x = 1.0 - ((double)C[q + 1] / m);
+
+			if((x != 0.0) && (x != 1.0))
+			{
+				double y = 1.0, zPrev;
+				z = 1.0 - x;
+				do
+				{
+					x      = sqrt(x);
+					zPrev  = z;
+					y     *= 0.5;
+					z     -= (1.0 - x) * (1.0 - x) * y;
+				} while(z != zPrev);
+				z /= 3.0;
+			}
+		}
+		z *= m;
+
+		for(uint32_t k = q; k >= 1; --k)
+			z = 0.5 * (z + (double)C[k]);
+
+		// + m * sigma(C[0] / m)
+		{
+			double x = (double)C[0] / m;
+
+			if(x == 1.0)
+				return 0.0;
+
+			double y = 1.0, s = x, sPrev;
+			do
+			{
+				x     *= x;
+				sPrev  = s;
+				s     += x * y;
+				y     += y;
+			} while(s != sPrev);
+
+			z += m * s;
+		}
+
+		return (m * m) / (z * 2.0 * 0.6931471805599453); // alpha_inf = 1 / (2 ln 2)
+	}
+
+
+	template <typename T, typename H, typename A>
+	bool hyperloglog<T, H, A>::validate() const
+	{
+		if((mnPrecision < kMinPrecision) || (mnPrecision > kMaxPrecision))
+			return false;
+
+		if(mpRegisters)
+		{
+			if(!mSparse.empty() || ((uintptr_t)mpRegisters % 16))
+				return false;
+
+			for(size_type i = 0, iEnd = register_count(); i < iEnd; ++i)
+			{
+				if(mpRegisters[i] > (65 - mnPrecision))
+					return false;
+			}
+		}
+		else
+		{
+			for(size_type i = 0, iEnd = mSparse.size(); i < iEnd; ++i)
+			{
+				const uint32_t nRank = mSparse[i] & 63;
+
+				if((nRank == 0) || (nRank > (65 - kSparsePrecision)))
+					return false;
+
+				if(i && ((mSparse[i - 1] >> 6) >= (mSparse[i] >> 6))) // Strictly increasing indices.
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename H, typename A>
+	inline void swap(hyperloglog<T, H, A>& a, hyperloglog<T, H, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
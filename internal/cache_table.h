@@ -0,0 +1,386 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements cache_table, the storage shared by lru_cache and
+// clock_cache. A cache_table has a fixed capacity which is allocated up front
+// as a single block: an array of entries followed by an array of hash buckets.
+// Entries refer to each other by 32 bit index rather than by pointer, and
+// the hash chains run through the entries themselves. Thus there is no
+// per-entry allocation, and the per-entry overhead is a few 32 bit fields
+// plus one or two 32 bit buckets.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_CACHE_TABLE_H
+#define EASTL_INTERNAL_CACHE_TABLE_H
+
+
+#include <eastl/EABASE/eabase.h>
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <eastl/internal/config.h>
+#include <eastl/type_traits.h>
+#include <eastl/allocator.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <new>
+	#include <stddef.h>
+	#pragma warning(pop)
+#else
+	#include <new>
+	#include <stddef.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// cache_stats
+	///
+	/// Counters kept by lru_cache and clock_cache. get counts a hit or a miss;
+	/// peek and contains count nothing. An eviction is the removal of an entry
+	/// to make room for a new one, as opposed to an erase by the user.
+	///
+	struct cache_stats
+	{
+		uint64_t mnHits;
+		uint64_t mnMisses;
+		uint64_t mnInserts;
+		uint64_t mnEvictions;
+
+		cache_stats()
+			: mnHits(0), mnMisses(0), mnInserts(0), mnEvictions(0) { }
+
+		cache_stats& operator+=(const cache_stats& x)
+		{
+			mnHits      += x.mnHits;
+			mnMisses    += x.mnMisses;
+			mnInserts   += x.mnInserts;
+			mnEvictions += x.mnEvictions;
+			return *this;
+		}
+
+		float hit_rate() const
+			{ return (mnHits + mnMisses) ? (float)((double)mnHits / (double)(mnHits + mnMisses)) : 0.f; }
+	};
+
+
+
+	/// cache_entry_base
+	///
+	/// The part of an entry common to all caches. The value is constructed only
+	/// while the entry is in use.
+	///
+	template <typename Value>
+	struct cache_entry_base
+	{
+		typename aligned_storage<sizeof(Value), EASTL_ALIGN_OF(Value)>::type mStorage;
+		uint32_t mnHash;      // The low 32 bits of the key's hash.
+		uint32_t mnHashNext;  // The next entry in the hash chain, or in the free list.
+
+		Value& value()
+			{ return *reinterpret_cast<Value*>(&mStorage); }
+
+		const Value& value() const
+			{ return *reinterpret_cast<const Value*>(&mStorage); }
+	};
+
+
+
+	/// cache_table
+	///
+	/// Implements the storage of a fixed capacity cache. This is not meant to be
+	/// used directly; use lru_cache or clock_cache instead. Entry is a type derived
+	/// from cache_entry_base<pair<const Key, T> >, to which the cache adds its
+	/// replacement policy's bookkeeping.
+	///
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, typename Entry>
+	class cache_table
+	{
+	public:
+		typedef cache_table<Key, T, Hash, Predicate, Allocator, Entry>  this_type;
+		typedef Key                                                      key_type;
+		typedef T                                                        mapped_type;
+		typedef eastl::pair<const Key, T>                                value_type;
+		typedef eastl_size_t                                             size_type;
+		typedef Allocator                                                allocator_type;
+		typedef Hash                                                     hasher;
+		typedef Predicate                                                key_equal;
+		typedef Entry                                                    entry_type;
+
+		/// eviction_callback_type
+		///
+		/// Called just before an entry is evicted to make room for another. The
+		/// callback may modify or move from the value, but must not use the cache.
+		///
+		typedef void (*eviction_callback_type)(const key_type& key, mapped_type& value, void* pContext);
+
+		static const uint32_t kNil = 0xffffffff;
+
+	public:
+		cache_table(size_type capacity, const Hash& hashFunction, const Predicate& predicate, const allocator_type& allocator);
+	   ~cache_table();
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+		bool      empty() const EASTL_NOEXCEPT    { return (mnSize == 0); }
+		size_type size() const EASTL_NOEXCEPT     { return mnSize; }
+		size_type capacity() const EASTL_NOEXCEPT { return mnCapacity; }
+
+		bool contains(const key_type& key) const
+			{ return DoFind(key, DoHash(key)) != kNil; }
+
+		// Returns the value for key without updating its recency or the counters, or NULL.
+		const mapped_type* peek(const key_type& key) const
+		{
+			const uint32_t i = DoFind(key, DoHash(key));
+			return (i != kNil) ? &mpEntries[i].value().second : NULL;
+		}
+
+		const cache_stats& getStats() const EASTL_NOEXCEPT { return mStats; }
+		void               resetStats() EASTL_NOEXCEPT     { mStats = cache_stats(); }
+
+		void setEvictionCallback(eviction_callback_type pCallback, void* pContext = NULL)
+			{ mpEvictionCallback = pCallback; mpEvictionContext = pContext; }
+
+		eviction_callback_type getEvictionCallback() const EASTL_NOEXCEPT  { return mpEvictionCallback; }
+		void*                  getEvictionContext() const EASTL_NOEXCEPT   { return mpEvictionContext; }
+
+		hasher    hash_function() const { return mHash; }
+		key_equal key_eq() const        { return mPredicate; }
+
+	protected:
+		Entry*                 mpEntries;
+		uint32_t*              mpBuckets;
+		uint32_t               mnBucketMask;
+		uint32_t               mnCapacity;
+		uint32_t               mnSize;
+		uint32_t               mnFreeList;          // Entries freed by erase, linked through mnHashNext.
+		uint32_t               mnHighWater;         // Entries at or above this index have never been used.
+		cache_stats            mStats;
+		eviction_callback_type mpEvictionCallback;
+		void*                  mpEvictionContext;
+		Hash                   mHash;
+		Predicate              mPredicate;
+		allocator_type         mAllocator;
+
+		uint32_t DoHash(const key_type& key) const
+		{
+			const size_t h = mHash(key);
+			return (uint32_t)(h ^ (h >> 16) ^ ((uint64_t)h >> 32)); // Fold the upper bits in, as we use the low bits to pick the bucket.
+		}
+
+		uint32_t DoFind(const key_type& key, uint32_t h) const;
+		uint32_t DoAllocateEntry();                         // Returns kNil if the table is full.
+		void     DoLinkEntry(uint32_t i, uint32_t h);       // Adds a constructed entry to its hash chain.
+		void     DoUnlinkEntry(uint32_t i);                 // Removes an entry from its hash chain.
+		void     DoFreeEntry(uint32_t i);                   // Destroys an unlinked entry's value and frees it.
+		void     DoEvictEntry(uint32_t i);                  // Calls the callback, then unlinks and frees the entry.
+		void     DoClear();                                 // Destroys every value and returns all entries to the never used state.
+		void     DoAbandonEntry(uint32_t i);                // Frees an allocated entry whose value failed to construct.
+		void     DoSwap(this_type& x);
+
+	private:
+		#if defined(EA_COMPILER_NO_DELETED_FUNCTIONS)
+			cache_table(const this_type&);
+			void operator=(const this_type&);
+		#else
+			cache_table(const this_type&) = delete;
+			void operator=(const this_type&) = delete;
+		#endif
+
+	}; // class cache_table
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// cache_table
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	cache_table<K, T, H, P, A, E>::cache_table(size_type capacity, const H& hashFunction, const P& predicate, const allocator_type& allocator)
+		: mpEntries(NULL),
+		  mpBuckets(NULL),
+		  mnBucketMask(0),
+		  mnCapacity((uint32_t)capacity),
+		  mnSize(0),
+		  mnFreeList(kNil),
+		  mnHighWater(0),
+		  mStats(),
+		  mpEvictionCallback(NULL),
+		  mpEvictionContext(NULL),
+		  mHash(hashFunction),
+		  mPredicate(predicate),
+		  mAllocator(allocator)
+	{
+		EASTL_ASSERT(capacity < kNil);
+
+		if(mnCapacity)
+		{
+			uint32_t nBucketCount = 1;
+			while(nBucketCount < mnCapacity)
+				nBucketCount *= 2;
+			mnBucketMask = nBucketCount - 1;
+
+			// One allocation holds the entries followed by the buckets.
+			const size_t nEntryBytes = ((mnCapacity * sizeof(E)) + EASTL_ALIGN_OF(uint32_t) - 1) & ~(EASTL_ALIGN_OF(uint32_t) - 1);
+			void* const  pMemory     = allocate_memory(mAllocator, nEntryBytes + (nBucketCount * sizeof(uint32_t)), EASTL_ALIGN_OF(E), 0);
+			EASTL_ASSERT(pMemory != NULL);
+
+			mpEntries = (E*)pMemory;
+			mpBuckets = (uint32_t*)((char*)pMemory + nEntryBytes);
+
+			for(uint32_t b = 0; b < nBucketCount; ++b)
+				mpBuckets[b] = kNil;
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	cache_table<K, T, H, P, A, E>::~cache_table()
+	{
+		// The derived cache destroys its entries' values, as only it knows which are in use.
+		if(mnCapacity)
+		{
+			const size_t nEntryBytes = ((mnCapacity * sizeof(E)) + EASTL_ALIGN_OF(uint32_t) - 1) & ~(EASTL_ALIGN_OF(uint32_t) - 1);
+			EASTLFree(mAllocator, mpEntries, nEntryBytes + ((mnBucketMask + 1) * sizeof(uint32_t)));
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	inline uint32_t cache_table<K, T, H, P, A, E>::DoFind(const key_type& key, uint32_t h) const
+	{
+		if(mnCapacity)
+		{
+			for(uint32_t i = mpBuckets[h & mnBucketMask]; i != kNil; i = mpEntries[i].mnHashNext)
+			{
+				if((mpEntries[i].mnHash == h) && mPredicate(mpEntries[i].value().first, key))
+					return i;
+			}
+		}
+		return kNil;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	inline uint32_t cache_table<K, T, H, P, A, E>::DoAllocateEntry()
+	{
+		if(mnFreeList != kNil)
+		{
+			const uint32_t i = mnFreeList;
+			mnFreeList = mpEntries[i].mnHashNext;
+			return i;
+		}
+
+		if(mnHighWater < mnCapacity)
+			return mnHighWater++;
+
+		return kNil;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	inline void cache_table<K, T, H, P, A, E>::DoAbandonEntry(uint32_t i)
+	{
+		mpEntries[i].mnHashNext = mnFreeList;
+		mnFreeList = i;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	inline void cache_table<K, T, H, P, A, E>::DoLinkEntry(uint32_t i, uint32_t h)
+	{
+		uint32_t& bucket = mpBuckets[h & mnBucketMask];
+
+		mpEntries[i].mnHash     = h;
+		mpEntries[i].mnHashNext = bucket;
+		bucket = i;
+		++mnSize;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	inline void cache_table<K, T, H, P, A, E>::DoUnlinkEntry(uint32_t i)
+	{
+		uint32_t* pLink = &mpBuckets[mpEntries[i].mnHash & mnBucketMask];
+
+		while(*pLink != i)
+			pLink = &mpEntries[*pLink].mnHashNext;
+
+		*pLink = mpEntries[i].mnHashNext;
+		--mnSize;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	inline void cache_table<K, T, H, P, A, E>::DoFreeEntry(uint32_t i)
+	{
+		mpEntries[i].value().~value_type();
+		mpEntries[i].mnHashNext = mnFreeList;
+		mnFreeList = i;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	inline void cache_table<K, T, H, P, A, E>::DoEvictEntry(uint32_t i)
+	{
+		if(mpEvictionCallback)
+			mpEvictionCallback(mpEntries[i].value().first, mpEntries[i].value().second, mpEvictionContext);
+
+		DoUnlinkEntry(i);
+		DoFreeEntry(i);
+		++mStats.mnEvictions;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	void cache_table<K, T, H, P, A, E>::DoClear()
+	{
+		// An entry is in use if it is reachable from a bucket.
+		for(uint32_t b = 0; mnCapacity && (b <= mnBucketMask); ++b)
+		{
+			for(uint32_t i = mpBuckets[b]; i != kNil; i = mpEntries[i].mnHashNext)
+				mpEntries[i].value().~value_type();
+			mpBuckets[b] = kNil;
+		}
+
+		mnSize      = 0;
+		mnFreeList  = kNil;
+		mnHighWater = 0;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A, typename E>
+	inline void cache_table<K, T, H, P, A, E>::DoSwap(this_type& x)
+	{
+		eastl::swap(mpEntries,          x.mpEntries);
+		eastl::swap(mpBuckets,          x.mpBuckets);
+		eastl::swap(mnBucketMask,       x.mnBucketMask);
+		eastl::swap(mnCapacity,         x.mnCapacity);
+		eastl::swap(mnSize,             x.mnSize);
+		eastl::swap(mnFreeList,         x.mnFreeList);
+		eastl::swap(mnHighWater,        x.mnHighWater);
+		eastl::swap(mStats,             x.mStats);
+		eastl::swap(mpEvictionCallback, x.mpEvictionCallback);
+		eastl::swap(mpEvictionContext,  x.mpEvictionContext);
+		eastl::swap(mHash,              x.mHash);
+		eastl::swap(mPredicate,         x.mPredicate);
+		eastl::swap(mAllocator,         x.mAllocator);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements support shared by the probabilistic containers,
+// bloom_filter, cuckoo_filter, count_min_sketch and hyperloglog: hash
+// finalization and the header of the flat buffer format they serialize to.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_FILTER_SUPPORT_H
+#define EASTL_INTERNAL_FILTER_SUPPORT_H
+
+
+#include <eastl/EABASE/eabase.h>
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <eastl/internal/config.h>
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <string.h>
+#endif
+
+
+
+namespace eastl
+{
+	namespace Internal
+	{
+		/// filter_mix64
+		///
+		/// The MurmurHash3 64 bit finalizer. These containers use the hash bits
+		/// directly to pick blocks, bits and registers, so identity hashes such as
+		/// eastl::hash<int> must be spread over all 64 bits first.
+		///
+		inline uint64_t filter_mix64(uint64_t h)
+		{
+			h ^= h >> 33;
+			h *= UINT64_C(0xff51afd7ed558ccd);
+			h ^= h >> 33;
+			h *= UINT64_C(0xc4ceb9fe1a85ec53);
+			h ^= h >> 33;
+			return h;
+		}
+
+
+		/// filter_range
+		///
+		/// Maps a 32 bit value uniformly onto [0, n) with a multiply instead of a divide.
+		///
+		inline uint32_t filter_range(uint32_t x, uint32_t n)
+		{
+			return (uint32_t)(((uint64_t)x * n) >> 32);
+		}
+
+
+		/// filter_header
+		///
+		/// Precedes the filter's data in its serialized form. The data is written
+		/// in native byte order, so a buffer can only be read on a platform with
+		/// the same endianness; mnMagic detects a mismatch.
+		///
+		struct filter_header
+		{
+			uint32_t mnMagic;        // Identifies the filter type; see the filters' kSerializeMagic.
+			uint16_t mnVersion;
+			uint16_t mnParameter;    // A filter specific parameter, such as fingerprint size.
+			uint32_t mnBlockCount;   // Blocks for bloom_filter, buckets for cuckoo_filter.
+			uint32_t mnReserved;
+			uint64_t mnItemCount;
+		};
+
+		inline bool filter_read_header(const void* pBuffer, size_t nBufferSize, uint32_t nMagic, filter_header& header)
+		{
+			if(nBufferSize < sizeof(filter_header))
+				return false;
+
+			memcpy(&header, pBuffer, sizeof(filter_header));
+			return (header.mnMagic == nMagic) && (header.mnVersion == 1);
+		}
+
+	} // namespace Internal
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,1344 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements a hash array mapped trie, which is the engine behind
+// hash_trie_map and hash_trie_set. It is based on Alex Evans' ideal hash trie
+// (see extra/IdealHashTrie.h for the history), with the following changes:
+//    - Memory comes from an EASTL allocator instead of malloc.
+//    - Nodes keep two bitmaps (one for inline values, one for child nodes)
+//      instead of tagging the low bit of the stored value. Thus the value type
+//      can be anything, and not just a pointer-sized POD.
+//    - Slot lookup uses the hardware popcount instruction where available.
+//    - The container has iterators and the usual find/insert/erase interface.
+//
+// A hash_trie walks the hash code of a key five bits at a time. Each node has
+// up to 32 slots, but stores only the slots that are used, tightly packed. A
+// slot's position within its node's array is the count of set bits below the
+// slot's bit in the node's bitmap. Thus a node costs 8 bytes plus its entries,
+// there are no empty buckets, and the structure never needs to be rehashed.
+// Once the hash bits are exhausted, colliding values go into a linear list node.
+//
+// The primary tradeoffs versus hashtable are:
+//    - A hash_trie uses much less memory per entry, as values are stored
+//      inline in the trie nodes rather than in individually allocated nodes,
+//      and there is no bucket array.
+//    - Lookups cost one dependent load per five bits of hash consumed,
+//      which for n entries is about log32(n) loads.
+//    - Inserts and erases reallocate the node they modify. Thus insert and
+//      erase invalidate all iterators, pointers and references into the
+//      container. This is the price of having no slack in the nodes.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_HASH_TRIE_H
+#define EASTL_INTERNAL_HASH_TRIE_H
+
+
+#include <eastl/EABASE/eabase.h>
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <eastl/internal/config.h>
+#include <eastl/bit.h>
+#include <eastl/type_traits.h>
+#include <eastl/allocator.h>
+#include <eastl/iterator.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+#include <eastl/algorithm.h>
+#include <eastl/memory.h>
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <new>
+	#include <stddef.h>
+	#pragma warning(pop)
+#else
+	#include <new>
+	#include <stddef.h>
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4512)  // 'class' : assignment operator could not be generated.
+	#pragma warning(disable: 4530)  // C++ exception handler used, but unwind semantics are not enabled. Specify /EHsc
+#endif
+
+
+namespace eastl
+{
+
+	/// EASTL_HASH_TRIE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_HASH_TRIE_DEFAULT_NAME
+		#define EASTL_HASH_TRIE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " hash_trie" // Unless the user overrides something, this is "EASTL hash_trie".
+	#endif
+
+
+	/// EASTL_HASH_TRIE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_HASH_TRIE_DEFAULT_ALLOCATOR
+		#define EASTL_HASH_TRIE_DEFAULT_ALLOCATOR allocator_type(EASTL_HASH_TRIE_DEFAULT_NAME)
+	#endif
+
+
+
+	/// Hash trie geometry
+	///
+	/// kHashTrieMaxShift is the number of hash bits the trie consumes before
+	/// switching to linear collision lists: 60 bits with 64 bit size_t, else 30.
+	///
+	static const uint32_t kHashTrieBitsPerLevel = 5;
+	static const uint32_t kHashTrieLevelMask    = (1u << kHashTrieBitsPerLevel) - 1;
+	static const uint32_t kHashTrieMaxShift     = ((sizeof(size_t) * 8) / kHashTrieBitsPerLevel) * kHashTrieBitsPerLevel;
+	static const uint32_t kHashTrieMaxDepth     = (kHashTrieMaxShift / kHashTrieBitsPerLevel) + 1;
+
+
+
+	/// hash_trie_node
+	///
+	/// A node is allocated with variable size. It is laid out as follows:
+	///     hash_trie_node header
+	///     value_type values[popcount(mDataMap)]        (aligned to the value type)
+	///     hash_trie_node* children[popcount(mNodeMap)] (aligned to a pointer)
+	///
+	/// Collision nodes (those at depth kHashTrieMaxDepth - 1) instead store
+	/// the count of values in mDataMap and have no children.
+	///
+	struct hash_trie_node
+	{
+		uint32_t mDataMap;  // Bit i is set if slot i holds a value.
+		uint32_t mNodeMap;  // Bit i is set if slot i holds a child node.
+	};
+
+
+	/// hash_trie_layout
+	///
+	/// Computes the location of the value and child arrays within a node.
+	/// Node is the node header type: hash_trie_node or a type derived
+	/// from it which carries additional bookkeeping (e.g. a reference count).
+	///
+	template <typename Value, typename Node = hash_trie_node>
+	struct hash_trie_layout
+	{
+		static const size_t kValueAlignment = EASTL_ALIGN_OF(Value);
+		static const size_t kNodeAlignment  = (EASTL_ALIGN_OF(Value) > EASTL_ALIGN_OF(Node*)) ? EASTL_ALIGN_OF(Value) : EASTL_ALIGN_OF(Node*);
+		static const size_t kValueOffset    = (sizeof(Node) + kValueAlignment - 1) & ~(kValueAlignment - 1);
+
+		static size_t GetChildOffset(uint32_t nDataCount)
+			{ return (kValueOffset + (nDataCount * sizeof(Value)) + EASTL_ALIGN_OF(Node*) - 1) & ~(EASTL_ALIGN_OF(Node*) - 1); }
+
+		static size_t GetNodeSize(uint32_t nDataCount, uint32_t nNodeCount)
+			{ return GetChildOffset(nDataCount) + (nNodeCount * sizeof(Node*)); }
+
+		static Value* GetValues(const Node* pNode)
+			{ return reinterpret_cast<Value*>((char*)pNode + kValueOffset); }
+
+		static Node** GetChildren(const Node* pNode, uint32_t nDataCount)
+			{ return reinterpret_cast<Node**>((char*)pNode + GetChildOffset(nDataCount)); }
+
+		static uint32_t GetDataCount(const Node* pNode, uint32_t depth)
+			{ return ((depth + 1) < kHashTrieMaxDepth) ? (uint32_t)eastl::popcount(pNode->mDataMap) : pNode->mDataMap; }
+
+		static uint32_t GetNodeCount(const Node* pNode)
+			{ return (uint32_t)eastl::popcount(pNode->mNodeMap); }
+	};
+
+
+
+	/// hash_trie_iterator
+	///
+	/// Iterates the trie depth-first, visiting a node's values before its children.
+	/// The iterator keeps the path from the root to the current node, so it is
+	/// larger than a typical container iterator; it isn't suited to being stored
+	/// in bulk.
+	///
+	template <typename Value, bool bConst, typename Node = hash_trie_node>
+	struct hash_trie_iterator
+	{
+	public:
+		typedef hash_trie_iterator<Value, bConst, Node>                   this_type;
+		typedef hash_trie_iterator<Value, false, Node>                    iterator;
+		typedef hash_trie_layout<Value, Node>                             layout_type;
+		typedef Value                                                     value_type;
+		typedef typename type_select<bConst, const Value*, Value*>::type pointer;
+		typedef typename type_select<bConst, const Value&, Value&>::type reference;
+		typedef ptrdiff_t                                                 difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag                        iterator_category;
+
+	public:
+		const Node* mpNodeStack[kHashTrieMaxDepth];  // The path from the root to the current node.
+		uint32_t    mnChildStack[kHashTrieMaxDepth]; // For each node in the path, the index of the next child to visit.
+		int32_t     mnDepth;                         // The depth of the current node, or -1 for the end iterator.
+		uint32_t    mnValueIndex;                    // The index of the current value within the current node.
+
+	public:
+		hash_trie_iterator()
+			: mnDepth(-1), mnValueIndex(0) { }
+
+		explicit hash_trie_iterator(const Node* pRoot)
+			: mnDepth(-1), mnValueIndex(0)
+		{
+			if(pRoot)
+			{
+				mnDepth        = 0;
+				mpNodeStack[0] = pRoot;
+				mnChildStack[0] = 0;
+
+				if(layout_type::GetDataCount(pRoot, 0) == 0)
+					DoAdvanceNode();
+			}
+		}
+
+		hash_trie_iterator(const iterator& x)
+			: mnDepth(x.mnDepth), mnValueIndex(x.mnValueIndex)
+		{
+			for(int32_t i = 0; i <= mnDepth; ++i)
+			{
+				mpNodeStack[i]  = x.mpNodeStack[i];
+				mnChildStack[i] = x.mnChildStack[i];
+			}
+		}
+
+		reference operator*() const
+			{ return layout_type::GetValues(mpNodeStack[mnDepth])[mnValueIndex]; }
+
+		pointer operator->() const
+			{ return &layout_type::GetValues(mpNodeStack[mnDepth])[mnValueIndex]; }
+
+		this_type& operator++()
+		{
+			if(++mnValueIndex >= layout_type::GetDataCount(mpNodeStack[mnDepth], (uint32_t)mnDepth))
+				DoAdvanceNode();
+			return *this;
+		}
+
+		this_type operator++(int)
+			{ this_type temp(*this); ++*this; return temp; }
+
+		bool equals(const hash_trie_iterator<Value, true, Node>& x) const
+		{
+			if(mnDepth < 0)
+				return (x.mnDepth < 0);
+			return (x.mnDepth >= 0) && (mpNodeStack[mnDepth] == x.mpNodeStack[x.mnDepth]) && (mnValueIndex == x.mnValueIndex);
+		}
+
+		bool equals(const hash_trie_iterator<Value, false, Node>& x) const
+		{
+			if(mnDepth < 0)
+				return (x.mnDepth < 0);
+			return (x.mnDepth >= 0) && (mpNodeStack[mnDepth] == x.mpNodeStack[x.mnDepth]) && (mnValueIndex == x.mnValueIndex);
+		}
+
+	protected:
+		// Moves to the first value of the next node which has any values, or to the end.
+		void DoAdvanceNode()
+		{
+			while(mnDepth >= 0)
+			{
+				const Node* const pNode = mpNodeStack[mnDepth];
+
+				if(((uint32_t)mnDepth + 1 < kHashTrieMaxDepth) && (mnChildStack[mnDepth] < layout_type::GetNodeCount(pNode)))
+				{
+					const uint32_t nDataCount = layout_type::GetDataCount(pNode, (uint32_t)mnDepth);
+					const Node*    pChild     = layout_type::GetChildren(pNode, nDataCount)[mnChildStack[mnDepth]++];
+
+					mpNodeStack[++mnDepth] = pChild;
+					mnChildStack[mnDepth]  = 0;
+					mnValueIndex           = 0;
+
+					if(layout_type::GetDataCount(pChild, (uint32_t)mnDepth))
+						return;
+				}
+				else
+					--mnDepth;
+			}
+
+			mnValueIndex = 0;
+		}
+
+	}; // hash_trie_iterator
+
+
+	template <typename Value, bool bConstA, bool bConstB, typename Node>
+	inline bool operator==(const hash_trie_iterator<Value, bConstA, Node>& a, const hash_trie_iterator<Value, bConstB, Node>& b)
+		{ return a.equals(b); }
+
+	template <typename Value, bool bConstA, bool bConstB, typename Node>
+	inline bool operator!=(const hash_trie_iterator<Value, bConstA, Node>& a, const hash_trie_iterator<Value, bConstB, Node>& b)
+		{ return !a.equals(b); }
+
+
+
+	namespace Internal
+	{
+		// Value construction policies used by hash_trie::DoInsert. The new value is
+		// always constructed before the trie is modified, so that a throwing
+		// constructor leaves the container unchanged.
+
+		template <typename Value>
+		struct hash_trie_copy_construct
+		{
+			const Value& mValue;
+			explicit hash_trie_copy_construct(const Value& value) : mValue(value) { }
+			void operator()(void* p) const { ::new(p) Value(mValue); }
+		};
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			template <typename Value>
+			struct hash_trie_move_construct
+			{
+				Value& mValue;
+				explicit hash_trie_move_construct(Value& value) : mValue(value) { }
+				void operator()(void* p) const { ::new(p) Value(eastl::move(mValue)); }
+			};
+		#endif
+
+		template <typename Value, typename Key>
+		struct hash_trie_key_construct
+		{
+			const Key& mKey;
+			explicit hash_trie_key_construct(const Key& key) : mKey(key) { }
+			void operator()(void* p) const { ::new(p) Value(mKey, typename Value::second_type()); }
+		};
+	}
+
+
+
+	/// hash_trie
+	///
+	/// Implements the hash trie. This is not meant to be used directly; use
+	/// hash_trie_map or hash_trie_set instead. Keys are always unique.
+	///
+	/// Template parameters:
+	///     Key            The key type. For sets this is the same as Value.
+	///     Value          The value type. For maps this is pair<const Key, T>.
+	///     Allocator      An EASTL allocator. All nodes are allocated from it.
+	///     ExtractKey     Returns the key from a value (useSelf or useFirst).
+	///     Equal          Key equality predicate.
+	///     Hash           Key hash function, returning size_t.
+	///
+	template <typename Key, typename Value, typename Allocator, typename ExtractKey, typename Equal, typename Hash>
+	class hash_trie
+	{
+	public:
+		typedef hash_trie<Key, Value, Allocator, ExtractKey, Equal, Hash>  this_type;
+		typedef Key                                                        key_type;
+		typedef Value                                                      value_type;
+		typedef value_type&                                                reference;
+		typedef const value_type&                                          const_reference;
+		typedef eastl_size_t                                               size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef ptrdiff_t                                                  difference_type;
+		typedef Allocator                                                  allocator_type;
+		typedef Hash                                                       hasher;
+		typedef Equal                                                      key_equal;
+		typedef hash_trie_iterator<value_type, false>                      iterator;
+		typedef hash_trie_iterator<value_type, true>                       const_iterator;
+		typedef eastl::pair<iterator, bool>                                insert_return_type;
+		typedef hash_trie_node                                             node_type;
+		typedef hash_trie_layout<value_type>                               layout_type;
+
+	public:
+		hash_trie(const Hash& hashFunction, const Equal& equal, const ExtractKey& extractKey, const allocator_type& allocator);
+		hash_trie(const this_type& x);
+	   ~hash_trie();
+
+		this_type& operator=(const this_type& x);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			hash_trie(this_type&& x);
+			this_type& operator=(this_type&& x);
+		#endif
+
+		void swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT;
+		allocator_type&       getAllocator() EASTL_NOEXCEPT;
+		void                  setAllocator(const allocator_type& allocator);
+
+		iterator       begin() EASTL_NOEXCEPT;
+		const_iterator begin() const EASTL_NOEXCEPT;
+		const_iterator cbegin() const EASTL_NOEXCEPT;
+
+		iterator       end() EASTL_NOEXCEPT;
+		const_iterator end() const EASTL_NOEXCEPT;
+		const_iterator cend() const EASTL_NOEXCEPT;
+
+		bool      empty() const EASTL_NOEXCEPT;
+		size_type size() const EASTL_NOEXCEPT;
+
+		hasher    hash_function() const;
+		key_equal key_eq() const;
+
+		insert_return_type insert(const value_type& value);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			insert_return_type insert(value_type&& value);
+		#endif
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last);
+
+		size_type erase(const key_type& key);
+		void      erase(const_iterator position);     // Unlike hashtable::erase, this doesn't return the next iterator, as erase can restructure the trie.
+
+		void clear();
+
+		iterator       find(const key_type& key);
+		const_iterator find(const key_type& key) const;
+		size_type      count(const key_type& key) const;
+
+		// Returns a pointer to the value with the given key, or NULL. This is
+		// cheaper than find, as it doesn't need to build an iterator path.
+		value_type*       find_value(const key_type& key);
+		const value_type* find_value(const key_type& key) const;
+
+		// Returns the number of bytes allocated by the trie, which is useful
+		// for comparing its footprint against other containers.
+		size_type memory_usage() const;
+
+		bool validate() const;
+		int  validateIterator(const_iterator i) const;
+
+	protected:
+		template <typename Constructor>
+		insert_return_type DoInsert(const key_type& key, const Constructor& construct);
+
+		const value_type* DoFind(const key_type& key, const_iterator* pIterator) const;
+
+		node_type* DoAllocateNode(uint32_t nDataCount, uint32_t nNodeCount);
+		void       DoFreeNode(node_type* pNode, uint32_t nDataCount, uint32_t nNodeCount);
+		template <typename Constructor>
+		void       DoConstructValue(node_type* pNode, uint32_t nDataCount, uint32_t nNodeCount, value_type* pValue, const Constructor& construct);
+		void       DoDestroyTree(node_type* pNode, uint32_t depth);
+		node_type* DoCopyTree(const node_type* pNode, uint32_t depth);
+		node_type* DoCreatePairNode(void* pNewValueOut[1], value_type& oldValue, size_t newHash, size_t oldHash, uint32_t depth);
+		int        DoErase(node_type*& pNode, const key_type& key, size_t h, uint32_t depth);
+		size_type  DoMemoryUsage(const node_type* pNode, uint32_t depth) const;
+		size_type  DoValidate(const node_type* pNode, uint32_t depth, size_t hashPrefix) const;
+
+		enum EraseResult
+		{
+			kEraseNotFound,     // The key wasn't found; nothing changed.
+			kEraseModified,     // The node was modified (and possibly reallocated).
+			kEraseEmptied,      // The node became empty and was freed; the parent must drop it.
+			kEraseSingleValue   // The node now has exactly one value and no children; the parent should inline it.
+		};
+
+	protected:
+		node_type*     mpRoot;
+		size_type      mnElementCount;
+		Hash           mHash;
+		Equal          mEqual;
+		ExtractKey     mExtractKey;
+		allocator_type mAllocator;
+
+	}; // class hash_trie
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// hash_trie
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline hash_trie<K, V, A, EK, Eq, H>::hash_trie(const H& hashFunction, const Eq& equal, const EK& extractKey, const allocator_type& allocator)
+		: mpRoot(NULL), mnElementCount(0), mHash(hashFunction), mEqual(equal), mExtractKey(extractKey), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline hash_trie<K, V, A, EK, Eq, H>::hash_trie(const this_type& x)
+		: mpRoot(NULL), mnElementCount(x.mnElementCount), mHash(x.mHash), mEqual(x.mEqual), mExtractKey(x.mExtractKey), mAllocator(x.mAllocator)
+	{
+		if(x.mpRoot)
+			mpRoot = DoCopyTree(x.mpRoot, 0);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline hash_trie<K, V, A, EK, Eq, H>::~hash_trie()
+	{
+		clear();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	typename hash_trie<K, V, A, EK, Eq, H>::this_type&
+	hash_trie<K, V, A, EK, Eq, H>::operator=(const this_type& x)
+	{
+		if(this != &x)
+		{
+			clear();
+
+			#if EASTL_ALLOCATOR_COPY_ENABLED
+				mAllocator = x.mAllocator;
+			#endif
+
+			mHash       = x.mHash;
+			mEqual      = x.mEqual;
+			mExtractKey = x.mExtractKey;
+
+			if(x.mpRoot)
+				mpRoot = DoCopyTree(x.mpRoot, 0);
+			mnElementCount = x.mnElementCount;
+		}
+
+		return *this;
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+		inline hash_trie<K, V, A, EK, Eq, H>::hash_trie(this_type&& x)
+			: mpRoot(NULL), mnElementCount(0), mHash(x.mHash), mEqual(x.mEqual), mExtractKey(x.mExtractKey), mAllocator(x.mAllocator)
+		{
+			swap(x);
+		}
+
+
+		template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+		inline typename hash_trie<K, V, A, EK, Eq, H>::this_type&
+		hash_trie<K, V, A, EK, Eq, H>::operator=(this_type&& x)
+		{
+			if(this != &x)
+			{
+				clear();
+				swap(x);
+			}
+			return *this;
+		}
+	#endif
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline void hash_trie<K, V, A, EK, Eq, H>::swap(this_type& x)
+	{
+		eastl::swap(mpRoot,         x.mpRoot);
+		eastl::swap(mnElementCount, x.mnElementCount);
+		eastl::swap(mHash,          x.mHash);
+		eastl::swap(mEqual,         x.mEqual);
+		eastl::swap(mExtractKey,    x.mExtractKey);
+		eastl::swap(mAllocator,     x.mAllocator); // We do this even if EASTL_ALLOCATOR_COPY_ENABLED is 0.
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline const typename hash_trie<K, V, A, EK, Eq, H>::allocator_type&
+	hash_trie<K, V, A, EK, Eq, H>::getAllocator() const EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::allocator_type&
+	hash_trie<K, V, A, EK, Eq, H>::getAllocator() EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline void hash_trie<K, V, A, EK, Eq, H>::setAllocator(const allocator_type& allocator)
+	{
+		EASTL_ASSERT(mpRoot == NULL); // The allocator can only be changed while the container is empty.
+		mAllocator = allocator;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::iterator
+	hash_trie<K, V, A, EK, Eq, H>::begin() EASTL_NOEXCEPT
+	{
+		return iterator(mpRoot);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::const_iterator
+	hash_trie<K, V, A, EK, Eq, H>::begin() const EASTL_NOEXCEPT
+	{
+		return const_iterator(mpRoot);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::const_iterator
+	hash_trie<K, V, A, EK, Eq, H>::cbegin() const EASTL_NOEXCEPT
+	{
+		return const_iterator(mpRoot);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::iterator
+	hash_trie<K, V, A, EK, Eq, H>::end() EASTL_NOEXCEPT
+	{
+		return iterator();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::const_iterator
+	hash_trie<K, V, A, EK, Eq, H>::end() const EASTL_NOEXCEPT
+	{
+		return const_iterator();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::const_iterator
+	hash_trie<K, V, A, EK, Eq, H>::cend() const EASTL_NOEXCEPT
+	{
+		return const_iterator();
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline bool hash_trie<K, V, A, EK, Eq, H>::empty() const EASTL_NOEXCEPT
+	{
+		return (mnElementCount == 0);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::size_type
+	hash_trie<K, V, A, EK, Eq, H>::size() const EASTL_NOEXCEPT
+	{
+		return mnElementCount;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::hasher
+	hash_trie<K, V, A, EK, Eq, H>::hash_function() const
+	{
+		return mHash;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::key_equal
+	hash_trie<K, V, A, EK, Eq, H>::key_eq() const
+	{
+		return mEqual;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::insert_return_type
+	hash_trie<K, V, A, EK, Eq, H>::insert(const value_type& value)
+	{
+		return DoInsert(mExtractKey(value), Internal::hash_trie_copy_construct<value_type>(value));
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+		inline typename hash_trie<K, V, A, EK, Eq, H>::insert_return_type
+		hash_trie<K, V, A, EK, Eq, H>::insert(value_type&& value)
+		{
+			return DoInsert(mExtractKey(value), Internal::hash_trie_move_construct<value_type>(value));
+		}
+	#endif
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	template <typename InputIterator>
+	inline void hash_trie<K, V, A, EK, Eq, H>::insert(InputIterator first, InputIterator last)
+	{
+		for(; first != last; ++first)
+			insert(*first);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	typename hash_trie<K, V, A, EK, Eq, H>::size_type
+	hash_trie<K, V, A, EK, Eq, H>::erase(const key_type& key)
+	{
+		if(mpRoot)
+		{
+			const int result = DoErase(mpRoot, key, mHash(key), 0);
+
+			if(result != kEraseNotFound)
+			{
+				--mnElementCount;
+				return 1;
+			}
+		}
+
+		return 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline void hash_trie<K, V, A, EK, Eq, H>::erase(const_iterator position)
+	{
+		const key_type key(mExtractKey(*position)); // We need a copy, as the value is destroyed during the erase.
+		erase(key);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline void hash_trie<K, V, A, EK, Eq, H>::clear()
+	{
+		if(mpRoot)
+		{
+			DoDestroyTree(mpRoot, 0);
+			mpRoot = NULL;
+		}
+		mnElementCount = 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::iterator
+	hash_trie<K, V, A, EK, Eq, H>::find(const key_type& key)
+	{
+		iterator it;
+		DoFind(key, reinterpret_cast<const_iterator*>(&it)); // The two iterator types have identical layout.
+		return it;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::const_iterator
+	hash_trie<K, V, A, EK, Eq, H>::find(const key_type& key) const
+	{
+		const_iterator it;
+		DoFind(key, &it);
+		return it;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::size_type
+	hash_trie<K, V, A, EK, Eq, H>::count(const key_type& key) const
+	{
+		return DoFind(key, NULL) ? 1 : 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::value_type*
+	hash_trie<K, V, A, EK, Eq, H>::find_value(const key_type& key)
+	{
+		return const_cast<value_type*>(DoFind(key, NULL));
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline const typename hash_trie<K, V, A, EK, Eq, H>::value_type*
+	hash_trie<K, V, A, EK, Eq, H>::find_value(const key_type& key) const
+	{
+		return DoFind(key, NULL);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	const typename hash_trie<K, V, A, EK, Eq, H>::value_type*
+	hash_trie<K, V, A, EK, Eq, H>::DoFind(const key_type& key, const_iterator* pIterator) const
+	{
+		const node_type* pNode = mpRoot;
+		size_t           h     = mHash(key);
+
+		for(uint32_t depth = 0; pNode; ++depth, h >>= kHashTrieBitsPerLevel)
+		{
+			if(pIterator)
+			{
+				pIterator->mpNodeStack[depth]  = pNode;
+				pIterator->mnChildStack[depth] = 0;
+			}
+
+			if((depth + 1) == kHashTrieMaxDepth) // If this is a collision node...
+			{
+				const value_type* const pValues = layout_type::GetValues(pNode);
+
+				for(uint32_t i = 0; i < pNode->mDataMap; ++i)
+				{
+					if(mEqual(mExtractKey(pValues[i]), key))
+					{
+						if(pIterator)
+						{
+							pIterator->mnDepth      = (int32_t)depth;
+							pIterator->mnValueIndex = i;
+						}
+						return pValues + i;
+					}
+				}
+				break;
+			}
+
+			const uint32_t bit = 1u << (h & kHashTrieLevelMask);
+
+			if(pNode->mDataMap & bit)
+			{
+				const uint32_t          i      = (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1));
+				const value_type* const pValue = layout_type::GetValues(pNode) + i;
+
+				if(mEqual(mExtractKey(*pValue), key))
+				{
+					if(pIterator)
+					{
+						pIterator->mnDepth      = (int32_t)depth;
+						pIterator->mnValueIndex = i;
+					}
+					return pValue;
+				}
+				break;
+			}
+			else if(pNode->mNodeMap & bit)
+			{
+				const uint32_t j = (uint32_t)eastl::popcount(pNode->mNodeMap & (bit - 1));
+
+				if(pIterator) // Iteration resumes after this child, so that ++ continues correctly from the found value.
+					pIterator->mnChildStack[depth] = j + 1;
+
+				pNode = layout_type::GetChildren(pNode, (uint32_t)eastl::popcount(pNode->mDataMap))[j];
+			}
+			else
+				break;
+		}
+
+		return NULL;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::node_type*
+	hash_trie<K, V, A, EK, Eq, H>::DoAllocateNode(uint32_t nDataCount, uint32_t nNodeCount)
+	{
+		node_type* const pNode = (node_type*)allocate_memory(mAllocator, layout_type::GetNodeSize(nDataCount, nNodeCount), layout_type::kNodeAlignment, 0);
+		EASTL_ASSERT(pNode != NULL);
+		return pNode;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline void hash_trie<K, V, A, EK, Eq, H>::DoFreeNode(node_type* pNode, uint32_t nDataCount, uint32_t nNodeCount)
+	{
+		EASTLFree(mAllocator, pNode, layout_type::GetNodeSize(nDataCount, nNodeCount));
+	}
+
+
+	// Constructs a value in a node that was just allocated, freeing the node if the construction throws.
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	template <typename Constructor>
+	inline void hash_trie<K, V, A, EK, Eq, H>::DoConstructValue(node_type* pNode, uint32_t nDataCount, uint32_t nNodeCount, value_type* pValue, const Constructor& construct)
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				construct(pValue);
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				DoFreeNode(pNode, nDataCount, nNodeCount);
+				throw;
+			}
+		#else
+			EA_UNUSED(pNode); EA_UNUSED(nDataCount); EA_UNUSED(nNodeCount);
+		#endif
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	void hash_trie<K, V, A, EK, Eq, H>::DoDestroyTree(node_type* pNode, uint32_t depth)
+	{
+		const uint32_t nDataCount = layout_type::GetDataCount(pNode, depth);
+		const uint32_t nNodeCount = layout_type::GetNodeCount(pNode);
+		value_type*    pValues    = layout_type::GetValues(pNode);
+		node_type**    pChildren  = layout_type::GetChildren(pNode, nDataCount);
+
+		for(uint32_t i = 0; i < nDataCount; ++i)
+			pValues[i].~value_type();
+
+		for(uint32_t j = 0; j < nNodeCount; ++j)
+			DoDestroyTree(pChildren[j], depth + 1);
+
+		DoFreeNode(pNode, nDataCount, nNodeCount);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	typename hash_trie<K, V, A, EK, Eq, H>::node_type*
+	hash_trie<K, V, A, EK, Eq, H>::DoCopyTree(const node_type* pNode, uint32_t depth)
+	{
+		const uint32_t nDataCount = layout_type::GetDataCount(pNode, depth);
+		const uint32_t nNodeCount = layout_type::GetNodeCount(pNode);
+		node_type*     pNew       = DoAllocateNode(nDataCount, nNodeCount);
+
+		*pNew = *pNode;
+		eastl::uninitializedCopyPtr(layout_type::GetValues(pNode), layout_type::GetValues(pNode) + nDataCount, layout_type::GetValues(pNew));
+
+		node_type** const pChildrenSrc  = layout_type::GetChildren(pNode, nDataCount);
+		node_type** const pChildrenDest = layout_type::GetChildren(pNew, nDataCount);
+
+		for(uint32_t j = 0; j < nNodeCount; ++j)
+			pChildrenDest[j] = DoCopyTree(pChildrenSrc[j], depth + 1);
+
+		return pNew;
+	}
+
+
+	// Creates the subtree which resolves a collision between an existing value and a
+	// new one whose hashes agree in all bits consumed so far. Returns the root of the
+	// subtree, and sets pNewValueOut to the uninitialized slot for the new value.
+	// The old value is moved into the subtree.
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	typename hash_trie<K, V, A, EK, Eq, H>::node_type*
+	hash_trie<K, V, A, EK, Eq, H>::DoCreatePairNode(void* pNewValueOut[1], value_type& oldValue, size_t newHash, size_t oldHash, uint32_t depth)
+	{
+		if((depth + 1) == kHashTrieMaxDepth) // If we've run out of hash bits...
+		{
+			node_type* const pNode = DoAllocateNode(2, 0);
+			pNode->mDataMap = 2;
+			pNode->mNodeMap = 0;
+			::new((void*)layout_type::GetValues(pNode)) value_type(eastl::move(oldValue));
+			pNewValueOut[0] = layout_type::GetValues(pNode) + 1;
+			return pNode;
+		}
+
+		const uint32_t newBit = 1u << (newHash & kHashTrieLevelMask);
+		const uint32_t oldBit = 1u << (oldHash & kHashTrieLevelMask);
+
+		if(newBit != oldBit)
+		{
+			node_type* const pNode = DoAllocateNode(2, 0);
+			pNode->mDataMap = newBit | oldBit;
+			pNode->mNodeMap = 0;
+
+			value_type* const pValues = layout_type::GetValues(pNode);
+			const uint32_t    oldIndex = (oldBit < newBit) ? 0 : 1;
+
+			::new((void*)(pValues + oldIndex)) value_type(eastl::move(oldValue));
+			pNewValueOut[0] = pValues + (oldIndex ^ 1);
+			return pNode;
+		}
+
+		// The hashes agree at this level as well; create a single-child node and descend.
+		// With a good hash function this is rare.
+		node_type* const pChild = DoCreatePairNode(pNewValueOut, oldValue, newHash >> kHashTrieBitsPerLevel, oldHash >> kHashTrieBitsPerLevel, depth + 1);
+		node_type* const pNode  = DoAllocateNode(0, 1);
+		pNode->mDataMap = 0;
+		pNode->mNodeMap = newBit;
+		layout_type::GetChildren(pNode, 0)[0] = pChild;
+		return pNode;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	template <typename Constructor>
+	typename hash_trie<K, V, A, EK, Eq, H>::insert_return_type
+	hash_trie<K, V, A, EK, Eq, H>::DoInsert(const key_type& key, const Constructor& construct)
+	{
+		const size_t fullHash = mHash(key);
+		iterator     it;
+
+		if(!mpRoot)
+		{
+			node_type* const pNode = DoAllocateNode(1, 0);
+			DoConstructValue(pNode, 1, 0, layout_type::GetValues(pNode), construct);
+			pNode->mDataMap = 1u << (fullHash & kHashTrieLevelMask);
+			pNode->mNodeMap = 0;
+			mpRoot = pNode;
+			++mnElementCount;
+
+			it.mpNodeStack[0]  = mpRoot;
+			it.mnChildStack[0] = 0;
+			it.mnDepth         = 0;
+			it.mnValueIndex    = 0;
+			return insert_return_type(it, true);
+		}
+
+		node_type** ppSlot = &mpRoot;
+		size_t      h      = fullHash;
+		uint32_t    depth  = 0;
+
+		for(;; ++depth, h >>= kHashTrieBitsPerLevel)
+		{
+			node_type* const pNode      = *ppSlot;
+			const uint32_t   nDataCount = layout_type::GetDataCount(pNode, depth);
+			const uint32_t   nNodeCount = layout_type::GetNodeCount(pNode);
+			value_type*      pValues    = layout_type::GetValues(pNode);
+
+			it.mpNodeStack[depth]  = pNode;
+			it.mnChildStack[depth] = 0;
+
+			if((depth + 1) == kHashTrieMaxDepth) // Collision node: linear search, then append.
+			{
+				for(uint32_t i = 0; i < nDataCount; ++i)
+				{
+					if(mEqual(mExtractKey(pValues[i]), key))
+					{
+						it.mnDepth = (int32_t)depth; it.mnValueIndex = i;
+						return insert_return_type(it, false);
+					}
+				}
+
+				node_type* const pNew = DoAllocateNode(nDataCount + 1, 0);
+				DoConstructValue(pNew, nDataCount + 1, 0, layout_type::GetValues(pNew) + nDataCount, construct);
+				pNew->mDataMap = nDataCount + 1;
+				pNew->mNodeMap = 0;
+				eastl::uninitializedMove_ptr_if_noexcept(pValues, pValues + nDataCount, layout_type::GetValues(pNew));
+				eastl::destruct(pValues, pValues + nDataCount);
+				DoFreeNode(pNode, nDataCount, 0);
+				*ppSlot = pNew;
+				++mnElementCount;
+
+				it.mpNodeStack[depth] = pNew;
+				it.mnDepth = (int32_t)depth; it.mnValueIndex = nDataCount;
+				return insert_return_type(it, true);
+			}
+
+			const uint32_t bit = 1u << (h & kHashTrieLevelMask);
+
+			if(pNode->mDataMap & bit)
+			{
+				const uint32_t i = (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1));
+
+				if(mEqual(mExtractKey(pValues[i]), key))
+				{
+					it.mnDepth = (int32_t)depth; it.mnValueIndex = i;
+					return insert_return_type(it, false);
+				}
+
+				// Collision within this slot: replace the value with a subtree holding both values.
+				// We construct the new value first, so that if it throws nothing has changed.
+				const uint32_t j = (uint32_t)eastl::popcount(pNode->mNodeMap & (bit - 1));
+
+				node_type* const pSubtreeTemp = DoAllocateNode(1, 0); // Holds the new value until the subtree exists.
+				DoConstructValue(pSubtreeTemp, 1, 0, layout_type::GetValues(pSubtreeTemp), construct);
+
+				node_type* const pNew = DoAllocateNode(nDataCount - 1, nNodeCount + 1);
+				void*            pNewValue[1];
+
+				const size_t     oldHash  = mHash(mExtractKey(pValues[i])) >> ((depth + 1) * kHashTrieBitsPerLevel);
+				node_type* const pSubtree = DoCreatePairNode(pNewValue, pValues[i], h >> kHashTrieBitsPerLevel, oldHash, depth + 1);
+
+				::new(pNewValue[0]) value_type(eastl::move(*layout_type::GetValues(pSubtreeTemp)));
+				layout_type::GetValues(pSubtreeTemp)->~value_type();
+				DoFreeNode(pSubtreeTemp, 1, 0);
+
+				value_type* const pNewValues   = layout_type::GetValues(pNew);
+				node_type** const pOldChildren = layout_type::GetChildren(pNode, nDataCount);
+				node_type** const pNewChildren = layout_type::GetChildren(pNew, nDataCount - 1);
+
+				pNew->mDataMap = pNode->mDataMap & ~bit;
+				pNew->mNodeMap = pNode->mNodeMap | bit;
+				eastl::uninitializedMove_ptr_if_noexcept(pValues, pValues + i, pNewValues);
+				eastl::uninitializedMove_ptr_if_noexcept(pValues + i + 1, pValues + nDataCount, pNewValues + i);
+				eastl::copy(pOldChildren, pOldChildren + j, pNewChildren);
+				pNewChildren[j] = pSubtree;
+				eastl::copy(pOldChildren + j, pOldChildren + nNodeCount, pNewChildren + j + 1);
+
+				eastl::destruct(pValues, pValues + nDataCount);
+				DoFreeNode(pNode, nDataCount, nNodeCount);
+				*ppSlot = pNew;
+				++mnElementCount;
+
+				// The subtree is a chain of single-child nodes ending in the node that holds
+				// both values. Walk down it to build the iterator. The key can't be looked up
+				// again, as for an rvalue insert it refers to the value we moved from.
+				it.mpNodeStack[depth]  = pNew;
+				it.mnChildStack[depth] = j + 1;
+
+				const node_type* pChild = pSubtree;
+				uint32_t         d      = depth + 1;
+
+				for(; pChild->mDataMap == 0; ++d)
+				{
+					it.mpNodeStack[d]  = pChild;
+					it.mnChildStack[d] = 1;
+					pChild = layout_type::GetChildren(pChild, 0)[0];
+				}
+
+				it.mpNodeStack[d]  = pChild;
+				it.mnChildStack[d] = 0;
+				it.mnDepth         = (int32_t)d;
+				it.mnValueIndex    = (uint32_t)((value_type*)pNewValue[0] - layout_type::GetValues(pChild));
+				return insert_return_type(it, true);
+			}
+			else if(pNode->mNodeMap & bit)
+			{
+				const uint32_t j = (uint32_t)eastl::popcount(pNode->mNodeMap & (bit - 1));
+				it.mnChildStack[depth] = j + 1;
+				ppSlot = layout_type::GetChildren(pNode, nDataCount) + j;
+			}
+			else
+			{
+				// Empty slot: reallocate this node with the value inserted.
+				const uint32_t   i    = (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1));
+				node_type* const pNew = DoAllocateNode(nDataCount + 1, nNodeCount);
+				value_type* const pNewValues = layout_type::GetValues(pNew);
+
+				DoConstructValue(pNew, nDataCount + 1, nNodeCount, pNewValues + i, construct);
+				pNew->mDataMap = pNode->mDataMap | bit;
+				pNew->mNodeMap = pNode->mNodeMap;
+				eastl::uninitializedMove_ptr_if_noexcept(pValues, pValues + i, pNewValues);
+				eastl::uninitializedMove_ptr_if_noexcept(pValues + i, pValues + nDataCount, pNewValues + i + 1);
+				eastl::copy(layout_type::GetChildren(pNode, nDataCount), layout_type::GetChildren(pNode, nDataCount) + nNodeCount, layout_type::GetChildren(pNew, nDataCount + 1));
+
+				eastl::destruct(pValues, pValues + nDataCount);
+				DoFreeNode(pNode, nDataCount, nNodeCount);
+				*ppSlot = pNew;
+				++mnElementCount;
+
+				it.mpNodeStack[depth] = pNew;
+				it.mnDepth = (int32_t)depth; it.mnValueIndex = i;
+				return insert_return_type(it, true);
+			}
+		}
+	}
+
+
+	// Erases key from the subtree rooted at pNode, reallocating pNode as needed.
+	// Keeps the trie in canonical form: no non-root node is left with a single
+	// value and no children, as such a value is moved up into its parent.
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	int hash_trie<K, V, A, EK, Eq, H>::DoErase(node_type*& pNode, const key_type& key, size_t h, uint32_t depth)
+	{
+		const uint32_t    nDataCount = layout_type::GetDataCount(pNode, depth);
+		const uint32_t    nNodeCount = layout_type::GetNodeCount(pNode);
+		value_type* const pValues    = layout_type::GetValues(pNode);
+		node_type** const pChildren  = layout_type::GetChildren(pNode, nDataCount);
+
+		uint32_t i;       // Index of the value to remove, if any.
+		uint32_t bit = 0; // Bit of the value to remove (unused for collision nodes).
+
+		if((depth + 1) == kHashTrieMaxDepth)
+		{
+			for(i = 0; (i < nDataCount) && !mEqual(mExtractKey(pValues[i]), key); ++i)
+				{ }
+
+			if(i == nDataCount)
+				return kEraseNotFound;
+		}
+		else
+		{
+			bit = 1u << (h & kHashTrieLevelMask);
+
+			if(pNode->mNodeMap & bit)
+			{
+				const uint32_t j      = (uint32_t)eastl::popcount(pNode->mNodeMap & (bit - 1));
+				const int      result = DoErase(pChildren[j], key, h >> kHashTrieBitsPerLevel, depth + 1);
+
+				if((result == kEraseNotFound) || (result == kEraseModified))
+					return result;
+
+				// The child either vanished or is down to a single value which we inline here.
+				node_type* const pChild = pChildren[j];
+				const bool       bInline = (result == kEraseSingleValue);
+				const uint32_t   iNew    = (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1));
+				const uint32_t   nNewDataCount = nDataCount + (bInline ? 1 : 0);
+
+				if((nNewDataCount + nNodeCount - 1) == 0) // If this node is now empty...
+				{
+					DoFreeNode(pNode, nDataCount, nNodeCount);
+					pNode = NULL;
+					return kEraseEmptied;
+				}
+
+				node_type* const  pNew        = DoAllocateNode(nNewDataCount, nNodeCount - 1);
+				value_type* const pNewValues  = layout_type::GetValues(pNew);
+				node_type** const pNewChildren = layout_type::GetChildren(pNew, nNewDataCount);
+
+				pNew->mDataMap = bInline ? (pNode->mDataMap | bit) : pNode->mDataMap;
+				pNew->mNodeMap = pNode->mNodeMap & ~bit;
+
+				if(bInline)
+				{
+					value_type* const pChildValue = layout_type::GetValues(pChild);
+
+					eastl::uninitializedMove_ptr_if_noexcept(pValues, pValues + iNew, pNewValues);
+					::new((void*)(pNewValues + iNew)) value_type(eastl::move(*pChildValue));
+					eastl::uninitializedMove_ptr_if_noexcept(pValues + iNew, pValues + nDataCount, pNewValues + iNew + 1);
+
+					pChildValue->~value_type();
+					DoFreeNode(pChild, 1, 0);
+				}
+				else
+					eastl::uninitializedMove_ptr_if_noexcept(pValues, pValues + nDataCount, pNewValues);
+
+				eastl::copy(pChildren, pChildren + j, pNewChildren);
+				eastl::copy(pChildren + j + 1, pChildren + nNodeCount, pNewChildren + j);
+
+				eastl::destruct(pValues, pValues + nDataCount);
+				DoFreeNode(pNode, nDataCount, nNodeCount);
+				pNode = pNew;
+
+				return ((depth > 0) && (nNewDataCount == 1) && (nNodeCount == 1)) ? kEraseSingleValue : kEraseModified;
+			}
+
+			if(!(pNode->mDataMap & bit))
+				return kEraseNotFound;
+
+			i = (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1));
+
+			if(!mEqual(mExtractKey(pValues[i]), key))
+				return kEraseNotFound;
+		}
+
+		// Remove value i from this node.
+		if((nDataCount + nNodeCount) == 1)
+		{
+			pValues[0].~value_type();
+			DoFreeNode(pNode, 1, 0);
+			pNode = NULL;
+			return kEraseEmptied;
+		}
+
+		node_type* const  pNew       = DoAllocateNode(nDataCount - 1, nNodeCount);
+		value_type* const pNewValues = layout_type::GetValues(pNew);
+
+		pNew->mDataMap = ((depth + 1) == kHashTrieMaxDepth) ? (nDataCount - 1) : (pNode->mDataMap & ~bit);
+		pNew->mNodeMap = pNode->mNodeMap;
+		eastl::uninitializedMove_ptr_if_noexcept(pValues, pValues + i, pNewValues);
+		eastl::uninitializedMove_ptr_if_noexcept(pValues + i + 1, pValues + nDataCount, pNewValues + i);
+		eastl::copy(pChildren, pChildren + nNodeCount, layout_type::GetChildren(pNew, nDataCount - 1));
+
+		eastl::destruct(pValues, pValues + nDataCount);
+		DoFreeNode(pNode, nDataCount, nNodeCount);
+		pNode = pNew;
+
+		return ((depth > 0) && (nDataCount == 2) && (nNodeCount == 0)) ? kEraseSingleValue : kEraseModified;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline typename hash_trie<K, V, A, EK, Eq, H>::size_type
+	hash_trie<K, V, A, EK, Eq, H>::memory_usage() const
+	{
+		return mpRoot ? DoMemoryUsage(mpRoot, 0) : 0;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	typename hash_trie<K, V, A, EK, Eq, H>::size_type
+	hash_trie<K, V, A, EK, Eq, H>::DoMemoryUsage(const node_type* pNode, uint32_t depth) const
+	{
+		const uint32_t nDataCount = layout_type::GetDataCount(pNode, depth);
+		const uint32_t nNodeCount = layout_type::GetNodeCount(pNode);
+		size_type      n          = (size_type)layout_type::GetNodeSize(nDataCount, nNodeCount);
+
+		for(uint32_t j = 0; j < nNodeCount; ++j)
+			n += DoMemoryUsage(layout_type::GetChildren(pNode, nDataCount)[j], depth + 1);
+
+		return n;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline bool hash_trie<K, V, A, EK, Eq, H>::validate() const
+	{
+		if(!mpRoot)
+			return (mnElementCount == 0);
+		return DoValidate(mpRoot, 0, 0) == mnElementCount;
+	}
+
+
+	// Returns the number of values under pNode, or (size_type)-1 if the subtree is
+	// malformed: values in the wrong slot, overlapping bitmaps, or non-canonical nodes.
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	typename hash_trie<K, V, A, EK, Eq, H>::size_type
+	hash_trie<K, V, A, EK, Eq, H>::DoValidate(const node_type* pNode, uint32_t depth, size_t hashPrefix) const
+	{
+		const size_type   kInvalid   = (size_type)-1;
+		const uint32_t    nDataCount = layout_type::GetDataCount(pNode, depth);
+		const uint32_t    nNodeCount = layout_type::GetNodeCount(pNode);
+		const value_type* pValues    = layout_type::GetValues(pNode);
+		const size_t      prefixMask = (depth * kHashTrieBitsPerLevel < sizeof(size_t) * 8) ? (((size_t)1 << (depth * kHashTrieBitsPerLevel)) - 1) : ~(size_t)0;
+
+		if((depth > 0) && (nNodeCount == 0) && (nDataCount < 2))
+			return kInvalid;
+
+		if((depth + 1) == kHashTrieMaxDepth)
+		{
+			for(uint32_t i = 0; i < nDataCount; ++i)
+			{
+				if((mHash(mExtractKey(pValues[i])) & prefixMask) != hashPrefix)
+					return kInvalid;
+			}
+			return (pNode->mNodeMap == 0) ? nDataCount : kInvalid;
+		}
+
+		if(pNode->mDataMap & pNode->mNodeMap)
+			return kInvalid;
+
+		for(uint32_t i = 0, slot = 0; slot < 32; ++slot)
+		{
+			if(pNode->mDataMap & (1u << slot))
+			{
+				const size_t expected = hashPrefix | ((size_t)slot << (depth * kHashTrieBitsPerLevel));
+				const size_t mask     = prefixMask | ((size_t)kHashTrieLevelMask << (depth * kHashTrieBitsPerLevel));
+
+				if((mHash(mExtractKey(pValues[i++])) & mask) != expected)
+					return kInvalid;
+			}
+		}
+
+		size_type n = nDataCount;
+
+		for(uint32_t j = 0, slot = 0; slot < 32; ++slot)
+		{
+			if(pNode->mNodeMap & (1u << slot))
+			{
+				const size_type nChild = DoValidate(layout_type::GetChildren(pNode, nDataCount)[j++], depth + 1, hashPrefix | ((size_t)slot << (depth * kHashTrieBitsPerLevel)));
+
+				if(nChild == kInvalid)
+					return kInvalid;
+				n += nChild;
+			}
+		}
+
+		return n;
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	int hash_trie<K, V, A, EK, Eq, H>::validateIterator(const_iterator i) const
+	{
+		for(const_iterator temp = begin(), tempEnd = end(); temp != tempEnd; ++temp)
+		{
+			if(temp == i)
+				return (isf_valid | isf_current | isf_can_dereference);
+		}
+
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename A, typename EK, typename Eq, typename H>
+	inline void swap(hash_trie<K, V, A, EK, Eq, H>& a, hash_trie<K, V, A, EK, Eq, H>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
+
+
+#endif // Header include guard
@@ -781,6 +781,12 @@ namespace eastl
 	/// hash code.  This is useful for cases where the node's hash is
 	/// already known, allowing us to avoid a redundant hash operation
 	/// in the normal find path.
+	///
+	/// find(k, c), erase(k, c), insert_hinted_hash(c, value) and bucket_for_hash(c)
+	/// extend this to the other operations. The caller supplies the hash code that
+	/// hash_function() would return for the key, which is worthwhile when the key is
+	/// expensive to hash (e.g. a long string) and its hash is already at hand, such
+	/// as when one key is looked up in several tables. See also hashed_key.
 	/// 
 	template <typename Key, typename Value, typename Allocator, typename ExtractKey, 
 			  typename Equal, typename H1, typename H2, typename H, 
@@ -1016,6 +1022,18 @@ namespace eastl
 		// created by the user with the allocate_uninitialized_node function, and freed by the free_uninitialized_node function.
 		insert_return_type insert(hash_code_t c, node_type* pNodeNew, const value_type& value);
 
+		/// Inserts value, using c as the hash code of its key instead of computing it.
+		/// c must equal hash_function()(key), otherwise the element lands in the wrong bucket.
+		///
+		/// Example usage:
+		///     const size_t h = hashSet.hash_function()(s);
+		///     hashSetA.insert_hinted_hash(h, s);
+		///     hashSetB.insert_hinted_hash(h, s);
+		insert_return_type insert_hinted_hash(hash_code_t c, const value_type& value);
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			insert_return_type insert_hinted_hash(hash_code_t c, value_type&& value);
+		#endif
+
 		// Used to allocate and free memory used by insert(const value_type& value, hash_code_t c, node_type* pNodeNew).
 		node_type* allocate_uninitialized_node();
 		void       free_uninitialized_node(node_type* pNode);
@@ -1024,6 +1042,7 @@ namespace eastl
 		iterator         erase(const_iterator position);
 		iterator         erase(const_iterator first, const_iterator last);
 		size_type        erase(const key_type& k);
+		size_type        erase(const key_type& k, hash_code_t c);  // c is the precomputed hash code of k.
 
 		void clear();
 		void clear(bool clearBuckets);                  // If clearBuckets is true, we free the bucket memory and set the bucket count back to the newly constructed count.
@@ -1038,6 +1057,11 @@ namespace eastl
 		iterator       find(const key_type& key);
 		const_iterator find(const key_type& key) const;
 
+		/// Same as find(key), but uses c as the hash code of key instead of computing it.
+		/// This is the same as find_by_hash(key, c).
+		iterator       find(const key_type& key, hash_code_t c);
+		const_iterator find(const key_type& key, hash_code_t c) const;
+
 		/// Implements a find whereby the user supplies a comparison of a different type
 		/// than the hashtable value_type. A useful case of this is one whereby you have
 		/// a container of string objects but want to do searches via passing in char pointers.
@@ -1086,6 +1110,11 @@ namespace eastl
 		eastl::pair<iterator, iterator> find_range_by_hash(hash_code_t c);
 		eastl::pair<const_iterator, const_iterator> find_range_by_hash(hash_code_t c) const;
 
+		/// Returns the index of the bucket that an element with hash code c would be in,
+		/// for use with begin(n) / end(n). The bucket is only stable until the next rehash.
+		size_type bucket_for_hash(hash_code_t c) const EASTL_NOEXCEPT
+			{ return (size_type)bucket_index(c, (uint32_t)mnBucketCount); }
+
 		size_type count(const key_type& k) const EASTL_NOEXCEPT;
 
 		eastl::pair<iterator, iterator>             equalRange(const key_type& k);
@@ -1133,6 +1162,8 @@ namespace eastl
 
 		eastl::pair<iterator, bool> DoInsertKey(true_type, const key_type& key);
 		iterator                    DoInsertKey(false_type, const key_type& key);
+		eastl::pair<iterator, bool> DoInsertKey(true_type, const key_type& key, hash_code_t c);
+		iterator                    DoInsertKey(false_type, const key_type& key, hash_code_t c);
 
 		void       DoRehash(size_type nBucketCount);
 		node_type* DoFindNode(node_type* pNode, const key_type& k, hash_code_t c) const;
@@ -1545,11 +1576,7 @@ namespace eastl
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find(const key_type& k)
 	{
-		const hash_code_t c = get_hash_code(k);
-		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
-
-		node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
-		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		return find(k, get_hash_code(k));
 	}
 
 
@@ -1559,11 +1586,7 @@ namespace eastl
 	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find(const key_type& k) const
 	{
-		const hash_code_t c = get_hash_code(k);
-		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
-
-		node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
-		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		return find(k, get_hash_code(k));
 	}
 
 
@@ -1678,7 +1701,7 @@ namespace eastl
 		inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
 		hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_by_hash(const key_type& k, hash_code_t c)
 	{
-		const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		const size_type n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 
 		node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
 		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
@@ -1690,13 +1713,31 @@ namespace eastl
 		inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator
 		hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find_by_hash(const key_type& k, hash_code_t c) const
 	{
-		const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
+		const size_type n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 
 		node_type* const pNode = DoFindNode(mpBucketArray[n], k, c);
 		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find(const key_type& k, hash_code_t c)
+	{
+		return find_by_hash(k, c);
+	}
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::find(const key_type& k, hash_code_t c) const
+	{
+		return find_by_hash(k, c);
+	}
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq, 
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::const_iterator,
@@ -2391,7 +2432,16 @@ namespace eastl
 	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator, bool>
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertKey(true_type, const key_type& key) // true_type means bUniqueKeys is true.
 	{
-		const hash_code_t c     = get_hash_code(key);
+		return DoInsertKey(true_type(), key, get_hash_code(key));
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	eastl::pair<typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator, bool>
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertKey(true_type, const key_type& key, hash_code_t c)
+	{
 		size_type         n     = (size_type)bucket_index(key, c, (uint32_t)mnBucketCount);
 		node_type* const  pNode = DoFindNode(mpBucketArray[n], key, c);
 
@@ -2439,13 +2489,22 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertKey(false_type, const key_type& key) // false_type means bUniqueKeys is false.
+	{
+		return DoInsertKey(false_type(), key, get_hash_code(key));
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::DoInsertKey(false_type, const key_type& key, hash_code_t c)
 	{
 		const eastl::pair<bool, uint32_t> bRehash = mRehashPolicy.GetRehashRequired((uint32_t)mnBucketCount, (uint32_t)mnElementCount, (uint32_t)1);
 
 		if(bRehash.first)
 			DoRehash(bRehash.second);
 
-		const hash_code_t c = get_hash_code(key);
 		const size_type   n = (size_type)bucket_index(key, c, (uint32_t)mnBucketCount);
 
 		node_type* const pNodeNew = DoAllocateNodeFromKey(key);
@@ -2592,6 +2651,27 @@ namespace eastl
 	}
 
 
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::insert_return_type
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::insert_hinted_hash(hash_code_t c, const value_type& value)
+	{
+		return DoInsertValueExtra(has_unique_keys_type(), mExtractKey(value), c, NULL, value);
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename V, typename A, typename EK, typename Eq,
+				  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+		inline typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::insert_return_type
+		hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::insert_hinted_hash(hash_code_t c, value_type&& value)
+		{
+			const key_type& k = mExtractKey(value);
+			return DoInsertValueExtra(has_unique_keys_type(), k, c, NULL, eastl::move(value));
+		}
+	#endif
+
+
 	template <typename K, typename V, typename A, typename EK, typename Eq,
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::iterator
@@ -2682,12 +2762,21 @@ namespace eastl
 			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
 	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type 
 	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::erase(const key_type& k)
+	{
+		return erase(k, get_hash_code(k));
+	}
+
+
+
+	template <typename K, typename V, typename A, typename EK, typename Eq,
+			  typename H1, typename H2, typename H, typename RP, bool bC, bool bM, bool bU>
+	typename hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::size_type
+	hashtable<K, V, A, EK, Eq, H1, H2, H, RP, bC, bM, bU>::erase(const key_type& k, hash_code_t c)
 	{
 		// To do: Reimplement this function to do a single loop and not try to be 
 		// smart about element contiguity. The mechanism here is only a benefit if the 
 		// buckets are heavily overloaded; otherwise this mechanism may be slightly slower.
 
-		const hash_code_t c = get_hash_code(k);
 		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 		const size_type   nElementCountSaved = mnElementCount;
 
@@ -0,0 +1,780 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements an open addressing intrusive hash table, which is the
+// engine behind intrusive_flat_hash_map and intrusive_flat_hash_set.
+//
+// Like intrusive_hashtable, the table never allocates or copies elements; the
+// user owns them and the table merely refers to them. Unlike intrusive_hashtable,
+// the elements don't need an mpNext pointer, and the bucket array grows.
+//
+// The bucket array is made of cache-line-sized groups. Each group holds a small
+// number of element pointers plus, for each one, a one byte tag made from
+// hash bits which aren't used to pick the group. A lookup goes to one group,
+// compares the searched-for tag against all tags of the group at once, and
+// dereferences only the elements whose tags match. Thus a lookup typically
+// touches one cache line of the table plus the one element it's looking for,
+// and a miss typically touches only the one cache line.
+//
+// Collisions spill over into the following groups (linear probing by group).
+// Each group counts how many of the elements which hashed to it or to a group
+// before it had to be placed further along. A lookup stops at the first group
+// whose count is zero, so erase needs no tombstones.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_INTERNAL_INTRUSIVE_FLAT_HASHTABLE_H
+#define EASTL_INTERNAL_INTRUSIVE_FLAT_HASHTABLE_H
+
+
+#include <eastl/EABASE/eabase.h>
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once
+#endif
+
+#include <eastl/internal/config.h>
+#include <eastl/bit.h>
+#include <eastl/internal/intrusive_hashtable.h>
+#include <eastl/type_traits.h>
+#include <eastl/allocator.h>
+#include <eastl/iterator.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <stddef.h>
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <stddef.h>
+	#include <string.h>
+#endif
+
+#if EASTL_SSE2
+	#include <emmintrin.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_INTRUSIVE_FLAT_HASHTABLE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_INTRUSIVE_FLAT_HASHTABLE_DEFAULT_NAME
+		#define EASTL_INTRUSIVE_FLAT_HASHTABLE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " intrusive_flat_hashtable" // Unless the user overrides something, this is "EASTL intrusive_flat_hashtable".
+	#endif
+
+
+	/// EASTL_INTRUSIVE_FLAT_HASHTABLE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_INTRUSIVE_FLAT_HASHTABLE_DEFAULT_ALLOCATOR
+		#define EASTL_INTRUSIVE_FLAT_HASHTABLE_DEFAULT_ALLOCATOR allocator_type(EASTL_INTRUSIVE_FLAT_HASHTABLE_DEFAULT_NAME)
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// intrusive_flat_mix
+		///
+		/// Spreads the bits of a user hash value, so that identity hashes such as
+		/// eastl::hash<int> still give well distributed groups and tags.
+		///
+		inline size_t intrusive_flat_mix(size_t h)
+		{
+			#if (EA_PLATFORM_PTR_SIZE >= 8)
+				h *= (size_t)UINT64_C(0x9E3779B97F4A7C15);
+				return h ^ (h >> 32);
+			#else
+				h *= (size_t)0x9E3779B1u;
+				return h ^ (h >> 16);
+			#endif
+		}
+	}
+
+
+
+	/// intrusive_flat_group
+	///
+	/// One cache line of the bucket array: kSlotCount element pointers, one tag
+	/// byte per slot, and an overflow count. A tag is zero for an empty slot,
+	/// else the high bit is set and the low seven bits come from the hash.
+	///
+	/// The layout is 8 tag bytes and 7 pointers with 64 bit pointers, or 16 tag
+	/// bytes and 12 pointers with 32 bit pointers. Either way it's 64 bytes.
+	///
+	template <typename Value>
+	struct intrusive_flat_group
+	{
+		enum
+		{
+			kSlotCount    = (sizeof(void*) >= 8) ? 7 : 12,
+			kTagCount     = (sizeof(void*) >= 8) ? 8 : 16,  // The last tag byte is the overflow count, and the rest past kSlotCount are unused.
+			kSlotMask     = (1 << kSlotCount) - 1,
+			kMaxOverflow  = 255                             // An overflow count at this value is stuck, as we no longer know how many elements it counts.
+		};
+
+		uint8_t mTags[kTagCount];
+		Value*  mpSlots[kSlotCount];
+
+		uint8_t& overflow_count()
+			{ return mTags[kTagCount - 1]; }
+
+		uint8_t overflow_count() const
+			{ return mTags[kTagCount - 1]; }
+
+		// Returns a mask with bit i set for each slot i whose tag equals tag.
+		uint32_t match_tag(uint8_t tag) const
+		{
+			#if EASTL_SSE2
+				const __m128i tags = (kTagCount == 8) ? _mm_loadl_epi64((const __m128i*)mTags) : _mm_loadu_si128((const __m128i*)mTags);
+				return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8((char)tag))) & kSlotMask;
+			#else
+				uint32_t mask = 0;
+				for(uint32_t i = 0; i < kSlotCount; ++i)
+					mask |= (uint32_t)(mTags[i] == tag) << i;
+				return mask;
+			#endif
+		}
+
+		uint32_t match_empty() const
+			{ return match_tag(0); }
+
+		uint32_t match_full() const
+			{ return ~match_tag(0) & kSlotMask; }
+	};
+
+
+
+	/// intrusive_flat_hashtable_iterator
+	///
+	/// Iterates the occupied slots of the bucket array. The bucket array has an
+	/// extra group at the end whose first slot looks occupied, so that iteration
+	/// stops there without needing to know where the end is.
+	///
+	template <typename Value, bool bConst>
+	struct intrusive_flat_hashtable_iterator
+	{
+	public:
+		typedef intrusive_flat_hashtable_iterator<Value, bConst>         this_type;
+		typedef intrusive_flat_hashtable_iterator<Value, false>          this_type_non_const;
+		typedef intrusive_flat_group<Value>                              group_type;
+		typedef Value                                                    value_type;
+		typedef typename type_select<bConst, const Value*, Value*>::type pointer;
+		typedef typename type_select<bConst, const Value&, Value&>::type reference;
+		typedef ptrdiff_t                                                difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag                       iterator_category;
+
+	public:
+		group_type* mpGroup;
+		uint32_t    mnSlot;
+
+	public:
+		intrusive_flat_hashtable_iterator()
+			: mpGroup(NULL), mnSlot(0) { }
+
+		intrusive_flat_hashtable_iterator(group_type* pGroup, uint32_t nSlot)
+			: mpGroup(pGroup), mnSlot(nSlot) { }
+
+		intrusive_flat_hashtable_iterator(const this_type_non_const& x)
+			: mpGroup(x.mpGroup), mnSlot(x.mnSlot) { }
+
+		reference operator*() const
+			{ return *mpGroup->mpSlots[mnSlot]; }
+
+		pointer operator->() const
+			{ return mpGroup->mpSlots[mnSlot]; }
+
+		this_type& operator++()
+			{ increment(); return *this; }
+
+		this_type operator++(int)
+			{ this_type temp(*this); increment(); return temp; }
+
+		void increment()
+		{
+			uint32_t mask = mpGroup->match_full() & ~((2u << mnSlot) - 1);
+
+			while(!mask)
+				mask = (++mpGroup)->match_full();
+
+			mnSlot = (uint32_t)eastl::countr_zero(mask);
+		}
+
+	}; // intrusive_flat_hashtable_iterator
+
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator==(const intrusive_flat_hashtable_iterator<Value, bConstA>& a, const intrusive_flat_hashtable_iterator<Value, bConstB>& b)
+		{ return (a.mpGroup == b.mpGroup) && (a.mnSlot == b.mnSlot); }
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator!=(const intrusive_flat_hashtable_iterator<Value, bConstA>& a, const intrusive_flat_hashtable_iterator<Value, bConstB>& b)
+		{ return (a.mpGroup != b.mpGroup) || (a.mnSlot != b.mnSlot); }
+
+
+
+	///////////////////////////////////////////////////////////////////////////
+	/// intrusive_flat_hashtable
+	///
+	/// Keys are always unique. The table holds pointers to the user's objects,
+	/// so it neither constructs nor destroys them, and an object must stay at
+	/// the same address while it is in the table. The table is movable and
+	/// swappable but not copyable, as an object can only be in one table.
+	///
+	/// Insertion may grow the bucket array, which invalidates iterators but
+	/// not pointers and references, as the elements themselves never move.
+	/// Erasure invalidates only iterators to the erased element.
+	///
+	template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator, bool bConstIterators>
+	class intrusive_flat_hashtable
+	{
+	public:
+		typedef intrusive_flat_hashtable<Key, Value, Hash, Equal, Allocator, bConstIterators> this_type;
+		typedef Key                                                                            key_type;
+		typedef Value                                                                          value_type;
+		typedef Value                                                                          mapped_type;
+		typedef Value                                                                          node_type;
+		typedef Equal                                                                          key_equal;
+		typedef Hash                                                                           hasher;
+		typedef Allocator                                                                      allocator_type;
+		typedef ptrdiff_t                                                                      difference_type;
+		typedef eastl_size_t                                                                   size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef value_type&                                                                    reference;
+		typedef const value_type&                                                              const_reference;
+		typedef intrusive_flat_hashtable_iterator<value_type, bConstIterators>                 iterator;
+		typedef intrusive_flat_hashtable_iterator<value_type, true>                            const_iterator;
+		typedef eastl::pair<iterator, bool>                                                    insert_return_type;
+		typedef intrusive_flat_group<value_type>                                               group_type;
+		typedef typename type_select<bConstIterators, eastl::useSelf<Value>,
+									 eastl::use_intrusive_key<Value, key_type> >::type         extract_key;
+
+		enum
+		{
+			kSlotsPerGroup = group_type::kSlotCount
+		};
+
+	protected:
+		group_type*    mpGroups;          // mnGroupMask + 2 groups: the last is the iteration end marker.
+		size_type      mnGroupMask;       // The number of groups minus one. Groups are a power of two in number.
+		size_type      mnElementCount;
+		size_type      mnMaxElementCount; // The element count at which we grow. 0 means we're using the shared empty group array.
+		Hash           mHash;
+		Equal          mEqual;
+		allocator_type mAllocator;
+
+	public:
+		intrusive_flat_hashtable(const Hash& h, const Equal& eq, const allocator_type& allocator);
+	   ~intrusive_flat_hashtable();
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			intrusive_flat_hashtable(this_type&& x);
+			this_type& operator=(this_type&& x);
+		#endif
+
+		void swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+		iterator       begin() EASTL_NOEXCEPT;
+		const_iterator begin() const EASTL_NOEXCEPT;
+		const_iterator cbegin() const EASTL_NOEXCEPT { return begin(); }
+
+		iterator       end() EASTL_NOEXCEPT             { return iterator(mpGroups + mnGroupMask + 1, 0); }
+		const_iterator end() const EASTL_NOEXCEPT       { return const_iterator(mpGroups + mnGroupMask + 1, 0); }
+		const_iterator cend() const EASTL_NOEXCEPT      { return end(); }
+
+		size_type size() const EASTL_NOEXCEPT
+			{ return mnElementCount; }
+
+		bool empty() const EASTL_NOEXCEPT
+			{ return mnElementCount == 0; }
+
+		size_type bucket_count() const EASTL_NOEXCEPT // The number of slots, which is the most elements the table can hold before growing past its load limit.
+			{ return mnMaxElementCount ? (mnGroupMask + 1) * kSlotsPerGroup : 0; }
+
+		size_type group_count() const EASTL_NOEXCEPT
+			{ return mnMaxElementCount ? (mnGroupMask + 1) : 0; }
+
+		float load_factor() const EASTL_NOEXCEPT
+			{ return mnMaxElementCount ? (float)mnElementCount / (float)bucket_count() : 0.f; }
+
+		void reserve(size_type nElementCount);
+		void rehash(size_type nElementCount) { reserve(nElementCount); }
+
+		insert_return_type insert(value_type& value);
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last);
+
+		iterator  erase(const_iterator position);
+		iterator  erase(const_iterator first, const_iterator last);
+		size_type erase(const key_type& k);
+		iterator  remove(value_type& value); // Removes by value instead of by key.
+
+		void clear();   // Removes all elements, keeping the bucket array.
+		void reset();   // Removes all elements and frees the bucket array.
+
+		iterator       find(const key_type& k);
+		const_iterator find(const key_type& k) const;
+		size_type      count(const key_type& k) const;
+
+		bool validate() const;
+		int  validateIterator(const_iterator i) const;
+
+		Hash hash_function() const
+			{ return mHash; }
+
+		const key_equal& key_eq() const
+			{ return mEqual; }
+
+	protected:
+		static group_type* DoGetEmptyGroups();
+
+		static uint8_t DoGetTag(size_t h)
+			{ return (uint8_t)((h >> (sizeof(size_t) * 8 - 7)) | 0x80); }
+
+		iterator DoFind(const key_type& k, size_t h) const;
+		iterator DoInsertUnique(value_type* pValue, size_t h);
+		void     DoErase(group_type* pGroup, uint32_t nSlot, size_t h);
+		void     DoRehash(size_type nGroupCount);
+		void     DoFreeGroups();
+
+	private:
+		#if defined(EA_COMPILER_NO_DELETED_FUNCTIONS)
+			intrusive_flat_hashtable(const this_type&);
+			void operator=(const this_type&);
+		#else
+			intrusive_flat_hashtable(const this_type&) = delete;
+			void operator=(const this_type&) = delete;
+		#endif
+
+	}; // class intrusive_flat_hashtable
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// intrusive_flat_hashtable
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline intrusive_flat_hashtable<K, V, H, Eq, A, bC>::intrusive_flat_hashtable(const H& h, const Eq& eq, const allocator_type& allocator)
+		: mpGroups(DoGetEmptyGroups()),
+		  mnGroupMask(0),
+		  mnElementCount(0),
+		  mnMaxElementCount(0),
+		  mHash(h),
+		  mEqual(eq),
+		  mAllocator(allocator)
+	{
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline intrusive_flat_hashtable<K, V, H, Eq, A, bC>::~intrusive_flat_hashtable()
+	{
+		DoFreeGroups();
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+		inline intrusive_flat_hashtable<K, V, H, Eq, A, bC>::intrusive_flat_hashtable(this_type&& x)
+			: mpGroups(DoGetEmptyGroups()),
+			  mnGroupMask(0),
+			  mnElementCount(0),
+			  mnMaxElementCount(0),
+			  mHash(x.mHash),
+			  mEqual(x.mEqual),
+			  mAllocator(x.mAllocator)
+		{
+			swap(x);
+		}
+
+
+		template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+		inline typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::this_type&
+		intrusive_flat_hashtable<K, V, H, Eq, A, bC>::operator=(this_type&& x)
+		{
+			swap(x);
+			return *this;
+		}
+	#endif
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline void intrusive_flat_hashtable<K, V, H, Eq, A, bC>::swap(this_type& x)
+	{
+		eastl::swap(mpGroups,          x.mpGroups);
+		eastl::swap(mnGroupMask,       x.mnGroupMask);
+		eastl::swap(mnElementCount,    x.mnElementCount);
+		eastl::swap(mnMaxElementCount, x.mnMaxElementCount);
+		eastl::swap(mHash,             x.mHash);
+		eastl::swap(mEqual,            x.mEqual);
+		eastl::swap(mAllocator,        x.mAllocator);
+	}
+
+
+	// Returns the bucket array of empty tables: one empty group plus the end marker.
+	// Lookups in it fail without any special casing, and inserts grow first.
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::group_type*
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::DoGetEmptyGroups()
+	{
+		static group_type sEmptyGroups[2] = { { { 0 }, { NULL } }, { { 0xff }, { NULL } } };
+		return sEmptyGroups;
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline void intrusive_flat_hashtable<K, V, H, Eq, A, bC>::DoFreeGroups()
+	{
+		if(mnMaxElementCount)
+			EASTLFree(mAllocator, mpGroups, (mnGroupMask + 2) * sizeof(group_type));
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::begin() EASTL_NOEXCEPT
+	{
+		iterator i(mpGroups, 0);
+		if(!mpGroups->mTags[0])
+			i.increment();
+		return i;
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::const_iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::begin() const EASTL_NOEXCEPT
+	{
+		return const_cast<this_type*>(this)->begin();
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::DoFind(const key_type& k, size_t h) const
+	{
+		extract_key    extractKey; // extract_key is empty and thus this ctor is a no-op.
+		const uint8_t  tag = DoGetTag(h);
+		size_type      g   = (size_type)h & mnGroupMask;
+
+		for(size_type nProbes = 0; nProbes <= mnGroupMask; ++nProbes) // The probe limit matters only if every overflow count is stuck at kMaxOverflow.
+		{
+			group_type* const pGroup = mpGroups + g;
+
+			for(uint32_t mask = pGroup->match_tag(tag); mask; mask &= (mask - 1))
+			{
+				const uint32_t s = (uint32_t)eastl::countr_zero(mask);
+
+				if(mEqual(k, extractKey(*pGroup->mpSlots[s])))
+					return iterator(pGroup, s);
+			}
+
+			if(!pGroup->overflow_count())
+				break;
+
+			g = (g + 1) & mnGroupMask;
+		}
+
+		return iterator(mpGroups + mnGroupMask + 1, 0);
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::find(const key_type& k)
+	{
+		return DoFind(k, Internal::intrusive_flat_mix(mHash(k)));
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::const_iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::find(const key_type& k) const
+	{
+		return DoFind(k, Internal::intrusive_flat_mix(mHash(k)));
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::size_type
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::count(const key_type& k) const
+	{
+		return (DoFind(k, Internal::intrusive_flat_mix(mHash(k))).mpGroup != (mpGroups + mnGroupMask + 1)) ? 1 : 0;
+	}
+
+
+	// Places pValue in the first free slot along its probe sequence. The caller
+	// guarantees that the key is absent and that there is a free slot.
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::DoInsertUnique(value_type* pValue, size_t h)
+	{
+		size_type g = (size_type)h & mnGroupMask;
+
+		for(;;)
+		{
+			group_type* const pGroup = mpGroups + g;
+			const uint32_t    mask   = pGroup->match_empty();
+
+			if(mask)
+			{
+				const uint32_t s = (uint32_t)eastl::countr_zero(mask);
+				pGroup->mTags[s]    = DoGetTag(h);
+				pGroup->mpSlots[s]  = pValue;
+				return iterator(pGroup, s);
+			}
+
+			if(pGroup->overflow_count() != group_type::kMaxOverflow)
+				++pGroup->overflow_count();
+
+			g = (g + 1) & mnGroupMask;
+		}
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::insert_return_type
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::insert(value_type& value)
+	{
+		extract_key    extractKey; // extract_key is empty and thus this ctor is a no-op.
+		const size_t   h = Internal::intrusive_flat_mix(mHash(extractKey(value)));
+		const iterator it = DoFind(extractKey(value), h);
+
+		if(it.mpGroup != (mpGroups + mnGroupMask + 1))
+			return insert_return_type(it, false);
+
+		if(mnElementCount >= mnMaxElementCount)
+			DoRehash(mnMaxElementCount ? ((mnGroupMask + 1) * 2) : 1);
+
+		++mnElementCount;
+		return insert_return_type(DoInsertUnique(&value, h), true);
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	template <typename InputIterator>
+	inline void intrusive_flat_hashtable<K, V, H, Eq, A, bC>::insert(InputIterator first, InputIterator last)
+	{
+		for(; first != last; ++first)
+			insert(*first);
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	void intrusive_flat_hashtable<K, V, H, Eq, A, bC>::DoErase(group_type* pGroup, uint32_t nSlot, size_t h)
+	{
+		pGroup->mTags[nSlot]   = 0;
+		pGroup->mpSlots[nSlot] = NULL;
+		--mnElementCount;
+
+		// Every group between the element's home group and where it was placed counted
+		// it as overflow. Those counts go back down, unless they're stuck at the maximum.
+		for(size_type g = (size_type)h & mnGroupMask; (mpGroups + g) != pGroup; g = (g + 1) & mnGroupMask)
+		{
+			if(mpGroups[g].overflow_count() != group_type::kMaxOverflow)
+				--mpGroups[g].overflow_count();
+		}
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::erase(const_iterator position)
+	{
+		extract_key extractKey; // extract_key is empty and thus this ctor is a no-op.
+		iterator    iNext(position.mpGroup, position.mnSlot);
+
+		++iNext; // Erase leaves other elements in place, so the next iterator remains valid.
+		DoErase(position.mpGroup, position.mnSlot, Internal::intrusive_flat_mix(mHash(extractKey(*position))));
+		return iNext;
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::erase(const_iterator first, const_iterator last)
+	{
+		while(first != last)
+			first = erase(first);
+		return iterator(first.mpGroup, first.mnSlot);
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::size_type
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::erase(const key_type& k)
+	{
+		const size_t   h  = Internal::intrusive_flat_mix(mHash(k));
+		const iterator it = DoFind(k, h);
+
+		if(it.mpGroup == (mpGroups + mnGroupMask + 1))
+			return 0;
+
+		DoErase(it.mpGroup, it.mnSlot, h);
+		return 1;
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	typename intrusive_flat_hashtable<K, V, H, Eq, A, bC>::iterator
+	intrusive_flat_hashtable<K, V, H, Eq, A, bC>::remove(value_type& value)
+	{
+		// We search by address rather than by key, as the table holds at most one
+		// element with the key of value, and that element need not be value itself.
+		extract_key  extractKey; // extract_key is empty and thus this ctor is a no-op.
+		const size_t h   = Internal::intrusive_flat_mix(mHash(extractKey(value)));
+		iterator     it  = DoFind(extractKey(value), h);
+
+		if((it.mpGroup != (mpGroups + mnGroupMask + 1)) && (it.mpGroup->mpSlots[it.mnSlot] == &value))
+		{
+			iterator iNext(it);
+			++iNext;
+			DoErase(it.mpGroup, it.mnSlot, h);
+			return iNext;
+		}
+
+		return end();
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline void intrusive_flat_hashtable<K, V, H, Eq, A, bC>::clear()
+	{
+		if(mnMaxElementCount)
+			memset(mpGroups, 0, (mnGroupMask + 1) * sizeof(group_type)); // This leaves the end marker group alone.
+		mnElementCount = 0;
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline void intrusive_flat_hashtable<K, V, H, Eq, A, bC>::reset()
+	{
+		DoFreeGroups();
+		mpGroups          = DoGetEmptyGroups();
+		mnGroupMask       = 0;
+		mnElementCount    = 0;
+		mnMaxElementCount = 0;
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	void intrusive_flat_hashtable<K, V, H, Eq, A, bC>::reserve(size_type nElementCount)
+	{
+		if(nElementCount > mnMaxElementCount)
+		{
+			// We allow a load factor of 7/8, as lookups mostly compare tags rather than keys.
+			const size_type nSlotCount = (size_type)(((uint64_t)nElementCount * 8 + 6) / 7);
+			size_type       nGroupCount = 1;
+
+			while((nGroupCount * kSlotsPerGroup) < nSlotCount)
+				nGroupCount *= 2;
+
+			DoRehash(nGroupCount);
+		}
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	void intrusive_flat_hashtable<K, V, H, Eq, A, bC>::DoRehash(size_type nGroupCount)
+	{
+		EASTL_ASSERT((nGroupCount & (nGroupCount - 1)) == 0);
+
+		group_type* const pGroupsNew = (group_type*)allocate_memory(mAllocator, (nGroupCount + 1) * sizeof(group_type), sizeof(group_type), 0);
+		EASTL_ASSERT(pGroupsNew != NULL);
+
+		memset(pGroupsNew, 0, (nGroupCount + 1) * sizeof(group_type));
+		pGroupsNew[nGroupCount].mTags[0] = 0xff; // The iteration end marker.
+
+		group_type* const pGroupsOld     = mpGroups;
+		const size_type   nGroupCountOld = mnGroupMask + 1;
+		const size_type   nMaxOld        = mnMaxElementCount;
+		extract_key       extractKey; // extract_key is empty and thus this ctor is a no-op.
+
+		mpGroups          = pGroupsNew;
+		mnGroupMask       = nGroupCount - 1;
+		mnMaxElementCount = (nGroupCount * kSlotsPerGroup * 7) / 8;
+
+		for(size_type g = 0; g < nGroupCountOld; ++g)
+		{
+			for(uint32_t mask = pGroupsOld[g].match_full(); mask; mask &= (mask - 1))
+			{
+				value_type* const pValue = pGroupsOld[g].mpSlots[(uint32_t)eastl::countr_zero(mask)];
+				DoInsertUnique(pValue, Internal::intrusive_flat_mix(mHash(extractKey(*pValue))));
+			}
+		}
+
+		if(nMaxOld)
+			EASTLFree(mAllocator, pGroupsOld, (nGroupCountOld + 1) * sizeof(group_type));
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	bool intrusive_flat_hashtable<K, V, H, Eq, A, bC>::validate() const
+	{
+		// Verify that the element count matches mnElementCount, that every element
+		// can be found from its home group, and that the overflow counts are consistent.
+		extract_key extractKey; // extract_key is empty and thus this ctor is a no-op.
+		size_type   nElementCount = 0;
+
+		if(mnElementCount > mnMaxElementCount)
+			return false;
+
+		for(const_iterator temp = begin(), tempEnd = end(); temp != tempEnd; ++temp)
+		{
+			const size_t h = Internal::intrusive_flat_mix(mHash(extractKey(*temp)));
+
+			if(temp.mpGroup->mTags[temp.mnSlot] != DoGetTag(h))
+				return false;
+
+			if(DoFind(extractKey(*temp), h) != temp)
+				return false;
+
+			++nElementCount;
+		}
+
+		return (nElementCount == mnElementCount);
+	}
+
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	int intrusive_flat_hashtable<K, V, H, Eq, A, bC>::validateIterator(const_iterator i) const
+	{
+		if((i.mpGroup >= mpGroups) && (i.mpGroup <= (mpGroups + mnGroupMask)) && (i.mnSlot < (uint32_t)kSlotsPerGroup) && i.mpGroup->mTags[i.mnSlot])
+			return (isf_valid | isf_current | isf_can_dereference);
+
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename H, typename Eq, typename A, bool bC>
+	inline void swap(intrusive_flat_hashtable<K, V, H, Eq, A, bC>& a, intrusive_flat_hashtable<K, V, H, Eq, A, bC>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+
+#endif // Header include guard
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_INTRUSIVE_FLAT_HASH_MAP_H
+#define EASTL_INTRUSIVE_FLAT_HASH_MAP_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/intrusive_flat_hashtable.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_NAME
+		#define EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " intrusive_flat_hashMap" // Unless the user overrides something, this is "EASTL intrusive_flat_hashMap".
+	#endif
+
+
+	/// EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// intrusive_flat_hashMap
+	///
+	/// An intrusive map like intrusive_hashMap, but with an open addressing bucket
+	/// array of (tag, pointer) slots in cache-line-sized groups instead of chains
+	/// through mpNext. A lookup compares one byte tags first and dereferences only
+	/// elements whose tags match, so misses rarely touch any element at all. The
+	/// bucket array grows as needed and is the only memory the container allocates.
+	/// See internal/intrusive_flat_hashtable.h for details.
+	///
+	/// T needs a member of type Key named mKey, but doesn't need to derive from
+	/// intrusive_hash_node. Keys are unique; there is no multimap version.
+	///
+	/// Template parameters:
+	///     Key             The key object (key in the key/value pair). T must contain a member of type Key named mKey.
+	///     T               The type of object the map holds (a.k.a. value).
+	///     Hash            Hash function. See functional.h for examples of hash functions.
+	///     Equal           Equality testing predicate; tells if two elements are equal.
+	///     Allocator       Allocator for the bucket array.
+	///
+	/// Example usage:
+	///     struct Widget { int mKey; ... };
+	///     intrusive_flat_hashMap<int, Widget> widgetMap;
+	///     widgetMap.reserve(1000000);
+	///     widgetMap.insert(widget);
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Equal = eastl::equal_to<Key>, typename Allocator = EASTLAllocatorType>
+	class intrusive_flat_hashMap : public intrusive_flat_hashtable<Key, T, Hash, Equal, Allocator, false>
+	{
+	public:
+		typedef intrusive_flat_hashtable<Key, T, Hash, Equal, Allocator, false>  base_type;
+		typedef intrusive_flat_hashMap<Key, T, Hash, Equal, Allocator>           this_type;
+		typedef typename base_type::allocator_type                               allocator_type;
+
+	public:
+		explicit intrusive_flat_hashMap(const allocator_type& allocator = EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_ALLOCATOR)
+			: base_type(Hash(), Equal(), allocator)
+		{
+			// Empty
+		}
+
+		explicit intrusive_flat_hashMap(const Hash& h, const Equal& eq = Equal(), const allocator_type& allocator = EASTL_INTRUSIVE_FLAT_HASH_MAP_DEFAULT_ALLOCATOR)
+			: base_type(h, eq, allocator)
+		{
+			// Empty
+		}
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			intrusive_flat_hashMap(this_type&& x)
+				: base_type(eastl::move(x))
+			{
+			}
+
+			this_type& operator=(this_type&& x)
+			{
+				return static_cast<this_type&>(base_type::operator=(eastl::move(x)));
+			}
+		#endif
+
+	}; // intrusive_flat_hashMap
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef EASTL_INTRUSIVE_FLAT_HASH_SET_H
+#define EASTL_INTRUSIVE_FLAT_HASH_SET_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/intrusive_flat_hashtable.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_NAME
+		#define EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " intrusive_flat_hashSet" // Unless the user overrides something, this is "EASTL intrusive_flat_hashSet".
+	#endif
+
+
+	/// EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_ALLOCATOR
+		#define EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_ALLOCATOR allocator_type(EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_NAME)
+	#endif
+
+
+
+	/// intrusive_flat_hashSet
+	///
+	/// An intrusive set like intrusive_hashSet, but with an open addressing bucket
+	/// array of (tag, pointer) slots in cache-line-sized groups instead of chains
+	/// through mpNext. See intrusive_flat_hashMap for details.
+	///
+	/// Template parameters:
+	///     T               The type of object the set holds (a.k.a. value).
+	///     Hash            Hash function. See functional.h for examples of hash functions.
+	///     Equal           Equality testing predicate; tells if two elements are equal.
+	///     Allocator       Allocator for the bucket array.
+	///
+	template <typename T, typename Hash = eastl::hash<T>, typename Equal = eastl::equal_to<T>, typename Allocator = EASTLAllocatorType>
+	class intrusive_flat_hashSet : public intrusive_flat_hashtable<T, T, Hash, Equal, Allocator, true>
+	{
+	public:
+		typedef intrusive_flat_hashtable<T, T, Hash, Equal, Allocator, true>  base_type;
+		typedef intrusive_flat_hashSet<T, Hash, Equal, Allocator>             this_type;
+		typedef typename base_type::allocator_type                            allocator_type;
+
+	public:
+		explicit intrusive_flat_hashSet(const allocator_type& allocator = EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+			: base_type(Hash(), Equal(), allocator)
+		{
+			// Empty
+		}
+
+		explicit intrusive_flat_hashSet(const Hash& h, const Equal& eq = Equal(), const allocator_type& allocator = EASTL_INTRUSIVE_FLAT_HASH_SET_DEFAULT_ALLOCATOR)
+			: base_type(h, eq, allocator)
+		{
+			// Empty
+		}
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			intrusive_flat_hashSet(this_type&& x)
+				: base_type(eastl::move(x))
+			{
+			}
+
+			this_type& operator=(this_type&& x)
+			{
+				return static_cast<this_type&>(base_type::operator=(eastl::move(x)));
+			}
+		#endif
+
+	}; // intrusive_flat_hashSet
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
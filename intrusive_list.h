@@ -791,8 +791,10 @@ namespace eastl
 				EASTL_FAIL_MSG("intrusive_list::insert(): element already on a list.");
 		#endif
 
-		node_type& next = *const_cast<node_type*>(pos.mpNode);
-		node_type& prev = *static_cast<node_type*>(next.mpPrev);
+		// The neighbours may be the list anchor, which isn't a node_type, so they are
+		// accessed as intrusive_list_node lest the compiler assume they can't alias it.
+		intrusive_list_node& next = *const_cast<node_type*>(pos.mpNode);
+		intrusive_list_node& prev = *next.mpPrev;
 		prev.mpNext = next.mpPrev = &x;
 		x.mpPrev    = &prev;
 		x.mpNext    = &next;
@@ -805,8 +807,8 @@ namespace eastl
 	inline typename intrusive_list<T>::iterator
 	intrusive_list<T>::erase(const_iterator pos)
 	{
-		node_type& prev = *static_cast<node_type*>(pos.mpNode->mpPrev);
-		node_type& next = *static_cast<node_type*>(pos.mpNode->mpNext);
+		intrusive_list_node& prev = *pos.mpNode->mpPrev;
+		intrusive_list_node& next = *pos.mpNode->mpNext;
 		prev.mpNext = &next;
 		next.mpPrev = &prev;
 
@@ -815,7 +817,7 @@ namespace eastl
 			ii.mpNode->mpPrev = ii.mpNode->mpNext = NULL;
 		#endif
 
-		return iterator(&next);
+		return iterator(static_cast<node_type*>(&next));
 	}
 
 
@@ -823,8 +825,8 @@ namespace eastl
 	inline typename intrusive_list<T>::iterator
 	intrusive_list<T>::erase(const_iterator first, const_iterator last)
 	{
-		node_type& prev = *static_cast<node_type*>(first.mpNode->mpPrev);
-		node_type& next = *const_cast<node_type*>(last.mpNode);
+		intrusive_list_node& prev = *first.mpNode->mpPrev;
+		intrusive_list_node& next = *const_cast<node_type*>(last.mpNode);
 
 		#if EASTL_VALIDATE_INTRUSIVE_LIST
 			// need to clear out all the next/prev pointers in the elements;
@@ -929,10 +931,10 @@ namespace eastl
 		// Note: &x == this is prohibited, so self-insertion is not a problem.
 		if(x.mAnchor.mpNext != &x.mAnchor) // If the list 'x' isn't empty...
 		{
-			node_type& next       = *const_cast<node_type*>(pos.mpNode);
-			node_type& prev       = *static_cast<node_type*>(next.mpPrev);
-			node_type& insertPrev = *static_cast<node_type*>(x.mAnchor.mpNext);
-			node_type& insertNext = *static_cast<node_type*>(x.mAnchor.mpPrev);
+			intrusive_list_node& next       = *const_cast<node_type*>(pos.mpNode);
+			intrusive_list_node& prev       = *next.mpPrev;
+			intrusive_list_node& insertPrev = *x.mAnchor.mpNext;
+			intrusive_list_node& insertNext = *x.mAnchor.mpPrev;
 
 			prev.mpNext       = &insertPrev;
 			insertPrev.mpPrev = &prev;
@@ -983,16 +985,16 @@ namespace eastl
 		// Note: &x == this is prohibited, so self-insertion is not a problem.
 		if(first != last)
 		{
-			node_type& insertPrev = *const_cast<node_type*>(first.mpNode);
-			node_type& insertNext = *static_cast<node_type*>(last.mpNode->mpPrev);
+			intrusive_list_node& insertPrev = *const_cast<node_type*>(first.mpNode);
+			intrusive_list_node& insertNext = *last.mpNode->mpPrev;
 
 			// remove from old list
 			insertNext.mpNext->mpPrev = insertPrev.mpPrev;
 			insertPrev.mpPrev->mpNext = insertNext.mpNext;
 
 			// insert into this list
-			node_type& next = *const_cast<node_type*>(pos.mpNode);
-			node_type& prev = *static_cast<node_type*>(next.mpPrev);
+			intrusive_list_node& next = *const_cast<node_type*>(pos.mpNode);
+			intrusive_list_node& prev = *next.mpPrev;
 
 			prev.mpNext       = &insertPrev;
 			insertPrev.mpPrev = &prev;
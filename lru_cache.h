@@ -0,0 +1,522 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements lru_cache, a fixed capacity key/value cache which
+// evicts the least recently used entry when it is full. All entries are
+// allocated up front in a single block (see internal/cache_table.h), so
+// put and evict never allocate. The recency list is a doubly linked list
+// of 32 bit entry indices, so the per-entry overhead on top of the key and
+// value is 16 bytes for the entry plus 4 to 8 bytes for its hash bucket.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_LRU_CACHE_H
+#define EASTL_LRU_CACHE_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/cache_table.h>
+#include <eastl/iterator.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_LRU_CACHE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_LRU_CACHE_DEFAULT_NAME
+		#define EASTL_LRU_CACHE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " lru_cache" // Unless the user overrides something, this is "EASTL lru_cache".
+	#endif
+
+
+	/// EASTL_LRU_CACHE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_LRU_CACHE_DEFAULT_ALLOCATOR
+		#define EASTL_LRU_CACHE_DEFAULT_ALLOCATOR allocator_type(EASTL_LRU_CACHE_DEFAULT_NAME)
+	#endif
+
+
+
+	/// lru_cache_entry
+	///
+	template <typename Value>
+	struct lru_cache_entry : public cache_entry_base<Value>
+	{
+		uint32_t mnPrev;  // Toward the most recently used entry. The list is circular.
+		uint32_t mnNext;  // Toward the least recently used entry.
+	};
+
+
+
+	/// lru_cache_iterator
+	///
+	/// Iterates from the most recently used entry to the least recently used.
+	/// Iterating does not affect recency.
+	///
+	template <typename Value, bool bConst>
+	struct lru_cache_iterator
+	{
+	public:
+		typedef lru_cache_iterator<Value, bConst>                                this_type;
+		typedef lru_cache_iterator<Value, false>                                 iterator_type;
+		typedef lru_cache_entry<Value>                                           entry_type;
+		typedef Value                                                            value_type;
+		typedef typename type_select<bConst, const Value*, Value*>::type         pointer;
+		typedef typename type_select<bConst, const Value&, Value&>::type         reference;
+		typedef ptrdiff_t                                                        difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag                               iterator_category;
+
+		entry_type* mpEntries;
+		uint32_t    mnIndex;
+		uint32_t    mnHead;
+
+	public:
+		lru_cache_iterator(entry_type* pEntries = NULL, uint32_t nIndex = 0xffffffff, uint32_t nHead = 0xffffffff)
+			: mpEntries(pEntries), mnIndex(nIndex), mnHead(nHead) { }
+
+		lru_cache_iterator(const iterator_type& x)
+			: mpEntries(x.mpEntries), mnIndex(x.mnIndex), mnHead(x.mnHead) { }
+
+		reference operator*() const
+			{ return mpEntries[mnIndex].value(); }
+
+		pointer operator->() const
+			{ return &mpEntries[mnIndex].value(); }
+
+		this_type& operator++()
+		{
+			mnIndex = mpEntries[mnIndex].mnNext;
+			if(mnIndex == mnHead)
+				mnIndex = 0xffffffff;
+			return *this;
+		}
+
+		this_type operator++(int)
+		{
+			this_type temp(*this);
+			++*this;
+			return temp;
+		}
+
+	}; // lru_cache_iterator
+
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator==(const lru_cache_iterator<Value, bConstA>& a, const lru_cache_iterator<Value, bConstB>& b)
+		{ return a.mnIndex == b.mnIndex; }
+
+	template <typename Value, bool bConstA, bool bConstB>
+	inline bool operator!=(const lru_cache_iterator<Value, bConstA>& a, const lru_cache_iterator<Value, bConstB>& b)
+		{ return a.mnIndex != b.mnIndex; }
+
+
+
+	/// lru_cache
+	///
+	/// A fixed capacity map which, when full, makes room for a new entry by
+	/// evicting the entry which was least recently put or gotten.
+	///
+	/// The capacity is set at construction (or by setCapacity) and all entries
+	/// are allocated then. get returns a pointer to the value, which remains
+	/// valid until the entry is erased or evicted; it is not invalidated by
+	/// other gets or puts. A capacity of zero is valid and caches nothing.
+	///
+	/// Example usage:
+	///     lru_cache<uint64_t, Texture> textureCache(256);
+	///     textureCache.setEvictionCallback(&OnTextureEvicted, pTextureManager);
+	///
+	///     Texture* pTexture = textureCache.get(id);
+	///     if(!pTexture)
+	///         pTexture = textureCache.put(id, LoadTexture(id)).first;
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
+			  typename Allocator = EASTLAllocatorType>
+	class lru_cache
+		: public cache_table<Key, T, Hash, Predicate, Allocator, lru_cache_entry<eastl::pair<const Key, T> > >
+	{
+	public:
+		typedef cache_table<Key, T, Hash, Predicate, Allocator,
+							lru_cache_entry<eastl::pair<const Key, T> > >     base_type;
+		typedef lru_cache<Key, T, Hash, Predicate, Allocator>                  this_type;
+		typedef typename base_type::size_type                                  size_type;
+		typedef typename base_type::key_type                                   key_type;
+		typedef typename base_type::mapped_type                                mapped_type;
+		typedef typename base_type::value_type                                 value_type;     // Note that this is pair<const key_type, mapped_type>.
+		typedef typename base_type::allocator_type                             allocator_type;
+		typedef typename base_type::entry_type                                 entry_type;
+		typedef lru_cache_iterator<value_type, false>                          iterator;
+		typedef lru_cache_iterator<value_type, true>                           const_iterator;
+		typedef eastl::pair<mapped_type*, bool>                                insert_return_type;
+
+		using base_type::kNil;
+
+	public:
+		explicit lru_cache(size_type capacity = 0, const allocator_type& allocator = EASTL_LRU_CACHE_DEFAULT_ALLOCATOR)
+			: base_type(capacity, Hash(), Predicate(), allocator), mnHead(kNil) { }
+
+		lru_cache(size_type capacity, const Hash& hashFunction, const Predicate& predicate = Predicate(),
+				  const allocator_type& allocator = EASTL_LRU_CACHE_DEFAULT_ALLOCATOR)
+			: base_type(capacity, hashFunction, predicate, allocator), mnHead(kNil) { }
+
+	   ~lru_cache()
+			{ base_type::DoClear(); }
+
+		/// get
+		/// Returns the value for key and makes it the most recently used entry,
+		/// or returns NULL. Counts a hit or a miss.
+		mapped_type* get(const key_type& key);
+
+		/// put
+		/// Sets the value for key and makes it the most recently used entry,
+		/// evicting the least recently used entry if the cache is full. Returns
+		/// the stored value (NULL if the capacity is zero) and whether the key
+		/// was newly inserted.
+		insert_return_type put(const key_type& key, const mapped_type& value)
+			{ return DoPut(key, value); }
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			insert_return_type put(const key_type& key, mapped_type&& value)
+				{ return DoPut(key, eastl::move(value)); }
+
+			insert_return_type put(key_type&& key, mapped_type&& value)
+				{ return DoPut(eastl::move(key), eastl::move(value)); }
+		#endif
+
+		/// erase
+		/// Removes key without calling the eviction callback. Returns true if it was present.
+		bool erase(const key_type& key);
+
+		void clear();
+
+		/// setCapacity
+		/// Reallocates the cache with the given capacity. If the new capacity is
+		/// smaller than size(), the least recently used entries are evicted.
+		void setCapacity(size_type capacity);
+
+		void swap(this_type& x);
+
+		iterator       begin() EASTL_NOEXCEPT        { return iterator(mpEntries, mnHead, mnHead); }
+		const_iterator begin() const EASTL_NOEXCEPT  { return const_iterator(mpEntries, mnHead, mnHead); }
+		const_iterator cbegin() const EASTL_NOEXCEPT { return const_iterator(mpEntries, mnHead, mnHead); }
+
+		iterator       end() EASTL_NOEXCEPT          { return iterator(mpEntries, kNil, mnHead); }
+		const_iterator end() const EASTL_NOEXCEPT    { return const_iterator(mpEntries, kNil, mnHead); }
+		const_iterator cend() const EASTL_NOEXCEPT   { return const_iterator(mpEntries, kNil, mnHead); }
+
+		/// back
+		/// Returns the least recently used entry, which is the next to be evicted. The cache must not be empty.
+		value_type& back()             { EASTL_ASSERT(mnHead != kNil); return mpEntries[mpEntries[mnHead].mnPrev].value(); }
+		const value_type& back() const { EASTL_ASSERT(mnHead != kNil); return mpEntries[mpEntries[mnHead].mnPrev].value(); }
+
+		bool validate() const;
+		int  validateIterator(const_iterator i) const;
+
+	protected:
+		using base_type::mpEntries;
+		using base_type::mnSize;
+		using base_type::mnCapacity;
+		using base_type::mStats;
+
+		uint32_t mnHead; // The most recently used entry, or kNil if empty.
+
+		void DoListInsertFront(uint32_t i);
+		void DoListRemove(uint32_t i);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			template <typename KeyArg, typename ValueArg>
+			insert_return_type DoPut(KeyArg&& key, ValueArg&& value);
+		#else
+			template <typename KeyArg, typename ValueArg>
+			insert_return_type DoPut(const KeyArg& key, const ValueArg& value);
+		#endif
+
+	}; // class lru_cache
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// lru_cache
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void lru_cache<K, T, H, P, A>::DoListInsertFront(uint32_t i)
+	{
+		if(mnHead == kNil)
+		{
+			mpEntries[i].mnPrev = i;
+			mpEntries[i].mnNext = i;
+		}
+		else
+		{
+			const uint32_t nTail = mpEntries[mnHead].mnPrev;
+
+			mpEntries[i].mnPrev     = nTail;
+			mpEntries[i].mnNext     = mnHead;
+			mpEntries[nTail].mnNext = i;
+			mpEntries[mnHead].mnPrev = i;
+		}
+
+		mnHead = i;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void lru_cache<K, T, H, P, A>::DoListRemove(uint32_t i)
+	{
+		const uint32_t nPrev = mpEntries[i].mnPrev;
+		const uint32_t nNext = mpEntries[i].mnNext;
+
+		if(nNext == i) // If i is the only entry...
+			mnHead = kNil;
+		else
+		{
+			mpEntries[nPrev].mnNext = nNext;
+			mpEntries[nNext].mnPrev = nPrev;
+
+			if(mnHead == i)
+				mnHead = nNext;
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	typename lru_cache<K, T, H, P, A>::mapped_type*
+	lru_cache<K, T, H, P, A>::get(const key_type& key)
+	{
+		const uint32_t i = base_type::DoFind(key, base_type::DoHash(key));
+
+		if(i != kNil)
+		{
+			++mStats.mnHits;
+
+			if(i != mnHead) // Re-linking is the main cost of a hit, so skip it if the entry is already at the front.
+			{
+				DoListRemove(i);
+				DoListInsertFront(i);
+			}
+
+			return &mpEntries[i].value().second;
+		}
+
+		++mStats.mnMisses;
+		return NULL;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	template <typename KeyArg, typename ValueArg>
+	typename lru_cache<K, T, H, P, A>::insert_return_type
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		lru_cache<K, T, H, P, A>::DoPut(KeyArg&& key, ValueArg&& value)
+	#else
+		lru_cache<K, T, H, P, A>::DoPut(const KeyArg& key, const ValueArg& value)
+	#endif
+	{
+		const uint32_t h = base_type::DoHash(key);
+		uint32_t       i = base_type::DoFind(key, h);
+
+		if(i != kNil)
+		{
+			mpEntries[i].value().second = EASTL_FORWARD(ValueArg, value);
+
+			if(i != mnHead)
+			{
+				DoListRemove(i);
+				DoListInsertFront(i);
+			}
+
+			return insert_return_type(&mpEntries[i].value().second, false);
+		}
+
+		if(mnCapacity == 0)
+			return insert_return_type((mapped_type*)NULL, false);
+
+		i = base_type::DoAllocateEntry();
+
+		if(i == kNil) // If full, evict the least recently used entry and reuse it.
+		{
+			i = mpEntries[mnHead].mnPrev;
+			DoListRemove(i);
+			base_type::DoEvictEntry(i);
+			i = base_type::DoAllocateEntry();
+		}
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+				::new((void*)&mpEntries[i].mStorage) value_type(EASTL_FORWARD(KeyArg, key), EASTL_FORWARD(ValueArg, value));
+			}
+			catch(...)
+			{
+				base_type::DoAbandonEntry(i);
+				throw;
+			}
+		#else
+			::new((void*)&mpEntries[i].mStorage) value_type(EASTL_FORWARD(KeyArg, key), EASTL_FORWARD(ValueArg, value));
+		#endif
+
+		base_type::DoLinkEntry(i, h);
+		DoListInsertFront(i);
+		++mStats.mnInserts;
+
+		return insert_return_type(&mpEntries[i].value().second, true);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	bool lru_cache<K, T, H, P, A>::erase(const key_type& key)
+	{
+		const uint32_t i = base_type::DoFind(key, base_type::DoHash(key));
+
+		if(i != kNil)
+		{
+			DoListRemove(i);
+			base_type::DoUnlinkEntry(i);
+			base_type::DoFreeEntry(i);
+			return true;
+		}
+
+		return false;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void lru_cache<K, T, H, P, A>::clear()
+	{
+		base_type::DoClear();
+		mnHead = kNil;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	void lru_cache<K, T, H, P, A>::setCapacity(size_type capacity)
+	{
+		if(capacity != mnCapacity)
+		{
+			// A cache of capacity 0 drops anything put into it without evicting it,
+			// so the entries are evicted here instead, least recently used first.
+			if(capacity == 0)
+			{
+				#if EASTL_ASSERT_ENABLED
+					const size_type nOldSize      = base_type::size();
+					const uint64_t  nOldEvictions = mStats.mnEvictions;
+				#endif
+
+				while(mnHead != kNil)
+				{
+					const uint32_t i = mpEntries[mnHead].mnPrev;
+					DoListRemove(i);
+					base_type::DoEvictEntry(i);
+				}
+
+				EASTL_ASSERT((base_type::size() == 0) && ((mStats.mnEvictions - nOldEvictions) == nOldSize)); // Every entry went through the eviction callback.
+			}
+
+			this_type temp(capacity, base_type::mHash, base_type::mPredicate, base_type::mAllocator);
+			temp.setEvictionCallback(base_type::mpEvictionCallback, base_type::mpEvictionContext);
+
+			// Re-put from least to most recently used, so that the same order results
+			// and, if shrinking, the least recently used entries are the ones evicted.
+			if(mnHead != kNil)
+			{
+				for(uint32_t i = mpEntries[mnHead].mnPrev; ; i = mpEntries[i].mnPrev)
+				{
+					temp.DoPut(mpEntries[i].value().first, eastl::move(mpEntries[i].value().second));
+					if(i == mnHead)
+						break;
+				}
+			}
+
+			temp.mStats.mnHits      = mStats.mnHits;
+			temp.mStats.mnMisses    = mStats.mnMisses;
+			temp.mStats.mnInserts   = mStats.mnInserts;
+			temp.mStats.mnEvictions += mStats.mnEvictions;
+
+			swap(temp);
+		}
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void lru_cache<K, T, H, P, A>::swap(this_type& x)
+	{
+		base_type::DoSwap(x);
+		eastl::swap(mnHead, x.mnHead);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	bool lru_cache<K, T, H, P, A>::validate() const
+	{
+		if(mnSize > mnCapacity)
+			return false;
+
+		if(mnHead == kNil)
+			return (mnSize == 0);
+
+		// Walk the list, checking the links and that every listed entry can be found.
+		uint32_t nCount = 0;
+		uint32_t i      = mnHead;
+
+		do
+		{
+			const uint32_t nNext = mpEntries[i].mnNext;
+
+			if((nNext >= mnCapacity) || (mpEntries[nNext].mnPrev != i))
+				return false;
+
+			if(base_type::DoFind(mpEntries[i].value().first, mpEntries[i].mnHash) != i)
+				return false;
+
+			if(++nCount > mnSize)
+				return false;
+
+			i = nNext;
+		} while(i != mnHead);
+
+		return (nCount == mnSize);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	int lru_cache<K, T, H, P, A>::validateIterator(const_iterator i) const
+	{
+		for(const_iterator temp = begin(), tempEnd = end(); temp != tempEnd; ++temp)
+		{
+			if(temp == i)
+				return (isf_valid | isf_current | isf_can_dereference);
+		}
+
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void swap(lru_cache<K, T, H, P, A>& a, lru_cache<K, T, H, P, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
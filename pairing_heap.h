@@ -0,0 +1,666 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements pairing_heap, a node-based priority queue with O(1)
+// push, O(1) meld (merging two heaps) and O(1) increase of an entry's
+// priority, at the cost of an amortized O(log n) pop. That suits algorithms
+// which change priorities far more often than they pop, such as Dijkstra's
+// on dense graphs or Prim's algorithm, and those which merge queues.
+//
+// A pairing heap is a tree in which every node has higher priority than its
+// children. A push or meld links two trees: the one with the lower priority
+// root becomes the first child of the other. Raising an entry's priority
+// cuts its subtree out and links it with the root. Popping the root links
+// its children in pairs, left to right, then links the resulting trees
+// right to left; it is this two-pass pairing that makes the amortized cost
+// logarithmic.
+//
+// As with priority_queue, the entry for which no other compares greater
+// (per Compare, which defaults to less) is at the top.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_PAIRING_HEAP_H
+#define EASTL_PAIRING_HEAP_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/functional.h>
+#include <eastl/memory.h>
+#include <eastl/utility.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_PAIRING_HEAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_PAIRING_HEAP_DEFAULT_NAME
+		#define EASTL_PAIRING_HEAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " pairing_heap" // Unless the user overrides something, this is "EASTL pairing_heap".
+	#endif
+
+
+	/// EASTL_PAIRING_HEAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_PAIRING_HEAP_DEFAULT_ALLOCATOR
+		#define EASTL_PAIRING_HEAP_DEFAULT_ALLOCATOR allocator_type(EASTL_PAIRING_HEAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// pairing_heap_node
+	///
+	/// The children of a node are a doubly linked list of siblings. The first
+	/// child's mpPrev points to the parent, which lets a node be cut out of
+	/// the tree without knowing whether it is a first child.
+	///
+	template <typename T>
+	struct pairing_heap_node
+	{
+		T                  mValue;
+		pairing_heap_node* mpChild;  // The first child, or NULL.
+		pairing_heap_node* mpNext;   // The next sibling, or NULL.
+		pairing_heap_node* mpPrev;   // The previous sibling, the parent if this is the first child, or NULL for the root.
+	};
+
+
+
+	/// pairing_heap
+	///
+	/// push returns a handle to the new entry, which stays valid until the
+	/// entry is popped or erased and can be used to read, reprioritize or
+	/// erase the entry.
+	///
+	/// Example usage:
+	///     eastl::pairing_heap<Edge, EdgeWeightGreater> frontier;
+	///     eastl::vector<eastl::pairing_heap<Edge, EdgeWeightGreater>::handle_type> handles(vertexCount, NULL);
+	///     ...
+	///     if(!handles[v])
+	///         handles[v] = frontier.push(edge);
+	///     else if(edge.weight < frontier.get(handles[v]).weight)
+	///         frontier.decrease_key(handles[v], edge);
+	///
+	template <typename T, typename Compare = eastl::less<T>, typename Allocator = EASTLAllocatorType>
+	class pairing_heap
+	{
+	public:
+		typedef pairing_heap<T, Compare, Allocator> this_type;
+		typedef T                                   value_type;
+		typedef const T&                            const_reference;
+		typedef Compare                             compare_type;
+		typedef eastl_size_t                        size_type;
+		typedef Allocator                           allocator_type;
+		typedef pairing_heap_node<T>                node_type;
+		typedef node_type*                          handle_type;
+
+	public:
+		pairing_heap(const allocator_type& allocator = EASTL_PAIRING_HEAP_DEFAULT_ALLOCATOR);
+		explicit pairing_heap(const compare_type& compare, const allocator_type& allocator = EASTL_PAIRING_HEAP_DEFAULT_ALLOCATOR);
+	   ~pairing_heap();
+
+		void swap(this_type& x);
+
+		bool      empty() const EASTL_NOEXCEPT { return (mnSize == 0); }
+		size_type size() const EASTL_NOEXCEPT  { return mnSize; }
+
+		const_reference top() const
+			{ EASTL_ASSERT(mpRoot); return mpRoot->mValue; }
+
+		handle_type top_handle() const
+			{ EASTL_ASSERT(mpRoot); return mpRoot; }
+
+		handle_type push(const value_type& value);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			handle_type push(value_type&& value);
+		#endif
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED && EASTL_VARIADIC_TEMPLATES_ENABLED
+			template <class... Args>
+			handle_type emplace(Args&&... args);
+		#endif
+
+		void pop();
+		void pop(value_type& value); // Allows popping a move-only type (e.g. unique_ptr).
+
+		/// merge
+		/// Moves all of x's entries into this heap in O(1). The handles of x's
+		/// entries remain valid and now refer to entries of this heap. The two
+		/// heaps must have equal allocators.
+		void merge(this_type& x);
+
+		/// get
+		/// Returns the value of the entry referred to by h.
+		static const_reference get(handle_type h)
+			{ return h->mValue; }
+
+		/// decrease_key
+		/// Sets the value of h's entry to value, which must have priority
+		/// no lower than the current value (i.e. !compare(value, get(h))).
+		/// This is O(1); the name follows the usual min-heap terminology.
+		void decrease_key(handle_type h, const value_type& value);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			void decrease_key(handle_type h, value_type&& value);
+		#endif
+
+		/// change
+		/// Sets the value of h's entry to value, of any priority. Lowering the
+		/// priority costs as much as a pop.
+		void change(handle_type h, const value_type& value);
+
+		/// erase
+		/// Removes h's entry from the heap; amortized O(log n).
+		void erase(handle_type h);
+
+		void clear();
+
+		const compare_type& comp() const EASTL_NOEXCEPT { return mCompare; }
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+		bool validate() const;
+
+	protected:
+		node_type*     mpRoot;
+		size_type      mnSize;
+		compare_type   mCompare;
+		allocator_type mAllocator;
+
+		node_type*  DoAllocateNode();
+		void        DoFreeNode(node_type* pNode);
+		handle_type DoInsertNode(node_type* pNode);
+		node_type*  DoLink(node_type* pA, node_type* pB);
+		node_type*  DoCombineSiblings(node_type* pFirst);
+		void        DoCut(node_type* pNode);
+		void        DoRaise(node_type* pNode);
+		void        DoRemoveRoot();
+
+	private:
+		// The handles are node pointers, which a copy would invalidate.
+		pairing_heap(const this_type&);
+		this_type& operator=(const this_type&);
+	}; // class pairing_heap
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// pairing_heap
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename C, typename A>
+	inline pairing_heap<T, C, A>::pairing_heap(const allocator_type& allocator)
+		: mpRoot(NULL), mnSize(0), mCompare(), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline pairing_heap<T, C, A>::pairing_heap(const compare_type& compare, const allocator_type& allocator)
+		: mpRoot(NULL), mnSize(0), mCompare(compare), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline pairing_heap<T, C, A>::~pairing_heap()
+	{
+		clear();
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::swap(this_type& x)
+	{
+		eastl::swap(mpRoot,     x.mpRoot);
+		eastl::swap(mnSize,     x.mnSize);
+		eastl::swap(mCompare,   x.mCompare);
+		eastl::swap(mAllocator, x.mAllocator);
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline typename pairing_heap<T, C, A>::node_type*
+	pairing_heap<T, C, A>::DoAllocateNode()
+	{
+		node_type* const pNode = (node_type*)allocate_memory(mAllocator, sizeof(node_type), EASTL_ALIGN_OF(node_type), 0);
+		EASTL_ASSERT(pNode != NULL);
+		return pNode;
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::DoFreeNode(node_type* pNode)
+	{
+		pNode->mValue.~value_type();
+		EASTLFree(mAllocator, pNode, sizeof(node_type));
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline typename pairing_heap<T, C, A>::node_type*
+	pairing_heap<T, C, A>::DoLink(node_type* pA, node_type* pB)
+	{
+		// Links two roots, making the lower priority one the first child of the
+		// other, and returns the new root. The sibling links of the new root are
+		// left for the caller to set.
+		node_type* pWinner = pA;
+		node_type* pLoser  = pB;
+
+		if(mCompare(pA->mValue, pB->mValue))
+		{
+			pWinner = pB;
+			pLoser  = pA;
+		}
+
+		pLoser->mpNext = pWinner->mpChild;
+		pLoser->mpPrev = pWinner;
+		if(pWinner->mpChild)
+			pWinner->mpChild->mpPrev = pLoser;
+		pWinner->mpChild = pLoser;
+
+		return pWinner;
+	}
+
+
+	template <typename T, typename C, typename A>
+	typename pairing_heap<T, C, A>::node_type*
+	pairing_heap<T, C, A>::DoCombineSiblings(node_type* pFirst)
+	{
+		// The two-pass pairing. The first pass links the siblings in pairs from
+		// left to right and chains the results in reverse order through mpNext.
+		// The second pass links the chain into one tree, i.e. from right to left.
+		// Neither pass recurses, as a heap built by pushes alone is one node with
+		// n - 1 children.
+		if(!pFirst)
+			return NULL;
+
+		node_type* pPairs = NULL;
+
+		while(pFirst)
+		{
+			node_type* const pA = pFirst;
+			node_type* const pB = pA->mpNext;
+			node_type*       pTree;
+
+			if(pB)
+			{
+				pFirst = pB->mpNext;
+				pTree  = DoLink(pA, pB);
+			}
+			else
+			{
+				pFirst = NULL;
+				pTree  = pA;
+			}
+
+			pTree->mpNext = pPairs;
+			pPairs = pTree;
+		}
+
+		node_type* pRoot = pPairs;
+
+		for(pPairs = pPairs->mpNext; pPairs; )
+		{
+			node_type* const pNext = pPairs->mpNext;
+			pRoot  = DoLink(pRoot, pPairs);
+			pPairs = pNext;
+		}
+
+		pRoot->mpNext = pRoot->mpPrev = NULL;
+		return pRoot;
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::DoCut(node_type* pNode)
+	{
+		// Detaches a non-root node, with its subtree, from its parent or siblings.
+		node_type* const pPrev = pNode->mpPrev;
+
+		if(pPrev->mpChild == pNode)
+			pPrev->mpChild = pNode->mpNext;
+		else
+			pPrev->mpNext = pNode->mpNext;
+
+		if(pNode->mpNext)
+			pNode->mpNext->mpPrev = pPrev;
+
+		pNode->mpNext = pNode->mpPrev = NULL;
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::DoRaise(node_type* pNode)
+	{
+		// The node's priority was raised, so only its link to its parent can be
+		// out of order. Cutting it out leaves two valid trees.
+		if(pNode != mpRoot)
+		{
+			DoCut(pNode);
+			mpRoot = DoLink(mpRoot, pNode);
+			mpRoot->mpNext = mpRoot->mpPrev = NULL;
+		}
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::DoRemoveRoot()
+	{
+		node_type* const pRoot = mpRoot;
+		mpRoot = DoCombineSiblings(pRoot->mpChild);
+		DoFreeNode(pRoot);
+		--mnSize;
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline typename pairing_heap<T, C, A>::handle_type
+	pairing_heap<T, C, A>::DoInsertNode(node_type* pNode)
+	{
+		pNode->mpChild = pNode->mpNext = pNode->mpPrev = NULL;
+
+		if(mpRoot)
+		{
+			mpRoot = DoLink(mpRoot, pNode);
+			mpRoot->mpNext = mpRoot->mpPrev = NULL;
+		}
+		else
+			mpRoot = pNode;
+
+		++mnSize;
+		return pNode;
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline typename pairing_heap<T, C, A>::handle_type
+	pairing_heap<T, C, A>::push(const value_type& value)
+	{
+		node_type* const pNode = DoAllocateNode();
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+				::new((void*)&pNode->mValue) value_type(value);
+			}
+			catch(...)
+			{
+				EASTLFree(mAllocator, pNode, sizeof(node_type));
+				throw;
+			}
+		#else
+			::new((void*)&pNode->mValue) value_type(value);
+		#endif
+
+		return DoInsertNode(pNode);
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename T, typename C, typename A>
+		inline typename pairing_heap<T, C, A>::handle_type
+		pairing_heap<T, C, A>::push(value_type&& value)
+		{
+			node_type* const pNode = DoAllocateNode();
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+					::new((void*)&pNode->mValue) value_type(eastl::move(value));
+				}
+				catch(...)
+				{
+					EASTLFree(mAllocator, pNode, sizeof(node_type));
+					throw;
+				}
+			#else
+				::new((void*)&pNode->mValue) value_type(eastl::move(value));
+			#endif
+
+			return DoInsertNode(pNode);
+		}
+	#endif
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED && EASTL_VARIADIC_TEMPLATES_ENABLED
+		template <typename T, typename C, typename A>
+		template <class... Args>
+		inline typename pairing_heap<T, C, A>::handle_type
+		pairing_heap<T, C, A>::emplace(Args&&... args)
+		{
+			node_type* const pNode = DoAllocateNode();
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+					::new((void*)&pNode->mValue) value_type(eastl::forward<Args>(args)...);
+				}
+				catch(...)
+				{
+					EASTLFree(mAllocator, pNode, sizeof(node_type));
+					throw;
+				}
+			#else
+				::new((void*)&pNode->mValue) value_type(eastl::forward<Args>(args)...);
+			#endif
+
+			return DoInsertNode(pNode);
+		}
+	#endif
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::pop()
+	{
+		EASTL_ASSERT(mpRoot);
+		DoRemoveRoot();
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::pop(value_type& value)
+	{
+		EASTL_ASSERT(mpRoot);
+		value = eastl::move(mpRoot->mValue);
+		DoRemoveRoot();
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::merge(this_type& x)
+	{
+		EASTL_ASSERT(mAllocator == x.mAllocator); // The nodes of x will be freed with our allocator.
+
+		if((&x != this) && x.mpRoot)
+		{
+			mpRoot  = mpRoot ? DoLink(mpRoot, x.mpRoot) : x.mpRoot;
+			mpRoot->mpNext = mpRoot->mpPrev = NULL;
+			mnSize += x.mnSize;
+
+			x.mpRoot = NULL;
+			x.mnSize = 0;
+		}
+	}
+
+
+	template <typename T, typename C, typename A>
+	inline void pairing_heap<T, C, A>::decrease_key(handle_type h, const value_type& value)
+	{
+		EASTL_ASSERT(!mCompare(value, h->mValue)); // The new value must not have lower priority.
+		h->mValue = value;
+		DoRaise(h);
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename T, typename C, typename A>
+		inline void pairing_heap<T, C, A>::decrease_key(handle_type h, value_type&& value)
+		{
+			EASTL_ASSERT(!mCompare(value, h->mValue));
+			h->mValue = eastl::move(value);
+			DoRaise(h);
+		}
+	#endif
+
+
+	template <typename T, typename C, typename A>
+	void pairing_heap<T, C, A>::change(handle_type h, const value_type& value)
+	{
+		if(!mCompare(value, h->mValue))
+			decrease_key(h, value);
+		else
+		{
+			// The priority went down, so the node's children may now belong above
+			// it. Detach the node, pair up its children as a pop would, and link
+			// the node back in as a leaf.
+			h->mValue = value;
+
+			if(h != mpRoot)
+				DoCut(h);
+			else
+				mpRoot = NULL;
+
+			node_type* const pChildren = DoCombineSiblings(h->mpChild);
+			h->mpChild = NULL;
+
+			if(pChildren)
+				mpRoot = mpRoot ? DoLink(mpRoot, pChildren) : pChildren;
+			mpRoot = mpRoot ? DoLink(mpRoot, h) : h;
+			mpRoot->mpNext = mpRoot->mpPrev = NULL;
+		}
+	}
+
+
+	template <typename T, typename C, typename A>
+	void pairing_heap<T, C, A>::erase(handle_type h)
+	{
+		if(h == mpRoot)
+			DoRemoveRoot();
+		else
+		{
+			DoCut(h);
+
+			node_type* const pChildren = DoCombineSiblings(h->mpChild);
+			if(pChildren)
+			{
+				mpRoot = DoLink(mpRoot, pChildren);
+				mpRoot->mpNext = mpRoot->mpPrev = NULL;
+			}
+
+			DoFreeNode(h);
+			--mnSize;
+		}
+	}
+
+
+	template <typename T, typename C, typename A>
+	void pairing_heap<T, C, A>::clear()
+	{
+		// Frees the nodes in O(n) without recursion, by splicing each node's
+		// children into the chain of nodes still to be freed.
+		node_type* pNode = mpRoot;
+
+		while(pNode)
+		{
+			node_type* pNext = pNode->mpNext;
+
+			if(pNode->mpChild)
+			{
+				node_type* pLast = pNode->mpChild;
+				while(pLast->mpNext)
+					pLast = pLast->mpNext;
+				pLast->mpNext = pNext;
+				pNext = pNode->mpChild;
+			}
+
+			DoFreeNode(pNode);
+			pNode = pNext;
+		}
+
+		mpRoot = NULL;
+		mnSize = 0;
+	}
+
+
+	template <typename T, typename C, typename A>
+	bool pairing_heap<T, C, A>::validate() const
+	{
+		// Walks the tree in preorder without recursion, checking the links and
+		// that no node has higher priority than its parent.
+		if(!mpRoot)
+			return (mnSize == 0);
+
+		if(mpRoot->mpNext || mpRoot->mpPrev)
+			return false;
+
+		size_type        nCount = 0;
+		const node_type* pNode  = mpRoot;
+
+		while(pNode)
+		{
+			++nCount;
+
+			for(const node_type* pChild = pNode->mpChild, *pPrev = pNode; pChild; pPrev = pChild, pChild = pChild->mpNext)
+			{
+				if(pChild->mpPrev != pPrev)
+					return false;
+				if(mCompare(pNode->mValue, pChild->mValue))
+					return false;
+			}
+
+			// Advance to the next node in preorder: the first child, else the next
+			// sibling of the nearest ancestor that has one.
+			if(pNode->mpChild)
+				pNode = pNode->mpChild;
+			else
+			{
+				while(pNode && !pNode->mpNext)
+				{
+					// Climb to the parent: step back to the first sibling, whose mpPrev is the parent.
+					while(pNode->mpPrev && (pNode->mpPrev->mpChild != pNode))
+						pNode = pNode->mpPrev;
+					pNode = pNode->mpPrev;
+				}
+
+				if(pNode)
+					pNode = pNode->mpNext;
+			}
+
+			if(nCount > mnSize)
+				return false;
+		}
+
+		return (nCount == mnSize);
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename C, typename A>
+	inline void swap(pairing_heap<T, C, A>& a, pairing_heap<T, C, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
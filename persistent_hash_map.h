@@ -0,0 +1,1378 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements persistent_hash_map, an immutable hashed map whose
+// versions share structure, plus two helpers which go with it:
+//    - persistent_hash_map_transient, for making a batch of edits cheaply.
+//    - atomic_persistent_hash_map, for publishing versions to other threads.
+//
+// persistent_hash_map uses the same bitmap-compressed trie layout as
+// hash_trie_map (see internal/hash_trie.h), but its nodes are reference counted
+// and never modified once they are shared. insert and erase copy only the
+// nodes on the path from the root to the affected entry (about log32(n) of
+// them) and return a new map which shares every other node with the original.
+// Copying a persistent_hash_map is thus O(1): it increments one reference count.
+//
+// The intended use is publishing read-only snapshots of a large map to reader
+// threads. A writer derives new versions and stores them into an
+// atomic_persistent_hash_map; readers load the current version, which they can
+// then use for as long as they like without any locking. Since node reference
+// counts are updated atomically, versions may be created and destroyed on any
+// thread. A given persistent_hash_map object is no more thread-safe than an int,
+// however: two threads must not assign to the same map object concurrently.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_PERSISTENT_HASH_MAP_H
+#define EASTL_PERSISTENT_HASH_MAP_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/hash_trie.h>
+#include <eastl/internal/thread_support.h>
+#include <eastl/functional.h>
+#include <eastl/utility.h>
+#include <eastl/initializer_list.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_PERSISTENT_HASH_MAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_PERSISTENT_HASH_MAP_DEFAULT_NAME
+		#define EASTL_PERSISTENT_HASH_MAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " persistent_hash_map" // Unless the user overrides something, this is "EASTL persistent_hash_map".
+	#endif
+
+
+	/// EASTL_PERSISTENT_HASH_MAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_PERSISTENT_HASH_MAP_DEFAULT_ALLOCATOR
+		#define EASTL_PERSISTENT_HASH_MAP_DEFAULT_ALLOCATOR allocator_type(EASTL_PERSISTENT_HASH_MAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// persistent_hash_trie_node
+	///
+	/// A hash_trie_node with a reference count and an edit token. The reference
+	/// count is the number of parent nodes and maps which point at the node.
+	/// The edit token identifies the transient which created the node, if any;
+	/// a transient may modify its own nodes in place, as no one else can see them.
+	/// Zero means the node is frozen.
+	///
+	struct persistent_hash_trie_node : public hash_trie_node
+	{
+		int32_t  mnRefCount;
+		uint32_t mnEdit;
+	};
+
+
+	namespace Internal
+	{
+		/// persistent_hash_trie_new_edit
+		///
+		/// Returns a new nonzero edit token. Tokens are only compared for equality,
+		/// so wrapping around after four billion transients is harmless unless
+		/// a transient lives that long.
+		///
+		inline uint32_t persistent_hash_trie_new_edit()
+		{
+			static int32_t sEdit = 0;
+			int32_t        edit;
+
+			do {
+				edit = atomic_increment(&sEdit);
+			} while(edit == 0);
+
+			return (uint32_t)edit;
+		}
+	}
+
+
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+	class persistent_hash_map_transient;
+
+
+
+	/// persistent_hash_map
+	///
+	/// Implements an immutable hashed unique-key map with structural sharing.
+	/// There are no mutating member functions other than assignment and swap.
+	/// Instead, insert, insert_or_assign and erase are const and return a new
+	/// map which differs from this one by the given edit:
+	///
+	///     persistent_hash_map<int, Widget> v1;
+	///     persistent_hash_map<int, Widget> v2 = v1.insert(makePair(37, widget)); // v1 is unchanged.
+	///     persistent_hash_map<int, Widget> v3 = v2.erase(37);                    // v2 is unchanged.
+	///
+	/// Each such edit costs about log32(n) node allocations. To make many edits
+	/// at once, use transient(), which edits the nodes it has already copied in
+	/// place, then persistent() to obtain the resulting map.
+	///
+	/// Iterators, pointers and references into a map stay valid for as long as
+	/// the map (or any map which shares the element's node) exists.
+	///
+	/// All versions derived from a map share nodes, and any of them may free a
+	/// node, so they all use copies of the original map's allocator. The
+	/// allocator must therefore be one whose copies can free each other's memory.
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
+			  typename Allocator = EASTLAllocatorType>
+	class persistent_hash_map
+	{
+	public:
+		typedef persistent_hash_map<Key, T, Hash, Predicate, Allocator>                   this_type;
+		typedef persistent_hash_map_transient<Key, T, Hash, Predicate, Allocator>         transient_type;
+		typedef Key                                                                       key_type;
+		typedef T                                                                         mapped_type;
+		typedef eastl::pair<const Key, T>                                                 value_type;
+		typedef const value_type&                                                         reference;
+		typedef const value_type&                                                         const_reference;
+		typedef eastl_size_t                                                              size_type;     // See config.h for the definition of eastl_size_t, which defaults to size_t.
+		typedef ptrdiff_t                                                                 difference_type;
+		typedef Allocator                                                                 allocator_type;
+		typedef Hash                                                                      hasher;
+		typedef Predicate                                                                 key_equal;
+		typedef hash_trie_iterator<value_type, true, persistent_hash_trie_node>           const_iterator;
+		typedef const_iterator                                                            iterator;      // Elements are immutable.
+		typedef persistent_hash_trie_node                                                 node_type;
+		typedef hash_trie_layout<value_type, persistent_hash_trie_node>                   layout_type;
+
+		friend class persistent_hash_map_transient<Key, T, Hash, Predicate, Allocator>;
+
+	public:
+		explicit persistent_hash_map(const allocator_type& allocator = EASTL_PERSISTENT_HASH_MAP_DEFAULT_ALLOCATOR);
+		explicit persistent_hash_map(const Hash& hashFunction, const Predicate& predicate = Predicate(),
+									 const allocator_type& allocator = EASTL_PERSISTENT_HASH_MAP_DEFAULT_ALLOCATOR);
+
+		persistent_hash_map(std::initializer_list<value_type> ilist, const Hash& hashFunction = Hash(),
+							const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_PERSISTENT_HASH_MAP_DEFAULT_ALLOCATOR);
+
+		template <typename InputIterator>
+		persistent_hash_map(InputIterator first, InputIterator last, const Hash& hashFunction = Hash(),
+							const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_PERSISTENT_HASH_MAP_DEFAULT_ALLOCATOR);
+
+		persistent_hash_map(const this_type& x);
+	   ~persistent_hash_map();
+
+		this_type& operator=(const this_type& x);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			persistent_hash_map(this_type&& x);
+			this_type& operator=(this_type&& x);
+		#endif
+
+		void swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT;
+
+		const_iterator begin() const EASTL_NOEXCEPT;
+		const_iterator cbegin() const EASTL_NOEXCEPT;
+		const_iterator end() const EASTL_NOEXCEPT;
+		const_iterator cend() const EASTL_NOEXCEPT;
+
+		bool      empty() const EASTL_NOEXCEPT;
+		size_type size() const EASTL_NOEXCEPT;
+
+		hasher    hash_function() const;
+		key_equal key_eq() const;
+
+		const_iterator    find(const key_type& key) const;
+		size_type         count(const key_type& key) const;
+		const value_type* find_value(const key_type& key) const; // Returns NULL if not found. Cheaper than find, as no iterator path is built.
+
+		this_type insert(const value_type& value) const;                                     // Returns *this (sharing everything) if the key is already present.
+		this_type insert_or_assign(const key_type& key, const mapped_type& obj) const;
+		this_type erase(const key_type& key) const;                                          // Returns *this (sharing everything) if the key is absent.
+
+		template <typename InputIterator>
+		this_type insert(InputIterator first, InputIterator last) const;                    // Uses a transient internally.
+
+		transient_type transient() const;
+
+		// Returns true if x is this version or a copy of it, as opposed to a
+		// map which merely has equal contents. This is O(1).
+		bool identical(const this_type& x) const EASTL_NOEXCEPT;
+
+		bool validate() const;
+		int  validateIterator(const_iterator i) const;
+
+	protected:
+		enum InsertResult
+		{
+			kInsertUnchanged,
+			kInsertAssigned,
+			kInsertInserted
+		};
+
+		enum EraseResult
+		{
+			kEraseNotFound,
+			kEraseModified,
+			kEraseEmptied,
+			kEraseSingleValue // The node is left with just one value and no children; the parent should inline the value.
+		};
+
+		static const uint32_t kNoIndex = 0xffffffff;
+
+		node_type*  mpRoot;
+		size_type   mnElementCount;
+		Hash        mHash;
+		Predicate   mPredicate;
+		Allocator   mAllocator;
+
+		static bool IsEditable(const node_type* pNode, uint32_t edit)
+			{ return (edit != 0) && (pNode->mnEdit == edit); }
+
+		bool       DoInsertValue(const value_type& value, bool bAssign, uint32_t edit);
+		bool       DoEraseKey(const key_type& key, uint32_t edit);
+		node_type* DoAssoc(node_type* pNode, uint32_t depth, size_t h, const value_type& value, bool bAssign, uint32_t edit, int& result);
+		node_type* DoDissoc(node_type* pNode, uint32_t depth, size_t h, const key_type& key, uint32_t edit, int& result);
+		node_type* DoCreatePairNode(const value_type& a, size_t ha, const value_type& b, size_t hb, uint32_t depth, uint32_t edit);
+		node_type* DoRebuild(node_type* pNode, uint32_t depth, uint32_t nDataMap, uint32_t nNodeMap,
+							 uint32_t iRemoveValue, uint32_t iInsertValue, const value_type* pInsertValue,
+							 uint32_t jRemoveChild, uint32_t jInsertChild, node_type* pInsertChild, uint32_t edit);
+		const value_type* DoFind(const key_type& key, const_iterator* pIterator) const;
+
+		node_type* DoAllocateNode(uint32_t nDataCount, uint32_t nNodeCount, uint32_t nDataMap, uint32_t nNodeMap, uint32_t edit);
+		void       DoFreeNode(node_type* pNode, uint32_t nDataCount, uint32_t nNodeCount);
+		void       DoRelease(node_type* pNode, uint32_t depth);
+		size_type  DoValidate(const node_type* pNode, uint32_t depth, size_t hashPrefix) const;
+
+	}; // class persistent_hash_map
+
+
+
+	/// persistent_hash_map_transient
+	///
+	/// A mutable map for making a batch of edits to a persistent_hash_map. The
+	/// first edit along a path copies the path as usual, but marks the copies
+	/// as owned by this transient. Later edits reuse those nodes in place rather
+	/// than copying them again, so n edits cost far fewer than n * log32(n)
+	/// allocations. persistent() returns the result as a persistent_hash_map
+	/// and freezes every node made so far; the transient remains usable and
+	/// simply copies again from that point on.
+	///
+	/// A transient is not thread-safe, and its edits invalidate its iterators.
+	/// It is movable but not copyable, as a copy would share its owned nodes.
+	///
+	/// Example usage:
+	///     persistent_hash_map<int, int>::transient_type t = map.transient();
+	///     for(int i = 0; i < 1000; i++)
+	///         t.insert_or_assign(i, i * i);
+	///     map = t.persistent();
+	///
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator>
+	class persistent_hash_map_transient
+	{
+	public:
+		typedef persistent_hash_map_transient<Key, T, Hash, Predicate, Allocator> this_type;
+		typedef persistent_hash_map<Key, T, Hash, Predicate, Allocator>           map_type;
+		typedef typename map_type::key_type                                       key_type;
+		typedef typename map_type::mapped_type                                    mapped_type;
+		typedef typename map_type::value_type                                     value_type;
+		typedef typename map_type::size_type                                      size_type;
+		typedef typename map_type::const_iterator                                 const_iterator;
+		typedef typename map_type::iterator                                       iterator;
+
+	public:
+		explicit persistent_hash_map_transient(const map_type& map)
+			: mMap(map), mnEdit(Internal::persistent_hash_trie_new_edit()) { }
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			persistent_hash_map_transient(this_type&& x)
+				: mMap(eastl::move(x.mMap)), mnEdit(x.mnEdit) { x.mnEdit = Internal::persistent_hash_trie_new_edit(); }
+		#endif
+
+		const_iterator begin() const EASTL_NOEXCEPT { return mMap.begin(); }
+		const_iterator end() const EASTL_NOEXCEPT   { return mMap.end(); }
+
+		bool      empty() const EASTL_NOEXCEPT { return mMap.empty(); }
+		size_type size() const EASTL_NOEXCEPT  { return mMap.size(); }
+
+		const_iterator    find(const key_type& key) const       { return mMap.find(key); }
+		size_type         count(const key_type& key) const      { return mMap.count(key); }
+		const value_type* find_value(const key_type& key) const { return mMap.find_value(key); }
+
+		// Returns true if the value was inserted, false if the key was already present.
+		bool insert(const value_type& value)
+			{ return mMap.DoInsertValue(value, false, mnEdit); }
+
+		template <typename InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for(; first != last; ++first)
+				mMap.DoInsertValue(*first, false, mnEdit);
+		}
+
+		// Returns true if the value was inserted, false if an existing value was assigned.
+		bool insert_or_assign(const key_type& key, const mapped_type& obj)
+			{ return mMap.DoInsertValue(value_type(key, obj), true, mnEdit); }
+
+		size_type erase(const key_type& key)
+			{ return mMap.DoEraseKey(key, mnEdit) ? 1 : 0; }
+
+		map_type persistent()
+		{
+			mnEdit = Internal::persistent_hash_trie_new_edit(); // Freeze the nodes we own, as the returned map now shares them.
+			return mMap;
+		}
+
+		bool validate() const
+			{ return mMap.validate(); }
+
+	protected:
+		map_type mMap;
+		uint32_t mnEdit;
+
+	private:
+		#if defined(EA_COMPILER_NO_DELETED_FUNCTIONS)
+			persistent_hash_map_transient(const this_type&);
+			void operator=(const this_type&);
+		#else
+			persistent_hash_map_transient(const this_type&) = delete;
+			void operator=(const this_type&) = delete;
+		#endif
+
+	}; // class persistent_hash_map_transient
+
+
+
+	/// atomic_persistent_hash_map
+	///
+	/// Holds a persistent_hash_map which can be loaded and replaced concurrently
+	/// by any number of threads. This is the publication point between a writer
+	/// and its readers:
+	///
+	///     atomic_persistent_hash_map<int, Widget> gWidgets;
+	///
+	///     // Writer thread
+	///     gWidgets.store(gWidgets.load().insert(makePair(id, widget)));
+	///
+	///     // Reader threads
+	///     persistent_hash_map<int, Widget> snapshot = gWidgets.load(); // O(1); snapshot never changes.
+	///
+	/// Each operation holds a mutex private to this object for the duration of a
+	/// pointer swap and a reference count increment; freeing a replaced version
+	/// happens after the mutex is released. Multiple writers should use
+	/// compare_exchange in a loop, retrying their edit on the returned version.
+	///
+	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
+			  typename Allocator = EASTLAllocatorType>
+	class atomic_persistent_hash_map
+	{
+	public:
+		typedef atomic_persistent_hash_map<Key, T, Hash, Predicate, Allocator> this_type;
+		typedef persistent_hash_map<Key, T, Hash, Predicate, Allocator>        map_type;
+
+	public:
+		atomic_persistent_hash_map()
+			: mMap(), mMutex() { }
+
+		explicit atomic_persistent_hash_map(const map_type& map)
+			: mMap(map), mMutex() { }
+
+		map_type load() const
+		{
+			Internal::auto_mutex lock(mMutex);
+			return mMap;
+		}
+
+		void store(const map_type& map)
+		{
+			map_type temp(map);
+			{
+				Internal::auto_mutex lock(mMutex);
+				mMap.swap(temp);
+			}
+		} // The previous version is released here, outside the mutex.
+
+		map_type exchange(const map_type& map)
+		{
+			map_type temp(map);
+			{
+				Internal::auto_mutex lock(mMutex);
+				mMap.swap(temp);
+			}
+			return temp;
+		}
+
+		// If the current version is identical to expected, replaces it with desired
+		// and returns true. Else sets expected to the current version and returns false.
+		bool compare_exchange(map_type& expected, const map_type& desired)
+		{
+			map_type temp(desired);
+			{
+				Internal::auto_mutex lock(mMutex);
+
+				if(!mMap.identical(expected))
+				{
+					temp = mMap;
+					expected.swap(temp);
+					return false;
+				}
+
+				mMap.swap(temp);
+			}
+			return true;
+		}
+
+	protected:
+		map_type                 mMap;
+		mutable Internal::mutex  mMutex;
+
+	private:
+		#if defined(EA_COMPILER_NO_DELETED_FUNCTIONS)
+			atomic_persistent_hash_map(const this_type&);
+			void operator=(const this_type&);
+		#else
+			atomic_persistent_hash_map(const this_type&) = delete;
+			void operator=(const this_type&) = delete;
+		#endif
+
+	}; // class atomic_persistent_hash_map
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// persistent_hash_map
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline persistent_hash_map<K, T, H, P, A>::persistent_hash_map(const allocator_type& allocator)
+		: mpRoot(NULL), mnElementCount(0), mHash(), mPredicate(), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline persistent_hash_map<K, T, H, P, A>::persistent_hash_map(const H& hashFunction, const P& predicate, const allocator_type& allocator)
+		: mpRoot(NULL), mnElementCount(0), mHash(hashFunction), mPredicate(predicate), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline persistent_hash_map<K, T, H, P, A>::persistent_hash_map(std::initializer_list<value_type> ilist, const H& hashFunction,
+																	const P& predicate, const allocator_type& allocator)
+		: mpRoot(NULL), mnElementCount(0), mHash(hashFunction), mPredicate(predicate), mAllocator(allocator)
+	{
+		const uint32_t edit = Internal::persistent_hash_trie_new_edit(); // Nobody else can see our nodes yet, so edit them in place.
+
+		for(const value_type* p = ilist.begin(); p != ilist.end(); ++p)
+			DoInsertValue(*p, false, edit);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	template <typename InputIterator>
+	inline persistent_hash_map<K, T, H, P, A>::persistent_hash_map(InputIterator first, InputIterator last, const H& hashFunction,
+																	const P& predicate, const allocator_type& allocator)
+		: mpRoot(NULL), mnElementCount(0), mHash(hashFunction), mPredicate(predicate), mAllocator(allocator)
+	{
+		const uint32_t edit = Internal::persistent_hash_trie_new_edit();
+
+		for(; first != last; ++first)
+			DoInsertValue(*first, false, edit);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline persistent_hash_map<K, T, H, P, A>::persistent_hash_map(const this_type& x)
+		: mpRoot(x.mpRoot), mnElementCount(x.mnElementCount), mHash(x.mHash), mPredicate(x.mPredicate), mAllocator(x.mAllocator)
+	{
+		if(mpRoot)
+			Internal::atomic_increment(&mpRoot->mnRefCount);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline persistent_hash_map<K, T, H, P, A>::~persistent_hash_map()
+	{
+		if(mpRoot)
+			DoRelease(mpRoot, 0);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::this_type&
+	persistent_hash_map<K, T, H, P, A>::operator=(const this_type& x)
+	{
+		this_type temp(x); // This handles self-assignment, and releases our old root after the new one is referenced.
+		swap(temp);
+		return *this;
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename T, typename H, typename P, typename A>
+		inline persistent_hash_map<K, T, H, P, A>::persistent_hash_map(this_type&& x)
+			: mpRoot(NULL), mnElementCount(0), mHash(x.mHash), mPredicate(x.mPredicate), mAllocator(x.mAllocator)
+		{
+			swap(x);
+		}
+
+
+		template <typename K, typename T, typename H, typename P, typename A>
+		inline typename persistent_hash_map<K, T, H, P, A>::this_type&
+		persistent_hash_map<K, T, H, P, A>::operator=(this_type&& x)
+		{
+			swap(x);
+			return *this;
+		}
+	#endif
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void persistent_hash_map<K, T, H, P, A>::swap(this_type& x)
+	{
+		eastl::swap(mpRoot, x.mpRoot);
+		eastl::swap(mnElementCount, x.mnElementCount);
+		eastl::swap(mHash, x.mHash);
+		eastl::swap(mPredicate, x.mPredicate);
+		eastl::swap(mAllocator, x.mAllocator);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline const typename persistent_hash_map<K, T, H, P, A>::allocator_type&
+	persistent_hash_map<K, T, H, P, A>::getAllocator() const EASTL_NOEXCEPT
+	{
+		return mAllocator;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::const_iterator
+	persistent_hash_map<K, T, H, P, A>::begin() const EASTL_NOEXCEPT
+	{
+		return const_iterator(mpRoot);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::const_iterator
+	persistent_hash_map<K, T, H, P, A>::cbegin() const EASTL_NOEXCEPT
+	{
+		return const_iterator(mpRoot);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::const_iterator
+	persistent_hash_map<K, T, H, P, A>::end() const EASTL_NOEXCEPT
+	{
+		return const_iterator();
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::const_iterator
+	persistent_hash_map<K, T, H, P, A>::cend() const EASTL_NOEXCEPT
+	{
+		return const_iterator();
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline bool persistent_hash_map<K, T, H, P, A>::empty() const EASTL_NOEXCEPT
+	{
+		return (mnElementCount == 0);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::size_type
+	persistent_hash_map<K, T, H, P, A>::size() const EASTL_NOEXCEPT
+	{
+		return mnElementCount;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::hasher
+	persistent_hash_map<K, T, H, P, A>::hash_function() const
+	{
+		return mHash;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::key_equal
+	persistent_hash_map<K, T, H, P, A>::key_eq() const
+	{
+		return mPredicate;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::const_iterator
+	persistent_hash_map<K, T, H, P, A>::find(const key_type& key) const
+	{
+		const_iterator it;
+		DoFind(key, &it);
+		return it;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::size_type
+	persistent_hash_map<K, T, H, P, A>::count(const key_type& key) const
+	{
+		return DoFind(key, NULL) ? 1 : 0;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline const typename persistent_hash_map<K, T, H, P, A>::value_type*
+	persistent_hash_map<K, T, H, P, A>::find_value(const key_type& key) const
+	{
+		return DoFind(key, NULL);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::this_type
+	persistent_hash_map<K, T, H, P, A>::insert(const value_type& value) const
+	{
+		this_type result(*this);
+		result.DoInsertValue(value, false, 0);
+		return result;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::this_type
+	persistent_hash_map<K, T, H, P, A>::insert_or_assign(const key_type& key, const mapped_type& obj) const
+	{
+		this_type result(*this);
+		result.DoInsertValue(value_type(key, obj), true, 0);
+		return result;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::this_type
+	persistent_hash_map<K, T, H, P, A>::erase(const key_type& key) const
+	{
+		this_type result(*this);
+		result.DoEraseKey(key, 0);
+		return result;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	template <typename InputIterator>
+	inline typename persistent_hash_map<K, T, H, P, A>::this_type
+	persistent_hash_map<K, T, H, P, A>::insert(InputIterator first, InputIterator last) const
+	{
+		transient_type t(*this);
+		t.insert(first, last);
+		return t.persistent();
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::transient_type
+	persistent_hash_map<K, T, H, P, A>::transient() const
+	{
+		return transient_type(*this);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline bool persistent_hash_map<K, T, H, P, A>::identical(const this_type& x) const EASTL_NOEXCEPT
+	{
+		return (mpRoot == x.mpRoot);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	const typename persistent_hash_map<K, T, H, P, A>::value_type*
+	persistent_hash_map<K, T, H, P, A>::DoFind(const key_type& key, const_iterator* pIterator) const
+	{
+		const node_type* pNode = mpRoot;
+		size_t           h     = mHash(key);
+
+		for(uint32_t depth = 0; pNode; ++depth, h >>= kHashTrieBitsPerLevel)
+		{
+			if(pIterator)
+			{
+				pIterator->mpNodeStack[depth]  = pNode;
+				pIterator->mnChildStack[depth] = 0;
+			}
+
+			if((depth + 1) == kHashTrieMaxDepth) // If this is a collision node...
+			{
+				const value_type* const pValues = layout_type::GetValues(pNode);
+
+				for(uint32_t i = 0; i < pNode->mDataMap; ++i)
+				{
+					if(mPredicate(pValues[i].first, key))
+					{
+						if(pIterator)
+						{
+							pIterator->mnDepth      = (int32_t)depth;
+							pIterator->mnValueIndex = i;
+						}
+						return pValues + i;
+					}
+				}
+				break;
+			}
+
+			const uint32_t bit = 1u << (h & kHashTrieLevelMask);
+
+			if(pNode->mDataMap & bit)
+			{
+				const uint32_t          i      = (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1));
+				const value_type* const pValue = layout_type::GetValues(pNode) + i;
+
+				if(mPredicate(pValue->first, key))
+				{
+					if(pIterator)
+					{
+						pIterator->mnDepth      = (int32_t)depth;
+						pIterator->mnValueIndex = i;
+					}
+					return pValue;
+				}
+				break;
+			}
+			else if(pNode->mNodeMap & bit)
+			{
+				const uint32_t j = (uint32_t)eastl::popcount(pNode->mNodeMap & (bit - 1));
+
+				if(pIterator) // Iteration resumes after this child, so that ++ continues correctly from the found value.
+					pIterator->mnChildStack[depth] = j + 1;
+
+				pNode = layout_type::GetChildren(pNode, (uint32_t)eastl::popcount(pNode->mDataMap))[j];
+			}
+			else
+				break;
+		}
+
+		return NULL;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline typename persistent_hash_map<K, T, H, P, A>::node_type*
+	persistent_hash_map<K, T, H, P, A>::DoAllocateNode(uint32_t nDataCount, uint32_t nNodeCount, uint32_t nDataMap, uint32_t nNodeMap, uint32_t edit)
+	{
+		node_type* const pNode = (node_type*)allocate_memory(mAllocator, layout_type::GetNodeSize(nDataCount, nNodeCount), layout_type::kNodeAlignment, 0);
+		EASTL_ASSERT(pNode != NULL);
+		pNode->mDataMap    = nDataMap;
+		pNode->mNodeMap    = nNodeMap;
+		pNode->mnRefCount  = 1;
+		pNode->mnEdit      = edit;
+		return pNode;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void persistent_hash_map<K, T, H, P, A>::DoFreeNode(node_type* pNode, uint32_t nDataCount, uint32_t nNodeCount)
+	{
+		EASTLFree(mAllocator, pNode, layout_type::GetNodeSize(nDataCount, nNodeCount));
+	}
+
+
+	// Drops one reference to pNode, freeing it and releasing its children if it was the last.
+	template <typename K, typename T, typename H, typename P, typename A>
+	void persistent_hash_map<K, T, H, P, A>::DoRelease(node_type* pNode, uint32_t depth)
+	{
+		if(Internal::atomic_decrement(&pNode->mnRefCount) == 0)
+		{
+			const uint32_t    nDataCount = layout_type::GetDataCount(pNode, depth);
+			const uint32_t    nNodeCount = layout_type::GetNodeCount(pNode);
+			value_type* const pValues    = layout_type::GetValues(pNode);
+			node_type** const pChildren  = layout_type::GetChildren(pNode, nDataCount);
+
+			eastl::destruct(pValues, pValues + nDataCount);
+
+			for(uint32_t j = 0; j < nNodeCount; ++j)
+				DoRelease(pChildren[j], depth + 1);
+
+			DoFreeNode(pNode, nDataCount, nNodeCount);
+		}
+	}
+
+
+	// Builds a new node with the given bitmaps from pNode, less the value at
+	// iRemoveValue and the child at jRemoveChild, plus *pInsertValue at index
+	// iInsertValue and pInsertChild at index jInsertChild (indexes are into the new
+	// node; kNoIndex means none). The new node holds the only reference to itself.
+	//
+	// If pNode is owned by edit, it is consumed: its values are moved and its child
+	// references transferred to the new node, and it is freed. Else pNode is left as
+	// is and the new node copies its values and adds references to its children.
+	// Either way the removed child's reference is left to the caller, and the new
+	// node takes over the caller's reference to pInsertChild, even on exception.
+	template <typename K, typename T, typename H, typename P, typename A>
+	typename persistent_hash_map<K, T, H, P, A>::node_type*
+	persistent_hash_map<K, T, H, P, A>::DoRebuild(node_type* pNode, uint32_t depth, uint32_t nDataMap, uint32_t nNodeMap,
+												  uint32_t iRemoveValue, uint32_t iInsertValue, const value_type* pInsertValue,
+												  uint32_t jRemoveChild, uint32_t jInsertChild, node_type* pInsertChild, uint32_t edit)
+	{
+		const bool        bOwned        = IsEditable(pNode, edit);
+		const uint32_t    nDataCount    = layout_type::GetDataCount(pNode, depth);
+		const uint32_t    nNodeCount    = layout_type::GetNodeCount(pNode);
+		const uint32_t    nNewDataCount = ((depth + 1) < kHashTrieMaxDepth) ? (uint32_t)eastl::popcount(nDataMap) : nDataMap;
+		const uint32_t    nNewNodeCount = (uint32_t)eastl::popcount(nNodeMap);
+		value_type* const pValues       = layout_type::GetValues(pNode);
+		node_type** const pChildren     = layout_type::GetChildren(pNode, nDataCount);
+		node_type*  const pNew          = DoAllocateNode(nNewDataCount, nNewNodeCount, nDataMap, nNodeMap, edit);
+		value_type* const pNewValues    = layout_type::GetValues(pNew);
+		node_type** const pNewChildren  = layout_type::GetChildren(pNew, nNewDataCount);
+		uint32_t          iNew          = 0;
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				for(uint32_t iOld = 0; iNew < nNewDataCount; ++iNew)
+				{
+					if(iNew == iInsertValue)
+						::new((void*)(pNewValues + iNew)) value_type(*pInsertValue);
+					else
+					{
+						if(iOld == iRemoveValue)
+							++iOld;
+
+						if(bOwned)
+							::new((void*)(pNewValues + iNew)) value_type(eastl::move_if_noexcept(pValues[iOld++]));
+						else
+							::new((void*)(pNewValues + iNew)) value_type(pValues[iOld++]);
+					}
+				}
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				eastl::destruct(pNewValues, pNewValues + iNew);
+				DoFreeNode(pNew, nNewDataCount, nNewNodeCount);
+				if(pInsertChild)
+					DoRelease(pInsertChild, depth + 1);
+				throw;
+			}
+		#endif
+
+		for(uint32_t jOld = 0, jNew = 0; jNew < nNewNodeCount; ++jNew)
+		{
+			if(jNew == jInsertChild)
+				pNewChildren[jNew] = pInsertChild;
+			else
+			{
+				if(jOld == jRemoveChild)
+					++jOld;
+
+				pNewChildren[jNew] = pChildren[jOld++];
+
+				if(!bOwned)
+					Internal::atomic_increment(&pNewChildren[jNew]->mnRefCount);
+			}
+		}
+
+		if(bOwned)
+		{
+			eastl::destruct(pValues, pValues + nDataCount);
+			DoFreeNode(pNode, nDataCount, nNodeCount);
+		}
+
+		return pNew;
+	}
+
+
+	// Creates the subtree which resolves a collision between two values whose
+	// hashes agree in all bits consumed so far. ha and hb are the unconsumed hash bits.
+	template <typename K, typename T, typename H, typename P, typename A>
+	typename persistent_hash_map<K, T, H, P, A>::node_type*
+	persistent_hash_map<K, T, H, P, A>::DoCreatePairNode(const value_type& a, size_t ha, const value_type& b, size_t hb, uint32_t depth, uint32_t edit)
+	{
+		const uint32_t bitA = 1u << (ha & kHashTrieLevelMask);
+		const uint32_t bitB = 1u << (hb & kHashTrieLevelMask);
+
+		if(((depth + 1) == kHashTrieMaxDepth) || (bitA != bitB))
+		{
+			const bool     bCollision = ((depth + 1) == kHashTrieMaxDepth);
+			node_type*     pNode      = DoAllocateNode(2, 0, bCollision ? 2 : (bitA | bitB), 0, edit);
+			value_type*    pValues    = layout_type::GetValues(pNode);
+			const uint32_t iA         = (bCollision || (bitA < bitB)) ? 0 : 1;
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+			#endif
+					::new((void*)(pValues + iA)) value_type(a);
+			#if EASTL_EXCEPTIONS_ENABLED
+				}
+				catch(...)
+				{
+					DoFreeNode(pNode, 2, 0);
+					throw;
+				}
+
+				try
+				{
+			#endif
+					::new((void*)(pValues + (iA ^ 1))) value_type(b);
+			#if EASTL_EXCEPTIONS_ENABLED
+				}
+				catch(...)
+				{
+					pValues[iA].~value_type();
+					DoFreeNode(pNode, 2, 0);
+					throw;
+				}
+			#endif
+
+			return pNode;
+		}
+
+		node_type* const pChild = DoCreatePairNode(a, ha >> kHashTrieBitsPerLevel, b, hb >> kHashTrieBitsPerLevel, depth + 1, edit);
+		node_type* const pNode  = DoAllocateNode(0, 1, 0, bitA, edit);
+		layout_type::GetChildren(pNode, 0)[0] = pChild;
+		return pNode;
+	}
+
+
+	// Returns pNode with value associated, which is pNode itself if it was edited in
+	// place or there was nothing to do, else a new node holding its only reference.
+	template <typename K, typename T, typename H, typename P, typename A>
+	typename persistent_hash_map<K, T, H, P, A>::node_type*
+	persistent_hash_map<K, T, H, P, A>::DoAssoc(node_type* pNode, uint32_t depth, size_t h, const value_type& value, bool bAssign, uint32_t edit, int& result)
+	{
+		const uint32_t    nDataCount = layout_type::GetDataCount(pNode, depth);
+		value_type* const pValues    = layout_type::GetValues(pNode);
+
+		if((depth + 1) == kHashTrieMaxDepth) // Collision node: linear search, then append.
+		{
+			for(uint32_t i = 0; i < nDataCount; ++i)
+			{
+				if(mPredicate(pValues[i].first, value.first))
+				{
+					if(!bAssign)
+					{
+						result = kInsertUnchanged;
+						return pNode;
+					}
+
+					result = kInsertAssigned;
+
+					if(IsEditable(pNode, edit))
+					{
+						pValues[i].second = value.second;
+						return pNode;
+					}
+					return DoRebuild(pNode, depth, nDataCount, 0, i, i, &value, kNoIndex, kNoIndex, NULL, edit);
+				}
+			}
+
+			result = kInsertInserted;
+			return DoRebuild(pNode, depth, nDataCount + 1, 0, kNoIndex, nDataCount, &value, kNoIndex, kNoIndex, NULL, edit);
+		}
+
+		const uint32_t bit = 1u << (h & kHashTrieLevelMask);
+
+		if(pNode->mDataMap & bit)
+		{
+			const uint32_t i = (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1));
+
+			if(mPredicate(pValues[i].first, value.first))
+			{
+				if(!bAssign)
+				{
+					result = kInsertUnchanged;
+					return pNode;
+				}
+
+				result = kInsertAssigned;
+
+				if(IsEditable(pNode, edit))
+				{
+					pValues[i].second = value.second;
+					return pNode;
+				}
+				return DoRebuild(pNode, depth, pNode->mDataMap, pNode->mNodeMap, i, i, &value, kNoIndex, kNoIndex, NULL, edit);
+			}
+
+			// Collision within this slot: replace the value with a subtree holding both values.
+			const uint32_t   j        = (uint32_t)eastl::popcount(pNode->mNodeMap & (bit - 1));
+			const size_t     oldHash  = mHash(pValues[i].first) >> ((depth + 1) * kHashTrieBitsPerLevel);
+			node_type* const pSubtree = DoCreatePairNode(pValues[i], oldHash, value, h >> kHashTrieBitsPerLevel, depth + 1, edit);
+
+			result = kInsertInserted;
+			return DoRebuild(pNode, depth, pNode->mDataMap & ~bit, pNode->mNodeMap | bit, i, kNoIndex, NULL, kNoIndex, j, pSubtree, edit);
+		}
+		else if(pNode->mNodeMap & bit)
+		{
+			const uint32_t   j         = (uint32_t)eastl::popcount(pNode->mNodeMap & (bit - 1));
+			node_type** const pChildren = layout_type::GetChildren(pNode, nDataCount);
+			node_type* const pChild    = pChildren[j];
+			const bool       bOwned    = IsEditable(pChild, edit);
+			node_type* const pNewChild = DoAssoc(pChild, depth + 1, h >> kHashTrieBitsPerLevel, value, bAssign, edit, result);
+
+			if(pNewChild == pChild)
+				return pNode;
+
+			if(IsEditable(pNode, edit))
+			{
+				pChildren[j] = pNewChild;
+				if(!bOwned) // An owned child was consumed by DoRebuild.
+					DoRelease(pChild, depth + 1);
+				return pNode;
+			}
+
+			EASTL_ASSERT(!bOwned); // Owned nodes only ever have owned parents.
+			return DoRebuild(pNode, depth, pNode->mDataMap, pNode->mNodeMap, kNoIndex, kNoIndex, NULL, j, j, pNewChild, edit);
+		}
+
+		// Empty slot: add the value to this node.
+		result = kInsertInserted;
+		return DoRebuild(pNode, depth, pNode->mDataMap | bit, pNode->mNodeMap, kNoIndex, (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1)), &value, kNoIndex, kNoIndex, NULL, edit);
+	}
+
+
+	// Returns pNode with key removed: pNode itself if it was edited in place or the key
+	// is absent, NULL if the node is left empty, else a new node holding its only
+	// reference. Keeps the trie in canonical form, as hash_trie::DoErase does.
+	template <typename K, typename T, typename H, typename P, typename A>
+	typename persistent_hash_map<K, T, H, P, A>::node_type*
+	persistent_hash_map<K, T, H, P, A>::DoDissoc(node_type* pNode, uint32_t depth, size_t h, const key_type& key, uint32_t edit, int& result)
+	{
+		const uint32_t    nDataCount = layout_type::GetDataCount(pNode, depth);
+		const uint32_t    nNodeCount = layout_type::GetNodeCount(pNode);
+		value_type* const pValues    = layout_type::GetValues(pNode);
+		node_type** const pChildren  = layout_type::GetChildren(pNode, nDataCount);
+		const bool        bEditable  = IsEditable(pNode, edit);
+
+		uint32_t i;       // Index of the value to remove, if any.
+		uint32_t bit = 0; // Bit of the value to remove (unused for collision nodes).
+
+		if((depth + 1) == kHashTrieMaxDepth)
+		{
+			for(i = 0; (i < nDataCount) && !mPredicate(pValues[i].first, key); ++i)
+				{ }
+
+			if(i == nDataCount)
+			{
+				result = kEraseNotFound;
+				return pNode;
+			}
+		}
+		else
+		{
+			bit = 1u << (h & kHashTrieLevelMask);
+
+			if(pNode->mNodeMap & bit)
+			{
+				const uint32_t   j         = (uint32_t)eastl::popcount(pNode->mNodeMap & (bit - 1));
+				node_type* const pChild    = pChildren[j];
+				const bool       bOwned    = IsEditable(pChild, edit);
+				node_type* const pNewChild = DoDissoc(pChild, depth + 1, h >> kHashTrieBitsPerLevel, key, edit, result);
+
+				if(result == kEraseNotFound)
+					return pNode;
+
+				if(result == kEraseModified)
+				{
+					if(pNewChild == pChild)
+						return pNode;
+
+					if(bEditable)
+					{
+						pChildren[j] = pNewChild;
+						if(!bOwned)
+							DoRelease(pChild, depth + 1);
+						return pNode;
+					}
+
+					return DoRebuild(pNode, depth, pNode->mDataMap, pNode->mNodeMap, kNoIndex, kNoIndex, NULL, j, j, pNewChild, edit);
+				}
+
+				// The child either vanished or is down to a single value which we inline here.
+				const bool     bInline       = (result == kEraseSingleValue);
+				const uint32_t nNewDataCount = nDataCount + (bInline ? 1 : 0);
+				node_type*     pNew          = NULL;
+
+				if(bEditable && !bOwned) // We drop our reference to the old child. An owned child was consumed already.
+					DoRelease(pChild, depth + 1);
+
+				if((nNewDataCount + nNodeCount - 1) == 0) // If this node is now empty...
+				{
+					if(bEditable)
+						DoFreeNode(pNode, 0, nNodeCount);
+					result = kEraseEmptied;
+					return NULL;
+				}
+
+				if(bInline)
+				{
+					#if EASTL_EXCEPTIONS_ENABLED
+						try
+						{
+					#endif
+							pNew = DoRebuild(pNode, depth, pNode->mDataMap | bit, pNode->mNodeMap & ~bit,
+											 kNoIndex, (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1)), layout_type::GetValues(pNewChild),
+											 j, kNoIndex, NULL, edit);
+					#if EASTL_EXCEPTIONS_ENABLED
+						}
+						catch(...)
+						{
+							DoRelease(pNewChild, depth + 1);
+							throw;
+						}
+					#endif
+
+					DoRelease(pNewChild, depth + 1); // The single-value child was built for us alone; its value now lives in pNew.
+				}
+				else
+					pNew = DoRebuild(pNode, depth, pNode->mDataMap, pNode->mNodeMap & ~bit, kNoIndex, kNoIndex, NULL, j, kNoIndex, NULL, edit);
+
+				result = ((depth > 0) && (nNewDataCount == 1) && (nNodeCount == 1)) ? kEraseSingleValue : kEraseModified;
+				return pNew;
+			}
+
+			if(!(pNode->mDataMap & bit))
+			{
+				result = kEraseNotFound;
+				return pNode;
+			}
+
+			i = (uint32_t)eastl::popcount(pNode->mDataMap & (bit - 1));
+
+			if(!mPredicate(pValues[i].first, key))
+			{
+				result = kEraseNotFound;
+				return pNode;
+			}
+		}
+
+		// Remove value i from this node.
+		if((nDataCount + nNodeCount) == 1)
+		{
+			if(bEditable)
+				DoRelease(pNode, depth);
+			result = kEraseEmptied;
+			return NULL;
+		}
+
+		result = ((depth > 0) && (nDataCount == 2) && (nNodeCount == 0)) ? kEraseSingleValue : kEraseModified;
+
+		const uint32_t nNewDataMap = ((depth + 1) == kHashTrieMaxDepth) ? (nDataCount - 1) : (pNode->mDataMap & ~bit);
+		return DoRebuild(pNode, depth, nNewDataMap, pNode->mNodeMap, i, kNoIndex, NULL, kNoIndex, kNoIndex, NULL, edit);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	bool persistent_hash_map<K, T, H, P, A>::DoInsertValue(const value_type& value, bool bAssign, uint32_t edit)
+	{
+		const size_t h = mHash(value.first);
+
+		if(!mpRoot)
+		{
+			node_type* const pNode = DoAllocateNode(1, 0, 1u << (h & kHashTrieLevelMask), 0, edit);
+
+			#if EASTL_EXCEPTIONS_ENABLED
+				try
+				{
+			#endif
+					::new((void*)layout_type::GetValues(pNode)) value_type(value);
+			#if EASTL_EXCEPTIONS_ENABLED
+				}
+				catch(...)
+				{
+					DoFreeNode(pNode, 1, 0);
+					throw;
+				}
+			#endif
+
+			mpRoot = pNode;
+			mnElementCount = 1;
+			return true;
+		}
+
+		node_type* const pRoot   = mpRoot;
+		const bool       bOwned  = IsEditable(pRoot, edit);
+		int              result  = kInsertUnchanged;
+		node_type* const pNewRoot = DoAssoc(pRoot, 0, h, value, bAssign, edit, result);
+
+		if(pNewRoot != pRoot)
+		{
+			mpRoot = pNewRoot;
+			if(!bOwned)
+				DoRelease(pRoot, 0);
+		}
+
+		if(result == kInsertInserted)
+		{
+			++mnElementCount;
+			return true;
+		}
+		return false;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	bool persistent_hash_map<K, T, H, P, A>::DoEraseKey(const key_type& key, uint32_t edit)
+	{
+		if(!mpRoot)
+			return false;
+
+		node_type* const pRoot    = mpRoot;
+		const bool       bOwned   = IsEditable(pRoot, edit);
+		int              result   = kEraseNotFound;
+		node_type* const pNewRoot = DoDissoc(pRoot, 0, mHash(key), key, edit, result);
+
+		if(result == kEraseNotFound)
+			return false;
+
+		if(pNewRoot != pRoot)
+		{
+			mpRoot = pNewRoot;
+			if(!bOwned)
+				DoRelease(pRoot, 0);
+		}
+
+		--mnElementCount;
+		return true;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline bool persistent_hash_map<K, T, H, P, A>::validate() const
+	{
+		if(!mpRoot)
+			return (mnElementCount == 0);
+		return DoValidate(mpRoot, 0, 0) == mnElementCount;
+	}
+
+
+	// Returns the number of values under pNode, or (size_type)-1 if the subtree is
+	// malformed: values in the wrong slot, overlapping bitmaps, non-canonical nodes,
+	// or nonpositive reference counts.
+	template <typename K, typename T, typename H, typename P, typename A>
+	typename persistent_hash_map<K, T, H, P, A>::size_type
+	persistent_hash_map<K, T, H, P, A>::DoValidate(const node_type* pNode, uint32_t depth, size_t hashPrefix) const
+	{
+		const size_type   kInvalid   = (size_type)-1;
+		const uint32_t    nDataCount = layout_type::GetDataCount(pNode, depth);
+		const uint32_t    nNodeCount = layout_type::GetNodeCount(pNode);
+		const value_type* pValues    = layout_type::GetValues(pNode);
+		const size_t      prefixMask = (depth * kHashTrieBitsPerLevel) < (sizeof(size_t) * 8) ? (((size_t)1 << (depth * kHashTrieBitsPerLevel)) - 1) : ~(size_t)0;
+
+		if(pNode->mnRefCount <= 0)
+			return kInvalid;
+
+		if((depth + 1) == kHashTrieMaxDepth)
+		{
+			if((nDataCount < 2) || (pNode->mNodeMap != 0))
+				return kInvalid;
+
+			for(uint32_t i = 0; i < nDataCount; ++i)
+			{
+				if((mHash(pValues[i].first) & prefixMask) != hashPrefix)
+					return kInvalid;
+			}
+			return nDataCount;
+		}
+
+		if((pNode->mDataMap & pNode->mNodeMap) || ((depth > 0) && (nDataCount + nNodeCount) == 0) || ((depth > 0) && (nDataCount == 1) && (nNodeCount == 0)))
+			return kInvalid;
+
+		size_type n = nDataCount;
+
+		for(uint32_t slot = 0, i = 0, j = 0; slot < 32; ++slot)
+		{
+			const uint32_t bit = 1u << slot;
+
+			if(pNode->mDataMap & bit)
+			{
+				if((mHash(pValues[i++].first) & ((prefixMask << kHashTrieBitsPerLevel) | kHashTrieLevelMask)) != (hashPrefix | ((size_t)slot << (depth * kHashTrieBitsPerLevel))))
+					return kInvalid;
+			}
+			else if(pNode->mNodeMap & bit)
+			{
+				const size_type nChild = DoValidate(layout_type::GetChildren(pNode, nDataCount)[j++], depth + 1, hashPrefix | ((size_t)slot << (depth * kHashTrieBitsPerLevel)));
+
+				if(nChild == kInvalid)
+					return kInvalid;
+				n += nChild;
+			}
+		}
+
+		return n;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline int persistent_hash_map<K, T, H, P, A>::validateIterator(const_iterator i) const
+	{
+		for(const_iterator temp = begin(), tempEnd = end(); temp != tempEnd; ++temp)
+		{
+			if(temp == i)
+				return (isf_valid | isf_current | isf_can_dereference);
+		}
+
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline void swap(persistent_hash_map<K, T, H, P, A>& a, persistent_hash_map<K, T, H, P, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline bool operator==(const persistent_hash_map<K, T, H, P, A>& a, const persistent_hash_map<K, T, H, P, A>& b)
+	{
+		if(a.identical(b))
+			return true;
+
+		if(a.size() != b.size())
+			return false;
+
+		for(typename persistent_hash_map<K, T, H, P, A>::const_iterator it = a.begin(), itEnd = a.end(); it != itEnd; ++it)
+		{
+			const typename persistent_hash_map<K, T, H, P, A>::value_type* const pValue = b.find_value(it->first);
+
+			if(!pValue || !(pValue->second == it->second))
+				return false;
+		}
+
+		return true;
+	}
+
+
+	template <typename K, typename T, typename H, typename P, typename A>
+	inline bool operator!=(const persistent_hash_map<K, T, H, P, A>& a, const persistent_hash_map<K, T, H, P, A>& b)
+	{
+		return !(a == b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
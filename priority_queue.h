@@ -202,6 +202,12 @@ namespace eastl
 
 		void pop(value_type& value);    // Extension to the C++11 Standard that allows popping a move-only type (e.g. unique_ptr).
 
+		template <typename InputIterator>
+		void push_range(InputIterator first, InputIterator last);   /// Pushes each item, or appends them all and remakes the heap if that is cheaper.
+
+		template <typename OutputIterator>
+		OutputIterator pop_n(size_type n, OutputIterator result);   /// Pops the min(n, size()) top items, writing them to result in priority order.
+
 		void change(size_type n);   /// Moves the item at the given array index to a new location based on its current priority.
 		void remove(size_type n);   /// Removes the item at the given array index.
 
@@ -426,6 +432,61 @@ namespace eastl
 	}
 
 
+	template <typename T, typename Container, typename Compare>
+	template <typename InputIterator>
+	inline void priority_queue<T, Container, Compare>::push_range(InputIterator first, InputIterator last) // This function is not in the STL std::priority_queue.
+	{
+		const size_type nOldSize = c.size();
+
+		#if EASTL_EXCEPTIONS_ENABLED
+			try
+			{
+		#endif
+				c.insert(c.end(), first, last);
+
+				if(Internal::HeapRebuildIsCheaper((size_t)nOldSize, (size_t)(c.size() - nOldSize)))
+					eastl::makeHeap(c.begin(), c.end(), comp);
+				else
+				{
+					for(size_type i = nOldSize; i < c.size(); ++i)
+						eastl::pushHeap(c.begin(), c.begin() + (difference_type)(i + 1), comp);
+				}
+		#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...)
+			{
+				c.clear();
+				throw;
+			}
+		#endif
+	}
+
+
+	template <typename T, typename Container, typename Compare>
+	template <typename OutputIterator>
+	inline OutputIterator priority_queue<T, Container, Compare>::pop_n(size_type n, OutputIterator result) // This function is not in the STL std::priority_queue.
+	{
+		if(n > c.size())
+			n = c.size();
+
+		// Each popHeap moves the top to the back of the shrinking heap, so the
+		// popped items collect at the back of c in reverse priority order.
+		const size_type nNewSize = c.size() - n;
+
+		for(size_type i = c.size(); i > nNewSize; --i)
+			eastl::popHeap(c.begin(), c.begin() + (difference_type)i, comp);
+
+		while(c.size() > nNewSize)
+		{
+			*result = eastl::move(c.back());
+			++result;
+			c.popBack();
+		}
+
+		return result;
+	}
+
+
 	template <typename T, typename Container, typename Compare>
 	inline void priority_queue<T, Container, Compare>::change(size_type n) // This function is not in the STL std::priority_queue.
 	{
@@ -0,0 +1,488 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements radix_heap, a monotone priority queue for integer and
+// floating point keys. A monotone priority queue requires that no key pushed
+// be less than the last key popped, which holds for Dijkstra's algorithm and
+// for discrete event simulation, where the popped key is the current time.
+//
+// The heap keeps its entries in buckets by the highest bit in which their
+// key differs from the last key popped: bucket 0 holds keys equal to it and
+// bucket i keys that differ first in bit i - 1. When bucket 0 runs out the
+// first non-empty bucket is scanned for its minimum, which becomes the last
+// key, and redistributed into lower buckets. Push is O(1) and as an entry
+// only ever moves to lower buckets, pop is amortized O(log C), where C is
+// the range of the keys; there are no comparisons between entries except
+// while finding a bucket's minimum.
+//
+// Unlike priority_queue, radix_heap pops its smallest key first.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_RADIX_HEAP_H
+#define EASTL_RADIX_HEAP_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/bit.h>
+#include <eastl/type_traits.h>
+#include <eastl/utility.h>
+#include <eastl/vector.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_RADIX_HEAP_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_RADIX_HEAP_DEFAULT_NAME
+		#define EASTL_RADIX_HEAP_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " radix_heap" // Unless the user overrides something, this is "EASTL radix_heap".
+	#endif
+
+
+	/// EASTL_RADIX_HEAP_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_RADIX_HEAP_DEFAULT_ALLOCATOR
+		#define EASTL_RADIX_HEAP_DEFAULT_ALLOCATOR allocator_type(EASTL_RADIX_HEAP_DEFAULT_NAME)
+	#endif
+
+
+
+	/// radix_heap_key
+	///
+	/// Maps a key to an unsigned integer with the same ordering. Signed integers
+	/// have their sign bit flipped. Floating point keys have their sign bit set
+	/// if positive and all their bits flipped if negative, with -0 treated as +0;
+	/// NaNs are not allowed.
+	/// Users may specialize this for their own key types.
+	///
+	template <typename Key>
+	struct radix_heap_key
+	{
+		typedef typename eastl::make_unsigned<Key>::type unsigned_type;
+
+		static unsigned_type encode(Key key)
+			{ return (unsigned_type)key ^ (eastl::is_signed<Key>::value ? (unsigned_type)((unsigned_type)1 << (sizeof(Key) * 8 - 1)) : (unsigned_type)0); }
+	};
+
+	template <>
+	struct radix_heap_key<float>
+	{
+		typedef uint32_t unsigned_type;
+
+		static unsigned_type encode(float key)
+		{
+			if(key == 0) // -0 compares equal to +0, so it must encode the same.
+				key = 0;
+
+			uint32_t bits;
+			memcpy(&bits, &key, sizeof(bits));
+			return bits ^ ((uint32_t)((int32_t)bits >> 31) | UINT32_C(0x80000000));
+		}
+	};
+
+	template <>
+	struct radix_heap_key<double>
+	{
+		typedef uint64_t unsigned_type;
+
+		static unsigned_type encode(double key)
+		{
+			if(key == 0) // -0 compares equal to +0, so it must encode the same.
+				key = 0;
+
+			uint64_t bits;
+			memcpy(&bits, &key, sizeof(bits));
+			return bits ^ ((uint64_t)((int64_t)bits >> 63) | UINT64_C(0x8000000000000000));
+		}
+	};
+
+
+
+	/// radix_heap
+	///
+	/// A min-priority queue of (key, value) pairs whose keys never go below the
+	/// last key popped. Key must be an integral or floating point type, or have
+	/// a radix_heap_key specialization.
+	///
+	/// top() is non-const: it may need to redistribute a bucket to find the
+	/// minimum, which raises the bound on the keys that may be pushed to the
+	/// key of top(). This doesn't affect the usual use of top() before pop().
+	///
+	/// Example usage:
+	///     eastl::radix_heap<uint32_t, uint32_t> frontier;   // (distance, vertex)
+	///     frontier.push(0, source);
+	///
+	///     while(!frontier.empty())
+	///     {
+	///         const uint32_t d = frontier.top().first, u = frontier.top().second;
+	///         frontier.pop();
+	///
+	///         if(d == distance[u])
+	///         {
+	///             for(each edge (u, v, w))
+	///             {
+	///                 if(d + w < distance[v])
+	///                     frontier.push(distance[v] = d + w, v);
+	///             }
+	///         }
+	///     }
+	///
+	template <typename Key, typename Value, typename Allocator = EASTLAllocatorType>
+	class radix_heap
+	{
+	public:
+		typedef radix_heap<Key, Value, Allocator>           this_type;
+		typedef Key                                         key_type;
+		typedef Value                                       mapped_type;
+		typedef eastl::pair<Key, Value>                     value_type;
+		typedef const value_type&                           const_reference;
+		typedef eastl_size_t                                size_type;
+		typedef Allocator                                   allocator_type;
+		typedef radix_heap_key<Key>                         key_traits;
+		typedef typename key_traits::unsigned_type          unsigned_type;
+
+		static const size_t kBucketCount = (sizeof(unsigned_type) * 8) + 1;
+
+	protected:
+		typedef eastl::vector<value_type, Allocator> bucket_type;
+
+	public:
+		radix_heap(const allocator_type& allocator = EASTL_RADIX_HEAP_DEFAULT_ALLOCATOR);
+		radix_heap(const this_type& x);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			radix_heap(this_type&& x);
+		#endif
+
+		this_type& operator=(const this_type& x);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			this_type& operator=(this_type&& x);
+		#endif
+
+		void swap(this_type& x);
+
+		bool      empty() const EASTL_NOEXCEPT { return (mnSize == 0); }
+		size_type size() const EASTL_NOEXCEPT  { return mnSize; }
+
+		const_reference top();
+
+		void push(const key_type& key, const mapped_type& value);
+		void push(const value_type& value);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			void push(const key_type& key, mapped_type&& value);
+			void push(value_type&& value);
+		#endif
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED && EASTL_VARIADIC_TEMPLATES_ENABLED
+			template <class... Args>
+			void emplace(const key_type& key, Args&&... args);
+		#endif
+
+		void pop();
+		void pop(value_type& value); // Allows popping a move-only value.
+
+		/// clear
+		/// Removes all entries and resets the last key, so that any key may be
+		/// pushed again. The buckets keep their memory.
+		void clear();
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mBuckets[0].getAllocator(); }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mBuckets[0].getAllocator(); }
+		void                  setAllocator(const allocator_type& allocator);
+
+		bool validate() const;
+
+	protected:
+		bucket_type   mBuckets[kBucketCount];
+		unsigned_type mLast;       // The encoded last key popped.
+		uint64_t      mnOccupied;  // Bit i - 1 is set if bucket i (for i >= 1) is non-empty.
+		size_type     mnSize;
+
+		static size_t DoBucketIndex(unsigned_type x, unsigned_type last)
+			{ return (size_t)eastl::bit_width((unsigned_type)(x ^ last)); }
+
+		bucket_type& DoBucketFor(const key_type& key);
+		void         DoPull();
+	}; // class radix_heap
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// radix_heap
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename A>
+	inline radix_heap<K, V, A>::radix_heap(const allocator_type& allocator)
+		: mLast(0), mnOccupied(0), mnSize(0)
+	{
+		EASTL_CT_ASSERT(kBucketCount <= 65); // mnOccupied has a bit for each bucket but the first.
+		setAllocator(allocator);
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline radix_heap<K, V, A>::radix_heap(const this_type& x)
+		: mLast(x.mLast), mnOccupied(x.mnOccupied), mnSize(x.mnSize)
+	{
+		setAllocator(x.getAllocator());
+		for(size_t i = 0; i < kBucketCount; ++i)
+			mBuckets[i] = x.mBuckets[i];
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename V, typename A>
+		inline radix_heap<K, V, A>::radix_heap(this_type&& x)
+			: mLast(0), mnOccupied(0), mnSize(0)
+		{
+			setAllocator(x.getAllocator());
+			swap(x);
+		}
+	#endif
+
+
+	template <typename K, typename V, typename A>
+	inline typename radix_heap<K, V, A>::this_type&
+	radix_heap<K, V, A>::operator=(const this_type& x)
+	{
+		if(&x != this)
+		{
+			for(size_t i = 0; i < kBucketCount; ++i)
+				mBuckets[i] = x.mBuckets[i];
+			mLast      = x.mLast;
+			mnOccupied = x.mnOccupied;
+			mnSize     = x.mnSize;
+		}
+		return *this;
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename V, typename A>
+		inline typename radix_heap<K, V, A>::this_type&
+		radix_heap<K, V, A>::operator=(this_type&& x)
+		{
+			swap(x);
+			return *this;
+		}
+	#endif
+
+
+	template <typename K, typename V, typename A>
+	inline void radix_heap<K, V, A>::swap(this_type& x)
+	{
+		for(size_t i = 0; i < kBucketCount; ++i)
+			mBuckets[i].swap(x.mBuckets[i]);
+		eastl::swap(mLast,      x.mLast);
+		eastl::swap(mnOccupied, x.mnOccupied);
+		eastl::swap(mnSize,     x.mnSize);
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline void radix_heap<K, V, A>::setAllocator(const allocator_type& allocator)
+	{
+		for(size_t i = 0; i < kBucketCount; ++i)
+			mBuckets[i].setAllocator(allocator);
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline typename radix_heap<K, V, A>::bucket_type&
+	radix_heap<K, V, A>::DoBucketFor(const key_type& key)
+	{
+		const unsigned_type x = key_traits::encode(key);
+		EASTL_ASSERT(x >= mLast); // The key must not be less than the last key popped.
+
+		const size_t i = DoBucketIndex(x, mLast);
+		if(i)
+			mnOccupied |= (uint64_t)1 << (i - 1);
+		++mnSize;
+
+		return mBuckets[i];
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline void radix_heap<K, V, A>::push(const key_type& key, const mapped_type& value)
+	{
+		DoBucketFor(key).pushBack(value_type(key, value));
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline void radix_heap<K, V, A>::push(const value_type& value)
+	{
+		DoBucketFor(value.first).pushBack(value);
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename K, typename V, typename A>
+		inline void radix_heap<K, V, A>::push(const key_type& key, mapped_type&& value)
+		{
+			DoBucketFor(key).pushBack(value_type(key, eastl::move(value)));
+		}
+
+		template <typename K, typename V, typename A>
+		inline void radix_heap<K, V, A>::push(value_type&& value)
+		{
+			DoBucketFor(value.first).pushBack(eastl::move(value));
+		}
+	#endif
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED && EASTL_VARIADIC_TEMPLATES_ENABLED
+		template <typename K, typename V, typename A>
+		template <class... Args>
+		inline void radix_heap<K, V, A>::emplace(const key_type& key, Args&&... args)
+		{
+			DoBucketFor(key).pushBack(value_type(key, mapped_type(eastl::forward<Args>(args)...)));
+		}
+	#endif
+
+
+	template <typename K, typename V, typename A>
+	void radix_heap<K, V, A>::DoPull()
+	{
+		// Refills bucket 0 from the first non-empty bucket. Its minimum becomes
+		// the last key and every entry in it moves to a lower bucket, since they
+		// all share the bits above the bucket's with the new last key.
+		EASTL_ASSERT(mBuckets[0].empty() && mnOccupied);
+
+		const size_t i = (size_t)eastl::countr_zero(mnOccupied) + 1;
+		bucket_type& bucket = mBuckets[i];
+
+		typename bucket_type::iterator it = bucket.begin(), itEnd = bucket.end();
+		unsigned_type newLast = key_traits::encode(it->first);
+
+		for(++it; it != itEnd; ++it)
+		{
+			const unsigned_type x = key_traits::encode(it->first);
+			if(x < newLast)
+				newLast = x;
+		}
+
+		mLast = newLast;
+
+		for(it = bucket.begin(); it != itEnd; ++it)
+		{
+			const size_t j = DoBucketIndex(key_traits::encode(it->first), newLast);
+			if(j)
+				mnOccupied |= (uint64_t)1 << (j - 1);
+			mBuckets[j].pushBack(eastl::move(*it));
+		}
+
+		bucket.clear();
+		mnOccupied &= ~((uint64_t)1 << (i - 1));
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline typename radix_heap<K, V, A>::const_reference
+	radix_heap<K, V, A>::top()
+	{
+		EASTL_ASSERT(mnSize != 0);
+
+		if(mBuckets[0].empty())
+			DoPull();
+
+		return mBuckets[0].back();
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline void radix_heap<K, V, A>::pop()
+	{
+		EASTL_ASSERT(mnSize != 0);
+
+		if(mBuckets[0].empty())
+			DoPull();
+
+		mBuckets[0].popBack();
+		--mnSize;
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline void radix_heap<K, V, A>::pop(value_type& value)
+	{
+		EASTL_ASSERT(mnSize != 0);
+
+		if(mBuckets[0].empty())
+			DoPull();
+
+		value = eastl::move(mBuckets[0].back());
+		mBuckets[0].popBack();
+		--mnSize;
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline void radix_heap<K, V, A>::clear()
+	{
+		for(size_t i = 0; i < kBucketCount; ++i)
+			mBuckets[i].clear();
+		mLast      = 0;
+		mnOccupied = 0;
+		mnSize     = 0;
+	}
+
+
+	template <typename K, typename V, typename A>
+	inline bool radix_heap<K, V, A>::validate() const
+	{
+		size_type nSize = 0;
+
+		for(size_t i = 0; i < kBucketCount; ++i)
+		{
+			const bucket_type& bucket = mBuckets[i];
+
+			if(i && (((mnOccupied >> (i - 1)) & 1) == bucket.empty()))
+				return false;
+
+			for(typename bucket_type::const_iterator it = bucket.begin(); it != bucket.end(); ++it)
+			{
+				if(DoBucketIndex(key_traits::encode(it->first), mLast) != i)
+					return false;
+			}
+
+			nSize += (size_type)bucket.size();
+		}
+
+		return (nSize == mnSize);
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename V, typename A>
+	inline void swap(radix_heap<K, V, A>& a, radix_heap<K, V, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,1084 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements basicRope, a string for large texts which are edited
+// in the middle, and its typedef rope.
+//
+// basicString::insert and erase move every character after the edit, so n
+// edits to a text of length m cost O(n * m). A rope stores the text as a
+// balanced binary tree whose leaves hold chunks of up to a few hundred
+// characters, so that insert, erase and substr are O(log m): they split the
+// tree at the edit positions and join the pieces back together.
+//
+// The nodes are reference counted and never modified once made, so edits
+// copy only the O(log m) nodes along their paths and share the rest, as with
+// persistent_hash_map. Copying a rope or taking a substring is thus cheap,
+// and copies may be used and destroyed on different threads.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_ROPE_H
+#define EASTL_ROPE_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/thread_support.h>
+#include <eastl/allocator.h>
+#include <eastl/iterator.h>
+#include <eastl/string.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <string.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_ROPE_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_ROPE_DEFAULT_NAME
+		#define EASTL_ROPE_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " rope" // Unless the user overrides something, this is "EASTL rope".
+	#endif
+
+
+	/// EASTL_ROPE_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_ROPE_DEFAULT_ALLOCATOR
+		#define EASTL_ROPE_DEFAULT_ALLOCATOR allocator_type(EASTL_ROPE_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_ROPE_LEAF_BYTES
+	///
+	/// The most bytes of characters a leaf holds. Larger leaves make the tree
+	/// shallower and iteration faster, but make each edit copy more.
+	///
+	#ifndef EASTL_ROPE_LEAF_BYTES
+		#define EASTL_ROPE_LEAF_BYTES 512
+	#endif
+
+
+
+	/// rope_node_base
+	///
+	/// A leaf has mnHeight 0 and is followed by its characters. A concatenation
+	/// has mnHeight 1 + the greater of its children's heights, which differ by
+	/// at most one, as in an AVL tree.
+	///
+	struct rope_node_base
+	{
+		int32_t          mnRefCount;  // The number of ropes and concatenations which point at the node.
+		uint32_t         mnHeight;
+		size_t           mnLength;    // The number of characters below the node.
+	};
+
+	struct rope_concat_node : public rope_node_base
+	{
+		rope_node_base*  mpLeft;
+		rope_node_base*  mpRight;
+	};
+
+	template <typename T>
+	struct rope_leaf_node : public rope_node_base
+	{
+		T mData[1];                   // Actually mnLength characters.
+	};
+
+
+
+	/// rope_iterator
+	///
+	/// A read-only bidirectional iterator. It remembers the leaf it is in, so
+	/// that moving within a leaf is as cheap as with a pointer, and finds the
+	/// next leaf by descending from the root, which is O(log n) per leaf.
+	///
+	/// An iterator is invalidated by any change to the rope it came from, as
+	/// that may free the nodes it refers to. Iterators into a copy of the rope
+	/// remain valid as long as the copy isn't changed.
+	///
+	template <typename T>
+	class rope_iterator
+	{
+	public:
+		typedef rope_iterator<T>                         this_type;
+		typedef T                                        value_type;
+		typedef const T*                                 pointer;
+		typedef const T&                                 reference;
+		typedef ptrdiff_t                                difference_type;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag iterator_category;
+
+	public:
+		rope_iterator()
+			: mpRoot(NULL), mnPosition(0), mpLeafData(NULL), mnLeafBegin(0), mnLeafEnd(0) { }
+
+		rope_iterator(const rope_node_base* pRoot, size_t nPosition)
+			: mpRoot(pRoot), mnPosition(nPosition), mpLeafData(NULL), mnLeafBegin(0), mnLeafEnd(0)
+		{
+			if(pRoot && (nPosition < pRoot->mnLength))
+				DoSeek();
+		}
+
+		reference operator*() const
+			{ return mpLeafData[mnPosition - mnLeafBegin]; }
+
+		pointer operator->() const
+			{ return &mpLeafData[mnPosition - mnLeafBegin]; }
+
+		this_type& operator++()
+		{
+			if((++mnPosition == mnLeafEnd) && (mnPosition < mpRoot->mnLength))
+				DoSeek();
+			return *this;
+		}
+
+		this_type operator++(int)
+			{ this_type temp(*this); ++*this; return temp; }
+
+		this_type& operator--()
+		{
+			if((mnPosition-- == mnLeafBegin) || !mpLeafData)
+				DoSeek();
+			return *this;
+		}
+
+		this_type operator--(int)
+			{ this_type temp(*this); --*this; return temp; }
+
+		/// Returns the position of the iterator in the rope.
+		size_t position() const
+			{ return mnPosition; }
+
+		/// Returns the rest of the current leaf, which are the characters
+		/// [position(), position() + n) of the rope. This allows scanning a
+		/// rope a chunk at a time.
+		const T* chunk(size_t& n) const
+		{
+			n = mnLeafEnd - mnPosition;
+			return mpLeafData + (mnPosition - mnLeafBegin);
+		}
+
+		bool operator==(const this_type& x) const
+			{ return (mnPosition == x.mnPosition) && (mpRoot == x.mpRoot); }
+
+		bool operator!=(const this_type& x) const
+			{ return (mnPosition != x.mnPosition) || (mpRoot != x.mpRoot); }
+
+	protected:
+		const rope_node_base* mpRoot;
+		size_t                mnPosition;
+		const T*              mpLeafData;   // The characters [mnLeafBegin, mnLeafEnd) of the rope.
+		size_t                mnLeafBegin;
+		size_t                mnLeafEnd;
+
+		void DoSeek()
+		{
+			const rope_node_base* pNode = mpRoot;
+			size_t                pos   = mnPosition;
+
+			while(pNode->mnHeight)
+			{
+				const rope_concat_node* const pConcat = static_cast<const rope_concat_node*>(pNode);
+
+				if(pos < pConcat->mpLeft->mnLength)
+					pNode = pConcat->mpLeft;
+				else
+				{
+					pos  -= pConcat->mpLeft->mnLength;
+					pNode = pConcat->mpRight;
+				}
+			}
+
+			mpLeafData  = static_cast<const rope_leaf_node<T>*>(pNode)->mData;
+			mnLeafBegin = mnPosition - pos;
+			mnLeafEnd   = mnLeafBegin + pNode->mnLength;
+		}
+
+	}; // class rope_iterator
+
+
+
+	/// basicRope
+	///
+	/// A string of characters T stored as a balanced tree of shared chunks.
+	///
+	/// Operation                  Cost
+	/// ------------------------------------------------------------------
+	/// copy, swap                 O(1)
+	/// operator[], at             O(log n)
+	/// insert, erase, replace     O(log n + edit length)
+	/// append, pushBack           O(log n + appended length)
+	/// substr                     O(log n), sharing the characters
+	/// iteration                  O(1) per character, amortized
+	/// str, copy                  O(n)
+	///
+	/// Each edit allocates O(log n) nodes, so a rope is slower than a string for
+	/// small texts and for appending one character at a time; build such text
+	/// in a string and append it as a whole.
+	///
+	/// Example usage:
+	///     rope text(pFileData, nFileSize);
+	///     text.insert(nOffset, "[redacted]");
+	///     text.erase(nOtherOffset, 42);
+	///     rope header = text.substr(0, 1024); // Shares text's chunks.
+	///     eastl::string output = text.str();
+	///
+	template <typename T, typename Allocator = EASTLAllocatorType>
+	class basicRope
+	{
+	public:
+		typedef basicRope<T, Allocator>               this_type;
+		typedef T                                     value_type;
+		typedef const T*                              const_pointer;
+		typedef const T&                              const_reference;
+		typedef rope_iterator<T>                      const_iterator;
+		typedef const_iterator                        iterator;           // Ropes are only changed through their member functions.
+		typedef eastl::reverse_iterator<iterator>     const_reverse_iterator;
+		typedef const_reverse_iterator                reverse_iterator;
+		typedef eastl_size_t                          size_type;
+		typedef ptrdiff_t                             difference_type;
+		typedef Allocator                             allocator_type;
+
+		static const size_type npos     = (size_type)-1;
+		static const size_type kMaxSize = (size_type)-2;
+
+	public:
+		basicRope(const allocator_type& allocator = EASTL_ROPE_DEFAULT_ALLOCATOR);
+		basicRope(const T* p, const allocator_type& allocator = EASTL_ROPE_DEFAULT_ALLOCATOR);
+		basicRope(const T* p, size_type n, const allocator_type& allocator = EASTL_ROPE_DEFAULT_ALLOCATOR);
+		basicRope(const this_type& x);
+
+		template <typename A>
+		explicit basicRope(const basicString<T, A>& s, const allocator_type& allocator = EASTL_ROPE_DEFAULT_ALLOCATOR);
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			basicRope(this_type&& x);
+			this_type& operator=(this_type&& x);
+		#endif
+
+	   ~basicRope();
+
+		this_type& operator=(const this_type& x);
+		void       swap(this_type& x);
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+		const_iterator         begin() const EASTL_NOEXCEPT   { return const_iterator(mpRoot, 0); }
+		const_iterator         cbegin() const EASTL_NOEXCEPT  { return const_iterator(mpRoot, 0); }
+		const_iterator         end() const EASTL_NOEXCEPT     { return const_iterator(mpRoot, size()); }
+		const_iterator         cend() const EASTL_NOEXCEPT    { return const_iterator(mpRoot, size()); }
+		const_reverse_iterator rbegin() const EASTL_NOEXCEPT  { return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const EASTL_NOEXCEPT    { return const_reverse_iterator(begin()); }
+
+		/// Returns an iterator to the character at position.
+		const_iterator iteratorAt(size_type position) const
+			{ EASTL_ASSERT(position <= size()); return const_iterator(mpRoot, position); }
+
+		bool      empty() const EASTL_NOEXCEPT  { return (mpRoot == NULL); }
+		size_type size() const EASTL_NOEXCEPT   { return mpRoot ? (size_type)mpRoot->mnLength : 0; }
+		size_type length() const EASTL_NOEXCEPT { return size(); }
+
+		const T& operator[](size_type n) const;
+		const T& at(size_type n) const;
+		const T& front() const { return (*this)[0]; }
+		const T& back() const  { return (*this)[size() - 1]; }
+
+		this_type& assign(const T* p, size_type n);
+		this_type& append(const T* p, size_type n);
+		this_type& append(const T* p);
+		this_type& append(const this_type& x);
+		void       pushBack(T c);
+
+		this_type& insert(size_type position, const T* p, size_type n);
+		this_type& insert(size_type position, const T* p);
+		this_type& insert(size_type position, const this_type& x);
+
+		this_type& erase(size_type position = 0, size_type n = npos);
+		this_type& replace(size_type position, size_type n, const T* p, size_type nReplacement);
+		this_type& replace(size_type position, size_type n, const this_type& x);
+
+		this_type substr(size_type position = 0, size_type n = npos) const;
+
+		void clear();
+
+		/// Copies the characters [position, position + n) to p, returning how many were copied.
+		size_type copy(T* p, size_type n, size_type position = 0) const;
+
+		/// Returns the rope as a single basicString.
+		basicString<T, Allocator> str() const;
+
+		/// Calls function(const T* p, size_t n) for each chunk of the rope, in order.
+		template <typename Function>
+		void forEachChunk(Function function) const;
+
+		int compare(const this_type& x) const;
+
+		bool validate() const;
+		int  validateIterator(const_iterator i) const;
+
+	protected:
+		typedef rope_node_base    node_type;
+		typedef rope_concat_node  concat_type;
+		typedef rope_leaf_node<T> leaf_type;
+
+		static const size_t kMaxLeafLength = (EASTL_ROPE_LEAF_BYTES / sizeof(T)) ? (EASTL_ROPE_LEAF_BYTES / sizeof(T)) : 1;
+
+		node_type*     mpRoot;        // NULL if empty.
+		allocator_type mAllocator;
+
+		static node_type* DoAddRef(node_type* pNode)
+			{ if(pNode) Internal::atomic_increment(&pNode->mnRefCount); return pNode; }
+
+		static size_t DoLength(const node_type* pNode)
+			{ return pNode ? pNode->mnLength : 0; }
+
+		static uint32_t DoHeight(const node_type* pNode)
+			{ return pNode ? pNode->mnHeight : 0; }
+
+		static const T* DoLeafData(const node_type* pNode)
+			{ return static_cast<const leaf_type*>(pNode)->mData; }
+
+		static size_t DoLeafSize(size_t nLength)
+			{ return sizeof(leaf_type) + ((nLength ? nLength : 1) - 1) * sizeof(T); }
+
+		// These take their arguments by borrowed reference and return a new reference.
+		node_type* DoMakeLeaf(const T* p1, size_t n1, const T* p2 = NULL, size_t n2 = 0);
+		node_type* DoMakeConcat(node_type* pLeft, node_type* pRight);
+		node_type* DoBalance(node_type* pLeft, node_type* pRight);
+		node_type* DoJoin(node_type* pLeft, node_type* pRight);
+		node_type* DoBuild(const T* p, size_t n);
+		void       DoSplit(node_type* pNode, size_t position, node_type*& pLeft, node_type*& pRight);
+
+		void DoRelease(node_type* pNode);
+		void DoSetRoot(node_type* pNode);
+		void DoReplace(size_type position, size_type n, node_type* pInsert);
+
+		bool DoValidate(const node_type* pNode) const;
+
+	}; // class basicRope
+
+
+	typedef basicRope<char> rope;
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// basicRope
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename A>
+	inline basicRope<T, A>::basicRope(const allocator_type& allocator)
+		: mpRoot(NULL), mAllocator(allocator)
+	{
+	}
+
+
+	template <typename T, typename A>
+	inline basicRope<T, A>::basicRope(const T* p, const allocator_type& allocator)
+		: mpRoot(NULL), mAllocator(allocator)
+	{
+		mpRoot = DoBuild(p, (size_t)CharStrlen(p));
+	}
+
+
+	template <typename T, typename A>
+	inline basicRope<T, A>::basicRope(const T* p, size_type n, const allocator_type& allocator)
+		: mpRoot(NULL), mAllocator(allocator)
+	{
+		mpRoot = DoBuild(p, (size_t)n);
+	}
+
+
+	template <typename T, typename A>
+	template <typename SA>
+	inline basicRope<T, A>::basicRope(const basicString<T, SA>& s, const allocator_type& allocator)
+		: mpRoot(NULL), mAllocator(allocator)
+	{
+		mpRoot = DoBuild(s.data(), (size_t)s.size());
+	}
+
+
+	template <typename T, typename A>
+	inline basicRope<T, A>::basicRope(const this_type& x)
+		: mpRoot(DoAddRef(x.mpRoot)), mAllocator(x.mAllocator)
+	{
+	}
+
+
+	#if EASTL_MOVE_SEMANTICS_ENABLED
+		template <typename T, typename A>
+		inline basicRope<T, A>::basicRope(this_type&& x)
+			: mpRoot(x.mpRoot), mAllocator(x.mAllocator)
+		{
+			x.mpRoot = NULL;
+		}
+
+
+		template <typename T, typename A>
+		inline typename basicRope<T, A>::this_type&
+		basicRope<T, A>::operator=(this_type&& x)
+		{
+			swap(x);
+			return *this;
+		}
+	#endif
+
+
+	template <typename T, typename A>
+	inline basicRope<T, A>::~basicRope()
+	{
+		DoRelease(mpRoot);
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::operator=(const this_type& x)
+	{
+		this_type temp(x); // This handles self-assignment, and releases our old root after the new one is referenced.
+		swap(temp);
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	inline void basicRope<T, A>::swap(this_type& x)
+	{
+		// The nodes were allocated with our allocators, so swap them too.
+		eastl::swap(mpRoot,     x.mpRoot);
+		eastl::swap(mAllocator, x.mAllocator);
+	}
+
+
+	template <typename T, typename A>
+	void basicRope<T, A>::DoRelease(node_type* pNode)
+	{
+		while(pNode && (Internal::atomic_decrement(&pNode->mnRefCount) == 0))
+		{
+			if(pNode->mnHeight == 0)
+			{
+				EASTLFree(mAllocator, pNode, DoLeafSize(pNode->mnLength));
+				return;
+			}
+
+			concat_type* const pConcat = static_cast<concat_type*>(pNode);
+			node_type* const   pRight  = pConcat->mpRight;
+
+			DoRelease(pConcat->mpLeft);
+			EASTLFree(mAllocator, pConcat, sizeof(concat_type));
+			pNode = pRight; // Loop rather than recurse on one side.
+		}
+	}
+
+
+	template <typename T, typename A>
+	inline void basicRope<T, A>::DoSetRoot(node_type* pNode)
+	{
+		node_type* const pOld = mpRoot;
+		mpRoot = pNode;
+		DoRelease(pOld);
+	}
+
+
+	template <typename T, typename A>
+	typename basicRope<T, A>::node_type*
+	basicRope<T, A>::DoMakeLeaf(const T* p1, size_t n1, const T* p2, size_t n2)
+	{
+		const size_t     n     = n1 + n2;
+		leaf_type* const pLeaf = (leaf_type*)allocate_memory(mAllocator, DoLeafSize(n), EASTL_ALIGN_OF(leaf_type), 0);
+		EASTL_ASSERT(pLeaf != NULL);
+
+		pLeaf->mnRefCount = 1;
+		pLeaf->mnHeight   = 0;
+		pLeaf->mnLength   = n;
+		if(n1)
+			memcpy(pLeaf->mData, p1, n1 * sizeof(T));
+		if(n2) // Most leaves are made from a single source, with p2 NULL.
+			memcpy(pLeaf->mData + n1, p2, n2 * sizeof(T));
+		return pLeaf;
+	}
+
+
+	template <typename T, typename A>
+	typename basicRope<T, A>::node_type*
+	basicRope<T, A>::DoMakeConcat(node_type* pLeft, node_type* pRight)
+	{
+		EASTL_ASSERT(pLeft && pRight);
+
+		concat_type* const pConcat = (concat_type*)allocate_memory(mAllocator, sizeof(concat_type), EASTL_ALIGN_OF(concat_type), 0);
+		EASTL_ASSERT(pConcat != NULL);
+
+		pConcat->mnRefCount = 1;
+		pConcat->mnHeight   = 1 + ((pLeft->mnHeight > pRight->mnHeight) ? pLeft->mnHeight : pRight->mnHeight);
+		pConcat->mnLength   = pLeft->mnLength + pRight->mnLength;
+		pConcat->mpLeft     = DoAddRef(pLeft);
+		pConcat->mpRight    = DoAddRef(pRight);
+		return pConcat;
+	}
+
+
+	template <typename T, typename A>
+	typename basicRope<T, A>::node_type*
+	basicRope<T, A>::DoBalance(node_type* pLeft, node_type* pRight)
+	{
+		// Makes a balanced tree of pLeft followed by pRight, whose heights differ by at most two.
+		if(pLeft->mnHeight > (pRight->mnHeight + 1))
+		{
+			concat_type* const pL = static_cast<concat_type*>(pLeft);
+
+			if(pL->mpLeft->mnHeight >= pL->mpRight->mnHeight) // Single rotation.
+			{
+				node_type* const pNewRight = DoMakeConcat(pL->mpRight, pRight);
+				node_type* const pResult   = DoMakeConcat(pL->mpLeft, pNewRight);
+				DoRelease(pNewRight);
+				return pResult;
+			}
+			else // Double rotation.
+			{
+				concat_type* const pLR       = static_cast<concat_type*>(pL->mpRight);
+				node_type* const   pNewLeft  = DoMakeConcat(pL->mpLeft, pLR->mpLeft);
+				node_type* const   pNewRight = DoMakeConcat(pLR->mpRight, pRight);
+				node_type* const   pResult   = DoMakeConcat(pNewLeft, pNewRight);
+				DoRelease(pNewLeft);
+				DoRelease(pNewRight);
+				return pResult;
+			}
+		}
+		else if(pRight->mnHeight > (pLeft->mnHeight + 1))
+		{
+			concat_type* const pR = static_cast<concat_type*>(pRight);
+
+			if(pR->mpRight->mnHeight >= pR->mpLeft->mnHeight)
+			{
+				node_type* const pNewLeft = DoMakeConcat(pLeft, pR->mpLeft);
+				node_type* const pResult  = DoMakeConcat(pNewLeft, pR->mpRight);
+				DoRelease(pNewLeft);
+				return pResult;
+			}
+			else
+			{
+				concat_type* const pRL       = static_cast<concat_type*>(pR->mpLeft);
+				node_type* const   pNewLeft  = DoMakeConcat(pLeft, pRL->mpLeft);
+				node_type* const   pNewRight = DoMakeConcat(pRL->mpRight, pR->mpRight);
+				node_type* const   pResult   = DoMakeConcat(pNewLeft, pNewRight);
+				DoRelease(pNewLeft);
+				DoRelease(pNewRight);
+				return pResult;
+			}
+		}
+
+		return DoMakeConcat(pLeft, pRight);
+	}
+
+
+	template <typename T, typename A>
+	typename basicRope<T, A>::node_type*
+	basicRope<T, A>::DoJoin(node_type* pLeft, node_type* pRight)
+	{
+		// Joins two balanced trees by descending the taller one's near edge to the
+		// height of the shorter, as with AVL trees. A short leaf is taken all the
+		// way down so that it can be merged into its neighbour leaf, which keeps
+		// repeated small edits from fragmenting the rope into tiny leaves.
+		if(!pLeft)
+			return DoAddRef(pRight);
+		if(!pRight)
+			return DoAddRef(pLeft);
+
+		if((pLeft->mnHeight == 0) && (pRight->mnHeight == 0) && ((pLeft->mnLength + pRight->mnLength) <= kMaxLeafLength))
+			return DoMakeLeaf(DoLeafData(pLeft), pLeft->mnLength, DoLeafData(pRight), pRight->mnLength);
+
+		if((pLeft->mnHeight > (pRight->mnHeight + 1)) ||
+		   (pLeft->mnHeight && (pRight->mnHeight == 0) && (pRight->mnLength <= (kMaxLeafLength / 2))))
+		{
+			concat_type* const pL      = static_cast<concat_type*>(pLeft);
+			node_type* const   pJoined = DoJoin(pL->mpRight, pRight);
+			node_type* const   pResult = DoBalance(pL->mpLeft, pJoined);
+			DoRelease(pJoined);
+			return pResult;
+		}
+
+		if((pRight->mnHeight > (pLeft->mnHeight + 1)) ||
+		   (pRight->mnHeight && (pLeft->mnHeight == 0) && (pLeft->mnLength <= (kMaxLeafLength / 2))))
+		{
+			concat_type* const pR      = static_cast<concat_type*>(pRight);
+			node_type* const   pJoined = DoJoin(pLeft, pR->mpLeft);
+			node_type* const   pResult = DoBalance(pJoined, pR->mpRight);
+			DoRelease(pJoined);
+			return pResult;
+		}
+
+		return DoMakeConcat(pLeft, pRight);
+	}
+
+
+	template <typename T, typename A>
+	typename basicRope<T, A>::node_type*
+	basicRope<T, A>::DoBuild(const T* p, size_t n)
+	{
+		// Splits the characters evenly among the fewest leaves which can hold them,
+		// and builds a perfectly balanced tree over those.
+		if(n == 0)
+			return NULL;
+
+		if(n <= kMaxLeafLength)
+			return DoMakeLeaf(p, n);
+
+		const size_t     nLeafCount = (n + kMaxLeafLength - 1) / kMaxLeafLength;
+		const size_t     nSplit     = (n / nLeafCount) * (nLeafCount / 2) + ((n % nLeafCount) < (nLeafCount / 2) ? (n % nLeafCount) : (nLeafCount / 2));
+		node_type* const pLeft      = DoBuild(p, nSplit);
+		node_type* const pRight     = DoBuild(p + nSplit, n - nSplit);
+		node_type* const pResult    = DoMakeConcat(pLeft, pRight);
+
+		DoRelease(pLeft);
+		DoRelease(pRight);
+		return pResult;
+	}
+
+
+	template <typename T, typename A>
+	void basicRope<T, A>::DoSplit(node_type* pNode, size_t position, node_type*& pLeft, node_type*& pRight)
+	{
+		// Sets pLeft and pRight to new references to the characters before and after position.
+		if(!pNode || (position == 0))
+		{
+			pLeft  = NULL;
+			pRight = DoAddRef(pNode);
+		}
+		else if(position >= pNode->mnLength)
+		{
+			pLeft  = DoAddRef(pNode);
+			pRight = NULL;
+		}
+		else if(pNode->mnHeight == 0)
+		{
+			pLeft  = DoMakeLeaf(DoLeafData(pNode), position);
+			pRight = DoMakeLeaf(DoLeafData(pNode) + position, pNode->mnLength - position);
+		}
+		else
+		{
+			concat_type* const pConcat     = static_cast<concat_type*>(pNode);
+			const size_t       nLeftLength = pConcat->mpLeft->mnLength;
+			node_type*         pA;
+			node_type*         pB;
+
+			if(position < nLeftLength)
+			{
+				DoSplit(pConcat->mpLeft, position, pA, pB);
+				pLeft  = pA;
+				pRight = DoJoin(pB, pConcat->mpRight);
+				DoRelease(pB);
+			}
+			else if(position == nLeftLength)
+			{
+				pLeft  = DoAddRef(pConcat->mpLeft);
+				pRight = DoAddRef(pConcat->mpRight);
+			}
+			else
+			{
+				DoSplit(pConcat->mpRight, position - nLeftLength, pA, pB);
+				pLeft  = DoJoin(pConcat->mpLeft, pA);
+				pRight = pB;
+				DoRelease(pA);
+			}
+		}
+	}
+
+
+	template <typename T, typename A>
+	void basicRope<T, A>::DoReplace(size_type position, size_type n, node_type* pInsert)
+	{
+		// Replaces [position, position + n) with pInsert, which is borrowed.
+		EASTL_ASSERT(position <= size());
+
+		node_type *pBefore, *pRest, *pRemoved, *pAfter;
+
+		DoSplit(mpRoot, (size_t)position, pBefore, pRest);
+		DoSplit(pRest, (n < (size() - position)) ? (size_t)n : DoLength(pRest), pRemoved, pAfter);
+
+		node_type* const pFront  = DoJoin(pBefore, pInsert);
+		node_type* const pResult = DoJoin(pFront, pAfter);
+
+		DoRelease(pBefore);
+		DoRelease(pRest);
+		DoRelease(pRemoved);
+		DoRelease(pAfter);
+		DoRelease(pFront);
+		DoSetRoot(pResult);
+	}
+
+
+	template <typename T, typename A>
+	const T& basicRope<T, A>::operator[](size_type n) const
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= size()))
+				EASTL_FAIL_MSG("basicRope::operator[] -- out of range");
+		#endif
+
+		const node_type* pNode = mpRoot;
+		size_t           pos   = (size_t)n;
+
+		while(pNode->mnHeight)
+		{
+			const concat_type* const pConcat = static_cast<const concat_type*>(pNode);
+
+			if(pos < pConcat->mpLeft->mnLength)
+				pNode = pConcat->mpLeft;
+			else
+			{
+				pos  -= pConcat->mpLeft->mnLength;
+				pNode = pConcat->mpRight;
+			}
+		}
+
+		return DoLeafData(pNode)[pos];
+	}
+
+
+	template <typename T, typename A>
+	inline const T& basicRope<T, A>::at(size_type n) const
+	{
+		#if EASTL_EXCEPTIONS_ENABLED
+			if(EASTL_UNLIKELY(n >= size()))
+				throw std::out_of_range("basicRope::at -- out of range");
+		#elif EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= size()))
+				EASTL_FAIL_MSG("basicRope::at -- out of range");
+		#endif
+
+		return (*this)[n];
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::assign(const T* p, size_type n)
+	{
+		DoSetRoot(DoBuild(p, (size_t)n));
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::append(const T* p, size_type n)
+	{
+		node_type* const pInsert = DoBuild(p, (size_t)n);
+		DoSetRoot(DoJoin(mpRoot, pInsert));
+		DoRelease(pInsert);
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::append(const T* p)
+	{
+		return append(p, (size_type)CharStrlen(p));
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::append(const this_type& x)
+	{
+		DoSetRoot(DoJoin(mpRoot, x.mpRoot)); // If x is this, its root is still referenced by the new root when released.
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	inline void basicRope<T, A>::pushBack(T c)
+	{
+		append(&c, 1);
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::insert(size_type position, const T* p, size_type n)
+	{
+		node_type* const pInsert = DoBuild(p, (size_t)n);
+		DoReplace(position, 0, pInsert);
+		DoRelease(pInsert);
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::insert(size_type position, const T* p)
+	{
+		return insert(position, p, (size_type)CharStrlen(p));
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::insert(size_type position, const this_type& x)
+	{
+		node_type* const pInsert = DoAddRef(x.mpRoot); // In case x is this.
+		DoReplace(position, 0, pInsert);
+		DoRelease(pInsert);
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::erase(size_type position, size_type n)
+	{
+		DoReplace(position, n, NULL);
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::replace(size_type position, size_type n, const T* p, size_type nReplacement)
+	{
+		node_type* const pInsert = DoBuild(p, (size_t)nReplacement);
+		DoReplace(position, n, pInsert);
+		DoRelease(pInsert);
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	inline typename basicRope<T, A>::this_type&
+	basicRope<T, A>::replace(size_type position, size_type n, const this_type& x)
+	{
+		node_type* const pInsert = DoAddRef(x.mpRoot);
+		DoReplace(position, n, pInsert);
+		DoRelease(pInsert);
+		return *this;
+	}
+
+
+	template <typename T, typename A>
+	typename basicRope<T, A>::this_type
+	basicRope<T, A>::substr(size_type position, size_type n) const
+	{
+		EASTL_ASSERT(position <= size());
+
+		this_type  result(mAllocator); // Any nodes this makes are made through result's copy of our allocator.
+		node_type *pBefore, *pRest, *pAfter;
+
+		result.DoSplit(mpRoot, (size_t)position, pBefore, pRest);
+		result.DoSplit(pRest, (n < (size() - position)) ? (size_t)n : DoLength(pRest), result.mpRoot, pAfter);
+
+		result.DoRelease(pBefore);
+		result.DoRelease(pRest);
+		result.DoRelease(pAfter);
+		return result;
+	}
+
+
+	template <typename T, typename A>
+	inline void basicRope<T, A>::clear()
+	{
+		DoSetRoot(NULL);
+	}
+
+
+	template <typename T, typename A>
+	template <typename Function>
+	void basicRope<T, A>::forEachChunk(Function function) const
+	{
+		// An explicit stack of right subtrees; AVL trees of any size that fits in memory are less than 96 deep.
+		const node_type* stack[96];
+		size_t           nStackSize = 0;
+		const node_type* pNode      = mpRoot;
+
+		while(pNode)
+		{
+			while(pNode->mnHeight)
+			{
+				EASTL_ASSERT(nStackSize < (sizeof(stack) / sizeof(stack[0])));
+				stack[nStackSize++] = static_cast<const concat_type*>(pNode)->mpRight;
+				pNode = static_cast<const concat_type*>(pNode)->mpLeft;
+			}
+
+			function(DoLeafData(pNode), pNode->mnLength);
+			pNode = nStackSize ? stack[--nStackSize] : NULL;
+		}
+	}
+
+
+	template <typename T, typename A>
+	typename basicRope<T, A>::size_type
+	basicRope<T, A>::copy(T* p, size_type n, size_type position) const
+	{
+		EASTL_ASSERT(position <= size());
+
+		if(n > (size() - position))
+			n = size() - position;
+
+		const_iterator it(mpRoot, (size_t)position);
+		size_type      nCopied = 0;
+
+		while(nCopied < n)
+		{
+			size_t         nChunk;
+			const T* const pChunk = it.chunk(nChunk);
+
+			if(nChunk > (size_t)(n - nCopied))
+				nChunk = (size_t)(n - nCopied);
+
+			memcpy(p + nCopied, pChunk, nChunk * sizeof(T));
+			nCopied += (size_type)nChunk;
+			it = const_iterator(mpRoot, (size_t)(position + nCopied));
+		}
+
+		return n;
+	}
+
+
+	template <typename T, typename A>
+	basicString<T, A> basicRope<T, A>::str() const
+	{
+		basicString<T, A> result(mAllocator);
+		result.resize(size());
+		if(!empty())
+			copy(&result[0], size());
+		return result;
+	}
+
+
+	template <typename T, typename A>
+	int basicRope<T, A>::compare(const this_type& x) const
+	{
+		// Compares a chunk at a time, skipping shared subtrees only in the trivial case of identical roots.
+		if(mpRoot == x.mpRoot)
+			return 0;
+
+		const_iterator a(mpRoot, 0), b(x.mpRoot, 0);
+		size_t         pos = 0;
+		const size_t   n   = (size_t)((size() < x.size()) ? size() : x.size());
+
+		while(pos < n)
+		{
+			size_t         nA, nB;
+			const T* const pA = a.chunk(nA);
+			const T* const pB = b.chunk(nB);
+			size_t         nChunk = (nA < nB) ? nA : nB;
+
+			if(nChunk > (n - pos))
+				nChunk = n - pos;
+
+			const int result = Compare(pA, pB, nChunk);
+			if(result)
+				return result;
+
+			pos += nChunk;
+			a = const_iterator(mpRoot, pos);
+			b = const_iterator(x.mpRoot, pos);
+		}
+
+		return (size() < x.size()) ? -1 : (size() > x.size()) ? 1 : 0;
+	}
+
+
+	template <typename T, typename A>
+	bool basicRope<T, A>::DoValidate(const node_type* pNode) const
+	{
+		if(pNode->mnRefCount <= 0)
+			return false;
+
+		if(pNode->mnHeight == 0)
+			return (pNode->mnLength > 0) && (pNode->mnLength <= kMaxLeafLength);
+
+		const concat_type* const pConcat = static_cast<const concat_type*>(pNode);
+		const node_type* const   pLeft   = pConcat->mpLeft;
+		const node_type* const   pRight  = pConcat->mpRight;
+
+		if(!pLeft || !pRight)
+			return false;
+
+		const uint32_t nMax = (pLeft->mnHeight > pRight->mnHeight) ? pLeft->mnHeight : pRight->mnHeight;
+		const uint32_t nMin = (pLeft->mnHeight > pRight->mnHeight) ? pRight->mnHeight : pLeft->mnHeight;
+
+		if((pNode->mnHeight != (nMax + 1)) || ((nMax - nMin) > 1) || (pNode->mnLength != (pLeft->mnLength + pRight->mnLength)))
+			return false;
+
+		return DoValidate(pLeft) && DoValidate(pRight);
+	}
+
+
+	template <typename T, typename A>
+	inline bool basicRope<T, A>::validate() const
+	{
+		return !mpRoot || DoValidate(mpRoot);
+	}
+
+
+	template <typename T, typename A>
+	inline int basicRope<T, A>::validateIterator(const_iterator i) const
+	{
+		if(i == end())
+			return (isf_valid | isf_current);
+
+		if((i.position() < size()) && (i == const_iterator(mpRoot, i.position()))) // Checks that i is into this tree.
+			return (isf_valid | isf_current | isf_can_dereference);
+
+		return isf_none;
+	}
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename A>
+	inline bool operator==(const basicRope<T, A>& a, const basicRope<T, A>& b)
+	{
+		return (a.size() == b.size()) && (a.compare(b) == 0);
+	}
+
+	template <typename T, typename A>
+	inline bool operator!=(const basicRope<T, A>& a, const basicRope<T, A>& b)
+	{
+		return !(a == b);
+	}
+
+	template <typename T, typename A>
+	inline bool operator<(const basicRope<T, A>& a, const basicRope<T, A>& b)
+	{
+		return a.compare(b) < 0;
+	}
+
+	template <typename T, typename A>
+	inline basicRope<T, A> operator+(const basicRope<T, A>& a, const basicRope<T, A>& b)
+	{
+		basicRope<T, A> result(a);
+		result.append(b);
+		return result;
+	}
+
+	template <typename T, typename A>
+	inline void swap(basicRope<T, A>& a, basicRope<T, A>& b)
+	{
+		a.swap(b);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,306 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements sharded_cache, a thread-safe wrapper around lru_cache
+// or clock_cache. The keys are split by hash among a fixed number of shards,
+// each of which is a complete cache with its own mutex. Threads which use
+// different shards don't contend, so contention falls roughly with the
+// shard count.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_SHARDED_CACHE_H
+#define EASTL_SHARDED_CACHE_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/thread_support.h>
+#include <eastl/internal/cache_table.h>
+#include <eastl/type_traits.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// sharded_cache
+	///
+	/// Cache is lru_cache or clock_cache; nShardCount must be a power of two.
+	/// The capacity is divided evenly among the shards, so that the replacement
+	/// policy applies per shard rather than to the cache as a whole. With a
+	/// reasonable hash this makes little difference to the hit rate.
+	///
+	/// Since another thread may evict an entry at any time, values are returned
+	/// by copy rather than by pointer. Use visit to work on a value in place
+	/// while its shard is locked. The eviction callback is called with the
+	/// shard locked, and so must not use this cache.
+	///
+	/// Example usage:
+	///     typedef sharded_cache<lru_cache<uint64_t, Mesh*>, 16> MeshCache;
+	///     MeshCache meshCache(4096);
+	///
+	///     Mesh* pMesh;
+	///     if(!meshCache.get(id, pMesh))
+	///         meshCache.put(id, pMesh = LoadMesh(id));
+	///
+	template <typename Cache, size_t nShardCount = 16>
+	class sharded_cache
+	{
+		static_assert((nShardCount != 0) && ((nShardCount & (nShardCount - 1)) == 0), "sharded_cache: nShardCount must be a power of two.");
+
+	public:
+		typedef sharded_cache<Cache, nShardCount>             this_type;
+		typedef Cache                                         cache_type;
+		typedef typename Cache::size_type                     size_type;
+		typedef typename Cache::key_type                      key_type;
+		typedef typename Cache::mapped_type                   mapped_type;
+		typedef typename Cache::value_type                    value_type;
+		typedef typename Cache::hasher                        hasher;
+		typedef typename Cache::eviction_callback_type        eviction_callback_type;
+
+		static const size_t kShardCount = nShardCount;
+
+	public:
+		explicit sharded_cache(size_type capacity = 0)
+			{ setCapacity(capacity); }
+
+		/// get
+		/// Copies the value for key to value and returns true, or returns false.
+		/// Counts a hit or a miss and updates recency as the underlying cache does.
+		bool get(const key_type& key, mapped_type& value)
+		{
+			shard& s = DoGetShard(key);
+			Internal::auto_mutex lock(s.mMutex);
+
+			const mapped_type* const pValue = s.mCache.get(key);
+			if(pValue)
+				value = *pValue;
+			return (pValue != NULL);
+		}
+
+		/// visit
+		/// Calls function(mapped_type&) on the value for key with its shard locked,
+		/// and returns true, or returns false. Counts as a get.
+		template <typename Function>
+		bool visit(const key_type& key, Function function)
+		{
+			shard& s = DoGetShard(key);
+			Internal::auto_mutex lock(s.mMutex);
+
+			mapped_type* const pValue = s.mCache.get(key);
+			if(pValue)
+				function(*pValue);
+			return (pValue != NULL);
+		}
+
+		/// peek
+		/// As get, but doesn't update recency or the counters.
+		bool peek(const key_type& key, mapped_type& value) const
+		{
+			shard& s = DoGetShard(key);
+			Internal::auto_mutex lock(s.mMutex);
+
+			const mapped_type* const pValue = s.mCache.peek(key);
+			if(pValue)
+				value = *pValue;
+			return (pValue != NULL);
+		}
+
+		bool contains(const key_type& key) const
+		{
+			shard& s = DoGetShard(key);
+			Internal::auto_mutex lock(s.mMutex);
+			return s.mCache.contains(key);
+		}
+
+		/// put
+		/// Returns true if key was newly inserted.
+		bool put(const key_type& key, const mapped_type& value)
+		{
+			shard& s = DoGetShard(key);
+			Internal::auto_mutex lock(s.mMutex);
+			return s.mCache.put(key, value).second;
+		}
+
+		#if EASTL_MOVE_SEMANTICS_ENABLED
+			bool put(const key_type& key, mapped_type&& value)
+			{
+				shard& s = DoGetShard(key);
+				Internal::auto_mutex lock(s.mMutex);
+				return s.mCache.put(key, eastl::move(value)).second;
+			}
+		#endif
+
+		bool erase(const key_type& key)
+		{
+			shard& s = DoGetShard(key);
+			Internal::auto_mutex lock(s.mMutex);
+			return s.mCache.erase(key);
+		}
+
+		void clear()
+		{
+			for(size_t i = 0; i < nShardCount; ++i)
+			{
+				Internal::auto_mutex lock(mShards[i].mMutex);
+				mShards[i].mCache.clear();
+			}
+		}
+
+		/// setCapacity
+		/// Sets the total capacity, which is divided among the shards.
+		void setCapacity(size_type capacity)
+		{
+			for(size_t i = 0; i < nShardCount; ++i)
+			{
+				Internal::auto_mutex lock(mShards[i].mMutex);
+				mShards[i].mCache.setCapacity((capacity / nShardCount) + ((i < (capacity % nShardCount)) ? 1 : 0));
+			}
+		}
+
+		void setEvictionCallback(eviction_callback_type pCallback, void* pContext = NULL)
+		{
+			for(size_t i = 0; i < nShardCount; ++i)
+			{
+				Internal::auto_mutex lock(mShards[i].mMutex);
+				mShards[i].mCache.setEvictionCallback(pCallback, pContext);
+			}
+		}
+
+		// The following sum over the shards, locking each in turn. Thus they are not
+		// a snapshot of the whole cache if other threads are using it meanwhile.
+		size_type   size() const;
+		size_type   capacity() const;
+		cache_stats getStats() const;
+		void        resetStats();
+
+		bool validate() const;
+
+	protected:
+		struct shard
+		{
+			Cache                   mCache;
+			mutable Internal::mutex mMutex;
+			char                    mPad[EA_CACHE_LINE_SIZE]; // Keeps adjacent shards' mutexes off the same cache line.
+		};
+
+		shard  mShards[nShardCount];
+		hasher mHash;
+
+		shard& DoGetShard(const key_type& key) const
+		{
+			// The caches pick buckets with the low bits of the hash, so we pick shards with
+			// the high bits of a multiplicative hash. Otherwise each shard would use only
+			// 1 / nShardCount of its buckets.
+			const uint64_t h = (uint64_t)mHash(key) * UINT64_C(0x9E3779B97F4A7C15);
+			return const_cast<shard&>(mShards[(size_t)(h >> 40) & (nShardCount - 1)]);
+		}
+
+	private:
+		#if defined(EA_COMPILER_NO_DELETED_FUNCTIONS)
+			sharded_cache(const this_type&);
+			void operator=(const this_type&);
+		#else
+			sharded_cache(const this_type&) = delete;
+			void operator=(const this_type&) = delete;
+		#endif
+
+	}; // class sharded_cache
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// sharded_cache
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename Cache, size_t nShardCount>
+	typename sharded_cache<Cache, nShardCount>::size_type
+	sharded_cache<Cache, nShardCount>::size() const
+	{
+		size_type n = 0;
+
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			Internal::auto_mutex lock(mShards[i].mMutex);
+			n += mShards[i].mCache.size();
+		}
+
+		return n;
+	}
+
+
+	template <typename Cache, size_t nShardCount>
+	typename sharded_cache<Cache, nShardCount>::size_type
+	sharded_cache<Cache, nShardCount>::capacity() const
+	{
+		size_type n = 0;
+
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			Internal::auto_mutex lock(mShards[i].mMutex);
+			n += mShards[i].mCache.capacity();
+		}
+
+		return n;
+	}
+
+
+	template <typename Cache, size_t nShardCount>
+	cache_stats sharded_cache<Cache, nShardCount>::getStats() const
+	{
+		cache_stats stats;
+
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			Internal::auto_mutex lock(mShards[i].mMutex);
+			stats += mShards[i].mCache.getStats();
+		}
+
+		return stats;
+	}
+
+
+	template <typename Cache, size_t nShardCount>
+	void sharded_cache<Cache, nShardCount>::resetStats()
+	{
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			Internal::auto_mutex lock(mShards[i].mMutex);
+			mShards[i].mCache.resetStats();
+		}
+	}
+
+
+	template <typename Cache, size_t nShardCount>
+	bool sharded_cache<Cache, nShardCount>::validate() const
+	{
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			Internal::auto_mutex lock(mShards[i].mMutex);
+
+			if(!mShards[i].mCache.validate())
+				return false;
+
+			// Every key must be in the shard it hashes to.
+			for(typename Cache::const_iterator it = mShards[i].mCache.begin(), itEnd = mShards[i].mCache.end(); it != itEnd; ++it)
+			{
+				if(&DoGetShard(it->first) != &mShards[i])
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -8,7 +8,7 @@
 // C++ standard. We implement the following sorting algorithms:
 //    isSorted             -- 
 //    sort                  -- Unstable.    The implementation of this is mapped to quickSort by default.
-//    quickSort            -- Unstable.    This is actually an intro-sort (quick sort with switch to insertion sort).
+//    quickSort            -- Unstable.    This is actually a pattern-defeating intro-sort (quick sort with switches to insertion and heap sort).
 //    tim_sort              -- Stable.
 //    tim_sort_buffer       -- Stable.
 //    partialSort          -- Unstable.
@@ -17,17 +17,27 @@
 //    heapSort             -- Unstable. 
 //    stableSort           -- Stable.      The implementation of this is simply mapped to mergeSort.
 //    merge                 -- 
+//    merge_k               -- Stable.      Merges k sorted ranges using a loser tree.
+//    merge_path            --              Finds where a merge's output splits between its inputs.
+//    merge_part            -- Stable.      One of n equal, independent parts of a merge.
+//    parallel_merge        -- Stable.      A merge done in parts by a user-provided executor.
 //    mergeSort            -- Stable. 
 //    mergeSortBuffer     -- Stable. 
-//    nthElement           -- Unstable.
+//    nthElement           -- Unstable.    Introselect, with Floyd-Rivest sampling and a median of medians fallback.
+//    top_k                 -- Unstable.    The k first elements of a sequence, in O(k) memory.
 //    radixSort            -- Stable.      Important and useful sort for integral data, and faster than all others for this.
 //    combSort             -- Unstable.    Possibly the best combination of small code size but fast sort.
 //    bubbleSort           -- Stable.      Useful in practice for sorting tiny sets of data (<= 10 elements).
 //    selectionSort*       -- Unstable.
 //    shakerSort*          -- Stable.
 //    bucketSort*          -- Stable. 
+//    string_sort**         -- Unstable.    MSD radix sort and multikey quicksort for arrays of strings.
+//    string_stable_sort**  -- Stable.
+//    argsort***            -- Stable.      Sorts the positions of the elements, for use with apply_permutation.
 //
 // * Found in sort_extra.h.
+// ** Found in string_sort.h.
+// *** Found in argsort.h.
 //
 // Additional sorting and related algorithms we may want to implement:
 //    partialSort_copy     This would be like the std STL version.
@@ -43,6 +53,7 @@
 
 
 #include <eastl/internal/config.h>
+#include <eastl/bit.h>
 #include <eastl/iterator.h>
 #include <eastl/memory.h>
 #include <eastl/algorithm.h>
@@ -51,6 +62,14 @@
 #include <eastl/allocator.h>
 #include <eastl/memory.h>
 
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <math.h>
+	#pragma warning(pop)
+#else
+	#include <math.h>
+#endif
+
 
 #if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
 	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
@@ -205,6 +224,358 @@ namespace eastl
 
 
 
+	/// merge_k
+	///
+	/// Merges k sorted ranges into a result sorted range. *firstRange through
+	/// *(lastRange - 1) are the input ranges, each a pair (or any type with
+	/// first and second members) of input iterators whose reference type is
+	/// a real reference, as the tree tracks the heads by address. The merge is stable:
+	/// equal elements are output in the order of their ranges, and within a
+	/// range in their original order.
+	///
+	/// This uses a loser tree (tournament tree): each node of a complete
+	/// binary tree over the ranges holds the loser of the match played there,
+	/// so replacing the winner takes one comparison per level, log2(k) in all,
+	/// versus about 2 log2(k) for a binary heap of the range heads. The
+	/// matches are replayed without branching on their outcome, which is what
+	/// makes the tree faster than the heap in practice. The allocator is used
+	/// for a copy of the range iterators and for the tree.
+	///
+	/// Example usage:
+	///    eastl::pair<int*, int*> shards[64];
+	///    ...
+	///    eastl::merge_k(shards, shards + 64, output.begin(), allocator, eastl::less<int>());
+	///
+	namespace Internal
+	{
+		template <typename T>
+		struct merge_k_node
+		{
+			const T* mpHead;   // The head of the range, unless the range is exhausted.
+			size_t   mnRange;  // The range number, plus K if the range is exhausted.
+		};
+
+		template <typename T>
+		EASTL_FORCE_INLINE const T* MergeKSelect(bool bSecond, const T* pFirst, const T* pSecond)
+		{
+			// GCC compiles (b ? x : y) into a branch, which mispredicts half the time in a merge.
+			return (const T*)((uintptr_t)pFirst ^ (((uintptr_t)pFirst ^ (uintptr_t)pSecond) & ((uintptr_t)0 - (uintptr_t)bSecond)));
+		}
+
+		EASTL_FORCE_INLINE size_t MergeKSelect(bool bSecond, size_t nFirst, size_t nSecond)
+		{
+			return nFirst ^ ((nFirst ^ nSecond) & ((size_t)0 - (size_t)bSecond));
+		}
+
+		template <typename T, typename Compare>
+		EASTL_FORCE_INLINE bool MergeKBeats(size_t a, const T* pA, size_t b, const T* pB, Compare& compare)
+		{
+			// Returns true if the head of range a is output before the head of range b.
+			// Ties go to the lower numbered range, which makes the merge stable. Rather
+			// than branch on which range that is, the operands are swapped and the
+			// result flipped.
+			const bool bLower = (a < b);
+			return (compare(*MergeKSelect(bLower, pA, pB), *MergeKSelect(bLower, pB, pA)) != bLower);
+		}
+	}
+
+	template <typename RangeIterator, typename OutputIterator, typename Allocator, typename Compare>
+	OutputIterator merge_k(RangeIterator firstRange, RangeIterator lastRange, OutputIterator result, Allocator& allocator, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RangeIterator>::value_type range_type;
+		typedef typename range_type::first_type                             iterator_type;
+		typedef typename eastl::iterator_traits<iterator_type>::value_type value_type;
+		typedef Internal::merge_k_node<value_type>                          node_type;
+
+		const size_t k = (size_t)eastl::distance(firstRange, lastRange);
+
+		if(k <= 2)
+		{
+			if(k == 0)
+				return result;
+			if(k == 1)
+				return eastl::copy((*firstRange).first, (*firstRange).second, result);
+
+			RangeIterator secondRange(firstRange);
+			++secondRange;
+			return eastl::merge((*firstRange).first, (*firstRange).second, (*secondRange).first, (*secondRange).second, result, compare);
+		}
+
+		// The tree has K = bit_ceil(k) leaves, one per range; the leaves past k
+		// are empty ranges. Node n's children are 2n and 2n + 1, and leaf r is
+		// node K + r. Each internal node of pTree holds the loser of the match
+		// played there, with the address of its head, so that replaying a match
+		// needs no iterator and no branch on the outcome. An exhausted range r
+		// is entered as K + r, which loses every match without its head being
+		// looked at. pWinners is only used while building the tree.
+		const size_t K      = eastl::bit_ceil(k);
+		const size_t nBytes = (3 * K * sizeof(node_type)) + (2 * K * sizeof(iterator_type));
+
+		void* const          pMemory  = allocate_memory(allocator, nBytes, EASTL_ALIGN_OF(node_type) > EASTL_ALIGN_OF(iterator_type) ? EASTL_ALIGN_OF(node_type) : EASTL_ALIGN_OF(iterator_type), 0);
+		node_type* const     pTree    = (node_type*)pMemory;
+		node_type* const     pWinners = pTree + K;                       // 2K nodes, indexed by node.
+		iterator_type* const pHeads   = (iterator_type*)(pWinners + 2 * K);
+		iterator_type* const pEnds    = pHeads + K;
+
+		size_t r = 0;
+		for(; firstRange != lastRange; ++firstRange, ++r)
+		{
+			::new((void*)(pHeads + r)) iterator_type((*firstRange).first);
+			::new((void*)(pEnds + r))  iterator_type((*firstRange).second);
+		}
+		for(; r < K; ++r)
+		{
+			::new((void*)(pHeads + r)) iterator_type(pEnds[0]);
+			::new((void*)(pEnds + r))  iterator_type(pEnds[0]);
+		}
+
+		for(r = 0; r < K; ++r)
+		{
+			node_type& leaf = pWinners[K + r];
+			const bool bEmpty = (pHeads[r] == pEnds[r]);
+
+			leaf.mpHead  = bEmpty ? NULL : eastl::addressof(*pHeads[r]);
+			leaf.mnRange = bEmpty ? (K + r) : r;
+		}
+
+		for(size_t n = K - 1; n >= 1; --n)
+		{
+			const node_type& a = pWinners[2 * n];
+			const node_type& b = pWinners[2 * n + 1];
+			const bool bBWins  = (b.mnRange < K) && ((a.mnRange >= K) || Internal::MergeKBeats(b.mnRange, b.mpHead, a.mnRange, a.mpHead, compare));
+
+			pWinners[n] = bBWins ? b : a;
+			pTree[n]    = bBWins ? a : b;
+		}
+
+		size_t winner = pWinners[1].mnRange;
+
+		while(winner < K)
+		{
+			iterator_type& head = pHeads[winner];
+
+			*result = *head;
+			++result;
+
+			const value_type* pWinnerHead = NULL;
+
+			if(++head != pEnds[winner])
+				pWinnerHead = eastl::addressof(*head);
+			else
+				winner += K;
+
+			// Replay the winner's path to the root against the stored losers. Both
+			// the leaf of a live range r and the entry of an exhausted one are K | r.
+			for(size_t n = (K | winner) >> 1; n >= 1; n >>= 1)
+			{
+				node_type&        node       = pTree[n];
+				const size_t      loser      = node.mnRange;
+				const value_type* pLoserHead = node.mpHead;
+				const bool        bLoserWins = (loser < K) && ((winner >= K) || Internal::MergeKBeats(loser, pLoserHead, winner, pWinnerHead, compare));
+
+				node.mnRange = Internal::MergeKSelect(bLoserWins, loser, winner);
+				node.mpHead  = Internal::MergeKSelect(bLoserWins, pLoserHead, pWinnerHead);
+				winner       = Internal::MergeKSelect(bLoserWins, winner, loser);
+				pWinnerHead  = Internal::MergeKSelect(bLoserWins, pWinnerHead, pLoserHead);
+			}
+		}
+
+		for(r = 0; r < K; ++r)
+		{
+			pHeads[r].~iterator_type();
+			pEnds[r].~iterator_type();
+		}
+		EASTLFree(allocator, pMemory, nBytes);
+
+		return result;
+	}
+
+	template <typename RangeIterator, typename OutputIterator, typename Compare>
+	inline OutputIterator merge_k(RangeIterator firstRange, RangeIterator lastRange, OutputIterator result, Compare compare)
+	{
+		EASTLAllocatorType allocator(EASTL_DEFAULT_NAME_PREFIX " merge_k");
+		return eastl::merge_k<RangeIterator, OutputIterator, EASTLAllocatorType, Compare>(firstRange, lastRange, result, allocator, compare);
+	}
+
+	template <typename RangeIterator, typename OutputIterator>
+	inline OutputIterator merge_k(RangeIterator firstRange, RangeIterator lastRange, OutputIterator result)
+	{
+		typedef typename eastl::iterator_traits<RangeIterator>::value_type range_type;
+		typedef eastl::less<typename eastl::iterator_traits<typename range_type::first_type>::value_type> Less;
+
+		return eastl::merge_k<RangeIterator, OutputIterator, Less>(firstRange, lastRange, result, Less());
+	}
+
+
+
+	/// merge_path
+	///
+	/// Returns how many elements of [first1, last1) are among the first
+	/// nDiagonal elements output by merge(first1, last1, first2, last2, ...);
+	/// the other nDiagonal - n come from [first2, last2). This is a binary
+	/// search along the diagonal of the "merge path", so O(log n).
+	///
+	/// Splitting the output at several diagonals divides a merge into
+	/// independent pieces of exactly equal size, whatever the data; this is
+	/// how merge_part and parallel_merge divide a merge between threads.
+	///
+	template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Compare>
+	typename eastl::iterator_traits<RandomAccessIterator1>::difference_type
+	merge_path(RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+			   typename eastl::iterator_traits<RandomAccessIterator1>::difference_type nDiagonal, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+		const difference_type n1 = (difference_type)(last1 - first1);
+		const difference_type n2 = (difference_type)(last2 - first2);
+
+		EASTL_ASSERT((nDiagonal >= 0) && (nDiagonal <= (n1 + n2)));
+
+		difference_type lo = (nDiagonal > n2) ? (nDiagonal - n2) : 0;
+		difference_type hi = (nDiagonal < n1) ? nDiagonal : n1;
+
+		while(lo < hi)
+		{
+			// If first1[mid] goes before first2[nDiagonal - 1 - mid] (ties go to the
+			// first range, as in merge) then first1[mid] is within the diagonal.
+			const difference_type mid = lo + ((hi - lo) >> 1);
+
+			if(!compare(*(first2 + (nDiagonal - 1 - mid)), *(first1 + mid)))
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		return lo;
+	}
+
+	template <typename RandomAccessIterator1, typename RandomAccessIterator2>
+	inline typename eastl::iterator_traits<RandomAccessIterator1>::difference_type
+	merge_path(RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+			   typename eastl::iterator_traits<RandomAccessIterator1>::difference_type nDiagonal)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator1>::value_type> Less;
+
+		return eastl::merge_path<RandomAccessIterator1, RandomAccessIterator2, Less>(first1, last1, first2, last2, nDiagonal, Less());
+	}
+
+
+
+	/// merge_part
+	///
+	/// Does part nPart of nPartCount of merge(first1, last1, first2, last2,
+	/// result, compare): it writes the output elements from
+	/// nPart * n / nPartCount up to (nPart + 1) * n / nPartCount (rounded
+	/// consistently), where n is the total number of elements. The parts
+	/// write disjoint ranges of the output and read the inputs only, so they
+	/// can run concurrently, one per thread. Calling it for every part gives
+	/// the same result as merge.
+	///
+	/// Example usage:
+	///    // On each of nThreadCount threads:
+	///    eastl::merge_part(a.begin(), a.end(), b.begin(), b.end(), output.begin(), nThreadIndex, nThreadCount, eastl::less<int>());
+	///
+	template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename RandomAccessIterator3, typename Compare>
+	void merge_part(RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+					RandomAccessIterator3 result, size_t nPart, size_t nPartCount, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator1>::difference_type difference_type;
+
+		EASTL_ASSERT(nPart < nPartCount);
+
+		const size_t n         = (size_t)(last1 - first1) + (size_t)(last2 - first2);
+		const size_t nBase     = n / nPartCount;
+		const size_t nExtra    = n % nPartCount; // The first nExtra parts get one more element.
+		const size_t nBegin    = (nBase * nPart) + ((nPart < nExtra) ? nPart : nExtra);
+		const size_t nEnd      = nBegin + nBase + ((nPart < nExtra) ? 1 : 0);
+
+		const difference_type i0 = eastl::merge_path(first1, last1, first2, last2, (difference_type)nBegin, compare);
+		const difference_type i1 = eastl::merge_path(first1, last1, first2, last2, (difference_type)nEnd,   compare);
+
+		eastl::merge(first1 + i0, first1 + i1, first2 + ((difference_type)nBegin - i0), first2 + ((difference_type)nEnd - i1), result + (difference_type)nBegin, compare);
+	}
+
+	template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename RandomAccessIterator3>
+	inline void merge_part(RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+						   RandomAccessIterator3 result, size_t nPart, size_t nPartCount)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator1>::value_type> Less;
+
+		eastl::merge_part<RandomAccessIterator1, RandomAccessIterator2, RandomAccessIterator3, Less>(first1, last1, first2, last2, result, nPart, nPartCount, Less());
+	}
+
+
+
+	/// parallel_merge
+	///
+	/// Does merge(first1, last1, first2, last2, result, compare) in nPartCount
+	/// parts of equal size, using merge_part. EASTL has no threads of its own,
+	/// so the parts are run by the user's executor, which is called as
+	/// executor(task, nPartCount) and must call task(i) for each i in
+	/// [0, nPartCount), in any order and on any threads, and return once they
+	/// have all completed. The output must not overlap the inputs.
+	///
+	/// Example usage:
+	///    struct ThreadExecutor
+	///    {
+	///        template <typename Task>
+	///        void operator()(const Task& task, size_t nCount) const
+	///        {
+	///            std::vector<std::thread> threads;
+	///            for(size_t i = 1; i < nCount; ++i)
+	///                threads.emplace_back(task, i);
+	///            task(0);
+	///            for(auto& thread : threads)
+	///                thread.join();
+	///        }
+	///    };
+	///
+	///    eastl::parallel_merge(a.begin(), a.end(), b.begin(), b.end(), output.begin(), 8, ThreadExecutor(), eastl::less<int>());
+	///
+	namespace Internal
+	{
+		template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename RandomAccessIterator3, typename Compare>
+		struct merge_part_task
+		{
+			RandomAccessIterator1 mFirst1, mLast1;
+			RandomAccessIterator2 mFirst2, mLast2;
+			RandomAccessIterator3 mResult;
+			size_t                mnPartCount;
+			Compare               mCompare;
+
+			void operator()(size_t nPart) const
+				{ eastl::merge_part(mFirst1, mLast1, mFirst2, mLast2, mResult, nPart, mnPartCount, mCompare); }
+		};
+	}
+
+	template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename RandomAccessIterator3, typename Executor, typename Compare>
+	RandomAccessIterator3 parallel_merge(RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+										 RandomAccessIterator3 result, size_t nPartCount, Executor executor, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator3>::difference_type difference_type;
+
+		const Internal::merge_part_task<RandomAccessIterator1, RandomAccessIterator2, RandomAccessIterator3, Compare> task =
+			{ first1, last1, first2, last2, result, nPartCount ? nPartCount : 1, compare };
+
+		if(task.mnPartCount == 1)
+			task(0);
+		else
+			executor(task, task.mnPartCount);
+
+		return result + (difference_type)((last1 - first1) + (last2 - first2));
+	}
+
+	template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename RandomAccessIterator3, typename Executor>
+	inline RandomAccessIterator3 parallel_merge(RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+												RandomAccessIterator3 result, size_t nPartCount, Executor executor)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator1>::value_type> Less;
+
+		return eastl::parallel_merge<RandomAccessIterator1, RandomAccessIterator2, RandomAccessIterator3, Executor, Less>(first1, last1, first2, last2, result, nPartCount, executor, Less());
+	}
+
+
+
 	/// insertionSort
 	///
 	/// Since insertionSort requires that the data be addressed with a BidirectionalIterator and 
@@ -602,14 +973,14 @@ namespace eastl
 	/////////////////////////////////////////////////////////////////////
 	// quickSort
 	//
-	// We do the "introspection sort" variant of quick sort which is now
-	// well-known and understood. You can read about this algorithm in
-	// many articles on quick sort, but briefly what it does is a median-
-	// of-three quick sort whereby the recursion depth is limited to a
-	// some value (after which it gives up on quick sort and switches to
-	// a heap sort) and whereby after a certain amount of sorting the 
-	// algorithm stops doing quick-sort and finishes the sorting via
-	// a simple insertion sort.
+	// We do the "pattern-defeating" variant of the "introspection sort" 
+	// quick sort. Introsort is a median-of-three quick sort whereby the 
+	// recursion depth is limited to some value (after which it gives up 
+	// on quick sort and switches to a heap sort) and whereby small
+	// partitions are finished via a simple insertion sort. pdqsort limits
+	// the number of badly unbalanced partitions instead of the depth,
+	// shuffles elements to break up the patterns that cause them, and
+	// recognizes sorted partitions and runs of equal elements.
 	/////////////////////////////////////////////////////////////////////
 
 	#if (defined(EA_PROCESSOR_X86) || defined(EA_PROCESSOR_X86_64))
@@ -760,253 +1131,817 @@ namespace eastl
 	} // namespace Internal
 
 
-	template <typename RandomAccessIterator>
-	inline void partialSort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last)
+	namespace Internal
 	{
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+		// The pattern-defeating quicksort below is based on pdqsort by Orson Peters,
+		// https://github.com/orlp/pdqsort, which is licensed under the zlib license:
+		// Copyright (c) 2021 Orson Peters. The block partitioning is from BlockQuicksort,
+		// Edelkamp and Weiss, "BlockQuicksort: How Branch Mispredictions don't affect Quicksort".
 
-		eastl::makeHeap<RandomAccessIterator>(first, middle);
-
-		for(RandomAccessIterator i = middle; i < last; ++i)
-		{
-			if(*i < *first)
-			{
-				EASTL_VALIDATE_COMPARE(!(*first < *i)); // Validate that the compare function is sane.
-				const value_type temp(*i);
-				*i = *first;
-				eastl::adjustHeap<RandomAccessIterator, difference_type, value_type>
-								  (first, difference_type(0), difference_type(middle - first), difference_type(0), temp);
-			}
-		}
+		static const int kQuickSortNintherThreshold        = 128; // Partitions above this size use Tukey's ninther for the pivot.
+		static const int kQuickSortPartialInsertionLimit   = 8;   // Moves allowed by quickSort_partial_insertion before it gives up.
+		static const int kQuickSortBlockSize               = 64;  // The number of elements per block in quickSort_partition_block.
 
-		eastl::sortHeap<RandomAccessIterator>(first, middle);
-	}
+		/// quickSort_use_block_partition
+		///
+		/// Whether quickSort partitions with quickSort_partition_block, which replaces the
+		/// unpredictable branch on each comparison with arithmetic. This is a win only when
+		/// comparing is cheap and free of branches itself, as it is for the built-in
+		/// comparisons of arithmetic types. It's a loss for anything else, as the block
+		/// partition does more moves. Specialize this for other cheap comparisons.
+		///
+		template <typename T, typename Compare>
+		struct quickSort_use_block_partition : public eastl::false_type { };
 
+		template <typename T>
+		struct quickSort_use_block_partition<T, eastl::less<T> > : public eastl::integral_constant<bool, eastl::is_arithmetic<T>::value> { };
 
-	template <typename RandomAccessIterator, typename Compare>
-	inline void partialSort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare compare)
-	{
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+		template <typename T>
+		struct quickSort_use_block_partition<T, eastl::greater<T> > : public eastl::integral_constant<bool, eastl::is_arithmetic<T>::value> { };
 
-		eastl::makeHeap<RandomAccessIterator, Compare>(first, middle, compare);
 
-		for(RandomAccessIterator i = middle; i < last; ++i)
+		template <typename RandomAccessIterator, typename Compare>
+		inline void quickSort_sort2(RandomAccessIterator a, RandomAccessIterator b, Compare& compare)
 		{
-			if(compare(*i, *first))
-			{
-				EASTL_VALIDATE_COMPARE(!compare(*first, *i)); // Validate that the compare function is sane.
-				const value_type temp(*i);
-				*i = *first;
-				eastl::adjustHeap<RandomAccessIterator, difference_type, value_type, Compare>
-								  (first, difference_type(0), difference_type(middle - first), difference_type(0), temp, compare);
-			}
+			if(compare(*b, *a))
+				eastl::iterSwap(a, b);
 		}
 
-		eastl::sortHeap<RandomAccessIterator, Compare>(first, middle, compare);
-	}
 
+		template <typename RandomAccessIterator, typename Compare>
+		inline void quickSort_sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare& compare)
+		{
+			quickSort_sort2(a, b, compare);
+			quickSort_sort2(b, c, compare);
+			quickSort_sort2(a, b, compare);
+		}
 
-	template<typename RandomAccessIterator>
-	inline void nthElement(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
-	{
-		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
 
-		while((last - first) > 5)
+		// Insertion sorts [first, last), but gives up and returns false once more than
+		// kQuickSortPartialInsertionLimit elements have been moved. Used to detect and
+		// cheaply finish partitions that are already sorted or nearly so.
+		template <typename RandomAccessIterator, typename Compare>
+		bool quickSort_partial_insertion(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
 		{
-			const value_type           midValue(eastl::median<value_type>(*first, *(first + (last - first) / 2), *(last - 1)));
-			const RandomAccessIterator midPos(eastl::getPartition<RandomAccessIterator, value_type>(first, last, midValue));
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
 
-			if(midPos <= nth)
-				first = midPos;
-			else
-				last = midPos;
-		}
+			if(first != last)
+			{
+				intptr_t nMoves = 0;
 
-		eastl::insertionSort<RandomAccessIterator>(first, last);
-	}
+				for(RandomAccessIterator current = first + 1; current != last; ++current)
+				{
+					RandomAccessIterator sift(current), prev(current - 1);
 
+					if(compare(*sift, *prev))
+					{
+						value_type temp(eastl::move(*sift));
 
-	template<typename RandomAccessIterator, typename Compare>
-	inline void nthElement(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare compare)
-	{
-		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+						do {
+							*sift-- = eastl::move(*prev);
+						} while((sift != first) && compare(temp, *--prev));
 
-		while((last - first) > 5)
-		{
-			const value_type           midValue(eastl::median<value_type, Compare>(*first, *(first + (last - first) / 2), *(last - 1), compare));
-			const RandomAccessIterator midPos(eastl::getPartition<RandomAccessIterator, value_type, Compare>(first, last, midValue, compare));
+						*sift = eastl::move(temp);
+						nMoves += (intptr_t)(current - sift);
 
-			if(midPos <= nth)
-				first = midPos;
-			else
-				last = midPos;
-		}
+						if(nMoves > kQuickSortPartialInsertionLimit)
+							return false;
+					}
+				}
+			}
 
-		eastl::insertionSort<RandomAccessIterator, Compare>(first, last, compare);
-	}
+			return true;
+		}
 
 
-	namespace Internal
-	{
-		template <typename RandomAccessIterator, typename Size>
-		inline void quickSort_impl(RandomAccessIterator first, RandomAccessIterator last, Size kRecursionCount)
+		// Partitions [first, last) around the pivot *first, with the elements equal to the
+		// pivot going left. Returns the pivot's final position, which is the last element
+		// not greater than it. Used when the pivot equals the element before the range, which
+		// is known to be not greater than anything in the range: all the elements equal to
+		// the pivot end up on its left, sorted, and only the right remains to be sorted.
+		template <typename RandomAccessIterator, typename Compare>
+		RandomAccessIterator quickSort_partition_left(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
 		{
-			typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			value_type           pivot(eastl::move(*first));
+			RandomAccessIterator l(first), r(last);
 
-			while(((last - first) > kQuickSortLimit) && (kRecursionCount > 0))
+			while(compare(pivot, *--r))
+				{ }
+
+			if((r + 1) == last)
+			{
+				while((l < r) && !compare(pivot, *++l))
+					{ }
+			}
+			else
 			{
-				const RandomAccessIterator position(eastl::getPartition<RandomAccessIterator, value_type>(first, last, eastl::median<value_type>(*first, *(first + (last - first) / 2), *(last - 1))));
+				while(!compare(pivot, *++l)) // The element at r stops this.
+					{ }
+			}
+
+			while(l < r)
+			{
+				eastl::iterSwap(l, r);
 
-				eastl::Internal::quickSort_impl<RandomAccessIterator, Size>(position, last, --kRecursionCount);
-				last = position;
+				while(compare(pivot, *--r))
+					{ }
+				while(!compare(pivot, *++l))
+					{ }
 			}
 
-			if(kRecursionCount == 0)
-				eastl::partialSort<RandomAccessIterator>(first, last, last);
+			*first = eastl::move(*r);
+			*r     = eastl::move(pivot);
+
+			return r;
 		}
 
 
-		template <typename RandomAccessIterator, typename Size, typename Compare>
-		inline void quickSort_impl(RandomAccessIterator first, RandomAccessIterator last, Size kRecursionCount, Compare compare)
+		// Partitions [first, last) around the pivot *first, with the elements equal to the pivot
+		// going right. Returns the pivot's final position and sets bAlreadyPartitioned if no
+		// elements had to be swapped. The caller guarantees that some element of the range
+		// isn't less than the pivot, which lets the left scan run without a bounds check.
+		template <typename RandomAccessIterator, typename Compare>
+		RandomAccessIterator quickSort_partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare& compare, bool& bAlreadyPartitioned)
 		{
-			typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+			value_type           pivot(eastl::move(*first));
+			RandomAccessIterator l(first), r(last);
+
+			while(compare(*++l, pivot))
+				{ }
+
+			if((l - 1) == first) // If there is no element less than the pivot to stop the right scan...
+			{
+				while((l < r) && !compare(*--r, pivot))
+					{ }
+			}
+			else
+			{
+				while(!compare(*--r, pivot))
+					{ }
+			}
+
+			bAlreadyPartitioned = (l >= r);
 
-			while(((last - first) > kQuickSortLimit) && (kRecursionCount > 0))
+			while(l < r)
 			{
-				const RandomAccessIterator position(eastl::getPartition<RandomAccessIterator, value_type, Compare>(first, last, eastl::median<value_type, Compare>(*first, *(first + (last - first) / 2), *(last - 1), compare), compare));
+				eastl::iterSwap(l, r);
 
-				eastl::Internal::quickSort_impl<RandomAccessIterator, Size, Compare>(position, last, --kRecursionCount, compare);
-				last = position;
+				while(compare(*++l, pivot))
+					{ }
+				while(!compare(*--r, pivot))
+					{ }
 			}
 
-			if(kRecursionCount == 0)
-				eastl::partialSort<RandomAccessIterator, Compare>(first, last, last, compare);
-		}
-	}
+			const RandomAccessIterator pivotPos(l - 1);
 
+			*first    = eastl::move(*pivotPos);
+			*pivotPos = eastl::move(pivot);
 
-	/// quickSort
-	///
-	/// This is an unstable sort.
-	/// quickSort sorts the elements in [first, last) into ascending order, 
-	/// meaning that if i and j are any two valid iterators in [first, last) 
-	/// such that i precedes j, then *j is not less than *i. quickSort is not 
-	/// guaranteed to be stable. That is, suppose that *i and *j are equivalent: 
-	/// neither one is less than the other. It is not guaranteed that the 
-	/// relative order of these two elements will be preserved by sort.
-	///
-	/// We implement the "introspective" variation of quick-sort. This is 
-	/// considered to be the best general-purpose variant, as it avoids 
-	/// worst-case behaviour and optimizes the final sorting stage by 
-	/// switching to an insertion sort.
-	///
-	template <typename RandomAccessIterator>
-	void quickSort(RandomAccessIterator first, RandomAccessIterator last)
-	{
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+			return pivotPos;
+		}
 
-		if(first != last)
+
+		// Swaps pairs of misplaced elements found by quickSort_partition_block: the elements at
+		// lBase + pOffsetsL[i] belong on the right, those at rBase - pOffsetsR[i] on the left.
+		// A single cyclic permutation takes fewer moves than swapping pairs, but when the two
+		// counts were equal the pairs can't be told from a cycle, so pairs are swapped.
+		template <typename RandomAccessIterator>
+		inline void quickSort_swap_offsets(RandomAccessIterator lBase, RandomAccessIterator rBase, const unsigned char* pOffsetsL,
+										   const unsigned char* pOffsetsR, intptr_t n, bool bUseSwaps)
 		{
-			eastl::Internal::quickSort_impl<RandomAccessIterator, difference_type>(first, last, 2 * Internal::Log2(last - first));
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
 
-			if((last - first) > (difference_type)kQuickSortLimit)
+			if(bUseSwaps)
 			{
-				eastl::insertionSort<RandomAccessIterator>(first, first + kQuickSortLimit);
-				eastl::Internal::insertionSort_simple<RandomAccessIterator>(first + kQuickSortLimit, last);
+				for(intptr_t i = 0; i < n; ++i)
+					eastl::iterSwap(lBase + pOffsetsL[i], rBase - pOffsetsR[i]);
 			}
-			else
-				eastl::insertionSort<RandomAccessIterator>(first, last);
-		}
-	}
-
+			else if(n > 0)
+			{
+				RandomAccessIterator l(lBase + pOffsetsL[0]);
+				RandomAccessIterator r(rBase - pOffsetsR[0]);
+				value_type           temp(eastl::move(*l));
 
-	template <typename RandomAccessIterator, typename Compare>
-	void quickSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
-	{
-		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+				*l = eastl::move(*r);
 
-		if(first != last)
-		{
-			eastl::Internal::quickSort_impl<RandomAccessIterator, difference_type, Compare>(first, last, 2 * Internal::Log2(last - first), compare);
+				for(intptr_t i = 1; i < n; ++i)
+				{
+					l  = lBase + pOffsetsL[i];
+					*r = eastl::move(*l);
+					r  = rBase - pOffsetsR[i];
+					*l = eastl::move(*r);
+				}
 
-			if((last - first) > (difference_type)kQuickSortLimit)
-			{
-				eastl::insertionSort<RandomAccessIterator, Compare>(first, first + kQuickSortLimit, compare);
-				eastl::Internal::insertionSort_simple<RandomAccessIterator, Compare>(first + kQuickSortLimit, last, compare);
+				*r = eastl::move(temp);
 			}
-			else
-				eastl::insertionSort<RandomAccessIterator, Compare>(first, last, compare);
 		}
-	}
 
 
+		// Does the same as quickSort_partition_right, but without a branch on the outcome of
+		// each comparison. A block of kQuickSortBlockSize elements is scanned from each end,
+		// writing every element's offset to a buffer and advancing the buffer's end only if
+		// the element is on the wrong side; then the misplaced elements are swapped in pairs.
+		template <typename RandomAccessIterator, typename Compare>
+		RandomAccessIterator quickSort_partition_block(RandomAccessIterator first, RandomAccessIterator last, Compare& compare, bool& bAlreadyPartitioned)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
 
+			value_type           pivot(eastl::move(*first));
+			RandomAccessIterator l(first), r(last);
 
-	namespace Internal
-	{
-		// Portions of the tim_sort code were originally written by Christopher Swenson.
-		// https://github.com/swenson/sort
-		// All code in this repository, unless otherwise specified, is hereby licensed under the 
-		// MIT Public License: Copyright (c) 2010 Christopher Swenson
+			while(compare(*++l, pivot))
+				{ }
 
-		const intptr_t kTimSortStackSize = 64; // Question: What's the upper-limit size requirement for this?
+			if((l - 1) == first)
+			{
+				while((l < r) && !compare(*--r, pivot))
+					{ }
+			}
+			else
+			{
+				while(!compare(*--r, pivot))
+					{ }
+			}
 
-		struct tim_sort_run
-		{
-			intptr_t start;
-			intptr_t length;
-		};
+			bAlreadyPartitioned = (l >= r);
 
+			if(!bAlreadyPartitioned)
+			{
+				eastl::iterSwap(l, r);
+				++l;
 
-		// EASTL_COUNT_LEADING_ZEROES
-		//
-		// Count leading zeroes in an integer.
-		//
-		#ifndef EASTL_COUNT_LEADING_ZEROES
-			#if   defined(__GNUC__)
-				#if (EA_PLATFORM_PTR_SIZE == 8)
-					#define EASTL_COUNT_LEADING_ZEROES __builtin_clzll
-				#else
-					#define EASTL_COUNT_LEADING_ZEROES __builtin_clz
-				#endif
-			#endif
+				// [l, r) is the unknown region. Offsets in pOffsetsL are from lBase forward and
+				// offsets in pOffsetsR are from rBase backward (and one-based, as rBase is one past).
+				unsigned char        pOffsetsL[kQuickSortBlockSize];
+				unsigned char        pOffsetsR[kQuickSortBlockSize];
+				RandomAccessIterator lBase(l), rBase(r);
+				intptr_t             nL = 0, nR = 0, startL = 0, startR = 0;
 
-			#ifndef EASTL_COUNT_LEADING_ZEROES
-				static inline int eastl_count_leading_zeroes(uint64_t x)
+				while(l < r)
 				{
-					if(x)
+					// Fill whichever buffers are empty. Near the end, split what is left between them.
+					const intptr_t nUnknown = (intptr_t)(r - l);
+					const intptr_t nSplitL  = (nL == 0) ? ((nR == 0) ? (nUnknown / 2) : nUnknown) : 0;
+					const intptr_t nSplitR  = (nR == 0) ? (nUnknown - nSplitL) : 0;
+
+					if(nSplitL >= kQuickSortBlockSize)
 					{
-						int n = 0;
-						if(x & UINT64_C(0xFFFFFFFF00000000)) { n += 32; x >>= 32; }
-						if(x & 0xFFFF0000)                   { n += 16; x >>= 16; }
-						if(x & 0xFFFFFF00)                   { n +=  8; x >>=  8; }
-						if(x & 0xFFFFFFF0)                   { n +=  4; x >>=  4; }
-						if(x & 0xFFFFFFFC)                   { n +=  2; x >>=  2; }
-						if(x & 0xFFFFFFFE)                   { n +=  1;           }
-						return 63 - n;
+						for(intptr_t i = 0; i < kQuickSortBlockSize; ++i, ++l)
+						{
+							pOffsetsL[nL] = (unsigned char)i;
+							nL += !compare(*l, pivot);
+						}
+					}
+					else
+					{
+						for(intptr_t i = 0; i < nSplitL; ++i, ++l)
+						{
+							pOffsetsL[nL] = (unsigned char)i;
+							nL += !compare(*l, pivot);
+						}
+					}
+
+					if(nSplitR >= kQuickSortBlockSize)
+					{
+						for(intptr_t i = 1; i <= kQuickSortBlockSize; ++i)
+						{
+							pOffsetsR[nR] = (unsigned char)i;
+							nR += compare(*--r, pivot);
+						}
+					}
+					else
+					{
+						for(intptr_t i = 1; i <= nSplitR; ++i)
+						{
+							pOffsetsR[nR] = (unsigned char)i;
+							nR += compare(*--r, pivot);
+						}
+					}
+
+					const intptr_t n = (nL < nR) ? nL : nR;
+
+					quickSort_swap_offsets(lBase, rBase, pOffsetsL + startL, pOffsetsR + startR, n, (nL == nR));
+
+					nL     -= n;
+					nR     -= n;
+					startL += n;
+					startR += n;
+
+					if(nL == 0)
+					{
+						startL = 0;
+						lBase  = l;
+					}
+
+					if(nR == 0)
+					{
+						startR = 0;
+						rBase  = r;
 					}
-					return 64;
 				}
 
-				static inline int eastl_count_leading_zeroes(uint32_t x)
+				// The unknown region is now empty, but one of the buffers may still hold misplaced
+				// elements. Swap them, from the back, to the boundary.
+				if(nL)
 				{
-					if(x)
+					while(nL--)
+						eastl::iterSwap(lBase + pOffsetsL[startL + nL], --r);
+					l = r;
+				}
+
+				if(nR)
+				{
+					while(nR--)
 					{
-						int n = 0;
-						if(x <= 0x0000FFFF) { n += 16; x <<= 16; }
-						if(x <= 0x00FFFFFF) { n +=  8; x <<=  8; }
-						if(x <= 0x0FFFFFFF) { n +=  4; x <<=  4; }
-						if(x <= 0x3FFFFFFF) { n +=  2; x <<=  2; }
-						if(x <= 0x7FFFFFFF) { n +=  1;           }
-						return n;
+						eastl::iterSwap(rBase - pOffsetsR[startR + nR], l);
+						++l;
 					}
-					return 32;
 				}
+			}
 
-				#define EASTL_COUNT_LEADING_ZEROES eastl_count_leading_zeroes
-			#endif
+			const RandomAccessIterator pivotPos(l - 1);
+
+			*first    = eastl::move(*pivotPos);
+			*pivotPos = eastl::move(pivot);
+
+			return pivotPos;
+		}
+
+
+		template <typename RandomAccessIterator, typename Compare, bool bBlockPartition>
+		void quickSort_impl(RandomAccessIterator first, RandomAccessIterator last, Compare& compare, int nBadAllowed, bool bLeftmost)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			for(;;)
+			{
+				const difference_type size = (last - first);
+
+				if(size <= (difference_type)kQuickSortLimit)
+				{
+					if(bLeftmost)
+						eastl::insertionSort<RandomAccessIterator, Compare>(first, last, compare);
+					else
+						eastl::Internal::insertionSort_simple<RandomAccessIterator, Compare>(first, last, compare); // *(first - 1) stops the insertion.
+					return;
+				}
+
+				// Put the pivot in *first. The median of three elements (or the median of the
+				// medians of three triples, Tukey's ninther, for large ranges) also leaves
+				// elements on either side that stop the partitioning scans.
+				const difference_type half = (size / 2);
+
+				if(size > kQuickSortNintherThreshold)
+				{
+					quickSort_sort3(first, first + half, last - 1, compare);
+					quickSort_sort3(first + 1, first + (half - 1), last - 2, compare);
+					quickSort_sort3(first + 2, first + (half + 1), last - 3, compare);
+					quickSort_sort3(first + (half - 1), first + half, first + (half + 1), compare);
+					eastl::iterSwap(first, first + half);
+				}
+				else
+					quickSort_sort3(first + half, first, last - 1, compare);
+
+				// If the pivot equals the element before the range (the previous pivot, or an element
+				// left of it), then it is the least element of the range and there are probably many
+				// more equal to it. Put them all on the left, where they need no further sorting.
+				if(!bLeftmost && !compare(*(first - 1), *first))
+				{
+					first = quickSort_partition_left(first, last, compare) + 1;
+					continue;
+				}
+
+				bool bAlreadyPartitioned;
+
+				const RandomAccessIterator pivotPos(bBlockPartition ? quickSort_partition_block(first, last, compare, bAlreadyPartitioned)
+				                                                    : quickSort_partition_right(first, last, compare, bAlreadyPartitioned));
+				const difference_type      sizeL = (pivotPos - first);
+				const difference_type      sizeR = (last - (pivotPos + 1));
+
+				if((sizeL < (size / 8)) || (sizeR < (size / 8)))
+				{
+					// A bad partition. After log2(n) of these, give up and heap sort, which
+					// guarantees O(n log n). Otherwise break up any pattern that might be causing
+					// them by swapping a few elements to new positions.
+					if(--nBadAllowed == 0)
+					{
+						eastl::heapSort<RandomAccessIterator, Compare>(first, last, compare);
+						return;
+					}
+
+					if(sizeL >= (difference_type)kQuickSortLimit)
+					{
+						eastl::iterSwap(first, first + (sizeL / 4));
+						eastl::iterSwap(pivotPos - 1, pivotPos - (sizeL / 4));
+
+						if(sizeL > kQuickSortNintherThreshold)
+						{
+							eastl::iterSwap(first + 1, first + (sizeL / 4 + 1));
+							eastl::iterSwap(first + 2, first + (sizeL / 4 + 2));
+							eastl::iterSwap(pivotPos - 2, pivotPos - (sizeL / 4 + 1));
+							eastl::iterSwap(pivotPos - 3, pivotPos - (sizeL / 4 + 2));
+						}
+					}
+
+					if(sizeR >= (difference_type)kQuickSortLimit)
+					{
+						eastl::iterSwap(pivotPos + 1, pivotPos + (1 + sizeR / 4));
+						eastl::iterSwap(last - 1, last - (sizeR / 4));
+
+						if(sizeR > kQuickSortNintherThreshold)
+						{
+							eastl::iterSwap(pivotPos + 2, pivotPos + (2 + sizeR / 4));
+							eastl::iterSwap(pivotPos + 3, pivotPos + (3 + sizeR / 4));
+							eastl::iterSwap(last - 2, last - (1 + sizeR / 4));
+							eastl::iterSwap(last - 3, last - (2 + sizeR / 4));
+						}
+					}
+				}
+				else if(bAlreadyPartitioned && quickSort_partial_insertion(first, pivotPos, compare)
+				                            && quickSort_partial_insertion(pivotPos + 1, last, compare))
+				{
+					// A partition that needed no swaps suggests sorted input. If both sides
+					// turned out to be nearly sorted, they've now been sorted.
+					return;
+				}
+
+				// Recurse into the left side and loop on the right, so the stack depth is bounded
+				// by the number of bad partitions plus log2(n).
+				eastl::Internal::quickSort_impl<RandomAccessIterator, Compare, bBlockPartition>(first, pivotPos, compare, nBadAllowed, bLeftmost);
+				first     = pivotPos + 1;
+				bLeftmost = false;
+			}
+		}
+	}
+
+
+	/// quickSort
+	///
+	/// This is an unstable sort.
+	/// quickSort sorts the elements in [first, last) into ascending order, 
+	/// meaning that if i and j are any two valid iterators in [first, last) 
+	/// such that i precedes j, then *j is not less than *i. quickSort is not 
+	/// guaranteed to be stable. That is, suppose that *i and *j are equivalent: 
+	/// neither one is less than the other. It is not guaranteed that the 
+	/// relative order of these two elements will be preserved by sort.
+	///
+	/// We implement pattern-defeating quicksort (pdqsort), a variant of the 
+	/// "introspective" quick-sort. Like introsort, it switches to insertion 
+	/// sort for small partitions and to heapSort when the partitions keep 
+	/// coming out unbalanced, which bounds the worst case to O(n log n). On 
+	/// top of that it finishes sorted and nearly sorted ranges in linear time, 
+	/// sorts runs of equal elements in linear time, breaks up patterns that 
+	/// would otherwise produce bad partitions, and for arithmetic types with 
+	/// eastl::less or eastl::greater partitions without branch mispredictions.
+	/// See Internal::quickSort_use_block_partition.
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	void quickSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+		if(first != last)
+		{
+			eastl::Internal::quickSort_impl<RandomAccessIterator, Compare, Internal::quickSort_use_block_partition<value_type, Compare>::value>
+				(first, last, compare, (int)Internal::Log2(last - first), true);
+		}
+	}
+
+
+	template <typename RandomAccessIterator>
+	inline void quickSort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::quickSort<RandomAccessIterator, Less>(first, last, Less());
+	}
+
+
+	static const int kPartialSortHeapRatio = 1024; // partialSort uses a heap when middle - first is at most 1/1024 of last - first.
+
+	namespace Internal
+	{
+		static const int kNthElementSampleThreshold = 600; // Ranges above this size pick the pivot by Floyd-Rivest sampling.
+
+		template <typename RandomAccessIterator, typename Compare, bool bBlockPartition>
+		void nthElement_impl(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare& compare, int nBadAllowed);
+
+
+		// Moves the median of each group of five elements to the front of [first, last) and
+		// selects the median of those. At least 3/10 of the range is not less than it and
+		// 3/10 is not greater, which is what makes the worst case of nthElement linear.
+		// Returns the median's position; the position after it holds an element not less
+		// than it.
+		template <typename RandomAccessIterator, typename Compare, bool bBlockPartition>
+		RandomAccessIterator nthElement_median_of_medians(RandomAccessIterator first, RandomAccessIterator last, Compare& compare)
+		{
+			RandomAccessIterator medians(first);
+
+			for(RandomAccessIterator group(first); (last - group) >= 5; group += 5)
+			{
+				eastl::insertionSort<RandomAccessIterator, Compare>(group, group + 5, compare);
+				eastl::iterSwap(medians++, group + 2);
+			}
+
+			const RandomAccessIterator median(first + ((medians - first) / 2));
+
+			nthElement_impl<RandomAccessIterator, Compare, bBlockPartition>(first, median, medians, compare, 0);
+			return median;
+		}
+
+
+		// Places the element that belongs at nth there, using a recursive selection in a sample
+		// of about n^(2/3) elements around nth, positioned and sized (per Floyd and Rivest, 
+		// "Expected Time Bounds for Selection") so that the element that lands at nth is very 
+		// likely to be just past the one sought, on the side toward the middle of the range. 
+		// Partitioning around it then leaves a small range to search, rather than half of it.
+		// The position after nth holds an element not less than it. Requires nth < last - 1.
+		template <typename RandomAccessIterator, typename Compare, bool bBlockPartition>
+		void nthElement_floyd_rivest(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare& compare, int nBadAllowed)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			const difference_type size = (last - first);
+			const double          n    = (double)size;
+			const double          i    = (double)(nth - first);
+			const double          z    = log(n);
+			const double          s    = 0.5 * exp(2.0 * z / 3.0);
+			const double          sd   = 0.5 * sqrt(z * s * (n - s) / n) * ((i < (n / 2)) ? -1.0 : 1.0);
+
+			difference_type sampleFirst = (difference_type)(i - (i * s / n) + sd);
+			difference_type sampleLast  = (difference_type)(i + ((n - i) * s / n) + sd) + 1;
+
+			if(sampleFirst < 0)
+				sampleFirst = 0;
+			else if(sampleFirst > (nth - first))
+				sampleFirst = (nth - first);
+
+			if(sampleLast > size)
+				sampleLast = size;
+			else if(sampleLast < ((nth - first) + 2))
+				sampleLast = ((nth - first) + 2);
+
+			nthElement_impl<RandomAccessIterator, Compare, bBlockPartition>(first + sampleFirst, nth, first + sampleLast, compare, nBadAllowed);
+		}
+
+
+		template <typename RandomAccessIterator, typename Compare, bool bBlockPartition>
+		void nthElement_impl(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare& compare, int nBadAllowed)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+			bool bLeftmost = true;
+
+			while((last - first) > (difference_type)kQuickSortLimit)
+			{
+				const difference_type size = (last - first);
+
+				// Put the pivot in *first and an element not less than it in *(last - 1).
+				if((nth + 1) == last) // If we want the greatest element... find it directly.
+				{
+					eastl::iterSwap(nth, eastl::maxElement(first, last, compare));
+					return;
+				}
+				else if(nBadAllowed <= 0)
+				{
+					const RandomAccessIterator median(nthElement_median_of_medians<RandomAccessIterator, Compare, bBlockPartition>(first, last, compare));
+
+					eastl::iterSwap(last - 1, median + 1);
+					eastl::iterSwap(first, median);
+				}
+				else if(size > kNthElementSampleThreshold)
+				{
+					nthElement_floyd_rivest<RandomAccessIterator, Compare, bBlockPartition>(first, nth, last, compare, nBadAllowed);
+
+					eastl::iterSwap(last - 1, nth + 1);
+					eastl::iterSwap(first, nth);
+				}
+				else
+					quickSort_sort3(first + (size / 2), first, last - 1, compare);
+
+				// As with quickSort, a pivot equal to the element before the range is its least
+				// element, and all the elements equal to it can be dealt with at once.
+				if(!bLeftmost && !compare(*(first - 1), *first))
+				{
+					first = quickSort_partition_left(first, last, compare);
+
+					if(nth <= first)
+						return;
+
+					++first;
+					continue;
+				}
+
+				bool bAlreadyPartitioned;
+
+				const RandomAccessIterator pivotPos(bBlockPartition ? quickSort_partition_block(first, last, compare, bAlreadyPartitioned)
+				                                                    : quickSort_partition_right(first, last, compare, bAlreadyPartitioned));
+
+				if(pivotPos == nth)
+					return;
+
+				// A partition that leaves more than 3/4 of the range to search is bad. After 
+				// log2(n) of them, switch to the median of medians, which can't make them.
+				if(nth < pivotPos)
+				{
+					if((pivotPos - first) > (size / 4 * 3))
+						--nBadAllowed;
+					last = pivotPos;
+				}
+				else
+				{
+					if((last - (pivotPos + 1)) > (size / 4 * 3))
+						--nBadAllowed;
+					first     = pivotPos + 1;
+					bLeftmost = false;
+				}
+			}
+
+			eastl::insertionSort<RandomAccessIterator, Compare>(first, last, compare);
+		}
+	}
+
+
+	/// nthElement
+	///
+	/// Rearranges [first, last) so that *nth is the element that would be there if the range
+	/// were sorted, no element of [first, nth) is greater than it and no element of (nth, last)
+	/// is less than it. This is an unstable algorithm.
+	///
+	/// We implement introselect: quick select, with the pivot chosen by Floyd-Rivest sampling
+	/// for large ranges, which takes about n + min(k, n - k) comparisons to find the k'th of n 
+	/// elements, and by the median of medians once too many partitions come out badly, which 
+	/// bounds the worst case to O(n). The partitioning is shared with quickSort, including its 
+	/// branchless block partitioning for arithmetic types.
+	///
+	/// Example usage (the 99th percentile of a set of samples):
+	///     eastl::vector<double> samples;
+	///     ...
+	///     eastl::vector<double>::iterator p99 = samples.begin() + (samples.size() * 99 / 100);
+	///     eastl::nthElement(samples.begin(), p99, samples.end());
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	void nthElement(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+		if(nth != last)
+		{
+			eastl::Internal::nthElement_impl<RandomAccessIterator, Compare, Internal::quickSort_use_block_partition<value_type, Compare>::value>
+				(first, nth, last, compare, (int)Internal::Log2(last - first));
+		}
+	}
+
+
+	template <typename RandomAccessIterator>
+	inline void nthElement(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::nthElement<RandomAccessIterator, Less>(first, nth, last, Less());
+	}
+
+
+	/// partialSort
+	///
+	/// Rearranges [first, last) so that [first, middle) holds, in sorted order, the elements that
+	/// would be there if the range were sorted. The order of [middle, last) is unspecified.
+	/// This is an unstable algorithm.
+	///
+	/// For a middle close to first this keeps a heap of the (middle - first) least elements seen 
+	/// so far, which costs O(n log k) comparisons in the worst case but little more than n for 
+	/// random data, as few elements get into the heap. For a larger middle it selects with 
+	/// nthElement and sorts [first, middle) with quickSort, in O(n + k log k).
+	///
+	template <typename RandomAccessIterator, typename Compare>
+	void partialSort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		if(first == middle)
+			return;
+
+		if((middle - first) > ((last - first) / kPartialSortHeapRatio))
+		{
+			if(middle != last)
+				eastl::nthElement<RandomAccessIterator, Compare>(first, middle, last, compare);
+			eastl::quickSort<RandomAccessIterator, Compare>(first, middle, compare);
+		}
+		else
+		{
+			eastl::makeHeap<RandomAccessIterator, Compare>(first, middle, compare);
+
+			for(RandomAccessIterator i = middle; i < last; ++i)
+			{
+				if(compare(*i, *first))
+				{
+					EASTL_VALIDATE_COMPARE(!compare(*first, *i)); // Validate that the compare function is sane.
+					const value_type temp(*i);
+					*i = *first;
+					eastl::adjustHeap<RandomAccessIterator, difference_type, value_type, Compare>
+									  (first, difference_type(0), difference_type(middle - first), difference_type(0), temp, compare);
+				}
+			}
+
+			eastl::sortHeap<RandomAccessIterator, Compare>(first, middle, compare);
+		}
+	}
+
+
+	template <typename RandomAccessIterator>
+	inline void partialSort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		eastl::partialSort<RandomAccessIterator, Less>(first, middle, last, Less());
+	}
+
+
+	/// top_k
+	///
+	/// Copies to [result, result + k) in sorted order the k elements of [first, last) that would
+	/// come first if it were sorted, or all of them if there are fewer than k, and returns the end
+	/// of the copied elements. [first, last) is read once, in order, and isn't modified, so it can 
+	/// be a stream; the only memory used is the k elements at result, which are kept as a heap
+	/// of the best elements so far. This costs O(n log k) comparisons in the worst case and 
+	/// little more than n for data in random order. This is an unstable algorithm.
+	///
+	/// Example usage (the 100 greatest latencies):
+	///     double slowest[100];
+	///     double* slowestEnd = eastl::top_k(latencies.begin(), latencies.end(), 100, slowest, eastl::greater<double>());
+	///
+	template <typename InputIterator, typename RandomAccessIterator, typename Compare>
+	RandomAccessIterator top_k(InputIterator first, InputIterator last, size_t k, RandomAccessIterator result, Compare compare)
+	{
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+		typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+		RandomAccessIterator resultEnd(result);
+
+		for(; (first != last) && ((size_t)(resultEnd - result) < k); ++first, ++resultEnd)
+			*resultEnd = *first;
+
+		eastl::makeHeap<RandomAccessIterator, Compare>(result, resultEnd, compare);
+
+		if(result != resultEnd)
+		{
+			for(; first != last; ++first)
+			{
+				if(compare(*first, *result)) // If the element is better than the worst element kept so far...
+				{
+					EASTL_VALIDATE_COMPARE(!compare(*result, *first)); // Validate that the compare function is sane.
+					const value_type temp(*first);
+					eastl::adjustHeap<RandomAccessIterator, difference_type, value_type, Compare>
+									  (result, difference_type(0), difference_type(resultEnd - result), difference_type(0), temp, compare);
+				}
+			}
+		}
+
+		eastl::sortHeap<RandomAccessIterator, Compare>(result, resultEnd, compare);
+
+		return resultEnd;
+	}
+
+
+	template <typename InputIterator, typename RandomAccessIterator>
+	inline RandomAccessIterator top_k(InputIterator first, InputIterator last, size_t k, RandomAccessIterator result)
+	{
+		typedef eastl::less<typename eastl::iterator_traits<RandomAccessIterator>::value_type> Less;
+
+		return eastl::top_k<InputIterator, RandomAccessIterator, Less>(first, last, k, result, Less());
+	}
+
+
+
+
+	namespace Internal
+	{
+		// Portions of the tim_sort code were originally written by Christopher Swenson.
+		// https://github.com/swenson/sort
+		// All code in this repository, unless otherwise specified, is hereby licensed under the 
+		// MIT Public License: Copyright (c) 2010 Christopher Swenson
+
+		const intptr_t kTimSortStackSize = 64; // Question: What's the upper-limit size requirement for this?
+		const intptr_t kTimSortMinGallop = 7;  // The initial min_gallop, and how long a run's winning streak must be for galloping to continue.
+
+		struct tim_sort_run
+		{
+			intptr_t start;
+			intptr_t length;
+		};
+
+
+		// EASTL_COUNT_LEADING_ZEROES
+		//
+		// Count leading zeroes in an unsigned integer; see eastl/bit.h.
+		//
+		#ifndef EASTL_COUNT_LEADING_ZEROES
+			#define EASTL_COUNT_LEADING_ZEROES eastl::countl_zero
 		#endif
 
 
@@ -1072,22 +2007,16 @@ namespace eastl
 				
 				if(!compare(*(first + start + 1), *(first + start))) // If (first[start + 1] >= first[start]) (If the run is increasing) ...
 				{
-					for(;; ++curr)
+					for(; curr < size; ++curr) // While we are not at the end of the data...
 					{
-						if(curr == (size - 1)) // If we are at the end of the data... this run is done.
-							break;
-
 						if(compare(*(first + curr), *(first + curr - 1))) // If this item is not in order... this run is done.
 							break;
 					}
 				}
 				else  // Else it is decreasing.
 				{
-					for(;; ++curr)
+					for(; curr < size; ++curr) // While we are not at the end of the data...
 					{
-						if(curr == (size - 1))  // If we are at the end of the data... this run is done.
-							break;
-
 						if(!compare(*(first + curr), *(first + curr - 1)))  // If this item is not in order... this run is done.
 							break;                                          // Note that we intentionally compare against <= 0 and not just < 0. This is because 
 					}                                                       // The reverse_elements call below could reverse two equal elements and break our stability requirement.
@@ -1142,68 +2071,383 @@ namespace eastl
 		}
 
 
-		template <typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
-		void tim_sort_merge(RandomAccessIterator first, const tim_sort_run* run_stack, const intptr_t stack_curr, 
-							T* pBuffer, StrictWeakOrdering compare)
+		// tim_sort_gallop_left
+		//
+		// Returns the position k in the sorted range [base, base + size) such that
+		// base[0, k) < key <= base[k, size), which is where key goes if it is to be
+		// placed before the elements equal to it. The search starts at hint and
+		// steps away from it in increasing powers of two before finishing with a
+		// binary search, so it costs O(log d) comparisons where d is the distance
+		// from hint to the answer.
+		//
+		template <typename Iterator, typename T, typename StrictWeakOrdering>
+		intptr_t tim_sort_gallop_left(const T& key, Iterator base, const intptr_t size, const intptr_t hint, StrictWeakOrdering compare)
 		{
-			const intptr_t A    = run_stack[stack_curr - 2].length;
-			const intptr_t B    = run_stack[stack_curr - 1].length;
-			const intptr_t curr = run_stack[stack_curr - 2].start;
+			intptr_t lastOffset = 0;
+			intptr_t offset     = 1;
+			intptr_t maxOffset;
 
-			EASTL_DEV_ASSERT((A < 10000000) && (B < 10000000) && (curr < 10000000)); // Sanity check.
+			if(compare(*(base + hint), key)) // If base[hint] < key... gallop right until base[hint + lastOffset] < key <= base[hint + offset].
+			{
+				maxOffset = size - hint;
+
+				while((offset < maxOffset) && compare(*(base + hint + offset), key))
+				{
+					lastOffset = offset;
+					offset     = (offset << 1) + 1;
+				}
+
+				if(offset > maxOffset)
+					offset = maxOffset;
 
-			if(A < B) // If the first run is shorter than the second run... merge left.
+				lastOffset += hint;
+				offset     += hint;
+			}
+			else // Else key <= base[hint]... gallop left until base[hint - offset] < key <= base[hint - lastOffset].
 			{
-				// Copy to another location so we have room in the main array to put the sorted items.
-				eastl::copy(first + curr, first + curr + A, pBuffer);
+				maxOffset = hint + 1;
 
-				#if EASTL_DEV_DEBUG
-					typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+				while((offset < maxOffset) && !compare(*(base + hint - offset), key))
+				{
+					lastOffset = offset;
+					offset     = (offset << 1) + 1;
+				}
 
-					for(intptr_t i = 0; i < A; i++)
-						*(first + curr + i) = value_type();
-				#endif
+				if(offset > maxOffset)
+					offset = maxOffset;
 
-				intptr_t i = 0;
-				intptr_t j = curr + A;
-				
-				for(intptr_t k = curr; k < curr + A + B; k++)
+				const intptr_t temp = lastOffset;
+				lastOffset = hint - offset;
+				offset     = hint - temp;
+			}
+
+			// Now base[lastOffset] < key <= base[offset], where base[-1] is taken to be less than
+			// everything and base[size] greater. Binary search between them.
+			++lastOffset;
+
+			while(lastOffset < offset)
+			{
+				const intptr_t middle = lastOffset + ((offset - lastOffset) >> 1);
+
+				if(compare(*(base + middle), key))
+					lastOffset = middle + 1;
+				else
+					offset = middle;
+			}
+
+			return offset;
+		}
+
+
+		// tim_sort_gallop_right
+		//
+		// Like tim_sort_gallop_left, but returns the k such that base[0, k) <= key < base[k, size),
+		// which is where key goes if it is to be placed after the elements equal to it.
+		//
+		template <typename Iterator, typename T, typename StrictWeakOrdering>
+		intptr_t tim_sort_gallop_right(const T& key, Iterator base, const intptr_t size, const intptr_t hint, StrictWeakOrdering compare)
+		{
+			intptr_t lastOffset = 0;
+			intptr_t offset     = 1;
+			intptr_t maxOffset;
+
+			if(compare(key, *(base + hint))) // If key < base[hint]... gallop left until base[hint - offset] <= key < base[hint - lastOffset].
+			{
+				maxOffset = hint + 1;
+
+				while((offset < maxOffset) && compare(key, *(base + hint - offset)))
+				{
+					lastOffset = offset;
+					offset     = (offset << 1) + 1;
+				}
+
+				if(offset > maxOffset)
+					offset = maxOffset;
+
+				const intptr_t temp = lastOffset;
+				lastOffset = hint - offset;
+				offset     = hint - temp;
+			}
+			else // Else base[hint] <= key... gallop right until base[hint + lastOffset] <= key < base[hint + offset].
+			{
+				maxOffset = size - hint;
+
+				while((offset < maxOffset) && !compare(key, *(base + hint + offset)))
 				{
-					if((i < A) && (j < (curr + A + B)))
+					lastOffset = offset;
+					offset     = (offset << 1) + 1;
+				}
+
+				if(offset > maxOffset)
+					offset = maxOffset;
+
+				lastOffset += hint;
+				offset     += hint;
+			}
+
+			++lastOffset;
+
+			while(lastOffset < offset)
+			{
+				const intptr_t middle = lastOffset + ((offset - lastOffset) >> 1);
+
+				if(compare(key, *(base + middle)))
+					offset = middle;
+				else
+					lastOffset = middle + 1;
+			}
+
+			return offset;
+		}
+
+
+		// tim_sort_merge_lo
+		//
+		// Merges the run [a, a + nA) with the run of nB elements that follows it, where
+		// nA <= nB. A is moved to pBuffer and the array is filled from the front. The runs
+		// have been trimmed so that B[0] < A[0] and B[nB - 1] < A[nA - 1].
+		//
+		// Elements are merged one at a time until one run has won min_gallop times in a
+		// row, at which point the merge switches to galloping: each run is searched for
+		// where the other's head goes and everything before that is moved as a block.
+		// Galloping stops once neither run wins kTimSortMinGallop at a time. min_gallop
+		// goes down while galloping pays and back up when it stops paying, and carries
+		// over from one merge to the next, so data without long winning streaks soon
+		// stops trying.
+		//
+		template <typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
+		void tim_sort_merge_lo(RandomAccessIterator first, const intptr_t a, intptr_t nA, intptr_t nB, 
+							   T* pBuffer, intptr_t& min_gallop, StrictWeakOrdering compare)
+		{
+			intptr_t dest = a;        // The next output position.
+			intptr_t b    = a + nA;   // The head of B. dest + nA == b throughout.
+			T*       pA   = pBuffer;  // The head of A.
+			intptr_t aCount, bCount, k;
+
+			eastl::copy(first + a, first + b, pBuffer);
+
+			*(first + dest++) = *(first + b++);
+			if(--nB == 0)
+				goto done;
+			if(nA == 1)
+				goto copy_b;
+
+			for(;;)
+			{
+				aCount = bCount = 0;
+
+				for(;;)
+				{
+					if(compare(*(first + b), *pA)) // If B's head < A's head... (equal elements are taken from A, which is what keeps the sort stable)
 					{
-						if(!compare(*(first + j), *(pBuffer + i))) // If (first[j] >= pBuffer[i])...
-							*(first + k) = *(pBuffer + i++);
-						else
-							*(first + k) = *(first + j++);
+						*(first + dest++) = *(first + b++);
+						++bCount;
+						aCount = 0;
+						if(--nB == 0)
+							goto done;
+						if(bCount >= min_gallop)
+							break;
 					}
-					else if(i < A)
-						*(first + k) = *(pBuffer + i++);
 					else
-						*(first + k) = *(first + j++);
+					{
+						*(first + dest++) = *pA++;
+						++aCount;
+						bCount = 0;
+						if(--nA == 1)
+							goto copy_b;
+						if(aCount >= min_gallop)
+							break;
+					}
 				}
+
+				++min_gallop;
+
+				do
+				{
+					min_gallop -= (intptr_t)(min_gallop > 1);
+
+					aCount = k = tim_sort_gallop_right(*(first + b), pA, nA, 0, compare);
+					if(k)
+					{
+						eastl::copy(pA, pA + k, first + dest);
+						dest += k;
+						pA   += k;
+						nA   -= k;
+						if(nA == 1)
+							goto copy_b;
+						if(nA == 0) // This can only happen if compare is inconsistent.
+							goto done;
+					}
+					*(first + dest++) = *(first + b++);
+					if(--nB == 0)
+						goto done;
+
+					bCount = k = tim_sort_gallop_left(*pA, first + b, nB, 0, compare);
+					if(k)
+					{
+						eastl::copy(first + b, first + b + k, first + dest);
+						dest += k;
+						b    += k;
+						nB   -= k;
+						if(nB == 0)
+							goto done;
+					}
+					*(first + dest++) = *pA++;
+					if(--nA == 1)
+						goto copy_b;
+				} while((aCount >= kTimSortMinGallop) || (bCount >= kTimSortMinGallop));
+
+				++min_gallop; // Penalize leaving the galloping mode.
 			}
-			else // Else the second run is equal or shorter... merge right.
+
+		copy_b:
+			// The last element of A is greater than what remains of B.
+			eastl::copy(first + b, first + b + nB, first + dest);
+			*(first + dest + nB) = *pA;
+			return;
+
+		done:
+			eastl::copy(pA, pA + nA, first + dest);
+		}
+
+
+		// tim_sort_merge_hi
+		//
+		// The mirror image of tim_sort_merge_lo, for nA > nB: B is moved to pBuffer and the
+		// array is filled from the back.
+		//
+		template <typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
+		void tim_sort_merge_hi(RandomAccessIterator first, const intptr_t a, intptr_t nA, intptr_t nB, 
+							   T* pBuffer, intptr_t& min_gallop, StrictWeakOrdering compare)
+		{
+			intptr_t dest = a + nA + nB - 1; // The next output position.
+			intptr_t iA   = a + nA - 1;      // The tail of A. dest == iA + nB throughout.
+			intptr_t iB   = nB - 1;          // The tail of B, in pBuffer.
+			intptr_t aCount, bCount, k;
+
+			eastl::copy(first + a + nA, first + a + nA + nB, pBuffer);
+
+			*(first + dest--) = *(first + iA--);
+			if(--nA == 0)
+				goto done;
+			if(nB == 1)
+				goto copy_a;
+
+			for(;;)
 			{
-				eastl::copy(first + curr + A, first + curr + A + B, pBuffer);
+				aCount = bCount = 0;
 
-				intptr_t i = B - 1;
-				intptr_t j = curr + A - 1;
-				
-				for(intptr_t k = curr + A + B - 1; k >= curr; k--)
+				for(;;)
 				{
-					if((i >= 0) && (j >= curr))
+					if(compare(*(pBuffer + iB), *(first + iA))) // If B's tail < A's tail... (equal elements are taken from B, which is what keeps the sort stable)
 					{
-						if(compare(*(pBuffer + i), *(first + j))) // If (pBuffer[i] < first[j]) ...
-							*(first + k) = *(first + j--);
-						else
-							*(first + k) = *(pBuffer + i--);
+						*(first + dest--) = *(first + iA--);
+						++aCount;
+						bCount = 0;
+						if(--nA == 0)
+							goto done;
+						if(aCount >= min_gallop)
+							break;
 					}
-					else if(i >= 0)
-						*(first + k) = *(pBuffer + i--);
 					else
-						*(first + k) = *(first + j--);
+					{
+						*(first + dest--) = *(pBuffer + iB--);
+						++bCount;
+						aCount = 0;
+						if(--nB == 1)
+							goto copy_a;
+						if(bCount >= min_gallop)
+							break;
+					}
 				}
+
+				++min_gallop;
+
+				do
+				{
+					min_gallop -= (intptr_t)(min_gallop > 1);
+
+					aCount = k = nA - tim_sort_gallop_right(*(pBuffer + iB), first + a, nA, nA - 1, compare);
+					if(k)
+					{
+						dest -= k;
+						iA   -= k;
+						nA   -= k;
+						eastl::copyBackward(first + iA + 1, first + iA + 1 + k, first + dest + 1 + k);
+						if(nA == 0)
+							goto done;
+					}
+					*(first + dest--) = *(pBuffer + iB--);
+					if(--nB == 1)
+						goto copy_a;
+
+					bCount = k = nB - tim_sort_gallop_left(*(first + iA), pBuffer, nB, nB - 1, compare);
+					if(k)
+					{
+						dest -= k;
+						iB   -= k;
+						nB   -= k;
+						eastl::copy(pBuffer + iB + 1, pBuffer + iB + 1 + k, first + dest + 1);
+						if(nB == 1)
+							goto copy_a;
+						if(nB == 0) // This can only happen if compare is inconsistent.
+							goto done;
+					}
+					*(first + dest--) = *(first + iA--);
+					if(--nA == 0)
+						goto done;
+				} while((aCount >= kTimSortMinGallop) || (bCount >= kTimSortMinGallop));
+
+				++min_gallop;
 			}
+
+		copy_a:
+			// The first element of B is less than what remains of A.
+			eastl::copyBackward(first + a, first + a + nA, first + dest + 1);
+			*(first + a) = *pBuffer;
+			return;
+
+		done:
+			eastl::copy(pBuffer, pBuffer + nB, first + a);
+		}
+
+
+		// tim_sort_merge
+		//
+		// Merges the two runs on the top of run_stack. The elements at the start of the first run 
+		// that are not greater than the head of the second are already in place, as are the elements 
+		// at the end of the second run that are not less than the tail of the first. These are found
+		// by galloping, so that merging a long sorted run with a short one that falls near one end
+		// of it, or with runs that don't overlap at all, costs only a few comparisons plus the moves
+		// of the elements that actually interleave.
+		//
+		template <typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
+		void tim_sort_merge(RandomAccessIterator first, const tim_sort_run* run_stack, const intptr_t stack_curr, 
+							T* pBuffer, intptr_t& min_gallop, StrictWeakOrdering compare)
+		{
+			intptr_t A    = run_stack[stack_curr - 2].length;
+			intptr_t B    = run_stack[stack_curr - 1].length;
+			intptr_t curr = run_stack[stack_curr - 2].start;
+
+			EASTL_DEV_ASSERT((A < 10000000) && (B < 10000000) && (curr < 10000000)); // Sanity check.
+
+			const intptr_t k = tim_sort_gallop_right(*(first + curr + A), first + curr, A, 0, compare);
+
+			curr += k;
+			A    -= k;
+
+			if(A == 0)
+				return;
+
+			B = tim_sort_gallop_left(*(first + curr + A - 1), first + curr + A, B, B - 1, compare);
+
+			if(B == 0)
+				return;
+
+			if(A <= B) // If the first run is no longer than the second run... merge left.
+				tim_sort_merge_lo(first, curr, A, B, pBuffer, min_gallop, compare);
+			else       // Else the second run is shorter... merge right.
+				tim_sort_merge_hi(first, curr, A, B, pBuffer, min_gallop, compare);
 		}
 
 
@@ -1248,7 +2492,7 @@ namespace eastl
 
 		template <typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
 		intptr_t tim_sort_collapse(RandomAccessIterator first, tim_sort_run* run_stack, intptr_t stack_curr, 
-								   T* pBuffer, const intptr_t size, StrictWeakOrdering compare)
+								   T* pBuffer, const intptr_t size, intptr_t& min_gallop, StrictWeakOrdering compare)
 		{
 			// If the run_stack only has one thing on it, we are done with the collapse.
 			while(stack_curr > 1)
@@ -1256,7 +2500,7 @@ namespace eastl
 				// If this is the last merge, just do it.
 				if((stack_curr == 2) && ((run_stack[0].length + run_stack[1].length) == size))
 				{
-					tim_sort_merge(first, run_stack, stack_curr, pBuffer, compare);
+					tim_sort_merge(first, run_stack, stack_curr, pBuffer, min_gallop, compare);
 					run_stack[0].length += run_stack[1].length;
 					stack_curr--;
 
@@ -1269,7 +2513,7 @@ namespace eastl
 				// Check if the invariant is off for a run_stack of 2 elements.
 				else if((stack_curr == 2) && (run_stack[0].length <= run_stack[1].length))
 				{
-					tim_sort_merge(first, run_stack, stack_curr, pBuffer, compare);
+					tim_sort_merge(first, run_stack, stack_curr, pBuffer, min_gallop, compare);
 					run_stack[0].length += run_stack[1].length;
 					stack_curr--;
 
@@ -1290,7 +2534,7 @@ namespace eastl
 				{
 					if(A < C)
 					{
-						tim_sort_merge(first, run_stack, stack_curr - 1, pBuffer, compare);
+						tim_sort_merge(first, run_stack, stack_curr - 1, pBuffer, min_gallop, compare);
 
 						stack_curr--;
 						run_stack[stack_curr - 2].length += run_stack[stack_curr - 1].length;   // Merge A and B.
@@ -1304,7 +2548,7 @@ namespace eastl
 					}
 					else
 					{
-						tim_sort_merge(first, run_stack, stack_curr, pBuffer, compare);                  // Merge B and C.
+						tim_sort_merge(first, run_stack, stack_curr, pBuffer, min_gallop, compare);                  // Merge B and C.
 
 						stack_curr--;
 						run_stack[stack_curr - 1].length += run_stack[stack_curr].length;
@@ -1317,7 +2561,7 @@ namespace eastl
 				}
 				else if(B <= C) // Check second invariant
 				{
-					tim_sort_merge(first, run_stack, stack_curr, pBuffer, compare);
+					tim_sort_merge(first, run_stack, stack_curr, pBuffer, min_gallop, compare);
 
 					stack_curr--;
 					run_stack[stack_curr - 1].length += run_stack[stack_curr].length;       // Merge B and C.
@@ -1341,7 +2585,7 @@ namespace eastl
 		//
 		template <typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
 		bool tim_sort_add_run(tim_sort_run* run_stack, RandomAccessIterator first, T* pBuffer, const intptr_t size, const intptr_t minrun, 
-							  intptr_t& len, intptr_t& run, intptr_t& curr, intptr_t& stack_curr, StrictWeakOrdering compare)
+							  intptr_t& len, intptr_t& run, intptr_t& curr, intptr_t& stack_curr, intptr_t& min_gallop, StrictWeakOrdering compare)
 		{
 			len = tim_sort_count_run(first, curr, size, compare); // This will count the length of the run and reverse the run if it is backwards.
 			run = minrun;
@@ -1374,7 +2618,7 @@ namespace eastl
 			{
 				while(stack_curr > 1) // If there is any more than one run... (else all the data is sorted)
 				{
-					tim_sort_merge(first, run_stack, stack_curr, pBuffer, compare);
+					tim_sort_merge(first, run_stack, stack_curr, pBuffer, min_gallop, compare);
 
 					run_stack[stack_curr - 2].length += run_stack[stack_curr - 1].length;
 					stack_curr--;
@@ -1410,6 +2654,8 @@ namespace eastl
 	// Strengths:
 	//     - Fastest stable sort for most sizes of data.
 	//     - Fastest sort for containers of data already mostly sorted.
+	//     - Merges runs by galloping where they don't interleave much, so a sorted range with a batch of
+	//       new elements appended or scattered through it sorts in little more than linear time.
 	//     - Simpler to understand than quickSort.
 	//
 	// Weaknesses:
@@ -1445,26 +2691,27 @@ namespace eastl
 			intptr_t       stack_curr = 0;
 			intptr_t       len, run;
 			intptr_t       curr = 0;
+			intptr_t       min_gallop = kTimSortMinGallop;
 			const intptr_t minrun = timsort_compute_minrun(size);
 
 			#if EASTL_DEV_DEBUG
 				memset(run_stack, 0, sizeof(run_stack));
 			#endif
 
-			if(tim_sort_add_run(run_stack, first, pBuffer, size, minrun, len, run, curr, stack_curr, compare))
+			if(tim_sort_add_run(run_stack, first, pBuffer, size, minrun, len, run, curr, stack_curr, min_gallop, compare))
 				return;
-			if(tim_sort_add_run(run_stack, first, pBuffer, size, minrun, len, run, curr, stack_curr, compare))
+			if(tim_sort_add_run(run_stack, first, pBuffer, size, minrun, len, run, curr, stack_curr, min_gallop, compare))
 				return;
-			if(tim_sort_add_run(run_stack, first, pBuffer, size, minrun, len, run, curr, stack_curr, compare))
+			if(tim_sort_add_run(run_stack, first, pBuffer, size, minrun, len, run, curr, stack_curr, min_gallop, compare))
 				return;
 
 			for(;;)
 			{
 				if(timsort_check_invariant(run_stack, stack_curr))
-					stack_curr = tim_sort_collapse(first, run_stack, stack_curr, pBuffer, size, compare);
+					stack_curr = tim_sort_collapse(first, run_stack, stack_curr, pBuffer, size, min_gallop, compare);
 				else
 				{
-					if(tim_sort_add_run(run_stack, first, pBuffer, size, minrun, len, run, curr, stack_curr, compare))
+					if(tim_sort_add_run(run_stack, first, pBuffer, size, minrun, len, run, curr, stack_curr, min_gallop, compare))
 						break;
 				}
 			}
@@ -1601,16 +2848,37 @@ namespace eastl
 
 
 		// Generic version.
+		// A byte that is the same in every key doesn't affect the order, so its pass
+		// is skipped. We find those bytes by or'ing together each key xor'd with the
+		// first key; countr_zero and bit_width of that give the range of bytes that differ.
+		// The result ends up where running every pass would have put it.
 		template <typename RandomAccessIterator, typename ExtractKey, typename IntegerType>
 		void radixSort_impl(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator buffer, ExtractKey extractKey, IntegerType)
 		{
+			typedef typename eastl::make_unsigned<IntegerType>::type UnsignedType;
+
 			uint32_t EASTL_PREFIX_ALIGN(EASTL_PLATFORM_PREFERRED_ALIGNMENT) bucketSize[256];       // The alignment of this variable isn't required; it merely 
 			uint32_t EASTL_PREFIX_ALIGN(EASTL_PLATFORM_PREFERRED_ALIGNMENT) bucketPosition[256];   // allows the code below to be faster on some platforms.
 			RandomAccessIterator temp;
 			uint32_t i;
+			UnsignedType diff = 0;
+			bool bInBuffer = false;
+
+			if(first != last)
+			{
+				const UnsignedType firstKey = (UnsignedType)extractKey(*first);
 
-			for(uint32_t j = 0; j < (8 * sizeof(IntegerType)); j += 8)
+				for(temp = first; temp != last; ++temp)
+					diff |= (UnsignedType)((UnsignedType)extractKey(*temp) ^ firstKey);
+			}
+
+			const uint32_t jEnd = (uint32_t)eastl::bit_width(diff);
+
+			for(uint32_t j = (uint32_t)eastl::countr_zero(diff) & ~7u; j < jEnd; j += 8)
 			{
+				if(((diff >> j) & 0xff) == 0)
+					continue;
+
 				memset(bucketSize, 0, sizeof(bucketSize));
 
 				for(temp = first; temp != last; ++temp)
@@ -1630,7 +2898,11 @@ namespace eastl
 				temp   = first;
 				first  = buffer;
 				buffer = temp; 
+				bInBuffer = !bInBuffer;
 			}
+
+			if(bInBuffer != ((sizeof(IntegerType) & 1) != 0))
+				eastl::copy(first, last, buffer);
 		}
 	} // namespace Internal
 
@@ -0,0 +1,734 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements string_pool, which interns strings: each distinct
+// string is stored once, in arena pages owned by the pool, and is identified
+// by an interned_string handle or by a 32 bit atom.
+//
+// Two handles from the same pool are equal if and only if their strings are
+// equal, so comparing and hashing them is a pointer or integer operation no
+// matter how long the strings are. A hash_map<interned_string, T> thus looks
+// up as fast as a hash_map<uint32_t, T>, and stores 8 bytes per key instead
+// of a whole string.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_STRING_POOL_H
+#define EASTL_STRING_POOL_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/internal/thread_support.h>
+#include <eastl/bit.h>
+#include <eastl/allocator.h>
+#include <eastl/functional.h>
+#include <eastl/string.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+	#include <string.h>
+	#pragma warning(pop)
+#else
+	#include <string.h>
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_STRING_POOL_DEFAULT_NAME
+	///
+	/// Defines a default container name in the absence of a user-provided name.
+	///
+	#ifndef EASTL_STRING_POOL_DEFAULT_NAME
+		#define EASTL_STRING_POOL_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " string_pool" // Unless the user overrides something, this is "EASTL string_pool".
+	#endif
+
+
+	/// EASTL_STRING_POOL_DEFAULT_ALLOCATOR
+	///
+	#ifndef EASTL_STRING_POOL_DEFAULT_ALLOCATOR
+		#define EASTL_STRING_POOL_DEFAULT_ALLOCATOR allocator_type(EASTL_STRING_POOL_DEFAULT_NAME)
+	#endif
+
+
+	/// EASTL_STRING_POOL_DEFAULT_PAGE_SIZE
+	///
+	/// The size of the arena pages strings are stored in. Strings longer than a
+	/// quarter of this get a page of their own.
+	///
+	#ifndef EASTL_STRING_POOL_DEFAULT_PAGE_SIZE
+		#define EASTL_STRING_POOL_DEFAULT_PAGE_SIZE 16384
+	#endif
+
+
+
+	namespace Internal
+	{
+		/// string_pool_entry
+		///
+		/// Precedes each interned string's characters in the arena. The
+		/// characters are followed by a 0, so that they can be used as a C string.
+		///
+		struct string_pool_entry
+		{
+			uint32_t mnSize;
+			uint32_t mnAtom;
+			uint32_t mnHash;
+		};
+
+		inline const string_pool_entry* string_pool_get_entry(const char* p)
+			{ return reinterpret_cast<const string_pool_entry*>(p - sizeof(string_pool_entry)); }
+
+
+		/// string_pool_hash
+		///
+		/// Hashes 8 bytes at a time, as interning is dominated by hashing the
+		/// input when the string is already present.
+		///
+		inline uint64_t string_pool_hash(const char* p, size_t n)
+		{
+			const uint64_t kMul = UINT64_C(0x9E3779B97F4A7C15);
+			uint64_t       h    = UINT64_C(0xcbf29ce484222325) ^ ((uint64_t)n * kMul);
+			uint64_t       w;
+
+			for(; n >= 8; p += 8, n -= 8)
+			{
+				memcpy(&w, p, 8);
+				h = (h ^ w) * kMul;
+				h ^= h >> 29;
+			}
+
+			if(n)
+			{
+				w = 0;
+				memcpy(&w, p, n);
+				h = (h ^ w) * kMul;
+			}
+
+			h ^= h >> 32;
+			h *= UINT64_C(0xff51afd7ed558ccd);
+			h ^= h >> 29;
+			return h;
+		}
+
+	} // namespace Internal
+
+
+
+	/// interned_string
+	///
+	/// A handle to a string in a string_pool. It is the size of a pointer and is
+	/// valid until the pool is cleared or destroyed. A default constructed
+	/// handle refers to no string; it is not equal to the handle of "".
+	///
+	/// Comparison and hashing are O(1). operator< orders by atom, which is an
+	/// arbitrary but consistent order; compare c_str() for alphabetical order.
+	///
+	class interned_string
+	{
+	public:
+		typedef uint32_t atom_type;
+
+		static const atom_type kInvalidAtom = 0xffffffff;
+
+	public:
+		interned_string() EASTL_NOEXCEPT
+			: mpData(NULL) { }
+
+		explicit interned_string(const char* pInterned) EASTL_NOEXCEPT
+			: mpData(pInterned) { }
+
+		bool        valid() const EASTL_NOEXCEPT  { return (mpData != NULL); }
+		const char* c_str() const EASTL_NOEXCEPT  { return mpData ? mpData : ""; }
+		const char* data() const EASTL_NOEXCEPT   { return c_str(); }
+		size_t      size() const EASTL_NOEXCEPT   { return mpData ? Internal::string_pool_get_entry(mpData)->mnSize : 0; }
+		size_t      length() const EASTL_NOEXCEPT { return size(); }
+		bool        empty() const EASTL_NOEXCEPT  { return (size() == 0); }
+
+		/// Returns the string's atom, a small integer unique within its pool.
+		atom_type atom() const EASTL_NOEXCEPT
+			{ return mpData ? Internal::string_pool_get_entry(mpData)->mnAtom : kInvalidAtom; }
+
+		/// Returns the hash of the string's characters, which was computed when it was interned.
+		uint32_t string_hash() const EASTL_NOEXCEPT
+			{ return mpData ? Internal::string_pool_get_entry(mpData)->mnHash : 0; }
+
+		bool operator==(const interned_string& x) const EASTL_NOEXCEPT { return (mpData == x.mpData); }
+		bool operator!=(const interned_string& x) const EASTL_NOEXCEPT { return (mpData != x.mpData); }
+		bool operator< (const interned_string& x) const EASTL_NOEXCEPT { return (atom() < x.atom()); }
+
+	protected:
+		const char* mpData;
+
+	}; // class interned_string
+
+
+	template <typename T> struct hash;
+
+	template <>
+	struct hash<interned_string>
+	{
+		size_t operator()(const interned_string& x) const
+			{ return (size_t)x.atom(); } // Atoms are dense and distinct, like the integers hash<int> returns as is.
+	};
+
+
+
+	/// string_pool
+	///
+	/// Interns strings and hands out interned_string handles and atoms for them.
+	///
+	/// Strings are stored in pages of EASTL_STRING_POOL_DEFAULT_PAGE_SIZE bytes
+	/// with 12 bytes of overhead each, and the lookup table and the atom pages
+	/// add another 40 to 80 bytes per string. Strings are never freed individually; clear frees
+	/// them all, invalidating every handle.
+	///
+	/// string_pool is thread-safe. The strings are divided by hash among
+	/// nShardCount shards, each with its own mutex, lookup table and pages, so
+	/// threads interning different strings rarely contend. Looking up an atom
+	/// never locks. Once all the strings are present, freeze makes intern and
+	/// find lock-free too, at the cost of no longer being able to add strings.
+	/// The allocator must be thread-safe if the pool is used by several threads.
+	///
+	/// Atoms are dense per shard: the nth string added to shard s has atom
+	/// (n * nShardCount + s). With nShardCount = 1 they are simply 0, 1, 2, ...
+	/// in the order the strings were added.
+	///
+	/// Example usage:
+	///     string_pool<> identifiers;
+	///
+	///     interned_string name = identifiers.intern(pToken, nTokenLength);
+	///     hash_map<interned_string, Symbol*>::iterator it = symbols.find(name); // Hashes and compares an integer.
+	///
+	///     identifiers.freeze(); // Before starting the reader threads.
+	///
+	template <typename Allocator = EASTLAllocatorType, size_t nShardCount = 16>
+	class string_pool
+	{
+		static_assert((nShardCount != 0) && ((nShardCount & (nShardCount - 1)) == 0), "string_pool: nShardCount must be a power of two.");
+		static_assert(nShardCount <= 64, "string_pool: nShardCount must be at most 64, as the shard is chosen by the top 6 bits of the hash.");
+
+	public:
+		typedef string_pool<Allocator, nShardCount>  this_type;
+		typedef interned_string::atom_type           atom_type;
+		typedef eastl_size_t                         size_type;
+		typedef Allocator                            allocator_type;
+
+		static const atom_type kInvalidAtom = interned_string::kInvalidAtom;
+
+	public:
+		string_pool(const allocator_type& allocator = EASTL_STRING_POOL_DEFAULT_ALLOCATOR);
+		string_pool(size_type nPageSize, const allocator_type& allocator = EASTL_STRING_POOL_DEFAULT_ALLOCATOR);
+	   ~string_pool();
+
+		const allocator_type& getAllocator() const EASTL_NOEXCEPT { return mAllocator; }
+		allocator_type&       getAllocator() EASTL_NOEXCEPT       { return mAllocator; }
+
+		/// intern
+		/// Returns the handle of the string, adding it if it isn't present.
+		/// Must not be called to add a string to a frozen pool.
+		interned_string intern(const char* p, size_type n);
+		interned_string intern(const char* p);
+
+		template <typename A>
+		interned_string intern(const basicString<char, A>& s)
+			{ return intern(s.data(), (size_type)s.size()); }
+
+		/// find
+		/// Returns the handle of the string, or an invalid handle if it isn't present.
+		interned_string find(const char* p, size_type n) const;
+		interned_string find(const char* p) const;
+
+		template <typename A>
+		interned_string find(const basicString<char, A>& s) const
+			{ return find(s.data(), (size_type)s.size()); }
+
+		/// get
+		/// Returns the handle for an atom returned by this pool. Never locks.
+		interned_string get(atom_type atom) const;
+
+		/// freeze
+		/// Makes intern and find lock-free, after which strings can no longer be
+		/// added. The pool must not be in use by other threads during the call,
+		/// and they must be synchronized with it afterwards, such as by being
+		/// started after it.
+		void freeze()                      { mbFrozen = true; }
+		bool frozen() const EASTL_NOEXCEPT { return mbFrozen; }
+
+		size_type size() const;
+		size_type memory_usage() const; // Returns the bytes allocated for strings, tables and atom pages.
+
+		/// clear
+		/// Removes all strings, invalidating every handle, and unfreezes the pool.
+		/// The pool must not be in use by other threads during the call.
+		void clear();
+
+		bool validate() const;
+
+	protected:
+		enum
+		{
+			kFirstAtomPageShift = 10,   // The first atom page of a shard holds 1024 strings, and each page after it twice as many as the one before.
+			kAtomPageCount      = 22    // Enough for 2^32 atoms.
+		};
+
+		struct page
+		{
+			page*  mpNext;
+			size_t mnSize;
+		};
+
+		struct slot
+		{
+			const char* mpData;         // NULL if the slot is empty.
+			uint32_t    mnHash;
+			uint32_t    mnSize;
+		};
+
+		struct shard
+		{
+			slot*                   mpSlots;
+			size_t                  mnSlotMask;      // Slot count - 1, or 0 if mpSlots is NULL.
+			size_t                  mnCount;
+			page*                   mpPages;         // The current page is the first.
+			char*                   mpPageCurrent;
+			char*                   mpPageEnd;
+			size_t                  mnPageBytes;
+			const char**            mpAtomPages[kAtomPageCount];
+			mutable Internal::mutex mMutex;
+			char                    mPad[EA_CACHE_LINE_SIZE]; // Keeps adjacent shards' mutexes off the same cache line.
+		};
+
+		shard          mShards[nShardCount];
+		size_type      mnPageSize;
+		bool           mbFrozen;
+		allocator_type mAllocator;
+
+		static shard& DoGetShard(const this_type* pThis, uint64_t h)
+			{ return const_cast<shard&>(pThis->mShards[(size_t)(h >> 58) & (nShardCount - 1)]); } // The table uses the low bits.
+
+		static const char* DoFind(const shard& s, uint64_t h, const char* p, size_type n);
+
+		const char* DoAdd(shard& s, size_t nShard, uint64_t h, const char* p, size_type n);
+		void        DoGrow(shard& s);
+		char*       DoAllocateString(shard& s, size_t nBytes);
+		void        DoClearShard(shard& s);
+
+		static void DoGetAtomLocation(uint32_t nIndex, size_t& nPage, size_t& nOffset);
+
+	private:
+		#if defined(EA_COMPILER_NO_DELETED_FUNCTIONS)
+			string_pool(const this_type&);
+			void operator=(const this_type&);
+		#else
+			string_pool(const this_type&) = delete;
+			void operator=(const this_type&) = delete;
+		#endif
+
+	}; // class string_pool
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// string_pool
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename A, size_t nShardCount>
+	inline string_pool<A, nShardCount>::string_pool(const allocator_type& allocator)
+		: mnPageSize(EASTL_STRING_POOL_DEFAULT_PAGE_SIZE), mbFrozen(false), mAllocator(allocator)
+	{
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			shard& s = mShards[i];
+			s.mpSlots       = NULL;
+			s.mnSlotMask    = 0;
+			s.mnCount       = 0;
+			s.mpPages       = NULL;
+			s.mpPageCurrent = NULL;
+			s.mpPageEnd     = NULL;
+			s.mnPageBytes   = 0;
+			memset(s.mpAtomPages, 0, sizeof(s.mpAtomPages));
+		}
+	}
+
+
+	template <typename A, size_t nShardCount>
+	inline string_pool<A, nShardCount>::string_pool(size_type nPageSize, const allocator_type& allocator)
+		: mnPageSize(nPageSize), mbFrozen(false), mAllocator(allocator)
+	{
+		EASTL_ASSERT(nPageSize >= 256);
+
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			shard& s = mShards[i];
+			s.mpSlots       = NULL;
+			s.mnSlotMask    = 0;
+			s.mnCount       = 0;
+			s.mpPages       = NULL;
+			s.mpPageCurrent = NULL;
+			s.mpPageEnd     = NULL;
+			s.mnPageBytes   = 0;
+			memset(s.mpAtomPages, 0, sizeof(s.mpAtomPages));
+		}
+	}
+
+
+	template <typename A, size_t nShardCount>
+	inline string_pool<A, nShardCount>::~string_pool()
+	{
+		for(size_t i = 0; i < nShardCount; ++i)
+			DoClearShard(mShards[i]);
+	}
+
+
+	template <typename A, size_t nShardCount>
+	inline void string_pool<A, nShardCount>::DoGetAtomLocation(uint32_t nIndex, size_t& nPage, size_t& nOffset)
+	{
+		// Page k holds the indexes [1024 * (2^k - 1), 1024 * (2^(k+1) - 1)).
+		const uint64_t i = (uint64_t)nIndex + (1u << kFirstAtomPageShift);
+
+		const size_t nBit = (size_t)(eastl::bit_width(i) - 1);
+
+		nPage   = nBit - kFirstAtomPageShift;
+		nOffset = (size_t)(i - (UINT64_C(1) << nBit));
+	}
+
+
+	template <typename A, size_t nShardCount>
+	inline const char* string_pool<A, nShardCount>::DoFind(const shard& s, uint64_t h, const char* p, size_type n)
+	{
+		if(!s.mpSlots)
+			return NULL;
+
+		const uint32_t h32 = (uint32_t)h;
+
+		for(size_t i = (size_t)h & s.mnSlotMask; s.mpSlots[i].mpData; i = (i + 1) & s.mnSlotMask)
+		{
+			const slot& sl = s.mpSlots[i];
+
+			if((sl.mnHash == h32) && (sl.mnSize == n) && (memcmp(sl.mpData, p, n) == 0))
+				return sl.mpData;
+		}
+
+		return NULL;
+	}
+
+
+	template <typename A, size_t nShardCount>
+	void string_pool<A, nShardCount>::DoGrow(shard& s)
+	{
+		// Linear probing with a load factor of at most 1/2.
+		const size_t nOldCount = s.mpSlots ? (s.mnSlotMask + 1) : 0;
+		const size_t nNewCount = nOldCount ? (nOldCount * 2) : 64;
+		slot* const  pNew      = (slot*)allocate_memory(mAllocator, nNewCount * sizeof(slot), EASTL_ALIGN_OF(slot), 0);
+		EASTL_ASSERT(pNew != NULL);
+
+		memset(pNew, 0, nNewCount * sizeof(slot));
+
+		for(size_t i = 0; i < nOldCount; ++i)
+		{
+			if(s.mpSlots[i].mpData)
+			{
+				size_t j = (size_t)s.mpSlots[i].mnHash & (nNewCount - 1);
+				while(pNew[j].mpData)
+					j = (j + 1) & (nNewCount - 1);
+				pNew[j] = s.mpSlots[i];
+			}
+		}
+
+		if(s.mpSlots)
+			EASTLFree(mAllocator, s.mpSlots, nOldCount * sizeof(slot));
+
+		s.mpSlots    = pNew;
+		s.mnSlotMask = nNewCount - 1;
+	}
+
+
+	template <typename A, size_t nShardCount>
+	char* string_pool<A, nShardCount>::DoAllocateString(shard& s, size_t nBytes)
+	{
+		nBytes = (nBytes + (EASTL_ALIGN_OF(Internal::string_pool_entry) - 1)) & ~(size_t)(EASTL_ALIGN_OF(Internal::string_pool_entry) - 1);
+
+		if((size_t)(s.mpPageEnd - s.mpPageCurrent) < nBytes)
+		{
+			// Long strings get their own page, placed behind the current one so that it stays current.
+			const bool   bOwnPage = (nBytes > (mnPageSize / 4));
+			const size_t nSize    = sizeof(page) + (bOwnPage ? nBytes : mnPageSize);
+			page* const  pPage    = (page*)allocate_memory(mAllocator, nSize, EASTL_ALIGN_OF(page), 0);
+			EASTL_ASSERT(pPage != NULL);
+
+			pPage->mnSize  = nSize;
+			s.mnPageBytes += nSize;
+
+			if(bOwnPage && s.mpPages)
+			{
+				pPage->mpNext       = s.mpPages->mpNext;
+				s.mpPages->mpNext   = pPage;
+				return (char*)(pPage + 1);
+			}
+
+			pPage->mpNext   = s.mpPages;
+			s.mpPages       = pPage;
+			s.mpPageCurrent = (char*)(pPage + 1);
+			s.mpPageEnd     = (char*)pPage + nSize;
+		}
+
+		char* const pResult = s.mpPageCurrent;
+		s.mpPageCurrent += nBytes;
+		return pResult;
+	}
+
+
+	template <typename A, size_t nShardCount>
+	const char* string_pool<A, nShardCount>::DoAdd(shard& s, size_t nShard, uint64_t h, const char* p, size_type n)
+	{
+		EASTL_ASSERT(n < 0xffffffff);
+
+		const uint32_t nIndex = (uint32_t)s.mnCount;
+		const uint64_t nAtom  = ((uint64_t)nIndex * nShardCount) + nShard;
+		EASTL_ASSERT(nAtom < kInvalidAtom);
+
+		size_t nPage, nOffset;
+		DoGetAtomLocation(nIndex, nPage, nOffset);
+
+		if(!s.mpAtomPages[nPage])
+		{
+			const size_t nPageCount = (size_t)1 << (nPage + kFirstAtomPageShift);
+			s.mpAtomPages[nPage] = (const char**)allocate_memory(mAllocator, nPageCount * sizeof(const char*), EASTL_ALIGN_OF(const char*), 0);
+			EASTL_ASSERT(s.mpAtomPages[nPage] != NULL);
+		}
+
+		if((s.mnCount + 1) * 2 > (s.mpSlots ? (s.mnSlotMask + 1) : 0))
+			DoGrow(s);
+
+		char* const                      pEntry = DoAllocateString(s, sizeof(Internal::string_pool_entry) + n + 1);
+		Internal::string_pool_entry* const pHeader = reinterpret_cast<Internal::string_pool_entry*>(pEntry);
+		char* const                      pData  = pEntry + sizeof(Internal::string_pool_entry);
+
+		pHeader->mnSize = (uint32_t)n;
+		pHeader->mnAtom = (uint32_t)nAtom;
+		pHeader->mnHash = (uint32_t)(h >> 32);
+		memcpy(pData, p, n);
+		pData[n] = 0;
+
+		size_t i = (size_t)h & s.mnSlotMask;
+		while(s.mpSlots[i].mpData)
+			i = (i + 1) & s.mnSlotMask;
+
+		s.mpSlots[i].mpData = pData;
+		s.mpSlots[i].mnHash = (uint32_t)h;
+		s.mpSlots[i].mnSize = (uint32_t)n;
+
+		s.mpAtomPages[nPage][nOffset] = pData;
+		++s.mnCount;
+
+		return pData;
+	}
+
+
+	template <typename A, size_t nShardCount>
+	interned_string string_pool<A, nShardCount>::intern(const char* p, size_type n)
+	{
+		const uint64_t h = Internal::string_pool_hash(p, n);
+		shard&         s = DoGetShard(this, h);
+
+		if(mbFrozen)
+		{
+			const char* const pData = DoFind(s, h, p, n);
+			#if EASTL_ASSERT_ENABLED
+				if(!pData)
+					EASTL_FAIL_MSG("string_pool::intern: strings can't be added to a frozen pool.");
+			#endif
+			return interned_string(pData);
+		}
+
+		Internal::auto_mutex lock(s.mMutex);
+
+		const char* const pData = DoFind(s, h, p, n);
+		if(pData)
+			return interned_string(pData);
+
+		return interned_string(DoAdd(s, (size_t)(&s - mShards), h, p, n));
+	}
+
+
+	template <typename A, size_t nShardCount>
+	inline interned_string string_pool<A, nShardCount>::intern(const char* p)
+	{
+		return intern(p, (size_type)strlen(p));
+	}
+
+
+	template <typename A, size_t nShardCount>
+	interned_string string_pool<A, nShardCount>::find(const char* p, size_type n) const
+	{
+		const uint64_t h = Internal::string_pool_hash(p, n);
+		const shard&   s = DoGetShard(this, h);
+
+		if(mbFrozen)
+			return interned_string(DoFind(s, h, p, n));
+
+		Internal::auto_mutex lock(s.mMutex);
+		return interned_string(DoFind(s, h, p, n));
+	}
+
+
+	template <typename A, size_t nShardCount>
+	inline interned_string string_pool<A, nShardCount>::find(const char* p) const
+	{
+		return find(p, (size_type)strlen(p));
+	}
+
+
+	template <typename A, size_t nShardCount>
+	inline interned_string string_pool<A, nShardCount>::get(atom_type atom) const
+	{
+		// The atom pages never move, and the caller must have been synchronized with
+		// the thread that created the atom in order to have it, so no lock is needed.
+		// The shard's mnCount isn't checked, as a concurrent intern may be changing it.
+		size_t nPage, nOffset;
+		DoGetAtomLocation(atom / nShardCount, nPage, nOffset);
+
+		const shard& s = mShards[atom & (nShardCount - 1)];
+		EASTL_ASSERT(s.mpAtomPages[nPage] != NULL);
+
+		return interned_string(s.mpAtomPages[nPage][nOffset]);
+	}
+
+
+	template <typename A, size_t nShardCount>
+	typename string_pool<A, nShardCount>::size_type
+	string_pool<A, nShardCount>::size() const
+	{
+		size_type n = 0;
+
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			Internal::auto_mutex lock(mShards[i].mMutex);
+			n += (size_type)mShards[i].mnCount;
+		}
+
+		return n;
+	}
+
+
+	template <typename A, size_t nShardCount>
+	typename string_pool<A, nShardCount>::size_type
+	string_pool<A, nShardCount>::memory_usage() const
+	{
+		size_type n = 0;
+
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			const shard& s = mShards[i];
+			Internal::auto_mutex lock(s.mMutex);
+
+			n += (size_type)s.mnPageBytes;
+			if(s.mpSlots)
+				n += (size_type)((s.mnSlotMask + 1) * sizeof(slot));
+			for(size_t j = 0; (j < kAtomPageCount) && s.mpAtomPages[j]; ++j)
+				n += (size_type)(((size_t)1 << (j + kFirstAtomPageShift)) * sizeof(const char*));
+		}
+
+		return n;
+	}
+
+
+	template <typename A, size_t nShardCount>
+	void string_pool<A, nShardCount>::DoClearShard(shard& s)
+	{
+		for(page* pPage = s.mpPages; pPage; )
+		{
+			page* const pNext = pPage->mpNext;
+			EASTLFree(mAllocator, pPage, pPage->mnSize);
+			pPage = pNext;
+		}
+
+		if(s.mpSlots)
+			EASTLFree(mAllocator, s.mpSlots, (s.mnSlotMask + 1) * sizeof(slot));
+
+		for(size_t j = 0; j < kAtomPageCount; ++j)
+		{
+			if(s.mpAtomPages[j])
+				EASTLFree(mAllocator, s.mpAtomPages[j], ((size_t)1 << (j + kFirstAtomPageShift)) * sizeof(const char*));
+			s.mpAtomPages[j] = NULL;
+		}
+
+		s.mpSlots       = NULL;
+		s.mnSlotMask    = 0;
+		s.mnCount       = 0;
+		s.mpPages       = NULL;
+		s.mpPageCurrent = NULL;
+		s.mpPageEnd     = NULL;
+		s.mnPageBytes   = 0;
+	}
+
+
+	template <typename A, size_t nShardCount>
+	void string_pool<A, nShardCount>::clear()
+	{
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			Internal::auto_mutex lock(mShards[i].mMutex);
+			DoClearShard(mShards[i]);
+		}
+
+		mbFrozen = false;
+	}
+
+
+	template <typename A, size_t nShardCount>
+	bool string_pool<A, nShardCount>::validate() const
+	{
+		for(size_t i = 0; i < nShardCount; ++i)
+		{
+			const shard& s = mShards[i];
+			Internal::auto_mutex lock(s.mMutex);
+
+			size_t nFound = 0;
+
+			for(size_t j = 0; s.mpSlots && (j <= s.mnSlotMask); ++j)
+			{
+				const slot& sl = s.mpSlots[j];
+
+				if(sl.mpData)
+				{
+					const Internal::string_pool_entry* const pEntry = Internal::string_pool_get_entry(sl.mpData);
+					const uint64_t                           h      = Internal::string_pool_hash(sl.mpData, sl.mnSize);
+
+					if((pEntry->mnSize != sl.mnSize) || (sl.mpData[sl.mnSize] != 0) || ((uint32_t)h != sl.mnHash) || (pEntry->mnHash != (uint32_t)(h >> 32)))
+						return false;
+
+					if((&DoGetShard(this, h) != &s) || ((pEntry->mnAtom & (nShardCount - 1)) != i) || ((pEntry->mnAtom / nShardCount) >= s.mnCount))
+						return false;
+
+					size_t nPage, nOffset;
+					DoGetAtomLocation(pEntry->mnAtom / nShardCount, nPage, nOffset);
+					if(s.mpAtomPages[nPage][nOffset] != sl.mpData)
+						return false;
+
+					++nFound;
+				}
+			}
+
+			if(nFound != s.mnCount)
+				return false;
+		}
+
+		return true;
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,527 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements string_sort and string_stable_sort, which sort arrays
+// of strings without comparing whole strings. A comparison sort compares
+// O(n log n) pairs of strings, and each comparison scans the prefix the two
+// have in common again, which for strings such as URLs or paths is most of
+// them. These sorts instead look at one character position at a time, and
+// at each character of each string about once:
+//
+//    - MSD (most significant digit first) radix sort distributes the strings
+//      by their character at the current depth into 257 buckets (one for the
+//      strings that end there), then sorts each bucket at the next depth.
+//      This is used for byte-wide characters while the range is large.
+//    - Multikey quicksort (Bentley and Sedgewick, "Fast Algorithms for Sorting
+//      and Searching Strings") partitions by the character at the current depth
+//      into less, equal and greater parts, and sorts the equal part at the next
+//      depth. This is used for small buckets and for wider characters.
+//    - Insertion sort finishes the smallest partitions, comparing from the
+//      current depth on, as the strings are known to agree before it.
+//
+// Strings are ordered by the unsigned values of their characters, shorter
+// strings first among those that agree up to the length of the shorter, which
+// is the order of basicString's operator< and of strcmp.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_STRING_SORT_H
+#define EASTL_STRING_SORT_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/allocator.h>
+#include <eastl/bit.h>
+#include <eastl/iterator.h>
+#include <eastl/memory.h>
+#include <eastl/sort.h>
+#include <eastl/type_traits.h>
+#include <eastl/utility.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// EASTL_STRING_SORT_DEFAULT_NAME
+	///
+	/// Defines a default allocation name in the absence of a user-provided allocator.
+	///
+	#ifndef EASTL_STRING_SORT_DEFAULT_NAME
+		#define EASTL_STRING_SORT_DEFAULT_NAME EASTL_DEFAULT_NAME_PREFIX " string_sort" // Unless the user overrides something, this is "EASTL string_sort".
+	#endif
+
+
+
+	/// string_sort_traits
+	///
+	/// Tells string_sort how to read the characters of an element. The default
+	/// handles any class with a value_type and data() and length() members, which
+	/// covers basicString (string, wstring, string16, string32), fixedString and
+	/// fixed_substring. The pointer specializations handle C strings of any
+	/// character width. Users may specialize this for their own string types.
+	///
+	template <typename String>
+	struct string_sort_traits
+	{
+		typedef typename String::value_type char_type;
+
+		static const char_type* data(const String& s)
+			{ return s.data(); }
+
+		static size_t length(const String& s)
+			{ return (size_t)s.length(); }
+	};
+
+	template <typename Char>
+	struct string_sort_traits<Char*>
+	{
+		typedef typename eastl::remove_const<Char>::type char_type;
+
+		static const char_type* data(const char_type* p)
+			{ return p; }
+
+		static size_t length(const char_type* p)
+		{
+			const char_type* pEnd = p;
+			while(*pEnd)
+				++pEnd;
+			return (size_t)(pEnd - p);
+		}
+	};
+
+
+
+	namespace Internal
+	{
+		static const size_t kStringSortInsertionLimit = 16;   // Partitions of at most this size are insertion sorted.
+		static const size_t kStringSortRadixLimit     = 4096; // Buckets smaller than this are sorted with multikey quicksort.
+
+		template <size_t nCharSize>
+		struct string_sort_code;
+
+		template <>
+		struct string_sort_code<1> { typedef uint8_t unsigned_type; };
+
+		template <>
+		struct string_sort_code<2> { typedef uint16_t unsigned_type; };
+
+		template <>
+		struct string_sort_code<4> { typedef uint32_t unsigned_type; };
+
+
+		// The strings are sorted as an array of these, and the elements are moved to
+		// their places once at the end. mnIndex is the element's original position.
+		//
+		// Reading a string's characters is a cache miss, so rather than reading one
+		// character at a time, as many as fit in 64 bits are read at once and kept in
+		// mnCache, most significant first, with zeroes past the end of the string.
+		// Comparing caches orders strings correctly except for ties, as a string that
+		// ends looks the same as one that goes on with zeroes; ties are broken by the
+		// following characters and, once the strings have all ended, by their lengths.
+		template <typename Char>
+		struct string_sort_entry
+		{
+			static const size_t kChunk = (8 / sizeof(Char)); // The number of characters per cache.
+
+			uint64_t    mnCache;
+			const Char* mpData;
+			size_t      mnLength;
+			size_t      mnIndex;
+		};
+
+
+		// Returns the characters [d, d + kChunk) of a string as a cache.
+		template <typename Char>
+		EASTL_FORCE_INLINE uint64_t StringSortLoad(const Char* pData, size_t nLength, size_t d)
+		{
+			typedef typename string_sort_code<sizeof(Char)>::unsigned_type unsigned_type;
+
+			const size_t kChunk = string_sort_entry<Char>::kChunk;
+
+			if((sizeof(Char) == 1) && ((d + kChunk) <= nLength))
+			{
+				uint64_t n;
+				memcpy(&n, pData + d, sizeof(n));
+
+				#if defined(EA_SYSTEM_LITTLE_ENDIAN)
+					n = eastl::byteswap(n);
+				#endif
+
+				return n;
+			}
+
+			uint64_t n = 0;
+
+			for(size_t i = 0; i < kChunk; ++i)
+				n = (n << (sizeof(Char) * 8)) | (((d + i) < nLength) ? (uint64_t)(unsigned_type)pData[d + i] : 0);
+
+			return n;
+		}
+
+
+		template <bool bStable>
+		struct string_sort_length_less
+		{
+			template <typename Char>
+			bool operator()(const string_sort_entry<Char>& a, const string_sort_entry<Char>& b) const
+				{ return (a.mnLength < b.mnLength) || (bStable && (a.mnLength == b.mnLength) && (a.mnIndex < b.mnIndex)); }
+		};
+
+
+		// Moves on to depth d for strings that agree before it. If they have all ended, they
+		// are equal but for their lengths and are sorted by length; otherwise their caches are
+		// loaded from d. Returns true if there is more sorting to do.
+		template <typename Char, bool bStable>
+		bool StringSortAdvance(string_sort_entry<Char>* pEntries, size_t n, size_t d)
+		{
+			size_t nMaxLength = 0;
+
+			for(size_t i = 0; i < n; ++i)
+			{
+				if(pEntries[i].mnLength > nMaxLength)
+					nMaxLength = pEntries[i].mnLength;
+			}
+
+			if(nMaxLength <= d)
+			{
+				eastl::quickSort(pEntries, pEntries + n, string_sort_length_less<bStable>());
+				return false;
+			}
+
+			for(size_t i = 0; i < n; ++i)
+				pEntries[i].mnCache = StringSortLoad(pEntries[i].mpData, pEntries[i].mnLength, d);
+
+			return true;
+		}
+
+
+		// Returns true if a is ordered before b, given that they agree before depth d and
+		// their caches are from d. Equal strings are ordered by their original positions
+		// if bStable.
+		template <typename Char, bool bStable>
+		inline bool StringSortLess(const string_sort_entry<Char>& a, const string_sort_entry<Char>& b, size_t d)
+		{
+			typedef typename string_sort_code<sizeof(Char)>::unsigned_type unsigned_type;
+
+			if(a.mnCache != b.mnCache)
+				return (a.mnCache < b.mnCache);
+
+			const size_t n = (a.mnLength < b.mnLength) ? a.mnLength : b.mnLength;
+
+			d += string_sort_entry<Char>::kChunk;
+
+			if(sizeof(Char) == 1)
+			{
+				if(d < n)
+				{
+					const int result = memcmp(a.mpData + d, b.mpData + d, n - d);
+
+					if(result)
+						return (result < 0);
+				}
+			}
+			else
+			{
+				for(; d < n; ++d)
+				{
+					if(a.mpData[d] != b.mpData[d])
+						return ((unsigned_type)a.mpData[d] < (unsigned_type)b.mpData[d]);
+				}
+			}
+
+			return string_sort_length_less<bStable>()(a, b);
+		}
+
+
+		template <typename Char, bool bStable>
+		void StringSortInsertion(string_sort_entry<Char>* pEntries, size_t n, size_t d)
+		{
+			for(size_t i = 1; i < n; ++i)
+			{
+				const string_sort_entry<Char> temp(pEntries[i]);
+				size_t j = i;
+
+				for(; (j > 0) && StringSortLess<Char, bStable>(temp, pEntries[j - 1], d); --j)
+					pEntries[j] = pEntries[j - 1];
+
+				pEntries[j] = temp;
+			}
+		}
+
+
+		// Multikey quicksort on the caches, which are from depth d.
+		template <typename Char, bool bStable>
+		void StringSortMultikey(string_sort_entry<Char>* pEntries, size_t n, size_t d)
+		{
+			while(n > kStringSortInsertionLimit)
+			{
+				// The pivot is the median of three caches. Partition into [0, lt) less than it,
+				// [lt, gt) equal to it and [gt, n) greater than it.
+				const uint64_t a = pEntries[0].mnCache;
+				const uint64_t b = pEntries[n / 2].mnCache;
+				const uint64_t c = pEntries[n - 1].mnCache;
+				const uint64_t pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+				                               : ((a < c) ? a : ((b < c) ? c : b));
+
+				size_t lt = 0, i = 0, gt = n;
+
+				while(i < gt)
+				{
+					const uint64_t key = pEntries[i].mnCache;
+
+					if(key < pivot)
+						eastl::swap(pEntries[lt++], pEntries[i++]);
+					else if(pivot < key)
+						eastl::swap(pEntries[i], pEntries[--gt]);
+					else
+						++i;
+				}
+
+				// Recurse on the two smaller parts and loop on the largest. Each recursion then
+				// gets at most half of n, which bounds the depth by log2(n) even for keys which
+				// share long prefixes.
+				const size_t nLess    = lt;
+				const size_t nEqual   = (gt - lt);
+				const size_t nGreater = (n - gt);
+				const size_t dNext    = d + string_sort_entry<Char>::kChunk;
+
+				if((nEqual >= nLess) && (nEqual >= nGreater))
+				{
+					StringSortMultikey<Char, bStable>(pEntries, nLess, d);
+					StringSortMultikey<Char, bStable>(pEntries + gt, nGreater, d);
+
+					pEntries += lt;
+					n         = nEqual;
+					d         = dNext;
+
+					if(!StringSortAdvance<Char, bStable>(pEntries, n, d))
+						return;
+				}
+				else
+				{
+					if(StringSortAdvance<Char, bStable>(pEntries + lt, nEqual, dNext))
+						StringSortMultikey<Char, bStable>(pEntries + lt, nEqual, dNext);
+
+					if(nLess >= nGreater)
+					{
+						StringSortMultikey<Char, bStable>(pEntries + gt, nGreater, d);
+						n = nLess;
+					}
+					else
+					{
+						StringSortMultikey<Char, bStable>(pEntries, nLess, d);
+						pEntries += gt;
+						n         = nGreater;
+					}
+				}
+			}
+
+			StringSortInsertion<Char, bStable>(pEntries, n, d);
+		}
+
+
+		// MSD radix sort for byte-wide characters, taking the digits from the caches, which
+		// are from depth d. The next digit is the byte at nShift in the cache. The distribution
+		// goes through pTemp, which has room for n entries.
+		template <typename Char, bool bStable>
+		void StringSortRadix(string_sort_entry<Char>* pEntries, string_sort_entry<Char>* pTemp, size_t n, size_t d, int nShift)
+		{
+			while(n >= kStringSortRadixLimit)
+			{
+				if(nShift < 0) // If the cached digits are used up...
+				{
+					d     += string_sort_entry<Char>::kChunk;
+					nShift = 56;
+
+					if(!StringSortAdvance<Char, bStable>(pEntries, n, d))
+						return;
+				}
+
+				// Skip the digits the strings all have in common, which for strings such as URLs
+				// can be most of them.
+				const uint64_t firstCache = pEntries[0].mnCache;
+				uint64_t       differ     = 0;
+
+				for(size_t i = 1; i < n; ++i)
+					differ |= (pEntries[i].mnCache ^ firstCache);
+
+				differ &= (((uint64_t)0xff << nShift) | (((uint64_t)0xff << nShift) - 1)); // The digits at nShift and below.
+
+				if(differ == 0)
+				{
+					nShift = -8;
+					continue;
+				}
+
+				nShift = (int)((63 - eastl::countl_zero(differ)) & ~7);
+
+				size_t pCounts[256];
+				memset(pCounts, 0, sizeof(pCounts));
+
+				for(size_t i = 0; i < n; ++i)
+					++pCounts[(size_t)(pEntries[i].mnCache >> nShift) & 0xff];
+
+				size_t pEnds[256];
+				size_t start = 0;
+
+				for(size_t k = 0; k < 256; ++k)
+				{
+					pEnds[k] = start;
+					start   += pCounts[k];
+				}
+
+				for(size_t i = 0; i < n; ++i)
+					pTemp[pEnds[(size_t)(pEntries[i].mnCache >> nShift) & 0xff]++] = pEntries[i];
+
+				memcpy(pEntries, pTemp, n * sizeof(string_sort_entry<Char>));
+
+				// Recurse on every bucket but the largest and loop on that one. Each recursion
+				// then gets at most half of n, which bounds the depth by log2(n) even for keys
+				// such as "a", "aa", "aaa", ... which split off one string per digit.
+				size_t kLargest = 0;
+
+				for(size_t k = 1; k < 256; ++k)
+				{
+					if(pCounts[k] > pCounts[kLargest])
+						kLargest = k;
+				}
+
+				for(size_t k = 0; k < 256; ++k)
+				{
+					const size_t nBucket = pCounts[k];
+
+					if(k == kLargest)
+						continue;
+					else if(nBucket >= kStringSortRadixLimit)
+						StringSortRadix<Char, bStable>(pEntries + (pEnds[k] - nBucket), pTemp, nBucket, d, nShift - 8);
+					else if(nBucket > 1)
+						StringSortMultikey<Char, bStable>(pEntries + (pEnds[k] - nBucket), nBucket, d); // The caches agree on the digits so far, so the sort can compare them whole.
+				}
+
+				pEntries += (pEnds[kLargest] - pCounts[kLargest]);
+				n         = pCounts[kLargest];
+				nShift   -= 8;
+			}
+
+			StringSortMultikey<Char, bStable>(pEntries, n, d);
+		}
+
+
+		template <typename RandomAccessIterator, typename Allocator, bool bStable>
+		void string_sort_impl(RandomAccessIterator first, RandomAccessIterator last, Allocator& allocator)
+		{
+			typedef typename eastl::iterator_traits<RandomAccessIterator>::value_type value_type;
+			typedef eastl::string_sort_traits<value_type>                            traits_type;
+			typedef typename eastl::remove_const<typename traits_type::char_type>::type char_type;
+			typedef string_sort_entry<char_type>                                      entry_type;
+
+			const size_t n = (size_t)(last - first);
+
+			if(n < 2)
+				return;
+
+			// The radix sort is used for byte-wide characters only, as wider ones would need too many buckets.
+			const bool   bRadix = (sizeof(char_type) == 1) && (n >= kStringSortRadixLimit);
+			// The entries are followed by room for the radix sort's distribution and, after the
+			// sort, for the moved elements.
+			const size_t nTempSize = (bRadix && (sizeof(entry_type) > sizeof(value_type))) ? sizeof(entry_type) : sizeof(value_type);
+			const size_t nBytes    = n * (sizeof(entry_type) + nTempSize);
+			const size_t nAlign    = (EASTL_ALIGN_OF(value_type) > EASTL_ALIGN_OF(entry_type)) ? EASTL_ALIGN_OF(value_type) : EASTL_ALIGN_OF(entry_type);
+
+			void* const       pMemory  = allocate_memory(allocator, nBytes, nAlign, 0);
+			entry_type* const pEntries = (entry_type*)pMemory;
+			value_type* const pBuffer  = (value_type*)(pEntries + n);
+
+			for(size_t i = 0; i < n; ++i)
+			{
+				const value_type& value = *(first + i);
+
+				pEntries[i].mpData   = traits_type::data(value);
+				pEntries[i].mnLength = traits_type::length(value);
+				pEntries[i].mnIndex  = i;
+				pEntries[i].mnCache  = StringSortLoad(pEntries[i].mpData, pEntries[i].mnLength, 0);
+			}
+
+			if(bRadix)
+				StringSortRadix<char_type, bStable>(pEntries, pEntries + n, n, 0, 56);
+			else
+				StringSortMultikey<char_type, bStable>(pEntries, n, 0);
+
+			// Move the elements into place, through pBuffer. Following the cycles of the permutation
+			// instead would save the buffer, but each move would have to wait for the cache miss
+			// of the one before.
+			for(size_t i = 0; i < n; ++i)
+				::new((void*)(pBuffer + i)) value_type(eastl::move(*(first + pEntries[i].mnIndex)));
+
+			for(size_t i = 0; i < n; ++i)
+			{
+				*(first + i) = eastl::move(pBuffer[i]);
+				pBuffer[i].~value_type();
+			}
+
+			EASTLFree(allocator, pMemory, nBytes);
+		}
+	}
+
+
+
+	/// string_sort
+	///
+	/// Sorts a range of strings (see string_sort_traits) into ascending order. This is
+	/// an unstable sort. It takes O(D + n log n) time, where D is the total length of
+	/// the distinguishing prefixes of the strings, versus the O(D log n) of a comparison
+	/// sort; in practice it's several times faster than sort for strings with long
+	/// common prefixes. It allocates 32 bytes per string plus room for a copy of the
+	/// range, or 64 bytes per string if that's more, and moves each element twice.
+	///
+	/// Example usage:
+	///     eastl::vector<eastl::string> urls;
+	///     ...
+	///     eastl::string_sort(urls.begin(), urls.end());
+	///
+	template <typename RandomAccessIterator, typename Allocator>
+	inline void string_sort(RandomAccessIterator first, RandomAccessIterator last, Allocator& allocator)
+	{
+		Internal::string_sort_impl<RandomAccessIterator, Allocator, false>(first, last, allocator);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void string_sort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		EASTLAllocatorType allocator(EASTL_STRING_SORT_DEFAULT_NAME);
+		Internal::string_sort_impl<RandomAccessIterator, EASTLAllocatorType, false>(first, last, allocator);
+	}
+
+
+	/// string_stable_sort
+	///
+	/// The same as string_sort, except that equal strings keep their relative order.
+	/// This costs next to nothing extra, as equal strings are only ever found all at
+	/// once, when they are known to be equal, and are then ordered by position.
+	///
+	template <typename RandomAccessIterator, typename Allocator>
+	inline void string_stable_sort(RandomAccessIterator first, RandomAccessIterator last, Allocator& allocator)
+	{
+		Internal::string_sort_impl<RandomAccessIterator, Allocator, true>(first, last, allocator);
+	}
+
+	template <typename RandomAccessIterator>
+	inline void string_stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		EASTLAllocatorType allocator(EASTL_STRING_SORT_DEFAULT_NAME);
+		Internal::string_sort_impl<RandomAccessIterator, EASTLAllocatorType, true>(first, last, allocator);
+	}
+
+} // namespace eastl
+
+
+#endif // Header include guard
@@ -0,0 +1,622 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// This file implements a hierarchical hashed timer wheel. A timer wheel is
+// the usual alternative to a priority queue of deadlines when timers are
+// numerous and most of them are cancelled before they fire (timeouts,
+// retransmits, keep-alives): scheduling and cancelling a timer are O(1),
+// and expiry costs O(1) per timer that fires rather than O(log n).
+//
+// Time is measured in ticks of a fixed duration. The wheel has nLevelCount
+// levels of 2^nSlotBits slots each. Level L holds timers that are due in
+// [2^(nSlotBits*L), 2^(nSlotBits*(L+1))) ticks, hashed by the bits of their
+// expiry tick that select that range. Level 0 slots thus hold timers for a
+// single tick. Whenever the lower levels wrap around, the next slot of the
+// level above is emptied and its timers are redistributed ("cascaded") into
+// the lower levels. Each timer is cascaded at most nLevelCount - 1 times.
+// Timers due further out than the wheel covers wait in an overflow list
+// that is revisited each time the top level wraps around.
+//
+// The wheel doesn't allocate; as with intrusive_list, the timers are user
+// structs which derive from timer_wheel_node, and the node is the handle
+// used to cancel or reschedule the timer.
+//
+// Example usage:
+//    struct Connection : public eastl::timer_wheel_node { ... };
+//
+//    eastl::timer_wheel<Connection> wheel(eastl::chrono::milliseconds(10));
+//    wheel.schedule(connection, eastl::chrono::seconds(30));
+//    ...
+//    wheel.cancel(connection);
+//    ...
+//    wheel.advance(elapsed, OnTimeout);   // Calls OnTimeout(Connection&) for each expired timer.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef EASTL_TIMER_WHEEL_H
+#define EASTL_TIMER_WHEEL_H
+
+
+#include <eastl/internal/config.h>
+#include <eastl/bit.h>
+#include <eastl/bitset.h>
+#include <eastl/chrono.h>
+#include <eastl/intrusive_list.h>
+#include <eastl/type_traits.h>
+#include <stddef.h>
+
+#if defined(EASTL_PRAGMA_ONCE_SUPPORTED)
+	#pragma once // Some compilers (e.g. VC++) benefit significantly from using this. We've measured 3-4% build speed improvements in apps as a result.
+#endif
+
+
+
+namespace eastl
+{
+
+	/// timer_wheel_node
+	///
+	/// The base class of timers held by a timer_wheel. Unlike intrusive_list_node
+	/// this isn't a POD, as the wheel needs to tell whether a node is scheduled.
+	/// A node may be in only one wheel at a time and must not be destroyed or
+	/// moved while it is scheduled.
+	///
+	struct timer_wheel_node : public intrusive_list_node
+	{
+		static const uint32_t kUnscheduled = 0xffffffff;
+
+		uint64_t mnExpiry;  /// The tick at which the timer fires; valid while scheduled.
+		uint32_t mnLevel;   /// The wheel level which holds the timer, or kUnscheduled.
+
+		timer_wheel_node()
+			: mnExpiry(0), mnLevel(kUnscheduled)
+		{
+			mpNext = mpPrev = NULL;
+		}
+
+		timer_wheel_node(const timer_wheel_node&)
+			: intrusive_list_node(), mnExpiry(0), mnLevel(kUnscheduled)
+		{
+			mpNext = mpPrev = NULL;
+		}
+
+		timer_wheel_node& operator=(const timer_wheel_node&)
+			{ return *this; } // Scheduling state isn't copied; the node keeps its own.
+	};
+
+
+
+	/// timer_wheel
+	///
+	/// T is the user's timer type and must derive from timer_wheel_node.
+	/// nSlotBits is the log2 of the number of slots per level and nLevelCount
+	/// the number of levels; with the defaults the wheel covers 2^32 ticks
+	/// (about 50 days at 1ms ticks) before timers go to the overflow list.
+	/// The slots are stored in the wheel itself; that's about 16KB with the
+	/// defaults and grows with 2^nSlotBits, so a wheel with a large nSlotBits
+	/// shouldn't be put on the stack.
+	///
+	/// A timer scheduled for d ticks fires during the advance() call which
+	/// moves the current tick to the current tick plus d. A delay of zero is
+	/// treated as one tick, so a timer never fires from within schedule().
+	///
+	/// Expired timers are unscheduled before they are handed to the user, so
+	/// the expiry callback may reschedule the timer it is called for, and it
+	/// may schedule or cancel any other timer too, including one which was
+	/// due on the same tick and hasn't been handed out yet.
+	///
+	/// advance() doesn't visit ticks on which nothing happens: each level
+	/// keeps a bitmap of its occupied slots, so an idle wheel advances over
+	/// 2^nSlotBits ticks of a level in a handful of word scans.
+	///
+	template <typename T = timer_wheel_node, size_t nSlotBits = 8, size_t nLevelCount = 4>
+	class timer_wheel
+	{
+	public:
+		typedef timer_wheel<T, nSlotBits, nLevelCount>  this_type;
+		typedef T                                       value_type;
+		typedef intrusive_list<T>                       list_type;
+		typedef eastl_size_t                            size_type;
+		typedef uint64_t                                tick_type;
+		typedef chrono::nanoseconds                     duration_type;
+
+		static const size_t    kSlotBits   = nSlotBits;
+		static const size_t    kLevelCount = nLevelCount;
+		static const size_t    kSlotCount  = (size_t)1 << nSlotBits;
+		static const tick_type kSlotMask   = (tick_type)kSlotCount - 1;
+		static const size_t    kWheelBits  = nSlotBits * nLevelCount; // If this is less than 64 then timers further out than 2^kWheelBits ticks go to the overflow list.
+
+	public:
+		explicit timer_wheel(duration_type tickDuration = chrono::milliseconds(1), tick_type nStartTick = 0);
+	   ~timer_wheel();
+
+		void schedule(value_type& timer, tick_type nDelayTicks);
+		void schedule_at(value_type& timer, tick_type nExpiryTick);
+
+		template <typename Rep, typename Period>
+		void schedule(value_type& timer, const chrono::duration<Rep, Period>& delay);
+
+		bool cancel(value_type& timer);
+
+		static bool is_scheduled(const value_type& timer);
+
+		template <typename Function>
+		size_type advance(tick_type nTicks, Function function);
+		size_type advance(tick_type nTicks, list_type& expired);
+
+		template <typename Rep, typename Period, typename Function>
+		size_type advance(const chrono::duration<Rep, Period>& elapsed, Function function);
+		template <typename Rep, typename Period>
+		size_type advance(const chrono::duration<Rep, Period>& elapsed, list_type& expired);
+
+		template <typename Rep, typename Period>
+		tick_type ticks_for(const chrono::duration<Rep, Period>& d) const;
+
+		tick_type     current_tick() const;
+		duration_type tick_duration() const;
+		tick_type     next_event_tick() const;
+
+		size_type size() const;
+		bool      empty() const;
+		void      clear();
+
+		bool validate() const;
+
+	protected:
+		static const size_t kOverflowSlot = kSlotCount * nLevelCount;
+
+		void      DoInsert(value_type& timer);
+		void      DoCascade(size_t nSlot);
+		tick_type DoNextEventTick(tick_type nLimitTick) const;
+		tick_type DoTicksFor(long long nNanoseconds) const;
+
+		template <typename Function>
+		size_type DoTick(Function& function);
+
+		template <typename Function>
+		size_type DoAdvance(tick_type nTicks, Function& function);
+
+		struct ListAppender
+		{
+			list_type* mpList;
+			void operator()(value_type& timer) { mpList->pushBack(timer); }
+		};
+
+	protected:
+		list_type          mSlots[kSlotCount * nLevelCount + 1]; // The last slot is the overflow list.
+		bitset<kSlotCount> mOccupied[nLevelCount];                // Bit s of level L is set if mSlots[L * kSlotCount + s] is non-empty.
+		tick_type          mnCurrentTick;
+		long long          mnTickNanoseconds;
+		long long          mnRemainderNanoseconds;                // The part of the time passed to advance() that didn't make up a whole tick.
+		size_type          mnSize;
+
+	private:
+		// Timer wheels are not copyable, as the slot lists are self-referential.
+		timer_wheel(const this_type&);
+		this_type& operator=(const this_type&);
+
+	}; // class timer_wheel
+
+
+
+
+	///////////////////////////////////////////////////////////////////////
+	// timer_wheel
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, size_t B, size_t L>
+	inline timer_wheel<T, B, L>::timer_wheel(duration_type tickDuration, tick_type nStartTick)
+		: mnCurrentTick(nStartTick),
+		  mnTickNanoseconds(tickDuration.count()),
+		  mnRemainderNanoseconds(0),
+		  mnSize(0)
+	{
+		EASTL_CT_ASSERT((is_base_of<timer_wheel_node, T>::value));
+		EASTL_CT_ASSERT((kSlotBits >= 1) && (kSlotBits <= 16) && (kLevelCount >= 1) && (kWheelBits <= 64));
+		EASTL_ASSERT(mnTickNanoseconds > 0);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline timer_wheel<T, B, L>::~timer_wheel()
+	{
+		clear();
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline void timer_wheel<T, B, L>::schedule(value_type& timer, tick_type nDelayTicks)
+	{
+		schedule_at(timer, mnCurrentTick + (nDelayTicks ? nDelayTicks : 1));
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline void timer_wheel<T, B, L>::schedule_at(value_type& timer, tick_type nExpiryTick)
+	{
+		// Rescheduling is a cancel followed by an insert; both are O(1).
+		cancel(timer);
+
+		timer.mnExpiry = (nExpiryTick > mnCurrentTick) ? nExpiryTick : (mnCurrentTick + 1);
+		DoInsert(timer);
+		++mnSize;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	template <typename Rep, typename Period>
+	inline void timer_wheel<T, B, L>::schedule(value_type& timer, const chrono::duration<Rep, Period>& delay)
+	{
+		schedule(timer, ticks_for(delay));
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline bool timer_wheel<T, B, L>::cancel(value_type& timer)
+	{
+		const uint32_t nLevel = timer.mnLevel;
+
+		if(nLevel == timer_wheel_node::kUnscheduled)
+			return false;
+
+		list_type::remove(timer);
+		timer.mpNext = timer.mpPrev = NULL;
+		timer.mnLevel = timer_wheel_node::kUnscheduled;
+		--mnSize;
+
+		// Keep the occupancy bitmaps exact, so that advance() never has to visit an empty slot.
+		if(nLevel < kLevelCount)
+		{
+			const size_t nSlot = (size_t)((timer.mnExpiry >> (kSlotBits * nLevel)) & kSlotMask);
+
+			if(mSlots[(nLevel * kSlotCount) + nSlot].empty())
+				mOccupied[nLevel].reset(nSlot);
+		}
+
+		return true;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline bool timer_wheel<T, B, L>::is_scheduled(const value_type& timer)
+	{
+		return (timer.mnLevel != timer_wheel_node::kUnscheduled);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	template <typename Function>
+	inline typename timer_wheel<T, B, L>::size_type
+	timer_wheel<T, B, L>::advance(tick_type nTicks, Function function)
+	{
+		return DoAdvance(nTicks, function);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline typename timer_wheel<T, B, L>::size_type
+	timer_wheel<T, B, L>::advance(tick_type nTicks, list_type& expired)
+	{
+		// The expired timers are appended to the list in expiry order. They are
+		// no longer scheduled, but they are linked into 'expired', so they must be
+		// removed from it before they can be scheduled again.
+		ListAppender appender = { &expired };
+		return DoAdvance(nTicks, appender);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	template <typename Rep, typename Period, typename Function>
+	inline typename timer_wheel<T, B, L>::size_type
+	timer_wheel<T, B, L>::advance(const chrono::duration<Rep, Period>& elapsed, Function function)
+	{
+		// Time that doesn't make up a whole tick is carried over to the next call,
+		// so that advancing by many short intervals doesn't make the wheel run slow.
+		mnRemainderNanoseconds += chrono::duration_cast<duration_type>(elapsed).count();
+
+		const tick_type nTicks = (mnRemainderNanoseconds > 0) ? (tick_type)(mnRemainderNanoseconds / mnTickNanoseconds) : 0;
+		mnRemainderNanoseconds -= (long long)nTicks * mnTickNanoseconds;
+
+		return DoAdvance(nTicks, function);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	template <typename Rep, typename Period>
+	inline typename timer_wheel<T, B, L>::size_type
+	timer_wheel<T, B, L>::advance(const chrono::duration<Rep, Period>& elapsed, list_type& expired)
+	{
+		ListAppender appender = { &expired };
+		return advance(elapsed, appender);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	template <typename Rep, typename Period>
+	inline typename timer_wheel<T, B, L>::tick_type
+	timer_wheel<T, B, L>::ticks_for(const chrono::duration<Rep, Period>& d) const
+	{
+		return DoTicksFor(chrono::duration_cast<duration_type>(d).count());
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline typename timer_wheel<T, B, L>::tick_type
+	timer_wheel<T, B, L>::DoTicksFor(long long nNanoseconds) const
+	{
+		// Rounds up, as a timer must not fire before its delay has passed.
+		return (nNanoseconds > 0) ? (tick_type)((nNanoseconds + mnTickNanoseconds - 1) / mnTickNanoseconds) : 0;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline typename timer_wheel<T, B, L>::tick_type
+	timer_wheel<T, B, L>::current_tick() const
+	{
+		return mnCurrentTick;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline typename timer_wheel<T, B, L>::duration_type
+	timer_wheel<T, B, L>::tick_duration() const
+	{
+		return duration_type(mnTickNanoseconds);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline typename timer_wheel<T, B, L>::tick_type
+	timer_wheel<T, B, L>::next_event_tick() const
+	{
+		// Returns the next tick at which a timer expires or timers are cascaded.
+		// No timer fires before this tick, so an event loop can sleep until then.
+		// Returns the maximum tick value if the wheel is empty.
+		return DoNextEventTick(~(tick_type)0);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline typename timer_wheel<T, B, L>::size_type
+	timer_wheel<T, B, L>::size() const
+	{
+		return mnSize;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline bool timer_wheel<T, B, L>::empty() const
+	{
+		return (mnSize == 0);
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline void timer_wheel<T, B, L>::clear()
+	{
+		// Unschedules all timers; O(n).
+		for(size_t i = 0; i <= kOverflowSlot; ++i)
+		{
+			list_type& slot = mSlots[i];
+
+			while(!slot.empty())
+			{
+				value_type& timer = slot.front();
+				slot.popFront();
+				timer.mpNext = timer.mpPrev = NULL;
+				timer.mnLevel = timer_wheel_node::kUnscheduled;
+			}
+		}
+
+		for(size_t i = 0; i < kLevelCount; ++i)
+			mOccupied[i].reset();
+
+		mnSize = 0;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline void timer_wheel<T, B, L>::DoInsert(value_type& timer)
+	{
+		// The level is the one whose range contains the delay: delays below
+		// 2^kSlotBits go to level 0, delays below 2^(2*kSlotBits) to level 1, etc.
+		// A delay of zero occurs only while cascading, for a timer due on the tick
+		// being processed, and it goes to the level 0 slot about to be expired.
+		const tick_type nDelay = timer.mnExpiry - mnCurrentTick;
+		const size_t    nLevel = (size_t)(eastl::bit_width(nDelay | 1) - 1) / kSlotBits;
+
+		if(nLevel < kLevelCount)
+		{
+			const size_t nSlot = (size_t)((timer.mnExpiry >> (kSlotBits * nLevel)) & kSlotMask);
+
+			mSlots[(nLevel * kSlotCount) + nSlot].pushBack(timer);
+			mOccupied[nLevel].set(nSlot);
+			timer.mnLevel = (uint32_t)nLevel;
+		}
+		else
+		{
+			mSlots[kOverflowSlot].pushBack(timer);
+			timer.mnLevel = (uint32_t)kLevelCount;
+		}
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline void timer_wheel<T, B, L>::DoCascade(size_t nSlot)
+	{
+		// Redistributes the timers of a slot into the levels below. The slot is
+		// detached first, as a timer may be put back into the same slot (this
+		// happens only with the overflow list).
+		list_type pending;
+		pending.splice(pending.end(), mSlots[nSlot]);
+
+		if(nSlot < kOverflowSlot)
+			mOccupied[nSlot / kSlotCount].reset(nSlot % kSlotCount);
+
+		while(!pending.empty())
+		{
+			value_type& timer = pending.front();
+			pending.popFront();
+			DoInsert(timer);
+		}
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	typename timer_wheel<T, B, L>::tick_type
+	timer_wheel<T, B, L>::DoNextEventTick(tick_type nLimitTick) const
+	{
+		// Finds the first tick after the current one at which something happens,
+		// or nLimitTick if that comes first. Ticks in between are then skipped.
+		//
+		// A level's occupied slots after its current position are processed
+		// in this rotation of the level, and the first of them is the answer
+		// if every level below it is empty. Occupied slots at or before the
+		// current position belong to the next rotation, which begins when the
+		// level wraps around; that tick is the answer as it also cascades the
+		// level above. An empty level defers to the level above it.
+		for(size_t nLevel = 0; nLevel < kLevelCount; ++nLevel)
+		{
+			const size_t    nShift     = kSlotBits * nLevel;
+			const tick_type nLevelTick = mnCurrentTick >> nShift;
+			const size_t    nPosition  = (size_t)(nLevelTick & kSlotMask);
+			const size_t    nNext      = mOccupied[nLevel].findNext(nPosition);
+			tick_type       nTick;
+
+			if(nNext < kSlotCount)
+				nTick = (nLevelTick + (nNext - nPosition)) << nShift;
+			else if(mOccupied[nLevel].findFirst() < kSlotCount)
+				nTick = ((nLevelTick | kSlotMask) + 1) << nShift;
+			else
+				continue;
+
+			// The shift can overflow only at the very end of the tick range.
+			return ((nTick > mnCurrentTick) && (nTick < nLimitTick)) ? nTick : nLimitTick;
+		}
+
+		if((kWheelBits < 64) && !mSlots[kOverflowSlot].empty())
+		{
+			const size_t    nShift = (kWheelBits < 64) ? kWheelBits : 0;
+			const tick_type nTick  = ((mnCurrentTick >> nShift) + 1) << nShift;
+
+			return ((nTick > mnCurrentTick) && (nTick < nLimitTick)) ? nTick : nLimitTick;
+		}
+
+		return nLimitTick;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	template <typename Function>
+	typename timer_wheel<T, B, L>::size_type
+	timer_wheel<T, B, L>::DoTick(Function& function)
+	{
+		const tick_type nTick = ++mnCurrentTick;
+
+		// When the lower levels wrap around, cascade the next slot of each level
+		// above. This is done top-down, so that the timers cascaded out of a level
+		// land in slots that are processed later.
+		if((nTick & kSlotMask) == 0)
+		{
+			if((kWheelBits < 64) && ((nTick & (((tick_type)1 << (kWheelBits % 64)) - 1)) == 0))
+				DoCascade(kOverflowSlot);
+
+			for(size_t nLevel = kLevelCount - 1; nLevel > 0; --nLevel)
+			{
+				const size_t nShift = kSlotBits * nLevel;
+
+				if((nTick & (((tick_type)1 << nShift) - 1)) == 0)
+				{
+					const size_t nSlot = (size_t)((nTick >> nShift) & kSlotMask);
+
+					if(mOccupied[nLevel].test(nSlot))
+						DoCascade((nLevel * kSlotCount) + nSlot);
+				}
+			}
+		}
+
+		// Expire the level 0 slot for this tick. The whole slot is detached at
+		// once and the timers are unscheduled one by one as they are handed out,
+		// which lets the callback cancel the ones that haven't been handed out.
+		const size_t nSlot = (size_t)(nTick & kSlotMask);
+		size_type    nCount = 0;
+
+		if(mOccupied[0].test(nSlot))
+		{
+			list_type expired;
+			expired.splice(expired.end(), mSlots[nSlot]);
+			mOccupied[0].reset(nSlot);
+
+			while(!expired.empty())
+			{
+				value_type& timer = expired.front();
+				expired.popFront();
+				timer.mpNext = timer.mpPrev = NULL;
+				timer.mnLevel = timer_wheel_node::kUnscheduled;
+				--mnSize;
+				++nCount;
+
+				function(timer);
+			}
+		}
+
+		return nCount;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	template <typename Function>
+	typename timer_wheel<T, B, L>::size_type
+	timer_wheel<T, B, L>::DoAdvance(tick_type nTicks, Function& function)
+	{
+		const tick_type nTargetTick = mnCurrentTick + nTicks;
+		size_type       nCount = 0;
+
+		while(mnCurrentTick != nTargetTick)
+		{
+			mnCurrentTick = DoNextEventTick(nTargetTick) - 1;
+			nCount += DoTick(function);
+		}
+
+		return nCount;
+	}
+
+
+	template <typename T, size_t B, size_t L>
+	inline bool timer_wheel<T, B, L>::validate() const
+	{
+		size_type nCount = 0;
+
+		for(size_t i = 0; i <= kOverflowSlot; ++i)
+		{
+			const list_type& slot  = mSlots[i];
+			const size_t    nLevel = i / kSlotCount;
+
+			if(!slot.validate())
+				return false;
+
+			if((nLevel < kLevelCount) && (mOccupied[nLevel].test(i % kSlotCount) == slot.empty()))
+				return false;
+
+			for(typename list_type::const_iterator it = slot.begin(); it != slot.end(); ++it, ++nCount)
+			{
+				const value_type& timer = *it;
+
+				if((timer.mnLevel != nLevel) || (timer.mnExpiry <= mnCurrentTick))
+					return false;
+
+				if((nLevel < kLevelCount) && ((size_t)((timer.mnExpiry >> (kSlotBits * nLevel)) & kSlotMask) != (i % kSlotCount)))
+					return false;
+			}
+		}
+
+		return (nCount == mnSize);
+	}
+
+
+} // namespace eastl
+
+
+#endif // Header include guard